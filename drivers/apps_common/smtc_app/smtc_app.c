@@ -128,6 +128,18 @@ static int prv_get_voltage_cb(uint32_t *value)
 	return prv_env_callbacks->get_voltage_level(value);
 }
 
+/**
+ * @brief Callback for modem hal
+ */
+static int prv_get_persistent_time_cb(uint32_t *value)
+{
+	if (!prv_env_callbacks || !prv_env_callbacks->get_persistent_time) {
+		return -1;
+	}
+
+	return prv_env_callbacks->get_persistent_time(value);
+}
+
 void smtc_app_init(const ralf_t *radio, struct smtc_app_event_callbacks *callbacks,
 		   struct smtc_app_env_callbacks *env_callbacks)
 {
@@ -147,6 +159,7 @@ void smtc_app_init(const ralf_t *radio, struct smtc_app_event_callbacks *callbac
 		.get_battery_level = prv_get_battery_level_cb,
 		.get_temperature = prv_get_temperature_cb,
 		.get_voltage = prv_get_voltage_cb,
+		.get_persistent_time = prv_get_persistent_time_cb,
 
 #ifdef CONFIG_LORA_BASICS_MODEM_USER_STORAGE_IMPL
 		.context_store = env_callbacks->context_store,
@@ -157,6 +170,9 @@ void smtc_app_init(const ralf_t *radio, struct smtc_app_event_callbacks *callbac
 	smtc_modem_hal_init((const struct device *)radio->ral.context, &prv_hal_cb);
 
 	smtc_modem_init(radio, &prv_event_process);
+
+	/* Downlinks are handed to the down_data callback in place */
+	smtc_modem_set_downlink_zero_copy(0, true);
 }
 
 smtc_modem_return_code_t smtc_app_configure_lorawan_params(uint8_t stack_id,
@@ -303,19 +319,29 @@ static void prv_event_process(void)
 					LOG_DBG("Rx SNR: %d",
 						current_event.event_data.downdata.snr / 4);
 
+					smtc_modem_downlink_t downlink;
+					/* The payload is copied in the event when it could not be lent */
+					bool is_lent = smtc_modem_get_downlink(0, &downlink) ==
+						       SMTC_MODEM_RC_OK;
+
 					if (prv_callbacks->down_data != NULL) {
 						prv_callbacks->down_data(
 							current_event.event_data.downdata.rssi,
 							current_event.event_data.downdata.snr,
 							current_event.event_data.downdata.window,
 							current_event.event_data.downdata.fport,
-							current_event.event_data.downdata.data,
+							is_lent ? downlink.data
+								: current_event.event_data.downdata.data,
 							current_event.event_data.downdata.length);
 					}
+					if (is_lent) {
+						smtc_modem_release_downlink(0);
+					}
 					break;
 				case SMTC_MODEM_EVENT_UPLOADDONE:
 					LOG_DBG("UPLOAD DONE EVENT");
-					LOG_DBG("Upload status: %s (%d)",
+					LOG_DBG("Upload session %d status: %s (%d)",
+						current_event.event_data.uploaddone.session_id,
 						smtc_modem_event_uploaddone_status_to_str(
 							current_event.event_data.uploaddone.status),
 						current_event.event_data.uploaddone.status);
@@ -324,6 +350,25 @@ static void prv_event_process(void)
 							current_event.event_data.uploaddone.status);
 					}
 					break;
+				case SMTC_MODEM_EVENT_UPLOAD_PROGRESS:
+					LOG_DBG("UPLOAD PROGRESS EVENT");
+					LOG_DBG("Upload session %d: %d/%d chunks, done in ~%u s",
+						current_event.event_data.upload_progress.session_id,
+						current_event.event_data.upload_progress.nb_chunks_sent,
+						current_event.event_data.upload_progress.nb_chunks_target,
+						current_event.event_data.upload_progress
+							.estimated_completion_s);
+					if (prv_callbacks->upload_progress != NULL) {
+						prv_callbacks->upload_progress(
+							current_event.event_data.upload_progress.session_id,
+							current_event.event_data.upload_progress
+								.nb_chunks_sent,
+							current_event.event_data.upload_progress
+								.nb_chunks_target,
+							current_event.event_data.upload_progress
+								.estimated_completion_s);
+					}
+					break;
 				case SMTC_MODEM_EVENT_SETCONF:
 					LOG_DBG("SET CONF EVENT");
 					LOG_DBG("Tag: %s (%d)",
@@ -109,7 +109,7 @@ struct smtc_app_event_callbacks {
 	 * @param [in] snr     snr signed value in 0.25 dB steps
 	 * @param [in] rx_window The RX window used for the downlink
 	 * @param [in] port    LoRaWAN port
-	 * @param [in] payload Received buffer
+	 * @param [in] payload Received buffer, lent in place and only valid during the callback
 	 * @param [in] size    Received buffer size
 	 */
 	void (*down_data)(int8_t rssi, int8_t snr, smtc_modem_event_downdata_window_t rx_window,
@@ -122,6 +122,17 @@ struct smtc_app_event_callbacks {
 	 */
 	void (*upload_done)(smtc_modem_event_uploaddone_status_t status);
 
+	/**
+	 * @brief  File upload fragment sent
+	 *
+	 * @param [in] session_id             File upload session
+	 * @param [in] nb_chunks_sent         Number of chunks sent so far
+	 * @param [in] nb_chunks_target       Number of chunks after which the upload ends
+	 * @param [in] estimated_completion_s Estimated time before the last fragment is sent
+	 */
+	void (*upload_progress)(uint8_t session_id, uint16_t nb_chunks_sent,
+				uint16_t nb_chunks_target, uint32_t estimated_completion_s);
+
 	/**
 	 * @brief  Set conf changed by DM
 	 *
@@ -267,6 +278,19 @@ struct smtc_app_env_callbacks {
 	 */
 	int (*get_voltage_level)(uint32_t *voltage_level);
 
+	/**
+	 * @brief Get persistent time callback, optional (can be NULL)
+	 *
+	 * @param [out] time_s A time in seconds that keeps counting across MCU resets (RTC, wall
+	 * clock). It is used to age the duty cycle state restored after a reset. Without it, the
+	 * state is restored as if the reset happened right after it was stored: the airtime used
+	 * before the reset is kept for its full hour, which can only delay uplinks. See the
+	 * custom_context_storage sample for an implementation.
+	 *
+	 * @return int 0 if the time was set, or a negative error code if no valid time is available
+	 */
+	int (*get_persistent_time)(uint32_t *time_s);
+
 #ifdef CONFIG_LORA_BASICS_MODEM_USER_STORAGE_IMPL
 
 	/**
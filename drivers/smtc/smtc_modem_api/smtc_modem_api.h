@@ -87,6 +87,21 @@ extern "C" {
  */
 #define SMTC_MODEM_D2D_PING_SLOTS_MASK_SIZE 16
 
+/**
+ * @brief Maximum number of duty cycle bands reported by @ref smtc_modem_get_airtime_forecast
+ */
+#define SMTC_MODEM_AIRTIME_BANDS_MAX 6
+
+/**
+ * @brief Delay returned by @ref smtc_modem_get_airtime_forecast when the uplink never fits in the duty cycle budget
+ */
+#define SMTC_MODEM_AIRTIME_DELAY_NEVER 0xFFFFFFFF
+
+/**
+ * @brief Maximum number of channels reported by @ref smtc_modem_lbt_get_channel_stats
+ */
+#define SMTC_MODEM_LBT_CHANNELS_MAX 16
+
 /**
  * @defgroup SMTC_MODEM_EVENT_DEF Event codes definitions
  * @{
@@ -109,6 +124,7 @@ extern "C" {
 #define SMTC_MODEM_EVENT_USER_RADIO_ACCESS 0x12       //!< radio callback when user use the radio by itself
 #define SMTC_MODEM_EVENT_CLASS_B_PING_SLOT_INFO 0x13  //!< Ping Slot Info answered by network
 #define SMTC_MODEM_EVENT_CLASS_B_STATUS 0x14          //!< Downlink class B is ready or not
+#define SMTC_MODEM_EVENT_UPLOAD_PROGRESS 0x19         //!< File upload fragment sent, progress and estimate updated
 #define SMTC_MODEM_EVENT_NONE 0xFF                    //!< No event available
 /**
  * @}
@@ -489,8 +505,16 @@ typedef struct smtc_modem_event_s
         struct
         {
             smtc_modem_event_uploaddone_status_t status;
+            uint8_t                              session_id;  //!< File upload session that completed
         } uploaddone;
         struct
+        {
+            uint8_t  session_id;              //!< File upload session that sent a fragment
+            uint16_t nb_chunks_sent;          //!< Number of chunks sent so far
+            uint16_t nb_chunks_target;        //!< Number of chunks after which the upload ends without confirmation
+            uint32_t estimated_completion_s;  //!< Estimated time in seconds before the last fragment is sent
+        } upload_progress;
+        struct
         {
             smtc_modem_event_setconf_tag_t tag;
         } setconf;
@@ -543,6 +567,56 @@ typedef struct smtc_modem_event_s
     } event_data;
 } smtc_modem_event_t;
 
+/**
+ * @brief Duty cycle budget of a regulatory band
+ */
+typedef struct smtc_modem_airtime_band_s
+{
+    uint32_t freq_min_hz;   //!< Lowest frequency of the band
+    uint32_t freq_max_hz;   //!< Highest frequency of the band (excluded)
+    uint32_t budget_ms;     //!< Airtime allowed in the band over one hour
+    uint32_t available_ms;  //!< Airtime still available in the band over the current hour
+    uint32_t delay_ms;      //!< Time before the uplink fits in the band, SMTC_MODEM_AIRTIME_DELAY_NEVER if never
+} smtc_modem_airtime_band_t;
+
+/**
+ * @brief Airtime forecast of an uplink
+ */
+typedef struct smtc_modem_airtime_forecast_s
+{
+    uint32_t toa_ms;                //!< Time on air of the uplink
+    uint32_t earliest_tx_delay_ms;  //!< Time before the uplink is allowed, SMTC_MODEM_AIRTIME_DELAY_NEVER if never
+    uint8_t  nb_bands;              //!< Number of valid entries in bands, 0 if no regional duty cycle applies
+    smtc_modem_airtime_band_t bands[SMTC_MODEM_AIRTIME_BANDS_MAX];  //!< Bands of the enabled channels
+} smtc_modem_airtime_forecast_t;
+
+/**
+ * @brief Listen Before Talk statistics of a channel
+ */
+typedef struct smtc_modem_lbt_channel_stats_s
+{
+    uint32_t freq_hz;        //!< Channel frequency
+    uint32_t free_cnt;       //!< Number of listen windows which found the channel free
+    uint32_t busy_cnt;       //!< Number of listen windows which found the channel busy
+    int16_t  last_rssi_dbm;  //!< Last RSSI measured on the channel
+} smtc_modem_lbt_channel_stats_t;
+
+/**
+ * @brief Downlink lent in place by @ref smtc_modem_get_downlink
+ */
+typedef struct smtc_modem_downlink_s
+{
+    const uint8_t*                     data;  //!< Payload, valid until @ref smtc_modem_release_downlink
+    uint16_t                           length;
+    int8_t                             rssi;  //!< Signed value in dBm + 64
+    int8_t                             snr;   //!< Signed value in dB given in 0.25dB step
+    smtc_modem_event_downdata_window_t window;
+    uint8_t                            fport;
+    uint8_t                            fpending_bit;
+    uint32_t                           frequency_hz;
+    uint8_t                            datarate;
+} smtc_modem_downlink_t;
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
@@ -553,17 +627,72 @@ typedef struct smtc_modem_event_s
  *
  * @remark This command can be used to retrieve pending events from the modem.
  *
+ * @remark In zero-copy mode, the downlink lent by a SMTC_MODEM_EVENT_DOWNDATA event has to be released with
+ *         @ref smtc_modem_release_downlink before the next SMTC_MODEM_EVENT_DOWNDATA event is read: until then, the
+ *         next event is the DOWNDATA one and this command returns SMTC_MODEM_RC_BUSY without consuming it.
+ *
  * @param [out] event                   Structure holding event-related information
  * @param [out] event_pending_count     Number of pending event(s)
  *
  * @return Modem return code as defined in @ref smtc_modem_return_code_t
  * @retval SMTC_MODEM_RC_OK            Command executed without errors
  * @retval SMTC_MODEM_RC_INVALID       \p event or \p event_pending_count are NULL
- * @retval SMTC_MODEM_RC_BUSY          Modem is currently in test mode
+ * @retval SMTC_MODEM_RC_BUSY          Modem is currently in test mode, or the next event is a downlink while the
+ *                                     previous one is still lent
  */
 
 smtc_modem_return_code_t smtc_modem_get_event( smtc_modem_event_t* event, uint8_t* event_pending_count );
 
+/**
+ * @brief Enable or disable the zero-copy downlink path
+ *
+ * @remark Once enabled, the payload of a SMTC_MODEM_EVENT_DOWNDATA event is no longer copied in the event data: only
+ *         its length and metadata are set. The payload is read in place with @ref smtc_modem_get_downlink and has to
+ *         be released with @ref smtc_modem_release_downlink before the next SMTC_MODEM_EVENT_DOWNDATA event is read,
+ *         see @ref smtc_modem_get_event. While a downlink is not released, a new downlink which needs its room in the
+ *         downlink fifo is dropped. While the modem certification mode runs, the payloads are still copied in the
+ *         events.
+ *
+ * @param [in] stack_id  Stack identifier
+ * @param [in] enable    true to lend downlinks in place, false to copy them in the events
+ *
+ * @return Modem return code as defined in @ref smtc_modem_return_code_t
+ * @retval SMTC_MODEM_RC_OK                Command executed without errors
+ * @retval SMTC_MODEM_RC_BUSY              Modem is currently in test mode
+ * @retval SMTC_MODEM_RC_INVALID_STACK_ID  Invalid \p stack_id
+ */
+smtc_modem_return_code_t smtc_modem_set_downlink_zero_copy( uint8_t stack_id, bool enable );
+
+/**
+ * @brief Borrow the oldest received downlink without copying its payload
+ *
+ * @remark Returns the downlink of the last SMTC_MODEM_EVENT_DOWNDATA event when its payload was lent in place, the
+ *         same downlink is returned until @ref smtc_modem_release_downlink is called.
+ *
+ * @param [in]  stack_id  Stack identifier
+ * @param [out] downlink  Downlink payload and metadata
+ *
+ * @return Modem return code as defined in @ref smtc_modem_return_code_t
+ * @retval SMTC_MODEM_RC_OK                Command executed without errors
+ * @retval SMTC_MODEM_RC_INVALID           \p downlink is NULL
+ * @retval SMTC_MODEM_RC_FAIL              No downlink is lent, the payload of the last event was copied in the event
+ * @retval SMTC_MODEM_RC_BUSY              Modem is currently in test mode
+ * @retval SMTC_MODEM_RC_INVALID_STACK_ID  Invalid \p stack_id
+ */
+smtc_modem_return_code_t smtc_modem_get_downlink( uint8_t stack_id, smtc_modem_downlink_t* downlink );
+
+/**
+ * @brief Release the downlink borrowed with @ref smtc_modem_get_downlink, its payload must no longer be read
+ *
+ * @param [in] stack_id  Stack identifier
+ *
+ * @return Modem return code as defined in @ref smtc_modem_return_code_t
+ * @retval SMTC_MODEM_RC_OK                Command executed without errors
+ * @retval SMTC_MODEM_RC_BUSY              Modem is currently in test mode
+ * @retval SMTC_MODEM_RC_INVALID_STACK_ID  Invalid \p stack_id
+ */
+smtc_modem_return_code_t smtc_modem_release_downlink( uint8_t stack_id );
+
 /**
  * @brief Get the modem firmware version
  *
@@ -1157,6 +1286,25 @@ smtc_modem_return_code_t smtc_modem_get_region( uint8_t stack_id, smtc_modem_reg
  */
 smtc_modem_return_code_t smtc_modem_set_region( uint8_t stack_id, smtc_modem_region_t region );
 
+/**
+ * @brief Switch the LoRaWAN region, for devices moving between regulatory areas
+ *
+ * @remark If the modem is joined or joining, it leaves the network first: a new join is needed in the new region.
+ * Keys, DevNonce and statistics are kept, as the duty cycle airtime of the bands shared by both regions. The switch
+ * does not access the radio, its duration is bounded by the number of channels of \p region and by the NVM write of
+ * the new region. Switching to the current region does nothing.
+ *
+ * @param [in]  stack_id Stack identifier
+ * @param [in]  region   LoRaWAN region to switch to
+ *
+ * @return Modem return code as defined in @ref smtc_modem_return_code_t
+ * @retval SMTC_MODEM_RC_OK                Command executed without errors
+ * @retval SMTC_MODEM_RC_INVALID           \p region is not supported
+ * @retval SMTC_MODEM_RC_BUSY              Modem is currently in test mode
+ * @retval SMTC_MODEM_RC_INVALID_STACK_ID  Invalid \p stack_id
+ */
+smtc_modem_return_code_t smtc_modem_switch_region( uint8_t stack_id, smtc_modem_region_t region );
+
 /**
  * @brief Get the current adaptative data rate (ADR) profile
  *
@@ -1469,6 +1617,10 @@ smtc_modem_return_code_t smtc_modem_file_upload_init( uint8_t stack_id, uint8_t
 /**
  * @brief Start the file upload session
  *
+ * @remark Fragments are spaced by the average delay given at init, extended when the regional duty cycle budget
+ *         requires it. After each fragment, a SMTC_MODEM_EVENT_UPLOAD_PROGRESS event reports the progress and the
+ *         estimated time before the last fragment is sent.
+ *
  * @param [in] stack_id Stack identifier
  *
  * @return Modem return code as defined in @ref smtc_modem_return_code_t
@@ -1496,6 +1648,68 @@ smtc_modem_return_code_t smtc_modem_file_upload_start( uint8_t stack_id );
  */
 smtc_modem_return_code_t smtc_modem_file_upload_reset( uint8_t stack_id );
 
+/**
+ * @brief Create and initialize one of several concurrent file upload sessions
+ *
+ * @remark Sessions are served by weighted round-robin: when several sessions are allowed to send, each one gets a
+ *         share of the uplinks proportional to its \p weight. Each session keeps its own index and pacing, and
+ *         reports its own UPLOADDONE event (see smtc_modem_event_t.event_data.uploaddone.session_id).
+ *         smtc_modem_file_upload_init() is equivalent to this function on session 0 with a weight of 1.
+ *
+ * @param [in] stack_id        Stack identifier
+ * @param [in] session_id      File upload session, from 0 to FILE_UPLOAD_NB_SESSIONS - 1
+ * @param [in] index           Index on which the upload is done
+ * @param [in] cipher_mode     Cipher mode
+ * @param [in] file            File buffer
+ * @param [in] file_length     File size in bytes
+ * @param [in] average_delay_s Minimum delay between two fragments of this session in seconds
+ * @param [in] weight          Scheduling weight of the session (0 is handled as 1)
+ *
+ * @return Modem return code as defined in @ref smtc_modem_return_code_t
+ * @retval SMTC_MODEM_RC_OK                Command executed without errors
+ * @retval SMTC_MODEM_RC_INVALID           \p session_id is not supported, \p file_length is equal to 0 or greater
+ *                                         than 8180 bytes, or \p file is NULL
+ * @retval SMTC_MODEM_RC_BUSY              Modem is currently in test mode, or this session is already ongoing
+ * @retval SMTC_MODEM_RC_INVALID_STACK_ID  Invalid \p stack_id
+ */
+smtc_modem_return_code_t smtc_modem_file_upload_session_init( uint8_t stack_id, uint8_t session_id, uint8_t index,
+                                                              smtc_modem_file_upload_cipher_mode_t cipher_mode,
+                                                              const uint8_t* file, uint16_t file_length,
+                                                              uint32_t average_delay_s, uint8_t weight );
+
+/**
+ * @brief Start a file upload session
+ *
+ * @param [in] stack_id   Stack identifier
+ * @param [in] session_id File upload session
+ *
+ * @return Modem return code as defined in @ref smtc_modem_return_code_t
+ * @retval SMTC_MODEM_RC_OK                Command executed without errors
+ * @retval SMTC_MODEM_RC_INVALID           \p session_id is not supported
+ * @retval SMTC_MODEM_RC_BUSY              Modem is currently in test mode, or this session is already ongoing
+ * @retval SMTC_MODEM_RC_FAIL              Modem is not available (suspended, muted, or not joined)
+ * @retval SMTC_MODEM_RC_NOT_INIT          The session is not initialized
+ * @retval SMTC_MODEM_RC_INVALID_STACK_ID  Invalid \p stack_id
+ */
+smtc_modem_return_code_t smtc_modem_file_upload_session_start( uint8_t stack_id, uint8_t session_id );
+
+/**
+ * @brief Reset a file upload session
+ *
+ * @remark The other sessions are not affected
+ *
+ * @param [in] stack_id   Stack identifier
+ * @param [in] session_id File upload session
+ *
+ * @return Modem return code as defined in @ref smtc_modem_return_code_t
+ * @retval SMTC_MODEM_RC_OK                Command executed without errors
+ * @retval SMTC_MODEM_RC_INVALID           \p session_id is not supported
+ * @retval SMTC_MODEM_RC_NOT_INIT          This session is not running
+ * @retval SMTC_MODEM_RC_BUSY              Modem is currently in test mode
+ * @retval SMTC_MODEM_RC_INVALID_STACK_ID  Invalid \p stack_id
+ */
+smtc_modem_return_code_t smtc_modem_file_upload_session_reset( uint8_t stack_id, uint8_t session_id );
+
 /**
  * @brief Create and initialize a data stream
  *
@@ -1666,6 +1880,28 @@ smtc_modem_return_code_t smtc_modem_lorawan_get_lost_connection_counter( uint8_t
  */
 smtc_modem_return_code_t smtc_modem_get_duty_cycle_status( int32_t* duty_cycle_status_ms );
 
+/**
+ * @brief Forecast the earliest time an uplink is allowed and the duty cycle budget left in each band
+ *
+ * @remark The uplink is assumed to carry \p payload_length bytes with an FPort and no MAC commands. The earliest delay
+ * takes into account the regional duty cycle of the bands of the enabled channels and the network duty cycle
+ * (DutyCycleReq). It does not take into account the activity of the radio planner.
+ *
+ * @param [in]  stack_id        Stack identifier
+ * @param [in]  datarate        LoRaWAN data rate of the uplink
+ * @param [in]  payload_length  Applicative payload length in bytes
+ * @param [out] forecast        Airtime forecast as defined in @ref smtc_modem_airtime_forecast_t
+ *
+ * @return Modem return code as defined in @ref smtc_modem_return_code_t
+ * @retval SMTC_MODEM_RC_OK                Command executed without errors
+ * @retval SMTC_MODEM_RC_INVALID           \p forecast is NULL, \p datarate is not valid or \p payload_length is too
+ *                                         long for \p datarate
+ * @retval SMTC_MODEM_RC_BUSY              Modem is currently in test mode
+ * @retval SMTC_MODEM_RC_INVALID_STACK_ID  Invalid \p stack_id
+ */
+smtc_modem_return_code_t smtc_modem_get_airtime_forecast( uint8_t stack_id, uint8_t datarate, uint8_t payload_length,
+                                                          smtc_modem_airtime_forecast_t* forecast );
+
 /**
  * @brief Get the current state of the stack
  *
@@ -1770,6 +2006,37 @@ smtc_modem_return_code_t smtc_modem_lbt_set_state( uint8_t stack_id, bool enable
  */
 smtc_modem_return_code_t smtc_modem_lbt_get_state( uint8_t stack_id, bool* enabled );
 
+/**
+ * @brief Get the busy/free statistics of the channels listened by the Listen Before Talk (LBT) feature
+ *
+ * @remark When its channel is busy, an uplink is moved to the first free channel among a few enabled candidates, so
+ *         the statistics cover every listened channel.
+ *
+ * @param [in]  stack_id     Stack identifier
+ * @param [out] stats        Statistics of the channels, at least SMTC_MODEM_LBT_CHANNELS_MAX entries
+ * @param [out] nb_channels  Number of valid entries in \p stats
+ *
+ * @return Modem return code as defined in @ref smtc_modem_return_code_t
+ * @retval SMTC_MODEM_RC_OK                Command executed without errors
+ * @retval SMTC_MODEM_RC_INVALID           At least one parameter is NULL
+ * @retval SMTC_MODEM_RC_BUSY              Modem is currently in test mode
+ * @retval SMTC_MODEM_RC_INVALID_STACK_ID  Invalid \p stack_id
+ */
+smtc_modem_return_code_t smtc_modem_lbt_get_channel_stats( uint8_t stack_id, smtc_modem_lbt_channel_stats_t* stats,
+                                                           uint8_t* nb_channels );
+
+/**
+ * @brief Clear the busy/free statistics of the Listen Before Talk (LBT) feature
+ *
+ * @param [in] stack_id  Stack identifier
+ *
+ * @return Modem return code as defined in @ref smtc_modem_return_code_t
+ * @retval SMTC_MODEM_RC_OK                Command executed without errors
+ * @retval SMTC_MODEM_RC_BUSY              Modem is currently in test mode
+ * @retval SMTC_MODEM_RC_INVALID_STACK_ID  Invalid \p stack_id
+ */
+smtc_modem_return_code_t smtc_modem_lbt_clear_channel_stats( uint8_t stack_id );
+
 /**
  * @brief Set the number of transmissions in case of unconfirmed uplink
  *
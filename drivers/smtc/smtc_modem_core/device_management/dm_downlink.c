@@ -227,31 +227,46 @@ dm_rc_t dm_parse_cmd( dm_cmd_msg_t* cmd_input )
         // Not supported yet
         break;
 #if defined( ADD_SMTC_FILE_UPLOAD )
-    case DM_FILE_DONE:
+    case DM_FILE_DONE: {
         SMTC_MODEM_HAL_TRACE_WARNING( "DM_FILE_DONE donwlink\n" );
 
-        if( modem_get_upload_state( ) != MODEM_UPLOAD_ON_GOING )
+        bool is_upload_on_going = false;
+        bool is_session_found   = false;
+
+        // the session counter carried by the frame identifies which on going session is acknowledged
+        for( uint8_t session_id = 0; session_id < FILE_UPLOAD_NB_SESSIONS; session_id++ )
         {
-            SMTC_MODEM_HAL_TRACE_ERROR( "No FileUpload ongoing\n" );
-            break;
+            if( modem_get_upload_state( session_id ) != MODEM_UPLOAD_ON_GOING )
+            {
+                continue;
+            }
+            is_upload_on_going = true;
+
+            // process frame
+            if( file_upload_process_file_done_frame( &( smtc_modem_services_ctx.file_upload_ctx[session_id] ),
+                                                     cmd_input->buffer, cmd_input->buffer_len ) == FILE_UPLOAD_OK )
+            {
+                // file upload is done with server confirmation
+                SMTC_MODEM_HAL_TRACE_INFO( "File upload %d DONE with server confirmation \n", session_id );
+                modem_upload_event_push( SMTC_MODEM_EVENT_UPLOADDONE, session_id,
+                                         SMTC_MODEM_EVENT_UPLOADDONE_SUCCESSFUL );
+                modem_set_upload_state( session_id, MODEM_UPLOAD_FINISHED );
+                modem_supervisor_update_task_file_upload( );
+                is_session_found = true;
+                break;
+            }
         }
 
-        // process frame
-        if( file_upload_process_file_done_frame( &( smtc_modem_services_ctx.file_upload_ctx ), cmd_input->buffer,
-                                                 cmd_input->buffer_len ) != FILE_UPLOAD_OK )
+        if( is_upload_on_going == false )
         {
-            SMTC_MODEM_HAL_TRACE_ERROR( "DM_FILE_DONE bad session_counter or bad message\n" );
+            SMTC_MODEM_HAL_TRACE_ERROR( "No FileUpload ongoing\n" );
         }
-        else
+        else if( is_session_found == false )
         {
-            // file upload is done with server confirmation
-            SMTC_MODEM_HAL_TRACE_INFO( "File upload DONE with server confirmation \n" );
-            increment_asynchronous_msgnumber( SMTC_MODEM_EVENT_UPLOADDONE, 0x01 );
-            set_modem_status_file_upload( false );
-            modem_set_upload_state( MODEM_UPLOAD_FINISHED );
-            modem_supervisor_remove_task( FILE_UPLOAD_TASK );
+            SMTC_MODEM_HAL_TRACE_ERROR( "DM_FILE_DONE bad session_counter or bad message\n" );
         }
         break;
+    }
 #endif  // ADD_SMTC_FILE_UPLOAD
     case DM_GET_INFO:
         if( set_dm_info( cmd_input->buffer, cmd_input->buffer_len, DM_INFO_NOW ) != DM_OK )
@@ -115,7 +115,10 @@ static modem_suspend_status_t is_modem_suspend   = MODEM_NOT_SUSPEND;
 static uint32_t               modem_start_time   = 0;
 #if defined( ADD_SMTC_FILE_UPLOAD )
 static uint8_t              modem_dm_upload_sctr = 0;
-static modem_upload_state_t modem_upload_state   = MODEM_UPLOAD_NOT_INIT;
+static modem_upload_state_t modem_upload_state[FILE_UPLOAD_NB_SESSIONS];
+static uint32_t             modem_upload_next_time_s[FILE_UPLOAD_NB_SESSIONS];
+static uint8_t              modem_upload_event_sessions[2];  // bitmaps of the sessions with a pending event
+static uint8_t              modem_upload_done_status[FILE_UPLOAD_NB_SESSIONS];
 #endif  // ADD_SMTC_FILE_UPLOAD
 #if defined( ADD_SMTC_STREAM )
 static modem_stream_t modem_stream_state = {  //
@@ -180,7 +183,10 @@ struct
     uint32_t                     modem_start_time;
 #if defined( ADD_SMTC_FILE_UPLOAD )
     uint8_t                      modem_dm_upload_sctr;
-    modem_upload_state_t         modem_upload_state;
+    modem_upload_state_t         modem_upload_state[FILE_UPLOAD_NB_SESSIONS];
+    uint32_t                     modem_upload_next_time_s[FILE_UPLOAD_NB_SESSIONS];
+    uint8_t                      modem_upload_event_sessions[2];
+    uint8_t                      modem_upload_done_status[FILE_UPLOAD_NB_SESSIONS];
     uint32_t                     modem_upload_avgdelay;
 #endif  // ADD_SMTC_FILE_UPLOAD
 #if defined( ADD_SMTC_STREAM )
@@ -238,6 +244,9 @@ struct
 #if defined( ADD_SMTC_FILE_UPLOAD )
 #define  modem_dm_upload_sctr                       modem_ctx_context.modem_dm_upload_sctr
 #define  modem_upload_state                         modem_ctx_context.modem_upload_state
+#define  modem_upload_next_time_s                   modem_ctx_context.modem_upload_next_time_s
+#define  modem_upload_event_sessions                modem_ctx_context.modem_upload_event_sessions
+#define  modem_upload_done_status                   modem_ctx_context.modem_upload_done_status
 #endif // ADD_SMTC_FILE_UPLOAD
 #if defined( ADD_SMTC_STREAM )
 #define  modem_stream_state                         modem_ctx_context.modem_stream_state
@@ -371,7 +380,13 @@ void modem_context_init( )
     modem_start_time = 0;
 #if defined( ADD_SMTC_FILE_UPLOAD )
     modem_dm_upload_sctr = 0;
-    modem_upload_state   = MODEM_UPLOAD_NOT_INIT;
+    for( uint8_t i = 0; i < FILE_UPLOAD_NB_SESSIONS; i++ )
+    {
+        modem_upload_state[i]       = MODEM_UPLOAD_NOT_INIT;
+        modem_upload_next_time_s[i] = 0;
+        modem_upload_done_status[i] = 0;
+    }
+    memset( modem_upload_event_sessions, 0, sizeof( modem_upload_event_sessions ) );
 #endif  // ADD_SMTC_FILE_UPLOAD
 #if defined( ADD_SMTC_STREAM )
     modem_stream_state.port       = DEFAULT_DM_PORT;
@@ -626,6 +641,30 @@ dm_rc_t set_modem_region( uint8_t region )
     return DM_OK;
 }
 
+dm_rc_t switch_modem_region( uint8_t region )
+{
+    if( region == get_modem_region( ) )
+    {
+        return DM_OK;
+    }
+    if( smtc_real_is_supported_region( ( smtc_real_region_types_t ) region ) != SMTC_REAL_STATUS_OK )
+    {
+        return DM_ERROR;
+    }
+
+    // The session is bound to the region, leave it but keep keys, DevNonce and statistics
+    if( get_join_state( ) != MODEM_NOT_JOINED )
+    {
+        modem_leave( );
+    }
+
+    if( lorawan_api_switch_region( ( smtc_real_region_types_t ) region ) != OKLORAWAN )
+    {
+        return DM_ERROR;
+    }
+    return DM_OK;
+}
+
 modem_join_state_t get_join_state( void )
 {
     modem_join_state_t joinstate;
@@ -842,13 +881,46 @@ void modem_supervisor_add_task_stream( void )
 #endif  // ADD_SMTC_STREAM
 
 #if defined( ADD_SMTC_FILE_UPLOAD )
-void modem_supervisor_add_task_file_upload( uint32_t delay_in_s )
+void modem_supervisor_add_task_file_upload( uint8_t session_id, uint32_t delay_in_s )
 {
+    if( session_id >= FILE_UPLOAD_NB_SESSIONS )
+    {
+        return;
+    }
+    modem_upload_next_time_s[session_id] = smtc_modem_hal_get_time_in_s( ) + delay_in_s;
+    modem_supervisor_update_task_file_upload( );
+}
+
+void modem_supervisor_update_task_file_upload( void )
+{
+    bool     is_task_needed = false;
+    uint32_t next_time_s    = 0;
+
+    // all sessions share one supervisor task that is armed at the earliest on going session
+    for( uint8_t i = 0; i < FILE_UPLOAD_NB_SESSIONS; i++ )
+    {
+        if( modem_upload_state[i] != MODEM_UPLOAD_ON_GOING )
+        {
+            continue;
+        }
+        if( ( is_task_needed == false ) || ( ( int32_t )( modem_upload_next_time_s[i] - next_time_s ) < 0 ) )
+        {
+            next_time_s = modem_upload_next_time_s[i];
+        }
+        is_task_needed = true;
+    }
+
+    if( is_task_needed == false )
+    {
+        modem_supervisor_remove_task( FILE_UPLOAD_TASK );
+        return;
+    }
+
     smodem_task upload_task;
 
     upload_task.id                = FILE_UPLOAD_TASK;
     upload_task.priority          = TASK_HIGH_PRIORITY;
-    upload_task.time_to_execute_s = smtc_modem_hal_get_time_in_s( ) + delay_in_s;
+    upload_task.time_to_execute_s = next_time_s;
 
     modem_supervisor_add_task( &upload_task );
 }
@@ -986,15 +1058,13 @@ bool get_modem_status_streaming( void )
 void reset_modem_charge( void )
 {
     radio_planner_t* rp = modem_context_get_modem_rp( );
-    rp_stats_init( &rp->stats );
+    rp_get_stats_hooks_snapshot( rp, NULL, true );
 }
 
 uint32_t get_modem_charge_ma_s( void )
 {
     radio_planner_t* rp = modem_context_get_modem_rp( );
-    uint32_t         total_consumption =
-        rp->stats.tx_total_consumption_ma + rp->stats.rx_total_consumption_ma + rp->stats.none_total_consumption_ma;
-    return ( ( total_consumption / 1000 ) + modem_charge_offset );
+    return ( uint32_t ) ( rp_stats_get_total_charge_uas( &rp->stats ) / 1000 ) + modem_charge_offset;
 }
 
 uint32_t get_modem_charge_ma_h( void )
@@ -1727,14 +1797,83 @@ uint8_t modem_context_compute_and_get_next_dm_upload_sctr( void )
     return modem_dm_upload_sctr;
 }
 
-modem_upload_state_t modem_get_upload_state( void )
+modem_upload_state_t modem_get_upload_state( uint8_t session_id )
 {
-    return ( modem_upload_state );
+    if( session_id >= FILE_UPLOAD_NB_SESSIONS )
+    {
+        return MODEM_UPLOAD_NOT_INIT;
+    }
+    return ( modem_upload_state[session_id] );
 }
 
-void modem_set_upload_state( modem_upload_state_t upload_state )
+void modem_set_upload_state( uint8_t session_id, modem_upload_state_t upload_state )
 {
-    modem_upload_state = upload_state;
+    if( session_id >= FILE_UPLOAD_NB_SESSIONS )
+    {
+        return;
+    }
+    modem_upload_state[session_id] = upload_state;
+
+    bool is_upload_on_going = false;
+    for( uint8_t i = 0; i < FILE_UPLOAD_NB_SESSIONS; i++ )
+    {
+        if( modem_upload_state[i] == MODEM_UPLOAD_ON_GOING )
+        {
+            is_upload_on_going = true;
+        }
+    }
+    set_modem_status_file_upload( is_upload_on_going );
+}
+
+uint32_t modem_get_upload_next_time_s( uint8_t session_id )
+{
+    if( session_id >= FILE_UPLOAD_NB_SESSIONS )
+    {
+        return 0;
+    }
+    return ( modem_upload_next_time_s[session_id] );
+}
+
+void modem_upload_event_push( uint8_t event_type, uint8_t session_id, uint8_t status )
+{
+    if( session_id >= FILE_UPLOAD_NB_SESSIONS )
+    {
+        return;
+    }
+    uint8_t index = ( event_type == SMTC_MODEM_EVENT_UPLOADDONE ) ? 0 : 1;
+
+    if( event_type == SMTC_MODEM_EVENT_UPLOADDONE )
+    {
+        modem_upload_done_status[session_id] = status;
+    }
+    if( ( modem_upload_event_sessions[index] & ( 1 << session_id ) ) == 0 )
+    {
+        modem_upload_event_sessions[index] |= ( 1 << session_id );
+        increment_asynchronous_msgnumber( event_type, 0 );
+    }
+}
+
+uint8_t modem_upload_event_pop( uint8_t event_type, uint8_t* session_id, uint8_t* status )
+{
+    uint8_t index        = ( event_type == SMTC_MODEM_EVENT_UPLOADDONE ) ? 0 : 1;
+    uint8_t nb_remaining = 0;
+
+    *session_id = 0;
+    *status     = 0;
+    for( uint8_t i = 0; i < FILE_UPLOAD_NB_SESSIONS; i++ )
+    {
+        if( ( modem_upload_event_sessions[index] & ( 1 << i ) ) == 0 )
+        {
+            continue;
+        }
+        if( nb_remaining++ == 0 )
+        {
+            *session_id = i;
+            *status     = modem_upload_done_status[i];
+            modem_upload_event_sessions[index] &= ~( 1 << i );
+        }
+    }
+    return ( nb_remaining > 0 ) ? nb_remaining - 1 : 0;
 }
 #endif  // ADD_SMTC_FILE_UPLOAD
 
@@ -2105,8 +2244,10 @@ void modem_leave( void )
 
 #if defined( ADD_SMTC_FILE_UPLOAD )
     // Stop and reset file upload service
-    set_modem_status_file_upload( false );
-    modem_set_upload_state( MODEM_UPLOAD_NOT_INIT );
+    for( uint8_t i = 0; i < FILE_UPLOAD_NB_SESSIONS; i++ )
+    {
+        modem_set_upload_state( i, MODEM_UPLOAD_NOT_INIT );
+    }
 #endif  // ADD_SMTC_FILE_UPLOAD
 
 #if defined( ADD_SMTC_STREAM )
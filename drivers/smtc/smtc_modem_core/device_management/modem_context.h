@@ -69,7 +69,7 @@ extern "C" {
 
 #define POWER_CONFIG_LUT_SIZE 6
 
-#define MODEM_NUMBER_OF_EVENTS 0x19  // number of possible events in modem
+#define MODEM_NUMBER_OF_EVENTS 0x1A  // number of possible events in modem
 
 /*
  * -----------------------------------------------------------------------------
@@ -408,6 +408,15 @@ uint8_t get_modem_status( void );
  */
 dm_rc_t set_modem_region( uint8_t region );
 
+/*!
+ * \brief   Switch the region
+ * \remark  Leave the network if needed, the switch does not access the NVM
+ *
+ * \param   [in]    region                      - region
+ * \retval   return                      - dm_rc_t
+ */
+dm_rc_t switch_modem_region( uint8_t region );
+
 /*!
  * \brief   Get the region
  * \remark  This command returns the current regulatory region.
@@ -741,11 +750,19 @@ void modem_supervisor_add_task_stream( void );
 
 #if defined( ADD_SMTC_FILE_UPLOAD )
 /**
- * @brief add a file upload task in scheduler
+ * @brief schedule the next fragment of a file upload session
  *
- * @param [in] delay_in_s The delay in s before task is launched
+ * @remark The supervisor keeps a single file upload task, armed at the earliest pending session
+ *
+ * @param [in] session_id The file upload session
+ * @param [in] delay_in_s The delay in s before the session can send its next fragment
+ */
+void modem_supervisor_add_task_file_upload( uint8_t session_id, uint32_t delay_in_s );
+
+/**
+ * @brief re-arm the file upload task on the earliest on going session, or remove it if none is left
  */
-void modem_supervisor_add_task_file_upload( uint32_t delay_in_s );
+void modem_supervisor_update_task_file_upload( void );
 #endif  // ADD_SMTC_FILE_UPLOAD
 
 /*!
@@ -876,16 +893,51 @@ uint8_t modem_context_compute_and_get_next_dm_upload_sctr( void );
 /**
  * @brief Get modem internal upload state
  *
+ * @param [in] session_id The file upload session
  * @return modem_upload_state_t
  */
-modem_upload_state_t modem_get_upload_state( void );
+modem_upload_state_t modem_get_upload_state( uint8_t session_id );
 
 /**
  * @brief Set modem internal upload state
  *
+ * @remark The file upload bit of the modem status follows the state of all sessions
+ *
+ * @param [in] session_id   The file upload session
  * @param [in] upload_state The upload state
  */
-void modem_set_upload_state( modem_upload_state_t upload_state );
+void modem_set_upload_state( uint8_t session_id, modem_upload_state_t upload_state );
+
+/**
+ * @brief Get the time at which a file upload session is allowed to send its next fragment
+ *
+ * @param [in] session_id The file upload session
+ * @return uint32_t time in s
+ */
+uint32_t modem_get_upload_next_time_s( uint8_t session_id );
+
+/**
+ * @brief Raise the UPLOADDONE or UPLOAD_PROGRESS event of a file upload session
+ *
+ * @remark Events of one type coalesce in a single pending event, the sessions that raised it are kept aside so that
+ *         each one is reported by its own call to smtc_modem_get_event. A session raising the event again before it
+ *         was read only updates its status.
+ *
+ * @param [in] event_type SMTC_MODEM_EVENT_UPLOADDONE or SMTC_MODEM_EVENT_UPLOAD_PROGRESS
+ * @param [in] session_id The file upload session
+ * @param [in] status     The event status (UPLOADDONE only)
+ */
+void modem_upload_event_push( uint8_t event_type, uint8_t session_id, uint8_t status );
+
+/**
+ * @brief Take the pending session with the lowest id of an upload event
+ *
+ * @param [in]  event_type SMTC_MODEM_EVENT_UPLOADDONE or SMTC_MODEM_EVENT_UPLOAD_PROGRESS
+ * @param [out] session_id The file upload session
+ * @param [out] status     The event status (UPLOADDONE only)
+ * @return uint8_t the number of sessions still pending for this event
+ */
+uint8_t modem_upload_event_pop( uint8_t event_type, uint8_t* session_id, uint8_t* status );
 
 /*!
  * \brief    set info_bitfield_periodic
@@ -190,8 +190,16 @@ void lorawan_api_class_c_downlink_callback( lr1mac_class_c_t* class_c_object )
     if( modem_supervisor_update_downlink_frame( class_c_object->rx_payload, class_c_object->rx_payload_size,
                                                 &( class_c_object->rx_metadata ), class_c_object->tx_ack_bit ) )
     {
-        if( fifo_ctrl_set( &fifo_ctrl_obj, class_c_object->rx_payload, class_c_object->rx_payload_size,
-                           &( class_c_object->rx_metadata ), sizeof( lr1mac_down_metadata_t ) ) != FIFO_STATUS_OK )
+        fifo_return_status_t status =
+            fifo_ctrl_set( &fifo_ctrl_obj, class_c_object->rx_payload, class_c_object->rx_payload_size,
+                           &( class_c_object->rx_metadata ), sizeof( lr1mac_down_metadata_t ) );
+
+        if( status == FIFO_STATUS_ELEMENT_BORROWED )
+        {
+            SMTC_MODEM_HAL_TRACE_WARNING( "Fifo full and its oldest downlink is lent, downlink dropped\n" );
+            return;
+        }
+        else if( status != FIFO_STATUS_OK )
         {
             smtc_modem_hal_mcu_panic( "Fifo problem\n" );
             return;
@@ -207,8 +215,16 @@ void lorawan_api_class_b_downlink_callback( smtc_ping_slot_t* class_b_object )
     if( modem_supervisor_update_downlink_frame( class_b_object->rx_payload, class_b_object->rx_payload_size,
                                                 &( class_b_object->rx_metadata ), class_b_object->tx_ack_bit ) )
     {
-        if( fifo_ctrl_set( &fifo_ctrl_obj, class_b_object->rx_payload, class_b_object->rx_payload_size,
-                           &( class_b_object->rx_metadata ), sizeof( lr1mac_down_metadata_t ) ) != FIFO_STATUS_OK )
+        fifo_return_status_t status =
+            fifo_ctrl_set( &fifo_ctrl_obj, class_b_object->rx_payload, class_b_object->rx_payload_size,
+                           &( class_b_object->rx_metadata ), sizeof( lr1mac_down_metadata_t ) );
+
+        if( status == FIFO_STATUS_ELEMENT_BORROWED )
+        {
+            SMTC_MODEM_HAL_TRACE_WARNING( "Fifo full and its oldest downlink is lent, downlink dropped\n" );
+            return;
+        }
+        else if( status != FIFO_STATUS_OK )
         {
             smtc_modem_hal_mcu_panic( "Fifo problem\n" );
             return;
@@ -226,10 +242,17 @@ void lorawan_api_class_b_beacon_callback( smtc_lr1_beacon_t* class_b_beacon_obje
                                                 class_b_beacon_object->beacon_buffer_length,
                                                 &( class_b_beacon_object->beacon_metadata.rx_metadata ), 0 ) )
     {
-        if( fifo_ctrl_set( &fifo_ctrl_obj, class_b_beacon_object->beacon_buffer,
-                           class_b_beacon_object->beacon_buffer_length,
-                           &( class_b_beacon_object->beacon_metadata.rx_metadata ),
-                           sizeof( lr1mac_down_metadata_t ) ) != FIFO_STATUS_OK )
+        fifo_return_status_t status = fifo_ctrl_set( &fifo_ctrl_obj, class_b_beacon_object->beacon_buffer,
+                                                     class_b_beacon_object->beacon_buffer_length,
+                                                     &( class_b_beacon_object->beacon_metadata.rx_metadata ),
+                                                     sizeof( lr1mac_down_metadata_t ) );
+
+        if( status == FIFO_STATUS_ELEMENT_BORROWED )
+        {
+            SMTC_MODEM_HAL_TRACE_WARNING( "Fifo full and its oldest downlink is lent, downlink dropped\n" );
+            return;
+        }
+        else if( status != FIFO_STATUS_OK )
         {
             smtc_modem_hal_mcu_panic( "Fifo problem\n" );
             return;
@@ -262,6 +285,11 @@ status_lorawan_t lorawan_api_set_region( smtc_real_region_types_t region_type )
     return lr1mac_core_set_region( &lr1_mac_obj, region_type );
 }
 
+status_lorawan_t lorawan_api_switch_region( smtc_real_region_types_t region_type )
+{
+    return lr1mac_core_switch_region( &lr1_mac_obj, region_type );
+}
+
 status_lorawan_t lorawan_api_payload_send( uint8_t fport, bool fport_enabled, const uint8_t* data, uint8_t data_len,
                                            uint8_t packet_type, uint32_t target_time_ms )
 {
@@ -477,6 +505,24 @@ int32_t lorawan_api_next_free_duty_cycle_ms_get( void )
     return lr1mac_core_next_free_duty_cycle_ms_get( &lr1_mac_obj );
 }
 
+uint32_t lorawan_api_duty_cycle_period_budget_ms_get( void )
+{
+    return lr1mac_core_duty_cycle_period_budget_ms_get( &lr1_mac_obj );
+}
+
+uint32_t lorawan_api_toa_ms_get( uint8_t data_rate, uint8_t app_payload_size )
+{
+    return lr1mac_core_toa_ms_get( &lr1_mac_obj, data_rate, app_payload_size );
+}
+
+status_lorawan_t lorawan_api_airtime_forecast_get( uint8_t data_rate, uint8_t app_payload_size, uint32_t* toa_ms,
+                                                   uint32_t* earliest_delay_ms, smtc_dtc_band_forecast_t* forecast,
+                                                   uint8_t* number_of_bands )
+{
+    return lr1mac_core_airtime_forecast_get( &lr1_mac_obj, data_rate, app_payload_size, toa_ms, earliest_delay_ms,
+                                             forecast, number_of_bands );
+}
+
 status_lorawan_t lorawan_api_duty_cycle_enable_set( smtc_dtc_enablement_type_t dtc_type )
 {
     if( smtc_duty_cycle_enable_set( lr1_mac_obj.dtc_obj, dtc_type ) == true )
@@ -879,6 +925,16 @@ bool lorawan_api_lbt_get_state( void )
     return smtc_lbt_get_state( &lbt_obj );
 }
 
+uint8_t lorawan_api_lbt_get_channel_stats( smtc_lbt_channel_stats_t* stats )
+{
+    return smtc_lbt_get_channel_stats( &lbt_obj, stats );
+}
+
+void lorawan_api_lbt_clear_channel_stats( void )
+{
+    smtc_lbt_clear_channel_stats( &lbt_obj );
+}
+
 void lorawan_api_class_b_enabled( bool enable )
 {
     smtc_beacon_class_b_enable_service( &lr1_beacon_obj, enable );
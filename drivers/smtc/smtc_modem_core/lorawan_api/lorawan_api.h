@@ -114,6 +114,14 @@ smtc_real_region_types_t lorawan_api_get_region( void );
  */
 status_lorawan_t lorawan_api_set_region( smtc_real_region_types_t region_type );
 
+/**
+ * @brief Switch the current LoRaWAN region without NVM access, the region is stored by the next join request
+ *
+ * @param [in] region_type LoRaWAN region
+ * @return status_lorawan_t The status of the operation
+ */
+status_lorawan_t lorawan_api_switch_region( smtc_real_region_types_t region_type );
+
 /**
  * @brief  Sends an uplink as soon as possible at a chosen time
  *
@@ -394,6 +402,37 @@ uint32_t lorawan_api_next_join_time_second_get( void );
  */
 int32_t lorawan_api_next_free_duty_cycle_ms_get( void );
 
+/**
+ * @brief returns the airtime allowed by the regional duty cycle over one hour on the enabled channels
+ *
+ * @return uint32_t Airtime budget in ms per hour, 0 if no regional duty cycle applies
+ */
+uint32_t lorawan_api_duty_cycle_period_budget_ms_get( void );
+
+/**
+ * @brief returns the time on air of an uplink carrying an applicative payload
+ *
+ * @param [in] data_rate         Data rate of the uplink
+ * @param [in] app_payload_size  Size of the applicative payload in bytes (fopts are not accounted)
+ * @return uint32_t Time on air in ms
+ */
+uint32_t lorawan_api_toa_ms_get( uint8_t data_rate, uint8_t app_payload_size );
+
+/**
+ * @brief returns the earliest uplink allowed by the duty cycle and the budget left in each band
+ *
+ * @param [in]  data_rate           Data rate of the uplink
+ * @param [in]  app_payload_size    Size of the applicative payload in bytes
+ * @param [out] toa_ms              Time on air of the uplink in ms
+ * @param [out] earliest_delay_ms   Time before the uplink is allowed in ms, SMTC_DTC_DELAY_NEVER if never
+ * @param [out] forecast            Forecast of each band of the enabled channels, SMTC_DTC_BANDS_MAX entries
+ * @param [out] number_of_bands     Number of bands written in forecast
+ * @return status_lorawan_t         ERRORLORAWAN if the data rate is not valid or the payload is too long for it
+ */
+status_lorawan_t lorawan_api_airtime_forecast_get( uint8_t data_rate, uint8_t app_payload_size, uint32_t* toa_ms,
+                                                   uint32_t* earliest_delay_ms, smtc_dtc_band_forecast_t* forecast,
+                                                   uint8_t* number_of_bands );
+
 /**
  * @brief Enable / disable the dutycycle
  *
@@ -917,6 +956,19 @@ void lorawan_api_lbt_set_state( bool enable );
  */
 bool lorawan_api_lbt_get_state( void );
 
+/**
+ * @brief Get the busy/free statistics of the channels listened by the lbt service
+ *
+ * @param [out] stats statistics of the channels, at least SMTC_LBT_STATS_NB entries
+ * @return uint8_t number of channels written in stats
+ */
+uint8_t lorawan_api_lbt_get_channel_stats( smtc_lbt_channel_stats_t* stats );
+
+/**
+ * @brief Clear the busy/free statistics of the channels listened by the lbt service
+ */
+void lorawan_api_lbt_clear_channel_stats( void );
+
 /**
  * @brief Enable the class B
  *
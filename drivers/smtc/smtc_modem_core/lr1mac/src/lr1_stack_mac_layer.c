@@ -117,6 +117,7 @@ void lr1_stack_mac_init( lr1_stack_mac_t* lr1_mac, lr1mac_activation_mode_t acti
     lr1_mac->real->region_type                        = region;
     lr1_mac->is_lorawan_modem_certification_enabled   = false;
     lr1_mac->isr_tx_done_radio_timestamp              = 0;
+    lr1_mac->isr_tx_done_radio_timestamp_100us        = 0;
     lr1_mac->dev_nonce                                = 0;
     lr1_mac->nb_of_reset                              = 0;
     lr1_mac->adr_mode_select                          = STATIC_ADR_MODE;
@@ -213,8 +214,54 @@ void lr1_stack_mac_tx_frame_encrypt( lr1_stack_mac_t* lr1_mac )
     }
     lr1_mac->tx_payload_size = lr1_mac->tx_payload_size + 4;
 }
+void lr1_stack_mac_lbt_listen( lr1_stack_mac_t* lr1_mac )
+{
+    lr1_mac->lbt_tx_frequency[0]  = lr1_mac->tx_frequency;
+    lr1_mac->lbt_rx1_frequency[0] = lr1_mac->rx1_frequency;
+    lr1_mac->lbt_channel_nb       = 1;
+
+    // Only the channel of a transmission at time or of a join request is listened
+    if( ( lr1_mac->send_at_time == false ) && ( lr1_mac->join_status == JOINED ) )
+    {
+        // Fallback candidates are listed without drawing channels, the channel selection state is left untouched
+        uint32_t tx_frequency[SMTC_LBT_CHANNELS_MAX];
+        uint32_t rx1_frequency[SMTC_LBT_CHANNELS_MAX];
+        uint8_t  nb = smtc_real_get_tx_channel_list( lr1_mac, lr1_mac->tx_data_rate, tx_frequency, rx1_frequency,
+                                                     SMTC_LBT_CHANNELS_MAX );
+
+        for( uint8_t i = 0; ( i < nb ) && ( lr1_mac->lbt_channel_nb < SMTC_LBT_CHANNELS_MAX ); i++ )
+        {
+            bool is_known = false;
+            for( uint8_t j = 0; j < lr1_mac->lbt_channel_nb; j++ )
+            {
+                if( lr1_mac->lbt_tx_frequency[j] == tx_frequency[i] )
+                {
+                    is_known = true;
+                    break;
+                }
+            }
+            if( is_known == false )
+            {
+                lr1_mac->lbt_tx_frequency[lr1_mac->lbt_channel_nb]  = tx_frequency[i];
+                lr1_mac->lbt_rx1_frequency[lr1_mac->lbt_channel_nb] = rx1_frequency[i];
+                lr1_mac->lbt_channel_nb++;
+            }
+        }
+    }
+
+    smtc_lbt_listen_channels( lr1_mac->lbt_obj, lr1_mac->lbt_tx_frequency, lr1_mac->lbt_channel_nb,
+                              lr1_mac->send_at_time, lr1_mac->rtc_target_timer_ms, lr1_stack_toa_get( lr1_mac ) );
+}
+
 void lr1_stack_mac_tx_radio_free_lbt( lr1_stack_mac_t* lr1_mac )
 {
+    uint8_t channel_index = smtc_lbt_get_channel_index( lr1_mac->lbt_obj );
+
+    if( ( channel_index > 0 ) && ( channel_index < lr1_mac->lbt_channel_nb ) )
+    {
+        lr1_mac->tx_frequency  = lr1_mac->lbt_tx_frequency[channel_index];
+        lr1_mac->rx1_frequency = lr1_mac->lbt_rx1_frequency[channel_index];
+    }
     lr1_mac->radio_process_state = RADIOSTATE_TX_ON;
     lr1_mac->rtc_target_timer_ms = smtc_modem_hal_get_time_in_ms( ) + lr1_mac->rp->margin_delay;
     lr1_mac->send_at_time        = true;
@@ -240,10 +287,7 @@ void lr1_stack_mac_tx_lora_launch_callback_for_rp( void* rp_void )
     smtc_modem_hal_assert( ral_set_pkt_payload( &( rp->radio->ral ), rp->payload[id], rp->payload_size[id] ) ==
                            RAL_STATUS_OK );
     // Wait the exact expected time (ie target - tcxo startup delay)
-    while( ( int32_t )( rp->tasks[id].start_time_ms - smtc_modem_hal_get_time_in_ms( ) ) > 0 )
-    {
-        // Do nothing
-    }
+    rp_task_wait_start( rp, id );
     // At this time only tcxo startup delay is remaining
     smtc_modem_hal_start_radio_tcxo( );
     smtc_modem_hal_assert( ral_set_tx( &( rp->radio->ral ) ) == RAL_STATUS_OK );
@@ -260,9 +304,7 @@ void lr1_stack_mac_tx_gfsk_launch_callback_for_rp( void* rp_void )
     smtc_modem_hal_assert( ral_set_pkt_payload( &( rp->radio->ral ), rp->payload[id], rp->payload_size[id] ) ==
                            RAL_STATUS_OK );
     // Wait the exact expected time (ie target - tcxo startup delay)
-    while( ( int32_t )( rp->tasks[id].start_time_ms - smtc_modem_hal_get_time_in_ms( ) ) > 0 )
-    {
-    }
+    rp_task_wait_start( rp, id );
     // At this time only tcxo startup delay is remaining
     smtc_modem_hal_start_radio_tcxo( );
     smtc_modem_hal_assert( ral_set_tx( &( rp->radio->ral ) ) == RAL_STATUS_OK );
@@ -288,10 +330,7 @@ void lr1_stack_mac_tx_lr_fhss_launch_callback_for_rp( void* rp_void )
                                                     rp->radio_params[id].tx.lr_fhss.hop_sequence_id, rp->payload[id],
                                                     rp->payload_size[id] ) == RAL_STATUS_OK );
     // Wait the exact expected time (ie target - tcxo startup delay)
-    while( ( int32_t )( rp->tasks[id].start_time_ms - smtc_modem_hal_get_time_in_ms( ) ) > 0 )
-    {
-        // Do nothing
-    }
+    rp_task_wait_start( rp, id );
     // At this time only tcxo startup delay is remaining
     smtc_modem_hal_start_radio_tcxo( );
     smtc_modem_hal_assert( ral_set_tx( &( rp->radio->ral ) ) == RAL_STATUS_OK );
@@ -308,9 +347,7 @@ void lr1_stack_mac_rx_lora_launch_callback_for_rp( void* rp_void )
                                                                             RAL_IRQ_RX_HDR_ERROR |
                                                                             RAL_IRQ_RX_CRC_ERROR ) == RAL_STATUS_OK );
     // Wait the exact expected time (ie target - tcxo startup delay)
-    while( ( int32_t )( rp->tasks[id].start_time_ms - smtc_modem_hal_get_time_in_ms( ) ) > 0 )
-    {
-    }
+    rp_task_wait_start( rp, id );
     // At this time only tcxo startup delay is remaining
     smtc_modem_hal_start_radio_tcxo( );
     smtc_modem_hal_assert( ral_set_rx( &( rp->radio->ral ), rp->radio_params[id].rx.timeout_in_ms ) == RAL_STATUS_OK );
@@ -326,9 +363,7 @@ void lr1_stack_mac_rx_gfsk_launch_callback_for_rp( void* rp_void )
     smtc_modem_hal_assert( ral_set_dio_irq_params( &( rp->radio->ral ), RAL_IRQ_RX_DONE | RAL_IRQ_RX_TIMEOUT |
                                                                             RAL_IRQ_RX_CRC_ERROR ) == RAL_STATUS_OK );
     // Wait the exact expected time (ie target - tcxo startup delay)
-    while( ( int32_t )( rp->tasks[id].start_time_ms - smtc_modem_hal_get_time_in_ms( ) ) > 0 )
-    {
-    }
+    rp_task_wait_start( rp, id );
     // At this time only tcxo startup delay is remaining
     smtc_modem_hal_start_radio_tcxo( );
     smtc_modem_hal_assert( ral_set_rx( &( rp->radio->ral ), rp->radio_params[id].rx.timeout_in_ms ) == RAL_STATUS_OK );
@@ -481,7 +516,8 @@ void lr1_stack_mac_tx_radio_start( lr1_stack_mac_t* lr1_mac )
     }
 }
 
-void lr1_stack_mac_rx_radio_start( lr1_stack_mac_t* lr1_mac, const rx_win_type_t type, const uint32_t time_to_start )
+void lr1_stack_mac_rx_radio_start( lr1_stack_mac_t* lr1_mac, const rx_win_type_t type, const uint32_t time_to_start,
+                                   const uint32_t time_to_start_100us )
 {
     uint32_t          rx_frequency       = 0;
     uint8_t           rx_datarate        = lr1_mac->rx_data_rate;
@@ -581,6 +617,7 @@ void lr1_stack_mac_rx_radio_start( lr1_stack_mac_t* lr1_mac, const rx_win_type_t
                                      : lr1_stack_mac_rx_gfsk_launch_callback_for_rp,
         .state            = RP_TASK_STATE_SCHEDULE,
         .start_time_ms    = time_to_start,
+        .start_time_100us = time_to_start_100us,
         .duration_time_ms = lr1_mac->rx_timeout_symb_in_ms,
     };
 
@@ -620,7 +657,8 @@ void lr1_stack_mac_rp_callback( lr1_stack_mac_t* lr1_mac )
     switch( lr1_mac->planner_status )
     {
     case RP_STATUS_TX_DONE:
-        lr1_mac->isr_tx_done_radio_timestamp = tcurrent_ms;  //@info Timestamp only on txdone it
+        lr1_mac->isr_tx_done_radio_timestamp       = tcurrent_ms;  //@info Timestamp only on txdone it
+        lr1_mac->isr_tx_done_radio_timestamp_100us = lr1_mac->rp->irq_timestamp_100us[my_hook_id];
         break;
 
     case RP_STATUS_RX_PACKET:
@@ -793,7 +831,12 @@ void lr1_stack_mac_rx_timer_configure( lr1_stack_mac_t* lr1_mac, const rx_win_ty
         }
         else
         {
-            lr1_stack_mac_rx_radio_start( lr1_mac, type, tcurrent_ms + talarm_ms + lr1_mac->rx_offset_ms );
+            // The rx window is timed from the tx done in 100us, the offset keeps its ms resolution
+            uint32_t time_to_start_100us =
+                lr1_mac->isr_tx_done_radio_timestamp_100us + ( ( delay_ms + lr1_mac->rx_offset_ms ) * 10 );
+
+            lr1_stack_mac_rx_radio_start( lr1_mac, type, tcurrent_ms + talarm_ms + lr1_mac->rx_offset_ms,
+                                          ( time_to_start_100us == 0 ) ? 1 : time_to_start_100us );
             SMTC_MODEM_HAL_TRACE_PRINTF( "  Timer will expire in %d ms\n", ( talarm_ms + lr1_mac->rx_offset_ms ) );
         }
     }
@@ -1446,17 +1489,21 @@ int32_t lr1_stack_network_next_free_duty_cycle_ms_get( lr1_stack_mac_t* lr1_mac
 }
 
 uint32_t lr1_stack_toa_get( lr1_stack_mac_t* lr1_mac )
+{
+    return lr1_stack_toa_compute( lr1_mac, lr1_mac->tx_data_rate, lr1_mac->tx_payload_size );
+}
+
+uint32_t lr1_stack_toa_compute( lr1_stack_mac_t* lr1_mac, uint8_t data_rate, uint8_t payload_size )
 {
     uint32_t toa = 0;
 
-    modulation_type_t tx_modulation_type =
-        smtc_real_get_modulation_type_from_datarate( lr1_mac, lr1_mac->tx_data_rate );
+    modulation_type_t tx_modulation_type = smtc_real_get_modulation_type_from_datarate( lr1_mac, data_rate );
 
     if( tx_modulation_type == LORA )
     {
         uint8_t            tx_sf;
         lr1mac_bandwidth_t tx_bw;
-        smtc_real_lora_dr_to_sf_bw( lr1_mac, lr1_mac->tx_data_rate, &tx_sf, &tx_bw );
+        smtc_real_lora_dr_to_sf_bw( lr1_mac, data_rate, &tx_sf, &tx_bw );
 
         ralf_params_lora_t lora_param;
         memset( &lora_param, 0, sizeof( ralf_params_lora_t ) );
@@ -1468,7 +1515,7 @@ uint32_t lr1_stack_toa_get( lr1_stack_mac_t* lr1_mac )
 
         lora_param.pkt_params.crc_is_on            = true;
         lora_param.pkt_params.invert_iq_is_on      = false;
-        lora_param.pkt_params.pld_len_in_bytes     = lr1_mac->tx_payload_size;
+        lora_param.pkt_params.pld_len_in_bytes     = payload_size;
         lora_param.pkt_params.preamble_len_in_symb = smtc_real_get_preamble_len( lr1_mac, lora_param.mod_params.sf );
         lora_param.pkt_params.header_type          = RAL_LORA_PKT_EXPLICIT;
 
@@ -1478,7 +1525,7 @@ uint32_t lr1_stack_toa_get( lr1_stack_mac_t* lr1_mac )
     else if( tx_modulation_type == FSK )
     {
         uint8_t tx_bitrate;
-        smtc_real_fsk_dr_to_bitrate( lr1_mac, lr1_mac->tx_data_rate, &tx_bitrate );
+        smtc_real_fsk_dr_to_bitrate( lr1_mac, data_rate, &tx_bitrate );
 
         ralf_params_gfsk_t gfsk_param;
         memset( &gfsk_param, 0, sizeof( ralf_params_gfsk_t ) );
@@ -1492,7 +1539,7 @@ uint32_t lr1_stack_toa_get( lr1_stack_mac_t* lr1_mac )
         gfsk_param.mod_params.fdev_in_hz            = 25000;
         gfsk_param.mod_params.br_in_bps             = tx_bitrate * 1000;
         gfsk_param.mod_params.bw_dsb_in_hz          = 100000;
-        gfsk_param.pkt_params.pld_len_in_bytes      = lr1_mac->tx_payload_size;
+        gfsk_param.pkt_params.pld_len_in_bytes      = payload_size;
         gfsk_param.pkt_params.preamble_len_in_bits  = 40;
         gfsk_param.pkt_params.header_type           = RAL_GFSK_PKT_VAR_LEN;
         gfsk_param.pkt_params.sync_word_len_in_bits = 24;
@@ -1506,7 +1553,7 @@ uint32_t lr1_stack_toa_get( lr1_stack_mac_t* lr1_mac )
     {
         lr_fhss_v1_cr_t tx_cr;
         lr_fhss_v1_bw_t tx_bw;
-        smtc_real_lr_fhss_dr_to_cr_bw( lr1_mac, lr1_mac->tx_data_rate, &tx_cr, &tx_bw );
+        smtc_real_lr_fhss_dr_to_cr_bw( lr1_mac, data_rate, &tx_cr, &tx_bw );
 
         ralf_params_lr_fhss_t lr_fhss_param;
         memset( &lr_fhss_param, 0, sizeof( ralf_params_lr_fhss_t ) );
@@ -1516,7 +1563,7 @@ uint32_t lr1_stack_toa_get( lr1_stack_mac_t* lr1_mac )
         lr_fhss_param.ral_lr_fhss_params.lr_fhss_params.header_count   = smtc_real_lr_fhss_get_header_count( tx_cr );
 
         ral_lr_fhss_get_time_on_air_in_ms( ( &lr1_mac->rp->radio->ral ), &lr_fhss_param.ral_lr_fhss_params,
-                                           lr1_mac->tx_payload_size, &toa );
+                                           payload_size, &toa );
     }
     else
     {
@@ -1817,7 +1864,7 @@ static void rx_param_setup_parser( lr1_stack_mac_t* lr1_mac )
     uint8_t rx1_dr_offset_temp = ( lr1_mac->nwk_payload[lr1_mac->nwk_payload_index + 1] & 0x70 ) >> 4;
     if( smtc_real_is_rx1_dr_offset_valid( lr1_mac, rx1_dr_offset_temp ) == ERRORLORAWAN )
     {
-        status_ans &= 0x6;
+        status_ans &= 0x3;
         SMTC_MODEM_HAL_TRACE_MSG( "INVALID RX1DROFFSET\n" );
     }
 
@@ -1835,7 +1882,7 @@ static void rx_param_setup_parser( lr1_stack_mac_t* lr1_mac )
 
     if( smtc_real_is_frequency_valid( lr1_mac, rx2_frequency_temp ) == ERRORLORAWAN )
     {
-        status_ans &= 0x3;
+        status_ans &= 0x6;
         SMTC_MODEM_HAL_TRACE_MSG( "INVALID RX2 FREQUENCY\n" );
     }
 
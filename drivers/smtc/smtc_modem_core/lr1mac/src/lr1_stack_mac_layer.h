@@ -177,6 +177,9 @@ typedef struct lr1_stack_mac_s
 
     uint32_t      tx_frequency;
     uint32_t      rx1_frequency;
+    uint32_t      lbt_tx_frequency[SMTC_LBT_CHANNELS_MAX];   // candidate channels of the listen before talk
+    uint32_t      lbt_rx1_frequency[SMTC_LBT_CHANNELS_MAX];  // rx1 frequencies of the candidate channels
+    uint8_t       lbt_channel_nb;
     uint8_t       rx_data_rate;
     uint8_t       sync_word;
     rx_win_type_t current_win;
@@ -192,6 +195,7 @@ typedef struct lr1_stack_mac_s
     rp_status_t            planner_status;
     lr1mac_down_metadata_t rx_metadata;
     uint32_t               isr_tx_done_radio_timestamp;
+    uint32_t               isr_tx_done_radio_timestamp_100us;
     int16_t                fine_tune_board_setting_delay_ms[16];
     int32_t                rx_offset_ms;
     uint32_t               timestamp_failsafe;
@@ -284,6 +288,14 @@ void lr1_stack_mac_tx_radio_start( lr1_stack_mac_t* lr1_mac );
  */
 void lr1_stack_mac_tx_radio_free_lbt( lr1_stack_mac_t* lr1_mac );
 
+/*!
+ * \brief   Listen the tx channel before transmitting, with fallback channels drawn among the enabled ones once joined
+ * \remark  The tx channel is replaced by the first free candidate in lr1_stack_mac_tx_radio_free_lbt
+ * \param [IN]  lr1_mac
+ * \param [OUT] return
+ */
+void lr1_stack_mac_lbt_listen( lr1_stack_mac_t* lr1_mac );
+
 /*!
  * \brief
  * \remark
@@ -299,12 +311,15 @@ void lr1_stack_mac_radio_busy_lbt( lr1_stack_mac_t* lr1_mac );
  */
 void lr1_stack_mac_radio_abort_lbt( lr1_stack_mac_t* lr1_mac );
 /*!
- * \brief
- * \remark
- * \param [IN]  none
- * \param [OUT] return
+ * \brief   Enqueue the radio planner task of an rx window
+ * \remark  time_to_start_100us gives the radio planner a 100us resolution start, 0 if the window is only timed in ms
+ * \param [IN]  lr1_mac             lr1mac object
+ * \param [IN]  type                RX1 or RX2
+ * \param [IN]  time_to_start       start time of the window in ms
+ * \param [IN]  time_to_start_100us start time of the window in 100us
  */
-void lr1_stack_mac_rx_radio_start( lr1_stack_mac_t* lr1_mac, const rx_win_type_t type, const uint32_t time_to_start );
+void lr1_stack_mac_rx_radio_start( lr1_stack_mac_t* lr1_mac, const rx_win_type_t type, const uint32_t time_to_start,
+                                   const uint32_t time_to_start_100us );
 
 /*!
  * \brief
@@ -380,6 +395,16 @@ int32_t lr1_stack_network_next_free_duty_cycle_ms_get( lr1_stack_mac_t* lr1_mac
  */
 uint32_t lr1_stack_toa_get( lr1_stack_mac_t* lr1_mac );
 
+/*!
+ * \brief lr1_stack_toa_compute
+ * \remark Same computation as lr1_stack_toa_get but for any data rate and frame size
+ * \param [IN]  lr1_stack_mac_t
+ * \param [IN]  data_rate       data rate of the frame
+ * \param [IN]  payload_size    size of the whole PHY payload (MHDR to MIC)
+ * \return toa of the frame in ms
+ */
+uint32_t lr1_stack_toa_compute( lr1_stack_mac_t* lr1_mac, uint8_t data_rate, uint8_t payload_size );
+
 /**
  * @brief
  *
@@ -367,9 +367,7 @@ void smtc_beacon_sniff_launch_callback_for_rp( void* rp_void )
                                                                             RAL_IRQ_RX_HDR_ERROR |
                                                                             RAL_IRQ_RX_CRC_ERROR ) == RAL_STATUS_OK );
     // Wait the exact time
-    while( ( int32_t )( rp->tasks[id].start_time_ms - smtc_modem_hal_get_time_in_ms( ) ) > 0 )
-    {
-    }
+    rp_task_wait_start( rp, id );
     smtc_modem_hal_assert( ral_set_rx( &( rp->radio->ral ), rp->radio_params[id].rx.timeout_in_ms ) == RAL_STATUS_OK );
     rp_stats_set_rx_timestamp( &rp->stats, smtc_modem_hal_get_time_in_ms( ) );
 }
@@ -272,6 +272,8 @@ void lr1mac_class_c_launch( lr1mac_class_c_t* class_c_obj )
     rp_task.state            = RP_TASK_STATE_ASAP;
     rp_task.start_time_ms    = smtc_modem_hal_get_time_in_ms( );
     rp_task.duration_time_ms = LR1MAC_RCX_MIN_DURATION_MS;
+    // The continuous RX is resumed after the tasks which preempt it
+    rp_task.suspendable = true;
 
     if( rp_radio_params.pkt_type == RAL_PKT_TYPE_LORA )
     {
@@ -89,6 +89,8 @@ static void        copy_user_payload( lr1_stack_mac_t* lr1_mac_obj, const uint8_
 static void        lr1mac_mac_update( lr1_stack_mac_t* lr1_mac_obj );
 static void        save_devnonce_rst( const lr1_stack_mac_t* lr1_mac_obj );
 static void        load_devnonce_reset( lr1_stack_mac_t* lr1_mac_obj );
+static void        save_duty_cycle( lr1_stack_mac_t* lr1_mac_obj );
+static void        load_duty_cycle( lr1_stack_mac_t* lr1_mac_obj );
 static void        try_recover_nvm( lr1_stack_mac_t* lr1_mac_obj );
 /*
  *-----------------------------------------------------------------------------------
@@ -164,11 +166,15 @@ void lr1mac_core_init( lr1_stack_mac_t* lr1_mac_obj, smtc_real_t* real, smtc_lbt
                   ( lr1_mac_obj ) );
     SMTC_MODEM_HAL_TRACE_PRINTF_DEBUG( "rp_hook_init done\n" );
 
+    smtc_duty_cycle_init( lr1_mac_obj->dtc_obj );
     smtc_real_config( lr1_mac_obj );
     SMTC_MODEM_HAL_TRACE_PRINTF_DEBUG( "smtc_real_config done\n" );
     smtc_real_init( lr1_mac_obj );
     SMTC_MODEM_HAL_TRACE_PRINTF_DEBUG( "smtc_real_init done\n" );
 
+    // Restore the duty cycle consumed before the reset, the bands are configured by smtc_real_config
+    load_duty_cycle( lr1_mac_obj );
+
     // Initialize here adr_ack_limit_init and adr_ack_delay_init which are real dependant and must be updated after the
     // real is initialized and not reinit after the join accept
     lr1_mac_obj->adr_ack_limit_init = smtc_real_get_adr_ack_limit( lr1_mac_obj );
@@ -265,8 +271,7 @@ lr1mac_states_t lr1mac_core_process( lr1_stack_mac_t* lr1_mac_obj )
 
             if( smtc_lbt_get_state( lr1_mac_obj->lbt_obj ) == true )
             {
-                smtc_lbt_listen_channel( ( lr1_mac_obj->lbt_obj ), lr1_mac_obj->tx_frequency, lr1_mac_obj->send_at_time,
-                                         lr1_mac_obj->rtc_target_timer_ms, lr1_stack_toa_get( lr1_mac_obj ) );
+                lr1_stack_mac_lbt_listen( lr1_mac_obj );
             }
             else
             {
@@ -291,6 +296,10 @@ lr1mac_states_t lr1mac_core_process( lr1_stack_mac_t* lr1_mac_obj )
             lr1_stack_mac_update_tx_done( lr1_mac_obj );
             smtc_duty_cycle_sum( lr1_mac_obj->dtc_obj, lr1_mac_obj->tx_frequency,
                                  lr1_mac_obj->rp->stats.tx_last_toa_ms[myhook_id] );
+            if( smtc_duty_cycle_is_context_store_needed( lr1_mac_obj->dtc_obj ) == true )
+            {
+                save_duty_cycle( lr1_mac_obj );
+            }
 
             break;
 
@@ -832,6 +841,62 @@ int32_t lr1mac_core_next_free_duty_cycle_ms_get( lr1_stack_mac_t* lr1_mac_obj )
     return ret;
 }
 
+uint32_t lr1mac_core_duty_cycle_period_budget_ms_get( lr1_stack_mac_t* lr1_mac_obj )
+{
+    uint8_t  number_of_freq = 0;
+    uint8_t  max_size       = 16;
+    uint32_t freq_list[16]  = { 0 };  // Generally region with duty cycle support 16 channels only
+
+    if( ( smtc_real_is_dtc_supported( lr1_mac_obj ) == true ) &&
+        ( smtc_real_get_current_enabled_frequency_list( lr1_mac_obj, &number_of_freq, freq_list, max_size ) == true ) )
+    {
+        return smtc_duty_cycle_get_period_budget_ms( lr1_mac_obj->dtc_obj, number_of_freq, freq_list );
+    }
+    return 0;
+}
+
+uint32_t lr1mac_core_toa_ms_get( lr1_stack_mac_t* lr1_mac_obj, uint8_t data_rate, uint8_t app_payload_size )
+{
+    // MHDR + FHDR without fopts, FPort and MIC
+    return lr1_stack_toa_compute( lr1_mac_obj, data_rate, app_payload_size + FHDROFFSET + 1 + MICSIZE );
+}
+
+status_lorawan_t lr1mac_core_airtime_forecast_get( lr1_stack_mac_t* lr1_mac_obj, uint8_t data_rate,
+                                                   uint8_t app_payload_size, uint32_t* toa_ms,
+                                                   uint32_t* earliest_delay_ms, smtc_dtc_band_forecast_t* forecast,
+                                                   uint8_t* number_of_bands )
+{
+    uint8_t  number_of_freq = 0;
+    uint8_t  max_size       = 16;
+    uint32_t freq_list[16]  = { 0 };  // Generally region with duty cycle support 16 channels only
+
+    if( ( smtc_real_is_tx_dr_valid( lr1_mac_obj, data_rate ) != OKLORAWAN ) ||
+        ( ( app_payload_size + FHDROFFSET ) >
+          smtc_real_get_max_payload_size( lr1_mac_obj, data_rate, lr1_mac_obj->uplink_dwell_time ) ) )
+    {
+        return ERRORLORAWAN;
+    }
+
+    *toa_ms            = lr1mac_core_toa_ms_get( lr1_mac_obj, data_rate, app_payload_size );
+    *earliest_delay_ms = 0;
+    *number_of_bands   = 0;
+
+    if( ( smtc_real_is_dtc_supported( lr1_mac_obj ) == true ) &&
+        ( smtc_real_get_current_enabled_frequency_list( lr1_mac_obj, &number_of_freq, freq_list, max_size ) == true ) )
+    {
+        smtc_duty_cycle_update( lr1_mac_obj->dtc_obj );
+        *earliest_delay_ms = smtc_duty_cycle_get_forecast( lr1_mac_obj->dtc_obj, number_of_freq, freq_list, *toa_ms,
+                                                           forecast, number_of_bands );
+    }
+
+    int32_t nwk_dtc = lr1_stack_network_next_free_duty_cycle_ms_get( lr1_mac_obj );
+    if( ( nwk_dtc > 0 ) && ( *earliest_delay_ms != SMTC_DTC_DELAY_NEVER ) )
+    {
+        *earliest_delay_ms = MAX( *earliest_delay_ms, ( uint32_t ) nwk_dtc );
+    }
+    return OKLORAWAN;
+}
+
 uint8_t lr1mac_core_rx_ack_bit_get( lr1_stack_mac_t* lr1_mac_obj )
 {
     return ( lr1_mac_obj->rx_ack_bit );
@@ -862,6 +927,38 @@ status_lorawan_t lr1mac_core_set_region( lr1_stack_mac_t* lr1_mac_obj, smtc_real
     return ERRORLORAWAN;
 }
 
+status_lorawan_t lr1mac_core_switch_region( lr1_stack_mac_t* lr1_mac_obj, smtc_real_region_types_t region_type )
+{
+    if( smtc_real_is_supported_region( region_type ) != SMTC_REAL_STATUS_OK )
+    {
+        return ERRORLORAWAN;
+    }
+    if( lr1_mac_obj->real->region_type == region_type )
+    {
+        return OKLORAWAN;
+    }
+
+#if MODEM_HAL_DBG_TRACE == MODEM_HAL_FEATURE_ON
+    uint32_t start_time_ms = smtc_modem_hal_get_time_in_ms( );
+#endif
+
+    // Region constants and operations are const tables: the switch only rebinds them and rebuilds the channel plan.
+    // Keys, DevNonce and statistics are kept, as the airtime of the duty cycle bands shared by both regions
+    lr1_mac_obj->real->region_type = region_type;
+    smtc_real_config( lr1_mac_obj );
+    smtc_real_init( lr1_mac_obj );
+    lr1_mac_obj->retry_join_cpt = 0;
+
+    // Store the region so a reset does not restart in the previous one, only the region changed in the context
+    lr1mac_core_context_save( lr1_mac_obj );
+
+#if MODEM_HAL_DBG_TRACE == MODEM_HAL_FEATURE_ON
+    SMTC_MODEM_HAL_TRACE_PRINTF( "Region switched to %s in %u ms\n", smtc_real_region_list_str[region_type],
+                                 smtc_modem_hal_get_time_in_ms( ) - start_time_ms );
+#endif
+    return OKLORAWAN;
+}
+
 void lr1mac_core_set_no_rx_packet_threshold( lr1_stack_mac_t* lr1_mac_obj, uint16_t no_rx_packet_reset_threshold )
 {
     lr1_mac_obj->no_rx_packet_reset_threshold = no_rx_packet_reset_threshold;
@@ -1256,6 +1353,28 @@ static void load_devnonce_reset( lr1_stack_mac_t* lr1_mac_obj )
     }
 }
 
+static void save_duty_cycle( lr1_stack_mac_t* lr1_mac_obj )
+{
+    smtc_dtc_context_t ctx;
+
+    smtc_duty_cycle_context_get( lr1_mac_obj->dtc_obj, &ctx );
+    ctx.crc = lr1mac_utilities_crc( ( uint8_t* ) &ctx, sizeof( ctx ) - 4 );
+
+    smtc_modem_hal_context_store( CONTEXT_DUTY_CYCLE, ( uint8_t* ) &ctx, sizeof( ctx ) );
+}
+
+static void load_duty_cycle( lr1_stack_mac_t* lr1_mac_obj )
+{
+    smtc_dtc_context_t ctx = { 0 };
+    smtc_modem_hal_context_restore( CONTEXT_DUTY_CYCLE, ( uint8_t* ) &ctx, sizeof( ctx ) );
+
+    if( ( lr1mac_utilities_crc( ( uint8_t* ) &ctx, sizeof( ctx ) - 4 ) == ctx.crc ) &&
+        ( smtc_duty_cycle_context_set( lr1_mac_obj->dtc_obj, &ctx ) == true ) )
+    {
+        SMTC_MODEM_HAL_TRACE_PRINTF( " Duty cycle restored\n" );
+    }
+}
+
 static void try_recover_nvm( lr1_stack_mac_t* lr1_mac_obj )
 {
     SMTC_MODEM_HAL_TRACE_PRINTF( "Lr1mac context : Try recover NVM\n" );
@@ -379,6 +379,44 @@ uint32_t lr1mac_core_next_join_time_second_get( lr1_stack_mac_t* lr1_mac_obj );
  */
 int32_t lr1mac_core_next_free_duty_cycle_ms_get( lr1_stack_mac_t* lr1_mac_obj );
 
+/**
+ * @brief Get the airtime allowed by the regional duty cycle over one hour on the enabled channels
+ *
+ * @param lr1_mac_obj
+ * @return uint32_t milliseconds per hour, 0 if no regional duty cycle applies
+ */
+uint32_t lr1mac_core_duty_cycle_period_budget_ms_get( lr1_stack_mac_t* lr1_mac_obj );
+
+/**
+ * @brief Get the time on air of an uplink carrying an applicative payload (FPort present, no fopts)
+ *
+ * @param lr1_mac_obj
+ * @param data_rate         Data rate of the uplink
+ * @param app_payload_size  Size of the applicative payload in bytes
+ * @return uint32_t time on air in ms
+ */
+uint32_t lr1mac_core_toa_ms_get( lr1_stack_mac_t* lr1_mac_obj, uint8_t data_rate, uint8_t app_payload_size );
+
+/**
+ * @brief Forecast the earliest uplink allowed by the duty cycle and the budget left in each band
+ *
+ * @remark The earliest delay includes the network duty cycle (DutyCycleReq), only the bands of the enabled channels
+ *         are reported
+ *
+ * @param lr1_mac_obj
+ * @param data_rate             Data rate of the uplink
+ * @param app_payload_size      Size of the applicative payload in bytes
+ * @param toa_ms                Time on air of the uplink in ms
+ * @param earliest_delay_ms     Time before the uplink is allowed in ms, SMTC_DTC_DELAY_NEVER if never
+ * @param forecast              Forecast of each band, SMTC_DTC_BANDS_MAX entries
+ * @param number_of_bands       Number of bands written in forecast, 0 if no regional duty cycle applies
+ * @return status_lorawan_t     ERRORLORAWAN if the data rate is not valid or the payload is too long for it
+ */
+status_lorawan_t lr1mac_core_airtime_forecast_get( lr1_stack_mac_t* lr1_mac_obj, uint8_t data_rate,
+                                                   uint8_t app_payload_size, uint32_t* toa_ms,
+                                                   uint32_t* earliest_delay_ms, smtc_dtc_band_forecast_t* forecast,
+                                                   uint8_t* number_of_bands );
+
 /**
  * @brief Get the Rx network ACK bit status
  *
@@ -412,6 +450,20 @@ smtc_real_region_types_t lr1mac_core_get_region( lr1_stack_mac_t* lr1_mac_obj );
  */
 status_lorawan_t lr1mac_core_set_region( lr1_stack_mac_t* lr1_mac_obj, smtc_real_region_types_t region_type );
 
+/**
+ * @brief Switch the region, keeping the state that does not depend on it
+ *
+ * @remark Only the region constants, operations and channel plan are rebuilt, the cost is bounded by the number of
+ *         channels of the target region and by the NVM write of the new region. Keys, DevNonce, statistics and the
+ *         duty cycle airtime of the bands shared by both regions are kept. Switching to the current region does
+ *         nothing.
+ *
+ * @param lr1_mac_obj
+ * @param region_type
+ * @return status_lorawan_t
+ */
+status_lorawan_t lr1mac_core_switch_region( lr1_stack_mac_t* lr1_mac_obj, smtc_real_region_types_t region_type );
+
 /**
  * @brief Set the number of consecutive uplink packet without downlink to concidere the stack out of range
  *
@@ -160,6 +160,47 @@ uint8_t SMTC_ARE_CLR_BYTE8( uint8_t* array, uint8_t length )
     return true;
 }
 
+uint8_t SMTC_COUNT_BIT8( const uint8_t* array, uint8_t length )
+{
+    uint8_t count = 0;
+    for( uint8_t i = 0; i < length; i++ )
+    {
+        // Clear the lowest set bit until the byte is empty
+        for( uint8_t byte = array[i]; byte != 0; byte &= ( byte - 1 ) )
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+uint8_t SMTC_GET_NTH_SET_BIT8( const uint8_t* array, uint8_t length, uint8_t n )
+{
+    for( uint8_t i = 0; i < length; i++ )
+    {
+        uint8_t byte = array[i];
+        // Skip the whole byte when the wanted bit is further
+        uint8_t byte_count = SMTC_COUNT_BIT8( &byte, 1 );
+        if( n >= byte_count )
+        {
+            n -= byte_count;
+            continue;
+        }
+        for( uint8_t j = 0; j < 8; j++ )
+        {
+            if( ( byte >> j ) & 0x01 )
+            {
+                if( n == 0 )
+                {
+                    return ( i * 8 ) + j;
+                }
+                n--;
+            }
+        }
+    }
+    return 0xFF;  // less than n + 1 bits set
+}
+
 uint8_t SMTC_GET_BIT16( const uint16_t* array, uint8_t index )
 {
     return ( ( ( ( array )[( index ) / 16] ) >> ( ( index ) % 16 ) ) & 0x01 );
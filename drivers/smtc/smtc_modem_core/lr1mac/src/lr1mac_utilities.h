@@ -85,6 +85,8 @@ void    SMTC_SET_BIT8( uint8_t* array, uint8_t index );
 void    SMTC_CLR_BIT8( uint8_t* array, uint8_t index );
 void    SMTC_PUT_BIT8( uint8_t* array, uint8_t index, uint8_t bit );
 uint8_t SMTC_ARE_CLR_BYTE8( uint8_t* array, uint8_t length );
+uint8_t SMTC_COUNT_BIT8( const uint8_t* array, uint8_t length );
+uint8_t SMTC_GET_NTH_SET_BIT8( const uint8_t* array, uint8_t length, uint8_t n );
 
 uint8_t SMTC_GET_BIT16( const uint16_t* array, uint8_t index );
 void    SMTC_SET_BIT16( uint16_t* array, uint8_t index );
@@ -100,7 +100,7 @@ static inline uint8_t smtc_duty_cycle_compute_index( uint32_t timestamp_ms, uint
 /**
  * @brief Compute Diff between the two timestamp and manage wrapping
  *
- * @remark the Second parameter is rounded to the begin of an index
+ * @remark the Second parameter is the beginning of an index: the indexes keep the same alignment when rtc_ms wraps
  *
  * @param rtc_ms                    RTC ms
  * @param timestamp_ms              Timestamp ms
@@ -108,6 +108,84 @@ static inline uint8_t smtc_duty_cycle_compute_index( uint32_t timestamp_ms, uint
  */
 static inline uint32_t smtc_duty_cycle_time_diff( uint32_t rtc_ms, uint32_t timestamp_ms );
 
+/**
+ * @brief Erase all the TOA of a band
+ *
+ * @param band_obj                  Band to reset
+ */
+static void smtc_duty_cycle_band_reset( smtc_dtc_band_t* band_obj );
+
+/**
+ * @brief Erase the obsolete TOA of a band
+ *
+ * @param band_obj                  Band to update
+ * @param rtc_time_now              RTC ms
+ */
+static void smtc_duty_cycle_band_update( smtc_dtc_band_t* band_obj, uint32_t rtc_time_now );
+
+/**
+ * @brief Pick the slot a band is configured from, among the slots not configured yet for the current region
+ *
+ * @remark The slot holding the same frequency range is picked, else the slot holding the least TOA
+ *
+ * @param dtc_obj                   Contains the duty cycle context
+ * @param band_idx                  First slot not configured yet for the current region
+ * @param freq_min                  Frequency min of the band
+ * @param freq_max                  Frequency max of the band
+ * @return uint8_t                  Return the slot index
+ */
+static uint8_t smtc_duty_cycle_find_slot( smtc_dtc_t* dtc_obj, uint8_t band_idx, uint32_t freq_min,
+                                          uint32_t freq_max );
+
+/**
+ * @brief Erase the TOA of one index and keep the running sum and the oldest index up to date
+ *
+ * @param band_obj                  Band to update
+ * @param idx                       Index to erase
+ */
+static void smtc_duty_cycle_band_clear_index( smtc_dtc_band_t* band_obj, uint8_t idx );
+
+/**
+ * @brief Erase the obsolete TOA between the last saved index (excluded) and the current index (included), then the
+ *        index after the current one if its last TOA is one period old
+ *
+ * @remark Only the oldest indexes can be obsolete, so they are erased from the oldest one and the loop stops on the
+ *         first index still in the window. Each index is erased at most once per period.
+ *
+ * @param band_obj                  Band to update
+ * @param idx_previous              Last saved index
+ * @param idx_new                   Current index
+ * @param elapsed_in_idx_ms         Time elapsed since the beginning of the current index
+ */
+static void smtc_duty_cycle_band_expire( smtc_dtc_band_t* band_obj, uint8_t idx_previous, uint8_t idx_new,
+                                         uint32_t elapsed_in_idx_ms );
+
+/**
+ * @brief Time before the TOA of an index leaves the window, one period after the last TOA summed in it
+ *
+ * @param band_obj                  Band of the index
+ * @param idx                       Index holding TOA
+ * @param age                       Number of indexes between this index and the current one
+ * @param elapsed_in_idx_ms         Time elapsed since the beginning of the current index
+ * @return uint32_t                 Delay in milliseconds, 0 if the TOA already left the window
+ */
+static uint32_t smtc_duty_cycle_band_get_release_ms( const smtc_dtc_band_t* band_obj, uint8_t idx, uint8_t age,
+                                                     uint32_t elapsed_in_idx_ms );
+
+/**
+ * @brief Forecast the budget of a band and the time before a Time On Air fits in it
+ *
+ * @remark The TOA of each index is released one period after the last TOA summed in it, the indexes are walked from
+ *         the oldest one until enough TOA is released
+ *
+ * @param dtc_obj                   Contains the duty cycle context
+ * @param band                      Band requested
+ * @param toa_ms                    Time On Air to forecast in milliseconds
+ * @param forecast                  Forecast of the band
+ */
+static void smtc_duty_cycle_band_get_forecast( smtc_dtc_t* dtc_obj, uint8_t band, uint32_t toa_ms,
+                                               smtc_dtc_band_forecast_t* forecast );
+
 /**
  * @brief Put band number in array if not already present
  *
@@ -140,9 +218,50 @@ void smtc_duty_cycle_config( smtc_dtc_t* dtc_obj, uint8_t number_of_bands, uint8
     {
         smtc_modem_hal_mcu_panic( );
     }
-    dtc_obj->bands[band_idx].duty_cycle_regulation = duty_cycle_regulation;
-    dtc_obj->bands[band_idx].freq_min              = freq_min;
-    dtc_obj->bands[band_idx].freq_max              = freq_max;
+
+    // Bring the slot of the band to its index, the slots of the other bands keep their TOA for a later region switch
+    uint8_t slot = smtc_duty_cycle_find_slot( dtc_obj, band_idx, freq_min, freq_max );
+    if( slot != band_idx )
+    {
+        smtc_dtc_band_t band_tmp    = dtc_obj->bands[band_idx];
+        uint32_t        unsaved_tmp = dtc_obj->ctx_unsaved_toa_ms[band_idx];
+
+        dtc_obj->bands[band_idx]              = dtc_obj->bands[slot];
+        dtc_obj->ctx_unsaved_toa_ms[band_idx] = dtc_obj->ctx_unsaved_toa_ms[slot];
+        dtc_obj->bands[slot]                  = band_tmp;
+        dtc_obj->ctx_unsaved_toa_ms[slot]     = unsaved_tmp;
+    }
+
+    smtc_dtc_band_t* band_obj = &dtc_obj->bands[band_idx];
+    if( ( band_obj->freq_min != freq_min ) || ( band_obj->freq_max != freq_max ) )
+    {
+        smtc_duty_cycle_band_reset( band_obj );
+        band_obj->index_oldest                = 0;
+        band_obj->index_previous              = 0;
+        band_obj->toa_timestamp_ms            = 0;
+        dtc_obj->ctx_unsaved_toa_ms[band_idx] = 0;
+    }
+    band_obj->duty_cycle_regulation = duty_cycle_regulation;
+    band_obj->freq_min              = freq_min;
+    band_obj->freq_max              = freq_max;
+}
+
+void smtc_duty_cycle_config_clear( smtc_dtc_t* dtc_obj )
+{
+    uint32_t rtc_time_now = smtc_modem_hal_get_time_in_ms( );
+
+    // Erase the obsolete TOA of every slot, so the slots reused by the next region are the ones holding the least TOA
+    for( uint8_t band = 0; band < SMTC_DTC_BANDS_MAX; band++ )
+    {
+        if( dtc_obj->bands[band].freq_max != 0 )
+        {
+            smtc_duty_cycle_band_update( &dtc_obj->bands[band], rtc_time_now );
+        }
+    }
+
+    // Bands beyond number_of_bands are ignored until configured again, a region without duty cycle has no band
+    dtc_obj->enabled         = SMTC_DTC_PARTIAL_DISABLED;
+    dtc_obj->number_of_bands = 0;
 }
 
 uint8_t smtc_duty_cycle_enable_set( smtc_dtc_t* dtc_obj, smtc_dtc_enablement_type_t enable )
@@ -176,48 +295,44 @@ void smtc_duty_cycle_sum( smtc_dtc_t* dtc_obj, uint32_t freq_hz, uint32_t toa_ms
     uint8_t  band         = smtc_duty_cycle_get_band( dtc_obj, freq_hz );
     uint8_t  idx_previous = dtc_obj->bands[band].index_previous;
 
+    dtc_obj->ctx_unsaved_toa_ms[band] += toa_ms;
+
     // compute index by delta to manage rtc_ms wrapping
     uint32_t timestamp_diff = smtc_duty_cycle_time_diff( rtc_time_now, dtc_obj->bands[band].toa_timestamp_ms );
     uint8_t  idx_new        = smtc_duty_cycle_compute_index( timestamp_diff, idx_previous );
 
-    // Convert TOA to the resolution
-    toa_ms = ( toa_ms < smtc_dtc_resolution_ms )
-                 ? 1
-                 : ( smtc_dtc_resolution_ms == 1 ) ? toa_ms : ( toa_ms / smtc_dtc_resolution_ms ) + 1;
+    uint32_t elapsed_in_idx = timestamp_diff % ( SMTC_DTC_SECONDS_BY_UNIT * 1000UL );
 
-    // More than SMTC_DTC_PERIOD_MS since the last timestamp
-    if( smtc_duty_cycle_time_diff( rtc_time_now, dtc_obj->bands[band].toa_timestamp_ms ) >= SMTC_DTC_PERIOD_MS )
+    // More than one period since the last timestamp index
+    if( timestamp_diff >= ( SMTC_DTC_PERIOD_MS + ( SMTC_DTC_SECONDS_BY_UNIT * 1000UL ) ) )
     {
         // Erase band cumulated TOA
-        memset( dtc_obj->bands[band].toa_sum_ms, 0, sizeof( dtc_obj->bands[band].toa_sum_ms ) );
+        smtc_duty_cycle_band_reset( &dtc_obj->bands[band] );
     }
     else
     {
+        // Erase obsolete data between last saved and the current
+        smtc_duty_cycle_band_expire( &dtc_obj->bands[band], idx_previous, idx_new, elapsed_in_idx );
+
         // If we are on the same index since less than the time of one unit
         if( ( idx_new == idx_previous ) && ( timestamp_diff < ( SMTC_DTC_SECONDS_BY_UNIT * 1000 ) ) )
         {
             // Sum TOA in same buffer
             toa_ms += dtc_obj->bands[band].toa_sum_ms[idx_new];
         }
-        else
-        {
-            // Erase obsolete data between last saved and the current
-            uint8_t i = idx_previous;
-            while( i != idx_new )
-            {
-                i++;
-                if( i >= SMTC_DTC_TOA_BUFF_SIZE )
-                {
-                    i = 0;
-                }
-                dtc_obj->bands[band].toa_sum_ms[i] = 0;
-            }
-        }
     }
     // Save the new TOA
+    if( dtc_obj->bands[band].toa_total == 0 )
+    {
+        dtc_obj->bands[band].index_oldest = idx_new;
+    }
+    dtc_obj->bands[band].toa_total -= dtc_obj->bands[band].toa_sum_ms[idx_new];
+    dtc_obj->bands[band].toa_total += toa_ms;
     dtc_obj->bands[band].toa_sum_ms[idx_new] = toa_ms;
-    dtc_obj->bands[band].toa_timestamp_ms    = rtc_time_now;
-    dtc_obj->bands[band].index_previous      = idx_new;
+    dtc_obj->bands[band].toa_last[idx_new] =
+        ( uint16_t )( ( elapsed_in_idx + SMTC_DTC_TOA_TIME_UNIT_MS - 1 ) / SMTC_DTC_TOA_TIME_UNIT_MS );
+    dtc_obj->bands[band].toa_timestamp_ms = rtc_time_now - elapsed_in_idx;
+    dtc_obj->bands[band].index_previous   = idx_new;
 }
 
 void smtc_duty_cycle_update( smtc_dtc_t* dtc_obj )
@@ -230,38 +345,7 @@ void smtc_duty_cycle_update( smtc_dtc_t* dtc_obj )
 
     for( uint8_t band = 0; band < dtc_obj->number_of_bands; band++ )
     {
-        uint8_t idx_previous = dtc_obj->bands[band].index_previous;
-        // compute index by delta to manage rtc_ms wrapping
-        uint32_t timestamp_diff = smtc_duty_cycle_time_diff( rtc_time_now, dtc_obj->bands[band].toa_timestamp_ms );
-        uint8_t  idx_new        = smtc_duty_cycle_compute_index( timestamp_diff, idx_previous );
-
-        // More than SMTC_DTC_PERIOD_MS since the last timestamp
-        if( smtc_duty_cycle_time_diff( rtc_time_now, dtc_obj->bands[band].toa_timestamp_ms ) >= SMTC_DTC_PERIOD_MS )
-        {
-            // Erase band cumulated TOA, it's been over 1h
-            memset( dtc_obj->bands[band].toa_sum_ms, 0, sizeof( dtc_obj->bands[band].toa_sum_ms ) );
-            dtc_obj->bands[band].toa_timestamp_ms = rtc_time_now;
-            dtc_obj->bands[band].index_previous   = idx_new;
-        }
-        else
-        {
-            // Erase obsolete data between last saved and the current
-            uint8_t i = idx_previous;
-            while( i != idx_new )
-            {
-                i++;
-                if( i >= SMTC_DTC_TOA_BUFF_SIZE )
-                {
-                    i = 0;
-                }
-                // If equal do not erase the TOA
-                if( ( i != idx_new ) ||
-                    ( ( i == idx_new ) && ( timestamp_diff >= ( SMTC_DTC_SECONDS_BY_UNIT * 1000 ) ) ) )
-                {
-                    dtc_obj->bands[band].toa_sum_ms[i] = 0;
-                }
-            }
-        }
+        smtc_duty_cycle_band_update( &dtc_obj->bands[band], rtc_time_now );
     }
 }
 
@@ -334,6 +418,19 @@ bool smtc_duty_cycle_is_band_free( smtc_dtc_t* dtc_obj, uint8_t band )
     return false;
 }
 
+uint32_t smtc_duty_cycle_channel_get_available_toa_ms( smtc_dtc_t* dtc_obj, uint32_t freq_hz )
+{
+    if( ( dtc_obj->enabled != SMTC_DTC_ENABLED ) || ( dtc_obj->number_of_bands == 0 ) )
+    {
+        return SMTC_DTC_PERIOD_MS;
+    }
+
+    uint8_t band = smtc_duty_cycle_get_band( dtc_obj, freq_hz );
+    int32_t toa  = smtc_duty_cycle_band_get_available_toa_ms( dtc_obj, band );
+
+    return ( toa > 0 ) ? ( uint32_t ) toa : 0;
+}
+
 int32_t smtc_duty_cycle_get_next_free_time_ms( smtc_dtc_t* dtc_obj, uint8_t number_of_tx_freq, uint32_t* tx_freq_list )
 {
     if( ( dtc_obj->enabled != SMTC_DTC_ENABLED ) || ( dtc_obj->number_of_bands == 0 ) )
@@ -407,36 +504,18 @@ int32_t smtc_duty_cycle_get_next_free_time_ms( smtc_dtc_t* dtc_obj, uint8_t numb
             uint32_t timestamp_diff = smtc_duty_cycle_time_diff( rtc_time_now, dtc_obj->bands[band].toa_timestamp_ms );
             uint8_t  idx_new        = smtc_duty_cycle_compute_index( timestamp_diff, idx_previous );
 
-            // compute time between now and the end of this index
-            uint32_t next_available_slot_ms =
-                ( SMTC_DTC_SECONDS_BY_UNIT * 1000UL ) - ( rtc_time_now % ( SMTC_DTC_SECONDS_BY_UNIT * 1000UL ) );
-
-            uint8_t idx_empty_counter = 0;
-
-            uint8_t i = idx_new;
-            do
+            // A full band has TOA in the window: the budget comes back when the TOA of the oldest not empty index
+            // leaves the window. Slots are aligned on the beginning of the index of the timestamp to remain right when
+            // rtc_ms wraps
+            if( dtc_obj->bands[band].toa_total == 0 )
             {
-                i++;
-                if( i >= SMTC_DTC_TOA_BUFF_SIZE )
-                {
-                    i = 0;
-                }
-                if( dtc_obj->bands[band].toa_sum_ms[i] != 0 )
-                {
-                    break;
-                }
-                if( i != idx_previous )
-                {
-                    idx_empty_counter++;
-                }
-
-                if( idx_empty_counter > SMTC_DTC_TOA_BUFF_SIZE )
-                {
-                    smtc_modem_hal_lr1mac_panic( );
-                }
-            } while( i != idx_previous );
-
-            next_available_slot_ms += idx_empty_counter * SMTC_DTC_SECONDS_BY_UNIT * 1000UL;
+                smtc_modem_hal_lr1mac_panic( );
+            }
+            uint8_t idx_oldest = dtc_obj->bands[band].index_oldest;
+            uint8_t age        = ( idx_new + SMTC_DTC_TOA_BUFF_SIZE - idx_oldest ) % SMTC_DTC_TOA_BUFF_SIZE;
+
+            uint32_t next_available_slot_ms = smtc_duty_cycle_band_get_release_ms(
+                &dtc_obj->bands[band], idx_oldest, age, timestamp_diff % ( SMTC_DTC_SECONDS_BY_UNIT * 1000UL ) );
             if( next_available_slot_ms_tmp > next_available_slot_ms )
             {
                 next_available_slot_ms_tmp = next_available_slot_ms;
@@ -448,6 +527,225 @@ int32_t smtc_duty_cycle_get_next_free_time_ms( smtc_dtc_t* dtc_obj, uint8_t numb
     return ret;
 }
 
+uint32_t smtc_duty_cycle_get_period_budget_ms( smtc_dtc_t* dtc_obj, uint8_t number_of_tx_freq,
+                                               uint32_t* tx_freq_list )
+{
+    if( ( dtc_obj->enabled != SMTC_DTC_ENABLED ) || ( dtc_obj->number_of_bands == 0 ) )
+    {
+        return 0;
+    }
+
+    uint32_t budget_ms      = 0;
+    uint8_t  tmp_band_index = 0;
+    uint8_t  tmp_band[SMTC_DTC_BANDS_MAX];
+
+    memset( tmp_band, 0xFF, SMTC_DTC_BANDS_MAX );
+
+    for( uint8_t i = 0; i < number_of_tx_freq; i++ )
+    {
+        smtc_duty_cycle_put_band_in_array( dtc_obj, tmp_band, smtc_duty_cycle_get_band( dtc_obj, tx_freq_list[i] ),
+                                           &tmp_band_index );
+    }
+    for( uint8_t i = 0; i < tmp_band_index; i++ )
+    {
+        budget_ms += SMTC_DTC_PERIOD_MS / dtc_obj->bands[tmp_band[i]].duty_cycle_regulation;
+    }
+    return budget_ms;
+}
+
+uint32_t smtc_duty_cycle_get_forecast( smtc_dtc_t* dtc_obj, uint8_t number_of_tx_freq, uint32_t* tx_freq_list,
+                                       uint32_t toa_ms, smtc_dtc_band_forecast_t* forecast, uint8_t* number_of_bands )
+{
+    uint32_t delay_ms       = SMTC_DTC_DELAY_NEVER;
+    uint8_t  tmp_band_index = 0;
+    uint8_t  tmp_band[SMTC_DTC_BANDS_MAX];
+
+    *number_of_bands = 0;
+    if( dtc_obj->number_of_bands == 0 )
+    {
+        return 0;
+    }
+
+    memset( tmp_band, 0xFF, SMTC_DTC_BANDS_MAX );
+
+    for( uint8_t i = 0; i < number_of_tx_freq; i++ )
+    {
+        smtc_duty_cycle_put_band_in_array( dtc_obj, tmp_band, smtc_duty_cycle_get_band( dtc_obj, tx_freq_list[i] ),
+                                           &tmp_band_index );
+    }
+    for( uint8_t i = 0; i < tmp_band_index; i++ )
+    {
+        smtc_duty_cycle_band_get_forecast( dtc_obj, tmp_band[i], toa_ms, &forecast[i] );
+        if( forecast[i].delay_ms < delay_ms )
+        {
+            delay_ms = forecast[i].delay_ms;
+        }
+    }
+    *number_of_bands = tmp_band_index;
+
+    return ( tmp_band_index > 0 ) ? delay_ms : 0;
+}
+
+bool smtc_duty_cycle_is_context_store_needed( smtc_dtc_t* dtc_obj )
+{
+    if( dtc_obj->enabled != SMTC_DTC_ENABLED )
+    {
+        return false;
+    }
+    for( uint8_t band = 0; band < dtc_obj->number_of_bands; band++ )
+    {
+        uint32_t budget_ms = SMTC_DTC_PERIOD_MS / dtc_obj->bands[band].duty_cycle_regulation;
+
+        if( ( dtc_obj->ctx_unsaved_toa_ms[band] * SMTC_DTC_CTX_STORE_BUDGET_DIV ) >= budget_ms )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void smtc_duty_cycle_context_get( smtc_dtc_t* dtc_obj, smtc_dtc_context_t* ctx )
+{
+    memset( ctx, 0, sizeof( smtc_dtc_context_t ) );
+
+    // Erase the obsolete TOA before storing
+    smtc_duty_cycle_update( dtc_obj );
+
+    uint32_t rtc_time_now  = smtc_modem_hal_get_time_in_ms( );
+    ctx->persistent_time_s = smtc_modem_hal_get_persistent_time_in_s( );
+    ctx->number_of_bands   = dtc_obj->number_of_bands;
+
+    for( uint8_t band = 0; band < dtc_obj->number_of_bands; band++ )
+    {
+        smtc_dtc_band_t* band_obj = &dtc_obj->bands[band];
+
+        ctx->freq_min[band] = band_obj->freq_min;
+        if( band_obj->toa_total == 0 )
+        {
+            continue;
+        }
+
+        uint32_t timestamp_diff = smtc_duty_cycle_time_diff( rtc_time_now, band_obj->toa_timestamp_ms );
+        uint8_t  idx_new        = smtc_duty_cycle_compute_index( timestamp_diff, band_obj->index_previous );
+        uint32_t elapsed_in_idx = timestamp_diff % ( SMTC_DTC_SECONDS_BY_UNIT * 1000UL );
+
+        for( uint8_t age = 0; age < SMTC_DTC_TOA_BUFF_SIZE; age++ )
+        {
+            uint8_t  idx    = ( idx_new + SMTC_DTC_TOA_BUFF_SIZE - age ) % SMTC_DTC_TOA_BUFF_SIZE;
+            uint32_t toa_ms = band_obj->toa_sum_ms[idx];
+            if( toa_ms == 0 )
+            {
+                continue;
+            }
+
+            // The youngest TOA of an index is its last one, the index began age units before the current one
+            uint32_t idx_age_ms     = ( age * SMTC_DTC_SECONDS_BY_UNIT * 1000UL ) + elapsed_in_idx;
+            uint32_t last_ms        = band_obj->toa_last[idx] * SMTC_DTC_TOA_TIME_UNIT_MS;
+            uint32_t youngest_age_s = ( idx_age_ms > last_ms ) ? ( ( idx_age_ms - last_ms ) / 1000 ) : 0;
+            uint8_t  ctx_idx        = youngest_age_s / SMTC_DTC_CTX_SECONDS_BY_UNIT;
+            uint32_t toa_sum = ctx->toa_sum[band][ctx_idx] +
+                               ( ( toa_ms + SMTC_DTC_CTX_TOA_UNIT_MS - 1 ) / SMTC_DTC_CTX_TOA_UNIT_MS );
+
+            ctx->toa_sum[band][ctx_idx] = ( toa_sum > 0xFFFF ) ? 0xFFFF : toa_sum;
+        }
+    }
+
+    memset( dtc_obj->ctx_unsaved_toa_ms, 0, sizeof( dtc_obj->ctx_unsaved_toa_ms ) );
+}
+
+bool smtc_duty_cycle_context_set( smtc_dtc_t* dtc_obj, const smtc_dtc_context_t* ctx )
+{
+    if( ( dtc_obj->number_of_bands == 0 ) || ( ctx->number_of_bands != dtc_obj->number_of_bands ) )
+    {
+        return false;
+    }
+    for( uint8_t band = 0; band < dtc_obj->number_of_bands; band++ )
+    {
+        if( ctx->freq_min[band] != dtc_obj->bands[band].freq_min )
+        {
+            return false;
+        }
+    }
+
+    // Time elapsed since the store minus one second of resolution, 0 if unknown
+    uint32_t elapsed_s         = 0;
+    uint32_t persistent_time_s = smtc_modem_hal_get_persistent_time_in_s( );
+    if( ( ctx->persistent_time_s != 0 ) && ( persistent_time_s > ctx->persistent_time_s ) )
+    {
+        elapsed_s = persistent_time_s - ctx->persistent_time_s - 1;
+    }
+
+    uint32_t rtc_time_now   = smtc_modem_hal_get_time_in_ms( );
+    uint32_t elapsed_in_idx = rtc_time_now % ( SMTC_DTC_SECONDS_BY_UNIT * 1000UL );
+
+    for( uint8_t band = 0; band < dtc_obj->number_of_bands; band++ )
+    {
+        smtc_dtc_band_t* band_obj = &dtc_obj->bands[band];
+
+        // The current index is the index 0
+        smtc_duty_cycle_band_reset( band_obj );
+        band_obj->toa_timestamp_ms = rtc_time_now - elapsed_in_idx;
+        band_obj->index_previous   = 0;
+
+        for( uint8_t ctx_idx = 0; ctx_idx < SMTC_DTC_CTX_BUFF_SIZE; ctx_idx++ )
+        {
+            if( ctx->toa_sum[band][ctx_idx] == 0 )
+            {
+                continue;
+            }
+
+            // The TOA is considered sent at the younger age of its context index
+            uint32_t age_s = ( ctx_idx * SMTC_DTC_CTX_SECONDS_BY_UNIT ) + elapsed_s;
+            if( age_s >= ( SMTC_DTC_PERIOD_MS / 1000UL ) )
+            {
+                continue;
+            }
+
+            // Number of indexes between the current one and the one holding this TOA, the indexes are not aligned
+            // like before the reset so the TOA is put in the index holding its time
+            uint32_t age_ms   = age_s * 1000UL;
+            uint32_t idx_back = 0;
+            if( age_ms > elapsed_in_idx )
+            {
+                idx_back = ( age_ms - elapsed_in_idx + ( SMTC_DTC_SECONDS_BY_UNIT * 1000UL ) - 1 ) /
+                           ( SMTC_DTC_SECONDS_BY_UNIT * 1000UL );
+            }
+            if( idx_back >= SMTC_DTC_TOA_BUFF_SIZE )
+            {
+                continue;
+            }
+
+            uint8_t  idx    = ( SMTC_DTC_TOA_BUFF_SIZE - idx_back ) % SMTC_DTC_TOA_BUFF_SIZE;
+            uint32_t toa_ms = ctx->toa_sum[band][ctx_idx] * SMTC_DTC_CTX_TOA_UNIT_MS;
+
+            // Time of the TOA from the beginning of its index, the youngest TOA of an index is kept
+            uint32_t last_ms   = ( idx_back * SMTC_DTC_SECONDS_BY_UNIT * 1000UL ) + elapsed_in_idx - age_ms;
+            uint16_t last_time =
+                ( uint16_t )( ( last_ms + SMTC_DTC_TOA_TIME_UNIT_MS - 1 ) / SMTC_DTC_TOA_TIME_UNIT_MS );
+
+            if( band_obj->toa_last[idx] < last_time )
+            {
+                band_obj->toa_last[idx] = last_time;
+            }
+            band_obj->toa_sum_ms[idx] += toa_ms;
+            band_obj->toa_total += toa_ms;
+        }
+
+        // The oldest index is the first not empty one after the current index
+        for( uint8_t i = 1; ( i <= SMTC_DTC_TOA_BUFF_SIZE ) && ( band_obj->toa_total != 0 ); i++ )
+        {
+            if( band_obj->toa_sum_ms[i % SMTC_DTC_TOA_BUFF_SIZE] != 0 )
+            {
+                band_obj->index_oldest = i % SMTC_DTC_TOA_BUFF_SIZE;
+                break;
+            }
+        }
+    }
+
+    memset( dtc_obj->ctx_unsaved_toa_ms, 0, sizeof( dtc_obj->ctx_unsaved_toa_ms ) );
+    return true;
+}
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
@@ -467,31 +765,188 @@ static uint8_t smtc_duty_cycle_get_band( smtc_dtc_t* dtc_obj, uint32_t freq_hz )
 
 static uint32_t smtc_duty_cycle_get_band_consumed_time_ms( smtc_dtc_t* dtc_obj, uint8_t band )
 {
-    uint32_t toa_ms = 0;
-    for( uint8_t i = 0; i < SMTC_DTC_TOA_BUFF_SIZE; i++ )
-    {
-        toa_ms += dtc_obj->bands[band].toa_sum_ms[i];
-    }
-
-    // Convert to the resolution
-    toa_ms *= smtc_dtc_resolution_ms;
-    return toa_ms;
+    return dtc_obj->bands[band].toa_total;
 }
 
 static inline uint8_t smtc_duty_cycle_compute_index( uint32_t timestamp_ms, uint8_t idx_previous )
 {
-    uint8_t idx_new =
-        ( ( ( timestamp_ms / 60000UL ) % ( ( ( SMTC_DTC_PERIOD_MS / 1000UL ) + SMTC_DTC_SECONDS_BY_UNIT ) / 60 ) ) /
-          ( SMTC_DTC_SECONDS_BY_UNIT / 60 ) );
+    // Computed on 16 bits as the sum of the two indexes can exceed 255
+    uint16_t idx_new = ( ( timestamp_ms / 1000UL ) % ( ( SMTC_DTC_PERIOD_MS / 1000UL ) + SMTC_DTC_SECONDS_BY_UNIT ) ) /
+                       SMTC_DTC_SECONDS_BY_UNIT;
 
     idx_new += idx_previous;
     idx_new %= SMTC_DTC_TOA_BUFF_SIZE;
-    return idx_new;
+    return ( uint8_t ) idx_new;
 }
 
 static inline uint32_t smtc_duty_cycle_time_diff( uint32_t rtc_ms, uint32_t timestamp_ms )
 {
-    return ( rtc_ms - ( timestamp_ms - ( timestamp_ms % ( SMTC_DTC_SECONDS_BY_UNIT * 1000UL ) ) ) );
+    return ( rtc_ms - timestamp_ms );
+}
+
+static void smtc_duty_cycle_band_reset( smtc_dtc_band_t* band_obj )
+{
+    memset( band_obj->toa_sum_ms, 0, sizeof( band_obj->toa_sum_ms ) );
+    memset( band_obj->toa_last, 0, sizeof( band_obj->toa_last ) );
+    band_obj->toa_total = 0;
+}
+
+static void smtc_duty_cycle_band_update( smtc_dtc_band_t* band_obj, uint32_t rtc_time_now )
+{
+    uint8_t idx_previous = band_obj->index_previous;
+    // compute index by delta to manage rtc_ms wrapping
+    uint32_t timestamp_diff = smtc_duty_cycle_time_diff( rtc_time_now, band_obj->toa_timestamp_ms );
+    uint8_t  idx_new        = smtc_duty_cycle_compute_index( timestamp_diff, idx_previous );
+
+    // More than one period since the last timestamp index
+    if( timestamp_diff >= ( SMTC_DTC_PERIOD_MS + ( SMTC_DTC_SECONDS_BY_UNIT * 1000UL ) ) )
+    {
+        // Erase band cumulated TOA, it's been over 1h
+        smtc_duty_cycle_band_reset( band_obj );
+        band_obj->toa_timestamp_ms = rtc_time_now - ( timestamp_diff % ( SMTC_DTC_SECONDS_BY_UNIT * 1000UL ) );
+        band_obj->index_previous   = idx_new;
+    }
+    else
+    {
+        // Erase obsolete data between last saved and the current, idx_new differs from idx_previous only when
+        // at least one unit elapsed so the current index is obsolete too
+        smtc_duty_cycle_band_expire( band_obj, idx_previous, idx_new,
+                                     timestamp_diff % ( SMTC_DTC_SECONDS_BY_UNIT * 1000UL ) );
+    }
+}
+
+static uint8_t smtc_duty_cycle_find_slot( smtc_dtc_t* dtc_obj, uint8_t band_idx, uint32_t freq_min,
+                                          uint32_t freq_max )
+{
+    uint8_t slot = band_idx;
+
+    for( uint8_t i = band_idx; i < SMTC_DTC_BANDS_MAX; i++ )
+    {
+        if( ( dtc_obj->bands[i].freq_min == freq_min ) && ( dtc_obj->bands[i].freq_max == freq_max ) )
+        {
+            return i;
+        }
+        if( dtc_obj->bands[i].toa_total < dtc_obj->bands[slot].toa_total )
+        {
+            slot = i;
+        }
+    }
+    return slot;
+}
+
+static void smtc_duty_cycle_band_clear_index( smtc_dtc_band_t* band_obj, uint8_t idx )
+{
+    band_obj->toa_total -= band_obj->toa_sum_ms[idx];
+    band_obj->toa_sum_ms[idx] = 0;
+
+    if( ( band_obj->toa_total != 0 ) && ( idx == band_obj->index_oldest ) )
+    {
+        // Move to the next not empty index, it exists as the running sum is not null
+        do
+        {
+            idx++;
+            if( idx >= SMTC_DTC_TOA_BUFF_SIZE )
+            {
+                idx = 0;
+            }
+        } while( band_obj->toa_sum_ms[idx] == 0 );
+        band_obj->index_oldest = idx;
+    }
+}
+
+static void smtc_duty_cycle_band_expire( smtc_dtc_band_t* band_obj, uint8_t idx_previous, uint8_t idx_new,
+                                         uint32_t elapsed_in_idx_ms )
+{
+    uint8_t obsolete_range = ( idx_new + SMTC_DTC_TOA_BUFF_SIZE - idx_previous ) % SMTC_DTC_TOA_BUFF_SIZE;
+
+    while( band_obj->toa_total != 0 )
+    {
+        uint8_t oldest_distance =
+            ( band_obj->index_oldest + SMTC_DTC_TOA_BUFF_SIZE - idx_previous ) % SMTC_DTC_TOA_BUFF_SIZE;
+        if( ( oldest_distance == 0 ) || ( oldest_distance > obsolete_range ) )
+        {
+            break;
+        }
+        smtc_duty_cycle_band_clear_index( band_obj, band_obj->index_oldest );
+    }
+
+    // The index after the current one began one period before it, it is the oldest one if it holds TOA
+    uint8_t idx_last = ( idx_new + 1 ) % SMTC_DTC_TOA_BUFF_SIZE;
+    if( ( band_obj->toa_total != 0 ) && ( band_obj->index_oldest == idx_last ) &&
+        ( smtc_duty_cycle_band_get_release_ms( band_obj, idx_last, SMTC_DTC_TOA_BUFF_SIZE - 1, elapsed_in_idx_ms ) ==
+          0 ) )
+    {
+        smtc_duty_cycle_band_clear_index( band_obj, idx_last );
+    }
+}
+
+static uint32_t smtc_duty_cycle_band_get_release_ms( const smtc_dtc_band_t* band_obj, uint8_t idx, uint8_t age,
+                                                     uint32_t elapsed_in_idx_ms )
+{
+    // The index began age units before the current one, its TOA leaves the window one period after its last TOA
+    uint32_t release_ms = ( ( SMTC_DTC_PERIOD_MS / 1000UL ) - ( age * SMTC_DTC_SECONDS_BY_UNIT ) ) * 1000UL +
+                          ( band_obj->toa_last[idx] * SMTC_DTC_TOA_TIME_UNIT_MS );
+
+    return ( release_ms > elapsed_in_idx_ms ) ? ( release_ms - elapsed_in_idx_ms ) : 0;
+}
+
+static void smtc_duty_cycle_band_get_forecast( smtc_dtc_t* dtc_obj, uint8_t band, uint32_t toa_ms,
+                                               smtc_dtc_band_forecast_t* forecast )
+{
+    smtc_dtc_band_t* band_obj = &dtc_obj->bands[band];
+    uint32_t         consumed = smtc_duty_cycle_get_band_consumed_time_ms( dtc_obj, band );
+
+    forecast->freq_min     = band_obj->freq_min;
+    forecast->freq_max     = band_obj->freq_max;
+    forecast->budget_ms    = SMTC_DTC_PERIOD_MS / band_obj->duty_cycle_regulation;
+    forecast->available_ms = ( consumed < forecast->budget_ms ) ? ( forecast->budget_ms - consumed ) : 0;
+    forecast->delay_ms     = 0;
+
+    if( dtc_obj->enabled != SMTC_DTC_ENABLED )
+    {
+        return;
+    }
+    if( toa_ms > forecast->budget_ms )
+    {
+        forecast->delay_ms = SMTC_DTC_DELAY_NEVER;
+        return;
+    }
+    if( ( consumed + toa_ms ) <= forecast->budget_ms )
+    {
+        return;
+    }
+
+    // The TOA exceeding the budget must leave the window, consumed is not null here so index_oldest is valid
+    uint32_t excess_ms      = consumed + toa_ms - forecast->budget_ms;
+    uint32_t timestamp_diff = smtc_duty_cycle_time_diff( smtc_modem_hal_get_time_in_ms( ), band_obj->toa_timestamp_ms );
+    uint8_t  idx_new        = smtc_duty_cycle_compute_index( timestamp_diff, band_obj->index_previous );
+
+    // the index located n indexes after the current one began SMTC_DTC_TOA_BUFF_SIZE - n units before it, the current
+    // index is the last one to leave
+    uint8_t distance = ( band_obj->index_oldest + SMTC_DTC_TOA_BUFF_SIZE - idx_new ) % SMTC_DTC_TOA_BUFF_SIZE;
+    if( distance == 0 )
+    {
+        distance = SMTC_DTC_TOA_BUFF_SIZE;
+    }
+
+    for( ; distance <= SMTC_DTC_TOA_BUFF_SIZE; distance++ )
+    {
+        uint32_t released_ms = band_obj->toa_sum_ms[( idx_new + distance ) % SMTC_DTC_TOA_BUFF_SIZE];
+
+        if( released_ms >= excess_ms )
+        {
+            break;
+        }
+        excess_ms -= released_ms;
+    }
+    if( distance > SMTC_DTC_TOA_BUFF_SIZE )
+    {
+        distance = SMTC_DTC_TOA_BUFF_SIZE;
+    }
+    forecast->delay_ms =
+        smtc_duty_cycle_band_get_release_ms( band_obj, ( idx_new + distance ) % SMTC_DTC_TOA_BUFF_SIZE,
+                                             SMTC_DTC_TOA_BUFF_SIZE - distance,
+                                             timestamp_diff % ( SMTC_DTC_SECONDS_BY_UNIT * 1000UL ) );
 }
 
 static void smtc_duty_cycle_put_band_in_array( smtc_dtc_t* dtc_obj, uint8_t* tmp_band, uint8_t band,
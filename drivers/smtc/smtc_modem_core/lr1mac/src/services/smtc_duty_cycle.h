@@ -58,21 +58,36 @@ extern "C" {
 // clang-format off
 #define SMTC_DTC_BANDS_MAX          ( 6 )                      // Number of ETSI band supported by this algo
 #define SMTC_DTC_PERIOD_MS          ( 3600000UL )              // Number of miliseconds in one period (3600000 for period 1h)
-#define SMTC_DTC_SECONDS_BY_UNIT    ( 120 )                    // Sum TOA by step of N seconds, MIN VALUE IS 60s to avoid division by 0
-#define SMTC_DTC_TOA_BUFF_SIZE      ( ( SMTC_DTC_PERIOD_MS / 1000UL ) / SMTC_DTC_SECONDS_BY_UNIT )  // Buffer size to sum all TOA over one period
+#ifndef SMTC_DTC_SECONDS_BY_UNIT
+#define SMTC_DTC_SECONDS_BY_UNIT    ( 60 )                     // Sum TOA by step of N seconds, must divide the period
+#endif
+#define SMTC_DTC_TOA_BUFF_SIZE      ( ( ( SMTC_DTC_PERIOD_MS / 1000UL ) / SMTC_DTC_SECONDS_BY_UNIT ) + 1 )  // One period and the index being filled
+#define SMTC_DTC_TOA_TIME_UNIT_MS   ( 10 )                     // Resolution of the time of the last TOA of an index
+#define SMTC_DTC_DELAY_NEVER        ( 0xFFFFFFFFUL )           // Forecast delay of a TOA greater than the band budget
+#define SMTC_DTC_CTX_SECONDS_BY_UNIT ( 300 )                   // TOA is stored in the context by age step of N seconds
+#define SMTC_DTC_CTX_BUFF_SIZE      ( ( SMTC_DTC_PERIOD_MS / 1000UL ) / SMTC_DTC_CTX_SECONDS_BY_UNIT )  // Context buffer size for one period
+#define SMTC_DTC_CTX_TOA_UNIT_MS    ( 10 )                     // Resolution of the TOA stored in the context
+#define SMTC_DTC_CTX_STORE_BUDGET_DIV ( 4 )                    // Store the context once 1/N of a band budget is not stored
 
-#if SMTC_DTC_SECONDS_BY_UNIT < 60
-#warning "SMTC_DTC_SECONDS_BY_UNIT must be greater or equal to 60"
-#undef SMTC_DTC_SECONDS_BY_UNIT
-#define SMTC_DTC_SECONDS_BY_UNIT 60
+#if ( ( SMTC_DTC_PERIOD_MS / 1000UL ) % SMTC_DTC_SECONDS_BY_UNIT ) != 0
+#error "SMTC_DTC_SECONDS_BY_UNIT must divide the duty cycle period"
+#endif
+#if SMTC_DTC_TOA_BUFF_SIZE > 255
+#error "SMTC_DTC_SECONDS_BY_UNIT is too small, the TOA buffer is indexed on 8 bits"
+#endif
+#if ( ( SMTC_DTC_SECONDS_BY_UNIT * 1000UL ) / SMTC_DTC_TOA_TIME_UNIT_MS ) > 0xFFFF
+#error "SMTC_DTC_SECONDS_BY_UNIT is too large, the time of the last TOA of an index is stored on 16 bits"
 #endif
 
 //
-// Represention of the current configuration
+// Represention of the default configuration
+//
+// index                       0     1     2                  59    60    0
+// 32bits array to save TOA {[    ][    ][    ][    ...    ][    ][    ][    ]}
+// RTC                       0s    60s   120s  180s         3540s 3600s 3660s
 //
-// index                       0     1     2                  28    29   0
-// 16bits array to save TOA {[    ][    ][    ][    ...    ][    ][    ][    ]}
-// RTC                       0s    120s  240s  360s         3360s 3480s 3600s
+// A TOA leaves the window one period after the last TOA summed in its index, so the index holding it is still in use
+// during the period and is only reused one index later.
 //
 
 // clang-format on
@@ -92,24 +107,49 @@ typedef struct smtc_dtc_band_s
     uint32_t freq_min;
     uint32_t freq_max;
     uint16_t duty_cycle_regulation;  // 1000->0.1%, 100->1%, 10->10%
-    uint32_t toa_timestamp_ms;       // last access to the array when adding the TOA or reset all TOA
+    uint32_t toa_timestamp_ms;       // beginning of index_previous, set when adding the TOA or reset all TOA
     uint8_t  index_previous;
-    uint16_t toa_sum_ms[SMTC_DTC_TOA_BUFF_SIZE];  // Store all TOA by step of SMTC_DTC_SECONDS_BY_UNIT
+    uint8_t  index_oldest;                        // Oldest not empty index of toa_sum_ms, valid if toa_total != 0
+    uint32_t toa_total;                           // Running sum of toa_sum_ms in milliseconds
+    uint32_t toa_sum_ms[SMTC_DTC_TOA_BUFF_SIZE];  // Store all TOA in milliseconds by step of SMTC_DTC_SECONDS_BY_UNIT
+    uint16_t toa_last[SMTC_DTC_TOA_BUFF_SIZE];    // Time of the last TOA from the index beginning, rounded up
 } smtc_dtc_band_t;
 
+/**
+ * @brief Airtime forecast of a band, see smtc_duty_cycle_band_get_forecast()
+ */
+typedef struct smtc_dtc_band_forecast_s
+{
+    uint32_t freq_min;      // Lowest frequency of the band
+    uint32_t freq_max;      // Highest frequency of the band (excluded)
+    uint32_t budget_ms;     // Time On Air allowed over one period
+    uint32_t available_ms;  // Time On Air still available over the current period
+    uint32_t delay_ms;      // Time before the requested TOA fits in the band, SMTC_DTC_DELAY_NEVER if never
+} smtc_dtc_band_forecast_t;
+
 typedef struct smtc_dtc_s
 {
     smtc_dtc_enablement_type_t enabled;
     uint8_t                    number_of_bands;
     smtc_dtc_band_t            bands[SMTC_DTC_BANDS_MAX];
+    uint32_t                   ctx_unsaved_toa_ms[SMTC_DTC_BANDS_MAX];  // TOA summed since the last context store
 } smtc_dtc_t;
 
 /**
- * @brief the resolution is the number of bits per SMTC_DTC_SECONDS_BY_UNIT
- * @remark 16 represents the number of bits to save the TOA
- *          ceil(120s/65536) -> ceil(0.001831055) -> 2ms per bit
+ * @brief Duty cycle context kept across resets, see smtc_duty_cycle_context_get()
+ *
+ * @remark The TOA is stored by age and not by index, index 0 holds the TOA younger than SMTC_DTC_CTX_SECONDS_BY_UNIT
+ *         when the context is stored. The crc is computed and checked by the owner of the context.
  */
-static const uint32_t smtc_dtc_resolution_ms = ( ( ( SMTC_DTC_SECONDS_BY_UNIT * 1000 ) / ( 1 << ( 16 ) ) ) + 1 );
+typedef struct smtc_dtc_context_s
+{
+    uint32_t persistent_time_s;                                        // smtc_modem_hal_get_persistent_time_in_s( )
+    uint32_t freq_min[SMTC_DTC_BANDS_MAX];                              // Bands the stored TOA belongs to
+    uint16_t toa_sum[SMTC_DTC_BANDS_MAX][SMTC_DTC_CTX_BUFF_SIZE];      // TOA by age, in SMTC_DTC_CTX_TOA_UNIT_MS unit
+    uint8_t  number_of_bands;
+    uint8_t  rfu[3];
+    uint32_t crc;
+} smtc_dtc_context_t;
 
 /*
  * -----------------------------------------------------------------------------
@@ -123,9 +163,24 @@ static const uint32_t smtc_dtc_resolution_ms = ( ( ( SMTC_DTC_SECONDS_BY_UNIT *
  */
 void smtc_duty_cycle_init( smtc_dtc_t* dtc_obj );
 
+/**
+ * @brief Clear the duty cycle configuration before the bands of a region are configured again
+ *
+ * @remark The airtime of the bands is not cleared: a band configured again by smtc_duty_cycle_config() with the same
+ *         frequency range keeps it, whatever its index, when switching back and forth between regions.
+ *
+ * @param dtc_obj Contains the duty cycle context
+ */
+void smtc_duty_cycle_config_clear( smtc_dtc_t* dtc_obj );
+
 /**
  * @brief Duty cycle configuration
  *
+ * @remark The bands of a region are configured in index order after smtc_duty_cycle_config_clear(). The band keeps
+ *         the airtime of the slot holding the same frequency range. Else it takes the slot holding the least airtime
+ *         among the slots not configured yet, and clears it: the airtime of the bands of a previous region is lost
+ *         only when every free slot holds airtime.
+ *
  * @param dtc_obj                   Contains the duty cycle context
  * @param number_of_bands           Number of bands in this region
  * @param band_idx                  Index bands to store configuration
@@ -220,6 +275,18 @@ bool smtc_duty_cycle_is_channel_free( smtc_dtc_t* dtc_obj, uint32_t freq_hz );
  */
 bool smtc_duty_cycle_is_band_free( smtc_dtc_t* dtc_obj, uint8_t band );
 
+/**
+ * @brief Get Time On Air still available in the band of a channel
+ *
+ * @remark  smtc_duty_cycle_update() must be called before this function to have a right value
+ *
+ * @param dtc_obj                   Contains the duty cycle context
+ * @param freq_hz                   Frequency of the channel
+ * @return uint32_t                 Time On Air available in milliseconds, 0 if the band is full,
+ *                                  SMTC_DTC_PERIOD_MS if the duty cycle is not enforced
+ */
+uint32_t smtc_duty_cycle_channel_get_available_toa_ms( smtc_dtc_t* dtc_obj, uint32_t freq_hz );
+
 /**
  * @brief Get the next available slot with free duty cycle
  *
@@ -231,6 +298,71 @@ bool smtc_duty_cycle_is_band_free( smtc_dtc_t* dtc_obj, uint8_t band );
  * @return int32_t                  milliseconds, if > 0: the next slot availble, else the available time
  */
 int32_t smtc_duty_cycle_get_next_free_time_ms( smtc_dtc_t* dtc_obj, uint8_t number_of_tx_freq, uint32_t* tx_freq_list );
+
+/**
+ * @brief Get the airtime allowed by the regulation over one period on the bands of the frequency list
+ *
+ * @param dtc_obj                   Contains the duty cycle context
+ * @param number_of_tx_freq         number of tx freq in list
+ * @param tx_freq_list              tx frequency list used by the app to check only duty cycle in these bands
+ * @return uint32_t                 milliseconds per SMTC_DTC_PERIOD_MS, 0 if the duty cycle is not enforced
+ */
+uint32_t smtc_duty_cycle_get_period_budget_ms( smtc_dtc_t* dtc_obj, uint8_t number_of_tx_freq,
+                                               uint32_t* tx_freq_list );
+
+/**
+ * @brief Forecast when a Time On Air fits in the bands of the frequency list
+ *
+ * @remark  smtc_duty_cycle_update() must be called before this function to have a right value
+ *
+ * @param dtc_obj                   Contains the duty cycle context
+ * @param number_of_tx_freq         number of tx freq in list
+ * @param tx_freq_list              tx frequency list used by the app to check only duty cycle in these bands
+ * @param toa_ms                    Time On Air to forecast in milliseconds
+ * @param forecast                  Forecast of each band of the frequency list, SMTC_DTC_BANDS_MAX entries
+ * @param number_of_bands           Number of bands written in forecast
+ * @return uint32_t                 milliseconds before the TOA fits in one of the bands, SMTC_DTC_DELAY_NEVER if never
+ */
+uint32_t smtc_duty_cycle_get_forecast( smtc_dtc_t* dtc_obj, uint8_t number_of_tx_freq, uint32_t* tx_freq_list,
+                                       uint32_t toa_ms, smtc_dtc_band_forecast_t* forecast, uint8_t* number_of_bands );
+
+/**
+ * @brief Check if enough TOA was summed since the last context store to store the context again
+ *
+ * @remark The context is stored when the TOA not stored yet in a band reaches 1/SMTC_DTC_CTX_STORE_BUDGET_DIV of the
+ *         band budget, so a reset forgets less than this share of any band budget, the smallest band having the
+ *         smallest threshold. As the duty cycle caps the TOA of a band over one period to its budget, this also caps
+ *         the writes to SMTC_DTC_CTX_STORE_BUDGET_DIV per band and per period. Nothing is stored while the duty cycle
+ *         is not enforced.
+ *
+ * @param dtc_obj                   Contains the duty cycle context
+ * @return bool                     true if the context must be stored
+ */
+bool smtc_duty_cycle_is_context_store_needed( smtc_dtc_t* dtc_obj );
+
+/**
+ * @brief Get the duty cycle context to store
+ *
+ * @remark The TOA is moved to the younger age of its index, so the restored TOA never leaves the window earlier than
+ *         the real one
+ *
+ * @param dtc_obj                   Contains the duty cycle context
+ * @param ctx                       Context to fill, the crc is not computed
+ */
+void smtc_duty_cycle_context_get( smtc_dtc_t* dtc_obj, smtc_dtc_context_t* ctx );
+
+/**
+ * @brief Restore a duty cycle context stored before a reset
+ *
+ * @remark Must be called after the bands configuration. The TOA is aged with smtc_modem_hal_get_persistent_time_in_s( )
+ *         if available, else as if the reset happened right after the store.
+ *
+ * @param dtc_obj                   Contains the duty cycle context
+ * @param ctx                       Stored context, the crc must be checked by the caller
+ * @return bool                     false if the context does not match the configured bands
+ */
+bool smtc_duty_cycle_context_set( smtc_dtc_t* dtc_obj, const smtc_dtc_context_t* ctx );
+
 #ifdef __cplusplus
 }
 #endif
@@ -40,6 +40,40 @@
 #include "smtc_modem_hal.h"
 #include "lr1_stack_mac_layer.h"
 
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Configure the radio in rx continuous on the current candidate channel and start its listen window
+ *
+ * @param rp pointer to the radio planner
+ * @param lbt_obj pointer to lbt_obj itself
+ */
+static void smtc_lbt_channel_start( radio_planner_t* rp, smtc_lbt_t* lbt_obj );
+
+/**
+ * @brief Radio task timer callback, take one rssi sample and decide if the listen window is over
+ *
+ * @param rp_void pointer to the radio planner
+ */
+static void smtc_lbt_sample_callback_for_rp( void* rp_void );
+
+/**
+ * @brief Account a busy or free listen window in the statistics of the channel
+ *
+ * @param lbt_obj pointer to lbt_obj itself
+ * @param freq frequency of the channel in hertz
+ * @param is_busy true if the channel was found busy
+ */
+static void smtc_lbt_stats_update( smtc_lbt_t* lbt_obj, uint32_t freq, bool is_busy );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
 void smtc_lbt_init( smtc_lbt_t* lbt_obj, radio_planner_t* rp, uint8_t lbt_id_rp,
                     void ( *free_callback )( void* free_context ), void*   free_context,
                     void ( *busy_callback )( void* busy_context ), void*   busy_context,
@@ -65,6 +99,9 @@ void smtc_lbt_init( smtc_lbt_t* lbt_obj, radio_planner_t* rp, uint8_t lbt_id_rp,
     lbt_obj->listen_duration_ms = 0;
     lbt_obj->threshold          = 0;
     lbt_obj->bw_hz              = 0;
+    lbt_obj->channel_nb         = 0;
+    lbt_obj->channel_index      = 0;
+    smtc_lbt_clear_channel_stats( lbt_obj );
     rp_release_hook( rp, lbt_id_rp );
     rp_hook_init( rp, lbt_id_rp, ( void ( * )( void* ) )( smtc_lbt_rp_callback ), lbt_obj );
 }
@@ -99,44 +136,22 @@ bool smtc_lbt_get_state( smtc_lbt_t* lbt_obj )
 
 void smtc_lbt_launch_callback_for_rp( void* rp_void )
 {
-    radio_planner_t* rp = ( radio_planner_t* ) rp_void;
-    uint8_t          id = rp->radio_task_id;
-    int16_t          rssi_tmp;
-    smtc_modem_hal_start_radio_tcxo( );
-    smtc_modem_hal_assert( ral_set_pkt_type( &( rp->radio->ral ), rp->radio_params[id].pkt_type ) == RAL_STATUS_OK );
-    smtc_modem_hal_assert( ral_set_rf_freq( &( rp->radio->ral ), rp->radio_params[id].rx.gfsk.rf_freq_in_hz ) ==
-                           RAL_STATUS_OK );
-    smtc_modem_hal_assert( ral_set_gfsk_mod_params( &( rp->radio->ral ), &rp->radio_params[id].rx.gfsk.mod_params ) ==
-                           RAL_STATUS_OK );
-    smtc_modem_hal_assert( ral_set_dio_irq_params( &( rp->radio->ral ), RAL_IRQ_NONE ) == RAL_STATUS_OK );
-    smtc_modem_hal_assert( ral_set_rx( &( rp->radio->ral ), RAL_RX_TIMEOUT_CONTINUOUS_MODE ) == RAL_STATUS_OK );
-
-    uint32_t carrier_sense_time = smtc_modem_hal_get_time_in_ms( );
-    while( ( int32_t )( carrier_sense_time + LAP_OF_TIME_TO_GET_A_RSSI_VALID - smtc_modem_hal_get_time_in_ms( ) ) > 0 )
-    {  // delay LAP_OF_TIME_TO_GET_A_RSSI_VALID ms
-    }
-    do
-    {
-        smtc_modem_hal_assert( ral_get_rssi_inst( &( rp->radio->ral ), &rssi_tmp ) == RAL_STATUS_OK );
-        ( ( smtc_lbt_t* ) rp->hooks[id] )->rssi_inst = rssi_tmp;
-        ( ( smtc_lbt_t* ) rp->hooks[id] )->rssi_accu += rssi_tmp;
-        ( ( smtc_lbt_t* ) rp->hooks[id] )->rssi_nb_of_meas++;
-        if( rssi_tmp >= rp->radio_params[id].lbt_threshold )
-        {
-            SMTC_MODEM_HAL_TRACE_PRINTF( "lbt rssi: %d dBm\n", rssi_tmp );
-            rp->status[id] = RP_STATUS_LBT_BUSY_CHANNEL;
-            rp_radio_irq_callback( rp_void );
-            return;
-        }
-    } while( ( int32_t )( carrier_sense_time + rp->radio_params[id].rx.timeout_in_ms -
-                          smtc_modem_hal_get_time_in_ms( ) ) > 0 );
+    radio_planner_t* rp      = ( radio_planner_t* ) rp_void;
+    smtc_lbt_t*      lbt_obj = ( smtc_lbt_t* ) rp->hooks[rp->radio_task_id];
 
-    rp->status[id] = RP_STATUS_LBT_FREE_CHANNEL;
-    rp_radio_irq_callback( rp_void );
+    smtc_modem_hal_start_radio_tcxo( );
+    lbt_obj->channel_index = 0;
+    smtc_lbt_channel_start( rp, lbt_obj );
 }
 
 void smtc_lbt_listen_channel( smtc_lbt_t* lbt_obj, uint32_t freq, bool is_at_time, uint32_t target_time_ms,
                               uint32_t tx_duration_ms )
+{
+    smtc_lbt_listen_channels( lbt_obj, &freq, 1, is_at_time, target_time_ms, tx_duration_ms );
+}
+
+void smtc_lbt_listen_channels( smtc_lbt_t* lbt_obj, const uint32_t* freq_list, uint8_t nb_freq, bool is_at_time,
+                               uint32_t target_time_ms, uint32_t tx_duration_ms )
 {
     lbt_obj->is_at_time = is_at_time;
     if( ( lbt_obj->free_callback == NULL ) || ( lbt_obj->busy_callback == NULL ) ||
@@ -144,6 +159,22 @@ void smtc_lbt_listen_channel( smtc_lbt_t* lbt_obj, uint32_t freq, bool is_at_tim
     {
         smtc_modem_hal_mcu_panic( "lbt_obj bad initialization \n" );
     }
+    if( ( freq_list == NULL ) || ( nb_freq == 0 ) )
+    {
+        smtc_modem_hal_mcu_panic( "lbt no channel to listen \n" );
+    }
+
+    // Scanning the next candidates would delay a transmission at time
+    if( ( is_at_time == true ) || ( nb_freq > SMTC_LBT_CHANNELS_MAX ) )
+    {
+        nb_freq = ( is_at_time == true ) ? 1 : SMTC_LBT_CHANNELS_MAX;
+    }
+    for( uint8_t i = 0; i < nb_freq; i++ )
+    {
+        lbt_obj->channel_freq[i] = freq_list[i];
+    }
+    lbt_obj->channel_nb    = nb_freq;
+    lbt_obj->channel_index = 0;
 
     ralf_params_gfsk_t gfsk_param;
     rp_radio_params_t  radio_params;
@@ -153,7 +184,7 @@ void smtc_lbt_listen_channel( smtc_lbt_t* lbt_obj, uint32_t freq, bool is_at_tim
     memset( &gfsk_param, 0, sizeof( ralf_params_gfsk_t ) );
 
     gfsk_param.dc_free_is_on = true;
-    gfsk_param.rf_freq_in_hz = freq;
+    gfsk_param.rf_freq_in_hz = freq_list[0];
 
     gfsk_param.mod_params.br_in_bps    = lbt_obj->bw_hz >> 1;
     gfsk_param.mod_params.bw_dsb_in_hz = lbt_obj->bw_hz;
@@ -171,7 +202,7 @@ void smtc_lbt_listen_channel( smtc_lbt_t* lbt_obj, uint32_t freq, bool is_at_tim
         smtc_modem_hal_mcu_panic( "radioplanner isn't initialized for lbt obj \n" );
     }
     rp_task.hook_id               = my_hook_id;
-    rp_task.duration_time_ms      = lbt_obj->listen_duration_ms + tx_duration_ms;
+    rp_task.duration_time_ms      = ( nb_freq * lbt_obj->listen_duration_ms ) + tx_duration_ms;
     rp_task.type                  = RP_TASK_TYPE_LBT;
     rp_task.launch_task_callbacks = smtc_lbt_launch_callback_for_rp;
     rp_task.start_time_ms =
@@ -191,8 +222,8 @@ void smtc_lbt_listen_channel( smtc_lbt_t* lbt_obj, uint32_t freq, bool is_at_tim
     }
     else
     {
-        SMTC_MODEM_HAL_TRACE_PRINTF( "  Listen Frequency = %u during %d ms \n", freq,
-                                     lbt_obj->listen_duration_ms - LAP_OF_TIME_TO_GET_A_RSSI_VALID );
+        SMTC_MODEM_HAL_TRACE_PRINTF( "  Listen Frequency = %u during %d ms (%u candidates)\n", freq_list[0],
+                                     lbt_obj->listen_duration_ms - LAP_OF_TIME_TO_GET_A_RSSI_VALID, nb_freq );
     }
 }
 
@@ -223,4 +254,125 @@ void smtc_lbt_rp_callback( smtc_lbt_t* lbt_obj )
     {
         lbt_obj->abort_callback( lbt_obj->abort_context );
     }
-}
\ No newline at end of file
+}
+
+uint8_t smtc_lbt_get_channel_index( smtc_lbt_t* lbt_obj )
+{
+    return lbt_obj->channel_index;
+}
+
+uint8_t smtc_lbt_get_channel_stats( smtc_lbt_t* lbt_obj, smtc_lbt_channel_stats_t* stats )
+{
+    uint8_t nb = 0;
+
+    for( uint8_t i = 0; i < SMTC_LBT_STATS_NB; i++ )
+    {
+        if( lbt_obj->stats[i].freq_hz != 0 )
+        {
+            stats[nb++] = lbt_obj->stats[i];
+        }
+    }
+    return nb;
+}
+
+void smtc_lbt_clear_channel_stats( smtc_lbt_t* lbt_obj )
+{
+    memset( lbt_obj->stats, 0, sizeof( lbt_obj->stats ) );
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static void smtc_lbt_channel_start( radio_planner_t* rp, smtc_lbt_t* lbt_obj )
+{
+    uint8_t id = rp->radio_task_id;
+
+    // The frequency of the following candidates can only be changed in standby
+    smtc_modem_hal_assert( ral_set_standby( &( rp->radio->ral ), RAL_STANDBY_CFG_RC ) == RAL_STATUS_OK );
+    smtc_modem_hal_assert( ral_set_pkt_type( &( rp->radio->ral ), rp->radio_params[id].pkt_type ) == RAL_STATUS_OK );
+    smtc_modem_hal_assert( ral_set_rf_freq( &( rp->radio->ral ), lbt_obj->channel_freq[lbt_obj->channel_index] ) ==
+                           RAL_STATUS_OK );
+    smtc_modem_hal_assert( ral_set_gfsk_mod_params( &( rp->radio->ral ), &rp->radio_params[id].rx.gfsk.mod_params ) ==
+                           RAL_STATUS_OK );
+    smtc_modem_hal_assert( ral_set_dio_irq_params( &( rp->radio->ral ), RAL_IRQ_NONE ) == RAL_STATUS_OK );
+    smtc_modem_hal_assert( ral_set_rx( &( rp->radio->ral ), RAL_RX_TIMEOUT_CONTINUOUS_MODE ) == RAL_STATUS_OK );
+
+    lbt_obj->channel_start_ms = smtc_modem_hal_get_time_in_ms( );
+    rp_radio_task_timer_start( rp, LAP_OF_TIME_TO_GET_A_RSSI_VALID, smtc_lbt_sample_callback_for_rp );
+}
+
+static void smtc_lbt_sample_callback_for_rp( void* rp_void )
+{
+    radio_planner_t* rp      = ( radio_planner_t* ) rp_void;
+    uint8_t          id      = rp->radio_task_id;
+    smtc_lbt_t*      lbt_obj = ( smtc_lbt_t* ) rp->hooks[id];
+    uint32_t         freq    = lbt_obj->channel_freq[lbt_obj->channel_index];
+    int16_t          rssi_tmp;
+
+    smtc_modem_hal_assert( ral_get_rssi_inst( &( rp->radio->ral ), &rssi_tmp ) == RAL_STATUS_OK );
+    lbt_obj->rssi_inst = rssi_tmp;
+    lbt_obj->rssi_accu += rssi_tmp;
+    lbt_obj->rssi_nb_of_meas++;
+
+    if( rssi_tmp >= rp->radio_params[id].lbt_threshold )
+    {
+        SMTC_MODEM_HAL_TRACE_PRINTF( "lbt rssi: %d dBm on %u\n", rssi_tmp, freq );
+        smtc_lbt_stats_update( lbt_obj, freq, true );
+
+        lbt_obj->channel_index++;
+        if( lbt_obj->channel_index < lbt_obj->channel_nb )
+        {
+            smtc_lbt_channel_start( rp, lbt_obj );
+            return;
+        }
+        rp->status[id] = RP_STATUS_LBT_BUSY_CHANNEL;
+        rp_radio_irq_callback( rp_void );
+        return;
+    }
+
+    if( ( int32_t )( lbt_obj->channel_start_ms + rp->radio_params[id].rx.timeout_in_ms -
+                     smtc_modem_hal_get_time_in_ms( ) ) > 0 )
+    {
+        rp_radio_task_timer_start( rp, SMTC_LBT_SAMPLE_PERIOD_MS, smtc_lbt_sample_callback_for_rp );
+        return;
+    }
+
+    smtc_lbt_stats_update( lbt_obj, freq, false );
+    rp->status[id] = RP_STATUS_LBT_FREE_CHANNEL;
+    rp_radio_irq_callback( rp_void );
+}
+
+static void smtc_lbt_stats_update( smtc_lbt_t* lbt_obj, uint32_t freq, bool is_busy )
+{
+    smtc_lbt_channel_stats_t* entry = NULL;
+
+    for( uint8_t i = 0; i < SMTC_LBT_STATS_NB; i++ )
+    {
+        if( lbt_obj->stats[i].freq_hz == freq )
+        {
+            entry = &lbt_obj->stats[i];
+            break;
+        }
+        if( ( entry == NULL ) && ( lbt_obj->stats[i].freq_hz == 0 ) )
+        {
+            entry = &lbt_obj->stats[i];
+        }
+    }
+    if( entry == NULL )
+    {
+        // Table full, the channel is not accounted
+        return;
+    }
+    entry->freq_hz       = freq;
+    entry->last_rssi_dbm = lbt_obj->rssi_inst;
+    if( is_busy == true )
+    {
+        entry->busy_cnt++;
+    }
+    else
+    {
+        entry->free_cnt++;
+    }
+}
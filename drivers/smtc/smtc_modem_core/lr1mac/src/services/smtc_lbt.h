@@ -48,6 +48,18 @@ extern "C" {
  * ============================================================================
  */
 #define LAP_OF_TIME_TO_GET_A_RSSI_VALID 2  // duration to stabilize the radio after rx cmd in ms
+#define SMTC_LBT_SAMPLE_PERIOD_MS 1        // period between two rssi samples in ms, the cpu is released in between
+#define SMTC_LBT_CHANNELS_MAX 4            // max number of candidate channels scanned by one listen task
+#define SMTC_LBT_STATS_NB 16               // number of channels with busy/free statistics
+
+typedef struct smtc_lbt_channel_stats_s
+{
+    uint32_t freq_hz;        // channel frequency, 0 if the entry is unused
+    uint32_t free_cnt;       // number of listen windows which found the channel free
+    uint32_t busy_cnt;       // number of listen windows which found the channel busy
+    int16_t  last_rssi_dbm;  // last rssi measured on the channel
+} smtc_lbt_channel_stats_t;
+
 typedef struct smtc_lbt_s
 {
     radio_planner_t* rp;
@@ -66,6 +78,12 @@ typedef struct smtc_lbt_s
     int32_t  rssi_accu;
     uint32_t rssi_nb_of_meas;
     bool     enabled;
+    uint32_t channel_freq[SMTC_LBT_CHANNELS_MAX];
+    uint8_t  channel_nb;
+    uint8_t  channel_index;  // candidate channel currently listened, or found free
+    uint32_t channel_start_ms;
+
+    smtc_lbt_channel_stats_t stats[SMTC_LBT_STATS_NB];
     /* data */
 } smtc_lbt_t;
 
@@ -137,6 +155,47 @@ bool smtc_lbt_get_state( smtc_lbt_t* lbt_obj );
 void smtc_lbt_listen_channel( smtc_lbt_t* lbt_obj, uint32_t freq, bool is_at_time, uint32_t target_time_ms,
                               uint32_t tx_duration_ms );
 
+/**
+ * @brief smtc_lbt_listen_channels listen a list of candidate channels in a row until a free one is found
+ *
+ * @remark The free callback is called for the first free channel, see @ref smtc_lbt_get_channel_index.
+ *         The busy callback is called only if all candidates are busy. A listen at time only scans the first candidate
+ *         as the following ones would delay the transmission.
+ *
+ * @param lbt_obj pointer to lbt_obj itself
+ * @param freq_list candidate listen frequencies in hertz, by order of preference
+ * @param nb_freq number of candidates, clamped to SMTC_LBT_CHANNELS_MAX
+ * @param is_at_time is a listen at time or asap
+ * @param target_time_ms time to start the listening
+ * @param tx_duration_ms duration of the transmission if channel is free ( allow to book the radio planer )
+ */
+void smtc_lbt_listen_channels( smtc_lbt_t* lbt_obj, const uint32_t* freq_list, uint8_t nb_freq, bool is_at_time,
+                               uint32_t target_time_ms, uint32_t tx_duration_ms );
+
+/**
+ * @brief Return the index in the candidate list of the channel found free by the last listen task
+ *
+ * @param [in] lbt_obj pointer to lbt_obj itself
+ * @return uint8_t index of the free channel
+ */
+uint8_t smtc_lbt_get_channel_index( smtc_lbt_t* lbt_obj );
+
+/**
+ * @brief Get the busy/free statistics of the listened channels
+ *
+ * @param [in]  lbt_obj pointer to lbt_obj itself
+ * @param [out] stats   statistics of the channels, at least SMTC_LBT_STATS_NB entries
+ * @return uint8_t number of channels written in stats
+ */
+uint8_t smtc_lbt_get_channel_stats( smtc_lbt_t* lbt_obj, smtc_lbt_channel_stats_t* stats );
+
+/**
+ * @brief Clear the busy/free statistics of the listened channels
+ *
+ * @param [in] lbt_obj pointer to lbt_obj itself
+ */
+void smtc_lbt_clear_channel_stats( smtc_lbt_t* lbt_obj );
+
 /**
  * @brief smtc_lbt_rp_callback this function is call by the radio planer when lbt task is finished
  *
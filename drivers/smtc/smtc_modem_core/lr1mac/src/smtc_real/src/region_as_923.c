@@ -58,11 +58,73 @@
 #define dr_distribution lr1_mac->real->region.as923.dr_distribution
 #define unwrapped_channel_mask lr1_mac->real->region.as923.unwrapped_channel_mask
 
+#define FREQOFFSET_HZ_AS_923( grp ) ( FREQOFFSET_GRP##grp##_AS_923 * FREQUENCY_FACTOR_AS_923 )
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE CONSTANTS -------------------------------------------------------
  */
 
+/**
+ * Region constants, kept in flash and bound to smtc_real_t.real_const. Frequencies depend on the AS923 group so one
+ * descriptor is built per group
+ */
+#define REGION_AS_923_CONST( grp )                                                                                    \
+    {                                                                                                                 \
+        .number_of_tx_channel   = NUMBER_OF_CHANNEL_AS_923,                                                           \
+        .number_of_rx_channel   = NUMBER_OF_CHANNEL_AS_923,                                                           \
+        .number_of_boot_tx_channel = NUMBER_OF_BOOT_TX_CHANNEL_AS_923,                                                \
+        .number_of_channel_bank = BANK_MAX_AS923,                                                                     \
+        .join_accept_delay1     = JOIN_ACCEPT_DELAY1_AS_923,                                                          \
+        .received_delay1        = RECEIVE_DELAY1_AS_923,                                                              \
+        .tx_power_dbm           = TX_POWER_EIRP_AS_923 - 2,  /* EIRP to ERP */                                        \
+        .max_tx_power_idx       = MAX_TX_POWER_IDX_AS_923,                                                            \
+        .adr_ack_limit          = ADR_ACK_LIMIT_AS_923,                                                               \
+        .adr_ack_delay          = ADR_ACK_DELAY_AS_923,                                                               \
+        .datarate_backoff       = &datarate_backoff_as_923[0][0],                                                     \
+        .ack_timeout            = ACK_TIMEOUT_AS_923,                                                                 \
+        .frequency_factor       = FREQUENCY_FACTOR_AS_923,                                                            \
+        .frequency_offset_hz    = FREQOFFSET_HZ_AS_923( grp ),                                                        \
+        .freq_min               = FREQMIN_GRP##grp##_AS_923,                                                          \
+        .freq_max               = FREQMAX_GRP##grp##_AS_923,                                                          \
+        .rx2_freq               = RX2_FREQ_AS_923 + FREQOFFSET_HZ_AS_923( grp ),                                      \
+        .rx2_dr_init            = RX2DR_INIT_AS_923,                                                                  \
+        .sync_word_private      = SYNC_WORD_PRIVATE_AS_923,                                                           \
+        .sync_word_public       = SYNC_WORD_PUBLIC_AS_923,                                                            \
+        .sync_word_gfsk         = ( uint8_t* ) SYNC_WORD_GFSK_AS_923,                                                 \
+        .min_tx_dr              = MIN_DR_AS_923,                                                                      \
+        .max_tx_dr              = MAX_DR_AS_923,                                                                      \
+        .min_tx_dr_limit        = MIN_TX_DR_LIMIT_AS_923,                                                             \
+        .min_rx_dr              = MIN_DR_AS_923,                                                                      \
+        .max_rx_dr              = MAX_DR_AS_923,                                                                      \
+        .number_rx1_dr_offset   = NUMBER_RX1_DR_OFFSET_AS_923,                                                        \
+        .dr_bitfield            = DR_BITFIELD_SUPPORTED_AS_923,                                                       \
+        .default_tx_dr_bit_field = DEFAULT_TX_DR_BIT_FIELD_AS_923,                                                    \
+        .number_of_tx_dr        = NUMBER_OF_TX_DR_AS_923,                                                             \
+        .tx_param_setup_req_supported = TX_PARAM_SETUP_REQ_SUPPORTED_AS_923,                                          \
+        .new_channel_req_supported = NEW_CHANNEL_REQ_SUPPORTED_AS_923,                                                \
+        .dtc_supported          = DTC_SUPPORTED_AS_923,                                                               \
+        .lbt_supported          = LBT_SUPPORTED_AS_923,                                                               \
+        .lbt_sniff_duration_ms  = LBT_SNIFF_DURATION_MS_AS_923,                                                       \
+        .lbt_threshold_dbm      = LBT_THRESHOLD_DBM_AS_923,                                                           \
+        .lbt_bw_hz              = LBT_BW_HZ_AS_923,                                                                   \
+        .max_payload_m          = &M_as_923[0][0],                                                                    \
+        .coding_rate            = RAL_LORA_CR_4_5,                                                                    \
+        .mobile_longrange_dr_distri = &MOBILE_LONGRANGE_DR_DISTRIBUTION_AS_923[0],                                    \
+        .mobile_lowpower_dr_distri = &MOBILE_LOWPER_DR_DISTRIBUTION_AS_923[0],                                        \
+        .join_dr_distri         = &JOIN_DR_DISTRIBUTION_AS_923[0],                                                    \
+        .default_dr_distri      = &DEFAULT_DR_DISTRIBUTION_AS_923[0],                                                 \
+        .cf_list_type_supported = CF_LIST_SUPPORTED_AS_923,                                                           \
+        .beacon_dr              = BEACON_DR_AS_923,                                                                   \
+        .beacon_frequency       = BEACON_FREQ_AS_923 + FREQOFFSET_HZ_AS_923( grp ),                                   \
+        .ping_slot_frequency    = PING_SLOT_FREQ_AS_923 + FREQOFFSET_HZ_AS_923( grp ),                                \
+    }
+
+static const smtc_real_const_t region_as_923_grp1_const = REGION_AS_923_CONST( 1 );
+static const smtc_real_const_t region_as_923_grp2_const = REGION_AS_923_CONST( 2 );
+static const smtc_real_const_t region_as_923_grp3_const = REGION_AS_923_CONST( 3 );
+static const smtc_real_const_t region_as_923_grp4_const = REGION_AS_923_CONST( 4 );
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE TYPES -----------------------------------------------------------
@@ -84,87 +146,33 @@
  */
 void region_as_923_config( lr1_stack_mac_t* lr1_mac, uint8_t group_id )
 {
-    const_number_of_tx_channel      = NUMBER_OF_CHANNEL_AS_923;
-    const_number_of_rx_channel      = NUMBER_OF_CHANNEL_AS_923;
-    const_number_of_boot_tx_channel = NUMBER_OF_BOOT_TX_CHANNEL_AS_923;
-    const_number_of_channel_bank    = BANK_MAX_AS923;
-    const_join_accept_delay1        = JOIN_ACCEPT_DELAY1_AS_923;
-    const_received_delay1           = RECEIVE_DELAY1_AS_923;
-    const_tx_power_dbm              = TX_POWER_EIRP_AS_923 - 2;  // EIRP to ERP
-    const_max_tx_power_idx          = MAX_TX_POWER_IDX_AS_923;
-    const_adr_ack_limit             = ADR_ACK_LIMIT_AS_923;
-    const_adr_ack_delay             = ADR_ACK_DELAY_AS_923;
-    const_datarate_backoff          = &datarate_backoff_as_923[0][0];
-    const_ack_timeout               = ACK_TIMEOUT_AS_923;
-    const_frequency_factor          = FREQUENCY_FACTOR_AS_923;
-
     switch( group_id )
     {
     case 1:  // AS923 groupe 1
-        const_frequency_offset_hz = FREQOFFSET_GRP1_AS_923 * const_frequency_factor;
-        const_freq_min            = FREQMIN_GRP1_AS_923;
-        const_freq_max            = FREQMAX_GRP1_AS_923;
+        lr1_mac->real->real_const = &region_as_923_grp1_const;
         break;
     case 2:  // AS923 groupe 2
-        const_frequency_offset_hz = FREQOFFSET_GRP2_AS_923 * const_frequency_factor;
-        const_freq_min            = FREQMIN_GRP2_AS_923;
-        const_freq_max            = FREQMAX_GRP2_AS_923;
+        lr1_mac->real->real_const = &region_as_923_grp2_const;
         break;
     case 3:  // AS923 groupe 3
-        const_frequency_offset_hz = FREQOFFSET_GRP3_AS_923 * const_frequency_factor;
-        const_freq_min            = FREQMIN_GRP3_AS_923;
-        const_freq_max            = FREQMAX_GRP3_AS_923;
+        lr1_mac->real->real_const = &region_as_923_grp3_const;
         break;
     case 4:  // AS923 groupe 4
-        const_frequency_offset_hz = FREQOFFSET_GRP4_AS_923 * const_frequency_factor;
-        const_freq_min            = FREQMIN_GRP4_AS_923;
-        const_freq_max            = FREQMAX_GRP4_AS_923;
+        lr1_mac->real->real_const = &region_as_923_grp4_const;
         break;
     default:
         smtc_modem_hal_lr1mac_panic( );
         break;
     }
 
-    const_rx2_freq = RX2_FREQ_AS_923 + const_frequency_offset_hz;
-
-    const_rx2_dr_init                  = RX2DR_INIT_AS_923;
-    const_sync_word_private            = SYNC_WORD_PRIVATE_AS_923;
-    const_sync_word_public             = SYNC_WORD_PUBLIC_AS_923;
-    const_sync_word_gfsk               = ( uint8_t* ) SYNC_WORD_GFSK_AS_923;
-    const_min_tx_dr                    = MIN_DR_AS_923;
-    const_max_tx_dr                    = MAX_DR_AS_923;
-    const_min_tx_dr_limit              = MIN_TX_DR_LIMIT_AS_923;
-    const_min_rx_dr                    = MIN_DR_AS_923;
-    const_max_rx_dr                    = MAX_DR_AS_923;
-    const_number_rx1_dr_offset         = NUMBER_RX1_DR_OFFSET_AS_923;
-    const_dr_bitfield                  = DR_BITFIELD_SUPPORTED_AS_923;
-    const_default_tx_dr_bit_field      = DEFAULT_TX_DR_BIT_FIELD_AS_923;
-    const_number_of_tx_dr              = NUMBER_OF_TX_DR_AS_923;
-    const_tx_param_setup_req_supported = TX_PARAM_SETUP_REQ_SUPPORTED_AS_923;
-    const_new_channel_req_supported    = NEW_CHANNEL_REQ_SUPPORTED_AS_923;
-    const_dtc_supported                = DTC_SUPPORTED_AS_923;
-    const_lbt_supported                = LBT_SUPPORTED_AS_923;
-    const_lbt_sniff_duration_ms        = LBT_SNIFF_DURATION_MS_AS_923;
-    const_lbt_threshold_dbm            = LBT_THRESHOLD_DBM_AS_923;
-    const_lbt_bw_hz                    = LBT_BW_HZ_AS_923;
-    const_max_payload_m                = &M_as_923[0][0];
-    const_coding_rate                  = RAL_LORA_CR_4_5;
-    const_mobile_longrange_dr_distri   = &MOBILE_LONGRANGE_DR_DISTRIBUTION_AS_923[0];
-    const_mobile_lowpower_dr_distri    = &MOBILE_LOWPER_DR_DISTRIBUTION_AS_923[0];
-    const_join_dr_distri               = &JOIN_DR_DISTRIBUTION_AS_923[0];
-    const_default_dr_distri            = &DEFAULT_DR_DISTRIBUTION_AS_923[0];
-    const_cf_list_type_supported       = CF_LIST_SUPPORTED_AS_923;
-    const_beacon_dr                    = BEACON_DR_AS_923;
-    const_beacon_frequency             = BEACON_FREQ_AS_923 + const_frequency_offset_hz;
-    const_ping_slot_frequency          = PING_SLOT_FREQ_AS_923 + const_frequency_offset_hz;
-
-    real_ctx.tx_frequency_channel_ctx   = &tx_frequency_channel[0];
-    real_ctx.rx1_frequency_channel_ctx  = &rx1_frequency_channel[0];
-    real_ctx.channel_index_enabled_ctx  = &channel_index_enabled[0];
-    real_ctx.unwrapped_channel_mask_ctx = &unwrapped_channel_mask[0];
-    real_ctx.dr_bitfield_tx_channel_ctx = &dr_bitfield_tx_channel[0];
-    real_ctx.dr_distribution_init_ctx   = &dr_distribution_init[0];
-    real_ctx.dr_distribution_ctx        = &dr_distribution[0];
+    real_ctx.tx_frequency_channel_ctx       = &tx_frequency_channel[0];
+    real_ctx.rx1_frequency_channel_ctx      = &rx1_frequency_channel[0];
+    real_ctx.channel_index_enabled_ctx      = &channel_index_enabled[0];
+    real_ctx.unwrapped_channel_mask_ctx     = &unwrapped_channel_mask[0];
+    real_ctx.dr_bitfield_tx_channel_ctx     = &dr_bitfield_tx_channel[0];
+    real_ctx.dr_bitfield_tx_channel_nwk_ctx = &dr_bitfield_tx_channel[0];
+    real_ctx.dr_distribution_init_ctx       = &dr_distribution_init[0];
+    real_ctx.dr_distribution_ctx            = &dr_distribution[0];
 
     memset1( dr_distribution_init, 1, const_number_of_tx_dr );
     memset1( dr_distribution, 0, const_number_of_tx_dr );
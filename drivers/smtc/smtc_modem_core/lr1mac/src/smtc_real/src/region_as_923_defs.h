@@ -197,8 +197,8 @@ static const uint8_t datarate_backoff_as_923[2][8] = { {
                                                            6   // DR7 -> DR6
                                                        } };
 
-static const uint8_t NUMBER_RX1_DR_OFFSET_AS_923 =
-    sizeof( datarate_offsets_dwell_time_1_as_923[0] ) / sizeof( datarate_offsets_dwell_time_1_as_923[0][0] );
+#define NUMBER_RX1_DR_OFFSET_AS_923 \
+    ( sizeof( datarate_offsets_dwell_time_1_as_923[0] ) / sizeof( datarate_offsets_dwell_time_1_as_923[0][0] ) )
 /**
  * Data rates table definition
  */
@@ -51,7 +51,6 @@
 
 #define real_ctx lr1_mac->real->real_ctx
 
-#define dr_bitfield_tx_channel lr1_mac->real->region.au915.dr_bitfield_tx_channel
 #define channel_index_enabled lr1_mac->real->region.au915.channel_index_enabled
 #define dr_distribution_init lr1_mac->real->region.au915.dr_distribution_init
 #define dr_distribution lr1_mac->real->region.au915.dr_distribution
@@ -66,6 +65,51 @@
  * --- PRIVATE CONSTANTS -------------------------------------------------------
  */
 
+/**
+ * Region constants, kept in flash and bound to smtc_real_t.real_const by region_au_915_config( )
+ */
+static const smtc_real_const_t region_au_915_const = {
+    .number_of_tx_channel   = NUMBER_OF_TX_CHANNEL_AU_915,
+    .number_of_rx_channel   = NUMBER_OF_RX_CHANNEL_AU_915,
+    .number_of_channel_bank = BANK_MAX_AU915,
+    .join_accept_delay1     = JOIN_ACCEPT_DELAY1_AU_915,
+    .received_delay1        = RECEIVE_DELAY1_AU_915,
+    .tx_power_dbm           = TX_POWER_EIRP_AU_915 - 2,  // EIRP to ERP
+    .max_tx_power_idx       = MAX_TX_POWER_IDX_AU_915,
+    .adr_ack_limit          = ADR_ACK_LIMIT_AU_915,
+    .adr_ack_delay          = ADR_ACK_DELAY_AU_915,
+    .datarate_backoff       = &datarate_backoff_au_915[0][0],
+    .ack_timeout            = ACK_TIMEOUT_AU_915,
+    .freq_min               = FREQMIN_AU_915,
+    .freq_max               = FREQMAX_AU_915,
+    .rx2_freq               = RX2_FREQ_AU_915,
+    .frequency_factor       = FREQUENCY_FACTOR_AU_915,
+    .rx2_dr_init            = RX2DR_INIT_AU_915,
+    .sync_word_private      = SYNC_WORD_PRIVATE_AU_915,
+    .sync_word_public       = SYNC_WORD_PUBLIC_AU_915,
+    .sync_word_lr_fhss      = ( uint8_t* ) SYNC_WORD_LR_FHSS_AU_915,
+    .min_tx_dr              = MIN_TX_DR_AU_915,
+    .max_tx_dr              = MAX_TX_DR_AU_915,
+    .min_tx_dr_limit        = MIN_TX_DR_LIMIT_AU_915,
+    .number_of_tx_dr        = NUMBER_OF_TX_DR_AU_915,
+    .min_rx_dr              = MIN_RX_DR_AU_915,
+    .max_rx_dr              = MAX_RX_DR_AU_915,
+    .number_rx1_dr_offset   = NUMBER_RX1_DR_OFFSET_AU_915,
+    .dr_bitfield            = DR_BITFIELD_SUPPORTED_AU_915,
+    .tx_param_setup_req_supported = TX_PARAM_SETUP_REQ_SUPPORTED_AU_915,
+    .new_channel_req_supported = NEW_CHANNEL_REQ_SUPPORTED_AU_923,
+    .dtc_supported          = DTC_SUPPORTED_AU_915,
+    .lbt_supported          = LBT_SUPPORTED_AU_915,
+    .max_payload_m          = &M_au_915[0][0],
+    .coding_rate            = RAL_LORA_CR_4_5,
+    .mobile_longrange_dr_distri = &MOBILE_LONGRANGE_DR_DISTRIBUTION_AU_915[0],
+    .mobile_lowpower_dr_distri = &MOBILE_LOWPER_DR_DISTRIBUTION_AU_915[0],
+    .join_dr_distri         = &JOIN_DR_DISTRIBUTION_AU_915[0],
+    .default_dr_distri      = &DEFAULT_DR_DISTRIBUTION_AU_915[0],
+    .cf_list_type_supported = CF_LIST_SUPPORTED_AU_915,
+    .beacon_dr              = BEACON_DR_AU_915,
+};
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE TYPES -----------------------------------------------------------
@@ -95,6 +139,17 @@ typedef enum ch_mask_after_join_e
  */
 static void region_au_915_channel_mask_set_after_join( lr1_stack_mac_t* lr1_mac );
 
+/**
+ * @brief Keep in a channel mask only the channels able to transmit at a datarate
+ *
+ * @remark The datarates of a channel only depend on its bandwidth, so the per-datarate channel bitmaps are the
+ *         const 125 kHz / 500 kHz bank masks: no per-channel scan is needed
+ *
+ * @param [in,out] channel_mask Channel mask of BANK_MAX_AU915 bytes
+ * @param [in]     dr           Datarate
+ */
+static void region_au_915_channel_mask_filter_dr( uint8_t* channel_mask, uint8_t dr );
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
@@ -102,53 +157,16 @@ static void region_au_915_channel_mask_set_after_join( lr1_stack_mac_t* lr1_mac
 
 void region_au_915_config( lr1_stack_mac_t* lr1_mac )
 {
-    const_number_of_tx_channel         = NUMBER_OF_TX_CHANNEL_AU_915;
-    const_number_of_rx_channel         = NUMBER_OF_RX_CHANNEL_AU_915;
-    const_number_of_channel_bank       = BANK_MAX_AU915;
-    const_join_accept_delay1           = JOIN_ACCEPT_DELAY1_AU_915;
-    const_received_delay1              = RECEIVE_DELAY1_AU_915;
-    const_tx_power_dbm                 = TX_POWER_EIRP_AU_915 - 2;  // EIRP to ERP
-    const_max_tx_power_idx             = MAX_TX_POWER_IDX_AU_915;
-    const_adr_ack_limit                = ADR_ACK_LIMIT_AU_915;
-    const_adr_ack_delay                = ADR_ACK_DELAY_AU_915;
-    const_datarate_backoff             = &datarate_backoff_au_915[0][0];
-    const_ack_timeout                  = ACK_TIMEOUT_AU_915;
-    const_freq_min                     = FREQMIN_AU_915;
-    const_freq_max                     = FREQMAX_AU_915;
-    const_rx2_freq                     = RX2_FREQ_AU_915;
-    const_frequency_factor             = FREQUENCY_FACTOR_AU_915;
-    const_rx2_dr_init                  = RX2DR_INIT_AU_915;
-    const_sync_word_private            = SYNC_WORD_PRIVATE_AU_915;
-    const_sync_word_public             = SYNC_WORD_PUBLIC_AU_915;
-    const_sync_word_lr_fhss            = ( uint8_t* ) SYNC_WORD_LR_FHSS_AU_915;
-    const_min_tx_dr                    = MIN_TX_DR_AU_915;
-    const_max_tx_dr                    = MAX_TX_DR_AU_915;
-    const_min_tx_dr_limit              = MIN_TX_DR_LIMIT_AU_915;
-    const_number_of_tx_dr              = NUMBER_OF_TX_DR_AU_915;
-    const_min_rx_dr                    = MIN_RX_DR_AU_915;
-    const_max_rx_dr                    = MAX_RX_DR_AU_915;
-    const_number_rx1_dr_offset         = NUMBER_RX1_DR_OFFSET_AU_915;
-    const_dr_bitfield                  = DR_BITFIELD_SUPPORTED_AU_915;
-    const_tx_param_setup_req_supported = TX_PARAM_SETUP_REQ_SUPPORTED_AU_915;
-    const_new_channel_req_supported    = NEW_CHANNEL_REQ_SUPPORTED_AU_923;
-    const_dtc_supported                = DTC_SUPPORTED_AU_915;
-    const_lbt_supported                = LBT_SUPPORTED_AU_915;
-    const_max_payload_m                = &M_au_915[0][0];
-    const_coding_rate                  = RAL_LORA_CR_4_5;
-    const_mobile_longrange_dr_distri   = &MOBILE_LONGRANGE_DR_DISTRIBUTION_AU_915[0];
-    const_mobile_lowpower_dr_distri    = &MOBILE_LOWPER_DR_DISTRIBUTION_AU_915[0];
-    const_join_dr_distri               = &JOIN_DR_DISTRIBUTION_AU_915[0];
-    const_default_dr_distri            = &DEFAULT_DR_DISTRIBUTION_AU_915[0];
-    const_cf_list_type_supported       = CF_LIST_SUPPORTED_AU_915;
-    const_beacon_dr                    = BEACON_DR_AU_915;
-
-    real_ctx.tx_frequency_channel_ctx   = NULL;
-    real_ctx.rx1_frequency_channel_ctx  = NULL;
-    real_ctx.channel_index_enabled_ctx  = &channel_index_enabled[0];
-    real_ctx.unwrapped_channel_mask_ctx = &unwrapped_channel_mask[0];
-    real_ctx.dr_bitfield_tx_channel_ctx = &dr_bitfield_tx_channel[0];
-    real_ctx.dr_distribution_init_ctx   = &dr_distribution_init[0];
-    real_ctx.dr_distribution_ctx        = &dr_distribution[0];
+    lr1_mac->real->real_const = &region_au_915_const;
+
+    real_ctx.tx_frequency_channel_ctx       = NULL;
+    real_ctx.rx1_frequency_channel_ctx      = NULL;
+    real_ctx.channel_index_enabled_ctx      = &channel_index_enabled[0];
+    real_ctx.unwrapped_channel_mask_ctx     = &unwrapped_channel_mask[0];
+    real_ctx.dr_bitfield_tx_channel_ctx     = &dr_bitfield_tx_channel_au_915[0];
+    real_ctx.dr_bitfield_tx_channel_nwk_ctx = NULL;
+    real_ctx.dr_distribution_init_ctx       = &dr_distribution_init[0];
+    real_ctx.dr_distribution_ctx            = &dr_distribution[0];
 
     memset1( dr_distribution_init, 0, const_number_of_tx_dr );
     memset1( dr_distribution, 0, const_number_of_tx_dr );
@@ -167,23 +185,18 @@ void region_au_915_init( lr1_stack_mac_t* lr1_mac )
     {
         SMTC_PUT_BIT8( channel_index_enabled, i, CHANNEL_ENABLED );
 
-        // Enable default datarate
-        dr_bitfield_tx_channel[i] = DEFAULT_TX_DR_125_BIT_FIELD_AU_915;
-
         SMTC_MODEM_HAL_TRACE_PRINTF( "TX - idx:%u, freq: %d, dr: 0x%x,\n%s", i,
-                                     region_au_915_get_tx_frequency_channel( lr1_mac, i ), dr_bitfield_tx_channel[i],
-                                     ( ( i % 8 ) == 7 ) ? "---\n" : "" );
+                                     region_au_915_get_tx_frequency_channel( lr1_mac, i ),
+                                     dr_bitfield_tx_channel_au_915[i], ( ( i % 8 ) == 7 ) ? "---\n" : "" );
     }
     // Tx 500 kHz channels
     for( uint8_t i = NUMBER_OF_TX_CHANNEL_AU_915 - 8; i < NUMBER_OF_TX_CHANNEL_AU_915; i++ )
     {
         SMTC_PUT_BIT8( channel_index_enabled, i, CHANNEL_ENABLED );
-        // Enable default datarate
-        dr_bitfield_tx_channel[i] = DEFAULT_TX_DR_500_BIT_FIELD_AU_915;
 
         SMTC_MODEM_HAL_TRACE_PRINTF( "TX - idx:%u, freq: %d, dr: 0x%x,\n%s", i,
-                                     region_au_915_get_tx_frequency_channel( lr1_mac, i ), dr_bitfield_tx_channel[i],
-                                     ( ( i % 8 ) == 7 ) ? "---\n" : "" );
+                                     region_au_915_get_tx_frequency_channel( lr1_mac, i ),
+                                     dr_bitfield_tx_channel_au_915[i], ( ( i % 8 ) == 7 ) ? "---\n" : "" );
     }
 #if MODEM_HAL_DBG_TRACE == MODEM_HAL_FEATURE_ON
     // Rx 500 kHz channels
@@ -204,35 +217,15 @@ void region_au_915_init( lr1_stack_mac_t* lr1_mac )
 status_lorawan_t region_au_915_is_acceptable_tx_dr( lr1_stack_mac_t* lr1_mac, uint8_t dr,
                                                     bool is_ch_mask_from_link_adr )
 {
-    status_lorawan_t status                      = ERRORLORAWAN;
-    uint8_t          number_channels_125_enabled = 0;
-
     uint8_t* ch_mask_to_check = ( is_ch_mask_from_link_adr == true ) ? unwrapped_channel_mask : channel_index_enabled;
+    uint8_t  dr_channel_mask[BANK_MAX_AU915];
 
-    // 125 kHz channels
-    for( uint8_t i = 0; i < const_number_of_tx_channel - 8; i++ )
-    {
-        if( SMTC_GET_BIT8( ch_mask_to_check, i ) == CHANNEL_ENABLED )
-        {
-            if( SMTC_GET_BIT16( &dr_bitfield_tx_channel[i], dr ) == 1 )
-            {
-                status = OKLORAWAN;
-                number_channels_125_enabled++;
-            }
-        }
-    }
-    // 500 kHz channels
-    for( uint8_t i = const_number_of_tx_channel - 8; i < const_number_of_tx_channel; i++ )
-    {
-        if( SMTC_GET_BIT8( ch_mask_to_check, i ) == CHANNEL_ENABLED )
-        {
-            if( SMTC_GET_BIT16( &dr_bitfield_tx_channel[i], dr ) == 1 )
-            {
-                status = OKLORAWAN;
-                break;
-            }
-        }
-    }
+    memcpy1( dr_channel_mask, ch_mask_to_check, BANK_MAX_AU915 );
+    region_au_915_channel_mask_filter_dr( dr_channel_mask, dr );
+
+    status_lorawan_t status =
+        ( SMTC_ARE_CLR_BYTE8( dr_channel_mask, BANK_MAX_AU915 ) == true ) ? ERRORLORAWAN : OKLORAWAN;
+    uint8_t number_channels_125_enabled = SMTC_COUNT_BIT8( dr_channel_mask, BANK_8_500_AU915 );
 
     if( dr < MAX_TX_DR_LORA_AU_915 )
     {
@@ -261,8 +254,9 @@ status_lorawan_t region_au_915_is_acceptable_tx_dr( lr1_stack_mac_t* lr1_mac, ui
 status_lorawan_t region_au_915_get_join_next_channel( lr1_stack_mac_t* lr1_mac )
 {
     au_915_channels_bank_t bank_tmp_cnt = 0;
+    uint8_t                bank        = 0;
+    uint8_t                active_channel_mask;
     uint8_t                active_channel_nb;
-    uint8_t                active_channel_index[NUMBER_OF_TX_CHANNEL_AU_915];
     do
     {
         if( snapshot_bank_tx_mask > BANK_8_500_AU915 )
@@ -276,28 +270,9 @@ status_lorawan_t region_au_915_get_join_next_channel( lr1_stack_mac_t* lr1_mac )
             snapshot_channel_tx_mask[snapshot_bank_tx_mask] = channel_index_enabled[snapshot_bank_tx_mask];
         }
 
-        active_channel_nb = 0;
-        for( uint8_t i = snapshot_bank_tx_mask * 8; i < ( ( snapshot_bank_tx_mask * 8 ) + 8 ); i++ )
-        {
-            if( snapshot_bank_tx_mask == BANK_8_500_AU915 )
-            {
-                if( ( SMTC_GET_BIT8( snapshot_channel_tx_mask, i ) == CHANNEL_ENABLED ) &&
-                    ( SMTC_GET_BIT8( channel_index_enabled, i ) == CHANNEL_ENABLED ) )
-                {
-                    active_channel_index[active_channel_nb] = i;
-                    active_channel_nb++;
-                }
-            }
-            else
-            {
-                if( ( SMTC_GET_BIT8( snapshot_channel_tx_mask, i ) == CHANNEL_ENABLED ) &&
-                    ( SMTC_GET_BIT8( channel_index_enabled, i ) == CHANNEL_ENABLED ) )
-                {
-                    active_channel_index[active_channel_nb] = i;
-                    active_channel_nb++;
-                }
-            }
-        }
+        bank                = snapshot_bank_tx_mask;
+        active_channel_mask = snapshot_channel_tx_mask[bank] & channel_index_enabled[bank];
+        active_channel_nb   = SMTC_COUNT_BIT8( &active_channel_mask, 1 );
         snapshot_bank_tx_mask++;
         bank_tmp_cnt++;
     } while( ( active_channel_nb == 0 ) && ( bank_tmp_cnt < BANK_MAX_AU915 ) );
@@ -308,25 +283,13 @@ status_lorawan_t region_au_915_get_join_next_channel( lr1_stack_mac_t* lr1_mac )
         return ERRORLORAWAN;
     }
 
-    uint8_t temp        = 0xFF;
-    uint8_t channel_idx = 0;
-    if( snapshot_bank_tx_mask > BANK_8_500_AU915 )
-    {
-        // active_channel_index[0] contains the first available 500KHz channel
-        channel_idx = active_channel_index[0];
-    }
-    else
+    uint8_t temp = 0;
+    if( bank != BANK_8_500_AU915 )
     {
-        temp        = ( smtc_modem_hal_get_random_nb_in_range( 0, ( active_channel_nb - 1 ) ) ) % active_channel_nb;
-        channel_idx = active_channel_index[temp];
-    }
-
-    if( channel_idx >= NUMBER_OF_TX_CHANNEL_AU_915 )
-    {
-        SMTC_MODEM_HAL_TRACE_PRINTF( "INVALID CHANNEL  active channel = %d and random channel = %d \n",
-                                     active_channel_nb, temp );
-        return ERRORLORAWAN;
+        // The first available 500KHz channel is used, a random one in 125KHz banks
+        temp = ( smtc_modem_hal_get_random_nb_in_range( 0, ( active_channel_nb - 1 ) ) ) % active_channel_nb;
     }
+    uint8_t channel_idx = ( bank * 8 ) + SMTC_GET_NTH_SET_BIT8( &active_channel_mask, 1, temp );
 
     // Mask the channel used, to be remove for the next selection
     SMTC_PUT_BIT8( snapshot_channel_tx_mask, channel_idx, CHANNEL_DISABLED );
@@ -394,25 +357,23 @@ status_lorawan_t region_au_915_get_next_channel( lr1_stack_mac_t* lr1_mac )
         region_au_915_init_after_join_snapshot_channel_mask( lr1_mac );
     }
 
-    uint8_t active_channel_nb = 0;
-    uint8_t active_channel_index[NUMBER_OF_TX_CHANNEL_AU_915];
-    for( uint8_t i = 0; i < NUMBER_OF_TX_CHANNEL_AU_915; i++ )
+    // Channels not used yet in the snapshot, enabled, and able to transmit at the current datarate
+    uint8_t active_channel_mask[BANK_MAX_AU915];
+    for( uint8_t i = 0; i < BANK_MAX_AU915; i++ )
     {
-        if( ( SMTC_GET_BIT8( snapshot_channel_tx_mask, i ) == CHANNEL_ENABLED ) &&
-            ( SMTC_GET_BIT8( channel_index_enabled, i ) == CHANNEL_ENABLED ) &&
-            ( SMTC_GET_BIT16( &dr_bitfield_tx_channel[i], lr1_mac->tx_data_rate ) == 1 ) )
-        {
-            active_channel_index[active_channel_nb] = i;
-            active_channel_nb++;
-        }
+        active_channel_mask[i] = snapshot_channel_tx_mask[i] & channel_index_enabled[i];
     }
+    region_au_915_channel_mask_filter_dr( active_channel_mask, lr1_mac->tx_data_rate );
+
+    uint8_t active_channel_nb = SMTC_COUNT_BIT8( active_channel_mask, BANK_MAX_AU915 );
     if( active_channel_nb == 0 )
     {
         smtc_modem_hal_lr1mac_panic( "NO CHANNELS AVAILABLE\n" );
     }
 
+    // Select a channel in the mask
     uint8_t temp        = ( smtc_modem_hal_get_random_nb_in_range( 0, ( active_channel_nb - 1 ) ) ) % active_channel_nb;
-    uint8_t channel_idx = active_channel_index[temp];
+    uint8_t channel_idx = SMTC_GET_NTH_SET_BIT8( active_channel_mask, BANK_MAX_AU915, temp );
     if( channel_idx >= NUMBER_OF_TX_CHANNEL_AU_915 )
     {
         SMTC_MODEM_HAL_TRACE_PRINTF( "INVALID CHANNEL  active channel = %d and random channel = %d \n",
@@ -639,13 +600,11 @@ void region_au_915_enable_all_channels_with_valid_freq( lr1_stack_mac_t* lr1_mac
     for( uint8_t i = 0; i < NUMBER_OF_TX_CHANNEL_AU_915 - 8; i++ )
     {
         SMTC_PUT_BIT8( channel_index_enabled, i, CHANNEL_ENABLED );
-        dr_bitfield_tx_channel[i] = DEFAULT_TX_DR_125_BIT_FIELD_AU_915;
     }
     // Tx 500 kHz channels
     for( uint8_t i = NUMBER_OF_TX_CHANNEL_AU_915 - 8; i < NUMBER_OF_TX_CHANNEL_AU_915; i++ )
     {
         SMTC_PUT_BIT8( channel_index_enabled, i, CHANNEL_ENABLED );
-        dr_bitfield_tx_channel[i] = DEFAULT_TX_DR_500_BIT_FIELD_AU_915;
     }
 }
 
@@ -692,6 +651,12 @@ void region_au_915_lr_fhss_dr_to_cr_bw( uint8_t in_dr, lr_fhss_v1_cr_t* out_cr,
     }
 }
 
+uint8_t region_au_915_get_number_of_chmask_in_cflist( lr1_stack_mac_t* lr1_mac )
+{
+    UNUSED( lr1_mac );
+    return 5;
+}
+
 uint32_t region_au_915_get_tx_frequency_channel( lr1_stack_mac_t* lr1_mac, uint8_t index )
 {
     uint32_t freq = 0;
@@ -710,11 +675,13 @@ uint32_t region_au_915_get_tx_frequency_channel( lr1_stack_mac_t* lr1_mac, uint8
 
 uint32_t region_au_915_get_rx1_frequency_channel( lr1_stack_mac_t* lr1_mac, uint8_t index )
 {
+    UNUSED( lr1_mac );
     return ( DEFAULT_RX_FREQ_500_START_AU_915 + ( ( index % 8 ) * DEFAULT_RX_STEP_500_AU_915 ) );
 }
 
 uint32_t region_au_915_get_rx_beacon_frequency_channel( lr1_stack_mac_t* lr1_mac, uint32_t gps_time_s )
 {
+    UNUSED( lr1_mac );
     uint8_t index = ( uint32_t )( floorf( gps_time_s / 128 ) ) % 8;
     return ( BEACON_FREQ_START_AU_915 + ( index * BEACON_STEP_AU_915 ) );
 }
@@ -722,6 +689,7 @@ uint32_t region_au_915_get_rx_beacon_frequency_channel( lr1_stack_mac_t* lr1_mac
 uint32_t region_au_915_get_rx_ping_slot_frequency_channel( lr1_stack_mac_t* lr1_mac, uint32_t gps_time_s,
                                                            uint32_t dev_addr )
 {
+    UNUSED( lr1_mac );
     uint8_t index = ( dev_addr + ( uint32_t )( floorf( gps_time_s / 128 ) ) ) % 8;
     return ( PING_SLOT_FREQ_START_AU_915 + ( index * PING_SLOT_STEP_AU_915 ) );
 }
@@ -754,4 +722,16 @@ static void region_au_915_channel_mask_set_after_join( lr1_stack_mac_t* lr1_mac
     first_ch_mask_received++;
 }
 
+static void region_au_915_channel_mask_filter_dr( uint8_t* channel_mask, uint8_t dr )
+{
+    uint8_t mask_125 = ( ( ( DEFAULT_TX_DR_125_BIT_FIELD_AU_915 >> dr ) & 0x01 ) == 1 ) ? 0xFF : 0x00;
+    uint8_t mask_500 = ( ( ( DEFAULT_TX_DR_500_BIT_FIELD_AU_915 >> dr ) & 0x01 ) == 1 ) ? 0xFF : 0x00;
+
+    for( uint8_t i = 0; i < BANK_8_500_AU915; i++ )
+    {
+        channel_mask[i] &= mask_125;
+    }
+    channel_mask[BANK_8_500_AU915] &= mask_500;
+}
+
 /* --- EOF ------------------------------------------------------------------ */
@@ -175,6 +175,14 @@ void region_au_915_lora_dr_to_sf_bw( uint8_t in_dr, uint8_t* out_sf, lr1mac_band
  */
 void region_au_915_lr_fhss_dr_to_cr_bw( uint8_t in_dr, lr_fhss_v1_cr_t* out_cr, lr_fhss_v1_bw_t* out_bw );
 
+/**
+ * @brief Get the number of channel mask carried by a CFList
+ *
+ * @param lr1_mac
+ * @return uint8_t
+ */
+uint8_t region_au_915_get_number_of_chmask_in_cflist( lr1_stack_mac_t* lr1_mac );
+
 /**
  * \brief
  * \remark
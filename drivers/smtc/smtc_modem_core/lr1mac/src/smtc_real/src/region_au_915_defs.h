@@ -150,13 +150,12 @@ typedef enum au_915_channels_bank_e
 
 typedef struct region_au915_context_s
 {
-    uint16_t dr_bitfield_tx_channel[NUMBER_OF_TX_CHANNEL_AU_915];
-    uint8_t  channel_index_enabled[BANK_MAX_AU915];     // 8ch-125KHz + 1ch-500KHZ // Enable by Network
-    uint8_t  unwrapped_channel_mask[BANK_MAX_AU915];    // 8ch-125KHz + 1ch-500KHZ // Temp conf send by Network
-    uint8_t  snapshot_channel_tx_mask[BANK_MAX_AU915];  // 8ch-125KHz + 1ch-500KHZ // snapshot of used channels
-    uint8_t  dr_distribution_init[NUMBER_OF_TX_DR_AU_915];
-    uint8_t  dr_distribution[NUMBER_OF_TX_DR_AU_915];
-    uint8_t  first_ch_mask_received;
+    uint8_t channel_index_enabled[BANK_MAX_AU915];     // 8ch-125KHz + 1ch-500KHZ // Enable by Network
+    uint8_t unwrapped_channel_mask[BANK_MAX_AU915];    // 8ch-125KHz + 1ch-500KHZ // Temp conf send by Network
+    uint8_t snapshot_channel_tx_mask[BANK_MAX_AU915];  // 8ch-125KHz + 1ch-500KHZ // snapshot of used channels
+    uint8_t dr_distribution_init[NUMBER_OF_TX_DR_AU_915];
+    uint8_t dr_distribution[NUMBER_OF_TX_DR_AU_915];
+    uint8_t first_ch_mask_received;
 
     au_915_channels_bank_t snapshot_bank_tx_mask;
 
@@ -210,8 +209,25 @@ static const uint8_t datarate_backoff_au_915[2][8] = { {
                                                            2   // DR7 -> DR2
                                                        } };
 
-static const uint8_t NUMBER_RX1_DR_OFFSET_AU_915 =
-    sizeof( datarate_offsets_au_915[0] ) / sizeof( datarate_offsets_au_915[0][0] );
+#define NUMBER_RX1_DR_OFFSET_AU_915 ( sizeof( datarate_offsets_au_915[0] ) / sizeof( datarate_offsets_au_915[0][0] ) )
+
+/**
+ * Data rates of each Tx channel, by bank of 8 channels: 125 kHz banks 0 to 7 then the 500 kHz bank 8
+ */
+#define DR_BITFIELD_TX_BANK_AU_915( bit_field ) \
+    bit_field, bit_field, bit_field, bit_field, bit_field, bit_field, bit_field, bit_field
+
+static const uint16_t dr_bitfield_tx_channel_au_915[NUMBER_OF_TX_CHANNEL_AU_915] = {
+    DR_BITFIELD_TX_BANK_AU_915( DEFAULT_TX_DR_125_BIT_FIELD_AU_915 ),
+    DR_BITFIELD_TX_BANK_AU_915( DEFAULT_TX_DR_125_BIT_FIELD_AU_915 ),
+    DR_BITFIELD_TX_BANK_AU_915( DEFAULT_TX_DR_125_BIT_FIELD_AU_915 ),
+    DR_BITFIELD_TX_BANK_AU_915( DEFAULT_TX_DR_125_BIT_FIELD_AU_915 ),
+    DR_BITFIELD_TX_BANK_AU_915( DEFAULT_TX_DR_125_BIT_FIELD_AU_915 ),
+    DR_BITFIELD_TX_BANK_AU_915( DEFAULT_TX_DR_125_BIT_FIELD_AU_915 ),
+    DR_BITFIELD_TX_BANK_AU_915( DEFAULT_TX_DR_125_BIT_FIELD_AU_915 ),
+    DR_BITFIELD_TX_BANK_AU_915( DEFAULT_TX_DR_125_BIT_FIELD_AU_915 ),
+    DR_BITFIELD_TX_BANK_AU_915( DEFAULT_TX_DR_500_BIT_FIELD_AU_915 ),
+};
 
 /**
  * Data rates table definition
@@ -56,11 +56,66 @@
 #define unwrapped_channel_mask lr1_mac->real->region.cn470.unwrapped_channel_mask
 #define activated_by_join_channel lr1_mac->real->region.cn470.activated_by_join_channel
 #define activated_channel_plan lr1_mac->real->region.cn470.activated_channel_plan
+#define tx_dr_channel_mask lr1_mac->real->region.cn470.tx_dr_channel_mask
 
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE CONSTANTS -------------------------------------------------------
  */
+
+/**
+ * Region constants, kept in flash and bound to smtc_real_t.real_const. The number of Tx channels depends on the
+ * activated channel plan so one descriptor is built per plan width
+ */
+#define REGION_CN_470_CONST( nb_tx_channel )                                                                          \
+    {                                                                                                                 \
+        .number_of_tx_channel   = nb_tx_channel,                                                                      \
+        .number_of_rx_channel   = NUMBER_OF_RX_CHANNEL_CN_470,                                                        \
+        .number_of_channel_bank = BANK_MAX_CN470,                                                                     \
+        .join_accept_delay1     = JOIN_ACCEPT_DELAY1_CN_470,                                                          \
+        .received_delay1        = RECEIVE_DELAY1_CN_470,                                                              \
+        .tx_power_dbm           = TX_POWER_EIRP_CN_470 - 2,  /* EIRP to ERP */                                        \
+        .max_tx_power_idx       = MAX_TX_POWER_IDX_CN_470,                                                            \
+        .adr_ack_limit          = ADR_ACK_LIMIT_CN_470,                                                               \
+        .adr_ack_delay          = ADR_ACK_DELAY_CN_470,                                                               \
+        .datarate_backoff       = &datarate_backoff_cn_470[0],                                                        \
+        .ack_timeout            = ACK_TIMEOUT_CN_470,                                                                 \
+        .freq_min               = FREQMIN_CN_470,                                                                     \
+        .freq_max               = FREQMAX_CN_470,                                                                     \
+        .frequency_factor       = FREQUENCY_FACTOR_CN_470,                                                            \
+        .rx2_dr_init            = RX2DR_INIT_CN_470,                                                                  \
+        .sync_word_private      = SYNC_WORD_PRIVATE_CN_470,                                                           \
+        .sync_word_public       = SYNC_WORD_PUBLIC_CN_470,                                                            \
+        .sync_word_gfsk         = ( uint8_t* ) SYNC_WORD_GFSK_CN_470,                                                 \
+        .min_tx_dr              = MIN_TX_DR_CN_470,                                                                   \
+        .max_tx_dr              = MAX_TX_DR_CN_470,                                                                   \
+        .min_tx_dr_limit        = MIN_TX_DR_LIMIT_CN_470,                                                             \
+        .number_of_tx_dr        = NUMBER_OF_TX_DR_CN_470,                                                             \
+        .min_rx_dr              = MIN_RX_DR_CN_470,                                                                   \
+        .max_rx_dr              = MAX_RX_DR_CN_470,                                                                   \
+        .number_rx1_dr_offset   = NUMBER_RX1_DR_OFFSET_CN_470,                                                        \
+        .dr_bitfield            = DR_BITFIELD_SUPPORTED_CN_470,                                                       \
+        .default_tx_dr_bit_field = DEFAULT_TX_DR_BIT_FIELD_CN_470,                                                    \
+        .tx_param_setup_req_supported = TX_PARAM_SETUP_REQ_SUPPORTED_CN_470,                                          \
+        .new_channel_req_supported = NEW_CHANNEL_REQ_SUPPORTED_CN_470,                                                \
+        .dtc_supported          = DTC_SUPPORTED_CN_470,                                                               \
+        .lbt_supported          = LBT_SUPPORTED_CN_470,                                                               \
+        .lbt_sniff_duration_ms  = LBT_SNIFF_DURATION_MS_CN_470,                                                       \
+        .lbt_threshold_dbm      = LBT_THRESHOLD_DBM_CN_470,                                                           \
+        .lbt_bw_hz              = LBT_BW_HZ_CN_470,                                                                   \
+        .max_payload_m          = &M_cn_470[0],                                                                       \
+        .coding_rate            = RAL_LORA_CR_4_5,                                                                    \
+        .mobile_longrange_dr_distri = &MOBILE_LONGRANGE_DR_DISTRIBUTION_CN_470[0],                                    \
+        .mobile_lowpower_dr_distri = &MOBILE_LOWPER_DR_DISTRIBUTION_CN_470[0],                                        \
+        .join_dr_distri         = &JOIN_DR_DISTRIBUTION_CN_470[0],                                                    \
+        .default_dr_distri      = &DEFAULT_DR_DISTRIBUTION_CN_470[0],                                                 \
+        .cf_list_type_supported = CF_LIST_SUPPORTED_CN_470,                                                           \
+        .beacon_dr              = BEACON_DR_CN_470,                                                                   \
+    }
+
+static const smtc_real_const_t region_cn_470_20mhz_const = REGION_CN_470_CONST( NUMBER_OF_TX_CHANNEL_20MHZ_CN_470 );
+static const smtc_real_const_t region_cn_470_26mhz_const = REGION_CN_470_CONST( NUMBER_OF_TX_CHANNEL_26MHZ_CN_470 );
+
 // #if defined( HYBRID_CN470_MONO_CHANNEL )
 // uint32_t freq_tx_cn470_mono_channel_mhz = 470900000;
 // #endif
@@ -89,6 +144,18 @@ static const char* smtc_real_channel_plan_cn470_str[] = {
  * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
  */
 
+/**
+ * @brief Set the datarate bitfield of a channel and keep tx_dr_channel_mask in sync
+ *
+ * @remark Enabled channels all share const_default_tx_dr_bit_field, so tx_dr_channel_mask is the per-datarate
+ *         channel bitmap for every datarate of this bitfield
+ *
+ * @param [in] lr1_mac
+ * @param [in] index     Channel index
+ * @param [in] dr_bitfield
+ */
+static void region_cn_470_set_channel_dr_bitfield( lr1_stack_mac_t* lr1_mac, uint8_t index, uint16_t dr_bitfield );
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
@@ -96,56 +163,17 @@ static const char* smtc_real_channel_plan_cn470_str[] = {
 
 void region_cn_470_config( lr1_stack_mac_t* lr1_mac )
 {
-    const_number_of_tx_channel         = NUMBER_OF_TX_CHANNEL_CN_470;
-    const_number_of_rx_channel         = NUMBER_OF_RX_CHANNEL_CN_470;
-    const_number_of_channel_bank       = BANK_MAX_CN470;
-    const_join_accept_delay1           = JOIN_ACCEPT_DELAY1_CN_470;
-    const_received_delay1              = RECEIVE_DELAY1_CN_470;
-    const_tx_power_dbm                 = TX_POWER_EIRP_CN_470 - 2;  // EIRP to ERP
-    const_max_tx_power_idx             = MAX_TX_POWER_IDX_CN_470;
-    const_adr_ack_limit                = ADR_ACK_LIMIT_CN_470;
-    const_adr_ack_delay                = ADR_ACK_DELAY_CN_470;
-    const_datarate_backoff             = &datarate_backoff_cn_470[0];
-    const_ack_timeout                  = ACK_TIMEOUT_CN_470;
-    const_freq_min                     = FREQMIN_CN_470;
-    const_freq_max                     = FREQMAX_CN_470;
-    const_frequency_factor             = FREQUENCY_FACTOR_CN_470;
-    const_rx2_dr_init                  = RX2DR_INIT_CN_470;
-    const_sync_word_private            = SYNC_WORD_PRIVATE_CN_470;
-    const_sync_word_public             = SYNC_WORD_PUBLIC_CN_470;
-    const_sync_word_gfsk               = ( uint8_t* ) SYNC_WORD_GFSK_CN_470;
-    const_min_tx_dr                    = MIN_TX_DR_CN_470;
-    const_max_tx_dr                    = MAX_TX_DR_CN_470;
-    const_min_tx_dr_limit              = MIN_TX_DR_LIMIT_CN_470;
-    const_number_of_tx_dr              = NUMBER_OF_TX_DR_CN_470;
-    const_min_rx_dr                    = MIN_RX_DR_CN_470;
-    const_max_rx_dr                    = MAX_RX_DR_CN_470;
-    const_number_rx1_dr_offset         = NUMBER_RX1_DR_OFFSET_CN_470;
-    const_dr_bitfield                  = DR_BITFIELD_SUPPORTED_CN_470;
-    const_default_tx_dr_bit_field      = DEFAULT_TX_DR_BIT_FIELD_CN_470;
-    const_tx_param_setup_req_supported = TX_PARAM_SETUP_REQ_SUPPORTED_CN_470;
-    const_new_channel_req_supported    = NEW_CHANNEL_REQ_SUPPORTED_CN_470;
-    const_dtc_supported                = DTC_SUPPORTED_CN_470;
-    const_lbt_supported                = LBT_SUPPORTED_CN_470;
-    const_lbt_sniff_duration_ms        = LBT_SNIFF_DURATION_MS_CN_470;
-    const_lbt_threshold_dbm            = LBT_THRESHOLD_DBM_CN_470;
-    const_lbt_bw_hz                    = LBT_BW_HZ_CN_470;
-    const_max_payload_m                = &M_cn_470[0];
-    const_coding_rate                  = RAL_LORA_CR_4_5;
-    const_mobile_longrange_dr_distri   = &MOBILE_LONGRANGE_DR_DISTRIBUTION_CN_470[0];
-    const_mobile_lowpower_dr_distri    = &MOBILE_LOWPER_DR_DISTRIBUTION_CN_470[0];
-    const_join_dr_distri               = &JOIN_DR_DISTRIBUTION_CN_470[0];
-    const_default_dr_distri            = &DEFAULT_DR_DISTRIBUTION_CN_470[0];
-    const_cf_list_type_supported       = CF_LIST_SUPPORTED_CN_470;
-    const_beacon_dr                    = BEACON_DR_CN_470;
-
-    real_ctx.tx_frequency_channel_ctx   = NULL;
-    real_ctx.rx1_frequency_channel_ctx  = NULL;
-    real_ctx.channel_index_enabled_ctx  = &channel_index_enabled[0];
-    real_ctx.unwrapped_channel_mask_ctx = &unwrapped_channel_mask[0];
-    real_ctx.dr_bitfield_tx_channel_ctx = &dr_bitfield_tx_channel[0];
-    real_ctx.dr_distribution_init_ctx   = &dr_distribution_init[0];
-    real_ctx.dr_distribution_ctx        = &dr_distribution[0];
+    // Bound to the widest plan until region_cn_470_init_session( ) selects the activated one
+    lr1_mac->real->real_const = &region_cn_470_20mhz_const;
+
+    real_ctx.tx_frequency_channel_ctx       = NULL;
+    real_ctx.rx1_frequency_channel_ctx      = NULL;
+    real_ctx.channel_index_enabled_ctx      = &channel_index_enabled[0];
+    real_ctx.unwrapped_channel_mask_ctx     = &unwrapped_channel_mask[0];
+    real_ctx.dr_bitfield_tx_channel_ctx     = &dr_bitfield_tx_channel[0];
+    real_ctx.dr_bitfield_tx_channel_nwk_ctx = NULL;
+    real_ctx.dr_distribution_init_ctx       = &dr_distribution_init[0];
+    real_ctx.dr_distribution_ctx            = &dr_distribution[0];
 
     memset1( dr_distribution_init, 0, const_number_of_tx_dr );
     memset1( dr_distribution, 0, const_number_of_tx_dr );
@@ -162,7 +190,7 @@ void region_cn_470_init( lr1_stack_mac_t* lr1_mac )
     for( uint8_t i = 0; i < const_number_of_tx_channel; i++ )
     {
         SMTC_PUT_BIT8( channel_index_enabled, i, CHANNEL_DISABLED );
-        dr_bitfield_tx_channel[i] = 0;
+        region_cn_470_set_channel_dr_bitfield( lr1_mac, i, 0 );
     }
 
     // Set the Common Join channels configuration
@@ -174,7 +202,7 @@ void region_cn_470_init( lr1_stack_mac_t* lr1_mac )
             err = false;
 #endif
             SMTC_PUT_BIT8( channel_index_enabled, i, CHANNEL_ENABLED );
-            dr_bitfield_tx_channel[i] = const_default_tx_dr_bit_field;
+            region_cn_470_set_channel_dr_bitfield( lr1_mac, i, const_default_tx_dr_bit_field );
 
             SMTC_MODEM_HAL_TRACE_PRINTF(
                 "join: idx:%u, TxFreq: %d, Rx1freq: %d, MaskDrRx1: 0x%x, freqRx2: %d, DrRx2: 0x%x\n%s", i,
@@ -203,13 +231,13 @@ void region_cn_470_init_session( lr1_stack_mac_t* lr1_mac )
     {
     case CN_470_20MHZ_A:
     case CN_470_20MHZ_B:
-        const_number_of_tx_channel = NUMBER_OF_TX_CHANNEL_20MHZ_CN_470;
+        lr1_mac->real->real_const = &region_cn_470_20mhz_const;
 
 #if defined( HYBRID_CN470_MONO_CHANNEL )
         for( uint8_t i = 0; i < const_number_of_tx_channel; i++ )
         {
             SMTC_PUT_BIT8( channel_index_enabled, i, CHANNEL_DISABLED );
-            dr_bitfield_tx_channel[i] = 0;
+            region_cn_470_set_channel_dr_bitfield( lr1_mac, i, 0 );
         }
 #endif
         for( uint8_t i = 0; i < const_number_of_tx_channel; i++ )
@@ -224,7 +252,7 @@ void region_cn_470_init_session( lr1_stack_mac_t* lr1_mac )
                                              region_cn_470_get_rx1_frequency_channel( lr1_mac, i ),
                                              dr_bitfield_tx_channel[i], ( ( i % 8 ) == 7 ) ? "---\n" : "" );
                 SMTC_PUT_BIT8( channel_index_enabled, i, CHANNEL_ENABLED );
-                dr_bitfield_tx_channel[i] = const_default_tx_dr_bit_field;
+                region_cn_470_set_channel_dr_bitfield( lr1_mac, i, const_default_tx_dr_bit_field );
 #if defined( HYBRID_CN470_MONO_CHANNEL )
             }
 #endif
@@ -232,12 +260,12 @@ void region_cn_470_init_session( lr1_stack_mac_t* lr1_mac )
         break;
     case CN_470_26MHZ_A:
     case CN_470_26MHZ_B:
-        const_number_of_tx_channel = NUMBER_OF_TX_CHANNEL_26MHZ_CN_470;
+        lr1_mac->real->real_const = &region_cn_470_26mhz_const;
 #if defined( HYBRID_CN470_MONO_CHANNEL )
         for( uint8_t i = 0; i < const_number_of_tx_channel; i++ )
         {
             SMTC_PUT_BIT8( channel_index_enabled, i, CHANNEL_DISABLED );
-            dr_bitfield_tx_channel[i] = 0;
+            region_cn_470_set_channel_dr_bitfield( lr1_mac, i, 0 );
         }
 #endif
 
@@ -252,7 +280,7 @@ void region_cn_470_init_session( lr1_stack_mac_t* lr1_mac )
                                              region_cn_470_get_tx_frequency_channel( lr1_mac, i ),
                                              dr_bitfield_tx_channel[i], ( ( i % 8 ) == 7 ) ? "---\n" : "" );
                 SMTC_PUT_BIT8( channel_index_enabled, i, CHANNEL_ENABLED );
-                dr_bitfield_tx_channel[i] = const_default_tx_dr_bit_field;
+                region_cn_470_set_channel_dr_bitfield( lr1_mac, i, const_default_tx_dr_bit_field );
 #if defined( HYBRID_CN470_MONO_CHANNEL )
             }
 #endif
@@ -334,20 +362,16 @@ status_lorawan_t region_cn_470_get_join_next_channel( lr1_stack_mac_t* lr1_mac )
 
 status_lorawan_t region_cn_470_get_next_channel( lr1_stack_mac_t* lr1_mac )
 {
-    uint8_t active_channel_nb = 0;
-    uint8_t active_channel_index[NUMBER_OF_TX_CHANNEL_CN_470];
-
-    for( uint8_t i = 0; i < const_number_of_tx_channel; i++ )
+    // Enabled channels able to transmit at the current datarate
+    uint8_t active_channel_mask[BANK_MAX_CN470] = { 0 };
+    if( SMTC_GET_BIT16( &const_default_tx_dr_bit_field, lr1_mac->tx_data_rate ) == 1 )
     {
-        if( SMTC_GET_BIT8( channel_index_enabled, i ) == CHANNEL_ENABLED )
+        for( uint8_t i = 0; i < ( const_number_of_tx_channel / 8 ); i++ )
         {
-            if( SMTC_GET_BIT16( &dr_bitfield_tx_channel[i], lr1_mac->tx_data_rate ) == 1 )
-            {
-                active_channel_index[active_channel_nb] = i;
-                active_channel_nb++;
-            }
+            active_channel_mask[i] = channel_index_enabled[i] & tx_dr_channel_mask[i];
         }
     }
+    uint8_t active_channel_nb = SMTC_COUNT_BIT8( active_channel_mask, BANK_MAX_CN470 );
 
     if( active_channel_nb == 0 )
     {
@@ -355,8 +379,7 @@ status_lorawan_t region_cn_470_get_next_channel( lr1_stack_mac_t* lr1_mac )
         return ERRORLORAWAN;
     }
     uint8_t temp        = ( smtc_modem_hal_get_random_nb_in_range( 0, ( active_channel_nb - 1 ) ) ) % active_channel_nb;
-    uint8_t channel_idx = 0;
-    channel_idx         = active_channel_index[temp];
+    uint8_t channel_idx = SMTC_GET_NTH_SET_BIT8( active_channel_mask, BANK_MAX_CN470, temp );
     if( channel_idx >= const_number_of_tx_channel )
     {
         SMTC_MODEM_HAL_TRACE_PRINTF( "INVALID CHANNEL  active channel = %d and random channel = %d \n",
@@ -527,7 +550,7 @@ void region_cn_470_enable_all_channels_with_valid_freq( lr1_stack_mac_t* lr1_mac
     for( uint8_t i = 0; i < const_number_of_tx_channel; i++ )
     {
         SMTC_PUT_BIT8( channel_index_enabled, i, CHANNEL_ENABLED );
-        dr_bitfield_tx_channel[i] = DEFAULT_TX_DR_BIT_FIELD_CN_470;
+        region_cn_470_set_channel_dr_bitfield( lr1_mac, i, DEFAULT_TX_DR_BIT_FIELD_CN_470 );
     }
 #endif
 }
@@ -659,6 +682,7 @@ uint32_t region_cn_470_get_rx1_frequency_channel( lr1_stack_mac_t* lr1_mac, uint
 channel_plan_type_cn470_t region_cn_470_get_corresponding_plan( lr1_stack_mac_t* lr1_mac,
                                                                 uint8_t          common_join_channel_index )
 {
+    UNUSED( lr1_mac );
     channel_plan_type_cn470_t plan = CN_470_20MHZ_A;
 
     if( common_join_channel_index <= 7 )
@@ -768,4 +792,10 @@ uint32_t region_cn_470_get_rx_ping_slot_frequency_channel( lr1_stack_mac_t* lr1_
  * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
  */
 
+static void region_cn_470_set_channel_dr_bitfield( lr1_stack_mac_t* lr1_mac, uint8_t index, uint16_t dr_bitfield )
+{
+    dr_bitfield_tx_channel[index] = dr_bitfield;
+    SMTC_PUT_BIT8( tx_dr_channel_mask, index, ( dr_bitfield != 0 ) ? 1 : 0 );
+}
+
 /* --- EOF ------------------------------------------------------------------ */
@@ -203,7 +203,8 @@ typedef struct region_cn470_context_s
     uint8_t                   dr_distribution[NUMBER_OF_TX_DR_CN_470];
     uint8_t                   channel_index_enabled[BANK_MAX_CN470];  // Contain the index of the activated channel only
     uint8_t                   unwrapped_channel_mask[BANK_MAX_CN470];
-    uint8_t                   activated_by_join_channel;  // Channel used to join
+    uint8_t                   tx_dr_channel_mask[BANK_MAX_CN470];  // Channels with a non empty dr_bitfield_tx_channel
+    uint8_t                   activated_by_join_channel;           // Channel used to join
     channel_plan_type_cn470_t activated_channel_plan;
 
 } region_cn470_context_t;
@@ -244,8 +245,7 @@ static const uint8_t datarate_backoff_cn_470[] = {
     6   // DR7 -> DR6
 };
 
-static const uint8_t NUMBER_RX1_DR_OFFSET_CN_470 =
-    sizeof( datarate_offsets_cn_470[0] ) / sizeof( datarate_offsets_cn_470[0][0] );
+#define NUMBER_RX1_DR_OFFSET_CN_470 ( sizeof( datarate_offsets_cn_470[0] ) / sizeof( datarate_offsets_cn_470[0][0] ) )
 
 /**
  * Data rates table definition
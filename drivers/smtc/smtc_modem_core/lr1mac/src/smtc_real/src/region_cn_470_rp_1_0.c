@@ -63,6 +63,55 @@
  * -----------------------------------------------------------------------------
  * --- PRIVATE CONSTANTS -------------------------------------------------------
  */
+
+/**
+ * Region constants, kept in flash and bound to smtc_real_t.real_const by region_cn_470_rp_1_0_config( )
+ */
+static const smtc_real_const_t region_cn_470_rp_1_0_const = {
+    .number_of_tx_channel   = NUMBER_OF_TX_CHANNEL_CN_470_RP_1_0,
+    .number_of_rx_channel   = NUMBER_OF_RX_CHANNEL_CN_470_RP_1_0,
+    .number_of_channel_bank = BANK_MAX_CN470_RP_1_0,
+    .join_accept_delay1     = JOIN_ACCEPT_DELAY1_CN_470_RP_1_0,
+    .received_delay1        = RECEIVE_DELAY1_CN_470_RP_1_0,
+    .tx_power_dbm           = TX_POWER_EIRP_CN_470_RP_1_0 - 2,  // EIRP to ERP
+    .max_tx_power_idx       = MAX_TX_POWER_IDX_CN_470_RP_1_0,
+    .adr_ack_limit          = ADR_ACK_LIMIT_CN_470_RP_1_0,
+    .adr_ack_delay          = ADR_ACK_DELAY_CN_470_RP_1_0,
+    .datarate_backoff       = &datarate_backoff_cn_470_rp_1_0[0],
+    .ack_timeout            = ACK_TIMEOUT_CN_470_RP_1_0,
+    .freq_min               = FREQMIN_CN_470_RP_1_0,
+    .freq_max               = FREQMAX_CN_470_RP_1_0,
+    .rx2_freq               = RX2_FREQ_CN_470_RP_1_0,
+    .frequency_factor       = FREQUENCY_FACTOR_CN_470_RP_1_0,
+    .rx2_dr_init            = RX2DR_INIT_CN_470_RP_1_0,
+    .sync_word_private      = SYNC_WORD_PRIVATE_CN_470_RP_1_0,
+    .sync_word_public       = SYNC_WORD_PUBLIC_CN_470_RP_1_0,
+    .sync_word_gfsk         = ( uint8_t* ) SYNC_WORD_GFSK_CN_470_RP_1_0,
+    .min_tx_dr              = MIN_TX_DR_CN_470_RP_1_0,
+    .max_tx_dr              = MAX_TX_DR_CN_470_RP_1_0,
+    .min_tx_dr_limit        = MIN_TX_DR_LIMIT_CN_470_RP_1_0,
+    .number_of_tx_dr        = NUMBER_OF_TX_DR_CN_470_RP_1_0,
+    .min_rx_dr              = MIN_RX_DR_CN_470_RP_1_0,
+    .max_rx_dr              = MAX_RX_DR_CN_470_RP_1_0,
+    .number_rx1_dr_offset   = NUMBER_RX1_DR_OFFSET_CN_470_RP_1_0,
+    .dr_bitfield            = DR_BITFIELD_SUPPORTED_CN_470_RP_1_0,
+    .default_tx_dr_bit_field = DEFAULT_TX_DR_BIT_FIELD_CN_470_RP_1_0,
+    .tx_param_setup_req_supported = TX_PARAM_SETUP_REQ_SUPPORTED_CN_470_RP_1_0,
+    .new_channel_req_supported = NEW_CHANNEL_REQ_SUPPORTED_CN_470_RP_1_0,
+    .dtc_supported          = DTC_SUPPORTED_CN_470_RP_1_0,
+    .lbt_supported          = LBT_SUPPORTED_CN_470_RP_1_0,
+    .lbt_sniff_duration_ms  = LBT_SNIFF_DURATION_MS_CN_470_RP_1_0,
+    .lbt_threshold_dbm      = LBT_THRESHOLD_DBM_CN_470_RP_1_0,
+    .lbt_bw_hz              = LBT_BW_HZ_CN_470_RP_1_0,
+    .max_payload_m          = &M_cn_470_rp_1_0[0],
+    .coding_rate            = RAL_LORA_CR_4_5,
+    .mobile_longrange_dr_distri = &MOBILE_LONGRANGE_DR_DISTRIBUTION_CN_470_RP_1_0[0],
+    .mobile_lowpower_dr_distri = &MOBILE_LOWPER_DR_DISTRIBUTION_CN_470_RP_1_0[0],
+    .join_dr_distri         = &JOIN_DR_DISTRIBUTION_CN_470_RP_1_0[0],
+    .default_dr_distri      = &DEFAULT_DR_DISTRIBUTION_CN_470_RP_1_0[0],
+    .cf_list_type_supported = CF_LIST_SUPPORTED_CN_470_RP_1_0,
+    .beacon_dr              = BEACON_DR_CN_470_RP_1_0,
+};
 #if defined( HYBRID_CN470_MONO_CHANNEL )
 uint32_t freq_tx_cn470_mono_channel_mhz = 471100000;
 #endif
@@ -88,57 +137,16 @@ uint32_t freq_tx_cn470_mono_channel_mhz = 471100000;
  */
 void region_cn_470_rp_1_0_config( lr1_stack_mac_t* lr1_mac )
 {
-    const_number_of_tx_channel         = NUMBER_OF_TX_CHANNEL_CN_470_RP_1_0;
-    const_number_of_rx_channel         = NUMBER_OF_RX_CHANNEL_CN_470_RP_1_0;
-    const_number_of_channel_bank       = BANK_MAX_CN470_RP_1_0;
-    const_join_accept_delay1           = JOIN_ACCEPT_DELAY1_CN_470_RP_1_0;
-    const_received_delay1              = RECEIVE_DELAY1_CN_470_RP_1_0;
-    const_tx_power_dbm                 = TX_POWER_EIRP_CN_470_RP_1_0 - 2;  // EIRP to ERP
-    const_max_tx_power_idx             = MAX_TX_POWER_IDX_CN_470_RP_1_0;
-    const_adr_ack_limit                = ADR_ACK_LIMIT_CN_470_RP_1_0;
-    const_adr_ack_delay                = ADR_ACK_DELAY_CN_470_RP_1_0;
-    const_datarate_backoff             = &datarate_backoff_cn_470_rp_1_0[0];
-    const_ack_timeout                  = ACK_TIMEOUT_CN_470_RP_1_0;
-    const_freq_min                     = FREQMIN_CN_470_RP_1_0;
-    const_freq_max                     = FREQMAX_CN_470_RP_1_0;
-    const_rx2_freq                     = RX2_FREQ_CN_470_RP_1_0;
-    const_frequency_factor             = FREQUENCY_FACTOR_CN_470_RP_1_0;
-    const_rx2_dr_init                  = RX2DR_INIT_CN_470_RP_1_0;
-    const_sync_word_private            = SYNC_WORD_PRIVATE_CN_470_RP_1_0;
-    const_sync_word_public             = SYNC_WORD_PUBLIC_CN_470_RP_1_0;
-    const_sync_word_gfsk               = ( uint8_t* ) SYNC_WORD_GFSK_CN_470_RP_1_0;
-    const_min_tx_dr                    = MIN_TX_DR_CN_470_RP_1_0;
-    const_max_tx_dr                    = MAX_TX_DR_CN_470_RP_1_0;
-    const_min_tx_dr_limit              = MIN_TX_DR_LIMIT_CN_470_RP_1_0;
-    const_number_of_tx_dr              = NUMBER_OF_TX_DR_CN_470_RP_1_0;
-    const_min_rx_dr                    = MIN_RX_DR_CN_470_RP_1_0;
-    const_max_rx_dr                    = MAX_RX_DR_CN_470_RP_1_0;
-    const_number_rx1_dr_offset         = NUMBER_RX1_DR_OFFSET_CN_470_RP_1_0;
-    const_dr_bitfield                  = DR_BITFIELD_SUPPORTED_CN_470_RP_1_0;
-    const_default_tx_dr_bit_field      = DEFAULT_TX_DR_BIT_FIELD_CN_470_RP_1_0;
-    const_tx_param_setup_req_supported = TX_PARAM_SETUP_REQ_SUPPORTED_CN_470_RP_1_0;
-    const_new_channel_req_supported    = NEW_CHANNEL_REQ_SUPPORTED_CN_470_RP_1_0;
-    const_dtc_supported                = DTC_SUPPORTED_CN_470_RP_1_0;
-    const_lbt_supported                = LBT_SUPPORTED_CN_470_RP_1_0;
-    const_lbt_sniff_duration_ms        = LBT_SNIFF_DURATION_MS_CN_470_RP_1_0;
-    const_lbt_threshold_dbm            = LBT_THRESHOLD_DBM_CN_470_RP_1_0;
-    const_lbt_bw_hz                    = LBT_BW_HZ_CN_470_RP_1_0;
-    const_max_payload_m                = &M_cn_470_rp_1_0[0];
-    const_coding_rate                  = RAL_LORA_CR_4_5;
-    const_mobile_longrange_dr_distri   = &MOBILE_LONGRANGE_DR_DISTRIBUTION_CN_470_RP_1_0[0];
-    const_mobile_lowpower_dr_distri    = &MOBILE_LOWPER_DR_DISTRIBUTION_CN_470_RP_1_0[0];
-    const_join_dr_distri               = &JOIN_DR_DISTRIBUTION_CN_470_RP_1_0[0];
-    const_default_dr_distri            = &DEFAULT_DR_DISTRIBUTION_CN_470_RP_1_0[0];
-    const_cf_list_type_supported       = CF_LIST_SUPPORTED_CN_470_RP_1_0;
-    const_beacon_dr                    = BEACON_DR_CN_470_RP_1_0;
-
-    real_ctx.tx_frequency_channel_ctx   = NULL;
-    real_ctx.rx1_frequency_channel_ctx  = NULL;
-    real_ctx.channel_index_enabled_ctx  = &channel_index_enabled[0];
-    real_ctx.unwrapped_channel_mask_ctx = &unwrapped_channel_mask[0];
-    real_ctx.dr_bitfield_tx_channel_ctx = &dr_bitfield_tx_channel[0];
-    real_ctx.dr_distribution_init_ctx   = &dr_distribution_init[0];
-    real_ctx.dr_distribution_ctx        = &dr_distribution[0];
+    lr1_mac->real->real_const = &region_cn_470_rp_1_0_const;
+
+    real_ctx.tx_frequency_channel_ctx       = NULL;
+    real_ctx.rx1_frequency_channel_ctx      = NULL;
+    real_ctx.channel_index_enabled_ctx      = &channel_index_enabled[0];
+    real_ctx.unwrapped_channel_mask_ctx     = &unwrapped_channel_mask[0];
+    real_ctx.dr_bitfield_tx_channel_ctx     = &dr_bitfield_tx_channel[0];
+    real_ctx.dr_bitfield_tx_channel_nwk_ctx = NULL;
+    real_ctx.dr_distribution_init_ctx       = &dr_distribution_init[0];
+    real_ctx.dr_distribution_ctx            = &dr_distribution[0];
 
     memset1( dr_distribution_init, 0, const_number_of_tx_dr );
     memset1( dr_distribution, 0, const_number_of_tx_dr );
@@ -312,6 +320,7 @@ status_lorawan_t region_cn_470_rp_1_0_get_next_channel( lr1_stack_mac_t* lr1_mac
 
 uint8_t region_cn_470_rp_1_0_get_number_of_chmask_in_cflist( lr1_stack_mac_t* lr1_mac )
 {
+    UNUSED( lr1_mac );
     return 6;
 }
 
@@ -434,17 +443,20 @@ void region_cn_470_rp_1_0_lora_dr_to_sf_bw( uint8_t in_dr, uint8_t* out_sf, lr1m
 
 uint32_t region_cn_470_rp_1_0_get_tx_frequency_channel( lr1_stack_mac_t* lr1_mac, uint8_t index )
 {
+    UNUSED( lr1_mac );
     return ( DEFAULT_TX_FREQ_CN_470_RP_1_0 + ( index * DEFAULT_TX_STEP_CN_470_RP_1_0 ) );
 }
 
 uint32_t region_cn_470_rp_1_0_get_rx1_frequency_channel( lr1_stack_mac_t* lr1_mac, uint8_t index )
 {
+    UNUSED( lr1_mac );
     return ( DEFAULT_RX_FREQ_CN_470_RP_1_0 +
              ( ( index % NUMBER_OF_RX_CHANNEL_CN_470_RP_1_0 ) * DEFAULT_RX_STEP_CN_470_RP_1_0 ) );
 }
 
 uint32_t region_cn_470_rp_1_0_get_rx_beacon_frequency_channel( lr1_stack_mac_t* lr1_mac, uint32_t gps_time_s )
 {
+    UNUSED( lr1_mac );
     uint8_t index = ( uint32_t )( floorf( gps_time_s / 128 ) ) % 8;
     return ( BEACON_FREQ_START_CN_470_RP_1_0 + ( ( index % 8 ) * BEACON_STEP_CN_470_RP_1_0 ) );
 }
@@ -452,6 +464,7 @@ uint32_t region_cn_470_rp_1_0_get_rx_beacon_frequency_channel( lr1_stack_mac_t*
 uint32_t region_cn_470_rp_1_0_get_rx_ping_slot_frequency_channel( lr1_stack_mac_t* lr1_mac, uint32_t gps_time_s,
                                                                   uint32_t dev_addr )
 {
+    UNUSED( lr1_mac );
     uint8_t index = ( dev_addr + ( uint32_t )( floorf( gps_time_s / 128 ) ) ) % 8;
     return ( PING_SLOT_FREQ_START_CN_470_RP_1_0 + ( ( index % 8 ) * PING_SLOT_STEP_CN_470_RP_1_0 ) );
 }
@@ -148,8 +148,8 @@ static const uint8_t datarate_backoff_cn_470_rp_1_0[] = {
     4   // DR5 -> DR4
 };
 
-static const uint8_t NUMBER_RX1_DR_OFFSET_CN_470_RP_1_0 =
-    sizeof( datarate_offsets_cn_470_rp_1_0[0] ) / sizeof( datarate_offsets_cn_470_rp_1_0[0][0] );
+#define NUMBER_RX1_DR_OFFSET_CN_470_RP_1_0 \
+    ( sizeof( datarate_offsets_cn_470_rp_1_0[0] ) / sizeof( datarate_offsets_cn_470_rp_1_0[0][0] ) )
 
 /**
  * Data rates table definition
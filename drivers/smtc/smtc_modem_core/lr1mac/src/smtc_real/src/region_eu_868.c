@@ -63,6 +63,61 @@
  * --- PRIVATE CONSTANTS -------------------------------------------------------
  */
 
+/**
+ * Region constants, kept in flash and bound to smtc_real_t.real_const by region_eu_868_config( )
+ */
+static const smtc_real_const_t region_eu_868_const = {
+    .number_of_tx_channel   = NUMBER_OF_CHANNEL_EU_868,
+    .number_of_rx_channel   = NUMBER_OF_CHANNEL_EU_868,
+    .number_of_boot_tx_channel = NUMBER_OF_BOOT_TX_CHANNEL_EU_868,
+    .number_of_channel_bank = BANK_MAX_EU868,
+    .join_accept_delay1     = JOIN_ACCEPT_DELAY1_EU_868,
+    .received_delay1        = RECEIVE_DELAY1_EU_868,
+    .tx_power_dbm           = TX_POWER_EIRP_EU_868 - 2,  // EIRP to ERP
+    .max_tx_power_idx       = MAX_TX_POWER_IDX_EU_868,
+    .adr_ack_limit          = ADR_ACK_LIMIT_EU_868,
+    .adr_ack_delay          = ADR_ACK_DELAY_EU_868,
+    .datarate_backoff       = &datarate_backoff_eu_868[0],
+    .ack_timeout            = ACK_TIMEOUT_EU_868,
+    .freq_min               = FREQMIN_EU_868,
+    .freq_max               = FREQMAX_EU_868,
+    .rx2_freq               = RX2_FREQ_EU_868,
+    .frequency_factor       = FREQUENCY_FACTOR_EU_868,
+    .rx2_dr_init            = RX2DR_INIT_EU_868,
+    .sync_word_private      = SYNC_WORD_PRIVATE_EU_868,
+    .sync_word_public       = SYNC_WORD_PUBLIC_EU_868,
+    .sync_word_gfsk         = ( uint8_t* ) SYNC_WORD_GFSK_EU_868,
+    .sync_word_lr_fhss      = ( uint8_t* ) SYNC_WORD_LR_FHSS_EU_868,
+    .min_tx_dr              = MIN_TX_DR_EU_868,
+    .max_tx_dr              = MAX_TX_DR_EU_868,
+    .min_tx_dr_limit        = MIN_TX_DR_LIMIT_EU_868,
+    .number_of_tx_dr        = NUMBER_OF_TX_DR_EU_868,
+    .min_rx_dr              = MIN_RX_DR_EU_868,
+    .max_rx_dr              = MAX_RX_DR_EU_868,
+    .number_rx1_dr_offset   = NUMBER_RX1_DR_OFFSET_EU_868,
+    .dr_bitfield            = DR_BITFIELD_SUPPORTED_EU_868,
+    .default_tx_dr_bit_field = DEFAULT_TX_DR_BIT_FIELD_EU_868,
+    .tx_param_setup_req_supported = TX_PARAM_SETUP_REQ_SUPPORTED_EU_868,
+    .new_channel_req_supported = NEW_CHANNEL_REQ_SUPPORTED_EU_868,
+    .dtc_supported          = DTC_SUPPORTED_EU_868,
+    .dtc_number_of_band     = BAND_EU868_MAX,
+    .dtc_by_band            = &duty_cycle_by_band_eu_868[0],
+    .lbt_supported          = LBT_SUPPORTED_EU_868,
+    .lbt_sniff_duration_ms  = LBT_SNIFF_DURATION_MS_EU_868,
+    .lbt_threshold_dbm      = LBT_THRESHOLD_DBM_EU_868,
+    .lbt_bw_hz              = LBT_BW_HZ_EU_868,
+    .max_payload_m          = &M_eu_868[0],
+    .coding_rate            = RAL_LORA_CR_4_5,
+    .mobile_longrange_dr_distri = &MOBILE_LONGRANGE_DR_DISTRIBUTION_EU_868[0],
+    .mobile_lowpower_dr_distri = &MOBILE_LOWPER_DR_DISTRIBUTION_EU_868[0],
+    .join_dr_distri         = &JOIN_DR_DISTRIBUTION_EU_868[0],
+    .default_dr_distri      = &DEFAULT_DR_DISTRIBUTION_EU_868[0],
+    .cf_list_type_supported = CF_LIST_SUPPORTED_EU_868,
+    .beacon_dr              = BEACON_DR_EU_868,
+    .beacon_frequency       = BEACON_FREQ_EU_868,
+    .ping_slot_frequency    = PING_SLOT_FREQ_EU_868,
+};
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE TYPES -----------------------------------------------------------
@@ -85,63 +140,16 @@
 
 void region_eu_868_config( lr1_stack_mac_t* lr1_mac )
 {
-    const_number_of_tx_channel         = NUMBER_OF_CHANNEL_EU_868;
-    const_number_of_rx_channel         = NUMBER_OF_CHANNEL_EU_868;
-    const_number_of_boot_tx_channel    = NUMBER_OF_BOOT_TX_CHANNEL_EU_868;
-    const_number_of_channel_bank       = BANK_MAX_EU868;
-    const_join_accept_delay1           = JOIN_ACCEPT_DELAY1_EU_868;
-    const_received_delay1              = RECEIVE_DELAY1_EU_868;
-    const_tx_power_dbm                 = TX_POWER_EIRP_EU_868 - 2;  // EIRP to ERP
-    const_max_tx_power_idx             = MAX_TX_POWER_IDX_EU_868;
-    const_adr_ack_limit                = ADR_ACK_LIMIT_EU_868;
-    const_adr_ack_delay                = ADR_ACK_DELAY_EU_868;
-    const_datarate_backoff             = &datarate_backoff_eu_868[0];
-    const_ack_timeout                  = ACK_TIMEOUT_EU_868;
-    const_freq_min                     = FREQMIN_EU_868;
-    const_freq_max                     = FREQMAX_EU_868;
-    const_rx2_freq                     = RX2_FREQ_EU_868;
-    const_frequency_factor             = FREQUENCY_FACTOR_EU_868;
-    const_rx2_dr_init                  = RX2DR_INIT_EU_868;
-    const_sync_word_private            = SYNC_WORD_PRIVATE_EU_868;
-    const_sync_word_public             = SYNC_WORD_PUBLIC_EU_868;
-    const_sync_word_gfsk               = ( uint8_t* ) SYNC_WORD_GFSK_EU_868;
-    const_sync_word_lr_fhss            = ( uint8_t* ) SYNC_WORD_LR_FHSS_EU_868;
-    const_min_tx_dr                    = MIN_TX_DR_EU_868;
-    const_max_tx_dr                    = MAX_TX_DR_EU_868;
-    const_min_tx_dr_limit              = MIN_TX_DR_LIMIT_EU_868;
-    const_number_of_tx_dr              = NUMBER_OF_TX_DR_EU_868;
-    const_min_rx_dr                    = MIN_RX_DR_EU_868;
-    const_max_rx_dr                    = MAX_RX_DR_EU_868;
-    const_number_rx1_dr_offset         = NUMBER_RX1_DR_OFFSET_EU_868;
-    const_dr_bitfield                  = DR_BITFIELD_SUPPORTED_EU_868;
-    const_default_tx_dr_bit_field      = DEFAULT_TX_DR_BIT_FIELD_EU_868;
-    const_tx_param_setup_req_supported = TX_PARAM_SETUP_REQ_SUPPORTED_EU_868;
-    const_new_channel_req_supported    = NEW_CHANNEL_REQ_SUPPORTED_EU_868;
-    const_dtc_supported                = DTC_SUPPORTED_EU_868;
-    const_dtc_number_of_band           = BAND_EU868_MAX;
-    const_dtc_by_band                  = &duty_cycle_by_band_eu_868[0];
-    const_lbt_supported                = LBT_SUPPORTED_EU_868;
-    const_lbt_sniff_duration_ms        = LBT_SNIFF_DURATION_MS_EU_868;
-    const_lbt_threshold_dbm            = LBT_THRESHOLD_DBM_EU_868;
-    const_lbt_bw_hz                    = LBT_BW_HZ_EU_868;
-    const_max_payload_m                = &M_eu_868[0];
-    const_coding_rate                  = RAL_LORA_CR_4_5;
-    const_mobile_longrange_dr_distri   = &MOBILE_LONGRANGE_DR_DISTRIBUTION_EU_868[0];
-    const_mobile_lowpower_dr_distri    = &MOBILE_LOWPER_DR_DISTRIBUTION_EU_868[0];
-    const_join_dr_distri               = &JOIN_DR_DISTRIBUTION_EU_868[0];
-    const_default_dr_distri            = &DEFAULT_DR_DISTRIBUTION_EU_868[0];
-    const_cf_list_type_supported       = CF_LIST_SUPPORTED_EU_868;
-    const_beacon_dr                    = BEACON_DR_EU_868;
-    const_beacon_frequency             = BEACON_FREQ_EU_868;
-    const_ping_slot_frequency          = PING_SLOT_FREQ_EU_868;
-
-    real_ctx.tx_frequency_channel_ctx   = &tx_frequency_channel[0];
-    real_ctx.rx1_frequency_channel_ctx  = &rx1_frequency_channel[0];
-    real_ctx.channel_index_enabled_ctx  = &channel_index_enabled[0];
-    real_ctx.unwrapped_channel_mask_ctx = &unwrapped_channel_mask[0];
-    real_ctx.dr_bitfield_tx_channel_ctx = &dr_bitfield_tx_channel[0];
-    real_ctx.dr_distribution_init_ctx   = &dr_distribution_init[0];
-    real_ctx.dr_distribution_ctx        = &dr_distribution[0];
+    lr1_mac->real->real_const = &region_eu_868_const;
+
+    real_ctx.tx_frequency_channel_ctx       = &tx_frequency_channel[0];
+    real_ctx.rx1_frequency_channel_ctx      = &rx1_frequency_channel[0];
+    real_ctx.channel_index_enabled_ctx      = &channel_index_enabled[0];
+    real_ctx.unwrapped_channel_mask_ctx     = &unwrapped_channel_mask[0];
+    real_ctx.dr_bitfield_tx_channel_ctx     = &dr_bitfield_tx_channel[0];
+    real_ctx.dr_bitfield_tx_channel_nwk_ctx = &dr_bitfield_tx_channel[0];
+    real_ctx.dr_distribution_init_ctx       = &dr_distribution_init[0];
+    real_ctx.dr_distribution_ctx            = &dr_distribution[0];
 
     memset1( dr_distribution_init, 1, const_number_of_tx_dr );
     memset1( dr_distribution, 0, const_number_of_tx_dr );
@@ -185,17 +193,23 @@ status_lorawan_t region_eu_868_get_join_next_channel( lr1_stack_mac_t* lr1_mac )
 
 status_lorawan_t region_eu_868_get_next_channel( lr1_stack_mac_t* lr1_mac )
 {
-    uint8_t active_channel_nb = 0;
-    uint8_t active_channel_index[NUMBER_OF_CHANNEL_EU_868];
+    uint8_t  active_channel_nb = 0;
+    uint8_t  active_channel_index[NUMBER_OF_CHANNEL_EU_868];
+    uint32_t active_channel_weight[NUMBER_OF_CHANNEL_EU_868];
+    uint32_t weight_sum = 0;
 
     for( uint8_t i = 0; i < const_number_of_tx_channel; i++ )
     {
-        if( SMTC_GET_BIT8( channel_index_enabled, i ) == CHANNEL_ENABLED )
+        if( ( SMTC_GET_BIT8( channel_index_enabled, i ) == CHANNEL_ENABLED ) &&
+            ( SMTC_GET_BIT16( &dr_bitfield_tx_channel[i], lr1_mac->tx_data_rate ) == 1 ) )
         {
-            if( ( smtc_duty_cycle_is_channel_free( lr1_mac->dtc_obj, tx_frequency_channel[i] ) == true ) &&
-                ( SMTC_GET_BIT16( &dr_bitfield_tx_channel[i], lr1_mac->tx_data_rate ) == 1 ) )
+            // The remaining duty cycle budget of the sub-band is used as weight, a full sub-band is skipped
+            uint32_t weight = smtc_duty_cycle_channel_get_available_toa_ms( lr1_mac->dtc_obj, tx_frequency_channel[i] );
+            if( weight > 0 )
             {
-                active_channel_index[active_channel_nb] = i;
+                active_channel_index[active_channel_nb]  = i;
+                active_channel_weight[active_channel_nb] = weight;
+                weight_sum += weight;
                 active_channel_nb++;
             }
         }
@@ -206,7 +220,15 @@ status_lorawan_t region_eu_868_get_next_channel( lr1_stack_mac_t* lr1_mac )
         SMTC_MODEM_HAL_TRACE_WARNING( "NO CHANNELS AVAILABLE \n" );
         return ERRORLORAWAN;
     }
-    uint8_t temp        = ( smtc_modem_hal_get_random_nb_in_range( 0, ( active_channel_nb - 1 ) ) ) % active_channel_nb;
+
+    // Weighted random draw: sub-bands with more airtime left are favoured so the budget is spread across the bands
+    uint32_t draw = smtc_modem_hal_get_random_nb_in_range( 0, ( weight_sum - 1 ) ) % weight_sum;
+    uint8_t  temp = 0;
+    while( ( temp < ( active_channel_nb - 1 ) ) && ( draw >= active_channel_weight[temp] ) )
+    {
+        draw -= active_channel_weight[temp];
+        temp++;
+    }
     uint8_t channel_idx = 0;
     channel_idx         = active_channel_index[temp];
     if( channel_idx >= const_number_of_tx_channel )
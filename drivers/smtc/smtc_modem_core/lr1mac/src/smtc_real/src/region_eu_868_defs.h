@@ -196,8 +196,7 @@ static const uint8_t datarate_backoff_eu_868[] = {
     10  // DR11 -> DR10
 };
 
-static const uint8_t NUMBER_RX1_DR_OFFSET_EU_868 =
-    sizeof( datarate_offsets_eu_868[0] ) / sizeof( datarate_offsets_eu_868[0][0] );
+#define NUMBER_RX1_DR_OFFSET_EU_868 ( sizeof( datarate_offsets_eu_868[0] ) / sizeof( datarate_offsets_eu_868[0][0] ) )
 
 /**
  * Data rates table definition
@@ -62,6 +62,55 @@
  * --- PRIVATE CONSTANTS -------------------------------------------------------
  */
 
+/**
+ * Region constants, kept in flash and bound to smtc_real_t.real_const by region_in_865_config( )
+ */
+static const smtc_real_const_t region_in_865_const = {
+    .number_of_tx_channel   = NUMBER_OF_CHANNEL_IN_865,
+    .number_of_rx_channel   = NUMBER_OF_CHANNEL_IN_865,
+    .number_of_boot_tx_channel = NUMBER_OF_BOOT_TX_CHANNEL_IN_865,
+    .number_of_channel_bank = BANK_MAX_IN865,
+    .join_accept_delay1     = JOIN_ACCEPT_DELAY1_IN_865,
+    .received_delay1        = RECEIVE_DELAY1_IN_865,
+    .tx_power_dbm           = TX_POWER_EIRP_IN_865 - 2,  // EIRP to ERP
+    .max_tx_power_idx       = MAX_TX_POWER_IDX_IN_865,
+    .adr_ack_limit          = ADR_ACK_LIMIT_IN_865,
+    .adr_ack_delay          = ADR_ACK_DELAY_IN_865,
+    .datarate_backoff       = &datarate_backoff_in_865[0],
+    .ack_timeout            = ACK_TIMEOUT_IN_865,
+    .frequency_factor       = FREQUENCY_FACTOR_IN_865,
+    .freq_min               = FREQMIN_IN_865,
+    .freq_max               = FREQMAX_IN_865,
+    .rx2_freq               = RX2_FREQ_IN_865,
+    .rx2_dr_init            = RX2DR_INIT_IN_865,
+    .sync_word_private      = SYNC_WORD_PRIVATE_IN_865,
+    .sync_word_public       = SYNC_WORD_PUBLIC_IN_865,
+    .sync_word_gfsk         = ( uint8_t* ) SYNC_WORD_GFSK_IN_865,
+    .min_tx_dr              = MIN_DR_IN_865,
+    .max_tx_dr              = MAX_DR_IN_865,
+    .min_tx_dr_limit        = MIN_TX_DR_LIMIT_IN_865,
+    .number_of_tx_dr        = NUMBER_OF_TX_DR_IN_865,
+    .min_rx_dr              = MIN_DR_IN_865,
+    .max_rx_dr              = MAX_DR_IN_865,
+    .number_rx1_dr_offset   = NUMBER_RX1_DR_OFFSET_IN_865,
+    .dr_bitfield            = DR_BITFIELD_SUPPORTED_IN_865,
+    .default_tx_dr_bit_field = DEFAULT_TX_DR_BIT_FIELD_IN_865,
+    .tx_param_setup_req_supported = TX_PARAM_SETUP_REQ_SUPPORTED_IN_865,
+    .new_channel_req_supported = NEW_CHANNEL_REQ_SUPPORTED_IN_865,
+    .dtc_supported          = DTC_SUPPORTED_IN_865,
+    .lbt_supported          = LBT_SUPPORTED_IN_865,
+    .max_payload_m          = &M_in_865[0],
+    .coding_rate            = RAL_LORA_CR_4_5,
+    .mobile_longrange_dr_distri = &MOBILE_LONGRANGE_DR_DISTRIBUTION_IN_865[0],
+    .mobile_lowpower_dr_distri = &MOBILE_LOWPER_DR_DISTRIBUTION_IN_865[0],
+    .join_dr_distri         = &JOIN_DR_DISTRIBUTION_IN_865[0],
+    .default_dr_distri      = &DEFAULT_DR_DISTRIBUTION_IN_865[0],
+    .cf_list_type_supported = CF_LIST_SUPPORTED_IN_865,
+    .beacon_dr              = BEACON_DR_IN_865,
+    .beacon_frequency       = BEACON_FREQ_IN_865,
+    .ping_slot_frequency    = PING_SLOT_FREQ_IN_865,
+};
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE TYPES -----------------------------------------------------------
@@ -84,57 +133,16 @@
 
 void region_in_865_config( lr1_stack_mac_t* lr1_mac )
 {
-    const_number_of_tx_channel         = NUMBER_OF_CHANNEL_IN_865;
-    const_number_of_rx_channel         = NUMBER_OF_CHANNEL_IN_865;
-    const_number_of_boot_tx_channel    = NUMBER_OF_BOOT_TX_CHANNEL_IN_865;
-    const_number_of_channel_bank       = BANK_MAX_IN865;
-    const_join_accept_delay1           = JOIN_ACCEPT_DELAY1_IN_865;
-    const_received_delay1              = RECEIVE_DELAY1_IN_865;
-    const_tx_power_dbm                 = TX_POWER_EIRP_IN_865 - 2;  // EIRP to ERP
-    const_max_tx_power_idx             = MAX_TX_POWER_IDX_IN_865;
-    const_adr_ack_limit                = ADR_ACK_LIMIT_IN_865;
-    const_adr_ack_delay                = ADR_ACK_DELAY_IN_865;
-    const_datarate_backoff             = &datarate_backoff_in_865[0];
-    const_ack_timeout                  = ACK_TIMEOUT_IN_865;
-    const_frequency_factor             = FREQUENCY_FACTOR_IN_865;
-    const_freq_min                     = FREQMIN_IN_865;
-    const_freq_max                     = FREQMAX_IN_865;
-    const_rx2_freq                     = RX2_FREQ_IN_865;
-    const_rx2_dr_init                  = RX2DR_INIT_IN_865;
-    const_sync_word_private            = SYNC_WORD_PRIVATE_IN_865;
-    const_sync_word_public             = SYNC_WORD_PUBLIC_IN_865;
-    const_sync_word_gfsk               = ( uint8_t* ) SYNC_WORD_GFSK_IN_865;
-    const_min_tx_dr                    = MIN_DR_IN_865;
-    const_max_tx_dr                    = MAX_DR_IN_865;
-    const_min_tx_dr_limit              = MIN_TX_DR_LIMIT_IN_865;
-    const_number_of_tx_dr              = NUMBER_OF_TX_DR_IN_865;
-    const_min_rx_dr                    = MIN_DR_IN_865;
-    const_max_rx_dr                    = MAX_DR_IN_865;
-    const_number_rx1_dr_offset         = NUMBER_RX1_DR_OFFSET_IN_865;
-    const_dr_bitfield                  = DR_BITFIELD_SUPPORTED_IN_865;
-    const_default_tx_dr_bit_field      = DEFAULT_TX_DR_BIT_FIELD_IN_865;
-    const_tx_param_setup_req_supported = TX_PARAM_SETUP_REQ_SUPPORTED_IN_865;
-    const_new_channel_req_supported    = NEW_CHANNEL_REQ_SUPPORTED_IN_865;
-    const_dtc_supported                = DTC_SUPPORTED_IN_865;
-    const_lbt_supported                = LBT_SUPPORTED_IN_865;
-    const_max_payload_m                = &M_in_865[0];
-    const_coding_rate                  = RAL_LORA_CR_4_5;
-    const_mobile_longrange_dr_distri   = &MOBILE_LONGRANGE_DR_DISTRIBUTION_IN_865[0];
-    const_mobile_lowpower_dr_distri    = &MOBILE_LOWPER_DR_DISTRIBUTION_IN_865[0];
-    const_join_dr_distri               = &JOIN_DR_DISTRIBUTION_IN_865[0];
-    const_default_dr_distri            = &DEFAULT_DR_DISTRIBUTION_IN_865[0];
-    const_cf_list_type_supported       = CF_LIST_SUPPORTED_IN_865;
-    const_beacon_dr                    = BEACON_DR_IN_865;
-    const_beacon_frequency             = BEACON_FREQ_IN_865;
-    const_ping_slot_frequency          = PING_SLOT_FREQ_IN_865;
-
-    real_ctx.tx_frequency_channel_ctx   = &tx_frequency_channel[0];
-    real_ctx.rx1_frequency_channel_ctx  = &rx1_frequency_channel[0];
-    real_ctx.channel_index_enabled_ctx  = &channel_index_enabled[0];
-    real_ctx.unwrapped_channel_mask_ctx = &unwrapped_channel_mask[0];
-    real_ctx.dr_bitfield_tx_channel_ctx = &dr_bitfield_tx_channel[0];
-    real_ctx.dr_distribution_init_ctx   = &dr_distribution_init[0];
-    real_ctx.dr_distribution_ctx        = &dr_distribution[0];
+    lr1_mac->real->real_const = &region_in_865_const;
+
+    real_ctx.tx_frequency_channel_ctx       = &tx_frequency_channel[0];
+    real_ctx.rx1_frequency_channel_ctx      = &rx1_frequency_channel[0];
+    real_ctx.channel_index_enabled_ctx      = &channel_index_enabled[0];
+    real_ctx.unwrapped_channel_mask_ctx     = &unwrapped_channel_mask[0];
+    real_ctx.dr_bitfield_tx_channel_ctx     = &dr_bitfield_tx_channel[0];
+    real_ctx.dr_bitfield_tx_channel_nwk_ctx = &dr_bitfield_tx_channel[0];
+    real_ctx.dr_distribution_init_ctx       = &dr_distribution_init[0];
+    real_ctx.dr_distribution_ctx            = &dr_distribution[0];
 
     memset1( dr_distribution_init, 1, const_number_of_tx_dr );
     memset1( dr_distribution, 0, const_number_of_tx_dr );
@@ -166,6 +174,7 @@ void region_in_865_init( lr1_stack_mac_t* lr1_mac )
 
 void region_in_865_init_session( lr1_stack_mac_t* lr1_mac )
 {
+    UNUSED( lr1_mac );
     // Not used for IN865
     return;
 }
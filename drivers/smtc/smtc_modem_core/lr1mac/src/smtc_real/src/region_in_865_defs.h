@@ -164,8 +164,7 @@ static const uint8_t datarate_backoff_in_865[] = {
     5   // DR7 -> DR5
 };
 
-static const uint8_t NUMBER_RX1_DR_OFFSET_IN_865 =
-    sizeof( datarate_offsets_in_865[0] ) / sizeof( datarate_offsets_in_865[0][0] );
+#define NUMBER_RX1_DR_OFFSET_IN_865 ( sizeof( datarate_offsets_in_865[0] ) / sizeof( datarate_offsets_in_865[0][0] ) )
 
 /**
  * Data rates table definition
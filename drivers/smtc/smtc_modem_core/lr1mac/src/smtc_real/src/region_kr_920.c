@@ -63,6 +63,58 @@
  * --- PRIVATE CONSTANTS -------------------------------------------------------
  */
 
+/**
+ * Region constants, kept in flash and bound to smtc_real_t.real_const by region_kr_920_config( )
+ */
+static const smtc_real_const_t region_kr_920_const = {
+    .number_of_tx_channel   = NUMBER_OF_CHANNEL_KR_920,
+    .number_of_rx_channel   = NUMBER_OF_CHANNEL_KR_920,
+    .number_of_boot_tx_channel = NUMBER_OF_BOOT_TX_CHANNEL_KR_920,
+    .number_of_channel_bank = BANK_MAX_KR920,
+    .join_accept_delay1     = JOIN_ACCEPT_DELAY1_KR_920,
+    .received_delay1        = RECEIVE_DELAY1_KR_920,
+    .tx_power_dbm           = TX_POWER_EIRP_KR_920 - 2,  // EIRP to ERP
+    .max_tx_power_idx       = MAX_TX_POWER_IDX_KR_920,
+    .adr_ack_limit          = ADR_ACK_LIMIT_KR_920,
+    .adr_ack_delay          = ADR_ACK_DELAY_KR_920,
+    .datarate_backoff       = &datarate_backoff_kr_920[0],
+    .ack_timeout            = ACK_TIMEOUT_KR_920,
+    .frequency_factor       = FREQUENCY_FACTOR_KR_920,
+    .freq_min               = FREQMIN_KR_920,
+    .freq_max               = FREQMAX_KR_920,
+    .rx2_freq               = RX2_FREQ_KR_920,
+    .rx2_dr_init            = RX2DR_INIT_KR_920,
+    .sync_word_private      = SYNC_WORD_PRIVATE_KR_920,
+    .sync_word_public       = SYNC_WORD_PUBLIC_KR_920,
+    .sync_word_gfsk         = ( uint8_t* ) SYNC_WORD_GFSK_KR_920,
+    .min_tx_dr              = MIN_DR_KR_920,
+    .max_tx_dr              = MAX_DR_KR_920,
+    .min_tx_dr_limit        = MIN_TX_DR_LIMIT_KR_920,
+    .min_rx_dr              = MIN_DR_KR_920,
+    .max_rx_dr              = MAX_DR_KR_920,
+    .number_rx1_dr_offset   = NUMBER_RX1_DR_OFFSET_KR_920,
+    .dr_bitfield            = DR_BITFIELD_SUPPORTED_KR_920,
+    .default_tx_dr_bit_field = DEFAULT_TX_DR_BIT_FIELD_KR_920,
+    .number_of_tx_dr        = NUMBER_OF_TX_DR_KR_920,
+    .tx_param_setup_req_supported = TX_PARAM_SETUP_REQ_SUPPORTED_KR_920,
+    .new_channel_req_supported = NEW_CHANNEL_REQ_SUPPORTED_KR_920,
+    .dtc_supported          = DTC_SUPPORTED_KR_920,
+    .lbt_supported          = LBT_SUPPORTED_KR_920,
+    .lbt_sniff_duration_ms  = LBT_SNIFF_DURATION_MS_KR_920,
+    .lbt_threshold_dbm      = LBT_THRESHOLD_DBM_KR_920,
+    .lbt_bw_hz              = LBT_BW_HZ_KR_920,
+    .max_payload_m          = &M_kr_920[0],
+    .coding_rate            = RAL_LORA_CR_4_5,
+    .mobile_longrange_dr_distri = &MOBILE_LONGRANGE_DR_DISTRIBUTION_KR_920[0],
+    .mobile_lowpower_dr_distri = &MOBILE_LOWPER_DR_DISTRIBUTION_KR_920[0],
+    .join_dr_distri         = &JOIN_DR_DISTRIBUTION_KR_920[0],
+    .default_dr_distri      = &DEFAULT_DR_DISTRIBUTION_KR_920[0],
+    .cf_list_type_supported = CF_LIST_SUPPORTED_KR_920,
+    .beacon_dr              = BEACON_DR_KR_920,
+    .beacon_frequency       = BEACON_FREQ_KR_920,
+    .ping_slot_frequency    = PING_SLOT_FREQ_KR_920,
+};
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE TYPES -----------------------------------------------------------
@@ -84,60 +136,16 @@
  */
 void region_kr_920_config( lr1_stack_mac_t* lr1_mac )
 {
-    const_number_of_tx_channel         = NUMBER_OF_CHANNEL_KR_920;
-    const_number_of_rx_channel         = NUMBER_OF_CHANNEL_KR_920;
-    const_number_of_boot_tx_channel    = NUMBER_OF_BOOT_TX_CHANNEL_KR_920;
-    const_number_of_channel_bank       = BANK_MAX_KR920;
-    const_join_accept_delay1           = JOIN_ACCEPT_DELAY1_KR_920;
-    const_received_delay1              = RECEIVE_DELAY1_KR_920;
-    const_tx_power_dbm                 = TX_POWER_EIRP_KR_920 - 2;  // EIRP to ERP
-    const_max_tx_power_idx             = MAX_TX_POWER_IDX_KR_920;
-    const_adr_ack_limit                = ADR_ACK_LIMIT_KR_920;
-    const_adr_ack_delay                = ADR_ACK_DELAY_KR_920;
-    const_datarate_backoff             = &datarate_backoff_kr_920[0];
-    const_ack_timeout                  = ACK_TIMEOUT_KR_920;
-    const_frequency_factor             = FREQUENCY_FACTOR_KR_920;
-    const_freq_min                     = FREQMIN_KR_920;
-    const_freq_max                     = FREQMAX_KR_920;
-    const_rx2_freq                     = RX2_FREQ_KR_920;
-    const_rx2_dr_init                  = RX2DR_INIT_KR_920;
-    const_sync_word_private            = SYNC_WORD_PRIVATE_KR_920;
-    const_sync_word_public             = SYNC_WORD_PUBLIC_KR_920;
-    const_sync_word_gfsk               = ( uint8_t* ) SYNC_WORD_GFSK_KR_920;
-    const_min_tx_dr                    = MIN_DR_KR_920;
-    const_max_tx_dr                    = MAX_DR_KR_920;
-    const_min_tx_dr_limit              = MIN_TX_DR_LIMIT_KR_920;
-    const_min_rx_dr                    = MIN_DR_KR_920;
-    const_max_rx_dr                    = MAX_DR_KR_920;
-    const_number_rx1_dr_offset         = NUMBER_RX1_DR_OFFSET_KR_920;
-    const_dr_bitfield                  = DR_BITFIELD_SUPPORTED_KR_920;
-    const_default_tx_dr_bit_field      = DEFAULT_TX_DR_BIT_FIELD_KR_920;
-    const_number_of_tx_dr              = NUMBER_OF_TX_DR_KR_920;
-    const_tx_param_setup_req_supported = TX_PARAM_SETUP_REQ_SUPPORTED_KR_920;
-    const_new_channel_req_supported    = NEW_CHANNEL_REQ_SUPPORTED_KR_920;
-    const_dtc_supported                = DTC_SUPPORTED_KR_920;
-    const_lbt_supported                = LBT_SUPPORTED_KR_920;
-    const_lbt_sniff_duration_ms        = LBT_SNIFF_DURATION_MS_KR_920;
-    const_lbt_threshold_dbm            = LBT_THRESHOLD_DBM_KR_920;
-    const_lbt_bw_hz                    = LBT_BW_HZ_KR_920;
-    const_max_payload_m                = &M_kr_920[0];
-    const_coding_rate                  = RAL_LORA_CR_4_5;
-    const_mobile_longrange_dr_distri   = &MOBILE_LONGRANGE_DR_DISTRIBUTION_KR_920[0];
-    const_mobile_lowpower_dr_distri    = &MOBILE_LOWPER_DR_DISTRIBUTION_KR_920[0];
-    const_join_dr_distri               = &JOIN_DR_DISTRIBUTION_KR_920[0];
-    const_default_dr_distri            = &DEFAULT_DR_DISTRIBUTION_KR_920[0];
-    const_cf_list_type_supported       = CF_LIST_SUPPORTED_KR_920;
-    const_beacon_dr                    = BEACON_DR_KR_920;
-    const_beacon_frequency             = BEACON_FREQ_KR_920;
-    const_ping_slot_frequency          = PING_SLOT_FREQ_KR_920;
-
-    real_ctx.tx_frequency_channel_ctx   = &tx_frequency_channel[0];
-    real_ctx.rx1_frequency_channel_ctx  = &rx1_frequency_channel[0];
-    real_ctx.channel_index_enabled_ctx  = &channel_index_enabled[0];
-    real_ctx.unwrapped_channel_mask_ctx = &unwrapped_channel_mask[0];
-    real_ctx.dr_bitfield_tx_channel_ctx = &dr_bitfield_tx_channel[0];
-    real_ctx.dr_distribution_init_ctx   = &dr_distribution_init[0];
-    real_ctx.dr_distribution_ctx        = &dr_distribution[0];
+    lr1_mac->real->real_const = &region_kr_920_const;
+
+    real_ctx.tx_frequency_channel_ctx       = &tx_frequency_channel[0];
+    real_ctx.rx1_frequency_channel_ctx      = &rx1_frequency_channel[0];
+    real_ctx.channel_index_enabled_ctx      = &channel_index_enabled[0];
+    real_ctx.unwrapped_channel_mask_ctx     = &unwrapped_channel_mask[0];
+    real_ctx.dr_bitfield_tx_channel_ctx     = &dr_bitfield_tx_channel[0];
+    real_ctx.dr_bitfield_tx_channel_nwk_ctx = &dr_bitfield_tx_channel[0];
+    real_ctx.dr_distribution_init_ctx       = &dr_distribution_init[0];
+    real_ctx.dr_distribution_ctx            = &dr_distribution[0];
 
     memset1( dr_distribution_init, 1, const_number_of_tx_dr );
     memset1( dr_distribution, 0, const_number_of_tx_dr );
@@ -169,6 +177,7 @@ void region_kr_920_init( lr1_stack_mac_t* lr1_mac )
 
 void region_kr_920_init_session( lr1_stack_mac_t* lr1_mac )
 {
+    UNUSED( lr1_mac );
     // Not used for KR920
     return;
 }
@@ -246,11 +255,13 @@ void region_kr_920_set_channel_mask( lr1_stack_mac_t* lr1_mac )
 
 void region_kr_920_init_join_snapshot_channel_mask( lr1_stack_mac_t* lr1_mac )
 {
+    UNUSED( lr1_mac );
     // Not useful for KR920
     return;
 }
 void region_kr_920_init_after_join_snapshot_channel_mask( lr1_stack_mac_t* lr1_mac )
 {
+    UNUSED( lr1_mac );
     // Not useful for KR920
     return;
 }
@@ -330,6 +341,18 @@ void region_kr_920_lora_dr_to_sf_bw( uint8_t in_dr, uint8_t* out_sf, lr1mac_band
     }
 }
 
+int8_t region_kr_920_clamp_output_power_eirp_vs_freq_and_dr( lr1_stack_mac_t* lr1_mac, int8_t tx_power,
+                                                             uint32_t tx_frequency, uint8_t datarate )
+{
+    UNUSED( lr1_mac );
+    UNUSED( datarate );
+    if( tx_frequency < 922000000 )
+    {
+        return MIN( tx_power, 10 );  // if freq < 922MHz, Max output power is limited to 10 dBm
+    }
+    return MIN( tx_power, TX_POWER_EIRP_KR_920 );  // else Max output power is limited to 14 dBm
+}
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
@@ -154,6 +154,18 @@ modulation_type_t region_kr_920_get_modulation_type_from_datarate( uint8_t datar
  */
 void region_kr_920_lora_dr_to_sf_bw( uint8_t in_dr, uint8_t* out_sf, lr1mac_bandwidth_t* out_bw );
 
+/**
+ * @brief Clamp the output power: 10 dBm below 922 MHz, TX_POWER_EIRP_KR_920 above
+ *
+ * @param lr1_mac
+ * @param tx_power
+ * @param tx_frequency
+ * @param datarate
+ * @return int8_t
+ */
+int8_t region_kr_920_clamp_output_power_eirp_vs_freq_and_dr( lr1_stack_mac_t* lr1_mac, int8_t tx_power,
+                                                             uint32_t tx_frequency, uint8_t datarate );
+
 #ifdef __cplusplus
 }
 #endif
@@ -156,8 +156,7 @@ static const uint8_t datarate_backoff_kr_920[] = {
     4   // DR5 -> DR4
 };
 
-static const uint8_t NUMBER_RX1_DR_OFFSET_KR_920 =
-    sizeof( datarate_offsets_kr_920[0] ) / sizeof( datarate_offsets_kr_920[0][0] );
+#define NUMBER_RX1_DR_OFFSET_KR_920 ( sizeof( datarate_offsets_kr_920[0] ) / sizeof( datarate_offsets_kr_920[0][0] ) )
 /**
  * Data rates table definition
  */
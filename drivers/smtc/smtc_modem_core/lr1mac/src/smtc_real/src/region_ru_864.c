@@ -63,6 +63,60 @@
  * --- PRIVATE CONSTANTS -------------------------------------------------------
  */
 
+/**
+ * Region constants, kept in flash and bound to smtc_real_t.real_const by region_ru_864_config( )
+ */
+static const smtc_real_const_t region_ru_864_const = {
+    .number_of_tx_channel   = NUMBER_OF_CHANNEL_RU_864,
+    .number_of_rx_channel   = NUMBER_OF_CHANNEL_RU_864,
+    .number_of_boot_tx_channel = NUMBER_OF_BOOT_TX_CHANNEL_RU_864,
+    .number_of_channel_bank = BANK_MAX_RU864,
+    .join_accept_delay1     = JOIN_ACCEPT_DELAY1_RU_864,
+    .received_delay1        = RECEIVE_DELAY1_RU_864,
+    .tx_power_dbm           = TX_POWER_EIRP_RU_864 - 2,  // EIRP to ERP
+    .max_tx_power_idx       = MAX_TX_POWER_IDX_RU_864,
+    .adr_ack_limit          = ADR_ACK_LIMIT_RU_864,
+    .adr_ack_delay          = ADR_ACK_DELAY_RU_864,
+    .datarate_backoff       = &datarate_backoff_ru_864[0],
+    .ack_timeout            = ACK_TIMEOUT_RU_864,
+    .freq_min               = FREQMIN_RU_864,
+    .freq_max               = FREQMAX_RU_864,
+    .rx2_freq               = RX2_FREQ_RU_864,
+    .frequency_factor       = FREQUENCY_FACTOR_RU_864,
+    .rx2_dr_init            = RX2DR_INIT_RU_864,
+    .sync_word_private      = SYNC_WORD_PRIVATE_RU_864,
+    .sync_word_public       = SYNC_WORD_PUBLIC_RU_864,
+    .sync_word_gfsk         = ( uint8_t* ) SYNC_WORD_GFSK_RU_864,
+    .min_tx_dr              = MIN_DR_RU_864,
+    .max_tx_dr              = MAX_DR_RU_864,
+    .min_tx_dr_limit        = MIN_TX_DR_LIMIT_RU_864,
+    .number_of_tx_dr        = NUMBER_OF_TX_DR_RU_864,
+    .min_rx_dr              = MIN_DR_RU_864,
+    .max_rx_dr              = MAX_DR_RU_864,
+    .number_rx1_dr_offset   = NUMBER_RX1_DR_OFFSET_RU_864,
+    .dr_bitfield            = DR_BITFIELD_SUPPORTED_RU_864,
+    .default_tx_dr_bit_field = DEFAULT_TX_DR_BIT_FIELD_RU_864,
+    .tx_param_setup_req_supported = TX_PARAM_SETUP_REQ_SUPPORTED_RU_864,
+    .new_channel_req_supported = NEW_CHANNEL_REQ_SUPPORTED_RU_864,
+    .dtc_supported          = DTC_SUPPORTED_RU_864,
+    .dtc_number_of_band     = BAND_RU864_MAX,
+    .dtc_by_band            = &duty_cycle_by_band_ru_864[0],
+    .lbt_supported          = LBT_SUPPORTED_RU_864,
+    .lbt_sniff_duration_ms  = LBT_SNIFF_DURATION_MS_RU_864,
+    .lbt_threshold_dbm      = LBT_THRESHOLD_DBM_RU_864,
+    .lbt_bw_hz              = LBT_BW_HZ_RU_864,
+    .max_payload_m          = &M_ru_864[0],
+    .coding_rate            = RAL_LORA_CR_4_5,
+    .mobile_longrange_dr_distri = &MOBILE_LONGRANGE_DR_DISTRIBUTION_RU_864[0],
+    .mobile_lowpower_dr_distri = &MOBILE_LOWPER_DR_DISTRIBUTION_RU_864[0],
+    .join_dr_distri         = &JOIN_DR_DISTRIBUTION_RU_864[0],
+    .default_dr_distri      = &DEFAULT_DR_DISTRIBUTION_RU_864[0],
+    .cf_list_type_supported = CF_LIST_SUPPORTED_RU_864,
+    .beacon_dr              = BEACON_DR_RU_864,
+    .beacon_frequency       = BEACON_FREQ_RU_864,
+    .ping_slot_frequency    = PING_SLOT_FREQ_RU_864,
+};
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE TYPES -----------------------------------------------------------
@@ -85,62 +139,16 @@
 
 void region_ru_864_config( lr1_stack_mac_t* lr1_mac )
 {
-    const_number_of_tx_channel         = NUMBER_OF_CHANNEL_RU_864;
-    const_number_of_rx_channel         = NUMBER_OF_CHANNEL_RU_864;
-    const_number_of_boot_tx_channel    = NUMBER_OF_BOOT_TX_CHANNEL_RU_864;
-    const_number_of_channel_bank       = BANK_MAX_RU864;
-    const_join_accept_delay1           = JOIN_ACCEPT_DELAY1_RU_864;
-    const_received_delay1              = RECEIVE_DELAY1_RU_864;
-    const_tx_power_dbm                 = TX_POWER_EIRP_RU_864 - 2;  // EIRP to ERP
-    const_max_tx_power_idx             = MAX_TX_POWER_IDX_RU_864;
-    const_adr_ack_limit                = ADR_ACK_LIMIT_RU_864;
-    const_adr_ack_delay                = ADR_ACK_DELAY_RU_864;
-    const_datarate_backoff             = &datarate_backoff_ru_864[0];
-    const_ack_timeout                  = ACK_TIMEOUT_RU_864;
-    const_freq_min                     = FREQMIN_RU_864;
-    const_freq_max                     = FREQMAX_RU_864;
-    const_rx2_freq                     = RX2_FREQ_RU_864;
-    const_frequency_factor             = FREQUENCY_FACTOR_RU_864;
-    const_rx2_dr_init                  = RX2DR_INIT_RU_864;
-    const_sync_word_private            = SYNC_WORD_PRIVATE_RU_864;
-    const_sync_word_public             = SYNC_WORD_PUBLIC_RU_864;
-    const_sync_word_gfsk               = ( uint8_t* ) SYNC_WORD_GFSK_RU_864;
-    const_min_tx_dr                    = MIN_DR_RU_864;
-    const_max_tx_dr                    = MAX_DR_RU_864;
-    const_min_tx_dr_limit              = MIN_TX_DR_LIMIT_RU_864;
-    const_number_of_tx_dr              = NUMBER_OF_TX_DR_RU_864;
-    const_min_rx_dr                    = MIN_DR_RU_864;
-    const_max_rx_dr                    = MAX_DR_RU_864;
-    const_number_rx1_dr_offset         = NUMBER_RX1_DR_OFFSET_RU_864;
-    const_dr_bitfield                  = DR_BITFIELD_SUPPORTED_RU_864;
-    const_default_tx_dr_bit_field      = DEFAULT_TX_DR_BIT_FIELD_RU_864;
-    const_tx_param_setup_req_supported = TX_PARAM_SETUP_REQ_SUPPORTED_RU_864;
-    const_new_channel_req_supported    = NEW_CHANNEL_REQ_SUPPORTED_RU_864;
-    const_dtc_supported                = DTC_SUPPORTED_RU_864;
-    const_dtc_number_of_band           = BAND_RU864_MAX;
-    const_dtc_by_band                  = &duty_cycle_by_band_ru_864[0];
-    const_lbt_supported                = LBT_SUPPORTED_RU_864;
-    const_lbt_sniff_duration_ms        = LBT_SNIFF_DURATION_MS_RU_864;
-    const_lbt_threshold_dbm            = LBT_THRESHOLD_DBM_RU_864;
-    const_lbt_bw_hz                    = LBT_BW_HZ_RU_864;
-    const_max_payload_m                = &M_ru_864[0];
-    const_coding_rate                  = RAL_LORA_CR_4_5;
-    const_mobile_longrange_dr_distri   = &MOBILE_LONGRANGE_DR_DISTRIBUTION_RU_864[0];
-    const_mobile_lowpower_dr_distri    = &MOBILE_LOWPER_DR_DISTRIBUTION_RU_864[0];
-    const_join_dr_distri               = &JOIN_DR_DISTRIBUTION_RU_864[0];
-    const_default_dr_distri            = &DEFAULT_DR_DISTRIBUTION_RU_864[0];
-    const_cf_list_type_supported       = CF_LIST_SUPPORTED_RU_864;
-    const_beacon_dr                    = BEACON_DR_RU_864;
-    const_beacon_frequency             = BEACON_FREQ_RU_864;
-    const_ping_slot_frequency          = PING_SLOT_FREQ_RU_864;
-
-    real_ctx.tx_frequency_channel_ctx   = &tx_frequency_channel[0];
-    real_ctx.rx1_frequency_channel_ctx  = &rx1_frequency_channel[0];
-    real_ctx.channel_index_enabled_ctx  = &channel_index_enabled[0];
-    real_ctx.unwrapped_channel_mask_ctx = &unwrapped_channel_mask[0];
-    real_ctx.dr_bitfield_tx_channel_ctx = &dr_bitfield_tx_channel[0];
-    real_ctx.dr_distribution_init_ctx   = &dr_distribution_init[0];
-    real_ctx.dr_distribution_ctx        = &dr_distribution[0];
+    lr1_mac->real->real_const = &region_ru_864_const;
+
+    real_ctx.tx_frequency_channel_ctx       = &tx_frequency_channel[0];
+    real_ctx.rx1_frequency_channel_ctx      = &rx1_frequency_channel[0];
+    real_ctx.channel_index_enabled_ctx      = &channel_index_enabled[0];
+    real_ctx.unwrapped_channel_mask_ctx     = &unwrapped_channel_mask[0];
+    real_ctx.dr_bitfield_tx_channel_ctx     = &dr_bitfield_tx_channel[0];
+    real_ctx.dr_bitfield_tx_channel_nwk_ctx = &dr_bitfield_tx_channel[0];
+    real_ctx.dr_distribution_init_ctx       = &dr_distribution_init[0];
+    real_ctx.dr_distribution_ctx            = &dr_distribution[0];
 
     memset1( dr_distribution_init, 1, const_number_of_tx_dr );
     memset1( dr_distribution, 0, const_number_of_tx_dr );
@@ -184,17 +192,23 @@ status_lorawan_t region_ru_864_get_join_next_channel( lr1_stack_mac_t* lr1_mac )
 
 status_lorawan_t region_ru_864_get_next_channel( lr1_stack_mac_t* lr1_mac )
 {
-    uint8_t active_channel_nb = 0;
-    uint8_t active_channel_index[NUMBER_OF_CHANNEL_RU_864];
+    uint8_t  active_channel_nb = 0;
+    uint8_t  active_channel_index[NUMBER_OF_CHANNEL_RU_864];
+    uint32_t active_channel_weight[NUMBER_OF_CHANNEL_RU_864];
+    uint32_t weight_sum = 0;
 
     for( uint8_t i = 0; i < const_number_of_tx_channel; i++ )
     {
-        if( SMTC_GET_BIT8( channel_index_enabled, i ) == CHANNEL_ENABLED )
+        if( ( SMTC_GET_BIT8( channel_index_enabled, i ) == CHANNEL_ENABLED ) &&
+            ( SMTC_GET_BIT16( &dr_bitfield_tx_channel[i], lr1_mac->tx_data_rate ) == 1 ) )
         {
-            if( ( smtc_duty_cycle_is_channel_free( lr1_mac->dtc_obj, tx_frequency_channel[i] ) == true ) &&
-                ( SMTC_GET_BIT16( &dr_bitfield_tx_channel[i], lr1_mac->tx_data_rate ) == 1 ) )
+            // The remaining duty cycle budget of the sub-band is used as weight, a full sub-band is skipped
+            uint32_t weight = smtc_duty_cycle_channel_get_available_toa_ms( lr1_mac->dtc_obj, tx_frequency_channel[i] );
+            if( weight > 0 )
             {
-                active_channel_index[active_channel_nb] = i;
+                active_channel_index[active_channel_nb]  = i;
+                active_channel_weight[active_channel_nb] = weight;
+                weight_sum += weight;
                 active_channel_nb++;
             }
         }
@@ -205,7 +219,15 @@ status_lorawan_t region_ru_864_get_next_channel( lr1_stack_mac_t* lr1_mac )
         SMTC_MODEM_HAL_TRACE_WARNING( "NO CHANNELS AVAILABLE \n" );
         return ERRORLORAWAN;
     }
-    uint8_t temp        = ( smtc_modem_hal_get_random_nb_in_range( 0, ( active_channel_nb - 1 ) ) ) % active_channel_nb;
+
+    // Weighted random draw: sub-bands with more airtime left are favoured so the budget is spread across the bands
+    uint32_t draw = smtc_modem_hal_get_random_nb_in_range( 0, ( weight_sum - 1 ) ) % weight_sum;
+    uint8_t  temp = 0;
+    while( ( temp < ( active_channel_nb - 1 ) ) && ( draw >= active_channel_weight[temp] ) )
+    {
+        draw -= active_channel_weight[temp];
+        temp++;
+    }
     uint8_t channel_idx = 0;
     channel_idx         = active_channel_index[temp];
     if( channel_idx >= const_number_of_tx_channel )
@@ -172,8 +172,7 @@ static const uint8_t datarate_backoff_ru_864[] = {
     6   // DR7 -> DR6
 };
 
-static const uint8_t NUMBER_RX1_DR_OFFSET_RU_864 =
-    sizeof( datarate_offsets_ru_864[0] ) / sizeof( datarate_offsets_ru_864[0][0] );
+#define NUMBER_RX1_DR_OFFSET_RU_864 ( sizeof( datarate_offsets_ru_864[0] ) / sizeof( datarate_offsets_ru_864[0][0] ) )
 
 /**
  * Data rates table definition
@@ -175,6 +175,26 @@ void region_us_915_lora_dr_to_sf_bw( uint8_t in_dr, uint8_t* out_sf, lr1mac_band
  */
 void region_us_915_lr_fhss_dr_to_cr_bw( uint8_t in_dr, lr_fhss_v1_cr_t* out_cr, lr_fhss_v1_bw_t* out_bw );
 
+/**
+ * @brief Get the number of channel mask carried by a CFList
+ *
+ * @param lr1_mac
+ * @return uint8_t
+ */
+uint8_t region_us_915_get_number_of_chmask_in_cflist( lr1_stack_mac_t* lr1_mac );
+
+/**
+ * @brief Clamp the output power: 26 dBm at DR4, 21 dBm when less than 50 channels are enabled for the datarate
+ *
+ * @param lr1_mac
+ * @param tx_power
+ * @param tx_frequency
+ * @param datarate
+ * @return int8_t
+ */
+int8_t region_us_915_clamp_output_power_eirp_vs_freq_and_dr( lr1_stack_mac_t* lr1_mac, int8_t tx_power,
+                                                             uint32_t tx_frequency, uint8_t datarate );
+
 /**
  * \brief
  * \remark
@@ -152,13 +152,12 @@ typedef enum us_915_channels_bank_e
 
 typedef struct region_us915_context_s
 {
-    uint16_t dr_bitfield_tx_channel[NUMBER_OF_TX_CHANNEL_US_915];
-    uint8_t  channel_index_enabled[BANK_MAX_US915];     // 8ch-125KHz + 1ch-500KHZ // Enable by Network
-    uint8_t  unwrapped_channel_mask[BANK_MAX_US915];    // 8ch-125KHz + 1ch-500KHZ // Temp conf send by Network
-    uint8_t  snapshot_channel_tx_mask[BANK_MAX_US915];  // 8ch-125KHz + 1ch-500KHZ // snapshot of used channels
-    uint8_t  dr_distribution_init[NUMBER_OF_TX_DR_US_915];
-    uint8_t  dr_distribution[NUMBER_OF_TX_DR_US_915];
-    uint8_t  first_ch_mask_received;
+    uint8_t channel_index_enabled[BANK_MAX_US915];     // 8ch-125KHz + 1ch-500KHZ // Enable by Network
+    uint8_t unwrapped_channel_mask[BANK_MAX_US915];    // 8ch-125KHz + 1ch-500KHZ // Temp conf send by Network
+    uint8_t snapshot_channel_tx_mask[BANK_MAX_US915];  // 8ch-125KHz + 1ch-500KHZ // snapshot of used channels
+    uint8_t dr_distribution_init[NUMBER_OF_TX_DR_US_915];
+    uint8_t dr_distribution[NUMBER_OF_TX_DR_US_915];
+    uint8_t first_ch_mask_received;
 
     us_915_channels_bank_t snapshot_bank_tx_mask;
 
@@ -198,8 +197,25 @@ static const uint8_t datarate_backoff_us_915[] = {
     5   // DR6 -> DR5
 };
 
-static const uint8_t NUMBER_RX1_DR_OFFSET_US_915 =
-    sizeof( datarate_offsets_us_915[0] ) / sizeof( datarate_offsets_us_915[0][0] );
+#define NUMBER_RX1_DR_OFFSET_US_915 ( sizeof( datarate_offsets_us_915[0] ) / sizeof( datarate_offsets_us_915[0][0] ) )
+
+/**
+ * Data rates of each Tx channel, by bank of 8 channels: 125 kHz banks 0 to 7 then the 500 kHz bank 8
+ */
+#define DR_BITFIELD_TX_BANK_US_915( bit_field ) \
+    bit_field, bit_field, bit_field, bit_field, bit_field, bit_field, bit_field, bit_field
+
+static const uint16_t dr_bitfield_tx_channel_us_915[NUMBER_OF_TX_CHANNEL_US_915] = {
+    DR_BITFIELD_TX_BANK_US_915( DEFAULT_TX_DR_125_BIT_FIELD_US_915 ),
+    DR_BITFIELD_TX_BANK_US_915( DEFAULT_TX_DR_125_BIT_FIELD_US_915 ),
+    DR_BITFIELD_TX_BANK_US_915( DEFAULT_TX_DR_125_BIT_FIELD_US_915 ),
+    DR_BITFIELD_TX_BANK_US_915( DEFAULT_TX_DR_125_BIT_FIELD_US_915 ),
+    DR_BITFIELD_TX_BANK_US_915( DEFAULT_TX_DR_125_BIT_FIELD_US_915 ),
+    DR_BITFIELD_TX_BANK_US_915( DEFAULT_TX_DR_125_BIT_FIELD_US_915 ),
+    DR_BITFIELD_TX_BANK_US_915( DEFAULT_TX_DR_125_BIT_FIELD_US_915 ),
+    DR_BITFIELD_TX_BANK_US_915( DEFAULT_TX_DR_125_BIT_FIELD_US_915 ),
+    DR_BITFIELD_TX_BANK_US_915( DEFAULT_TX_DR_500_BIT_FIELD_US_915 ),
+};
 
 /**
  * Data rates table definition
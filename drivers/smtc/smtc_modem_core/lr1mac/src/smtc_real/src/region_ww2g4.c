@@ -62,6 +62,60 @@
  * --- PRIVATE CONSTANTS -------------------------------------------------------
  */
 
+/**
+ * Region constants, kept in flash and bound to smtc_real_t.real_const by region_ww2g4_config( )
+ */
+static const smtc_real_const_t region_ww2g4_const = {
+    .number_of_tx_channel   = NUMBER_OF_CHANNEL_WW2G4,
+    .number_of_rx_channel   = NUMBER_OF_CHANNEL_WW2G4,
+    .number_of_boot_tx_channel = NUMBER_OF_BOOT_TX_CHANNEL_WW2G4,
+    .number_of_channel_bank = BANK_MAX_WW2G4,
+    .join_accept_delay1     = JOIN_ACCEPT_DELAY1_WW2G4,
+    .received_delay1        = RECEIVE_DELAY1_WW2G4,
+    .tx_power_dbm           = TX_POWER_EIRP_WW2G4 - 2,  // EIRP to ERP
+    .max_tx_power_idx       = MAX_TX_POWER_IDX_WW2G4,
+    .adr_ack_limit          = ADR_ACK_LIMIT_WW2G4,
+    .adr_ack_delay          = ADR_ACK_DELAY_WW2G4,
+    .datarate_backoff       = &datarate_backoff_ww2g4[0],
+    .ack_timeout            = ACK_TIMEOUT_WW2G4,
+    .freq_min               = FREQMIN_WW2G4,
+    .freq_max               = FREQMAX_WW2G4,
+    .rx2_freq               = RX2_FREQ_WW2G4,
+    .frequency_factor       = FREQUENCY_FACTOR_WW2G4,
+    .rx2_dr_init            = RX2DR_INIT_WW2G4,
+    .sync_word_private      = SYNC_WORD_PRIVATE_WW2G4,
+    .sync_word_public       = SYNC_WORD_PUBLIC_WW2G4,
+    .min_tx_dr              = MIN_DR_WW2G4,
+    .max_tx_dr              = MAX_DR_WW2G4,
+    .min_tx_dr_limit        = MIN_TX_DR_LIMIT_WW2G4,
+    .min_rx_dr              = MIN_DR_WW2G4,
+    .max_rx_dr              = MAX_DR_WW2G4,
+    .number_rx1_dr_offset   = NUMBER_RX1_DR_OFFSET_WW2G4,
+    .dr_bitfield            = DR_BITFIELD_SUPPORTED_WW2G4,
+    .default_tx_dr_bit_field = DEFAULT_TX_DR_BIT_FIELD_WW2G4,
+    .number_of_tx_dr        = NUMBER_OF_TX_DR_WW2G4,
+    .tx_param_setup_req_supported = TX_PARAM_SETUP_REQ_SUPPORTED_WW2G4,
+    .new_channel_req_supported = NEW_CHANNEL_REQ_SUPPORTED_WW2G4,
+    .dtc_supported          = DTC_SUPPORTED_WW2G4,
+    .lbt_supported          = LBT_SUPPORTED_WW2G4,
+    .max_payload_m          = &M_ww2g4[0],
+    .coding_rate            = RAL_LORA_CR_LI_4_8,
+#if defined( WW2G4_SINGLE_DATARATE )
+    .join_dr_distri         = &DEFAULT_DR_DISTRIBUTION_WW2G4[0],
+    .mobile_lowpower_dr_distri = &DEFAULT_DR_DISTRIBUTION_WW2G4[0],
+    .mobile_longrange_dr_distri = &DEFAULT_DR_DISTRIBUTION_WW2G4[0],
+#else
+    .mobile_longrange_dr_distri = &MOBILE_LONGRANGE_DR_DISTRIBUTION_WW2G4[0],
+    .mobile_lowpower_dr_distri = &MOBILE_LOWPER_DR_DISTRIBUTION_WW2G4[0],
+    .join_dr_distri         = &JOIN_DR_DISTRIBUTION_WW2G4[0],
+#endif
+    .default_dr_distri      = &DEFAULT_DR_DISTRIBUTION_WW2G4[0],
+    .cf_list_type_supported = CF_LIST_SUPPORTED_WW2G4,
+    .beacon_dr              = BEACON_DR_WW2G4,
+    .beacon_frequency       = BEACON_FREQ_WW2G4,
+    .ping_slot_frequency    = PING_SLOT_FREQ_WW2G4,
+};
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE TYPES -----------------------------------------------------------
@@ -84,62 +138,16 @@
 
 void region_ww2g4_config( lr1_stack_mac_t* lr1_mac )
 {
-    const_number_of_tx_channel         = NUMBER_OF_CHANNEL_WW2G4;
-    const_number_of_rx_channel         = NUMBER_OF_CHANNEL_WW2G4;
-    const_number_of_boot_tx_channel    = NUMBER_OF_BOOT_TX_CHANNEL_WW2G4;
-    const_number_of_channel_bank       = BANK_MAX_WW2G4;
-    const_join_accept_delay1           = JOIN_ACCEPT_DELAY1_WW2G4;
-    const_received_delay1              = RECEIVE_DELAY1_WW2G4;
-    const_tx_power_dbm                 = TX_POWER_EIRP_WW2G4 - 2;  // EIRP to ERP
-    const_max_tx_power_idx             = MAX_TX_POWER_IDX_WW2G4;
-    const_adr_ack_limit                = ADR_ACK_LIMIT_WW2G4;
-    const_adr_ack_delay                = ADR_ACK_DELAY_WW2G4;
-    const_datarate_backoff             = &datarate_backoff_ww2g4[0];
-    const_ack_timeout                  = ACK_TIMEOUT_WW2G4;
-    const_freq_min                     = FREQMIN_WW2G4;
-    const_freq_max                     = FREQMAX_WW2G4;
-    const_rx2_freq                     = RX2_FREQ_WW2G4;
-    const_frequency_factor             = FREQUENCY_FACTOR_WW2G4;
-    const_rx2_dr_init                  = RX2DR_INIT_WW2G4;
-    const_sync_word_private            = SYNC_WORD_PRIVATE_WW2G4;
-    const_sync_word_public             = SYNC_WORD_PUBLIC_WW2G4;
-    const_min_tx_dr                    = MIN_DR_WW2G4;
-    const_max_tx_dr                    = MAX_DR_WW2G4;
-    const_min_tx_dr_limit              = MIN_TX_DR_LIMIT_WW2G4;
-    const_min_rx_dr                    = MIN_DR_WW2G4;
-    const_max_rx_dr                    = MAX_DR_WW2G4;
-    const_number_rx1_dr_offset         = NUMBER_RX1_DR_OFFSET_WW2G4;
-    const_dr_bitfield                  = DR_BITFIELD_SUPPORTED_WW2G4;
-    const_default_tx_dr_bit_field      = DEFAULT_TX_DR_BIT_FIELD_WW2G4;
-    const_number_of_tx_dr              = NUMBER_OF_TX_DR_WW2G4;
-    const_tx_param_setup_req_supported = TX_PARAM_SETUP_REQ_SUPPORTED_WW2G4;
-    const_new_channel_req_supported    = NEW_CHANNEL_REQ_SUPPORTED_WW2G4;
-    const_dtc_supported                = DTC_SUPPORTED_WW2G4;
-    const_lbt_supported                = LBT_SUPPORTED_WW2G4;
-    const_max_payload_m                = &M_ww2g4[0];
-    const_coding_rate                  = RAL_LORA_CR_LI_4_8;
-#if defined( WW2G4_SINGLE_DATARATE )
-    const_join_dr_distri             = &DEFAULT_DR_DISTRIBUTION_WW2G4[0];
-    const_mobile_lowpower_dr_distri  = &DEFAULT_DR_DISTRIBUTION_WW2G4[0];
-    const_mobile_longrange_dr_distri = &DEFAULT_DR_DISTRIBUTION_WW2G4[0];
-#else
-    const_mobile_longrange_dr_distri = &MOBILE_LONGRANGE_DR_DISTRIBUTION_WW2G4[0];
-    const_mobile_lowpower_dr_distri  = &MOBILE_LOWPER_DR_DISTRIBUTION_WW2G4[0];
-    const_join_dr_distri             = &JOIN_DR_DISTRIBUTION_WW2G4[0];
-#endif
-    const_default_dr_distri      = &DEFAULT_DR_DISTRIBUTION_WW2G4[0];
-    const_cf_list_type_supported = CF_LIST_SUPPORTED_WW2G4;
-    const_beacon_dr              = BEACON_DR_WW2G4;
-    const_beacon_frequency       = BEACON_FREQ_WW2G4;
-    const_ping_slot_frequency    = PING_SLOT_FREQ_WW2G4;
-
-    real_ctx.tx_frequency_channel_ctx   = &tx_frequency_channel[0];
-    real_ctx.rx1_frequency_channel_ctx  = &rx1_frequency_channel[0];
-    real_ctx.channel_index_enabled_ctx  = &channel_index_enabled[0];
-    real_ctx.unwrapped_channel_mask_ctx = &unwrapped_channel_mask[0];
-    real_ctx.dr_bitfield_tx_channel_ctx = &dr_bitfield_tx_channel[0];
-    real_ctx.dr_distribution_init_ctx   = &dr_distribution_init[0];
-    real_ctx.dr_distribution_ctx        = &dr_distribution[0];
+    lr1_mac->real->real_const = &region_ww2g4_const;
+
+    real_ctx.tx_frequency_channel_ctx       = &tx_frequency_channel[0];
+    real_ctx.rx1_frequency_channel_ctx      = &rx1_frequency_channel[0];
+    real_ctx.channel_index_enabled_ctx      = &channel_index_enabled[0];
+    real_ctx.unwrapped_channel_mask_ctx     = &unwrapped_channel_mask[0];
+    real_ctx.dr_bitfield_tx_channel_ctx     = &dr_bitfield_tx_channel[0];
+    real_ctx.dr_bitfield_tx_channel_nwk_ctx = &dr_bitfield_tx_channel[0];
+    real_ctx.dr_distribution_init_ctx       = &dr_distribution_init[0];
+    real_ctx.dr_distribution_ctx            = &dr_distribution[0];
 
     memset1( dr_distribution_init, 1, const_number_of_tx_dr );
     memset1( dr_distribution, 0, const_number_of_tx_dr );
@@ -325,6 +333,11 @@ void region_ww2g4_lora_dr_to_sf_bw( uint8_t in_dr, uint8_t* out_sf, lr1mac_bandw
     }
 }
 
+uint8_t region_ww2g4_get_preamble_len( uint8_t sf )
+{
+    return ( ( sf == 5 ) || ( sf == 6 ) ) ? 12 : 8;
+}
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
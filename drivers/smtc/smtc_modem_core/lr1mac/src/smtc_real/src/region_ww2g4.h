@@ -151,6 +151,14 @@ modulation_type_t region_ww2g4_get_modulation_type_from_datarate( uint8_t datara
  */
 void region_ww2g4_lora_dr_to_sf_bw( uint8_t in_dr, uint8_t* out_sf, lr1mac_bandwidth_t* out_bw );
 
+/**
+ * @brief Get the LoRa preamble length, SF5 and SF6 need a longer preamble
+ *
+ * @param sf
+ * @return uint8_t
+ */
+uint8_t region_ww2g4_get_preamble_len( uint8_t sf );
+
 #ifdef __cplusplus
 }
 #endif
@@ -161,8 +161,7 @@ static const uint8_t datarate_backoff_ww2g4[] = {
     6   // DR7 -> DR6
 };
 
-static const uint8_t NUMBER_RX1_DR_OFFSET_WW2G4 =
-    sizeof( datarate_offsets_ww2g4[0] ) / sizeof( datarate_offsets_ww2g4[0][0] );
+#define NUMBER_RX1_DR_OFFSET_WW2G4 ( sizeof( datarate_offsets_ww2g4[0] ) / sizeof( datarate_offsets_ww2g4[0][0] ) )
 
 /**
  * Data rates table definition
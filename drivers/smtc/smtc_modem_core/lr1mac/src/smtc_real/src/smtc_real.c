@@ -86,111 +86,386 @@
 #define channel_index_enabled_ctx lr1_mac->real->real_ctx.channel_index_enabled_ctx
 #define unwrapped_channel_mask_ctx lr1_mac->real->real_ctx.unwrapped_channel_mask_ctx
 #define dr_bitfield_tx_channel_ctx lr1_mac->real->real_ctx.dr_bitfield_tx_channel_ctx
+#define dr_bitfield_tx_channel_nwk_ctx lr1_mac->real->real_ctx.dr_bitfield_tx_channel_nwk_ctx
 #define dr_distribution_init_ctx lr1_mac->real->real_ctx.dr_distribution_init_ctx
 #define dr_distribution_ctx lr1_mac->real->real_ctx.dr_distribution_ctx
 #define sync_word_ctx lr1_mac->real->real_ctx.sync_word_ctx
 
-smtc_real_status_t smtc_real_is_supported_region( smtc_real_region_types_t region_type )
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/**
+ * @brief Region specific operations
+ *
+ * @remark One const table per region, bound once by smtc_real_config( ) so the MAC does not have to switch on the
+ *         region type at every call. A NULL hook selects the common behaviour implemented in this file.
+ */
+typedef struct smtc_real_region_ops_s
+{
+    smtc_real_region_types_t region_type;
+    bool                     is_dynamic_channel_plan;  // Channels can be created/modified by the network
+    lr_fhss_v1_grid_t        lr_fhss_grid;
+
+    void ( *config )( lr1_stack_mac_t* lr1_mac );
+    void ( *init )( lr1_stack_mac_t* lr1_mac );
+    void ( *init_session )( lr1_stack_mac_t* lr1_mac );
+    uint8_t ( *get_number_of_chmask_in_cflist )( lr1_stack_mac_t* lr1_mac );
+    status_lorawan_t ( *get_next_channel )( lr1_stack_mac_t* lr1_mac );
+    status_lorawan_t ( *get_join_next_channel )( lr1_stack_mac_t* lr1_mac );
+    void ( *set_rx_config )( lr1_stack_mac_t* lr1_mac, rx_win_type_t type );
+    void ( *set_channel_mask )( lr1_stack_mac_t* lr1_mac );
+    void ( *init_join_snapshot_channel_mask )( lr1_stack_mac_t* lr1_mac );
+    void ( *init_after_join_snapshot_channel_mask )( lr1_stack_mac_t* lr1_mac );
+    status_channel_t ( *build_channel_mask )( lr1_stack_mac_t* lr1_mac, uint8_t ch_mask_cntl, uint16_t ch_mask );
+    void ( *enable_all_channels_with_valid_freq )( lr1_stack_mac_t* lr1_mac );
+    status_lorawan_t ( *is_tx_dr_acceptable )( lr1_stack_mac_t* lr1_mac, uint8_t dr, bool is_ch_mask_from_link_adr );
+    uint32_t ( *get_tx_channel_frequency )( lr1_stack_mac_t* lr1_mac, uint8_t channel_index );
+    uint32_t ( *get_rx1_channel_frequency )( lr1_stack_mac_t* lr1_mac, uint8_t channel_index );
+    uint8_t ( *get_preamble_len )( uint8_t sf );
+    modulation_type_t ( *get_modulation_type_from_datarate )( uint8_t datarate );
+    void ( *lora_dr_to_sf_bw )( uint8_t in_dr, uint8_t* out_sf, lr1mac_bandwidth_t* out_bw );
+    void ( *fsk_dr_to_bitrate )( uint8_t in_dr, uint8_t* out_bitrate );
+    void ( *lr_fhss_dr_to_cr_bw )( uint8_t in_dr, lr_fhss_v1_cr_t* out_cr, lr_fhss_v1_bw_t* out_bw );
+    int8_t ( *clamp_output_power_eirp_vs_freq_and_dr )( lr1_stack_mac_t* lr1_mac, int8_t tx_power,
+                                                        uint32_t tx_frequency, uint8_t datarate );
+    uint32_t ( *get_beacon_frequency )( lr1_stack_mac_t* lr1_mac, uint32_t gps_time_s );
+    uint32_t ( *get_ping_slot_frequency )( lr1_stack_mac_t* lr1_mac, uint32_t gps_time_s, uint32_t dev_addr );
+} smtc_real_region_ops_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+#if defined( REGION_WW2G4 )
+static const smtc_real_region_ops_t region_ops_ww2g4 = {
+    .region_type                       = SMTC_REAL_REGION_WW2G4,
+    .is_dynamic_channel_plan           = true,
+    .config                            = region_ww2g4_config,
+    .init                              = region_ww2g4_init,
+    .get_next_channel                  = region_ww2g4_get_next_channel,
+    .get_join_next_channel             = region_ww2g4_get_join_next_channel,
+    .set_rx_config                     = region_ww2g4_set_rx_config,
+    .set_channel_mask                  = region_ww2g4_set_channel_mask,
+    .build_channel_mask                = region_ww2g4_build_channel_mask,
+    .get_preamble_len                  = region_ww2g4_get_preamble_len,
+    .get_modulation_type_from_datarate = region_ww2g4_get_modulation_type_from_datarate,
+    .lora_dr_to_sf_bw                  = region_ww2g4_lora_dr_to_sf_bw,
+};
+#endif
+
+#if defined( REGION_EU_868 )
+static const smtc_real_region_ops_t region_ops_eu_868 = {
+    .region_type                       = SMTC_REAL_REGION_EU_868,
+    .is_dynamic_channel_plan           = true,
+    .lr_fhss_grid                      = LR_FHSS_V1_GRID_3906_HZ,
+    .config                            = region_eu_868_config,
+    .init                              = region_eu_868_init,
+    .get_next_channel                  = region_eu_868_get_next_channel,
+    .get_join_next_channel             = region_eu_868_get_join_next_channel,
+    .set_rx_config                     = region_eu_868_set_rx_config,
+    .set_channel_mask                  = region_eu_868_set_channel_mask,
+    .build_channel_mask                = region_eu_868_build_channel_mask,
+    .get_modulation_type_from_datarate = region_eu_868_get_modulation_type_from_datarate,
+    .lora_dr_to_sf_bw                  = region_eu_868_lora_dr_to_sf_bw,
+    .fsk_dr_to_bitrate                 = region_eu_868_fsk_dr_to_bitrate,
+    .lr_fhss_dr_to_cr_bw               = region_eu_868_lr_fhss_dr_to_cr_bw,
+};
+#endif
+
+#if defined( REGION_AS_923 )
+static void region_as_923_grp1_config( lr1_stack_mac_t* lr1_mac )
 {
-    for( uint8_t i = 0; i < SMTC_REAL_REGION_LIST_LENGTH; i++ )
-    {
-        if( smtc_real_region_list[i] == region_type )
-        {
-            return SMTC_REAL_STATUS_OK;
-        }
-    }
+    region_as_923_config( lr1_mac, 1 );
+}
 
-    SMTC_MODEM_HAL_TRACE_ERROR( "Invalid Region 0x%02x\n", region_type );
-    return SMTC_REAL_STATUS_UNSUPPORTED_FEATURE;
+static void region_as_923_grp2_config( lr1_stack_mac_t* lr1_mac )
+{
+    region_as_923_config( lr1_mac, 2 );
 }
 
-void smtc_real_config( lr1_stack_mac_t* lr1_mac )
+static void region_as_923_grp3_config( lr1_stack_mac_t* lr1_mac )
+{
+    region_as_923_config( lr1_mac, 3 );
+}
+
+#if defined( RP2_103 )
+static void region_as_923_grp4_config( lr1_stack_mac_t* lr1_mac )
 {
-    // Init duty-cycle object
-    smtc_duty_cycle_init( lr1_mac->dtc_obj );
+    region_as_923_config( lr1_mac, 4 );
+}
+#endif
+
+#define REGION_OPS_AS_923( type, config_func )                                                                        \
+    {                                                                                                                 \
+        .region_type                       = type,                                                                    \
+        .is_dynamic_channel_plan           = true,                                                                    \
+        .config                            = config_func,                                                             \
+        .init                              = region_as_923_init,                                                      \
+        .get_next_channel                  = region_as_923_get_next_channel,                                          \
+        .get_join_next_channel             = region_as_923_get_join_next_channel,                                     \
+        .set_rx_config                     = region_as_923_set_rx_config,                                             \
+        .set_channel_mask                  = region_as_923_set_channel_mask,                                          \
+        .build_channel_mask                = region_as_923_build_channel_mask,                                        \
+        .get_modulation_type_from_datarate = region_as_923_get_modulation_type_from_datarate,                         \
+        .lora_dr_to_sf_bw                  = region_as_923_lora_dr_to_sf_bw,                                          \
+        .fsk_dr_to_bitrate                 = region_as_923_fsk_dr_to_bitrate,                                         \
+    }
 
-    // Init all const_xxx to 0
-    memset( &( lr1_mac->real->real_const ), 0, sizeof( smtc_real_const_t ) );
 
-    switch( lr1_mac->real->region_type )
-    {
+static const smtc_real_region_ops_t region_ops_as_923_grp1 =
+    REGION_OPS_AS_923( SMTC_REAL_REGION_AS_923, region_as_923_grp1_config );
+static const smtc_real_region_ops_t region_ops_as_923_grp2 =
+    REGION_OPS_AS_923( SMTC_REAL_REGION_AS_923_GRP2, region_as_923_grp2_config );
+static const smtc_real_region_ops_t region_ops_as_923_grp3 =
+    REGION_OPS_AS_923( SMTC_REAL_REGION_AS_923_GRP3, region_as_923_grp3_config );
+#if defined( RP2_103 )
+static const smtc_real_region_ops_t region_ops_as_923_grp4 =
+    REGION_OPS_AS_923( SMTC_REAL_REGION_AS_923_GRP4, region_as_923_grp4_config );
+#endif
+#endif
+
+#if defined( REGION_US_915 )
+static const smtc_real_region_ops_t region_ops_us_915 = {
+    .region_type                            = SMTC_REAL_REGION_US_915,
+    .is_dynamic_channel_plan                = false,
+    .lr_fhss_grid                           = LR_FHSS_V1_GRID_25391_HZ,
+    .config                                 = region_us_915_config,
+    .init                                   = region_us_915_init,
+    .get_number_of_chmask_in_cflist         = region_us_915_get_number_of_chmask_in_cflist,
+    .get_next_channel                       = region_us_915_get_next_channel,
+    .get_join_next_channel                  = region_us_915_get_join_next_channel,
+    .set_rx_config                          = region_us_915_set_rx_config,
+    .set_channel_mask                       = region_us_915_set_channel_mask,
+    .init_join_snapshot_channel_mask        = region_us_915_init_join_snapshot_channel_mask,
+    .init_after_join_snapshot_channel_mask  = region_us_915_init_after_join_snapshot_channel_mask,
+    .build_channel_mask                     = region_us_915_build_channel_mask,
+    .enable_all_channels_with_valid_freq    = region_us_915_enable_all_channels_with_valid_freq,
+    .is_tx_dr_acceptable                    = region_us_915_is_acceptable_tx_dr,
+    .get_tx_channel_frequency               = region_us_915_get_tx_frequency_channel,
+    .get_rx1_channel_frequency              = region_us_915_get_rx1_frequency_channel,
+    .get_modulation_type_from_datarate      = region_us_915_get_modulation_type_from_datarate,
+    .lora_dr_to_sf_bw                       = region_us_915_lora_dr_to_sf_bw,
+    .lr_fhss_dr_to_cr_bw                    = region_us_915_lr_fhss_dr_to_cr_bw,
+    .clamp_output_power_eirp_vs_freq_and_dr = region_us_915_clamp_output_power_eirp_vs_freq_and_dr,
+    .get_beacon_frequency                   = region_us_915_get_rx_beacon_frequency_channel,
+    .get_ping_slot_frequency                = region_us_915_get_rx_ping_slot_frequency_channel,
+};
+#endif
+
+#if defined( REGION_AU_915 )
+static const smtc_real_region_ops_t region_ops_au_915 = {
+    .region_type                           = SMTC_REAL_REGION_AU_915,
+    .is_dynamic_channel_plan               = false,
+    .lr_fhss_grid                          = LR_FHSS_V1_GRID_25391_HZ,
+    .config                                = region_au_915_config,
+    .init                                  = region_au_915_init,
+    .get_number_of_chmask_in_cflist        = region_au_915_get_number_of_chmask_in_cflist,
+    .get_next_channel                      = region_au_915_get_next_channel,
+    .get_join_next_channel                 = region_au_915_get_join_next_channel,
+    .set_rx_config                         = region_au_915_set_rx_config,
+    .set_channel_mask                      = region_au_915_set_channel_mask,
+    .init_join_snapshot_channel_mask       = region_au_915_init_join_snapshot_channel_mask,
+    .init_after_join_snapshot_channel_mask = region_au_915_init_after_join_snapshot_channel_mask,
+    .build_channel_mask                    = region_au_915_build_channel_mask,
+    .enable_all_channels_with_valid_freq   = region_au_915_enable_all_channels_with_valid_freq,
+    .is_tx_dr_acceptable                   = region_au_915_is_acceptable_tx_dr,
+    .get_tx_channel_frequency              = region_au_915_get_tx_frequency_channel,
+    .get_rx1_channel_frequency             = region_au_915_get_rx1_frequency_channel,
+    .get_modulation_type_from_datarate     = region_au_915_get_modulation_type_from_datarate,
+    .lora_dr_to_sf_bw                      = region_au_915_lora_dr_to_sf_bw,
+    .lr_fhss_dr_to_cr_bw                   = region_au_915_lr_fhss_dr_to_cr_bw,
+    .get_beacon_frequency                  = region_au_915_get_rx_beacon_frequency_channel,
+    .get_ping_slot_frequency               = region_au_915_get_rx_ping_slot_frequency_channel,
+};
+#endif
+
+#if defined( REGION_CN_470 )
+static const smtc_real_region_ops_t region_ops_cn_470 = {
+    .region_type                         = SMTC_REAL_REGION_CN_470,
+    .is_dynamic_channel_plan             = false,
+    .config                              = region_cn_470_config,
+    .init                                = region_cn_470_init,
+    .init_session                        = region_cn_470_init_session,
+    .get_number_of_chmask_in_cflist      = region_cn_470_get_number_of_chmask_in_cflist,
+    .get_next_channel                    = region_cn_470_get_next_channel,
+    .get_join_next_channel               = region_cn_470_get_join_next_channel,
+    .set_rx_config                       = region_cn_470_set_rx_config,
+    .set_channel_mask                    = region_cn_470_set_channel_mask,
+    .build_channel_mask                  = region_cn_470_build_channel_mask,
+    .enable_all_channels_with_valid_freq = region_cn_470_enable_all_channels_with_valid_freq,
+    .get_tx_channel_frequency            = region_cn_470_get_tx_frequency_channel,
+    .get_rx1_channel_frequency           = region_cn_470_get_rx1_frequency_channel,
+    .get_modulation_type_from_datarate   = region_cn_470_get_modulation_type_from_datarate,
+    .lora_dr_to_sf_bw                    = region_cn_470_lora_dr_to_sf_bw,
+    .fsk_dr_to_bitrate                   = region_cn_470_fsk_dr_to_bitrate,
+    .get_beacon_frequency                = region_cn_470_get_rx_beacon_frequency_channel,
+    .get_ping_slot_frequency             = region_cn_470_get_rx_ping_slot_frequency_channel,
+};
+#endif
+
+#if defined( REGION_CN_470_RP_1_0 )
+static const smtc_real_region_ops_t region_ops_cn_470_rp_1_0 = {
+    .region_type                         = SMTC_REAL_REGION_CN_470_RP_1_0,
+    .is_dynamic_channel_plan             = false,
+    .config                              = region_cn_470_rp_1_0_config,
+    .init                                = region_cn_470_rp_1_0_init,
+    .get_number_of_chmask_in_cflist      = region_cn_470_rp_1_0_get_number_of_chmask_in_cflist,
+    .get_next_channel                    = region_cn_470_rp_1_0_get_next_channel,
+    .get_join_next_channel               = region_cn_470_rp_1_0_get_join_next_channel,
+    .set_rx_config                       = region_cn_470_rp_1_0_set_rx_config,
+    .set_channel_mask                    = region_cn_470_rp_1_0_set_channel_mask,
+    .build_channel_mask                  = region_cn_470_rp_1_0_build_channel_mask,
+    .enable_all_channels_with_valid_freq = region_cn_470_rp_1_0_enable_all_channels_with_valid_freq,
+    .get_tx_channel_frequency            = region_cn_470_rp_1_0_get_tx_frequency_channel,
+    .get_rx1_channel_frequency           = region_cn_470_rp_1_0_get_rx1_frequency_channel,
+    .get_modulation_type_from_datarate   = region_cn_470_rp_1_0_get_modulation_type_from_datarate,
+    .lora_dr_to_sf_bw                    = region_cn_470_rp_1_0_lora_dr_to_sf_bw,
+    .get_beacon_frequency                = region_cn_470_rp_1_0_get_rx_beacon_frequency_channel,
+    .get_ping_slot_frequency             = region_cn_470_rp_1_0_get_rx_ping_slot_frequency_channel,
+};
+#endif
+
+#if defined( REGION_IN_865 )
+static const smtc_real_region_ops_t region_ops_in_865 = {
+    .region_type                       = SMTC_REAL_REGION_IN_865,
+    .is_dynamic_channel_plan           = true,
+    .config                            = region_in_865_config,
+    .init                              = region_in_865_init,
+    .get_next_channel                  = region_in_865_get_next_channel,
+    .get_join_next_channel             = region_in_865_get_join_next_channel,
+    .set_rx_config                     = region_in_865_set_rx_config,
+    .set_channel_mask                  = region_in_865_set_channel_mask,
+    .build_channel_mask                = region_in_865_build_channel_mask,
+    .get_modulation_type_from_datarate = region_in_865_get_modulation_type_from_datarate,
+    .lora_dr_to_sf_bw                  = region_in_865_lora_dr_to_sf_bw,
+    .fsk_dr_to_bitrate                 = region_in_865_fsk_dr_to_bitrate,
+};
+#endif
+
+#if defined( REGION_KR_920 )
+static const smtc_real_region_ops_t region_ops_kr_920 = {
+    .region_type                            = SMTC_REAL_REGION_KR_920,
+    .is_dynamic_channel_plan                = true,
+    .config                                 = region_kr_920_config,
+    .init                                   = region_kr_920_init,
+    .get_next_channel                       = region_kr_920_get_next_channel,
+    .get_join_next_channel                  = region_kr_920_get_join_next_channel,
+    .set_rx_config                          = region_kr_920_set_rx_config,
+    .set_channel_mask                       = region_kr_920_set_channel_mask,
+    .build_channel_mask                     = region_kr_920_build_channel_mask,
+    .get_modulation_type_from_datarate      = region_kr_920_get_modulation_type_from_datarate,
+    .lora_dr_to_sf_bw                       = region_kr_920_lora_dr_to_sf_bw,
+    .clamp_output_power_eirp_vs_freq_and_dr = region_kr_920_clamp_output_power_eirp_vs_freq_and_dr,
+};
+#endif
+
+#if defined( REGION_RU_864 )
+static const smtc_real_region_ops_t region_ops_ru_864 = {
+    .region_type                       = SMTC_REAL_REGION_RU_864,
+    .is_dynamic_channel_plan           = true,
+    .config                            = region_ru_864_config,
+    .init                              = region_ru_864_init,
+    .get_next_channel                  = region_ru_864_get_next_channel,
+    .get_join_next_channel             = region_ru_864_get_join_next_channel,
+    .set_rx_config                     = region_ru_864_set_rx_config,
+    .set_channel_mask                  = region_ru_864_set_channel_mask,
+    .build_channel_mask                = region_ru_864_build_channel_mask,
+    .get_modulation_type_from_datarate = region_ru_864_get_modulation_type_from_datarate,
+    .lora_dr_to_sf_bw                  = region_ru_864_lora_dr_to_sf_bw,
+    .fsk_dr_to_bitrate                 = region_ru_864_fsk_dr_to_bitrate,
+};
+#endif
+
+static const smtc_real_region_ops_t* const smtc_real_region_ops_list[] = {
 #if defined( REGION_WW2G4 )
-    case SMTC_REAL_REGION_WW2G4: {
-        region_ww2g4_config( lr1_mac );
-        break;
-    }
+    &region_ops_ww2g4,
 #endif
 #if defined( REGION_EU_868 )
-    case SMTC_REAL_REGION_EU_868: {
-        region_eu_868_config( lr1_mac );
-        break;
-    }
+    &region_ops_eu_868,
 #endif
 #if defined( REGION_AS_923 )
-    case SMTC_REAL_REGION_AS_923: {
-        region_as_923_config( lr1_mac, 1 );
-        break;
-    }
-    case SMTC_REAL_REGION_AS_923_GRP2: {
-        region_as_923_config( lr1_mac, 2 );
-        break;
-    }
-    case SMTC_REAL_REGION_AS_923_GRP3: {
-        region_as_923_config( lr1_mac, 3 );
-        break;
-    }
+    &region_ops_as_923_grp1,
+    &region_ops_as_923_grp2,
+    &region_ops_as_923_grp3,
 #if defined( RP2_103 )
-    case SMTC_REAL_REGION_AS_923_GRP4: {
-        region_as_923_config( lr1_mac, 4 );
-        break;
-    }
+    &region_ops_as_923_grp4,
 #endif
 #endif
 #if defined( REGION_US_915 )
-    case SMTC_REAL_REGION_US_915: {
-        region_us_915_config( lr1_mac );
-        break;
-    }
+    &region_ops_us_915,
 #endif
 #if defined( REGION_AU_915 )
-    case SMTC_REAL_REGION_AU_915: {
-        region_au_915_config( lr1_mac );
-        break;
-    }
+    &region_ops_au_915,
 #endif
 #if defined( REGION_CN_470 )
-    case SMTC_REAL_REGION_CN_470: {
-        region_cn_470_config( lr1_mac );
-        break;
-    }
+    &region_ops_cn_470,
 #endif
 #if defined( REGION_CN_470_RP_1_0 )
-    case SMTC_REAL_REGION_CN_470_RP_1_0: {
-        region_cn_470_rp_1_0_config( lr1_mac );
-        break;
-    }
+    &region_ops_cn_470_rp_1_0,
 #endif
 #if defined( REGION_IN_865 )
-    case SMTC_REAL_REGION_IN_865: {
-        region_in_865_config( lr1_mac );
-        break;
-    }
+    &region_ops_in_865,
 #endif
 #if defined( REGION_KR_920 )
-    case SMTC_REAL_REGION_KR_920: {
-        region_kr_920_config( lr1_mac );
-        break;
-    }
+    &region_ops_kr_920,
 #endif
 #if defined( REGION_RU_864 )
-    case SMTC_REAL_REGION_RU_864: {
-        region_ru_864_config( lr1_mac );
-        break;
-    }
+    &region_ops_ru_864,
 #endif
-    default:
+};
+
+#define region_ops lr1_mac->real->region_ops
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+smtc_real_status_t smtc_real_is_supported_region( smtc_real_region_types_t region_type )
+{
+    for( uint8_t i = 0; i < SMTC_REAL_REGION_LIST_LENGTH; i++ )
+    {
+        if( smtc_real_region_list[i] == region_type )
+        {
+            return SMTC_REAL_STATUS_OK;
+        }
+    }
+
+    SMTC_MODEM_HAL_TRACE_ERROR( "Invalid Region 0x%02x\n", region_type );
+    return SMTC_REAL_STATUS_UNSUPPORTED_FEATURE;
+}
+
+void smtc_real_config( lr1_stack_mac_t* lr1_mac )
+{
+    // Bands are configured again by the region, the airtime of a band configured again on the same frequencies is kept
+    smtc_duty_cycle_config_clear( lr1_mac->dtc_obj );
+
+    // Region constants are bound by the region config
+    lr1_mac->real->real_const = NULL;
+
+    // Bind the region operations once, every smtc_real_xxx( ) call then goes through this table
+    region_ops = NULL;
+    for( uint8_t i = 0; i < ( sizeof( smtc_real_region_ops_list ) / sizeof( smtc_real_region_ops_list[0] ) ); i++ )
+    {
+        if( smtc_real_region_ops_list[i]->region_type == lr1_mac->real->region_type )
+        {
+            region_ops = smtc_real_region_ops_list[i];
+            break;
+        }
+    }
+    if( region_ops == NULL )
+    {
         smtc_modem_hal_lr1mac_panic( );
-        break;
+        return;
+    }
+    region_ops->config( lr1_mac );
+    if( lr1_mac->real->real_const == NULL )
+    {
+        smtc_modem_hal_lr1mac_panic( );
+        return;
     }
     smtc_lbt_init( lr1_mac->lbt_obj, lr1_mac->rp, RP_HOOK_ID_LBT,
                    ( void ( * )( void* ) ) lr1_stack_mac_tx_radio_free_lbt, lr1_mac,
@@ -227,135 +502,14 @@ void smtc_real_init( lr1_stack_mac_t* lr1_mac )
     lr1_mac->ping_slot_dr              = const_beacon_dr;
     lr1_mac->ping_slot_periodicity_req = SMTC_REAL_PING_SLOT_PERIODICITY_DEFAULT;
 
-    switch( lr1_mac->real->region_type )
-    {
-#if defined( REGION_WW2G4 )
-    case SMTC_REAL_REGION_WW2G4: {
-        region_ww2g4_init( lr1_mac );
-        break;
-    }
-#endif
-#if defined( REGION_EU_868 )
-    case SMTC_REAL_REGION_EU_868: {
-        region_eu_868_init( lr1_mac );
-        break;
-    }
-#endif
-#if defined( REGION_AS_923 )
-    case SMTC_REAL_REGION_AS_923:
-    case SMTC_REAL_REGION_AS_923_GRP2:
-    case SMTC_REAL_REGION_AS_923_GRP3:
-#if defined( RP2_103 )
-    case SMTC_REAL_REGION_AS_923_GRP4:
-#endif
-    {
-        region_as_923_init( lr1_mac );
-        break;
-    }
-#endif
-#if defined( REGION_US_915 )
-    case SMTC_REAL_REGION_US_915: {
-        region_us_915_init( lr1_mac );
-        break;
-    }
-#endif
-#if defined( REGION_AU_915 )
-    case SMTC_REAL_REGION_AU_915: {
-        region_au_915_init( lr1_mac );
-        break;
-    }
-#endif
-#if defined( REGION_CN_470 )
-    case SMTC_REAL_REGION_CN_470: {
-        region_cn_470_init( lr1_mac );
-        break;
-    }
-#endif
-#if defined( REGION_CN_470_RP_1_0 )
-    case SMTC_REAL_REGION_CN_470_RP_1_0: {
-        region_cn_470_rp_1_0_init( lr1_mac );
-        break;
-    }
-#endif
-#if defined( REGION_IN_865 )
-    case SMTC_REAL_REGION_IN_865: {
-        region_in_865_init( lr1_mac );
-        break;
-    }
-#endif
-#if defined( REGION_KR_920 )
-    case SMTC_REAL_REGION_KR_920: {
-        region_kr_920_init( lr1_mac );
-        break;
-    }
-#endif
-#if defined( REGION_RU_864 )
-    case SMTC_REAL_REGION_RU_864: {
-        region_ru_864_init( lr1_mac );
-        break;
-    }
-#endif
-    default:
-        smtc_modem_hal_lr1mac_panic( );
-        break;
-    }
+    region_ops->init( lr1_mac );
 }
 
 void smtc_real_init_session( lr1_stack_mac_t* lr1_mac )
 {
-    switch( lr1_mac->real->region_type )
-    {
-#if defined( REGION_WW2G4 )
-    case SMTC_REAL_REGION_WW2G4:
-#endif
-#if defined( REGION_EU_868 )
-    case SMTC_REAL_REGION_EU_868:
-#endif
-#if defined( REGION_AS_923 )
-    case SMTC_REAL_REGION_AS_923:
-    case SMTC_REAL_REGION_AS_923_GRP2:
-    case SMTC_REAL_REGION_AS_923_GRP3:
-#if defined( RP2_103 )
-    case SMTC_REAL_REGION_AS_923_GRP4:
-#endif
-#endif
-#if defined( REGION_US_915 )
-    case SMTC_REAL_REGION_US_915:
-#endif
-#if defined( REGION_AU_915 )
-    case SMTC_REAL_REGION_AU_915:
-#endif
-#if defined( REGION_IN_865 )
-    case SMTC_REAL_REGION_IN_865:
-#endif
-#if defined( REGION_KR_920 )
-    case SMTC_REAL_REGION_KR_920:
-#endif
-#if defined( REGION_RU_864 )
-    case SMTC_REAL_REGION_RU_864:
-#endif
-#if defined( REGION_WW2G4 ) || defined( REGION_EU_868 ) || defined( REGION_AS_923 ) || defined( REGION_US_915 ) || \
-    defined( REGION_AU_915 ) || defined( REGION_IN_865 ) || defined( REGION_KR_920 ) || defined( REGION_RU_864 )
+    if( region_ops->init_session != NULL )
     {
-        // Not used for these regions
-        break;
-    }
-#endif
-#if defined( REGION_CN_470 )
-    case SMTC_REAL_REGION_CN_470: {
-        region_cn_470_init_session( lr1_mac );
-        break;
-    }
-#endif
-#if defined( REGION_CN_470_RP_1_0 )
-    case SMTC_REAL_REGION_CN_470_RP_1_0: {
-        // Not used for these regions
-        break;
-    }
-#endif
-    default:
-        smtc_modem_hal_lr1mac_panic( );
-        break;
+        region_ops->init_session( lr1_mac );
     }
 }
 
@@ -505,7 +659,7 @@ status_lorawan_t smtc_real_update_cflist( lr1_stack_mac_t* lr1_mac )
                     tx_frequency_channel_ctx[const_number_of_boot_tx_channel + i] != 0 )
                 {
                     // Enable default datarate for all added channels
-                    dr_bitfield_tx_channel_ctx[const_number_of_boot_tx_channel + i] = const_default_tx_dr_bit_field;
+                    dr_bitfield_tx_channel_nwk_ctx[const_number_of_boot_tx_channel + i] = const_default_tx_dr_bit_field;
 
                     // Enable Channel
                     SMTC_PUT_BIT8( channel_index_enabled_ctx, ( const_number_of_boot_tx_channel + i ),
@@ -580,363 +734,45 @@ status_lorawan_t smtc_real_update_cflist( lr1_stack_mac_t* lr1_mac )
 
 uint8_t smtc_real_get_number_of_chmask_in_cflist( lr1_stack_mac_t* lr1_mac )
 {
-    switch( lr1_mac->real->region_type )
-    {
-#if defined( REGION_WW2G4 )
-    case SMTC_REAL_REGION_WW2G4:
-#endif
-#if defined( REGION_EU_868 )
-    case SMTC_REAL_REGION_EU_868:
-#endif
-#if defined( REGION_AS_923 )
-    case SMTC_REAL_REGION_AS_923:
-    case SMTC_REAL_REGION_AS_923_GRP2:
-    case SMTC_REAL_REGION_AS_923_GRP3:
-#if defined( RP2_103 )
-    case SMTC_REAL_REGION_AS_923_GRP4:
-#endif
-#endif
-#if defined( REGION_IN_865 )
-    case SMTC_REAL_REGION_IN_865:
-#endif
-#if defined( REGION_KR_920 )
-    case SMTC_REAL_REGION_KR_920:
-#endif
-#if defined( REGION_RU_864 )
-    case SMTC_REAL_REGION_RU_864:
-#endif
-#if defined( REGION_WW2G4 ) || defined( REGION_EU_868 ) || defined( REGION_AS_923 ) || defined( REGION_IN_865 ) || \
-    defined( REGION_KR_920 ) || defined( REGION_RU_864 )
+    if( region_ops->get_number_of_chmask_in_cflist == NULL )
     {
         return 0;
     }
-#endif
-#if defined( REGION_US_915 )
-    case SMTC_REAL_REGION_US_915:
-#endif
-#if defined( REGION_AU_915 )
-    case SMTC_REAL_REGION_AU_915:
-#endif
-#if defined( REGION_US_915 ) || defined( REGION_AU_915 )
-    {
-        return 5;
-    }
-#endif
-#if defined( REGION_CN_470 )
-    case SMTC_REAL_REGION_CN_470: {
-        return region_cn_470_get_number_of_chmask_in_cflist( lr1_mac );
-    }
-#endif
-#if defined( REGION_CN_470_RP_1_0 )
-    case SMTC_REAL_REGION_CN_470_RP_1_0: {
-        return region_cn_470_rp_1_0_get_number_of_chmask_in_cflist( lr1_mac );
-    }
-#endif
-    default:
-        smtc_modem_hal_lr1mac_panic( );
-        break;
-    }
-    return ERRORLORAWAN;  // never reach => avoid warning
+    return region_ops->get_number_of_chmask_in_cflist( lr1_mac );
 }
 
 status_lorawan_t smtc_real_get_next_channel( lr1_stack_mac_t* lr1_mac )
 {
-    switch( lr1_mac->real->region_type )
+    return region_ops->get_next_channel( lr1_mac );
+}
+
+status_lorawan_t smtc_real_get_join_next_channel( lr1_stack_mac_t* lr1_mac )
+{
+    return region_ops->get_join_next_channel( lr1_mac );
+}
+
+void smtc_real_set_rx_config( lr1_stack_mac_t* lr1_mac, rx_win_type_t type )
+{
+    region_ops->set_rx_config( lr1_mac, type );
+}
+
+void smtc_real_set_power( lr1_stack_mac_t* lr1_mac, uint8_t power_cmd )
+{
+    if( power_cmd > const_max_tx_power_idx )
     {
-#if defined( REGION_WW2G4 )
-    case SMTC_REAL_REGION_WW2G4: {
-        return region_ww2g4_get_next_channel( lr1_mac );
+        lr1_mac->tx_power = lr1_mac->max_erp_dbm;
+        SMTC_MODEM_HAL_TRACE_WARNING( "INVALID %d \n", power_cmd );
     }
-#endif
-#if defined( REGION_EU_868 )
-    case SMTC_REAL_REGION_EU_868: {
-        return region_eu_868_get_next_channel( lr1_mac );
-    }
-#endif
-#if defined( REGION_AS_923 )
-    case SMTC_REAL_REGION_AS_923:
-    case SMTC_REAL_REGION_AS_923_GRP2:
-    case SMTC_REAL_REGION_AS_923_GRP3:
-#if defined( RP2_103 )
-    case SMTC_REAL_REGION_AS_923_GRP4:
-#endif
-    {
-        return region_as_923_get_next_channel( lr1_mac );
-    }
-#endif
-#if defined( REGION_US_915 )
-    case SMTC_REAL_REGION_US_915: {
-        return region_us_915_get_next_channel( lr1_mac );
-    }
-#endif
-#if defined( REGION_AU_915 )
-    case SMTC_REAL_REGION_AU_915: {
-        return region_au_915_get_next_channel( lr1_mac );
-    }
-#endif
-#if defined( REGION_CN_470 )
-    case SMTC_REAL_REGION_CN_470: {
-        return region_cn_470_get_next_channel( lr1_mac );
-    }
-#endif
-#if defined( REGION_CN_470_RP_1_0 )
-    case SMTC_REAL_REGION_CN_470_RP_1_0: {
-        return region_cn_470_rp_1_0_get_next_channel( lr1_mac );
-    }
-#endif
-#if defined( REGION_IN_865 )
-    case SMTC_REAL_REGION_IN_865: {
-        return region_in_865_get_next_channel( lr1_mac );
-    }
-#endif
-#if defined( REGION_KR_920 )
-    case SMTC_REAL_REGION_KR_920: {
-        return region_kr_920_get_next_channel( lr1_mac );
-    }
-#endif
-#if defined( REGION_RU_864 )
-    case SMTC_REAL_REGION_RU_864: {
-        return region_ru_864_get_next_channel( lr1_mac );
-    }
-#endif
-    default:
-        smtc_modem_hal_lr1mac_panic( );
-        break;
-    }
-    return ERRORLORAWAN;  // never reach => avoid warning
-}
-
-status_lorawan_t smtc_real_get_join_next_channel( lr1_stack_mac_t* lr1_mac )
-{
-    switch( lr1_mac->real->region_type )
-    {
-#if defined( REGION_WW2G4 )
-    case SMTC_REAL_REGION_WW2G4: {
-        return region_ww2g4_get_join_next_channel( lr1_mac );
-    }
-#endif
-#if defined( REGION_EU_868 )
-    case SMTC_REAL_REGION_EU_868: {
-        return region_eu_868_get_join_next_channel( lr1_mac );
-    }
-#endif
-#if defined( REGION_AS_923 )
-    case SMTC_REAL_REGION_AS_923:
-    case SMTC_REAL_REGION_AS_923_GRP2:
-    case SMTC_REAL_REGION_AS_923_GRP3:
-#if defined( RP2_103 )
-    case SMTC_REAL_REGION_AS_923_GRP4:
-#endif
-    {
-        return region_as_923_get_join_next_channel( lr1_mac );
-    }
-#endif
-#if defined( REGION_US_915 )
-    case SMTC_REAL_REGION_US_915: {
-        return region_us_915_get_join_next_channel( lr1_mac );
-    }
-#endif
-#if defined( REGION_AU_915 )
-    case SMTC_REAL_REGION_AU_915: {
-        return region_au_915_get_join_next_channel( lr1_mac );
-    }
-#endif
-#if defined( REGION_CN_470 )
-    case SMTC_REAL_REGION_CN_470: {
-        return region_cn_470_get_join_next_channel( lr1_mac );
-    }
-#endif
-#if defined( REGION_CN_470_RP_1_0 )
-    case SMTC_REAL_REGION_CN_470_RP_1_0: {
-        return region_cn_470_rp_1_0_get_join_next_channel( lr1_mac );
-    }
-#endif
-#if defined( REGION_IN_865 )
-    case SMTC_REAL_REGION_IN_865: {
-        return region_in_865_get_join_next_channel( lr1_mac );
-    }
-#endif
-#if defined( REGION_KR_920 )
-    case SMTC_REAL_REGION_KR_920: {
-        return region_kr_920_get_join_next_channel( lr1_mac );
-    }
-#endif
-#if defined( REGION_RU_864 )
-    case SMTC_REAL_REGION_RU_864: {
-        return region_ru_864_get_join_next_channel( lr1_mac );
-    }
-#endif
-    default:
-        smtc_modem_hal_lr1mac_panic( );
-        break;
-    }
-    return ERRORLORAWAN;  // never reach => avoid warning
-}
-
-void smtc_real_set_rx_config( lr1_stack_mac_t* lr1_mac, rx_win_type_t type )
-{
-    switch( lr1_mac->real->region_type )
-    {
-#if defined( REGION_WW2G4 )
-    case SMTC_REAL_REGION_WW2G4: {
-        region_ww2g4_set_rx_config( lr1_mac, type );
-        break;
-    }
-#endif
-#if defined( REGION_EU_868 )
-    case SMTC_REAL_REGION_EU_868: {
-        region_eu_868_set_rx_config( lr1_mac, type );
-        break;
-    }
-#endif
-#if defined( REGION_AS_923 )
-    case SMTC_REAL_REGION_AS_923:
-    case SMTC_REAL_REGION_AS_923_GRP2:
-    case SMTC_REAL_REGION_AS_923_GRP3:
-#if defined( RP2_103 )
-    case SMTC_REAL_REGION_AS_923_GRP4:
-#endif
-    {
-        region_as_923_set_rx_config( lr1_mac, type );
-        break;
-    }
-#endif
-#if defined( REGION_US_915 )
-    case SMTC_REAL_REGION_US_915: {
-        region_us_915_set_rx_config( lr1_mac, type );
-        break;
-    }
-#endif
-#if defined( REGION_AU_915 )
-    case SMTC_REAL_REGION_AU_915: {
-        region_au_915_set_rx_config( lr1_mac, type );
-        break;
-    }
-#endif
-#if defined( REGION_CN_470 )
-    case SMTC_REAL_REGION_CN_470: {
-        region_cn_470_set_rx_config( lr1_mac, type );
-        break;
-    }
-#endif
-#if defined( REGION_CN_470_RP_1_0 )
-    case SMTC_REAL_REGION_CN_470_RP_1_0: {
-        region_cn_470_rp_1_0_set_rx_config( lr1_mac, type );
-        break;
-    }
-#endif
-#if defined( REGION_IN_865 )
-    case SMTC_REAL_REGION_IN_865: {
-        region_in_865_set_rx_config( lr1_mac, type );
-        break;
-    }
-#endif
-#if defined( REGION_KR_920 )
-    case SMTC_REAL_REGION_KR_920: {
-        region_kr_920_set_rx_config( lr1_mac, type );
-        break;
-    }
-#endif
-#if defined( REGION_RU_864 )
-    case SMTC_REAL_REGION_RU_864: {
-        region_ru_864_set_rx_config( lr1_mac, type );
-        break;
-    }
-#endif
-    default:
-        smtc_modem_hal_lr1mac_panic( );
-        break;
-    }
-}
-
-void smtc_real_set_power( lr1_stack_mac_t* lr1_mac, uint8_t power_cmd )
-{
-    if( power_cmd > const_max_tx_power_idx )
-    {
-        lr1_mac->tx_power = lr1_mac->max_erp_dbm;
-        SMTC_MODEM_HAL_TRACE_WARNING( "INVALID %d \n", power_cmd );
-    }
-    else
-    {
-        int8_t pwr_tmp    = lr1_mac->max_erp_dbm - ( 2 * power_cmd );
-        lr1_mac->tx_power = ( pwr_tmp < 0 ) ? 0 : pwr_tmp;
+    else
+    {
+        int8_t pwr_tmp    = lr1_mac->max_erp_dbm - ( 2 * power_cmd );
+        lr1_mac->tx_power = ( pwr_tmp < 0 ) ? 0 : pwr_tmp;
     }
 }
 
 void smtc_real_set_channel_mask( lr1_stack_mac_t* lr1_mac )
 {
-    switch( lr1_mac->real->region_type )
-    {
-#if defined( REGION_WW2G4 )
-    case SMTC_REAL_REGION_WW2G4: {
-        region_ww2g4_set_channel_mask( lr1_mac );
-        break;
-    }
-#endif
-#if defined( REGION_EU_868 )
-    case SMTC_REAL_REGION_EU_868: {
-        region_eu_868_set_channel_mask( lr1_mac );
-        break;
-    }
-#endif
-#if defined( REGION_AS_923 )
-    case SMTC_REAL_REGION_AS_923:
-    case SMTC_REAL_REGION_AS_923_GRP2:
-    case SMTC_REAL_REGION_AS_923_GRP3:
-#if defined( RP2_103 )
-    case SMTC_REAL_REGION_AS_923_GRP4:
-#endif
-    {
-        region_as_923_set_channel_mask( lr1_mac );
-        break;
-    }
-#endif
-#if defined( REGION_US_915 )
-    case SMTC_REAL_REGION_US_915: {
-        region_us_915_set_channel_mask( lr1_mac );
-        break;
-    }
-#endif
-#if defined( REGION_AU_915 )
-    case SMTC_REAL_REGION_AU_915: {
-        region_au_915_set_channel_mask( lr1_mac );
-        break;
-    }
-#endif
-#if defined( REGION_CN_470 )
-    case SMTC_REAL_REGION_CN_470: {
-        region_cn_470_set_channel_mask( lr1_mac );
-        break;
-    }
-#endif
-#if defined( REGION_CN_470_RP_1_0 )
-    case SMTC_REAL_REGION_CN_470_RP_1_0: {
-        region_cn_470_rp_1_0_set_channel_mask( lr1_mac );
-        break;
-    }
-#endif
-#if defined( REGION_IN_865 )
-    case SMTC_REAL_REGION_IN_865: {
-        region_in_865_set_channel_mask( lr1_mac );
-        break;
-    }
-#endif
-#if defined( REGION_KR_920 )
-    case SMTC_REAL_REGION_KR_920: {
-        region_kr_920_set_channel_mask( lr1_mac );
-        break;
-    }
-#endif
-#if defined( REGION_RU_864 )
-    case SMTC_REAL_REGION_RU_864: {
-        region_ru_864_set_channel_mask( lr1_mac );
-        break;
-    }
-#endif
-    default:
-        smtc_modem_hal_lr1mac_panic( );
-        break;
-    }
+    region_ops->set_channel_mask( lr1_mac );
 }
 
 void smtc_real_init_channel_mask( lr1_stack_mac_t* lr1_mac )
@@ -946,187 +782,23 @@ void smtc_real_init_channel_mask( lr1_stack_mac_t* lr1_mac )
 
 void smtc_real_init_join_snapshot_channel_mask( lr1_stack_mac_t* lr1_mac )
 {
-    switch( lr1_mac->real->region_type )
-    {
-#if defined( REGION_WW2G4 )
-    case SMTC_REAL_REGION_WW2G4:
-#endif
-#if defined( REGION_EU_868 )
-    case SMTC_REAL_REGION_EU_868:
-#endif
-#if defined( REGION_AS_923 )
-    case SMTC_REAL_REGION_AS_923:
-    case SMTC_REAL_REGION_AS_923_GRP2:
-    case SMTC_REAL_REGION_AS_923_GRP3:
-#if defined( RP2_103 )
-    case SMTC_REAL_REGION_AS_923_GRP4:
-#endif
-#endif
-#if defined( REGION_CN_470 )
-    case SMTC_REAL_REGION_CN_470:
-#endif
-#if defined( REGION_CN_470_RP_1_0 )
-    case SMTC_REAL_REGION_CN_470_RP_1_0:
-#endif
-#if defined( REGION_IN_865 )
-    case SMTC_REAL_REGION_IN_865:
-#endif
-#if defined( REGION_KR_920 )
-    case SMTC_REAL_REGION_KR_920:
-#endif
-#if defined( REGION_RU_864 )
-    case SMTC_REAL_REGION_RU_864:
-#endif
-#if defined( REGION_WW2G4 ) || defined( REGION_EU_868 ) || defined( REGION_AS_923 ) || defined( REGION_CN_470 ) || \
-    defined( REGION_CN_470_RP_1_0 ) || defined( REGION_IN_865 ) || defined( REGION_KR_920 ) ||                     \
-    defined( REGION_RU_864 )
+    if( region_ops->init_join_snapshot_channel_mask != NULL )
     {
-        // Not used for these regions
-        break;
-    }
-#endif
-#if defined( REGION_US_915 )
-    case SMTC_REAL_REGION_US_915: {
-        region_us_915_init_join_snapshot_channel_mask( lr1_mac );
-        break;
-    }
-#endif
-#if defined( REGION_AU_915 )
-    case SMTC_REAL_REGION_AU_915: {
-        region_au_915_init_join_snapshot_channel_mask( lr1_mac );
-        break;
-    }
-#endif
-    default:
-        smtc_modem_hal_lr1mac_panic( );
-        break;
+        region_ops->init_join_snapshot_channel_mask( lr1_mac );
     }
 }
 
 void smtc_real_init_after_join_snapshot_channel_mask( lr1_stack_mac_t* lr1_mac )
 {
-    switch( lr1_mac->real->region_type )
+    if( region_ops->init_after_join_snapshot_channel_mask != NULL )
     {
-#if defined( REGION_WW2G4 )
-    case SMTC_REAL_REGION_WW2G4:
-#endif
-#if defined( REGION_EU_868 )
-    case SMTC_REAL_REGION_EU_868:
-#endif
-#if defined( REGION_AS_923 )
-    case SMTC_REAL_REGION_AS_923:
-    case SMTC_REAL_REGION_AS_923_GRP2:
-    case SMTC_REAL_REGION_AS_923_GRP3:
-#if defined( RP2_103 )
-    case SMTC_REAL_REGION_AS_923_GRP4:
-#endif
-#endif
-#if defined( REGION_CN_470 )
-    case SMTC_REAL_REGION_CN_470:
-#endif
-#if defined( REGION_CN_470_RP_1_0 )
-    case SMTC_REAL_REGION_CN_470_RP_1_0:
-#endif
-#if defined( REGION_IN_865 )
-    case SMTC_REAL_REGION_IN_865:
-#endif
-#if defined( REGION_KR_920 )
-    case SMTC_REAL_REGION_KR_920:
-#endif
-#if defined( REGION_RU_864 )
-    case SMTC_REAL_REGION_RU_864:
-#endif
-#if defined( REGION_WW2G4 ) || defined( REGION_EU_868 ) || defined( REGION_AS_923 ) || defined( REGION_CN_470 ) || \
-    defined( REGION_CN_470_RP_1_0 ) || defined( REGION_IN_865 ) || defined( REGION_KR_920 ) ||                     \
-    defined( REGION_RU_864 )
-    {
-        // Not used for these regions
-        break;
-    }
-#endif
-#if defined( REGION_US_915 )
-    case SMTC_REAL_REGION_US_915: {
-        region_us_915_init_after_join_snapshot_channel_mask( lr1_mac );
-        break;
-    }
-#endif
-#if defined( REGION_AU_915 )
-    case SMTC_REAL_REGION_AU_915: {
-        region_au_915_init_after_join_snapshot_channel_mask( lr1_mac );
-        break;
-    }
-#endif
-    default:
-        smtc_modem_hal_lr1mac_panic( );
-        break;
+        region_ops->init_after_join_snapshot_channel_mask( lr1_mac );
     }
 }
 
 status_channel_t smtc_real_build_channel_mask( lr1_stack_mac_t* lr1_mac, uint8_t ch_mask_cntl, uint16_t ch_mask )
 {
-    switch( lr1_mac->real->region_type )
-    {
-#if defined( REGION_WW2G4 )
-    case SMTC_REAL_REGION_WW2G4: {
-        return region_ww2g4_build_channel_mask( lr1_mac, ch_mask_cntl, ch_mask );
-    }
-#endif
-#if defined( REGION_EU_868 )
-    case SMTC_REAL_REGION_EU_868: {
-        return region_eu_868_build_channel_mask( lr1_mac, ch_mask_cntl, ch_mask );
-    }
-#endif
-#if defined( REGION_AS_923 )
-    case SMTC_REAL_REGION_AS_923:
-    case SMTC_REAL_REGION_AS_923_GRP2:
-    case SMTC_REAL_REGION_AS_923_GRP3:
-#if defined( RP2_103 )
-    case SMTC_REAL_REGION_AS_923_GRP4:
-#endif
-    {
-        return region_as_923_build_channel_mask( lr1_mac, ch_mask_cntl, ch_mask );
-    }
-#endif
-#if defined( REGION_US_915 )
-    case SMTC_REAL_REGION_US_915: {
-        return region_us_915_build_channel_mask( lr1_mac, ch_mask_cntl, ch_mask );
-    }
-#endif
-#if defined( REGION_AU_915 )
-    case SMTC_REAL_REGION_AU_915: {
-        return region_au_915_build_channel_mask( lr1_mac, ch_mask_cntl, ch_mask );
-    }
-#endif
-#if defined( REGION_CN_470 )
-    case SMTC_REAL_REGION_CN_470: {
-        return region_cn_470_build_channel_mask( lr1_mac, ch_mask_cntl, ch_mask );
-    }
-#endif
-#if defined( REGION_CN_470_RP_1_0 )
-    case SMTC_REAL_REGION_CN_470_RP_1_0: {
-        return region_cn_470_rp_1_0_build_channel_mask( lr1_mac, ch_mask_cntl, ch_mask );
-    }
-#endif
-#if defined( REGION_IN_865 )
-    case SMTC_REAL_REGION_IN_865: {
-        return region_in_865_build_channel_mask( lr1_mac, ch_mask_cntl, ch_mask );
-    }
-#endif
-#if defined( REGION_KR_920 )
-    case SMTC_REAL_REGION_KR_920: {
-        return region_kr_920_build_channel_mask( lr1_mac, ch_mask_cntl, ch_mask );
-    }
-#endif
-#if defined( REGION_RU_864 )
-    case SMTC_REAL_REGION_RU_864: {
-        return region_ru_864_build_channel_mask( lr1_mac, ch_mask_cntl, ch_mask );
-    }
-#endif
-    default:
-        smtc_modem_hal_lr1mac_panic( );
-        break;
-    }
-    return ERROR_CHANNEL;  // never reach => avoid warning
+    return region_ops->build_channel_mask( lr1_mac, ch_mask_cntl, ch_mask );
 }
 
 uint8_t smtc_real_decrement_dr_simulation( lr1_stack_mac_t* lr1_mac )
@@ -1191,73 +863,20 @@ void smtc_real_decrement_dr( lr1_stack_mac_t* lr1_mac )
 
 void smtc_real_enable_all_channels_with_valid_freq( lr1_stack_mac_t* lr1_mac )
 {
-    switch( lr1_mac->real->region_type )
+    if( region_ops->enable_all_channels_with_valid_freq != NULL )
     {
-#if defined( REGION_WW2G4 )
-    case SMTC_REAL_REGION_WW2G4:
-#endif
-#if defined( REGION_EU_868 )
-    case SMTC_REAL_REGION_EU_868:
-#endif
-#if defined( REGION_AS_923 )
-    case SMTC_REAL_REGION_AS_923:
-    case SMTC_REAL_REGION_AS_923_GRP2:
-    case SMTC_REAL_REGION_AS_923_GRP3:
-#if defined( RP2_103 )
-    case SMTC_REAL_REGION_AS_923_GRP4:
-#endif
-#endif
-#if defined( REGION_KR_920 )
-    case SMTC_REAL_REGION_KR_920:
-#endif
-#if defined( REGION_IN_865 )
-    case SMTC_REAL_REGION_IN_865:
-#endif
-#if defined( REGION_RU_864 )
-    case SMTC_REAL_REGION_RU_864:
-#endif
-#if defined( REGION_WW2G4 ) || defined( REGION_EU_868 ) || defined( REGION_AS_923 ) || defined( REGION_IN_865 ) || \
-    defined( REGION_KR_920 ) || defined( REGION_RU_864 )
+        region_ops->enable_all_channels_with_valid_freq( lr1_mac );
+        return;
+    }
+
+    for( uint8_t i = 0; i < const_number_of_tx_channel; i++ )
     {
-        for( uint8_t i = 0; i < const_number_of_tx_channel; i++ )
+        if( ( tx_frequency_channel_ctx[i] != 0 ) &&
+            ( SMTC_GET_BIT8( channel_index_enabled_ctx, i ) == CHANNEL_DISABLED ) )
         {
-            if( ( tx_frequency_channel_ctx[i] != 0 ) &&
-                ( SMTC_GET_BIT8( channel_index_enabled_ctx, i ) == CHANNEL_DISABLED ) )
-            {
-                SMTC_PUT_BIT8( channel_index_enabled_ctx, i, CHANNEL_ENABLED );
-                dr_bitfield_tx_channel_ctx[i] = const_default_tx_dr_bit_field;
-            }
+            SMTC_PUT_BIT8( channel_index_enabled_ctx, i, CHANNEL_ENABLED );
+            dr_bitfield_tx_channel_nwk_ctx[i] = const_default_tx_dr_bit_field;
         }
-        break;
-    }
-#endif
-#if defined( REGION_CN_470 )
-    case SMTC_REAL_REGION_CN_470: {
-        region_cn_470_enable_all_channels_with_valid_freq( lr1_mac );
-        break;
-    }
-#endif
-#if defined( REGION_CN_470_RP_1_0 )
-    case SMTC_REAL_REGION_CN_470_RP_1_0: {
-        region_cn_470_rp_1_0_enable_all_channels_with_valid_freq( lr1_mac );
-        break;
-    }
-#endif
-#if defined( REGION_US_915 )
-    case SMTC_REAL_REGION_US_915: {
-        region_us_915_enable_all_channels_with_valid_freq( lr1_mac );
-        break;
-    }
-#endif
-#if defined( REGION_AU_915 )
-    case SMTC_REAL_REGION_AU_915: {
-        region_au_915_enable_all_channels_with_valid_freq( lr1_mac );
-        break;
-    }
-#endif
-    default:
-        smtc_modem_hal_lr1mac_panic( );
-        break;
     }
 }
 
@@ -1302,208 +921,65 @@ status_lorawan_t smtc_real_is_tx_dr_valid( lr1_stack_mac_t* lr1_mac, uint8_t dr
 
 status_lorawan_t smtc_real_is_tx_dr_acceptable( lr1_stack_mac_t* lr1_mac, uint8_t dr, bool is_ch_mask_from_link_adr )
 {
-    switch( lr1_mac->real->region_type )
-    {
-#if defined( REGION_WW2G4 )
-    case SMTC_REAL_REGION_WW2G4:
-#endif
-#if defined( REGION_EU_868 )
-    case SMTC_REAL_REGION_EU_868:
-#endif
-#if defined( REGION_AS_923 )
-    case SMTC_REAL_REGION_AS_923:
-    case SMTC_REAL_REGION_AS_923_GRP2:
-    case SMTC_REAL_REGION_AS_923_GRP3:
-#if defined( RP2_103 )
-    case SMTC_REAL_REGION_AS_923_GRP4:
-#endif
-#endif
-#if defined( REGION_CN_470 )
-    case SMTC_REAL_REGION_CN_470:
-#endif
-#if defined( REGION_CN_470_RP_1_0 )
-    case SMTC_REAL_REGION_CN_470_RP_1_0:
-#endif
-#if defined( REGION_IN_865 )
-    case SMTC_REAL_REGION_IN_865:
-#endif
-#if defined( REGION_KR_920 )
-    case SMTC_REAL_REGION_KR_920:
-#endif
-#if defined( REGION_RU_864 )
-    case SMTC_REAL_REGION_RU_864:
-#endif
-#if defined( REGION_WW2G4 ) || defined( REGION_EU_868 ) || defined( REGION_AS_923 ) || defined( REGION_CN_470 ) || \
-    defined( REGION_CN_470_RP_1_0 ) || defined( REGION_IN_865 ) || defined( REGION_KR_920 ) ||                     \
-    defined( REGION_RU_864 )
+    if( region_ops->is_tx_dr_acceptable != NULL )
     {
-        uint8_t* ch_mask_to_check =
-            ( is_ch_mask_from_link_adr == true ) ? unwrapped_channel_mask_ctx : channel_index_enabled_ctx;
+        return region_ops->is_tx_dr_acceptable( lr1_mac, dr, is_ch_mask_from_link_adr );
+    }
 
-        if( lr1_mac->uplink_dwell_time == true )
-        {
-            if( dr < const_min_tx_dr_limit )
-            {
-                return ERRORLORAWAN;
-            }
-        }
+    uint8_t* ch_mask_to_check =
+        ( is_ch_mask_from_link_adr == true ) ? unwrapped_channel_mask_ctx : channel_index_enabled_ctx;
 
-        for( uint8_t i = 0; i < const_number_of_tx_channel; i++ )
+    if( lr1_mac->uplink_dwell_time == true )
+    {
+        if( dr < const_min_tx_dr_limit )
         {
-            if( SMTC_GET_BIT8( ch_mask_to_check, i ) == CHANNEL_ENABLED )
-            {
-                SMTC_MODEM_HAL_TRACE_PRINTF( "ch%d - dr field 0x%04x\n", i, dr_bitfield_tx_channel_ctx[i] );
-                if( SMTC_GET_BIT16( &dr_bitfield_tx_channel_ctx[i], dr ) == 1 )
-                {
-                    return ( OKLORAWAN );
-                }
-            }
+            return ERRORLORAWAN;
         }
-
-        SMTC_MODEM_HAL_TRACE_WARNING( "Not acceptable data rate\n" );
-        return ( ERRORLORAWAN );
     }
-#endif
-#if defined( REGION_US_915 )
-    case SMTC_REAL_REGION_US_915:
-        return region_us_915_is_acceptable_tx_dr( lr1_mac, dr, is_ch_mask_from_link_adr );
-#endif
-#if defined( REGION_AU_915 )
-    case SMTC_REAL_REGION_AU_915:
-        return region_au_915_is_acceptable_tx_dr( lr1_mac, dr, is_ch_mask_from_link_adr );
-#endif
-    default:
-        smtc_modem_hal_lr1mac_panic( );
-        break;
+
+    for( uint8_t i = 0; i < const_number_of_tx_channel; i++ )
+    {
+        if( SMTC_GET_BIT8( ch_mask_to_check, i ) == CHANNEL_ENABLED )
+        {
+            SMTC_MODEM_HAL_TRACE_PRINTF( "ch%d - dr field 0x%04x\n", i, dr_bitfield_tx_channel_ctx[i] );
+            if( SMTC_GET_BIT16( &dr_bitfield_tx_channel_ctx[i], dr ) == 1 )
+            {
+                return ( OKLORAWAN );
+            }
+        }
     }
-    return ERRORLORAWAN;  // never reach => avoid warning
+
+    SMTC_MODEM_HAL_TRACE_WARNING( "Not acceptable data rate\n" );
+    return ( ERRORLORAWAN );
 }
 
 status_lorawan_t smtc_real_is_nwk_received_tx_frequency_valid( lr1_stack_mac_t* lr1_mac, uint32_t frequency )
 {
-    switch( lr1_mac->real->region_type )
-    {
-#if defined( REGION_WW2G4 )
-    case SMTC_REAL_REGION_WW2G4:
-#endif
-#if defined( REGION_EU_868 )
-    case SMTC_REAL_REGION_EU_868:
-#endif
-#if defined( REGION_AS_923 )
-    case SMTC_REAL_REGION_AS_923:
-    case SMTC_REAL_REGION_AS_923_GRP2:
-    case SMTC_REAL_REGION_AS_923_GRP3:
-#if defined( RP2_103 )
-    case SMTC_REAL_REGION_AS_923_GRP4:
-#endif
-#endif
-#if defined( REGION_IN_865 )
-    case SMTC_REAL_REGION_IN_865:
-#endif
-#if defined( REGION_KR_920 )
-    case SMTC_REAL_REGION_KR_920:
-#endif
-#if defined( REGION_RU_864 )
-    case SMTC_REAL_REGION_RU_864:
-#endif
-#if defined( REGION_WW2G4 ) || defined( REGION_EU_868 ) || defined( REGION_AS_923 ) || defined( REGION_IN_865 ) || \
-    defined( REGION_KR_920 ) || defined( REGION_RU_864 )
-    {
-        status_lorawan_t status = OKLORAWAN;
-        if( frequency == 0 )
-        {
-            return ( status );
-        }
-        status = smtc_real_is_frequency_valid( lr1_mac, frequency );
-        return ( status );
-    }
-#endif
-#if defined( REGION_CN_470 )
-    case SMTC_REAL_REGION_CN_470:
-#endif
-#if defined( REGION_CN_470_RP_1_0 )
-    case SMTC_REAL_REGION_CN_470_RP_1_0:
-#endif
-#if defined( REGION_US_915 )
-    case SMTC_REAL_REGION_US_915:
-#endif
-#if defined( REGION_AU_915 )
-    case SMTC_REAL_REGION_AU_915:
-#endif
-#if defined( REGION_CN_470 ) || defined( REGION_CN_470_RP_1_0 ) || defined( REGION_US_915 ) || defined( REGION_AU_915 )
+    if( region_ops->is_dynamic_channel_plan == false )
     {
         return ( ERRORLORAWAN );
     }
-#endif
-    default:
-        smtc_modem_hal_lr1mac_panic( );
-        break;
+    if( frequency == 0 )
+    {
+        return ( OKLORAWAN );
     }
-    return ERRORLORAWAN;  // never reach => avoid warning
+    return smtc_real_is_frequency_valid( lr1_mac, frequency );
 }
 
 status_lorawan_t smtc_real_is_channel_index_valid( lr1_stack_mac_t* lr1_mac, uint8_t channel_index )
 {
-    switch( lr1_mac->real->region_type )
-    {
-#if defined( REGION_WW2G4 )
-    case SMTC_REAL_REGION_WW2G4:
-#endif
-#if defined( REGION_EU_868 )
-    case SMTC_REAL_REGION_EU_868:
-#endif
-#if defined( REGION_AS_923 )
-    case SMTC_REAL_REGION_AS_923:
-    case SMTC_REAL_REGION_AS_923_GRP2:
-    case SMTC_REAL_REGION_AS_923_GRP3:
-#if defined( RP2_103 )
-    case SMTC_REAL_REGION_AS_923_GRP4:
-#endif
-#endif
-#if defined( REGION_IN_865 )
-    case SMTC_REAL_REGION_IN_865:
-#endif
-#if defined( REGION_KR_920 )
-    case SMTC_REAL_REGION_KR_920:
-#endif
-#if defined( REGION_RU_864 )
-    case SMTC_REAL_REGION_RU_864:
-#endif
-#if defined( REGION_WW2G4 ) || defined( REGION_EU_868 ) || defined( REGION_AS_923 ) || defined( REGION_IN_865 ) || \
-    defined( REGION_KR_920 ) || defined( REGION_RU_864 )
+    if( region_ops->is_dynamic_channel_plan == false )
     {
-        status_lorawan_t status = OKLORAWAN;
-        if( ( channel_index < const_number_of_boot_tx_channel ) || ( channel_index >= const_number_of_tx_channel ) )
-        {
-            status = ERRORLORAWAN;
-            SMTC_MODEM_HAL_TRACE_WARNING( "RECEIVE AN INVALID Channel Index Cmd = %d\n", channel_index );
-        }
-        return ( status );
+        return ( ERRORLORAWAN );
     }
-#endif
 
-#if defined( REGION_CN_470 )
-    case SMTC_REAL_REGION_CN_470:
-#endif
-#if defined( REGION_CN_470_RP_1_0 )
-    case SMTC_REAL_REGION_CN_470_RP_1_0:
-#endif
-#if defined( REGION_US_915 )
-    case SMTC_REAL_REGION_US_915:
-#endif
-#if defined( REGION_AU_915 )
-    case SMTC_REAL_REGION_AU_915:
-#endif
-#if defined( REGION_CN_470 ) || defined( REGION_CN_470_RP_1_0 ) || defined( REGION_US_915 ) || defined( REGION_AU_915 )
+    status_lorawan_t status = OKLORAWAN;
+    if( ( channel_index < const_number_of_boot_tx_channel ) || ( channel_index >= const_number_of_tx_channel ) )
     {
-        return ( ERRORLORAWAN );
-    }
-#endif
-    default:
-        smtc_modem_hal_lr1mac_panic( );
-        break;
+        status = ERRORLORAWAN;
+        SMTC_MODEM_HAL_TRACE_WARNING( "RECEIVE AN INVALID Channel Index Cmd = %d\n", channel_index );
     }
-    return ERRORLORAWAN;  // never reach => avoid warning
+    return ( status );
 }
 
 status_lorawan_t smtc_real_is_payload_size_valid( lr1_stack_mac_t* lr1_mac, uint8_t dr, uint8_t size,
@@ -1536,397 +1012,103 @@ status_lorawan_t smtc_real_is_payload_size_valid( lr1_stack_mac_t* lr1_mac, uint
 
 void smtc_real_set_tx_frequency_channel( lr1_stack_mac_t* lr1_mac, uint32_t tx_freq, uint8_t channel_index )
 {
-    switch( lr1_mac->real->region_type )
-    {
-#if defined( REGION_WW2G4 )
-    case SMTC_REAL_REGION_WW2G4:
-#endif
-#if defined( REGION_EU_868 )
-    case SMTC_REAL_REGION_EU_868:
-#endif
-#if defined( REGION_AS_923 )
-    case SMTC_REAL_REGION_AS_923:
-    case SMTC_REAL_REGION_AS_923_GRP2:
-    case SMTC_REAL_REGION_AS_923_GRP3:
-#if defined( RP2_103 )
-    case SMTC_REAL_REGION_AS_923_GRP4:
-#endif
-#endif
-#if defined( REGION_IN_865 )
-    case SMTC_REAL_REGION_IN_865:
-#endif
-#if defined( REGION_KR_920 )
-    case SMTC_REAL_REGION_KR_920:
-#endif
-#if defined( REGION_RU_864 )
-    case SMTC_REAL_REGION_RU_864:
-#endif
-#if defined( REGION_WW2G4 ) || defined( REGION_EU_868 ) || defined( REGION_AS_923 ) || defined( REGION_IN_865 ) || \
-    defined( REGION_KR_920 ) || defined( REGION_RU_864 )
-        if( channel_index >= const_number_of_tx_channel )
-        {
-            smtc_modem_hal_lr1mac_panic( );
-        }
-        else
-        {
-            tx_frequency_channel_ctx[channel_index] = tx_freq;
-        }
-        break;
-#endif
-#if defined( REGION_CN_470 )
-    case SMTC_REAL_REGION_CN_470:
-#endif
-#if defined( REGION_CN_470_RP_1_0 )
-    case SMTC_REAL_REGION_CN_470_RP_1_0:
-#endif
-#if defined( REGION_US_915 )
-    case SMTC_REAL_REGION_US_915:
-#endif
-#if defined( REGION_AU_915 )
-    case SMTC_REAL_REGION_AU_915:
-#endif
-#if defined( REGION_CN_470 ) || defined( REGION_CN_470_RP_1_0 ) || defined( REGION_US_915 ) || defined( REGION_AU_915 )
+    if( region_ops->is_dynamic_channel_plan == false )
     {
         // Not supported
-        break;
+        return;
     }
-#endif
-    default:
+    if( channel_index >= const_number_of_tx_channel )
+    {
         smtc_modem_hal_lr1mac_panic( );
-        break;
+    }
+    else
+    {
+        tx_frequency_channel_ctx[channel_index] = tx_freq;
     }
 }
 
 status_lorawan_t smtc_real_set_rx1_frequency_channel( lr1_stack_mac_t* lr1_mac, uint32_t rx_freq,
                                                       uint8_t channel_index )
 {
-    switch( lr1_mac->real->region_type )
-    {
-#if defined( REGION_WW2G4 )
-    case SMTC_REAL_REGION_WW2G4:
-#endif
-#if defined( REGION_EU_868 )
-    case SMTC_REAL_REGION_EU_868:
-#endif
-#if defined( REGION_AS_923 )
-    case SMTC_REAL_REGION_AS_923:
-    case SMTC_REAL_REGION_AS_923_GRP2:
-    case SMTC_REAL_REGION_AS_923_GRP3:
-#if defined( RP2_103 )
-    case SMTC_REAL_REGION_AS_923_GRP4:
-#endif
-#endif
-#if defined( REGION_IN_865 )
-    case SMTC_REAL_REGION_IN_865:
-#endif
-#if defined( REGION_KR_920 )
-    case SMTC_REAL_REGION_KR_920:
-#endif
-#if defined( REGION_RU_864 )
-    case SMTC_REAL_REGION_RU_864:
-#endif
-#if defined( REGION_WW2G4 ) || defined( REGION_EU_868 ) || defined( REGION_AS_923 ) || defined( REGION_IN_865 ) || \
-    defined( REGION_KR_920 ) || defined( REGION_RU_864 )
-        if( channel_index >= const_number_of_rx_channel )
-        {
-            smtc_modem_hal_lr1mac_panic( );
-        }
-        else
-        {
-            rx1_frequency_channel_ctx[channel_index] = rx_freq;
-        }
-        return OKLORAWAN;
-        break;
-#endif
-#if defined( REGION_CN_470 )
-    case SMTC_REAL_REGION_CN_470:
-#endif
-#if defined( REGION_CN_470_RP_1_0 )
-    case SMTC_REAL_REGION_CN_470_RP_1_0:
-#endif
-#if defined( REGION_US_915 )
-    case SMTC_REAL_REGION_US_915:
-#endif
-#if defined( REGION_AU_915 )
-    case SMTC_REAL_REGION_AU_915:
-#endif
-#if defined( REGION_CN_470 ) || defined( REGION_CN_470_RP_1_0 ) || defined( REGION_US_915 ) || defined( REGION_AU_915 )
+    if( region_ops->is_dynamic_channel_plan == false )
     {
         // Not supported
         return ERRORLORAWAN;
-        break;
     }
-#endif
-    default:
+    if( channel_index >= const_number_of_rx_channel )
+    {
         smtc_modem_hal_lr1mac_panic( );
-        break;
     }
-    return ERRORLORAWAN;  // never reach => avoid warning
-}
-
-void smtc_real_set_channel_dr( lr1_stack_mac_t* lr1_mac, uint8_t channel_index, uint8_t dr_min, uint8_t dr_max )
-{
-    switch( lr1_mac->real->region_type )
-    {
-#if defined( REGION_WW2G4 )
-    case SMTC_REAL_REGION_WW2G4:
-#endif
-#if defined( REGION_EU_868 )
-    case SMTC_REAL_REGION_EU_868:
-#endif
-#if defined( REGION_AS_923 )
-    case SMTC_REAL_REGION_AS_923:
-    case SMTC_REAL_REGION_AS_923_GRP2:
-    case SMTC_REAL_REGION_AS_923_GRP3:
-#if defined( RP2_103 )
-    case SMTC_REAL_REGION_AS_923_GRP4:
-#endif
-#endif
-#if defined( REGION_IN_865 )
-    case SMTC_REAL_REGION_IN_865:
-#endif
-#if defined( REGION_KR_920 )
-    case SMTC_REAL_REGION_KR_920:
-#endif
-#if defined( REGION_RU_864 )
-    case SMTC_REAL_REGION_RU_864:
-#endif
-#if defined( REGION_WW2G4 ) || defined( REGION_EU_868 ) || defined( REGION_AS_923 ) || defined( REGION_IN_865 ) || \
-    defined( REGION_KR_920 ) || defined( REGION_RU_864 )
-        if( channel_index >= const_number_of_tx_channel )
-        {
-            smtc_modem_hal_lr1mac_panic( );
-        }
-        else
-        {
-            dr_bitfield_tx_channel_ctx[channel_index] = 0;
-            for( uint8_t i = dr_min; i <= dr_max; i++ )
-            {
-                uint8_t tmp_dr = SMTC_GET_BIT16( &const_dr_bitfield, i );
-                SMTC_PUT_BIT16( &dr_bitfield_tx_channel_ctx[channel_index], i, tmp_dr );
-            }
-        }
-        break;
-#endif
-#if defined( REGION_CN_470 )
-    case SMTC_REAL_REGION_CN_470:
-#endif
-#if defined( REGION_CN_470_RP_1_0 )
-    case SMTC_REAL_REGION_CN_470_RP_1_0:
-#endif
-#if defined( REGION_US_915 )
-    case SMTC_REAL_REGION_US_915:
-#endif
-#if defined( REGION_AU_915 )
-    case SMTC_REAL_REGION_AU_915:
-#endif
-#if defined( REGION_CN_470 ) || defined( REGION_CN_470_RP_1_0 ) || defined( REGION_US_915 ) || defined( REGION_AU_915 )
+    else
     {
-        // Not supported
-        break;
-    }
-#endif
-    default:
-        smtc_modem_hal_lr1mac_panic( );
-        break;
+        rx1_frequency_channel_ctx[channel_index] = rx_freq;
     }
+    return OKLORAWAN;
 }
 
-void smtc_real_set_channel_enabled( lr1_stack_mac_t* lr1_mac, uint8_t enable, uint8_t channel_index )
+void smtc_real_set_channel_dr( lr1_stack_mac_t* lr1_mac, uint8_t channel_index, uint8_t dr_min, uint8_t dr_max )
 {
-    switch( lr1_mac->real->region_type )
-    {
-#if defined( REGION_WW2G4 )
-    case SMTC_REAL_REGION_WW2G4:
-#endif
-#if defined( REGION_EU_868 )
-    case SMTC_REAL_REGION_EU_868:
-#endif
-#if defined( REGION_AS_923 )
-    case SMTC_REAL_REGION_AS_923:
-    case SMTC_REAL_REGION_AS_923_GRP2:
-    case SMTC_REAL_REGION_AS_923_GRP3:
-#if defined( RP2_103 )
-    case SMTC_REAL_REGION_AS_923_GRP4:
-#endif
-#endif
-#if defined( REGION_IN_865 )
-    case SMTC_REAL_REGION_IN_865:
-#endif
-#if defined( REGION_KR_920 )
-    case SMTC_REAL_REGION_KR_920:
-#endif
-#if defined( REGION_RU_864 )
-    case SMTC_REAL_REGION_RU_864:
-#endif
-#if defined( REGION_WW2G4 ) || defined( REGION_EU_868 ) || defined( REGION_AS_923 ) || defined( REGION_IN_865 ) || \
-    defined( REGION_KR_920 ) || defined( REGION_RU_864 )
-        if( channel_index >= const_number_of_tx_channel )
-        {
-            smtc_modem_hal_lr1mac_panic( );
-        }
-        else
-        {
-            SMTC_PUT_BIT8( channel_index_enabled_ctx, channel_index, enable );
-        }
-        break;
-#endif
-#if defined( REGION_CN_470 )
-    case SMTC_REAL_REGION_CN_470:
-#endif
-#if defined( REGION_CN_470_RP_1_0 )
-    case SMTC_REAL_REGION_CN_470_RP_1_0:
-#endif
-#if defined( REGION_US_915 )
-    case SMTC_REAL_REGION_US_915:
-#endif
-#if defined( REGION_AU_915 )
-    case SMTC_REAL_REGION_AU_915:
-#endif
-#if defined( REGION_CN_470 ) || defined( REGION_CN_470_RP_1_0 ) || defined( REGION_US_915 ) || defined( REGION_AU_915 )
+    if( region_ops->is_dynamic_channel_plan == false )
     {
         // Not supported
-        break;
+        return;
     }
-#endif
-    default:
+    if( channel_index >= const_number_of_tx_channel )
+    {
         smtc_modem_hal_lr1mac_panic( );
-        break;
     }
-}
-
-uint32_t smtc_real_get_tx_channel_frequency( lr1_stack_mac_t* lr1_mac, uint8_t channel_index )
-{
-    switch( lr1_mac->real->region_type )
+    else
     {
-#if defined( REGION_WW2G4 )
-    case SMTC_REAL_REGION_WW2G4:
-#endif
-#if defined( REGION_EU_868 )
-    case SMTC_REAL_REGION_EU_868:
-#endif
-#if defined( REGION_AS_923 )
-    case SMTC_REAL_REGION_AS_923:
-    case SMTC_REAL_REGION_AS_923_GRP2:
-    case SMTC_REAL_REGION_AS_923_GRP3:
-#if defined( RP2_103 )
-    case SMTC_REAL_REGION_AS_923_GRP4:
-#endif
-#endif
-#if defined( REGION_IN_865 )
-    case SMTC_REAL_REGION_IN_865:
-#endif
-#if defined( REGION_KR_920 )
-    case SMTC_REAL_REGION_KR_920:
-#endif
-#if defined( REGION_RU_864 )
-    case SMTC_REAL_REGION_RU_864:
-#endif
-#if defined( REGION_WW2G4 ) || defined( REGION_EU_868 ) || defined( REGION_AS_923 ) || defined( REGION_IN_865 ) || \
-    defined( REGION_KR_920 ) || defined( REGION_RU_864 )
-        if( channel_index >= const_number_of_tx_channel )
+        dr_bitfield_tx_channel_nwk_ctx[channel_index] = 0;
+        for( uint8_t i = dr_min; i <= dr_max; i++ )
         {
-            smtc_modem_hal_lr1mac_panic( );
+            uint8_t tmp_dr = SMTC_GET_BIT16( &const_dr_bitfield, i );
+            SMTC_PUT_BIT16( &dr_bitfield_tx_channel_nwk_ctx[channel_index], i, tmp_dr );
         }
-        return ( tx_frequency_channel_ctx[channel_index] );
-        break;
-#endif
-#if defined( REGION_CN_470 )
-    case SMTC_REAL_REGION_CN_470: {
-        return region_cn_470_get_tx_frequency_channel( lr1_mac, channel_index );
-        break;
     }
-#endif
-#if defined( REGION_CN_470_RP_1_0 )
-    case SMTC_REAL_REGION_CN_470_RP_1_0: {
-        return region_cn_470_rp_1_0_get_tx_frequency_channel( lr1_mac, channel_index );
-        break;
+}
+
+void smtc_real_set_channel_enabled( lr1_stack_mac_t* lr1_mac, uint8_t enable, uint8_t channel_index )
+{
+    if( region_ops->is_dynamic_channel_plan == false )
+    {
+        // Not supported
+        return;
     }
-#endif
-#if defined( REGION_US_915 )
-    case SMTC_REAL_REGION_US_915: {
-        return region_us_915_get_tx_frequency_channel( lr1_mac, channel_index );
-        break;
+    if( channel_index >= const_number_of_tx_channel )
+    {
+        smtc_modem_hal_lr1mac_panic( );
     }
-#endif
-#if defined( REGION_AU_915 )
-    case SMTC_REAL_REGION_AU_915: {
-        return region_au_915_get_tx_frequency_channel( lr1_mac, channel_index );
-        break;
+    else
+    {
+        SMTC_PUT_BIT8( channel_index_enabled_ctx, channel_index, enable );
     }
-#endif
-    default:
+}
+
+uint32_t smtc_real_get_tx_channel_frequency( lr1_stack_mac_t* lr1_mac, uint8_t channel_index )
+{
+    if( region_ops->get_tx_channel_frequency != NULL )
+    {
+        return region_ops->get_tx_channel_frequency( lr1_mac, channel_index );
+    }
+    if( channel_index >= const_number_of_tx_channel )
+    {
         smtc_modem_hal_lr1mac_panic( );
-        break;
     }
-    return ERRORLORAWAN;  // never reach => avoid warning
+    return ( tx_frequency_channel_ctx[channel_index] );
 }
 
 uint32_t smtc_real_get_rx1_channel_frequency( lr1_stack_mac_t* lr1_mac, uint8_t channel_index )
 {
-    switch( lr1_mac->real->region_type )
+    if( region_ops->get_rx1_channel_frequency != NULL )
     {
-#if defined( REGION_WW2G4 )
-    case SMTC_REAL_REGION_WW2G4:
-#endif
-#if defined( REGION_EU_868 )
-    case SMTC_REAL_REGION_EU_868:
-#endif
-#if defined( REGION_AS_923 )
-    case SMTC_REAL_REGION_AS_923:
-    case SMTC_REAL_REGION_AS_923_GRP2:
-    case SMTC_REAL_REGION_AS_923_GRP3:
-#if defined( RP2_103 )
-    case SMTC_REAL_REGION_AS_923_GRP4:
-#endif
-#endif
-#if defined( REGION_IN_865 )
-    case SMTC_REAL_REGION_IN_865:
-#endif
-#if defined( REGION_KR_920 )
-    case SMTC_REAL_REGION_KR_920:
-#endif
-#if defined( REGION_RU_864 )
-    case SMTC_REAL_REGION_RU_864:
-#endif
-#if defined( REGION_WW2G4 ) || defined( REGION_EU_868 ) || defined( REGION_AS_923 ) || defined( REGION_IN_865 ) || \
-    defined( REGION_KR_920 ) || defined( REGION_RU_864 )
-        if( channel_index >= const_number_of_rx_channel )
-        {
-            smtc_modem_hal_lr1mac_panic( );
-        }
-        return ( rx1_frequency_channel_ctx[channel_index] );
-        break;
-#endif
-#if defined( REGION_CN_470 )
-    case SMTC_REAL_REGION_CN_470: {
-        return region_cn_470_get_rx1_frequency_channel( lr1_mac, channel_index );
-        break;
-    }
-#endif
-#if defined( REGION_CN_470_RP_1_0 )
-    case SMTC_REAL_REGION_CN_470_RP_1_0: {
-        return region_cn_470_rp_1_0_get_rx1_frequency_channel( lr1_mac, channel_index );
-        break;
-    }
-#endif
-#if defined( REGION_US_915 )
-    case SMTC_REAL_REGION_US_915: {
-        return region_us_915_get_rx1_frequency_channel( lr1_mac, channel_index );
-        break;
+        return region_ops->get_rx1_channel_frequency( lr1_mac, channel_index );
     }
-#endif
-#if defined( REGION_AU_915 )
-    case SMTC_REAL_REGION_AU_915: {
-        return region_au_915_get_rx1_frequency_channel( lr1_mac, channel_index );
-        break;
-    }
-#endif
-    default:
+    if( channel_index >= const_number_of_rx_channel )
+    {
         smtc_modem_hal_lr1mac_panic( );
-        break;
     }
-    return ERRORLORAWAN;  // never reach => avoid warning
+    return ( rx1_frequency_channel_ctx[channel_index] );
 }
 
 uint8_t smtc_real_get_min_tx_channel_dr( lr1_stack_mac_t* lr1_mac )
@@ -1996,320 +1178,109 @@ uint16_t smtc_real_mask_tx_dr_channel( lr1_stack_mac_t* lr1_mac )
     }
 
     return dr_mask;
-}
-
-uint16_t smtc_real_mask_tx_dr_channel_up_dwell_time_check( lr1_stack_mac_t* lr1_mac )
-{
-    uint16_t dr_mask = smtc_real_mask_tx_dr_channel( lr1_mac );
-    if( lr1_mac->uplink_dwell_time == true )
-    {
-        for( uint8_t i = 0; i < const_min_tx_dr_limit; i++ )
-        {
-            SMTC_PUT_BIT16( &dr_mask, i, false );
-        }
-    }
-
-    return dr_mask;
-}
-
-uint8_t smtc_real_get_preamble_len( const lr1_stack_mac_t* lr1_mac, uint8_t sf )
-{
-    switch( lr1_mac->real->region_type )
-    {
-#if defined( REGION_WW2G4 )
-    case SMTC_REAL_REGION_WW2G4: {
-        if( ( sf == 5 ) || ( sf == 6 ) )
-        {
-            return 12;
-        }
-        else
-        {
-            return 8;
-        }
-        break;
-    }
-#endif
-    default:
-        return 8;
-        break;
-    }
-}
-
-status_lorawan_t smtc_real_is_channel_mask_for_mobile_mode( const lr1_stack_mac_t* lr1_mac )
-{
-    status_lorawan_t status        = ERRORLORAWAN;
-    uint8_t          min_mobile_dr = const_min_tx_dr;
-    uint8_t          max_mobile_dr = const_max_tx_dr;
-
-    // search min datarate init
-    for( int i = 0; i < const_number_of_tx_dr; i++ )
-    {
-        if( dr_distribution_init_ctx[i] > 0 )
-        {
-            min_mobile_dr = i;
-            break;
-        }
-    }
-    if( lr1_mac->uplink_dwell_time == true )
-    {
-        min_mobile_dr = MAX( min_mobile_dr, const_min_tx_dr_limit );
-    }
-
-    // search max datarate init
-    for( int i = const_number_of_tx_dr - 1; i <= 0; i-- )
-    {
-        if( dr_distribution_init_ctx[i] > 0 )
-        {
-            max_mobile_dr = i;
-            break;
-        }
-    }
-
-    for( int i = 0; i < const_number_of_tx_channel; i++ )
-    {
-        if( SMTC_GET_BIT8( unwrapped_channel_mask_ctx, i ) == CHANNEL_ENABLED )
-        {
-            for( uint8_t dr = const_min_tx_dr; dr <= const_max_tx_dr; dr++ )
-            {
-                if( SMTC_GET_BIT16( &dr_bitfield_tx_channel_ctx[i], dr ) == 1 )
-                {
-                    if( ( dr >= min_mobile_dr ) && ( dr <= max_mobile_dr ) )
-                    {
-                        return ( OKLORAWAN );
-                    }
-                }
-            }
-        }
-    }
-    SMTC_MODEM_HAL_TRACE_WARNING( "Not acceptable data rate in mobile mode\n" );
-    return ( status );
-}
-
-modulation_type_t smtc_real_get_modulation_type_from_datarate( lr1_stack_mac_t* lr1_mac, uint8_t datarate )
-{
-    switch( lr1_mac->real->region_type )
-    {
-#if defined( REGION_WW2G4 )
-    case SMTC_REAL_REGION_WW2G4: {
-        return region_ww2g4_get_modulation_type_from_datarate( datarate );
-        break;
-    }
-#endif
-#if defined( REGION_EU_868 )
-    case SMTC_REAL_REGION_EU_868: {
-        return region_eu_868_get_modulation_type_from_datarate( datarate );
-        break;
-    }
-#endif
-#if defined( REGION_AS_923 )
-    case SMTC_REAL_REGION_AS_923:
-    case SMTC_REAL_REGION_AS_923_GRP2:
-    case SMTC_REAL_REGION_AS_923_GRP3:
-#if defined( RP2_103 )
-    case SMTC_REAL_REGION_AS_923_GRP4:
-#endif
-    {
-        return region_as_923_get_modulation_type_from_datarate( datarate );
-        break;
-    }
-#endif
-#if defined( REGION_US_915 )
-    case SMTC_REAL_REGION_US_915: {
-        return region_us_915_get_modulation_type_from_datarate( datarate );
-        break;
-    }
-#endif
-#if defined( REGION_AU_915 )
-    case SMTC_REAL_REGION_AU_915: {
-        return region_au_915_get_modulation_type_from_datarate( datarate );
-        break;
-    }
-#endif
-#if defined( REGION_CN_470 )
-    case SMTC_REAL_REGION_CN_470: {
-        return region_cn_470_get_modulation_type_from_datarate( datarate );
-        break;
-    }
-#endif
-#if defined( REGION_CN_470_RP_1_0 )
-    case SMTC_REAL_REGION_CN_470_RP_1_0: {
-        return region_cn_470_rp_1_0_get_modulation_type_from_datarate( datarate );
-        break;
-    }
-#endif
-#if defined( REGION_IN_865 )
-    case SMTC_REAL_REGION_IN_865: {
-        return region_in_865_get_modulation_type_from_datarate( datarate );
-        break;
-    }
-#endif
-#if defined( REGION_KR_920 )
-    case SMTC_REAL_REGION_KR_920: {
-        return region_kr_920_get_modulation_type_from_datarate( datarate );
-        break;
-    }
-#endif
-#if defined( REGION_RU_864 )
-    case SMTC_REAL_REGION_RU_864: {
-        return region_ru_864_get_modulation_type_from_datarate( datarate );
-        break;
-    }
-#endif
-    default:
-        smtc_modem_hal_lr1mac_panic( );
-        break;
-    }
-    return 0;  // never reach => avoid warning
-}
-void smtc_real_lora_dr_to_sf_bw( lr1_stack_mac_t* lr1_mac, uint8_t in_dr, uint8_t* out_sf, lr1mac_bandwidth_t* out_bw )
-{
-    switch( lr1_mac->real->region_type )
-    {
-#if defined( REGION_WW2G4 )
-    case SMTC_REAL_REGION_WW2G4: {
-        region_ww2g4_lora_dr_to_sf_bw( in_dr, out_sf, out_bw );
-        break;
-    }
-#endif
-#if defined( REGION_EU_868 )
-    case SMTC_REAL_REGION_EU_868: {
-        region_eu_868_lora_dr_to_sf_bw( in_dr, out_sf, out_bw );
-        break;
-    }
-#endif
-#if defined( REGION_AS_923 )
-    case SMTC_REAL_REGION_AS_923:
-    case SMTC_REAL_REGION_AS_923_GRP2:
-    case SMTC_REAL_REGION_AS_923_GRP3:
-#if defined( RP2_103 )
-    case SMTC_REAL_REGION_AS_923_GRP4:
-#endif
-    {
-        region_as_923_lora_dr_to_sf_bw( in_dr, out_sf, out_bw );
-        break;
-    }
-#endif
-#if defined( REGION_US_915 )
-    case SMTC_REAL_REGION_US_915: {
-        region_us_915_lora_dr_to_sf_bw( in_dr, out_sf, out_bw );
-        break;
-    }
-#endif
-#if defined( REGION_AU_915 )
-    case SMTC_REAL_REGION_AU_915: {
-        region_au_915_lora_dr_to_sf_bw( in_dr, out_sf, out_bw );
-        break;
-    }
-#endif
-#if defined( REGION_CN_470 )
-    case SMTC_REAL_REGION_CN_470: {
-        region_cn_470_lora_dr_to_sf_bw( in_dr, out_sf, out_bw );
-        break;
-    }
-#endif
-#if defined( REGION_CN_470_RP_1_0 )
-    case SMTC_REAL_REGION_CN_470_RP_1_0: {
-        region_cn_470_rp_1_0_lora_dr_to_sf_bw( in_dr, out_sf, out_bw );
-        break;
-    }
-#endif
-#if defined( REGION_IN_865 )
-    case SMTC_REAL_REGION_IN_865: {
-        region_in_865_lora_dr_to_sf_bw( in_dr, out_sf, out_bw );
-        break;
-    }
-#endif
-#if defined( REGION_KR_920 )
-    case SMTC_REAL_REGION_KR_920: {
-        region_kr_920_lora_dr_to_sf_bw( in_dr, out_sf, out_bw );
-        break;
-    }
-#endif
-#if defined( REGION_RU_864 )
-    case SMTC_REAL_REGION_RU_864: {
-        region_ru_864_lora_dr_to_sf_bw( in_dr, out_sf, out_bw );
-        break;
-    }
-#endif
-    default:
-        smtc_modem_hal_lr1mac_panic( );
-        break;
+}
+
+uint16_t smtc_real_mask_tx_dr_channel_up_dwell_time_check( lr1_stack_mac_t* lr1_mac )
+{
+    uint16_t dr_mask = smtc_real_mask_tx_dr_channel( lr1_mac );
+    if( lr1_mac->uplink_dwell_time == true )
+    {
+        for( uint8_t i = 0; i < const_min_tx_dr_limit; i++ )
+        {
+            SMTC_PUT_BIT16( &dr_mask, i, false );
+        }
     }
+
+    return dr_mask;
 }
 
-void smtc_real_fsk_dr_to_bitrate( lr1_stack_mac_t* lr1_mac, uint8_t in_dr, uint8_t* out_bitrate )
+uint8_t smtc_real_get_preamble_len( const lr1_stack_mac_t* lr1_mac, uint8_t sf )
 {
-    switch( lr1_mac->real->region_type )
+    if( region_ops->get_preamble_len != NULL )
     {
-#if defined( REGION_EU_868 )
-    case SMTC_REAL_REGION_EU_868: {
-        region_eu_868_fsk_dr_to_bitrate( in_dr, out_bitrate );
-        break;
+        return region_ops->get_preamble_len( sf );
     }
-#endif
-#if defined( REGION_AS_923 )
-    case SMTC_REAL_REGION_AS_923:
-    case SMTC_REAL_REGION_AS_923_GRP2:
-    case SMTC_REAL_REGION_AS_923_GRP3:
-#if defined( RP2_103 )
-    case SMTC_REAL_REGION_AS_923_GRP4:
-#endif
+    return 8;
+}
+
+status_lorawan_t smtc_real_is_channel_mask_for_mobile_mode( const lr1_stack_mac_t* lr1_mac )
+{
+    status_lorawan_t status        = ERRORLORAWAN;
+    uint8_t          min_mobile_dr = const_min_tx_dr;
+    uint8_t          max_mobile_dr = const_max_tx_dr;
+
+    // search min datarate init
+    for( int i = 0; i < const_number_of_tx_dr; i++ )
     {
-        region_as_923_fsk_dr_to_bitrate( in_dr, out_bitrate );
-        break;
+        if( dr_distribution_init_ctx[i] > 0 )
+        {
+            min_mobile_dr = i;
+            break;
+        }
     }
-#endif
-#if defined( REGION_CN_470 )
-    case SMTC_REAL_REGION_CN_470: {
-        region_cn_470_fsk_dr_to_bitrate( in_dr, out_bitrate );
-        break;
+    if( lr1_mac->uplink_dwell_time == true )
+    {
+        min_mobile_dr = MAX( min_mobile_dr, const_min_tx_dr_limit );
     }
-#endif
-#if defined( REGION_IN_865 )
-    case SMTC_REAL_REGION_IN_865: {
-        region_in_865_fsk_dr_to_bitrate( in_dr, out_bitrate );
-        break;
+
+    // search max datarate init
+    for( int i = const_number_of_tx_dr - 1; i <= 0; i-- )
+    {
+        if( dr_distribution_init_ctx[i] > 0 )
+        {
+            max_mobile_dr = i;
+            break;
+        }
     }
-#endif
-#if defined( REGION_RU_864 )
-    case SMTC_REAL_REGION_RU_864: {
-        region_ru_864_fsk_dr_to_bitrate( in_dr, out_bitrate );
-        break;
+
+    for( int i = 0; i < const_number_of_tx_channel; i++ )
+    {
+        if( SMTC_GET_BIT8( unwrapped_channel_mask_ctx, i ) == CHANNEL_ENABLED )
+        {
+            for( uint8_t dr = const_min_tx_dr; dr <= const_max_tx_dr; dr++ )
+            {
+                if( SMTC_GET_BIT16( &dr_bitfield_tx_channel_ctx[i], dr ) == 1 )
+                {
+                    if( ( dr >= min_mobile_dr ) && ( dr <= max_mobile_dr ) )
+                    {
+                        return ( OKLORAWAN );
+                    }
+                }
+            }
+        }
     }
-#endif
-    default:
+    SMTC_MODEM_HAL_TRACE_WARNING( "Not acceptable data rate in mobile mode\n" );
+    return ( status );
+}
+
+modulation_type_t smtc_real_get_modulation_type_from_datarate( lr1_stack_mac_t* lr1_mac, uint8_t datarate )
+{
+    return region_ops->get_modulation_type_from_datarate( datarate );
+}
+void smtc_real_lora_dr_to_sf_bw( lr1_stack_mac_t* lr1_mac, uint8_t in_dr, uint8_t* out_sf, lr1mac_bandwidth_t* out_bw )
+{
+    region_ops->lora_dr_to_sf_bw( in_dr, out_sf, out_bw );
+}
+
+void smtc_real_fsk_dr_to_bitrate( lr1_stack_mac_t* lr1_mac, uint8_t in_dr, uint8_t* out_bitrate )
+{
+    if( region_ops->fsk_dr_to_bitrate == NULL )
+    {
         smtc_modem_hal_lr1mac_panic( );
-        break;
+        return;
     }
+    region_ops->fsk_dr_to_bitrate( in_dr, out_bitrate );
 }
 
 void smtc_real_lr_fhss_dr_to_cr_bw( lr1_stack_mac_t* lr1_mac, uint8_t in_dr, lr_fhss_v1_cr_t* out_cr,
                                     lr_fhss_v1_bw_t* out_bw )
 {
-    switch( lr1_mac->real->region_type )
+    if( region_ops->lr_fhss_dr_to_cr_bw == NULL )
     {
-#if defined( REGION_EU_868 )
-    case SMTC_REAL_REGION_EU_868: {
-        region_eu_868_lr_fhss_dr_to_cr_bw( in_dr, out_cr, out_bw );
-        break;
-    }
-#endif
-#if defined( REGION_US_915 )
-    case SMTC_REAL_REGION_US_915: {
-        region_us_915_lr_fhss_dr_to_cr_bw( in_dr, out_cr, out_bw );
-        break;
-    }
-#endif
-#if defined( REGION_AU_915 )
-    case SMTC_REAL_REGION_AU_915: {
-        region_au_915_lr_fhss_dr_to_cr_bw( in_dr, out_cr, out_bw );
-        break;
-    }
-#endif
-    default:
         smtc_modem_hal_lr1mac_panic( );
-        break;
+        return;
     }
+    region_ops->lr_fhss_dr_to_cr_bw( in_dr, out_cr, out_bw );
 }
 
 lr_fhss_hc_t smtc_real_lr_fhss_get_header_count( lr_fhss_v1_cr_t in_cr )
@@ -2329,31 +1300,11 @@ lr_fhss_hc_t smtc_real_lr_fhss_get_header_count( lr_fhss_v1_cr_t in_cr )
 
 lr_fhss_v1_grid_t smtc_real_lr_fhss_get_grid( lr1_stack_mac_t* lr1_mac )
 {
-    switch( lr1_mac->real->region_type )
-    {
-#if defined( REGION_EU_868 )
-    case SMTC_REAL_REGION_EU_868: {
-        return LR_FHSS_V1_GRID_3906_HZ;
-        break;
-    }
-#endif
-#if defined( REGION_US_915 )
-    case SMTC_REAL_REGION_US_915:
-#endif
-#if defined( REGION_AU_915 )
-    case SMTC_REAL_REGION_AU_915:
-#endif
-#if defined( REGION_US_915 ) || defined( REGION_AU_915 )
+    if( region_ops->lr_fhss_dr_to_cr_bw == NULL )
     {
-        return LR_FHSS_V1_GRID_25391_HZ;
-        break;
-    }
-#endif
-    default:
         smtc_modem_hal_lr1mac_panic( );
-        break;
     }
-    return -1;  // never reach => avoid warning
+    return region_ops->lr_fhss_grid;
 }
 
 uint8_t smtc_real_get_number_of_enabled_channels_for_a_datarate( lr1_stack_mac_t* lr1_mac, uint8_t datarate )
@@ -2376,79 +1327,11 @@ uint8_t smtc_real_get_number_of_enabled_channels_for_a_datarate( lr1_stack_mac_t
 int8_t smtc_real_clamp_output_power_eirp_vs_freq_and_dr( lr1_stack_mac_t* lr1_mac, int8_t tx_power,
                                                          uint32_t tx_frequency, uint8_t datarate )
 {
-    switch( lr1_mac->real->region_type )
-    {
-#if defined( REGION_WW2G4 )
-    case SMTC_REAL_REGION_WW2G4:
-#endif
-#if defined( REGION_EU_868 )
-    case SMTC_REAL_REGION_EU_868:
-#endif
-#if defined( REGION_AS_923 )
-    case SMTC_REAL_REGION_AS_923:
-    case SMTC_REAL_REGION_AS_923_GRP2:
-    case SMTC_REAL_REGION_AS_923_GRP3:
-#if defined( RP2_103 )
-    case SMTC_REAL_REGION_AS_923_GRP4:
-#endif
-#endif
-#if defined( REGION_AU_915 )
-    case SMTC_REAL_REGION_AU_915:
-#endif
-#if defined( REGION_CN_470 )
-    case SMTC_REAL_REGION_CN_470:
-#endif
-#if defined( REGION_CN_470_RP_1_0 )
-    case SMTC_REAL_REGION_CN_470_RP_1_0:
-#endif
-#if defined( REGION_IN_865 )
-    case SMTC_REAL_REGION_IN_865:
-#endif
-#if defined( REGION_RU_864 )
-    case SMTC_REAL_REGION_RU_864:
-#endif
-#if defined( REGION_WW2G4 ) || defined( REGION_EU_868 ) || defined( REGION_AS_923 ) || defined( REGION_AU_915 ) || \
-    defined( REGION_CN_470 ) || defined( REGION_CN_470_RP_1_0 ) || defined( REGION_IN_865 ) ||                     \
-    defined( REGION_RU_864 )
+    if( region_ops->clamp_output_power_eirp_vs_freq_and_dr != NULL )
     {
-        return tx_power;
-        break;
-    }
-#endif
-
-#if defined( REGION_US_915 )
-    case SMTC_REAL_REGION_US_915: {
-        if( datarate == DR4 )
-        {
-            return MIN( tx_power, 26 );
-        }
-        else if( smtc_real_get_number_of_enabled_channels_for_a_datarate( lr1_mac, datarate ) < 50 )
-        {
-            return MIN( tx_power, 21 );
-        }
-        return tx_power;
-        break;
-    }
-#endif
-
-#if defined( REGION_KR_920 )
-    case SMTC_REAL_REGION_KR_920: {
-        if( tx_frequency < 922000000 )
-        {
-            return MIN( tx_power, 10 );  // if freq < 922MHz, Max output power is limited to 10 dBm
-        }
-        else
-        {
-            return MIN( tx_power, TX_POWER_EIRP_KR_920 );  // else Max output power is limited to 14 dBm
-        }
-        break;
+        return region_ops->clamp_output_power_eirp_vs_freq_and_dr( lr1_mac, tx_power, tx_frequency, datarate );
     }
-#endif
-    default:
-        smtc_modem_hal_lr1mac_panic( );
-        break;
-    }
-    return 0;  // never reach => avoid warning
+    return tx_power;
 }
 
 uint8_t smtc_real_get_current_enabled_frequency_list( lr1_stack_mac_t* lr1_mac, uint8_t* number_of_freq,
@@ -2470,6 +1353,32 @@ uint8_t smtc_real_get_current_enabled_frequency_list( lr1_stack_mac_t* lr1_mac,
     return true;
 }
 
+uint8_t smtc_real_get_tx_channel_list( lr1_stack_mac_t* lr1_mac, uint8_t datarate, uint32_t* tx_frequency,
+                                       uint32_t* rx1_frequency, uint8_t max_size )
+{
+    uint8_t nb    = 0;
+    uint8_t start = smtc_modem_hal_get_random_nb_in_range( 0, const_number_of_tx_channel - 1 );
+
+    for( uint8_t n = 0; ( n < const_number_of_tx_channel ) && ( nb < max_size ); n++ )
+    {
+        uint8_t i = ( start + n ) % const_number_of_tx_channel;
+
+        if( ( SMTC_GET_BIT8( channel_index_enabled_ctx, i ) == CHANNEL_ENABLED ) &&
+            ( SMTC_GET_BIT16( &dr_bitfield_tx_channel_ctx[i], datarate ) == 1 ) )
+        {
+            uint32_t freq = smtc_real_get_tx_channel_frequency( lr1_mac, i );
+
+            if( ( freq != 0 ) && ( smtc_duty_cycle_is_channel_free( lr1_mac->dtc_obj, freq ) == true ) )
+            {
+                tx_frequency[nb]  = freq;
+                rx1_frequency[nb] = smtc_real_get_rx1_channel_frequency( lr1_mac, i );
+                nb++;
+            }
+        }
+    }
+    return nb;
+}
+
 /*************************************************************************/
 /*                      Const init in region                             */
 /*************************************************************************/
@@ -2622,134 +1531,20 @@ uint8_t smtc_real_get_beacon_dr( lr1_stack_mac_t* lr1_mac )
 
 uint32_t smtc_real_get_beacon_frequency( lr1_stack_mac_t* lr1_mac, uint32_t gps_time_s )
 {
-    switch( lr1_mac->real->region_type )
-    {
-#if defined( REGION_WW2G4 )
-    case SMTC_REAL_REGION_WW2G4:
-#endif
-#if defined( REGION_EU_868 )
-    case SMTC_REAL_REGION_EU_868:
-#endif
-#if defined( REGION_AS_923 )
-    case SMTC_REAL_REGION_AS_923:
-    case SMTC_REAL_REGION_AS_923_GRP2:
-    case SMTC_REAL_REGION_AS_923_GRP3:
-#if defined( RP2_103 )
-    case SMTC_REAL_REGION_AS_923_GRP4:
-#endif
-#endif
-#if defined( REGION_IN_865 )
-    case SMTC_REAL_REGION_IN_865:
-#endif
-#if defined( REGION_RU_864 )
-    case SMTC_REAL_REGION_RU_864:
-#endif
-#if defined( REGION_KR_920 )
-    case SMTC_REAL_REGION_KR_920:
-#endif
-#if defined( REGION_WW2G4 ) || defined( REGION_EU_868 ) || defined( REGION_AS_923 ) || defined( REGION_IN_865 ) || \
-    defined( REGION_RU_864 ) || defined( SMTC_REAL_REGION_KR_920 )
+    if( region_ops->get_beacon_frequency != NULL )
     {
-        return const_beacon_frequency;
-        break;
-    }
-#endif
-
-#if defined( REGION_US_915 )
-    case SMTC_REAL_REGION_US_915: {
-        return region_us_915_get_rx_beacon_frequency_channel( lr1_mac, gps_time_s );
-        break;
-    }
-#endif
-#if defined( REGION_AU_915 )
-    case SMTC_REAL_REGION_AU_915: {
-        return region_au_915_get_rx_beacon_frequency_channel( lr1_mac, gps_time_s );
-        break;
-    }
-#endif
-#if defined( REGION_CN_470 )
-    case SMTC_REAL_REGION_CN_470: {
-        return region_cn_470_get_rx_beacon_frequency_channel( lr1_mac, gps_time_s );
-        break;
-    }
-#endif
-#if defined( REGION_CN_470_RP_1_0 )
-    case SMTC_REAL_REGION_CN_470_RP_1_0: {
-        return region_cn_470_rp_1_0_get_rx_beacon_frequency_channel( lr1_mac, gps_time_s );
-        break;
-    }
-#endif
-    default:
-        smtc_modem_hal_lr1mac_panic( );
-        break;
+        return region_ops->get_beacon_frequency( lr1_mac, gps_time_s );
     }
-    return 0;  // never reach => avoid warning
+    return const_beacon_frequency;
 }
 
 uint32_t smtc_real_get_ping_slot_frequency( lr1_stack_mac_t* lr1_mac, uint32_t gps_time_s, uint32_t dev_addr )
 {
-    switch( lr1_mac->real->region_type )
-    {
-#if defined( REGION_WW2G4 )
-    case SMTC_REAL_REGION_WW2G4:
-#endif
-#if defined( REGION_EU_868 )
-    case SMTC_REAL_REGION_EU_868:
-#endif
-#if defined( REGION_AS_923 )
-    case SMTC_REAL_REGION_AS_923:
-    case SMTC_REAL_REGION_AS_923_GRP2:
-    case SMTC_REAL_REGION_AS_923_GRP3:
-#if defined( RP2_103 )
-    case SMTC_REAL_REGION_AS_923_GRP4:
-#endif
-#endif
-#if defined( REGION_IN_865 )
-    case SMTC_REAL_REGION_IN_865:
-#endif
-#if defined( REGION_RU_864 )
-    case SMTC_REAL_REGION_RU_864:
-#endif
-#if defined( REGION_KR_920 )
-    case SMTC_REAL_REGION_KR_920:
-#endif
-#if defined( REGION_WW2G4 ) || defined( REGION_EU_868 ) || defined( REGION_AS_923 ) || defined( REGION_IN_865 ) || \
-    defined( REGION_RU_864 ) || defined( SMTC_REAL_REGION_KR_920 )
+    if( region_ops->get_ping_slot_frequency != NULL )
     {
-        return const_ping_slot_frequency;
-        break;
-    }
-#endif
-
-#if defined( REGION_US_915 )
-    case SMTC_REAL_REGION_US_915: {
-        return region_us_915_get_rx_ping_slot_frequency_channel( lr1_mac, gps_time_s, dev_addr );
-        break;
-    }
-#endif
-#if defined( REGION_AU_915 )
-    case SMTC_REAL_REGION_AU_915: {
-        return region_au_915_get_rx_ping_slot_frequency_channel( lr1_mac, gps_time_s, dev_addr );
-        break;
-    }
-#endif
-#if defined( REGION_CN_470 )
-    case SMTC_REAL_REGION_CN_470: {
-        return region_cn_470_get_rx_ping_slot_frequency_channel( lr1_mac, gps_time_s, dev_addr );
-        break;
-    }
-#endif
-#if defined( REGION_CN_470_RP_1_0 )
-    case SMTC_REAL_REGION_CN_470_RP_1_0: {
-        return region_cn_470_rp_1_0_get_rx_ping_slot_frequency_channel( lr1_mac, gps_time_s, dev_addr );
-        break;
-    }
-#endif
-    default:
-        smtc_modem_hal_lr1mac_panic( );
-        break;
+        return region_ops->get_ping_slot_frequency( lr1_mac, gps_time_s, dev_addr );
     }
-    return 0;  // never reach => avoid warning
+    return const_ping_slot_frequency;
 }
 
 uint8_t smtc_real_get_ping_slot_datarate( lr1_stack_mac_t* lr1_mac )
@@ -689,6 +689,22 @@ int8_t smtc_real_clamp_output_power_eirp_vs_freq_and_dr( lr1_stack_mac_t* lr1_ma
 uint8_t smtc_real_get_current_enabled_frequency_list( lr1_stack_mac_t* lr1_mac, uint8_t* number_of_freq,
                                                       uint32_t* freq_list, uint8_t max_size );
 
+/**
+ * @brief List the enabled Tx channels allowing a data rate and with duty cycle budget left
+ *
+ * @remark Unlike smtc_real_get_next_channel(), the channel selection state (hopping snapshot, channel mask phase) is
+ *         left untouched. The list starts at a random channel so that the same channels are not always listed first.
+ *
+ * @param lr1_mac
+ * @param datarate                  Data rate the channels must allow
+ * @param tx_frequency              Tx frequencies of the channels listed
+ * @param rx1_frequency             Rx1 frequencies of the channels listed
+ * @param max_size                  Size of both lists
+ * @return uint8_t                  Number of channels listed
+ */
+uint8_t smtc_real_get_tx_channel_list( lr1_stack_mac_t* lr1_mac, uint8_t datarate, uint32_t* tx_frequency,
+                                       uint32_t* rx1_frequency, uint8_t max_size );
+
 /**
  * @brief
  *
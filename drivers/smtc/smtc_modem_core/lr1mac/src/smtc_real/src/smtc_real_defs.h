@@ -222,128 +222,130 @@ static const uint8_t smtc_real_max_eirp_dbm_from_idx[] = {
 
 typedef struct smtc_real_ctx_s
 {
-    uint32_t* tx_frequency_channel_ctx;
-    uint32_t* rx1_frequency_channel_ctx;
-    uint8_t*  channel_index_enabled_ctx;
-    uint8_t*  unwrapped_channel_mask_ctx;
-    uint8_t*  min_tx_dr_channel_ctx;
-    uint8_t*  max_tx_dr_channel_ctx;
-    uint16_t* dr_bitfield_tx_channel_ctx;
-    uint8_t*  dr_distribution_init_ctx;
-    uint8_t*  dr_distribution_ctx;
-    uint8_t   sync_word_ctx;
+    uint32_t*       tx_frequency_channel_ctx;
+    uint32_t*       rx1_frequency_channel_ctx;
+    uint8_t*        channel_index_enabled_ctx;
+    uint8_t*        unwrapped_channel_mask_ctx;
+    uint8_t*        min_tx_dr_channel_ctx;
+    uint8_t*        max_tx_dr_channel_ctx;
+    const uint16_t* dr_bitfield_tx_channel_ctx;      // Data rates of each Tx channel, a const table in fixed plans
+    uint16_t*       dr_bitfield_tx_channel_nwk_ctx;  // Same array when the network sets the data rates, else NULL
+    uint8_t*        dr_distribution_init_ctx;
+    uint8_t*        dr_distribution_ctx;
+    uint8_t         sync_word_ctx;
 } smtc_real_ctx_t;
 
 typedef struct smtc_real_const_s
 {
-    uint8_t         const_number_of_tx_channel;
-    uint8_t         const_number_of_rx_channel;
-    uint8_t         const_number_of_boot_tx_channel;
-    uint8_t         const_number_of_channel_bank;
-    uint8_t         const_join_accept_delay1;
-    uint8_t         const_received_delay1;
-    uint8_t         const_tx_power_dbm;
-    uint8_t         const_max_tx_power_idx;
-    uint8_t         const_adr_ack_limit;
-    uint8_t         const_adr_ack_delay;
-    const uint8_t*  const_datarate_backoff;
-    uint8_t         const_ack_timeout;
-    uint32_t        const_freq_min;
-    uint32_t        const_freq_max;
-    uint32_t        const_rx2_freq;
-    uint8_t         const_frequency_factor;
-    int32_t         const_frequency_offset_hz;
-    uint8_t         const_rx2_dr_init;
-    uint8_t         const_sync_word_private;
-    uint8_t         const_sync_word_public;
-    uint8_t*        const_sync_word_gfsk;
-    uint8_t*        const_sync_word_lr_fhss;
-    uint8_t         const_min_tx_dr;
-    uint8_t         const_min_tx_dr_limit;
-    uint8_t         const_min_rx_dr;
-    uint8_t         const_max_tx_dr;
-    uint8_t         const_max_rx_dr;
-    uint8_t         const_number_rx1_dr_offset;
-    uint16_t        const_dr_bitfield;
-    uint16_t        const_default_tx_dr_bit_field;
-    uint8_t         const_number_of_tx_dr;
-    bool            const_tx_param_setup_req_supported;
-    bool            const_new_channel_req_supported;
-    bool            const_dtc_supported;
-    bool            const_lbt_supported;
-    uint32_t        const_lbt_sniff_duration_ms;
-    int16_t         const_lbt_threshold_dbm;
-    uint32_t        const_lbt_bw_hz;
-    const uint8_t*  const_max_payload_m;
-    ral_lora_cr_t   const_coding_rate;
-    uint8_t         const_dtc_number_of_band;
-    const uint16_t* const_dtc_by_band;
-    const uint8_t*  const_mobile_longrange_dr_distri;
-    const uint8_t*  const_mobile_lowpower_dr_distri;
-    const uint8_t*  const_join_dr_distri;
-    const uint8_t*  const_default_dr_distri;
-    cf_list_type_t  const_cf_list_type_supported;
-    uint8_t         const_beacon_dr;
-    uint32_t        const_beacon_frequency;
-    uint32_t        const_ping_slot_frequency;
+    uint8_t         number_of_tx_channel;
+    uint8_t         number_of_rx_channel;
+    uint8_t         number_of_boot_tx_channel;
+    uint8_t         number_of_channel_bank;
+    uint8_t         join_accept_delay1;
+    uint8_t         received_delay1;
+    uint8_t         tx_power_dbm;
+    uint8_t         max_tx_power_idx;
+    uint8_t         adr_ack_limit;
+    uint8_t         adr_ack_delay;
+    const uint8_t*  datarate_backoff;
+    uint8_t         ack_timeout;
+    uint32_t        freq_min;
+    uint32_t        freq_max;
+    uint32_t        rx2_freq;
+    uint8_t         frequency_factor;
+    int32_t         frequency_offset_hz;
+    uint8_t         rx2_dr_init;
+    uint8_t         sync_word_private;
+    uint8_t         sync_word_public;
+    uint8_t*        sync_word_gfsk;
+    uint8_t*        sync_word_lr_fhss;
+    uint8_t         min_tx_dr;
+    uint8_t         min_tx_dr_limit;
+    uint8_t         min_rx_dr;
+    uint8_t         max_tx_dr;
+    uint8_t         max_rx_dr;
+    uint8_t         number_rx1_dr_offset;
+    uint16_t        dr_bitfield;
+    uint16_t        default_tx_dr_bit_field;
+    uint8_t         number_of_tx_dr;
+    bool            tx_param_setup_req_supported;
+    bool            new_channel_req_supported;
+    bool            dtc_supported;
+    bool            lbt_supported;
+    uint32_t        lbt_sniff_duration_ms;
+    int16_t         lbt_threshold_dbm;
+    uint32_t        lbt_bw_hz;
+    const uint8_t*  max_payload_m;
+    ral_lora_cr_t   coding_rate;
+    uint8_t         dtc_number_of_band;
+    const uint16_t* dtc_by_band;
+    const uint8_t*  mobile_longrange_dr_distri;
+    const uint8_t*  mobile_lowpower_dr_distri;
+    const uint8_t*  join_dr_distri;
+    const uint8_t*  default_dr_distri;
+    cf_list_type_t  cf_list_type_supported;
+    uint8_t         beacon_dr;
+    uint32_t        beacon_frequency;
+    uint32_t        ping_slot_frequency;
 } smtc_real_const_t;
 
-#define const_number_of_tx_channel lr1_mac->real->real_const.const_number_of_tx_channel
-#define const_number_of_rx_channel lr1_mac->real->real_const.const_number_of_rx_channel
-#define const_number_of_boot_tx_channel lr1_mac->real->real_const.const_number_of_boot_tx_channel
-#define const_number_of_channel_bank lr1_mac->real->real_const.const_number_of_channel_bank
-#define const_join_accept_delay1 lr1_mac->real->real_const.const_join_accept_delay1
-#define const_received_delay1 lr1_mac->real->real_const.const_received_delay1
-#define const_tx_power_dbm lr1_mac->real->real_const.const_tx_power_dbm
-#define const_max_tx_power_idx lr1_mac->real->real_const.const_max_tx_power_idx
-#define const_adr_ack_limit lr1_mac->real->real_const.const_adr_ack_limit
-#define const_adr_ack_delay lr1_mac->real->real_const.const_adr_ack_delay
-#define const_datarate_backoff lr1_mac->real->real_const.const_datarate_backoff
-#define const_ack_timeout lr1_mac->real->real_const.const_ack_timeout
-#define const_freq_min lr1_mac->real->real_const.const_freq_min
-#define const_freq_max lr1_mac->real->real_const.const_freq_max
-#define const_rx2_freq lr1_mac->real->real_const.const_rx2_freq
-#define const_frequency_factor lr1_mac->real->real_const.const_frequency_factor
-#define const_frequency_offset_hz lr1_mac->real->real_const.const_frequency_offset_hz
-#define const_rx2_dr_init lr1_mac->real->real_const.const_rx2_dr_init
-#define const_sync_word_public lr1_mac->real->real_const.const_sync_word_public
-#define const_sync_word_private lr1_mac->real->real_const.const_sync_word_private
-#define const_sync_word_gfsk lr1_mac->real->real_const.const_sync_word_gfsk
-#define const_sync_word_lr_fhss lr1_mac->real->real_const.const_sync_word_lr_fhss
-#define const_min_tx_dr lr1_mac->real->real_const.const_min_tx_dr
-#define const_min_tx_dr_limit lr1_mac->real->real_const.const_min_tx_dr_limit
-#define const_min_rx_dr lr1_mac->real->real_const.const_min_rx_dr
-#define const_max_tx_dr lr1_mac->real->real_const.const_max_tx_dr
-#define const_max_rx_dr lr1_mac->real->real_const.const_max_rx_dr
-#define const_dr_bitfield lr1_mac->real->real_const.const_dr_bitfield
-#define const_default_tx_dr_bit_field lr1_mac->real->real_const.const_default_tx_dr_bit_field
-#define const_number_of_tx_dr lr1_mac->real->real_const.const_number_of_tx_dr
-#define const_number_rx1_dr_offset lr1_mac->real->real_const.const_number_rx1_dr_offset
-#define const_tx_param_setup_req_supported lr1_mac->real->real_const.const_tx_param_setup_req_supported
-#define const_new_channel_req_supported lr1_mac->real->real_const.const_new_channel_req_supported
-#define const_dtc_supported lr1_mac->real->real_const.const_dtc_supported
-#define const_lbt_supported lr1_mac->real->real_const.const_lbt_supported
-#define const_lbt_sniff_duration_ms lr1_mac->real->real_const.const_lbt_sniff_duration_ms
-#define const_lbt_threshold_dbm lr1_mac->real->real_const.const_lbt_threshold_dbm
-#define const_lbt_bw_hz lr1_mac->real->real_const.const_lbt_bw_hz
-#define const_max_payload_m lr1_mac->real->real_const.const_max_payload_m
-#define const_coding_rate lr1_mac->real->real_const.const_coding_rate
-#define const_dtc_number_of_band lr1_mac->real->real_const.const_dtc_number_of_band
-#define const_dtc_by_band lr1_mac->real->real_const.const_dtc_by_band
-#define const_mobile_longrange_dr_distri lr1_mac->real->real_const.const_mobile_longrange_dr_distri
-#define const_mobile_lowpower_dr_distri lr1_mac->real->real_const.const_mobile_lowpower_dr_distri
-#define const_join_dr_distri lr1_mac->real->real_const.const_join_dr_distri
-#define const_default_dr_distri lr1_mac->real->real_const.const_default_dr_distri
-#define const_cf_list_type_supported lr1_mac->real->real_const.const_cf_list_type_supported
-#define const_beacon_dr lr1_mac->real->real_const.const_beacon_dr
-#define const_beacon_frequency lr1_mac->real->real_const.const_beacon_frequency
-#define const_ping_slot_frequency lr1_mac->real->real_const.const_ping_slot_frequency
+#define const_number_of_tx_channel lr1_mac->real->real_const->number_of_tx_channel
+#define const_number_of_rx_channel lr1_mac->real->real_const->number_of_rx_channel
+#define const_number_of_boot_tx_channel lr1_mac->real->real_const->number_of_boot_tx_channel
+#define const_number_of_channel_bank lr1_mac->real->real_const->number_of_channel_bank
+#define const_join_accept_delay1 lr1_mac->real->real_const->join_accept_delay1
+#define const_received_delay1 lr1_mac->real->real_const->received_delay1
+#define const_tx_power_dbm lr1_mac->real->real_const->tx_power_dbm
+#define const_max_tx_power_idx lr1_mac->real->real_const->max_tx_power_idx
+#define const_adr_ack_limit lr1_mac->real->real_const->adr_ack_limit
+#define const_adr_ack_delay lr1_mac->real->real_const->adr_ack_delay
+#define const_datarate_backoff lr1_mac->real->real_const->datarate_backoff
+#define const_ack_timeout lr1_mac->real->real_const->ack_timeout
+#define const_freq_min lr1_mac->real->real_const->freq_min
+#define const_freq_max lr1_mac->real->real_const->freq_max
+#define const_rx2_freq lr1_mac->real->real_const->rx2_freq
+#define const_frequency_factor lr1_mac->real->real_const->frequency_factor
+#define const_frequency_offset_hz lr1_mac->real->real_const->frequency_offset_hz
+#define const_rx2_dr_init lr1_mac->real->real_const->rx2_dr_init
+#define const_sync_word_public lr1_mac->real->real_const->sync_word_public
+#define const_sync_word_private lr1_mac->real->real_const->sync_word_private
+#define const_sync_word_gfsk lr1_mac->real->real_const->sync_word_gfsk
+#define const_sync_word_lr_fhss lr1_mac->real->real_const->sync_word_lr_fhss
+#define const_min_tx_dr lr1_mac->real->real_const->min_tx_dr
+#define const_min_tx_dr_limit lr1_mac->real->real_const->min_tx_dr_limit
+#define const_min_rx_dr lr1_mac->real->real_const->min_rx_dr
+#define const_max_tx_dr lr1_mac->real->real_const->max_tx_dr
+#define const_max_rx_dr lr1_mac->real->real_const->max_rx_dr
+#define const_dr_bitfield lr1_mac->real->real_const->dr_bitfield
+#define const_default_tx_dr_bit_field lr1_mac->real->real_const->default_tx_dr_bit_field
+#define const_number_of_tx_dr lr1_mac->real->real_const->number_of_tx_dr
+#define const_number_rx1_dr_offset lr1_mac->real->real_const->number_rx1_dr_offset
+#define const_tx_param_setup_req_supported lr1_mac->real->real_const->tx_param_setup_req_supported
+#define const_new_channel_req_supported lr1_mac->real->real_const->new_channel_req_supported
+#define const_dtc_supported lr1_mac->real->real_const->dtc_supported
+#define const_lbt_supported lr1_mac->real->real_const->lbt_supported
+#define const_lbt_sniff_duration_ms lr1_mac->real->real_const->lbt_sniff_duration_ms
+#define const_lbt_threshold_dbm lr1_mac->real->real_const->lbt_threshold_dbm
+#define const_lbt_bw_hz lr1_mac->real->real_const->lbt_bw_hz
+#define const_max_payload_m lr1_mac->real->real_const->max_payload_m
+#define const_coding_rate lr1_mac->real->real_const->coding_rate
+#define const_dtc_number_of_band lr1_mac->real->real_const->dtc_number_of_band
+#define const_dtc_by_band lr1_mac->real->real_const->dtc_by_band
+#define const_mobile_longrange_dr_distri lr1_mac->real->real_const->mobile_longrange_dr_distri
+#define const_mobile_lowpower_dr_distri lr1_mac->real->real_const->mobile_lowpower_dr_distri
+#define const_join_dr_distri lr1_mac->real->real_const->join_dr_distri
+#define const_default_dr_distri lr1_mac->real->real_const->default_dr_distri
+#define const_cf_list_type_supported lr1_mac->real->real_const->cf_list_type_supported
+#define const_beacon_dr lr1_mac->real->real_const->beacon_dr
+#define const_beacon_frequency lr1_mac->real->real_const->beacon_frequency
+#define const_ping_slot_frequency lr1_mac->real->real_const->ping_slot_frequency
 
 typedef struct smtc_real_s
 {
-    smtc_real_region_types_t region_type;
-    smtc_real_const_t        real_const;
-    smtc_real_ctx_t          real_ctx;
+    smtc_real_region_types_t             region_type;
+    const struct smtc_real_region_ops_s* region_ops;  // Bound by smtc_real_config() from region_type
+    const smtc_real_const_t*             real_const;  // Region constants in flash, bound by the region config
+    smtc_real_ctx_t                      real_ctx;
 
     union smtc_real_region_u
     {
@@ -152,6 +152,9 @@ smtc_modem_services_t smtc_modem_services_ctx;
 // LBT configuration status
 static bool lbt_config_available = false;
 
+// Downlinks are lent in place from the fifo instead of copied in the event
+static bool downlink_zero_copy = false;
+
 // user_radio_access
 static rp_status_t user_radio_irq_status;
 static uint32_t    user_radio_irq_timestamp;
@@ -196,6 +199,7 @@ struct
     bool        lbt_config_available;
     rp_status_t user_radio_irq_status;
     uint32_t    user_radio_irq_timestamp;
+    bool        downlink_zero_copy;
     uint16_t    spare;
 #if !defined( LR1110_MODEM_E )
     void ( *user_end_task_callback_0 )( smtc_modem_rp_status_t* status );
@@ -207,6 +211,7 @@ struct
 #define lbt_config_available smtc_modem_ctx.lbt_config_available
 #define user_radio_irq_status smtc_modem_ctx.user_radio_irq_status
 #define user_radio_irq_timestamp smtc_modem_ctx.user_radio_irq_timestamp
+#define downlink_zero_copy smtc_modem_ctx.downlink_zero_copy
 #define user_end_task_callback_0 smtc_modem_ctx.user_end_task_callback_0
 #define user_end_task_callback_1 smtc_modem_ctx.user_end_task_callback_1
 #define user_end_task_callback_2 smtc_modem_ctx.user_end_task_callback_2
@@ -226,6 +231,8 @@ static smtc_modem_return_code_t smtc_modem_set_dm_status_with_rate( const uint8_
 
 static bool is_modem_connected( );
 
+static void downlink_metadata_convert( const lr1mac_down_metadata_t* metadata, smtc_modem_downlink_t* downlink );
+
 static smtc_modem_return_code_t smtc_modem_send_empty_tx( uint8_t f_port, bool f_port_present, bool confirmed );
 
 static smtc_modem_return_code_t smtc_modem_send_tx( uint8_t f_port, bool confirmed, const uint8_t* payload,
@@ -296,7 +303,14 @@ void smtc_modem_init( const ralf_t* radio, void ( *callback_event )( void ) )
 
 uint32_t smtc_modem_run_engine( void )
 {
-    uint8_t nb_downlink = fifo_ctrl_get_nb_elt( lorawan_api_get_fifo_obj( ) );
+    fifo_ctrl_t* fifo_obj    = lorawan_api_get_fifo_obj( );
+    uint8_t      nb_downlink = fifo_ctrl_get_nb_elt( fifo_obj );
+
+    if( fifo_ctrl_is_borrowed( fifo_obj ) == true )
+    {
+        // The lent downlink was already reported
+        nb_downlink--;
+    }
 
     if( nb_downlink > 0 )
     {
@@ -317,11 +331,18 @@ smtc_modem_return_code_t smtc_modem_get_event( smtc_modem_event_t* event, uint8_
 
     smtc_modem_return_code_t return_code = SMTC_MODEM_RC_OK;
     const uint8_t            event_count = get_asynchronous_msgnumber( );
+    uint8_t                  nb_requeued = 0;  // further sessions of an upload event, read by the next calls
 
     if( event_count > MODEM_NUMBER_OF_EVENTS )
     {
         smtc_modem_hal_mcu_panic( "asynchronous_msgnumber overlap" );
     }
+    else if( ( event_count > 0 ) && ( get_last_msg_event( ) == SMTC_MODEM_EVENT_DOWNDATA ) &&
+             ( fifo_ctrl_is_borrowed( lorawan_api_get_fifo_obj( ) ) == true ) )
+    {
+        // The head of the fifo is still the lent downlink, the event is kept until smtc_modem_release_downlink
+        return_code = SMTC_MODEM_RC_BUSY;
+    }
     else if( event_count > 0 )
     {
         event->event_type    = get_last_msg_event( );
@@ -339,37 +360,57 @@ smtc_modem_return_code_t smtc_modem_get_event( smtc_modem_event_t* event, uint8_
         case SMTC_MODEM_EVENT_DOWNDATA: {
             lr1mac_down_metadata_t metadata;
             uint8_t                metadata_len;
+            smtc_modem_downlink_t  downlink;
 
-            fifo_ctrl_get( lorawan_api_get_fifo_obj( ), event->event_data.downdata.data,
-                           &( event->event_data.downdata.length ), SMTC_MODEM_MAX_DOWNLINK_LENGTH, &metadata,
-                           &metadata_len, sizeof( lr1mac_down_metadata_t ) );
-
-            if( ( metadata.rx_rssi >= -128 ) && ( metadata.rx_rssi <= 63 ) )
-            {
-                event->event_data.downdata.rssi = ( int8_t )( metadata.rx_rssi + 64 );
-            }
-            else if( metadata.rx_rssi > 63 )
+            // The modem certification handler consumes the downlinks through the events, they are always copied
+            if( ( downlink_zero_copy == true ) && ( lorawan_api_modem_certification_is_enabled( ) == false ) )
             {
-                event->event_data.downdata.rssi = 127;
+                // The payload stays in the fifo, see smtc_modem_get_downlink
+                fifo_ctrl_peek( lorawan_api_get_fifo_obj( ), &downlink.data, &( event->event_data.downdata.length ),
+                                &metadata, &metadata_len, sizeof( lr1mac_down_metadata_t ) );
             }
-            else if( metadata.rx_rssi < -128 )
+            else
             {
-                event->event_data.downdata.rssi = -128;
+                fifo_ctrl_get( lorawan_api_get_fifo_obj( ), event->event_data.downdata.data,
+                               &( event->event_data.downdata.length ), SMTC_MODEM_MAX_DOWNLINK_LENGTH, &metadata,
+                               &metadata_len, sizeof( lr1mac_down_metadata_t ) );
             }
-
-            event->event_data.downdata.snr          = metadata.rx_snr << 2;
-            event->event_data.downdata.window       = ( smtc_modem_event_downdata_window_t ) metadata.rx_window;
-            event->event_data.downdata.fport        = metadata.rx_fport;
-            event->event_data.downdata.fpending_bit = metadata.rx_fpending_bit;
-            event->event_data.downdata.frequency_hz = metadata.rx_frequency_hz;
-            event->event_data.downdata.datarate     = metadata.rx_datarate;
+            downlink_metadata_convert( &metadata, &downlink );
+
+            event->event_data.downdata.rssi         = downlink.rssi;
+            event->event_data.downdata.snr          = downlink.snr;
+            event->event_data.downdata.window       = downlink.window;
+            event->event_data.downdata.fport        = downlink.fport;
+            event->event_data.downdata.fpending_bit = downlink.fpending_bit;
+            event->event_data.downdata.frequency_hz = downlink.frequency_hz;
+            event->event_data.downdata.datarate     = downlink.datarate;
             break;
         }
 #if defined( ADD_SMTC_FILE_UPLOAD )
-        case SMTC_MODEM_EVENT_UPLOADDONE:
-            event->event_data.uploaddone.status =
-                ( smtc_modem_event_uploaddone_status_t ) get_modem_event_status( event->event_type );
+        case SMTC_MODEM_EVENT_UPLOADDONE: {
+            uint8_t upload_status;
+
+            nb_requeued = modem_upload_event_pop( event->event_type, &event->event_data.uploaddone.session_id,
+                                                  &upload_status );
+            event->event_data.uploaddone.status = ( smtc_modem_event_uploaddone_status_t ) upload_status;
+            event->missed_events                = 0;
+            break;
+        }
+        case SMTC_MODEM_EVENT_UPLOAD_PROGRESS: {
+            uint8_t session_id;
+            uint8_t unused_status;
+
+            nb_requeued = modem_upload_event_pop( event->event_type, &session_id, &unused_status );
+
+            event->missed_events                         = 0;
+            event->event_data.upload_progress.session_id = session_id;
+            file_upload_get_progress( &( smtc_modem_services_ctx.file_upload_ctx[session_id] ),
+                                      &event->event_data.upload_progress.nb_chunks_sent,
+                                      &event->event_data.upload_progress.nb_chunks_target );
+            event->event_data.upload_progress.estimated_completion_s =
+                modem_supervisor_get_file_upload_eta_s( session_id );
             break;
+        }
 #endif  // ADD_SMTC_FILE_UPLOAD
         case SMTC_MODEM_EVENT_TXDONE:
             event->event_data.txdone.status =
@@ -462,6 +503,12 @@ smtc_modem_return_code_t smtc_modem_get_event( smtc_modem_event_t* event, uint8_
         // Reset the status after get the value
         set_modem_event_count_and_status( event->event_type, 0, 0 );
         decrement_asynchronous_msgnumber( );
+        if( nb_requeued > 0 )
+        {
+            // Raise the event again for the next session, it is returned first by the next call
+            increment_asynchronous_msgnumber( event->event_type, 0 );
+            *event_pending_count += 1;
+        }
     }
     else
     {
@@ -471,6 +518,49 @@ smtc_modem_return_code_t smtc_modem_get_event( smtc_modem_event_t* event, uint8_
     return return_code;
 }
 
+smtc_modem_return_code_t smtc_modem_set_downlink_zero_copy( uint8_t stack_id, bool enable )
+{
+    UNUSED( stack_id );
+    RETURN_BUSY_IF_TEST_MODE( );
+
+    if( enable == false )
+    {
+        // A downlink lent to the application is not reported twice
+        fifo_ctrl_release( lorawan_api_get_fifo_obj( ) );
+    }
+    downlink_zero_copy = enable;
+    return SMTC_MODEM_RC_OK;
+}
+
+smtc_modem_return_code_t smtc_modem_get_downlink( uint8_t stack_id, smtc_modem_downlink_t* downlink )
+{
+    UNUSED( stack_id );
+    RETURN_BUSY_IF_TEST_MODE( );
+    RETURN_INVALID_IF_NULL( downlink );
+
+    lr1mac_down_metadata_t metadata;
+    uint8_t                metadata_len;
+
+    // Only the downlink lent by the last DOWNDATA event is returned, a copied one is no longer in the fifo
+    if( ( fifo_ctrl_is_borrowed( lorawan_api_get_fifo_obj( ) ) == false ) ||
+        ( fifo_ctrl_peek( lorawan_api_get_fifo_obj( ), &downlink->data, &downlink->length, &metadata, &metadata_len,
+                          sizeof( lr1mac_down_metadata_t ) ) != FIFO_STATUS_OK ) )
+    {
+        return SMTC_MODEM_RC_FAIL;
+    }
+    downlink_metadata_convert( &metadata, downlink );
+    return SMTC_MODEM_RC_OK;
+}
+
+smtc_modem_return_code_t smtc_modem_release_downlink( uint8_t stack_id )
+{
+    UNUSED( stack_id );
+    RETURN_BUSY_IF_TEST_MODE( );
+
+    fifo_ctrl_release( lorawan_api_get_fifo_obj( ) );
+    return SMTC_MODEM_RC_OK;
+}
+
 smtc_modem_return_code_t smtc_modem_get_modem_version( smtc_modem_version_t* firmware_version )
 {
     RETURN_BUSY_IF_TEST_MODE( );
@@ -1378,6 +1468,20 @@ smtc_modem_return_code_t smtc_modem_set_region( uint8_t stack_id, smtc_modem_reg
     return SMTC_MODEM_RC_OK;
 }
 
+smtc_modem_return_code_t smtc_modem_switch_region( uint8_t stack_id, smtc_modem_region_t region )
+{
+    UNUSED( stack_id );
+    RETURN_BUSY_IF_TEST_MODE( );
+
+    if( switch_modem_region( region ) == DM_ERROR )
+    {
+        SMTC_MODEM_HAL_TRACE_ERROR( "%s call with region not valid\n", __func__ );
+        return SMTC_MODEM_RC_INVALID;
+    }
+
+    return SMTC_MODEM_RC_OK;
+}
+
 smtc_modem_return_code_t smtc_modem_adr_get_profile( uint8_t stack_id, smtc_modem_adr_profile_t* adr_profile )
 {
     UNUSED( stack_id );
@@ -1759,12 +1863,36 @@ smtc_modem_return_code_t smtc_modem_file_upload_init( uint8_t stack_id, uint8_t
                                                       smtc_modem_file_upload_cipher_mode_t cipher_mode,
                                                       const uint8_t* file, uint16_t file_length,
                                                       uint32_t average_delay_s )
+{
+    return smtc_modem_file_upload_session_init( stack_id, 0, index, cipher_mode, file, file_length, average_delay_s,
+                                                1 );
+}
+
+smtc_modem_return_code_t smtc_modem_file_upload_start( uint8_t stack_id )
+{
+    return smtc_modem_file_upload_session_start( stack_id, 0 );
+}
+
+smtc_modem_return_code_t smtc_modem_file_upload_reset( uint8_t stack_id )
+{
+    return smtc_modem_file_upload_session_reset( stack_id, 0 );
+}
+
+smtc_modem_return_code_t smtc_modem_file_upload_session_init( uint8_t stack_id, uint8_t session_id, uint8_t index,
+                                                              smtc_modem_file_upload_cipher_mode_t cipher_mode,
+                                                              const uint8_t* file, uint16_t file_length,
+                                                              uint32_t average_delay_s, uint8_t weight )
 {
 #if defined( ADD_SMTC_FILE_UPLOAD )
     UNUSED( stack_id );
     RETURN_BUSY_IF_TEST_MODE( );
 
-    if( file_length == 0 )
+    if( session_id >= FILE_UPLOAD_NB_SESSIONS )
+    {
+        SMTC_MODEM_HAL_TRACE_ERROR( "Upload initialization fails: session %d not supported\n", session_id );
+        return SMTC_MODEM_RC_INVALID;
+    }
+    else if( file_length == 0 )
     {
         SMTC_MODEM_HAL_TRACE_ERROR( "Upload initialization fails: size = 0 is not allowed\n" );
         return SMTC_MODEM_RC_INVALID;
@@ -1773,8 +1901,8 @@ smtc_modem_return_code_t smtc_modem_file_upload_init( uint8_t stack_id, uint8_t
     {
         return SMTC_MODEM_RC_INVALID;
     }
-    else if( ( modem_get_upload_state( ) == MODEM_UPLOAD_INIT_AND_FILLED ) ||
-             ( modem_get_upload_state( ) == MODEM_UPLOAD_ON_GOING ) )
+    else if( ( modem_get_upload_state( session_id ) == MODEM_UPLOAD_INIT_AND_FILLED ) ||
+             ( modem_get_upload_state( session_id ) == MODEM_UPLOAD_ON_GOING ) )
     {
         SMTC_MODEM_HAL_TRACE_ERROR( "File Upload still in going\n" );
         return SMTC_MODEM_RC_BUSY;
@@ -1791,18 +1919,20 @@ smtc_modem_return_code_t smtc_modem_file_upload_init( uint8_t stack_id, uint8_t
     // get the next modem upload session counter
     uint8_t next_session_counter = modem_context_compute_and_get_next_dm_upload_sctr( );
 
-    if( file_upload_init( &( smtc_modem_services_ctx.file_upload_ctx ), UPLOAD_SID, ( uint32_t ) file_length,
-                          average_delay_s, index, ( uint8_t ) cipher_mode, next_session_counter ) != FILE_UPLOAD_OK )
+    if( file_upload_init( &( smtc_modem_services_ctx.file_upload_ctx[session_id] ), UPLOAD_SID + session_id,
+                          ( uint32_t ) file_length, average_delay_s, index, ( uint8_t ) cipher_mode,
+                          next_session_counter, weight ) != FILE_UPLOAD_OK )
     {
         SMTC_MODEM_HAL_TRACE_ERROR( "Upload initialization fails\n" );
         return SMTC_MODEM_RC_INVALID;
     }
-    SMTC_MODEM_HAL_TRACE_PRINTF( "%s, cipher_mode: %d, size:%d, average_delay:%d, session counter:%d", __func__,
-                                 cipher_mode, file_length, average_delay_s, next_session_counter );
+    SMTC_MODEM_HAL_TRACE_PRINTF( "%s, session: %d, cipher_mode: %d, size:%d, average_delay:%d, session counter:%d",
+                                 __func__, session_id, cipher_mode, file_length, average_delay_s,
+                                 next_session_counter );
     // attach the file
-    file_upload_attach_file_buffer( &( smtc_modem_services_ctx.file_upload_ctx ), file );
+    file_upload_attach_file_buffer( &( smtc_modem_services_ctx.file_upload_ctx[session_id] ), file );
 
-    modem_set_upload_state( MODEM_UPLOAD_INIT_AND_FILLED );
+    modem_set_upload_state( session_id, MODEM_UPLOAD_INIT_AND_FILLED );
 
     return SMTC_MODEM_RC_OK;
 #else   // ADD_SMTC_FILE_UPLOAD
@@ -1810,36 +1940,39 @@ smtc_modem_return_code_t smtc_modem_file_upload_init( uint8_t stack_id, uint8_t
 #endif  // ADD_SMTC_FILE_UPLOAD
 }
 
-smtc_modem_return_code_t smtc_modem_file_upload_start( uint8_t stack_id )
+smtc_modem_return_code_t smtc_modem_file_upload_session_start( uint8_t stack_id, uint8_t session_id )
 {
 #if defined( ADD_SMTC_FILE_UPLOAD )
     UNUSED( stack_id );
     RETURN_BUSY_IF_TEST_MODE( );
 
+    if( session_id >= FILE_UPLOAD_NB_SESSIONS )
+    {
+        return SMTC_MODEM_RC_INVALID;
+    }
     if( is_modem_connected( ) == false )
     {
         return SMTC_MODEM_RC_FAIL;
     }
-    if( modem_get_upload_state( ) == MODEM_UPLOAD_ON_GOING )
+    if( modem_get_upload_state( session_id ) == MODEM_UPLOAD_ON_GOING )
     {
         SMTC_MODEM_HAL_TRACE_ERROR( "FileUpload still in progress..\n" );
         return SMTC_MODEM_RC_BUSY;
     }
-    if( modem_get_upload_state( ) != MODEM_UPLOAD_INIT_AND_FILLED )
+    if( modem_get_upload_state( session_id ) != MODEM_UPLOAD_INIT_AND_FILLED )
     {
         SMTC_MODEM_HAL_TRACE_ERROR( "File upload session not initialized\n" );
         return SMTC_MODEM_RC_NOT_INIT;
     }
 
     // ready to prepare the file to be uploaded
-    file_upload_prepare_upload( &( smtc_modem_services_ctx.file_upload_ctx ) );
+    file_upload_prepare_upload( &( smtc_modem_services_ctx.file_upload_ctx[session_id] ) );
 
-    // add the first upload task in scheduler
-    modem_supervisor_add_task_file_upload( smtc_modem_hal_get_random_nb_in_range( 0, 2 ) );
+    // set modem file upload state (and status) before scheduling so the session is taken into account
+    modem_set_upload_state( session_id, MODEM_UPLOAD_ON_GOING );
 
-    modem_set_upload_state( MODEM_UPLOAD_ON_GOING );
-    // set modem file upload status to true
-    set_modem_status_file_upload( true );
+    // add the first upload of this session in scheduler
+    modem_supervisor_add_task_file_upload( session_id, smtc_modem_hal_get_random_nb_in_range( 0, 2 ) );
 
     return SMTC_MODEM_RC_OK;
 #else   // ADD_SMTC_FILE_UPLOAD
@@ -1847,23 +1980,28 @@ smtc_modem_return_code_t smtc_modem_file_upload_start( uint8_t stack_id )
 #endif  // ADD_SMTC_FILE_UPLOAD
 }
 
-smtc_modem_return_code_t smtc_modem_file_upload_reset( uint8_t stack_id )
+smtc_modem_return_code_t smtc_modem_file_upload_session_reset( uint8_t stack_id, uint8_t session_id )
 {
 #if defined( ADD_SMTC_FILE_UPLOAD )
     UNUSED( stack_id );
     RETURN_BUSY_IF_TEST_MODE( );
 
-    if( ( modem_get_upload_state( ) == MODEM_UPLOAD_NOT_INIT ) ||
-        ( modem_get_upload_state( ) == MODEM_UPLOAD_FINISHED ) )
+    if( session_id >= FILE_UPLOAD_NB_SESSIONS )
+    {
+        return SMTC_MODEM_RC_INVALID;
+    }
+    if( ( modem_get_upload_state( session_id ) == MODEM_UPLOAD_NOT_INIT ) ||
+        ( modem_get_upload_state( session_id ) == MODEM_UPLOAD_FINISHED ) )
     {
         SMTC_MODEM_HAL_TRACE_ERROR( "No file upload session is on going\n" );
         return SMTC_MODEM_RC_NOT_INIT;
     }
 
-    SMTC_MODEM_HAL_TRACE_WARNING( "File Upload Cancel and session reset!\n" );
-    modem_set_upload_state( MODEM_UPLOAD_NOT_INIT );
+    SMTC_MODEM_HAL_TRACE_WARNING( "File Upload %d Cancel and session reset!\n", session_id );
+    modem_set_upload_state( session_id, MODEM_UPLOAD_NOT_INIT );
 
-    set_modem_status_file_upload( false );
+    // the other sessions keep their pacing
+    modem_supervisor_update_task_file_upload( );
 
     return SMTC_MODEM_RC_OK;
 #else   // ADD_SMTC_FILE_UPLOAD
@@ -2162,6 +2300,36 @@ smtc_modem_return_code_t smtc_modem_get_duty_cycle_status( int32_t* duty_cycle_s
     return SMTC_MODEM_RC_OK;
 }
 
+smtc_modem_return_code_t smtc_modem_get_airtime_forecast( uint8_t stack_id, uint8_t datarate, uint8_t payload_length,
+                                                          smtc_modem_airtime_forecast_t* forecast )
+{
+    UNUSED( stack_id );
+    RETURN_BUSY_IF_TEST_MODE( );
+    RETURN_INVALID_IF_NULL( forecast );
+
+    smtc_dtc_band_forecast_t band_forecast[SMTC_DTC_BANDS_MAX];
+    uint8_t                  number_of_bands = 0;
+
+    if( lorawan_api_airtime_forecast_get( datarate, payload_length, &forecast->toa_ms, &forecast->earliest_tx_delay_ms,
+                                          band_forecast, &number_of_bands ) != OKLORAWAN )
+    {
+        SMTC_MODEM_HAL_TRACE_ERROR( "%s call with datarate or payload length not valid\n", __func__ );
+        return SMTC_MODEM_RC_INVALID;
+    }
+
+    forecast->nb_bands =
+        ( number_of_bands < SMTC_MODEM_AIRTIME_BANDS_MAX ) ? number_of_bands : SMTC_MODEM_AIRTIME_BANDS_MAX;
+    for( uint8_t i = 0; i < forecast->nb_bands; i++ )
+    {
+        forecast->bands[i].freq_min_hz  = band_forecast[i].freq_min;
+        forecast->bands[i].freq_max_hz  = band_forecast[i].freq_max;
+        forecast->bands[i].budget_ms    = band_forecast[i].budget_ms;
+        forecast->bands[i].available_ms = band_forecast[i].available_ms;
+        forecast->bands[i].delay_ms     = band_forecast[i].delay_ms;
+    }
+    return SMTC_MODEM_RC_OK;
+}
+
 smtc_modem_return_code_t smtc_modem_rp_abort_user_radio_access_task( uint8_t user_task_id )
 {
 #if !defined( LR1110_MODEM_E )
@@ -2372,6 +2540,37 @@ smtc_modem_return_code_t smtc_modem_lbt_get_state( uint8_t stack_id, bool* enabl
     return SMTC_MODEM_RC_OK;
 }
 
+smtc_modem_return_code_t smtc_modem_lbt_get_channel_stats( uint8_t stack_id, smtc_modem_lbt_channel_stats_t* stats,
+                                                           uint8_t* nb_channels )
+{
+    UNUSED( stack_id );
+    RETURN_BUSY_IF_TEST_MODE( );
+    RETURN_INVALID_IF_NULL( stats );
+    RETURN_INVALID_IF_NULL( nb_channels );
+
+    smtc_lbt_channel_stats_t lbt_stats[SMTC_LBT_STATS_NB];
+    uint8_t                  nb = lorawan_api_lbt_get_channel_stats( lbt_stats );
+
+    *nb_channels = ( nb < SMTC_MODEM_LBT_CHANNELS_MAX ) ? nb : SMTC_MODEM_LBT_CHANNELS_MAX;
+    for( uint8_t i = 0; i < *nb_channels; i++ )
+    {
+        stats[i].freq_hz       = lbt_stats[i].freq_hz;
+        stats[i].free_cnt      = lbt_stats[i].free_cnt;
+        stats[i].busy_cnt      = lbt_stats[i].busy_cnt;
+        stats[i].last_rssi_dbm = lbt_stats[i].last_rssi_dbm;
+    }
+    return SMTC_MODEM_RC_OK;
+}
+
+smtc_modem_return_code_t smtc_modem_lbt_clear_channel_stats( uint8_t stack_id )
+{
+    UNUSED( stack_id );
+    RETURN_BUSY_IF_TEST_MODE( );
+
+    lorawan_api_lbt_clear_channel_stats( );
+    return SMTC_MODEM_RC_OK;
+}
+
 smtc_modem_return_code_t smtc_modem_set_nb_trans( uint8_t stack_id, uint8_t nb_trans )
 {
     UNUSED( stack_id );
@@ -2916,6 +3115,29 @@ static smtc_modem_return_code_t smtc_modem_set_dm_status_with_rate( const uint8_
     return return_code;
 }
 
+static void downlink_metadata_convert( const lr1mac_down_metadata_t* metadata, smtc_modem_downlink_t* downlink )
+{
+    if( ( metadata->rx_rssi >= -128 ) && ( metadata->rx_rssi <= 63 ) )
+    {
+        downlink->rssi = ( int8_t )( metadata->rx_rssi + 64 );
+    }
+    else if( metadata->rx_rssi > 63 )
+    {
+        downlink->rssi = 127;
+    }
+    else
+    {
+        downlink->rssi = -128;
+    }
+
+    downlink->snr          = metadata->rx_snr << 2;
+    downlink->window       = ( smtc_modem_event_downdata_window_t ) metadata->rx_window;
+    downlink->fport        = metadata->rx_fport;
+    downlink->fpending_bit = metadata->rx_fpending_bit;
+    downlink->frequency_hz = metadata->rx_frequency_hz;
+    downlink->datarate     = metadata->rx_datarate;
+}
+
 static bool is_modem_connected( )
 {
     bool ret = true;
@@ -51,6 +51,10 @@
 
 #define LEN_DATA_SIZE ( 2 )
 #define LEN_METADATA_SIZE ( 1 )
+#define LEN_HEADER_SIZE ( LEN_DATA_SIZE + LEN_METADATA_SIZE )
+
+// Data length written in place of a header to skip the end of the buffer
+#define PADDING_DATA_LEN ( 0xFFFF )
 
 /*
  * -----------------------------------------------------------------------------
@@ -72,6 +76,8 @@ static fifo_return_status_t ctrl_set( fifo_ctrl_t* ctrl, const uint8_t* buffer,
 static fifo_return_status_t ctrl_get( fifo_ctrl_t* ctrl, uint8_t* buffer, uint16_t* data_len,
                                       const uint16_t data_buffer_size, void* metadata, uint8_t* metadata_len,
                                       const uint8_t metadata_buffer_size );
+
+static void ctrl_skip_padding( fifo_ctrl_t* ctrl );
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
@@ -93,6 +99,7 @@ void fifo_ctrl_clear( fifo_ctrl_t* ctrl )
     ctrl->read_cnt     = 0;
     ctrl->drop_cnt     = 0;
     ctrl->free_space   = ctrl->buffer_size;
+    ctrl->is_borrowed  = false;
 }
 
 void fifo_ctrl_print_stat( const fifo_ctrl_t* ctrl )
@@ -139,71 +146,127 @@ fifo_return_status_t fifo_ctrl_set( fifo_ctrl_t* ctrl, const uint8_t* buffer, co
     return ret;
 }
 
+fifo_return_status_t fifo_ctrl_peek( fifo_ctrl_t* ctrl, const uint8_t** data, uint16_t* data_len, void* metadata,
+                                     uint8_t* metadata_len, const uint8_t metadata_buffer_size )
+{
+    fifo_return_status_t ret = FIFO_STATUS_OK;
+
+    if( ( data == NULL ) || ( data_len == NULL ) || ( metadata == NULL ) || ( metadata_len == NULL ) )
+    {
+        return FIFO_STATUS_PARAM_ERROR;
+    }
+
+    smtc_modem_hal_disable_modem_irq( );
+    if( ctrl->nb_element == 0 )
+    {
+        ret = FIFO_STATUS_BUFFER_EMPTY;
+    }
+    else
+    {
+        ctrl_skip_padding( ctrl );
+
+        const uint8_t* elt = ctrl->buffer + ctrl->read_offset;
+        *data_len          = ( ( ( uint16_t ) elt[0] ) << 8 ) + elt[1];
+        *metadata_len      = elt[2];
+
+        if( *metadata_len > metadata_buffer_size )
+        {
+            ret = FIFO_STATUS_BUFFER_TOO_SMALL;
+        }
+        else
+        {
+            // Metadata are copied as they may be unaligned in the fifo, data are lent in place
+            memcpy( ( uint8_t* ) metadata, elt + LEN_HEADER_SIZE, *metadata_len );
+            *data             = elt + LEN_HEADER_SIZE + *metadata_len;
+            ctrl->is_borrowed = true;
+        }
+    }
+    smtc_modem_hal_enable_modem_irq( );
+
+    return ret;
+}
+
+void fifo_ctrl_release( fifo_ctrl_t* ctrl )
+{
+    smtc_modem_hal_disable_modem_irq( );
+    if( ctrl->is_borrowed == true )
+    {
+        ctrl_get( ctrl, NULL, NULL, 0, NULL, NULL, 0 );
+    }
+    smtc_modem_hal_enable_modem_irq( );
+}
+
+bool fifo_ctrl_is_borrowed( const fifo_ctrl_t* ctrl )
+{
+    return ctrl->is_borrowed;
+}
+
 static fifo_return_status_t ctrl_set( fifo_ctrl_t* ctrl, const uint8_t* buffer, const uint16_t buffer_len,
                                       const void* metadata, const uint8_t metadata_len )
 {
-    uint16_t total_write_len = LEN_DATA_SIZE + LEN_METADATA_SIZE + metadata_len + buffer_len;
+    uint16_t total_write_len = LEN_HEADER_SIZE + metadata_len + buffer_len;
 
     if( total_write_len > ctrl->buffer_size )
     {
         return FIFO_STATUS_BUFFER_TOO_SMALL;
     }
 
-    while( ctrl->free_space < total_write_len )
+    // An element is never split at the end of the buffer so that it can be lent in place: if it does not fit in the
+    // tail, the tail is lost until the element before it is read
+    uint16_t tail_len   = ctrl->buffer_size - ctrl->write_offset;
+    uint16_t needed_len = ( tail_len < total_write_len ) ? ( tail_len + total_write_len ) : total_write_len;
+
+    while( ctrl->free_space < needed_len )
     {
+        if( ctrl->is_borrowed == true )
+        {
+            // The oldest element is lent, drop the new one
+            ctrl->drop_cnt += 1;
+            return FIFO_STATUS_ELEMENT_BORROWED;
+        }
         // Not enough free space --> Remove oldest
         ctrl_get( ctrl, NULL, NULL, 0, NULL, NULL, 0 );
         ctrl->drop_cnt += 1;
+
+        tail_len   = ctrl->buffer_size - ctrl->write_offset;
+        needed_len = ( tail_len < total_write_len ) ? ( tail_len + total_write_len ) : total_write_len;
+    }
+
+    if( tail_len < total_write_len )
+    {
+        if( tail_len >= LEN_HEADER_SIZE )
+        {
+            ctrl->buffer[ctrl->write_offset]     = ( uint8_t )( PADDING_DATA_LEN >> 8 );
+            ctrl->buffer[ctrl->write_offset + 1] = ( uint8_t )( PADDING_DATA_LEN );
+        }
+        ctrl->free_space -= tail_len;
+        ctrl->write_offset = 0;
     }
 
+    uint8_t* elt = ctrl->buffer + ctrl->write_offset;
+
     // Write data length - 2 bytes MSB first
-    ctrl->buffer[ctrl->write_offset] = ( uint8_t )( buffer_len >> 8 );
-    ctrl->write_offset += 1;
-    ctrl->write_offset %= ctrl->buffer_size;
-    ctrl->buffer[ctrl->write_offset] = ( uint8_t )( buffer_len );
-    ctrl->write_offset += 1;
-    ctrl->write_offset %= ctrl->buffer_size;
+    elt[0] = ( uint8_t )( buffer_len >> 8 );
+    elt[1] = ( uint8_t )( buffer_len );
 
     // Write metadata length
-    ctrl->buffer[ctrl->write_offset] = metadata_len;
-    ctrl->write_offset += 1;
-    ctrl->write_offset %= ctrl->buffer_size;
+    elt[2] = metadata_len;
 
     // Write metadata
     if( metadata_len != 0 )
     {
-        if( ( ctrl->write_offset + metadata_len ) > ctrl->buffer_size )
-        {
-            memcpy( ctrl->buffer + ctrl->write_offset, ( uint8_t* ) metadata, ctrl->buffer_size - ctrl->write_offset );
-            memcpy( ctrl->buffer, ( uint8_t* ) metadata + ctrl->buffer_size - ctrl->write_offset,
-                    metadata_len - ( ctrl->buffer_size - ctrl->write_offset ) );
-        }
-        else
-        {
-            memcpy( ctrl->buffer + ctrl->write_offset, ( uint8_t* ) metadata, metadata_len );
-        }
-        ctrl->write_offset += metadata_len;
-        ctrl->write_offset %= ctrl->buffer_size;
+        memcpy( elt + LEN_HEADER_SIZE, ( const uint8_t* ) metadata, metadata_len );
     }
 
     // Write data
     if( buffer_len != 0 )
     {
-        if( ( ctrl->write_offset + buffer_len ) > ctrl->buffer_size )
-        {
-            memcpy( ctrl->buffer + ctrl->write_offset, buffer, ctrl->buffer_size - ctrl->write_offset );
-            memcpy( ctrl->buffer, buffer + ctrl->buffer_size - ctrl->write_offset,
-                    buffer_len - ( ctrl->buffer_size - ctrl->write_offset ) );
-        }
-        else
-        {
-            memcpy( ctrl->buffer + ctrl->write_offset, buffer, buffer_len );
-        }
-
-        ctrl->write_offset += buffer_len;
-        ctrl->write_offset %= ctrl->buffer_size;
+        memcpy( elt + LEN_HEADER_SIZE + metadata_len, buffer, buffer_len );
     }
 
+    ctrl->write_offset += total_write_len;
+    ctrl->write_offset %= ctrl->buffer_size;
+
     ctrl->free_space -= total_write_len;
     ctrl->nb_element += 1;
     ctrl->write_cnt += 1;
@@ -220,10 +283,12 @@ static fifo_return_status_t ctrl_get( fifo_ctrl_t* ctrl, uint8_t* buffer, uint16
         return FIFO_STATUS_BUFFER_EMPTY;
     }
 
+    ctrl_skip_padding( ctrl );
+
     // Read data & metadata size (read_offset update is done later if input param are ok)
-    uint16_t read_data_len = ( ( uint16_t ) ctrl->buffer[ctrl->read_offset] ) << 8;
-    read_data_len += ( ( uint16_t ) ctrl->buffer[( ctrl->read_offset + 1 ) % ctrl->buffer_size] );
-    uint8_t read_metadata_len = ctrl->buffer[( ctrl->read_offset + 2 ) % ctrl->buffer_size];
+    const uint8_t* elt               = ctrl->buffer + ctrl->read_offset;
+    uint16_t       read_data_len     = ( ( ( uint16_t ) elt[0] ) << 8 ) + elt[1];
+    uint8_t        read_metadata_len = elt[2];
 
     // Buffer & metadata are NULL --> drop old message --> don't check/update size of buffer
     if( ( buffer != NULL ) && ( metadata != NULL ) )
@@ -243,47 +308,48 @@ static fifo_return_status_t ctrl_get( fifo_ctrl_t* ctrl, uint8_t* buffer, uint16
         }
     }
 
-    // Update read offset (only if there is no error)
-    ctrl->read_offset += ( LEN_DATA_SIZE + LEN_METADATA_SIZE );
-    ctrl->read_offset %= ctrl->buffer_size;
-
     // Copy metadata (if required)
     if( ( metadata != NULL ) && ( read_metadata_len != 0 ) )
     {
-        if( ( ctrl->read_offset + read_metadata_len ) > ctrl->buffer_size )
-        {
-            memcpy( ( uint8_t* ) metadata, ctrl->buffer + ctrl->read_offset, ctrl->buffer_size - ctrl->read_offset );
-            memcpy( ( uint8_t* ) metadata + ctrl->buffer_size - ctrl->read_offset, ctrl->buffer,
-                    read_metadata_len - ( ctrl->buffer_size - ctrl->read_offset ) );
-        }
-        else
-        {
-            memcpy( ( uint8_t* ) metadata, ctrl->buffer + ctrl->read_offset, read_metadata_len );
-        }
+        memcpy( ( uint8_t* ) metadata, elt + LEN_HEADER_SIZE, read_metadata_len );
     }
-    ctrl->read_offset += read_metadata_len;
-    ctrl->read_offset %= ctrl->buffer_size;
 
     // Copy data (if required)
     if( ( buffer != NULL ) && ( read_data_len != 0 ) )
     {
-        if( ( ctrl->read_offset + read_data_len ) > ctrl->buffer_size )
-        {
-            memcpy( buffer, ctrl->buffer + ctrl->read_offset, ctrl->buffer_size - ctrl->read_offset );
-            memcpy( buffer + ctrl->buffer_size - ctrl->read_offset, ctrl->buffer,
-                    read_data_len - ( ctrl->buffer_size - ctrl->read_offset ) );
-        }
-        else
-        {
-            memcpy( buffer, ctrl->buffer + ctrl->read_offset, read_data_len );
-        }
+        memcpy( buffer, elt + LEN_HEADER_SIZE + read_metadata_len, read_data_len );
     }
-    ctrl->read_offset += read_data_len;
+
+    uint16_t total_read_len = LEN_HEADER_SIZE + read_metadata_len + read_data_len;
+
+    ctrl->read_offset += total_read_len;
     ctrl->read_offset %= ctrl->buffer_size;
 
-    ctrl->free_space += ( LEN_DATA_SIZE + LEN_METADATA_SIZE + read_metadata_len + read_data_len );
+    ctrl->free_space += total_read_len;
     ctrl->nb_element -= 1;
     ctrl->read_cnt += 1;
+    ctrl->is_borrowed = false;
+
+    if( ctrl->nb_element == 0 )
+    {
+        // Restart from the beginning of the buffer, it also releases a lost tail
+        ctrl->read_offset  = 0;
+        ctrl->write_offset = 0;
+        ctrl->free_space   = ctrl->buffer_size;
+    }
 
     return FIFO_STATUS_OK;
 }
+
+static void ctrl_skip_padding( fifo_ctrl_t* ctrl )
+{
+    uint16_t tail_len = ctrl->buffer_size - ctrl->read_offset;
+
+    if( ( tail_len < LEN_HEADER_SIZE ) ||
+        ( ( ( ( ( uint16_t ) ctrl->buffer[ctrl->read_offset] ) << 8 ) + ctrl->buffer[ctrl->read_offset + 1] ) ==
+          PADDING_DATA_LEN ) )
+    {
+        ctrl->free_space += tail_len;
+        ctrl->read_offset = 0;
+    }
+}
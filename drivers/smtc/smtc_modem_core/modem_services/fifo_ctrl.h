@@ -43,7 +43,8 @@ extern "C" {
  * -----------------------------------------------------------------------------
  * --- DEPENDENCIES ------------------------------------------------------------
  */
-#include <stdint.h>  // C99 types
+#include <stdint.h>   // C99 types
+#include <stdbool.h>  // bool type
 
 /*
  * -----------------------------------------------------------------------------
@@ -68,6 +69,7 @@ typedef enum fifo_return_status_e
     FIFO_STATUS_BUFFER_EMPTY,      // Only for get function
     FIFO_STATUS_BUFFER_TOO_SMALL,  // For get: not enough space in buffer to read data from fifo
                                    // For set: fifo is not big enough to save data + metadata
+    FIFO_STATUS_ELEMENT_BORROWED,  // Only for set: fifo is full and its oldest element is lent, new element dropped
 } fifo_return_status_t;
 
 // Internal structure to manage fifo - don't modify it
@@ -84,6 +86,9 @@ typedef struct fifo_ctrl_s
     uint32_t write_cnt;
     uint32_t read_cnt;
     uint32_t drop_cnt;
+
+    // Oldest element lent by fifo_ctrl_peek
+    bool is_borrowed;
 } fifo_ctrl_t;
 
 /*
@@ -161,6 +166,37 @@ fifo_return_status_t fifo_ctrl_get( fifo_ctrl_t* ctrl, uint8_t* buffer, uint16_t
 fifo_return_status_t fifo_ctrl_set( fifo_ctrl_t* ctrl, const uint8_t* buffer, const uint16_t buffer_len,
                                     const void* metadata, const uint8_t metadata_len );
 
+/**
+ * @brief Lend the oldest element in fifo without copying its data
+ *      The element stays in the fifo until fifo_ctrl_release, meanwhile it is never dropped: a new element which
+ *      would need its space is dropped instead
+ *
+ * @param ctrl                  fifo manager
+ * @param data                  pointer to the data of the element, valid until fifo_ctrl_release
+ * @param data_len              length of data
+ * @param metadata              pointer to save metadata
+ * @param metadata_len          length of metadata
+ * @param metadata_buffer_size  size of metadata buffer
+ * @return fifo_return_status_t return status
+ */
+fifo_return_status_t fifo_ctrl_peek( fifo_ctrl_t* ctrl, const uint8_t** data, uint16_t* data_len, void* metadata,
+                                     uint8_t* metadata_len, const uint8_t metadata_buffer_size );
+
+/**
+ * @brief Remove the element lent by fifo_ctrl_peek, do nothing if no element is lent
+ *
+ * @param ctrl  fifo manager
+ */
+void fifo_ctrl_release( fifo_ctrl_t* ctrl );
+
+/**
+ * @brief Tell whether the oldest element is lent by fifo_ctrl_peek
+ *
+ * @param ctrl  fifo manager
+ * @return bool true from fifo_ctrl_peek until fifo_ctrl_release
+ */
+bool fifo_ctrl_is_borrowed( const fifo_ctrl_t* ctrl );
+
 #ifdef __cplusplus
 }
 #endif
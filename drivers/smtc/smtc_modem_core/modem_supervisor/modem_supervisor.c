@@ -88,6 +88,22 @@
  */
 #define MIN( a, b ) ( ( ( a ) < ( b ) ) ? ( a ) : ( b ) )
 
+/*!
+ * \brief Returns the maximum value between a and b
+ *
+ * \param [IN] a 1st value
+ * \param [IN] b 2nd value
+ * \retval maxValue Maximum value
+ */
+#define MAX( a, b ) ( ( ( a ) > ( b ) ) ? ( a ) : ( b ) )
+
+#if defined( ADD_SMTC_FILE_UPLOAD )
+/**
+ * @brief Maximum size of a file upload fragment, whatever the data rate
+ */
+#define FILE_UPLOAD_FRAGMENT_MAX_SIZE 100
+#endif  // ADD_SMTC_FILE_UPLOAD
+
 /**
  * @brief Math Abs macro
  */
@@ -119,6 +135,8 @@ static rose_t* ROSE = NULL;
 #if defined( ADD_SMTC_FILE_UPLOAD )
 
 static file_upload_t* file_upload_context = NULL;
+static uint8_t        file_upload_session_id;                           // session served by the last launch
+static int16_t        file_upload_wrr_credit[FILE_UPLOAD_NB_SESSIONS];  // weighted round-robin credits
 #endif  // ADD_SMTC_FILE_UPLOAD
 
 // Used for LoRaWAN Certification
@@ -152,6 +170,8 @@ struct
 
 #if defined( ADD_SMTC_FILE_UPLOAD )
     file_upload_t*    file_upload_context;
+    uint8_t           file_upload_session_id;
+    int16_t           file_upload_wrr_credit[FILE_UPLOAD_NB_SESSIONS];
 #endif  // ADD_SMTC_FILE_UPLOAD
 
     // Used for LoRaWAN Certification
@@ -184,6 +204,8 @@ struct
 
 #if defined( ADD_SMTC_FILE_UPLOAD )
 #define file_upload_context                     modem_supervisor_context.file_upload_context
+#define file_upload_session_id                  modem_supervisor_context.file_upload_session_id
+#define file_upload_wrr_credit                  modem_supervisor_context.file_upload_wrr_credit
 #endif  // ADD_SMTC_FILE_UPLOAD
 
 // Used for LoRaWAN Certification
@@ -213,6 +235,45 @@ static void check_class_b_to_generate_event( void );
 static void backoff_mobile_static( void );
 static void send_task_update( uint8_t event_type );
 
+#if defined( ADD_SMTC_FILE_UPLOAD )
+/**
+ * @brief Elect the file upload session that sends the next fragment
+ *
+ * @remark Smooth weighted round-robin between the on going sessions whose pacing delay has elapsed
+ *
+ * @param [in] spend_credit Update the round-robin credits, only once the elected session actually sends a fragment
+ * @return uint8_t the elected session, FILE_UPLOAD_NB_SESSIONS if none is ready
+ */
+static uint8_t file_upload_select_session( bool spend_credit );
+
+/**
+ * @brief Get the size of the buffer in which the next file upload fragment is built
+ *
+ * @return uint8_t the fragment buffer size
+ */
+static uint8_t file_upload_get_fragment_buffer_size( void );
+
+/**
+ * @brief Compute the delay before the next fragment of a session
+ *
+ * @remark The session average delay is the minimum spacing, the regional duty cycle can only extend it: when all the
+ *         bands are exhausted the fragment waits for the first one to be released, and when the remaining budget does
+ *         not cover the uplinks already waiting in the supervisor, the fragment is spread at the regulated rate.
+ *
+ * @param [in] file_upload Pointer to File Upload context
+ * @return uint32_t the delay in seconds
+ */
+static uint32_t file_upload_get_pacing_delay_s( file_upload_t* file_upload );
+
+/**
+ * @brief Tell whether a supervisor task sends an uplink and so takes duty cycle budget
+ *
+ * @param [in] id The task
+ * @return bool true for uplink tasks, false for the tasks that only run a callback or a timer
+ */
+static bool is_uplink_task( task_id_t id );
+#endif  // ADD_SMTC_FILE_UPLOAD
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
@@ -238,7 +299,9 @@ void modem_supervisor_init( void ( *callback )( void ), radio_planner_t* rp,
 #endif  // ADD_SMTC_STREAM
 
 #if defined( ADD_SMTC_FILE_UPLOAD )
-    file_upload_context = &( smtc_modem_services_ctx->file_upload_ctx );
+    file_upload_context    = &( smtc_modem_services_ctx->file_upload_ctx[0] );
+    file_upload_session_id = FILE_UPLOAD_NB_SESSIONS;
+    memset( file_upload_wrr_credit, 0, sizeof( file_upload_wrr_credit ) );
 #endif  // ADD_SMTC_FILE_UPLOAD
 
     // Used for LoRaWAN Certification
@@ -508,26 +571,33 @@ void modem_supervisor_launch_task( task_id_t id )
     case FILE_UPLOAD_TASK: {
         int32_t file_upload_chunk_size         = 0;
         uint8_t file_upload_chunk_payload[242] = { 0 };
+
+        file_upload_session_id = FILE_UPLOAD_NB_SESSIONS;
         if( get_join_state( ) != MODEM_JOINED )
         {
             SMTC_MODEM_HAL_TRACE_ERROR( "DEVICE NOT JOIN \n" );
             break;
         }
-        else if( modem_get_upload_state( ) != MODEM_UPLOAD_ON_GOING )
-
+        uint8_t session_id = file_upload_select_session( false );
+        if( session_id >= FILE_UPLOAD_NB_SESSIONS )
         {
             SMTC_MODEM_HAL_TRACE_ERROR( "FileUpload not init \n" );
             break;
         }
-        uint32_t max_payload_size = lorawan_api_next_max_payload_length_get( );
         file_upload_chunk_size =
-            file_upload_get_fragment( file_upload_context, file_upload_chunk_payload,
-                                      ( max_payload_size > 100 ) ? 100 : max_payload_size, lorawan_api_fcnt_up_get( ) );
+            file_upload_get_fragment( &file_upload_context[session_id], file_upload_chunk_payload,
+                                      file_upload_get_fragment_buffer_size( ), lorawan_api_fcnt_up_get( ) );
         if( file_upload_chunk_size > 0 )
         {
+            file_upload_session_id = session_id;
             send_status =
                 lorawan_api_payload_send( get_modem_dm_port( ), true, file_upload_chunk_payload, file_upload_chunk_size,
                                           UNCONF_DATA_UP, smtc_modem_hal_get_time_in_ms( ) + MODEM_TASK_DELAY_MS );
+            if( send_status == OKLORAWAN )
+            {
+                // The session is served: only now take its weighted round-robin credits
+                file_upload_select_session( true );
+            }
         }
         else
         {
@@ -810,23 +880,28 @@ void modem_supervisor_update_task( task_id_t id )
         break;
 #if defined( ADD_SMTC_FILE_UPLOAD )
     case FILE_UPLOAD_TASK: {
-        modem_upload_state_t modem_upload_state = modem_get_upload_state( );
-        if( modem_upload_state == MODEM_UPLOAD_ON_GOING )
+        uint8_t        session_id  = file_upload_session_id;
+        file_upload_t* file_upload = &file_upload_context[session_id];
+
+        file_upload_session_id = FILE_UPLOAD_NB_SESSIONS;
+        if( modem_get_upload_state( session_id ) == MODEM_UPLOAD_ON_GOING )
         {
-            if( ( file_upload_is_data_remaining( file_upload_context ) == true ) )
+            // A fragment was sent, the last one included
+            modem_upload_event_push( SMTC_MODEM_EVENT_UPLOAD_PROGRESS, session_id, 0 );
+            if( ( file_upload_is_data_remaining( file_upload ) == true ) )
             {
-                // There is still upload that need to be sent => add a new task
-                modem_supervisor_add_task_file_upload( file_upload_get_average_delay_in_s( file_upload_context ) );
-            }
-            else
-            {
-                // Nothing left to be sent => abort upload and generate event
-                SMTC_MODEM_HAL_TRACE_WARNING( "File upload ended without server confirmation \n" );
-                increment_asynchronous_msgnumber( SMTC_MODEM_EVENT_UPLOADDONE, 0x00 );
-                set_modem_status_file_upload( false );
-                modem_set_upload_state( MODEM_UPLOAD_FINISHED );
+                // There is still upload that need to be sent => pace this session before its next fragment
+                modem_supervisor_add_task_file_upload( session_id, file_upload_get_pacing_delay_s( file_upload ) );
+                break;
             }
+
+            // Nothing left to be sent => abort upload and generate event
+            SMTC_MODEM_HAL_TRACE_WARNING( "File upload %d ended without server confirmation \n", session_id );
+            modem_upload_event_push( SMTC_MODEM_EVENT_UPLOADDONE, session_id, SMTC_MODEM_EVENT_UPLOADDONE_ABORTED );
+            modem_set_upload_state( session_id, MODEM_UPLOAD_FINISHED );
         }
+        // keep serving the other sessions
+        modem_supervisor_update_task_file_upload( );
         break;
     }
 #endif  // ADD_SMTC_FILE_UPLOAD
@@ -1107,6 +1182,153 @@ uint32_t modem_supervisor_engine( void )
     return ( sleep_time );
 }
 
+#if defined( ADD_SMTC_FILE_UPLOAD )
+static uint8_t file_upload_select_session( bool spend_credit )
+{
+    uint8_t  selected     = FILE_UPLOAD_NB_SESSIONS;
+    int16_t  total_weight = 0;
+    uint32_t now_s        = smtc_modem_hal_get_time_in_s( );
+    int16_t  credit[FILE_UPLOAD_NB_SESSIONS];
+
+    for( uint8_t i = 0; i < FILE_UPLOAD_NB_SESSIONS; i++ )
+    {
+        if( modem_get_upload_state( i ) != MODEM_UPLOAD_ON_GOING )
+        {
+            file_upload_wrr_credit[i] = 0;
+            continue;
+        }
+        if( ( int32_t )( modem_get_upload_next_time_s( i ) - now_s ) > 0 )
+        {
+            continue;
+        }
+        int16_t weight = file_upload_get_weight( &file_upload_context[i] );
+
+        credit[i] = file_upload_wrr_credit[i] + weight;
+        total_weight += weight;
+        if( ( selected == FILE_UPLOAD_NB_SESSIONS ) || ( credit[i] > credit[selected] ) )
+        {
+            selected = i;
+        }
+        if( spend_credit == true )
+        {
+            file_upload_wrr_credit[i] = credit[i];
+        }
+    }
+
+    if( ( spend_credit == true ) && ( selected < FILE_UPLOAD_NB_SESSIONS ) )
+    {
+        file_upload_wrr_credit[selected] -= total_weight;
+    }
+    return selected;
+}
+
+static uint8_t file_upload_get_fragment_buffer_size( void )
+{
+    uint8_t max_payload_size = lorawan_api_next_max_payload_length_get( );
+    return MIN( max_payload_size, FILE_UPLOAD_FRAGMENT_MAX_SIZE );
+}
+
+static uint32_t file_upload_get_pacing_delay_s( file_upload_t* file_upload )
+{
+    uint32_t delay_s = file_upload_get_average_delay_in_s( file_upload );
+    int32_t  dtc_ms  = lorawan_api_next_free_duty_cycle_ms_get( );
+
+    if( dtc_ms > 0 )
+    {
+        // No band left: nothing can be sent before the first band is released
+        return MAX( delay_s, ( ( uint32_t ) dtc_ms + 999 ) / 1000 );
+    }
+
+    uint32_t period_budget_ms = lorawan_api_duty_cycle_period_budget_ms_get( );
+    if( period_budget_ms == 0 )
+    {
+        // No regional duty cycle
+        return delay_s;
+    }
+
+    // Count the uplinks already due, they go first on the remaining budget
+    uint8_t  nb_pending_uplinks = 0;
+    uint32_t now_s              = smtc_modem_hal_get_time_in_s( );
+    for( task_id_t i = 0; i < NUMBER_OF_TASKS; i++ )
+    {
+        if( ( is_uplink_task( i ) == true ) && ( task_manager.modem_task[i].priority != TASK_FINISH ) &&
+            ( ( int32_t )( task_manager.modem_task[i].time_to_execute_s - now_s ) <= ( int32_t ) delay_s ) )
+        {
+            nb_pending_uplinks++;
+        }
+    }
+
+    uint32_t toa_ms = lorawan_api_toa_ms_get( lorawan_api_next_dr_get( ), file_upload_get_fragment_buffer_size( ) );
+    if( ( uint32_t )( -dtc_ms ) < ( toa_ms * ( nb_pending_uplinks + 1 ) ) )
+    {
+        // Budget is short: send this session at the rate the regulation sustains
+        uint32_t regulated_delay_s =
+            ( uint32_t )( ( ( ( uint64_t ) toa_ms * SMTC_DTC_PERIOD_MS ) / period_budget_ms + 999 ) / 1000 );
+        delay_s = MAX( delay_s, regulated_delay_s );
+    }
+    return delay_s;
+}
+
+static bool is_uplink_task( task_id_t id )
+{
+    switch( id )
+    {
+    case FILE_UPLOAD_TASK:  // the session being paced
+    case IDLE_TASK:
+    case MUTE_TASK:
+    case USER_TASK:
+        return false;
+    default:
+        return true;
+    }
+}
+
+uint32_t modem_supervisor_get_file_upload_eta_s( uint8_t session_id )
+{
+    if( ( session_id >= FILE_UPLOAD_NB_SESSIONS ) || ( modem_get_upload_state( session_id ) != MODEM_UPLOAD_ON_GOING ) )
+    {
+        return 0;
+    }
+
+    file_upload_t* file_upload  = &file_upload_context[session_id];
+    uint8_t        fragment_len = file_upload_get_fragment_buffer_size( );
+    uint32_t       nb_fragments = file_upload_get_nb_remaining_fragments( file_upload, fragment_len );
+    if( nb_fragments == 0 )
+    {
+        return 0;
+    }
+
+    uint32_t toa_ms       = lorawan_api_toa_ms_get( lorawan_api_next_dr_get( ), fragment_len );
+    uint32_t spacing_ms   = ( file_upload_get_average_delay_in_s( file_upload ) * 1000 ) + toa_ms;
+    int32_t  dtc_ms       = lorawan_api_next_free_duty_cycle_ms_get( );
+    int32_t  next_frag_s  = ( int32_t )( modem_get_upload_next_time_s( session_id ) - smtc_modem_hal_get_time_in_s( ) );
+    uint64_t eta_ms       = ( next_frag_s > 0 ) ? ( uint64_t ) next_frag_s * 1000 : 0;
+    uint32_t nb_on_budget = nb_fragments;
+    uint32_t regulated_ms = 0;
+
+    if( dtc_ms > 0 )
+    {
+        eta_ms = MAX( eta_ms, ( uint64_t ) dtc_ms );
+    }
+
+    uint32_t period_budget_ms = lorawan_api_duty_cycle_period_budget_ms_get( );
+    if( ( period_budget_ms > 0 ) && ( toa_ms > 0 ) )
+    {
+        // fragments covered by the budget left are only paced by the session average delay, the following ones are
+        // sent at the rate the regulation sustains
+        uint32_t budget_ms = ( dtc_ms < 0 ) ? ( uint32_t )( -dtc_ms ) : 0;
+        nb_on_budget       = MIN( nb_fragments, ( budget_ms / toa_ms ) + 1 );
+        regulated_ms       = ( uint32_t )( ( ( uint64_t ) toa_ms * SMTC_DTC_PERIOD_MS ) / period_budget_ms );
+    }
+
+    eta_ms += ( uint64_t )( nb_on_budget - 1 ) * spacing_ms;
+    eta_ms += ( uint64_t )( nb_fragments - nb_on_budget ) * MAX( spacing_ms, regulated_ms );
+    eta_ms += toa_ms;
+
+    return ( uint32_t )( ( eta_ms + 999 ) / 1000 );
+}
+#endif  // ADD_SMTC_FILE_UPLOAD
+
 void check_class_b_to_generate_event( void )
 {
     bool class_b_bit_stack = lorawan_api_get_class_b_status( );
@@ -180,7 +180,7 @@ typedef struct smtc_modem_services_s
 #endif  // ADD_SMTC_STREAM
 
 #if defined( ADD_SMTC_FILE_UPLOAD )
-    file_upload_t file_upload_ctx;
+    file_upload_t file_upload_ctx[FILE_UPLOAD_NB_SESSIONS];
 #endif  // ADD_SMTC_FILE_UPLOAD
 } smtc_modem_services_t;
 /*
@@ -217,6 +217,18 @@ void init_task( void );
 
 eTask_priority modem_supervisor_get_task_priority( task_id_t id );
 
+#if defined( ADD_SMTC_FILE_UPLOAD )
+/**
+ * @brief Estimate the time left before the last fragment of a file upload session is sent
+ *
+ * @remark Based on the session pacing, the current data rate and the regional duty cycle budget
+ *
+ * @param [in] session_id File upload session
+ * @return uint32_t estimated time left in seconds, 0 if the session is not on going
+ */
+uint32_t modem_supervisor_get_file_upload_eta_s( uint8_t session_id );
+#endif  // ADD_SMTC_FILE_UPLOAD
+
 /*!
  * \brief   Remove a task in supervisor
  * \param [in]  id   - Task id
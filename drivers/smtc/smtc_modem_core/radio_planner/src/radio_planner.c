@@ -59,6 +59,73 @@ static void rp_task_free( const radio_planner_t* rp, rp_task_t* task );
  */
 static void rp_task_update_time( radio_planner_t* rp, uint32_t now );
 
+/**
+ * @brief rp_trace_add record an event in the trace ring
+ *
+ * @param rp pointer to the radioplaner object itself
+ * @param timestamp_100us time of the event in 100us
+ * @param event recorded event
+ * @param hook_id hook id concerned by the event
+ * @param arg event argument, see rp_trace_events_t
+ */
+static inline void rp_trace_add( radio_planner_t* rp, const uint32_t timestamp_100us, const rp_trace_events_t event,
+                                 const uint8_t hook_id, const uint16_t arg );
+
+/**
+ * @brief rp_task_get_priority compute the priority of a task, the lower the value the higher the priority
+ *
+ * @param rp pointer to the radioplaner object itself
+ * @param hook_id id of the task
+ * @param state state of the task, asap or schedule
+ * @param low_priority a schedule task with a low priority is ranked as an asap task
+ * @return the priority of the task
+ */
+static uint8_t rp_task_get_priority( const radio_planner_t* rp, const uint8_t hook_id, const rp_task_states_t state,
+                                     const bool low_priority );
+
+/**
+ * @brief rp_hook_mask_set set a hook in a hook mask
+ *
+ * @param mask hook mask of RP_HOOK_MASK_NB_WORDS words
+ * @param hook_id id of the hook
+ */
+static void rp_hook_mask_set( uint32_t mask[RP_HOOK_MASK_NB_WORDS], const uint8_t hook_id );
+
+/**
+ * @brief rp_hook_get_default_priority_class return the priority class of a RP_HOOK_ID_DEF hook
+ *
+ * @param id target hook id
+ * @return the priority class of the hook
+ */
+static rp_hook_priority_class_t rp_hook_get_default_priority_class( const uint8_t id );
+
+/**
+ * @brief rp_hook_rank_update order the hooks on their priority class then on their id, and update the priority of the
+ * queued tasks
+ *
+ * @param rp pointer to the radioplaner object itself
+ */
+static void rp_hook_rank_update( radio_planner_t* rp );
+
+/**
+ * @brief rp_task_suspend put a preempted suspendable task back in the queue to be resumed as soon as possible
+ *
+ * @param rp pointer to the radioplaner object itself
+ * @param hook_id id of the preempted task
+ * @param now the current time in ms
+ */
+static void rp_task_suspend( radio_planner_t* rp, const uint8_t hook_id, const uint32_t now );
+
+/**
+ * @brief rp_radio_cool_down put the idle radio to sleep unless the next task starts within
+ * RP_TASK_COALESCE_THRESHOLD_MS, in which case it is kept in standby with its TCXO running
+ *
+ * @param rp pointer to the radioplaner object itself
+ * @param next_task_delay_ms delay before the start of the next task in ms, UINT32_MAX if there is none
+ * @param now the current time in ms
+ */
+static void rp_radio_cool_down( radio_planner_t* rp, const uint32_t next_task_delay_ms, const uint32_t now );
+
 /**
  * @brief rp_task_arbiter the core of the radio planer
  *
@@ -76,11 +143,21 @@ static void rp_task_arbiter( radio_planner_t* rp, const char* caller_func_name )
 static void rp_irq_get_status( radio_planner_t* rp, const uint8_t hook_id );
 
 /**
- * @brief rp_task_compute_ranking compute the ranking of the different tasks inside the radio planer
+ * @brief rp_task_queue_update insert or move a task inside the priority and start time heaps
+ *
+ * @param rp pointer to the radioplaner object itself
+ * @param hook_id id of the queued task
+ */
+static void rp_task_queue_update( radio_planner_t* rp, const uint8_t hook_id );
+
+/**
+ * @brief rp_task_collect_past drop the ended tasks from the top of the start time heap and abort the schedule tasks
+ *        which are in the past
  *
  * @param rp pointer to the radioplaner object itself
+ * @param now the current time in ms
  */
-static void rp_task_compute_ranking( radio_planner_t* rp );
+static void rp_task_collect_past( radio_planner_t* rp, const uint32_t now );
 
 /**
  * @brief rp_task_launch_current call  the launch callback of the new running task
@@ -109,14 +186,67 @@ static uint8_t rp_task_select_next( radio_planner_t* rp, const uint32_t now );
  */
 static rp_next_state_status_t rp_task_get_next( radio_planner_t* rp, uint32_t* duration, uint8_t* task_id,
                                                 const uint32_t now );
+
 /**
- * @brief rp_task_find_highest_priority utilities to classify priority task (value 0 is the highest priority)
+ * @brief rp_task_heap_is_before compare the keys of two hooks inside a heap
  *
- * @param vector a vector of value to classify from the lowest to the highest
- * @param length size of the vector
- * @return uint8_t index of the vector to indicate the position inside the vector of the minimum value
+ * @param heap pointer to the heap
+ * @param hook_id_a id of the first hook
+ * @param hook_id_b id of the second hook
+ * @return bool true if the first hook has to be ordered before the second one
  */
-static uint8_t rp_task_find_highest_priority( uint8_t* vector, uint8_t length );
+static bool rp_task_heap_is_before( const rp_task_heap_t* heap, const uint8_t hook_id_a, const uint8_t hook_id_b );
+
+/**
+ * @brief rp_task_heap_set store a hook at a position of a heap
+ *
+ * @param heap pointer to the heap
+ * @param position position inside the heap
+ * @param hook_id id of the hook
+ */
+static void rp_task_heap_set( rp_task_heap_t* heap, const uint8_t position, const uint8_t hook_id );
+
+/**
+ * @brief rp_task_heap_sift restore the heap order around a position whose key has changed
+ *
+ * @param heap pointer to the heap
+ * @param position position of the moved hook
+ */
+static void rp_task_heap_sift( rp_task_heap_t* heap, uint8_t position );
+
+/**
+ * @brief rp_task_heap_init empty a task heap
+ *
+ * @param heap pointer to the heap
+ */
+static void rp_task_heap_init( rp_task_heap_t* heap );
+
+/**
+ * @brief rp_task_heap_update insert a hook inside a heap or move it if its key has changed
+ *
+ * @param heap pointer to the heap
+ * @param hook_id id of the hook
+ * @param key new key of the hook
+ */
+static void rp_task_heap_update( rp_task_heap_t* heap, const uint8_t hook_id, const uint32_t key );
+
+/**
+ * @brief rp_task_heap_remove remove a hook from a heap
+ *
+ * @param heap pointer to the heap
+ * @param hook_id id of the hook, nothing is done if the hook is not inside the heap
+ */
+static void rp_task_heap_remove( rp_task_heap_t* heap, const uint8_t hook_id );
+
+/**
+ * @brief rp_task_heap_get_before list the hooks of a heap with a key strictly before a given key
+ *
+ * @param heap pointer to the heap
+ * @param key the key to compare with
+ * @param hook_ids return the hook ids found, in no particular order (RP_NB_HOOKS elements)
+ * @return uint8_t the number of hook ids found
+ */
+static uint8_t rp_task_heap_get_before( const rp_task_heap_t* heap, const uint32_t key, uint8_t* hook_ids );
 
 /**
  * @brief rp_get_pkt_payload get the receive payload
@@ -131,9 +261,35 @@ rp_hook_status_t rp_get_pkt_payload( radio_planner_t* rp, const rp_task_t* task
  * @brief rp_set_alarm configure the radio planer timer
  *
  * @param rp pointer to the radioplaner object itself
- * @param alarm_in_ms delay in ms (relative value)
+ * @param alarm_in_100us delay in 100us (relative value)
+ */
+static void rp_set_alarm( radio_planner_t* rp, const uint32_t alarm_in_100us );
+
+/**
+ * @brief rp_task_get_delay_100us compute the delay to the start of a task in 100us
+ *
+ * @param task the task
+ * @param now the current time in ms
+ * @param now_100us the current time in 100us
+ * @return int32_t the delay, based on start_time_100us if the task has one, on start_time_ms otherwise
+ */
+static int32_t rp_task_get_delay_100us( const rp_task_t* task, const uint32_t now, const uint32_t now_100us );
+
+/**
+ * @brief rp_margin_update learn the launch margin from a launch latency measurement
+ *
+ * @param rp pointer to the radioplaner object itself
+ * @param latency_100us time between the launch decision and the radio ready to start, in 100us
+ * @param slack_100us time left before the task start when the radio is ready, in 100us
+ */
+static void rp_margin_update( radio_planner_t* rp, const uint32_t latency_100us, const int32_t slack_100us );
+
+/**
+ * @brief rp_timer_refresh start the radio planer timer on the nearest of the arbiter alarm and the radio task timer
+ *
+ * @param rp pointer to the radioplaner object itself
  */
-static void rp_set_alarm( radio_planner_t* rp, const uint32_t alarm_in_ms );
+static void rp_timer_refresh( radio_planner_t* rp );
 
 /**
  * @brief rp_timer_irq function call by the timer callback
@@ -156,6 +312,14 @@ static void rp_task_call_aborted( radio_planner_t* rp );
  * @param time the current time in ms
  */
 static void rp_consumption_statistics_updated( radio_planner_t* rp, const uint8_t hook_id, const uint32_t time );
+/**
+ * @brief rp_warm_statistics_updated compute the statistic (power consumption) of the time the radio was kept warm
+ *
+ * @param rp pointer to the radioplaner object itself
+ * @param hook_id hook id of the task launched on the warm radio, RP_NB_HOOKS if the radio is put to sleep instead
+ * @param time the current time in ms
+ */
+static void rp_warm_statistics_updated( radio_planner_t* rp, const uint8_t hook_id, const uint32_t time );
 /**
  * @brief rp_radio_irq radio callback
  *
@@ -207,12 +371,22 @@ void rp_init( radio_planner_t* rp, const ralf_t* radio )
         rp->hook_callbacks[i]                   = NULL;
         rp->status[i]                           = RP_STATUS_TASK_INIT;
     }
+    for( int32_t i = 0; i < RP_NB_HOOKS; i++ )
+    {
+        rp->hook_priority_class[i] = rp_hook_get_default_priority_class( i );
+    }
     rp->priority_task.type  = RP_TASK_TYPE_NONE;
     rp->priority_task.state = RP_TASK_STATE_FINISHED;
+    rp_task_heap_init( &rp->priority_heap );
+    rp_task_heap_init( &rp->start_time_heap );
+    rp_hook_rank_update( rp );
     rp_stats_init( &rp->stats );
 
-    rp->next_state_status = RP_STATUS_NO_MORE_TASK_SCHEDULE;
-    rp->margin_delay      = RP_MARGIN_DELAY;
+    rp->next_state_status        = RP_STATUS_NO_MORE_TASK_SCHEDULE;
+    rp->margin_delay             = RP_MARGIN_DELAY;
+    rp->margin_delay_100us       = RP_MARGIN_DELAY * 10;
+    rp->launch_latency_100us     = rp->margin_delay_100us - RP_MARGIN_GUARD_100US;
+    rp->stats.margin_delay_100us = rp->margin_delay_100us;
 }
 
 rp_hook_status_t rp_hook_init( radio_planner_t* rp, const uint8_t id, void ( *callback )( void* context ), void* hook )
@@ -243,9 +417,39 @@ rp_hook_status_t rp_release_hook( radio_planner_t* rp, uint8_t id )
 
     rp->hook_callbacks[id]                   = NULL;
     rp->tasks[id].schedule_task_low_priority = false;
+    if( id >= RP_HOOK_ID_MAX )
+    {  // The dynamic hook can be allocated again, its context must not be found anymore
+        rp->hooks[id] = NULL;
+    }
     return RP_HOOK_STATUS_OK;
 }
 
+rp_hook_status_t rp_hook_alloc( radio_planner_t* rp, const rp_hook_priority_class_t priority_class,
+                                void ( *callback )( void* context ), void* hook, uint8_t* id )
+{
+    if( ( callback == NULL ) || ( priority_class > RP_HOOK_PRIORITY_CLASS_BACKGROUND ) )
+    {
+        return RP_HOOK_STATUS_ID_ERROR;
+    }
+
+    for( uint8_t i = RP_HOOK_ID_MAX; i < RP_NB_HOOKS; i++ )
+    {
+        if( rp->hook_callbacks[i] == NULL )
+        {
+            rp_hal_critical_section_begin( );
+            rp->hook_priority_class[i] = priority_class;
+            rp_hook_rank_update( rp );
+            rp_hal_critical_section_end( );
+
+            *id = i;
+            SMTC_MODEM_HAL_RP_TRACE_PRINTF( "RP: Hook #%u allocated in priority class %u\n", i, priority_class );
+            return rp_hook_init( rp, i, callback, hook );
+        }
+    }
+    SMTC_MODEM_HAL_TRACE_WARNING( "RP: No hook left to allocate\n" );
+    return RP_HOOK_STATUS_ID_ERROR;
+}
+
 rp_hook_status_t rp_hook_get_id( const radio_planner_t* rp, const void* hook, uint8_t* id )
 {
     for( int32_t i = 0; i < RP_NB_HOOKS; i++ )
@@ -301,17 +505,13 @@ rp_hook_status_t rp_task_enqueue( radio_planner_t* rp, const rp_task_t* task, ui
     rp->radio_params[hook_id] = *radio_params;
     rp->payload[hook_id]      = payload;
     rp->payload_size[hook_id] = payload_size;
-    if( rp->tasks[hook_id].schedule_task_low_priority == true )
-    {
-        rp->tasks[hook_id].priority = ( RP_TASK_STATE_ASAP * RP_NB_HOOKS ) + hook_id;
-    }
-    else
-    {
-        rp->tasks[hook_id].priority = ( rp->tasks[hook_id].state * RP_NB_HOOKS ) + hook_id;
-    }
+    rp->tasks[hook_id].priority = rp_task_get_priority( rp, hook_id, rp->tasks[hook_id].state,
+                                                        rp->tasks[hook_id].schedule_task_low_priority );
     rp->tasks[hook_id].start_time_init_ms = rp->tasks[hook_id].start_time_ms;
     SMTC_MODEM_HAL_RP_TRACE_PRINTF( "RP: Task #%u enqueue with #%u priority\n", hook_id, rp->tasks[hook_id].priority );
-    rp_task_compute_ranking( rp );
+    rp_trace_add( rp, rp_hal_get_time_in_100us( ), RP_TRACE_EVENT_ENQUEUE, hook_id,
+                  ( uint16_t ) ( ( task->state << 8 ) | task->type ) );
+    rp_task_queue_update( rp, hook_id );
     if( rp->semaphore_radio == 0 )
     {
         rp_task_arbiter( rp, __func__ );
@@ -354,6 +554,82 @@ rp_hook_status_t rp_task_abort( radio_planner_t* rp, const uint8_t hook_id )
     return RP_HOOK_STATUS_OK;
 }
 
+rp_hook_status_t rp_task_admission_check( const radio_planner_t* rp, const rp_task_t* task,
+                                          rp_task_admission_t* result )
+{
+    uint8_t  hook_id = task->hook_id;
+    uint32_t now     = rp_hal_get_time_in_ms( );
+    uint8_t  priority;
+    uint32_t start;
+    bool     moved;
+
+    memset( result, 0, sizeof( rp_task_admission_t ) );
+    if( ( hook_id >= RP_NB_HOOKS ) || ( task->state > RP_TASK_STATE_ASAP ) )
+    {
+        return RP_HOOK_STATUS_ID_ERROR;
+    }
+    if( ( task->state == RP_TASK_STATE_SCHEDULE ) && ( ( int32_t )( task->start_time_ms - now ) <= 0 ) )
+    {
+        return RP_TASK_STATUS_SCHEDULE_TASK_IN_PAST;
+    }
+    if( rp->tasks[hook_id].state == RP_TASK_STATE_RUNNING )
+    {
+        return RP_TASK_STATUS_ALREADY_RUNNING;
+    }
+
+    priority = rp_task_get_priority( rp, hook_id, task->state, task->schedule_task_low_priority );
+    start = ( ( task->state == RP_TASK_STATE_ASAP ) && ( ( int32_t )( task->start_time_ms - now ) < 0 ) )
+                ? now
+                : task->start_time_ms;
+
+    // Move an asap task after the higher priority tasks it overlaps until it fits
+    do
+    {
+        moved                   = false;
+        memset( result->preempted_hooks, 0, sizeof( result->preempted_hooks ) );
+        for( uint8_t i = 0; i < RP_NB_HOOKS; i++ )
+        {
+            const rp_task_t* other       = &rp->tasks[i];
+            uint32_t         other_start = other->start_time_ms;
+
+            // A schedule task in the past will not be launched, a queued asap task starts at the earliest now
+            if( ( i == hook_id ) || ( other->state > RP_TASK_STATE_RUNNING ) ||
+                ( ( other->state == RP_TASK_STATE_SCHEDULE ) && ( ( int32_t )( other_start - now ) < 0 ) ) )
+            {
+                continue;
+            }
+            if( ( other->state == RP_TASK_STATE_ASAP ) && ( ( int32_t )( other_start - now ) < 0 ) )
+            {
+                other_start = now;
+            }
+            // Overlap of [start, start + duration[ and [other start, other start + other duration[
+            if( ( ( int32_t )( start - ( other_start + other->duration_time_ms ) ) >= 0 ) ||
+                ( ( int32_t )( other_start - ( start + task->duration_time_ms ) ) >= 0 ) )
+            {
+                continue;
+            }
+            if( priority < other->priority )
+            {
+                rp_hook_mask_set( result->preempted_hooks, i );
+            }
+            else
+            {
+                rp_hook_mask_set( result->blocking_hooks, i );
+                if( task->state == RP_TASK_STATE_SCHEDULE )
+                {
+                    return RP_HOOK_STATUS_OK;
+                }
+                start = other_start + other->duration_time_ms;
+                moved = true;
+            }
+        }
+    } while( moved == true );
+
+    result->admitted          = true;
+    result->expected_start_ms = start;
+    return RP_HOOK_STATUS_OK;
+}
+
 void rp_get_status( const radio_planner_t* rp, const uint8_t id, uint32_t* irq_timestamp_ms, rp_status_t* status )
 {
     if( id >= RP_NB_HOOKS )
@@ -382,6 +658,70 @@ rp_stats_t rp_get_stats( const radio_planner_t* rp )
     return rp->stats;
 }
 
+void rp_get_stats_hooks_snapshot( radio_planner_t* rp, rp_stats_hook_t* snapshot, const bool reset )
+{
+    rp_hal_critical_section_begin( );
+    if( snapshot != NULL )
+    {
+        memcpy( snapshot, rp->stats.hooks, sizeof( rp->stats.hooks ) );
+    }
+    if( reset == true )
+    {
+        rp_stats_reset_hooks( &rp->stats );
+    }
+    rp_hal_critical_section_end( );
+}
+
+uint16_t rp_trace_read( radio_planner_t* rp, uint32_t* next_index, rp_trace_record_t* records, const uint16_t max_nb )
+{
+    uint16_t nb = 0;
+
+    rp_hal_critical_section_begin( );
+    // Skip the records which have been overwritten
+    if( ( int32_t )( rp->trace.index - *next_index ) > RP_TRACE_NB_RECORDS )
+    {
+        *next_index = rp->trace.index - RP_TRACE_NB_RECORDS;
+    }
+    while( ( nb < max_nb ) && ( ( int32_t )( rp->trace.index - *next_index ) > 0 ) )
+    {
+        records[nb++] = rp->trace.records[*next_index % RP_TRACE_NB_RECORDS];
+        ( *next_index )++;
+    }
+    rp_hal_critical_section_end( );
+    return nb;
+}
+
+void rp_radio_task_timer_start( radio_planner_t* rp, const uint32_t alarm_in_ms, void ( *callback )( void* rp ) )
+{
+    rp->radio_task_timer_hook_id  = rp->radio_task_id;
+    rp->radio_task_timer_100us    = rp_hal_get_time_in_100us( ) + ( alarm_in_ms * 10 );
+    rp->radio_task_timer_callback = callback;
+    rp_timer_refresh( rp );
+}
+
+void rp_task_wait_start( radio_planner_t* rp, const uint8_t hook_id )
+{
+    const rp_task_t* task        = &rp->tasks[hook_id];
+    uint32_t         ready_100us = rp_hal_get_time_in_100us( );
+    uint32_t         latency     = ready_100us - rp->launch_origin_100us;
+
+    rp_trace_add( rp, ready_100us, RP_TRACE_EVENT_READY, hook_id, ( latency > UINT16_MAX ) ? UINT16_MAX : latency );
+    rp_margin_update( rp, latency, rp_task_get_delay_100us( task, rp_hal_get_time_in_ms( ), ready_100us ) );
+
+    if( task->start_time_100us != 0 )
+    {
+        while( ( int32_t )( task->start_time_100us - rp_hal_get_time_in_100us( ) ) > 0 )
+        {
+        }
+    }
+    else
+    {
+        while( ( int32_t )( task->start_time_ms - rp_hal_get_time_in_ms( ) ) > 0 )
+        {
+        }
+    }
+}
+
 void rp_radio_irq( radio_planner_t* rp )
 {
     if( rp->tasks[rp->radio_task_id].state < RP_TASK_STATE_ABORTED )
@@ -394,6 +734,8 @@ void rp_radio_irq( radio_planner_t* rp )
         SMTC_MODEM_HAL_RP_TRACE_PRINTF( " RP: INFO - Radio IRQ received for hook #%u\n", rp->radio_task_id );
 
         rp_irq_get_status( rp, rp->radio_task_id );
+        rp_trace_add( rp, irq_timestamp_100us, RP_TRACE_EVENT_RADIO_IRQ, rp->radio_task_id,
+                      rp->status[rp->radio_task_id] );
         if( rp->status[rp->radio_task_id] == RP_STATUS_LR_FHSS_HOP )
         {
             return;
@@ -419,14 +761,22 @@ void rp_radio_irq( radio_planner_t* rp )
         // Have to call rp_task_free before rp_hook_callback because the callback can enqueued a task and so call the
         // arbiter
         rp_task_free( rp, &rp->tasks[rp->radio_task_id] );
-        smtc_modem_hal_assert( ral_set_sleep( &( rp->radio->ral ), true ) == RAL_STATUS_OK );
+
+        // The callback may enqueue the next task (RX1 after TX, ...), keep the radio in standby with its TCXO running
+        // until the arbiter knows when the next task starts
+        smtc_modem_hal_assert( ral_set_standby( &( rp->radio->ral ), RAL_STANDBY_CFG_XOSC ) == RAL_STATUS_OK );
+        rp->radio_warm          = true;
+        rp->radio_warm_start_ms = rp->irq_timestamp_ms[rp->radio_task_id];
+
         rp_hook_callback( rp, rp->radio_task_id );
 
         rp_task_call_aborted( rp );
 
         rp->semaphore_radio = 0;
 
+        // The arbiter launches the next task on the warm radio, keeps it warm or puts it to sleep
         rp_task_arbiter( rp, __func__ );
+        return;
     }
     else
     {
@@ -434,7 +784,7 @@ void rp_radio_irq( radio_planner_t* rp )
     }
 
     // Shut Down the TCXO
-    smtc_modem_hal_stop_radio_tcxo( );
+    rp_hal_stop_radio_tcxo( );
 }
 //
 // Private planner utilities implementation
@@ -453,33 +803,32 @@ static void rp_task_free( const radio_planner_t* rp, rp_task_t* task )
 
 static void rp_task_update_time( radio_planner_t* rp, uint32_t now )
 {
-    for( int32_t i = 0; i < RP_NB_HOOKS; i++ )
+    uint8_t late[RP_NB_HOOKS];
+    uint8_t late_nb;
+
+    // Asap tasks are keyed on their init time inside the start time heap, only the tasks queued before now are visited
+    late_nb = rp_task_heap_get_before( &rp->start_time_heap, now, late );
+    for( uint8_t j = 0; j < late_nb; j++ )
     {
+        uint8_t i = late[j];
+
         if( rp->tasks[i].state == RP_TASK_STATE_ASAP )
         {
-            if( ( int32_t )( now - rp->tasks[i].start_time_init_ms ) > 0 )
-            {
-                rp->tasks[i].start_time_ms = now;
-            }
-            // An asap task is automatically switch in schedule task after RP_TASK_ASAP_TO_SCHEDULE_TRIG_TIME ms
+            // The key of the task does not change, it keeps its place inside the heaps
+            rp->tasks[i].start_time_ms = now;
 
+            // An asap task is automatically switch in schedule task after RP_TASK_ASAP_TO_SCHEDULE_TRIG_TIME ms
             if( ( int32_t )( now - rp->tasks[i].start_time_init_ms ) > RP_TASK_ASAP_TO_SCHEDULE_TRIG_TIME )
             {
                 rp->tasks[i].state = RP_TASK_STATE_SCHEDULE;
                 // Schedule the task @ now + RP_TASK_RE_SCHEDULE_OFFSET_TIME
                 // seconds
                 rp->tasks[i].start_time_ms = now + RP_TASK_RE_SCHEDULE_OFFSET_TIME;
-                if( rp->tasks[i].schedule_task_low_priority == true )
-                {
-                    rp->tasks[i].priority = ( RP_TASK_STATE_ASAP * RP_NB_HOOKS ) + i;
-                }
-                else
-                {
-                    rp->tasks[i].priority = ( rp->tasks[i].state * RP_NB_HOOKS ) + i;
-                }
+                rp->tasks[i].priority =
+                    rp_task_get_priority( rp, i, rp->tasks[i].state, rp->tasks[i].schedule_task_low_priority );
 
                 SMTC_MODEM_HAL_RP_TRACE_PRINTF( "RP: WARNING - SWITCH TASK FROM ASAP TO SCHEDULE \n" );
-                rp_task_compute_ranking( rp );
+                rp_task_queue_update( rp, i );
             }
         }
     }
@@ -495,9 +844,137 @@ static void rp_task_update_time( radio_planner_t* rp, uint32_t now )
     }
 }
 
+static inline void rp_trace_add( radio_planner_t* rp, const uint32_t timestamp_100us, const rp_trace_events_t event,
+                                 const uint8_t hook_id, const uint16_t arg )
+{
+    rp_trace_record_t* record = &rp->trace.records[rp->trace.index % RP_TRACE_NB_RECORDS];
+
+    record->timestamp_100us = timestamp_100us;
+    record->event           = event;
+    record->hook_id         = hook_id;
+    record->arg             = arg;
+    rp->trace.index++;
+}
+
+static uint8_t rp_task_get_priority( const radio_planner_t* rp, const uint8_t hook_id, const rp_task_states_t state,
+                                     const bool low_priority )
+{
+    return ( ( ( low_priority == true ) ? RP_TASK_STATE_ASAP : state ) * RP_NB_HOOKS ) + rp->hook_rank[hook_id];
+}
+
+static void rp_hook_mask_set( uint32_t mask[RP_HOOK_MASK_NB_WORDS], const uint8_t hook_id )
+{
+    mask[hook_id / 32] |= ( 1UL << ( hook_id % 32 ) );
+}
+
+static rp_hook_priority_class_t rp_hook_get_default_priority_class( const uint8_t id )
+{
+    switch( id )
+    {
+#if !defined( LR1110_MODEM_E )
+    case RP_HOOK_ID_USER_SUSPEND:
+    case RP_HOOK_ID_USER_SUSPEND_0:
+#endif  // !LR1110_MODEM_E
+    case RP_HOOK_ID_SUSPEND:
+        return RP_HOOK_PRIORITY_CLASS_SUSPEND;
+    case RP_HOOK_ID_LR1MAC_STACK:
+    case RP_HOOK_ID_LBT:
+    case RP_HOOK_ID_RTC_COMPENSATION:
+        return RP_HOOK_PRIORITY_CLASS_MAC;
+    case RP_HOOK_ID_CLASS_B_BEACON:
+#if defined( SMTC_D2D )
+    case RP_HOOK_ID_CLASS_B_D2D:
+#endif  // SMTC_D2D
+    case RP_HOOK_ID_CLASS_B_PING_SLOT:
+        return RP_HOOK_PRIORITY_CLASS_CLASS_B;
+    case RP_HOOK_ID_USER_SUSPEND_1:
+#if !defined( LR1110_MODEM_E )
+    case RP_HOOK_ID_USER_SUSPEND_2:
+#endif  // !LR1110_MODEM_E
+        return RP_HOOK_PRIORITY_CLASS_USER;
+    default:
+        return RP_HOOK_PRIORITY_CLASS_BACKGROUND;
+    }
+}
+
+static void rp_hook_rank_update( radio_planner_t* rp )
+{
+    // The RP_HOOK_ID_DEF hooks are declared in class order, without dynamic hooks the rank is the hook id
+    for( int32_t i = 0; i < RP_NB_HOOKS; i++ )
+    {
+        uint8_t rank = 0;
+
+        for( int32_t j = 0; j < RP_NB_HOOKS; j++ )
+        {
+            if( ( rp->hook_priority_class[j] < rp->hook_priority_class[i] ) ||
+                ( ( rp->hook_priority_class[j] == rp->hook_priority_class[i] ) && ( j < i ) ) )
+            {
+                rank++;
+            }
+        }
+        rp->hook_rank[i] = rank;
+    }
+
+    // The priority of the current tasks embeds the rank, keep their state part and requeue them
+    for( int32_t i = 0; i < RP_NB_HOOKS; i++ )
+    {
+        rp->tasks[i].priority = ( ( rp->tasks[i].priority / RP_NB_HOOKS ) * RP_NB_HOOKS ) + rp->hook_rank[i];
+        if( rp->tasks[i].state <= RP_TASK_STATE_ASAP )
+        {
+            rp_task_queue_update( rp, i );
+        }
+    }
+}
+
+static void rp_task_suspend( radio_planner_t* rp, const uint8_t hook_id, const uint32_t now )
+{
+    // The duration of a running rx task is extended on each arbiter call, the rest is counted from its planned end
+    rp_task_t* task    = &rp->tasks[hook_id];
+    int32_t    remains = ( int32_t )( rp->radio_task_end_ms - now );
+
+    SMTC_MODEM_HAL_RP_TRACE_PRINTF( "RP: Suspend running task with hook #%u\n", hook_id );
+    rp->stats.task_hook_suspended_nb[hook_id]++;
+    rp_trace_add( rp, rp_hal_get_time_in_100us( ), RP_TRACE_EVENT_SUSPEND, hook_id,
+                  ( remains <= 0 ) ? 0 : ( ( remains > UINT16_MAX ) ? UINT16_MAX : remains ) );
+
+    // The task keeps its priority and is launched again as an ASAP task for the rest of its duration
+    task->state              = RP_TASK_STATE_ASAP;
+    task->start_time_ms      = now;
+    task->start_time_init_ms = now;
+    task->start_time_100us   = 0;
+    task->duration_time_ms   = ( remains > 0 ) ? ( uint32_t ) remains : 0;
+    rp_task_queue_update( rp, hook_id );
+}
+
+static void rp_radio_cool_down( radio_planner_t* rp, const uint32_t next_task_delay_ms, const uint32_t now )
+{
+    if( ( rp->radio_warm == false ) || ( rp->tasks[rp->radio_task_id].state == RP_TASK_STATE_RUNNING ) )
+    {
+        return;
+    }
+
+    if( next_task_delay_ms <= RP_TASK_COALESCE_THRESHOLD_MS )
+    {
+        SMTC_MODEM_HAL_RP_TRACE_PRINTF( " RP: Keep radio warm, next task in %lu ms\n", next_task_delay_ms );
+        return;
+    }
+
+    rp_warm_statistics_updated( rp, RP_NB_HOOKS, now );
+    rp->radio_warm = false;
+    smtc_modem_hal_assert( ral_set_sleep( &( rp->radio->ral ), true ) == RAL_STATUS_OK );
+
+    // Shut Down the TCXO
+    rp_hal_stop_radio_tcxo( );
+}
+
 static void rp_task_arbiter( radio_planner_t* rp, const char* caller_func_name )
 {
-    uint32_t now = rp_hal_get_time_in_ms( );
+    uint32_t now       = rp_hal_get_time_in_ms( );
+    uint32_t now_100us = rp_hal_get_time_in_100us( );
+
+    // A task launched now is late by the alarm latency if the arbiter is called by the alarm
+    rp->launch_origin_100us = ( rp->alarm_fired == true ) ? rp->alarm_100us : now_100us;
+    rp->alarm_fired         = false;
 
     // Update time for ASAP task to now. But, also extended duration in case of running task is a RX task
     rp_task_update_time( rp, now );
@@ -505,7 +982,8 @@ static void rp_task_arbiter( radio_planner_t* rp, const char* caller_func_name )
     // Select the high priority task
     if( rp_task_select_next( rp, now ) == RP_SOMETHING_TO_DO )
     {  // Next task exists
-        int32_t delay = ( int32_t )( rp->priority_task.start_time_ms - now );
+        int32_t delay       = ( int32_t )( rp->priority_task.start_time_ms - now );
+        int32_t delay_100us = rp_task_get_delay_100us( &rp->priority_task, now, now_100us );
         SMTC_MODEM_HAL_RP_TRACE_PRINTF(
             " RP: Arbiter has been called by %s and priority-task #%d, timer hook #%d, delay %d, now %d\n ",
             caller_func_name, rp->priority_task.hook_id, rp->timer_hook_id, delay, now );
@@ -522,7 +1000,7 @@ static void rp_task_arbiter( radio_planner_t* rp, const char* caller_func_name )
             }
         }
         // Case where the high priority task is in the future
-        else if( ( uint32_t ) delay > rp->margin_delay )
+        else if( delay_100us > ( int32_t ) rp->margin_delay_100us )
         {  // The high priority task is in the future
             SMTC_MODEM_HAL_RP_TRACE_PRINTF( " RP: High priority task is in the future\n" );
         }
@@ -532,41 +1010,67 @@ static void rp_task_arbiter( radio_planner_t* rp, const char* caller_func_name )
             if( rp->tasks[rp->radio_task_id].state == RP_TASK_STATE_RUNNING )
             {  // Radio is already running
                 if( rp->tasks[rp->radio_task_id].hook_id != rp->priority_task.hook_id )
-                {  // priority task not equal to radio task => abort radio task
-                    rp->tasks[rp->radio_task_id].state = RP_TASK_STATE_ABORTED;
-                    SMTC_MODEM_HAL_RP_TRACE_PRINTF( "RP: Abort running task with hook #%u\n", rp->radio_task_id );
+                {  // priority task not equal to radio task => suspend or abort radio task
+                    bool suspended = rp->tasks[rp->radio_task_id].suspendable;
+
+                    rp_consumption_statistics_updated( rp, rp->radio_task_id, rp_hal_get_time_in_ms( ) );
 
-                    smtc_modem_hal_assert( ral_set_standby( &( rp->radio->ral ), RAL_STANDBY_CFG_RC ) ==
+                    if( suspended == true )
+                    {
+                        rp_task_suspend( rp, rp->radio_task_id, now );
+                    }
+                    else
+                    {
+                        rp->tasks[rp->radio_task_id].state = RP_TASK_STATE_ABORTED;
+                        SMTC_MODEM_HAL_RP_TRACE_PRINTF( "RP: Abort running task with hook #%u\n", rp->radio_task_id );
+                    }
+
+                    // Keep the radio warm if the suspended task can be resumed shortly
+                    rp->radio_warm = ( suspended == true ) &&
+                                     ( rp->priority_task.duration_time_ms <= RP_TASK_SUSPEND_WARM_DURATION_MS );
+
+                    smtc_modem_hal_assert( ral_set_standby( &( rp->radio->ral ), ( rp->radio_warm == true )
+                                                                                     ? RAL_STANDBY_CFG_XOSC
+                                                                                     : RAL_STANDBY_CFG_RC ) ==
                                            RAL_STATUS_OK );
                     smtc_modem_hal_assert( ral_clear_irq_status( &( rp->radio->ral ), RAL_IRQ_ALL ) == RAL_STATUS_OK );
 
                     rp_hal_irq_clear_pending( );
 
-                    smtc_modem_hal_assert( ral_set_sleep( &( rp->radio->ral ), true ) == RAL_STATUS_OK );
+                    if( rp->radio_warm == false )
+                    {
+                        smtc_modem_hal_assert( ral_set_sleep( &( rp->radio->ral ), true ) == RAL_STATUS_OK );
 
-                    // Shut Down the TCXO
-                    smtc_modem_hal_stop_radio_tcxo( );
-
-                    rp_consumption_statistics_updated( rp, rp->radio_task_id, rp_hal_get_time_in_ms( ) );
+                        // Shut Down the TCXO
+                        rp_hal_stop_radio_tcxo( );
+                    }
 
                     rp->radio_task_id                  = rp->priority_task.hook_id;
                     rp->tasks[rp->radio_task_id].state = RP_TASK_STATE_RUNNING;
+                    rp_task_heap_remove( &rp->start_time_heap, rp->radio_task_id );
                     rp_task_launch_current( rp );
                 }  // else case already managed during enqueue task
             }
             else
-            {  // Radio is sleeping start priority task on radio
+            {  // Radio is sleeping or kept warm, start priority task on radio
+                if( rp->radio_warm == true )
+                {
+                    rp_warm_statistics_updated( rp, rp->priority_task.hook_id, now );
+                    rp->radio_warm = false;
+                }
                 rp->radio_task_id                  = rp->priority_task.hook_id;
                 rp->tasks[rp->radio_task_id].state = RP_TASK_STATE_RUNNING;
+                rp_task_heap_remove( &rp->start_time_heap, rp->radio_task_id );
                 rp_task_launch_current( rp );
             }
         }
         // Timer has expired on a not priority task => Have to abort this task
-        int32_t tmp = ( int32_t )( rp->tasks[rp->timer_hook_id].start_time_ms - now );
+        int32_t tmp = rp_task_get_delay_100us( &rp->tasks[rp->timer_hook_id], now, now_100us );
 
         if( tmp > 0 )
         {
-            if( ( ( uint32_t ) tmp < rp->margin_delay ) && ( rp->next_state_status == RP_STATUS_HAVE_TO_SET_TIMER ) &&
+            if( ( ( uint32_t ) tmp < rp->margin_delay_100us ) &&
+                ( rp->next_state_status == RP_STATUS_HAVE_TO_SET_TIMER ) &&
                 ( rp->timer_hook_id != rp->priority_task.hook_id ) &&
                 ( rp->tasks[rp->timer_hook_id].state == RP_TASK_STATE_SCHEDULE ) )
             {
@@ -582,24 +1086,32 @@ static void rp_task_arbiter( radio_planner_t* rp, const char* caller_func_name )
         }
 
         // Set the Timer to the next Task
-        rp->next_state_status = rp_task_get_next( rp, &rp->timer_value, &rp->timer_hook_id, rp_hal_get_time_in_ms( ) );
+        now                   = rp_hal_get_time_in_ms( );
+        now_100us             = rp_hal_get_time_in_100us( );
+        rp->next_state_status = rp_task_get_next( rp, &rp->timer_value, &rp->timer_hook_id, now );
 
         if( rp->next_state_status == RP_STATUS_HAVE_TO_SET_TIMER )
         {
-            if( rp->timer_value > rp->margin_delay )
+            int32_t timer_value_100us = rp_task_get_delay_100us( &rp->tasks[rp->timer_hook_id], now, now_100us );
+
+            if( timer_value_100us > ( int32_t ) rp->margin_delay_100us )
             {
-                rp_set_alarm( rp, rp->timer_value - rp->margin_delay );
+                rp_set_alarm( rp, timer_value_100us - rp->margin_delay_100us );
             }
             else
             {
-                rp_set_alarm( rp, 1 );
+                rp_set_alarm( rp, RP_ALARM_RETRY_100US );
             }
         }
+        // The priority task is the next one launched, a queued asap task starting before it waits for it
+        int32_t next_task_delay = ( int32_t )( rp->priority_task.start_time_ms - now );
+        rp_radio_cool_down( rp, ( next_task_delay >= 0 ) ? ( uint32_t ) next_task_delay : UINT32_MAX, now );
     }
     else
     {  // No more tasks in the radio planner
         rp_task_call_aborted( rp );
         SMTC_MODEM_HAL_RP_TRACE_PRINTF( " RP: No more active tasks\n" );
+        rp_radio_cool_down( rp, UINT32_MAX, now );
     }
 }
 
@@ -680,20 +1192,42 @@ static void rp_irq_get_status( radio_planner_t* rp, const uint8_t hook_id )
     }
 }
 
-static void rp_task_compute_ranking( radio_planner_t* rp )
+static void rp_task_queue_update( radio_planner_t* rp, const uint8_t hook_id )
 {
-    uint8_t rank;
-    uint8_t ranks_temp[RP_NB_HOOKS];
+    const rp_task_t* task = &rp->tasks[hook_id];
 
-    for( int32_t i = 0; i < RP_NB_HOOKS; i++ )
+    // An asap task starts at max(init time, now): keyed on its init time, it keeps its place while it waits
+    rp_task_heap_update( &rp->priority_heap, hook_id, task->priority );
+    rp_task_heap_update( &rp->start_time_heap, hook_id,
+                         ( task->state == RP_TASK_STATE_ASAP ) ? task->start_time_init_ms : task->start_time_ms );
+}
+
+static void rp_task_collect_past( radio_planner_t* rp, const uint32_t now )
+{
+    uint8_t past[RP_NB_HOOKS];
+    uint8_t past_nb = rp_task_heap_get_before( &rp->start_time_heap, now, past );
+
+    // The asap tasks queued before now are kept, they start now
+    for( uint8_t i = 0; i < past_nb; i++ )
     {
-        ranks_temp[i] = rp->tasks[i].priority;
+        uint8_t hook_id = past[i];
+
+        if( rp->tasks[hook_id].state == RP_TASK_STATE_ASAP )
+        {
+            continue;
+        }
+        if( rp->tasks[hook_id].state == RP_TASK_STATE_SCHEDULE )
+        {
+            rp->tasks[hook_id].state = RP_TASK_STATE_ABORTED;
+        }
+        rp_task_heap_remove( &rp->start_time_heap, hook_id );
     }
-    for( int32_t i = 0; i < RP_NB_HOOKS; i++ )
+
+    // The earliest task left is a queued one once the ended tasks on top have been dropped
+    while( ( rp->start_time_heap.nb > 0 ) &&
+           ( rp->tasks[rp->start_time_heap.hook_id[0]].state >= RP_TASK_STATE_RUNNING ) )
     {
-        rank             = rp_task_find_highest_priority( &( ranks_temp[0] ), RP_NB_HOOKS );
-        ranks_temp[rank] = 0xFF;
-        rp->rankings[i]  = rank;
+        rp_task_heap_remove( &rp->start_time_heap, rp->start_time_heap.hook_id[0] );
     }
 }
 
@@ -709,6 +1243,10 @@ static void rp_task_launch_current( radio_planner_t* rp )
     else
     {
         rp_task_print( rp, &rp->tasks[id] );
+        rp_trace_add( rp, rp_hal_get_time_in_100us( ), RP_TRACE_EVENT_LAUNCH, id, rp->tasks[id].type );
+        // A timer started by the previous radio task is meaningless for the new one
+        rp->radio_task_timer_callback = NULL;
+        rp->radio_task_end_ms         = rp->tasks[id].start_time_ms + rp->tasks[id].duration_time_ms;
         rp->tasks[id].launch_task_callbacks( ( void* ) rp );
     }
 }
@@ -718,48 +1256,76 @@ static uint8_t rp_task_select_next( radio_planner_t* rp, const uint32_t now )
     uint8_t  hook_to_exe_tmp      = 0xFF;
     uint32_t hook_time_to_exe_tmp = 0;
     uint32_t time_tmp             = 0;
-    uint8_t  rank                 = 0;
     uint8_t  hook_id              = 0;
+    uint8_t  candidates[RP_NB_HOOKS];
+    uint8_t  candidates_nb = 0;
 
-    for( hook_id = 0; hook_id < RP_NB_HOOKS; hook_id++ )
-    {  // Garbage collector
-        if( ( rp->tasks[hook_id].state == RP_TASK_STATE_SCHEDULE ) &&
-            ( ( ( int32_t )( rp->tasks[hook_id].start_time_ms - now ) < 0 ) ) )
-        {
-            rp->tasks[hook_id].state = RP_TASK_STATE_ABORTED;
-        }
-    }
-    for( hook_id = 0; hook_id < RP_NB_HOOKS; hook_id++ )
+    // Garbage collector
+    rp_task_collect_past( rp, now );
+
+    // The highest priority task is on top of the priority heap once the ended tasks have been dropped
+    while( rp->priority_heap.nb > 0 )
     {
-        rank = rp->rankings[hook_id];
-        if( ( ( rp->tasks[rank].state < RP_TASK_STATE_RUNNING ) &&
-              ( ( int32_t )( rp->tasks[rank].start_time_ms - now ) >= 0 ) ) ||
-            ( rp->tasks[rank].state == RP_TASK_STATE_RUNNING ) )
+        hook_id = rp->priority_heap.hook_id[0];
+        if( ( ( rp->tasks[hook_id].state < RP_TASK_STATE_RUNNING ) &&
+              ( ( int32_t )( rp->tasks[hook_id].start_time_ms - now ) >= 0 ) ) ||
+            ( rp->tasks[hook_id].state == RP_TASK_STATE_RUNNING ) )
         {
-            hook_to_exe_tmp      = rp->tasks[rank].hook_id;
-            hook_time_to_exe_tmp = rp->tasks[rank].start_time_ms;
             break;
         }
+        rp_task_heap_remove( &rp->priority_heap, hook_id );
     }
-    if( hook_id == RP_NB_HOOKS )
+    if( rp->priority_heap.nb == 0 )
     {
         return RP_NO_MORE_TASK;
     }
+    hook_to_exe_tmp      = hook_id;
+    hook_time_to_exe_tmp = rp->tasks[hook_id].start_time_ms;
+
+    // A lower priority task is executed first if it ends before the start of the highest priority one, so only the
+    // tasks starting before it (and the running task) are candidates
+    candidates_nb = rp_task_heap_get_before( &rp->start_time_heap, hook_time_to_exe_tmp, candidates );
+    if( ( rp->tasks[rp->radio_task_id].state == RP_TASK_STATE_RUNNING ) && ( rp->radio_task_id != hook_to_exe_tmp ) )
+    {
+        candidates[candidates_nb++] = rp->radio_task_id;
+    }
+
+    // Candidates are checked from the highest to the lowest priority
+    for( uint8_t i = 1; i < candidates_nb; i++ )
+    {
+        uint8_t candidate = candidates[i];
+        uint8_t j         = i;
+
+        while( ( j > 0 ) && ( rp->tasks[candidates[j - 1]].priority > rp->tasks[candidate].priority ) )
+        {
+            candidates[j] = candidates[j - 1];
+            j--;
+        }
+        candidates[j] = candidate;
+    }
 
-    for( int32_t i = hook_id; i < RP_NB_HOOKS; i++ )
+    for( uint8_t i = 0; i < candidates_nb; i++ )
     {
-        rank = rp->rankings[i];
-        if( ( ( rp->tasks[rank].state < RP_TASK_STATE_RUNNING ) &&
-              ( ( int32_t )( rp->tasks[rank].start_time_ms - now ) >= 0 ) ) ||
-            ( rp->tasks[rank].state == RP_TASK_STATE_RUNNING ) )
+        hook_id = candidates[i];
+        // A task of a lower priority never preempts the running task, even if it would end before its start (a
+        // resumed task often has only a few ms left while the running task is launched a margin before its start)
+        if( ( rp->tasks[rp->radio_task_id].state == RP_TASK_STATE_RUNNING ) &&
+            ( rp->tasks[hook_id].priority > rp->tasks[rp->radio_task_id].priority ) )
+        {
+            break;
+        }
+        if( ( ( rp->tasks[hook_id].state < RP_TASK_STATE_RUNNING ) &&
+              ( ( int32_t )( rp->tasks[hook_id].start_time_ms - now ) >= 0 ) ) ||
+            ( rp->tasks[hook_id].state == RP_TASK_STATE_RUNNING ) )
         {
-            time_tmp = rp->tasks[rank].start_time_ms + rp->tasks[rank].duration_time_ms;
+            time_tmp = rp->tasks[hook_id].start_time_ms + rp->tasks[hook_id].duration_time_ms;
 
-            int32_t tmp = ( int32_t )( time_tmp - hook_time_to_exe_tmp );
+            // The task has to end a margin before the start of the selected one, which is launched a margin early
+            int32_t tmp = ( int32_t )( time_tmp + rp->margin_delay - hook_time_to_exe_tmp );
             if( ( tmp < 0 ) && ( ( int32_t )( time_tmp - now ) >= 0 ) )
             {
-                hook_to_exe_tmp      = rp->tasks[rank].hook_id;
-                hook_time_to_exe_tmp = rp->tasks[rank].start_time_ms;
+                hook_to_exe_tmp      = hook_id;
+                hook_time_to_exe_tmp = rp->tasks[hook_id].start_time_ms;
             }
         }
     }
@@ -770,62 +1336,137 @@ static uint8_t rp_task_select_next( radio_planner_t* rp, const uint32_t now )
 static rp_next_state_status_t rp_task_get_next( radio_planner_t* rp, uint32_t* duration, uint8_t* task_id,
                                                 const uint32_t now )
 {
-    uint8_t  hook_id  = 0;
-    uint8_t  index    = 0;
-    uint32_t time_tmp = now;
-
-    for( hook_id = 0; hook_id < RP_NB_HOOKS; hook_id++ )
-    {  // Garbage collector
-        if( ( rp->tasks[hook_id].state == RP_TASK_STATE_SCHEDULE ) &&
-            ( ( ( int32_t )( rp->tasks[hook_id].start_time_ms - time_tmp ) < 0 ) ) )
+    // Garbage collector, the earliest task left is on top of the start time heap
+    rp_task_collect_past( rp, now );
+
+    if( rp->start_time_heap.nb == 0 )
+    {
+        return RP_STATUS_NO_MORE_TASK_SCHEDULE;
+    }
+    *task_id  = rp->start_time_heap.hook_id[0];
+    *duration = rp->tasks[*task_id].start_time_ms - now;
+    return RP_STATUS_HAVE_TO_SET_TIMER;
+}
+
+//
+// Private task heap implementation
+//
+
+static bool rp_task_heap_is_before( const rp_task_heap_t* heap, const uint8_t hook_id_a, const uint8_t hook_id_b )
+{
+    int32_t diff = ( int32_t )( heap->key[hook_id_a] - heap->key[hook_id_b] );
+
+    return ( diff < 0 ) || ( ( diff == 0 ) && ( hook_id_a < hook_id_b ) );
+}
+
+static void rp_task_heap_set( rp_task_heap_t* heap, const uint8_t position, const uint8_t hook_id )
+{
+    heap->hook_id[position] = hook_id;
+    heap->position[hook_id] = position;
+}
+
+static void rp_task_heap_sift( rp_task_heap_t* heap, uint8_t position )
+{
+    uint8_t hook_id = heap->hook_id[position];
+
+    // Move up while before the parent
+    while( position > 0 )
+    {
+        uint8_t parent = ( position - 1 ) >> 1;
+
+        if( rp_task_heap_is_before( heap, hook_id, heap->hook_id[parent] ) == false )
         {
-            rp->tasks[hook_id].state = RP_TASK_STATE_ABORTED;
+            break;
         }
+        rp_task_heap_set( heap, position, heap->hook_id[parent] );
+        position = parent;
     }
-    for( hook_id = 0; hook_id < RP_NB_HOOKS; hook_id++ )
+
+    // Move down while a child is before
+    while( ( ( position << 1 ) + 1 ) < heap->nb )
     {
-        if( ( rp->tasks[hook_id].state < RP_TASK_STATE_RUNNING ) &&
-            ( ( ( int32_t )( rp->tasks[hook_id].start_time_ms - time_tmp ) >= 0 ) ) )
+        uint8_t child = ( position << 1 ) + 1;
+
+        if( ( ( child + 1 ) < heap->nb ) &&
+            ( rp_task_heap_is_before( heap, heap->hook_id[child + 1], heap->hook_id[child] ) == true ) )
+        {
+            child++;
+        }
+        if( rp_task_heap_is_before( heap, heap->hook_id[child], hook_id ) == false )
         {
-            time_tmp = rp->tasks[hook_id].start_time_ms;
-            index    = hook_id;
             break;
         }
+        rp_task_heap_set( heap, position, heap->hook_id[child] );
+        position = child;
+    }
+    rp_task_heap_set( heap, position, hook_id );
+}
+
+static void rp_task_heap_init( rp_task_heap_t* heap )
+{
+    heap->nb = 0;
+    for( int32_t i = 0; i < RP_NB_HOOKS; i++ )
+    {
+        heap->position[i] = RP_NB_HOOKS;
     }
-    if( hook_id == RP_NB_HOOKS )
+}
+
+static void rp_task_heap_update( rp_task_heap_t* heap, const uint8_t hook_id, const uint32_t key )
+{
+    heap->key[hook_id] = key;
+    if( heap->position[hook_id] == RP_NB_HOOKS )
     {
-        return RP_STATUS_NO_MORE_TASK_SCHEDULE;
+        rp_task_heap_set( heap, heap->nb, hook_id );
+        heap->nb++;
     }
+    rp_task_heap_sift( heap, heap->position[hook_id] );
+}
+
+static void rp_task_heap_remove( rp_task_heap_t* heap, const uint8_t hook_id )
+{
+    uint8_t position = heap->position[hook_id];
 
-    for( uint8_t i = hook_id; i < RP_NB_HOOKS; i++ )
+    if( position == RP_NB_HOOKS )
     {
-        if( ( rp->tasks[i].state < RP_TASK_STATE_RUNNING ) &&
-            ( ( int32_t )( rp->tasks[i].start_time_ms - time_tmp ) < 0 ) &&
-            ( ( int32_t )( rp->tasks[i].start_time_ms - now ) >= 0 ) )
-        {
-            time_tmp = rp->tasks[i].start_time_ms;
-            index    = i;
-        }
+        return;
+    }
+    heap->position[hook_id] = RP_NB_HOOKS;
+    heap->nb--;
+    if( position < heap->nb )
+    {
+        // Fill the hole with the last hook and restore the heap order
+        rp_task_heap_set( heap, position, heap->hook_id[heap->nb] );
+        rp_task_heap_sift( heap, position );
     }
-    *task_id  = index;
-    *duration = time_tmp - now;
-    return RP_STATUS_HAVE_TO_SET_TIMER;
 }
 
-static uint8_t rp_task_find_highest_priority( uint8_t* vector, uint8_t length )
+static uint8_t rp_task_heap_get_before( const rp_task_heap_t* heap, const uint32_t key, uint8_t* hook_ids )
 {
-    uint8_t priority_high = 0xFF;
-    uint8_t index         = 0;
+    uint8_t stack[RP_NB_HOOKS];
+    uint8_t stack_nb = 0;
+    uint8_t found_nb = 0;
 
-    for( int32_t i = 0; i < length; i++ )
+    // Children are never before their parent: a subtree is skipped as soon as its root is not before the key
+    if( heap->nb > 0 )
     {
-        if( vector[i] <= priority_high )
+        stack[stack_nb++] = 0;
+    }
+    while( stack_nb > 0 )
+    {
+        uint8_t position = stack[--stack_nb];
+        uint8_t hook_id  = heap->hook_id[position];
+
+        if( ( int32_t )( heap->key[hook_id] - key ) < 0 )
         {
-            priority_high = vector[i];
-            index         = i;
+            hook_ids[found_nb++] = hook_id;
+            for( uint8_t child = ( position << 1 ) + 1; ( child <= ( position << 1 ) + 2 ) && ( child < heap->nb );
+                 child++ )
+            {
+                stack[stack_nb++] = child;
+            }
         }
     }
-    return index;
+    return found_nb;
 }
 
 rp_hook_status_t rp_get_pkt_payload( radio_planner_t* rp, const rp_task_t* task )
@@ -864,15 +1505,118 @@ rp_hook_status_t rp_get_pkt_payload( radio_planner_t* rp, const rp_task_t* task
     return status;
 }
 
-static void rp_set_alarm( radio_planner_t* rp, const uint32_t alarm_in_ms )
+static void rp_set_alarm( radio_planner_t* rp, const uint32_t alarm_in_100us )
+{
+    rp->alarm_100us = rp_hal_get_time_in_100us( ) + alarm_in_100us;
+    rp->alarm_armed = true;
+    rp_timer_refresh( rp );
+}
+
+static int32_t rp_task_get_delay_100us( const rp_task_t* task, const uint32_t now, const uint32_t now_100us )
+{
+    int32_t delay_ms = ( int32_t )( task->start_time_ms - now );
+
+    if( task->start_time_100us != 0 )
+    {
+        return ( int32_t )( task->start_time_100us - now_100us );
+    }
+    // Saturate the tasks more than 2.5 days away
+    if( delay_ms > ( INT32_MAX / 10 ) )
+    {
+        return INT32_MAX;
+    }
+    if( delay_ms < ( INT32_MIN / 10 ) )
+    {
+        return INT32_MIN;
+    }
+    return delay_ms * 10;
+}
+
+static void rp_margin_update( radio_planner_t* rp, const uint32_t latency_100us, const int32_t slack_100us )
+{
+    uint32_t margin_100us;
+
+    if( latency_100us > rp->stats.launch_latency_max_100us )
+    {
+        rp->stats.launch_latency_max_100us = latency_100us;
+    }
+    if( slack_100us < 0 )
+    {
+        rp->stats.launch_late_nb++;
+    }
+
+    // Follow a longer latency at once, a shorter one slowly so that a single fast launch does not shrink the margin
+    if( latency_100us > rp->launch_latency_100us )
+    {
+        rp->launch_latency_100us = latency_100us;
+    }
+    else
+    {
+        rp->launch_latency_100us -= ( rp->launch_latency_100us - latency_100us ) >> 4;
+    }
+
+    margin_100us = rp->launch_latency_100us + RP_MARGIN_GUARD_100US;
+    if( margin_100us < RP_MARGIN_DELAY_MIN_100US )
+    {
+        margin_100us = RP_MARGIN_DELAY_MIN_100US;
+    }
+    else if( margin_100us > RP_MARGIN_DELAY_MAX_100US )
+    {
+        margin_100us = RP_MARGIN_DELAY_MAX_100US;
+    }
+    rp->margin_delay_100us       = margin_100us;
+    rp->margin_delay             = ( margin_100us + 9 ) / 10;
+    rp->stats.margin_delay_100us = margin_100us;
+}
+
+static void rp_timer_refresh( radio_planner_t* rp )
 {
+    bool     armed      = rp->alarm_armed;
+    uint32_t next_100us = rp->alarm_100us;
+
+    if( ( rp->radio_task_timer_callback != NULL ) &&
+        ( ( armed == false ) || ( ( int32_t )( rp->radio_task_timer_100us - next_100us ) < 0 ) ) )
+    {
+        armed      = true;
+        next_100us = rp->radio_task_timer_100us;
+    }
+    if( armed == false )
+    {
+        return;
+    }
+    int32_t delay = ( int32_t )( next_100us - rp_hal_get_time_in_100us( ) );
+
     rp_hal_timer_stop( );
-    rp_hal_timer_start( rp, alarm_in_ms, rp_timer_irq_callback );
+    rp_hal_timer_start( rp, ( delay > 0 ) ? ( uint32_t ) delay : 1, rp_timer_irq_callback );
 }
 
 static void rp_timer_irq( radio_planner_t* rp )
 {
-    rp_task_arbiter( rp, __func__ );
+    uint32_t now = rp_hal_get_time_in_100us( );
+
+    if( ( rp->radio_task_timer_callback != NULL ) && ( ( int32_t )( rp->radio_task_timer_100us - now ) <= 0 ) )
+    {
+        void ( *callback )( void* )   = rp->radio_task_timer_callback;
+        rp->radio_task_timer_callback = NULL;
+
+        // Drop the timer if its task has been aborted or has ended in the meantime
+        bool call = ( rp->radio_task_id == rp->radio_task_timer_hook_id ) &&
+                    ( rp->tasks[rp->radio_task_id].state == RP_TASK_STATE_RUNNING );
+
+        rp_trace_add( rp, now, RP_TRACE_EVENT_TASK_TIMER, rp->radio_task_timer_hook_id, call );
+        if( call == true )
+        {
+            callback( rp );
+        }
+    }
+    if( ( rp->alarm_armed == true ) && ( ( int32_t )( rp->alarm_100us - now ) <= 0 ) )
+    {
+        rp_trace_add( rp, now, RP_TRACE_EVENT_ALARM, rp->timer_hook_id, 0 );
+        rp->alarm_armed = false;
+        rp->alarm_fired = true;
+        rp_task_arbiter( rp, __func__ );
+    }
+    rp_timer_refresh( rp );
 }
 
 static void rp_task_call_aborted( radio_planner_t* rp )
@@ -883,6 +1627,7 @@ static void rp_task_call_aborted( radio_planner_t* rp )
         {
             SMTC_MODEM_HAL_RP_TRACE_PRINTF( " RP: INFO - Aborted hook # %d callback\n", i );
             rp->stats.task_hook_aborted_nb[i]++;
+            rp_trace_add( rp, rp_hal_get_time_in_100us( ), RP_TRACE_EVENT_ABORT, i, 0 );
             rp_task_free( rp, &rp->tasks[i] );
             rp->status[i] = RP_STATUS_TASK_ABORTED;
             rp_hook_callback( rp, i );
@@ -1033,3 +1778,9 @@ static void rp_consumption_statistics_updated( radio_planner_t* rp, const uint8_
         rp_stats_update( &rp->stats, time, hook_id, micro_ampere_radio );
     }
 }
+
+static void rp_warm_statistics_updated( radio_planner_t* rp, const uint8_t hook_id, const uint32_t time )
+{
+    rp_stats_warm_update( &rp->stats, time - rp->radio_warm_start_ms, hook_id, RP_RADIO_STANDBY_XOSC_CONSUMPTION_UA,
+                          RP_RADIO_WAKE_UP_CONSUMPTION_UAMS );
+}
@@ -68,6 +68,30 @@ extern "C" {
  * --- PUBLIC TYPES ------------------------------------------------------------
  */
 
+/*!
+ * Binary min-heap of hook ids used to order the radio planner tasks
+ *
+ * Each hook is present at most once. Keys are compared as wrapping 32 bits values and equal keys are ordered on the
+ * hook id. Entries are not removed when a task ends, they are dropped when they reach the top of the heap. Inside
+ * the start time heap an asap task is keyed on its init time, its start time is refreshed to now without moving it.
+ */
+typedef struct rp_task_heap_s
+{
+    uint8_t  nb;                     //!< Number of hooks inside the heap
+    uint8_t  hook_id[RP_NB_HOOKS];   //!< Hook ids in heap order
+    uint8_t  position[RP_NB_HOOKS];  //!< Position of each hook inside the heap (RP_NB_HOOKS if absent)
+    uint32_t key[RP_NB_HOOKS];       //!< Key of each hook when it has been queued
+} rp_task_heap_t;
+
+/*!
+ * Ring of the last radio planner decisions, the record of index i is records[i % RP_TRACE_NB_RECORDS]
+ */
+typedef struct rp_trace_s
+{
+    rp_trace_record_t records[RP_TRACE_NB_RECORDS];
+    uint32_t          index;  //!< Index of the next record, counted from rp_init
+} rp_trace_t;
+
 /*!
  *
  */
@@ -78,16 +102,21 @@ typedef struct radio_planner_s
     rp_task_t         tasks[RP_NB_HOOKS];
     uint8_t*          payload[RP_NB_HOOKS];
     uint16_t          payload_size[RP_NB_HOOKS];
-    uint8_t           rankings[RP_NB_HOOKS];
+    rp_task_heap_t    priority_heap;
+    rp_task_heap_t    start_time_heap;
     void*             hooks[RP_NB_HOOKS];
+    uint8_t           hook_priority_class[RP_NB_HOOKS];
+    uint8_t           hook_rank[RP_NB_HOOKS];
     rp_status_t       status[RP_NB_HOOKS];
     ral_irq_t         raw_radio_irq[RP_NB_HOOKS];
     uint32_t          irq_timestamp_ms[RP_NB_HOOKS];
     uint32_t          irq_timestamp_100us[RP_NB_HOOKS];
     rp_stats_t        stats;
+    rp_trace_t        trace;
     uint8_t           hook_to_execute;
     uint32_t          hook_to_execute_time_ms;
     uint8_t           radio_task_id;
+    uint32_t          radio_task_end_ms;
     uint8_t           timer_task_id;
     uint8_t           semaphore_radio;
     uint32_t          timer_value;
@@ -96,6 +125,17 @@ typedef struct radio_planner_s
     rp_next_state_status_t next_state_status;
     const ralf_t*          radio;
     uint32_t               margin_delay;
+    uint32_t               margin_delay_100us;
+    uint32_t               launch_latency_100us;
+    uint32_t               launch_origin_100us;
+    uint32_t               alarm_100us;
+    bool                   alarm_armed;
+    bool                   alarm_fired;
+    bool                   radio_warm;
+    uint32_t               radio_warm_start_ms;
+    uint32_t               radio_task_timer_100us;
+    uint8_t                radio_task_timer_hook_id;
+    void ( *radio_task_timer_callback )( void* );
 } radio_planner_t;
 
 /*
@@ -118,6 +158,23 @@ void rp_init( radio_planner_t* rp, const ralf_t* radio );
  */
 rp_hook_status_t rp_hook_init( radio_planner_t* rp, const uint8_t id, void ( *callback )( void* context ), void* hook );
 
+/*!
+ * Allocate a hook at runtime and initialize it
+ *
+ * \remark Tasks of the hook are ordered against the other hooks on the priority class, then on the hook id. The hook
+ *         is given back with rp_release_hook().
+ *
+ * \param [in/out] rp             Radio planner data structure
+ * \param [in]     priority_class Priority class of the hook
+ * \param [in]     callback       Callback of the hook
+ * \param [in]     hook           Context of the callback
+ * \param [out]    id             Allocated hook id
+ * \retval status                 RP_HOOK_STATUS_ID_ERROR if no hook is left (see RP_NB_DYNAMIC_HOOKS),
+ *                                RP_HOOK_STATUS_OK otherwise
+ */
+rp_hook_status_t rp_hook_alloc( radio_planner_t* rp, const rp_hook_priority_class_t priority_class,
+                                void ( *callback )( void* context ), void* hook, uint8_t* id );
+
 /*!
  *
  */
@@ -148,11 +205,74 @@ rp_hook_status_t rp_task_enqueue( radio_planner_t* rp, const rp_task_t* task, ui
  */
 rp_hook_status_t rp_task_abort( radio_planner_t* rp, const uint8_t hook_id );
 
+/*!
+ * Check, without changing the radio planner state, what would happen if a task was enqueued now
+ *
+ * \remark The task priority is computed as rp_task_enqueue() does. The current task of the same hook is ignored since
+ *         it would be replaced. An asap task is delayed after each higher priority task it overlaps, a schedule task
+ *         is not admitted if it overlaps one. A queued asap task whose start time is past is accounted from now.
+ *
+ * \param [in]  rp     Radio planner data structure
+ * \param [in]  task   Task which would be enqueued
+ * \param [out] result Admission result
+ * \retval status      Same status as rp_task_enqueue() for a task which can not be enqueued, RP_HOOK_STATUS_OK
+ *                     otherwise
+ */
+rp_hook_status_t rp_task_admission_check( const radio_planner_t* rp, const rp_task_t* task,
+                                          rp_task_admission_t* result );
+
 /*!
  *
  */
 rp_stats_t rp_get_stats( const radio_planner_t* rp );
 
+/*!
+ * Copy the radio time and charge accounted to each hook, and optionally clear them, in one critical section so the
+ * snapshot is consistent with the reset
+ *
+ * \param [in]  rp       Radio planner data structure
+ * \param [out] snapshot Time and charge of each hook, RP_NB_HOOKS elements, can be NULL to only reset
+ * \param [in]  reset    Clear the time and charge of each hook after the copy
+ */
+void rp_get_stats_hooks_snapshot( radio_planner_t* rp, rp_stats_hook_t* snapshot, const bool reset );
+
+/*!
+ * Copy records of the trace ring, oldest first
+ *
+ * \remark Records are indexed from 0 at rp_init(). Reading from 0 then passing back next_index reads each record once,
+ *         if the ring has wrapped in between the reading restarts at the oldest record left.
+ *
+ * \param [in]     rp         Radio planner data structure
+ * \param [in/out] next_index Index of the first record to read, updated to the index after the last record read
+ * \param [out]    records    Records read
+ * \param [in]     max_nb     Maximum number of records to read
+ * \retval nb                 Number of records read
+ */
+uint16_t rp_trace_read( radio_planner_t* rp, uint32_t* next_index, rp_trace_record_t* records, const uint16_t max_nb );
+
+/*!
+ * Start a one shot timer on behalf of the running radio task
+ *
+ * \remark The radio planner timer is shared with the arbiter alarm, the callback is only called if the task which
+ *         started the timer is still the running radio task. Starting a new timer replaces the previous one.
+ *
+ * \param [in/out] rp          Radio planner data structure
+ * \param [in]     alarm_in_ms Delay before the callback in ms
+ * \param [in]     callback    Callback called with the radio planner as context
+ */
+void rp_radio_task_timer_start( radio_planner_t* rp, const uint32_t alarm_in_ms, void ( *callback )( void* rp ) );
+
+/*!
+ * Wait for the start time of the running radio task, with a 100us resolution if the task has a start_time_100us
+ *
+ * \remark To be called by the launch callbacks once the radio is configured, right before the radio command. The time
+ *         spent since the launch decision is used to learn the launch margin (rp->margin_delay).
+ *
+ * \param [in/out] rp      Radio planner data structure
+ * \param [in]     hook_id Id of the running task
+ */
+void rp_task_wait_start( radio_planner_t* rp, const uint8_t hook_id );
+
 /*!
  *
  */
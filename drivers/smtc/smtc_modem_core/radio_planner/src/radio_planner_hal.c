@@ -95,9 +95,9 @@ void rp_hal_timer_stop( void )
     smtc_modem_hal_stop_timer( );
 }
 
-void rp_hal_timer_start( void* rp, uint32_t alarm_in_ms, void ( *callback )( void* context ) )
+void rp_hal_timer_start( void* rp, uint32_t alarm_in_100us, void ( *callback )( void* context ) )
 {
-    smtc_modem_hal_start_timer( alarm_in_ms, callback, rp );
+    smtc_modem_hal_start_timer_in_100us( alarm_in_100us, callback, rp );
 }
 
 uint32_t rp_hal_get_time_in_ms( void )
@@ -105,6 +105,11 @@ uint32_t rp_hal_get_time_in_ms( void )
     return smtc_modem_hal_get_time_in_ms( );
 }
 
+uint32_t rp_hal_get_time_in_100us( void )
+{
+    return smtc_modem_hal_get_time_in_100us( );
+}
+
 uint32_t rp_hal_get_radio_irq_timestamp_in_100us( void )
 {
     return smtc_modem_hal_get_radio_irq_timestamp_in_100us( );
@@ -115,6 +120,11 @@ void rp_hal_irq_clear_pending( void )
     smtc_modem_hal_radio_irq_clear_pending( );
 }
 
+void rp_hal_stop_radio_tcxo( void )
+{
+    smtc_modem_hal_stop_radio_tcxo( );
+}
+
 #if defined( LR1110_MODEM_E ) && defined( _MODEM_E_GNSS_ENABLE )
 void rp_hal_get_gnss_conso_us( uint32_t* p_radio_t, uint32_t* p_arc_process_t )
 {
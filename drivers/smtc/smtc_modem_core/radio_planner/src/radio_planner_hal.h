@@ -90,7 +90,7 @@ void rp_hal_timer_stop( void );
 /*!
  *
  */
-void rp_hal_timer_start( void* rp, uint32_t alarm_in_ms, void ( *callback )( void* context ) );
+void rp_hal_timer_start( void* rp, uint32_t alarm_in_100us, void ( *callback )( void* context ) );
 
 /**
  * @brief Gets current time in ms
@@ -99,6 +99,13 @@ void rp_hal_timer_start( void* rp, uint32_t alarm_in_ms, void ( *callback )( voi
  */
 uint32_t rp_hal_get_time_in_ms( void );
 
+/**
+ * @brief Gets current time in 100µs
+ *
+ * @return uint32_t
+ */
+uint32_t rp_hal_get_time_in_100us( void );
+
 /**
  * @brief Gets the time in 100µs at which the last radio IRQ occurred
  *
@@ -111,6 +118,11 @@ uint32_t rp_hal_get_radio_irq_timestamp_in_100us( void );
  */
 void rp_hal_irq_clear_pending( void );
 
+/*!
+ * Stop the TCXO once the radio is put to sleep
+ */
+void rp_hal_stop_radio_tcxo( void );
+
 #if defined( LR1110_MODEM_E ) && defined( _MODEM_E_GNSS_ENABLE )
 /*!
  *
@@ -67,29 +67,44 @@ extern "C" {
  * --- PUBLIC TYPES ------------------------------------------------------------
  */
 
+/*!
+ * Radio time and charge accounted to a hook. Times are in us and charges in uAs, they do not wrap over the life of
+ * the device
+ */
+typedef struct rp_stats_hook_s
+{
+    uint64_t tx_time_us;
+    uint64_t rx_time_us;
+    uint64_t none_time_us;
+    uint64_t tx_charge_uas;
+    uint64_t rx_charge_uas;
+    uint64_t none_charge_uas;
+} rp_stats_hook_t;
+
 /*!
  *
  */
 typedef struct rp_stats_s
 {
-    uint32_t tx_last_toa_ms[RP_NB_HOOKS];
-    uint32_t tx_consumption_ms[RP_NB_HOOKS];
-    uint32_t rx_consumption_ms[RP_NB_HOOKS];
-    uint32_t none_consumption_ms[RP_NB_HOOKS];
-    uint32_t tx_consumption_ma[RP_NB_HOOKS];
-    uint32_t rx_consumption_ma[RP_NB_HOOKS];
-    uint32_t none_consumption_ma[RP_NB_HOOKS];
-    uint32_t tx_total_consumption_ms;
-    uint32_t rx_total_consumption_ms;
-    uint32_t none_total_consumption_ms;
-    uint32_t tx_total_consumption_ma;
-    uint32_t rx_total_consumption_ma;
-    uint32_t none_total_consumption_ma;
-    uint32_t tx_timestamp;
-    uint32_t rx_timestamp;
-    uint32_t none_timestamp;
-    uint32_t task_hook_aborted_nb[RP_NB_HOOKS];
-    uint32_t rp_error;
+    uint32_t        tx_last_toa_ms[RP_NB_HOOKS];
+    rp_stats_hook_t hooks[RP_NB_HOOKS];
+    uint16_t        tx_charge_remainder_nas[RP_NB_HOOKS];  // Charge below 1 uAs carried to the next update, in nAs
+    uint16_t        rx_charge_remainder_nas[RP_NB_HOOKS];
+    uint16_t        none_charge_remainder_nas[RP_NB_HOOKS];
+    uint16_t        sniff_charge_remainder_pas[RP_NB_HOOKS];  // Sniff charge below 1 nAs carried, in pAs
+    uint32_t        tx_timestamp;
+    uint32_t        rx_timestamp;
+    uint32_t        none_timestamp;
+    uint32_t        task_hook_aborted_nb[RP_NB_HOOKS];
+    uint32_t        task_hook_suspended_nb[RP_NB_HOOKS];
+    uint32_t        rp_error;
+    uint32_t        margin_delay_100us;        // Learned launch margin
+    uint32_t        launch_latency_max_100us;  // Longest launch latency measured
+    uint32_t        launch_late_nb;            // Number of tasks ready after their start time
+    uint32_t        task_hook_coalesced_nb[RP_NB_HOOKS];  // Tasks launched on a radio kept warm since the previous task
+    uint64_t        warm_total_us;                        // Time the radio was kept warm between tasks
+    int64_t         warm_saved_charge_uas;                // Charge saved against sleeping between tasks
+    int16_t         warm_saved_charge_remainder_nas;      // Saved charge below 1 uAs carried to the next update
 } rp_stats_t;
 
 /*
@@ -105,6 +120,18 @@ static inline void rp_stats_init( rp_stats_t* rp_stats )
     memset( rp_stats, 0, sizeof( rp_stats_t ) );
 }
 
+/*!
+ * Clear the time and charge accounted to the hooks, the other statistics are kept
+ */
+static inline void rp_stats_reset_hooks( rp_stats_t* rp_stats )
+{
+    memset( rp_stats->hooks, 0, sizeof( rp_stats->hooks ) );
+    memset( rp_stats->tx_charge_remainder_nas, 0, sizeof( rp_stats->tx_charge_remainder_nas ) );
+    memset( rp_stats->rx_charge_remainder_nas, 0, sizeof( rp_stats->rx_charge_remainder_nas ) );
+    memset( rp_stats->none_charge_remainder_nas, 0, sizeof( rp_stats->none_charge_remainder_nas ) );
+    memset( rp_stats->sniff_charge_remainder_pas, 0, sizeof( rp_stats->sniff_charge_remainder_pas ) );
+}
+
 /*!
  *
  */
@@ -129,44 +156,47 @@ static inline void rp_stats_set_none_timestamp( rp_stats_t* rp_stats, uint32_t t
     rp_stats->none_timestamp = timestamp;
 }
 
+/*!
+ * Add a charge in nAs to an accumulator in uAs, the part below 1 uAs is carried in remainder_nas
+ */
+static inline void rp_stats_add_charge( uint64_t* charge_uas, uint16_t* remainder_nas, uint64_t charge_nas )
+{
+    charge_nas += *remainder_nas;
+    *charge_uas += charge_nas / 1000;
+    *remainder_nas = ( uint16_t ) ( charge_nas % 1000 );
+}
+
 /*!
  *
  */
 static inline void rp_stats_update( rp_stats_t* rp_stats, uint32_t timestamp, uint8_t hook_id, uint32_t micro_ampere )
 {
-    uint32_t computed_time        = 0;
-    uint32_t computed_consumption = 0;
+    rp_stats_hook_t* hook          = &rp_stats->hooks[hook_id];
+    uint32_t         computed_time = 0;
+
+    // A charge in nAs is a time in ms times a current in uA
     if( rp_stats->tx_timestamp != 0 )
     {
         // wrapping is impossible with this time base
         computed_time                     = timestamp - rp_stats->tx_timestamp;
         rp_stats->tx_last_toa_ms[hook_id] = computed_time;
-        rp_stats->tx_consumption_ms[hook_id] += computed_time;
-        rp_stats->tx_total_consumption_ms += computed_time;
-
-        computed_consumption = ( computed_time * micro_ampere );
-        rp_stats->tx_consumption_ma[hook_id] += ( computed_consumption / 1000 );
-        rp_stats->tx_total_consumption_ma += ( computed_consumption / 1000 );
+        hook->tx_time_us += ( uint64_t ) computed_time * 1000;
+        rp_stats_add_charge( &hook->tx_charge_uas, &rp_stats->tx_charge_remainder_nas[hook_id],
+                             ( uint64_t ) computed_time * micro_ampere );
     }
     if( rp_stats->rx_timestamp != 0 )
     {
         computed_time = timestamp - rp_stats->rx_timestamp;
-        rp_stats->rx_consumption_ms[hook_id] += computed_time;
-        rp_stats->rx_total_consumption_ms += computed_time;
-
-        computed_consumption = ( computed_time * micro_ampere );
-        rp_stats->rx_consumption_ma[hook_id] += ( computed_consumption / 1000 );
-        rp_stats->rx_total_consumption_ma += ( computed_consumption / 1000 );
+        hook->rx_time_us += ( uint64_t ) computed_time * 1000;
+        rp_stats_add_charge( &hook->rx_charge_uas, &rp_stats->rx_charge_remainder_nas[hook_id],
+                             ( uint64_t ) computed_time * micro_ampere );
     }
     if( rp_stats->none_timestamp != 0 )
     {
         computed_time = timestamp - rp_stats->none_timestamp;
-        rp_stats->none_consumption_ms[hook_id] += computed_time;
-        rp_stats->none_total_consumption_ms += computed_time;
-
-        computed_consumption = ( computed_time * micro_ampere );
-        rp_stats->none_consumption_ma[hook_id] += ( computed_consumption / 1000 );
-        rp_stats->none_total_consumption_ma += ( computed_consumption / 1000 );
+        hook->none_time_us += ( uint64_t ) computed_time * 1000;
+        rp_stats_add_charge( &hook->none_charge_uas, &rp_stats->none_charge_remainder_nas[hook_id],
+                             ( uint64_t ) computed_time * micro_ampere );
     }
     rp_stats->tx_timestamp   = 0;
     rp_stats->rx_timestamp   = 0;
@@ -179,24 +209,62 @@ static inline void rp_stats_update( rp_stats_t* rp_stats, uint32_t timestamp, ui
 static inline void rp_stats_sniff_update( rp_stats_t* rp_stats, uint32_t timestamp, uint32_t time_radio,
                                           uint32_t time_proc, uint8_t hook_id, uint32_t ma_radio, uint32_t ma_proc )
 {
-    uint32_t computed_time        = 0;
-    uint32_t computed_consumption = 0;
+    rp_stats_hook_t* hook          = &rp_stats->hooks[hook_id];
+    uint32_t         computed_time = 0;
 
     computed_time = timestamp - rp_stats->none_timestamp;
-    // SMTC_MODEM_HAL_TRACE_WARNING( "stat %d %d\n", time_radio/1000, time_proc/1000 );
-    // SMTC_MODEM_HAL_TRACE_WARNING( "stat %d \n", computed_time);
-    rp_stats->none_consumption_ms[hook_id] += computed_time;
-    rp_stats->none_total_consumption_ms += computed_time;
+    hook->none_time_us += ( uint64_t ) computed_time * 1000;
+
+    // Sniff times are in us, a time in us times a current in uA is a charge in pAs, the part below 1 nAs is carried
+    uint64_t charge_pas = ( ( uint64_t ) time_radio * ma_radio ) + ( ( uint64_t ) time_proc * ma_proc ) +
+                          rp_stats->sniff_charge_remainder_pas[hook_id];
 
-    computed_consumption = ( time_radio / 1000 * ma_radio ) + ( time_proc / 1000 * ma_proc );
-    rp_stats->none_consumption_ma[hook_id] += ( computed_consumption / 1000 );
-    rp_stats->none_total_consumption_ma += ( computed_consumption / 1000 );
+    rp_stats->sniff_charge_remainder_pas[hook_id] = ( uint16_t ) ( charge_pas % 1000 );
+    rp_stats_add_charge( &hook->none_charge_uas, &rp_stats->none_charge_remainder_nas[hook_id], charge_pas / 1000 );
 
     rp_stats->tx_timestamp   = 0;
     rp_stats->rx_timestamp   = 0;
     rp_stats->none_timestamp = 0;
 }
 
+/*!
+ * Account the time the radio was kept in standby between two tasks instead of sleeping. If a task is launched on the
+ * warm radio, the wake up charge it avoided is saved, the standby charge is always spent.
+ */
+static inline void rp_stats_warm_update( rp_stats_t* rp_stats, uint32_t warm_time_ms, uint8_t hook_id,
+                                         uint32_t standby_micro_ampere, uint32_t wake_up_micro_ampere_ms )
+{
+    // A charge in nAs is a time in ms times a current in uA
+    int64_t saved_charge_nas = -( ( int64_t ) warm_time_ms * standby_micro_ampere );
+
+    if( hook_id < RP_NB_HOOKS )
+    {
+        rp_stats->task_hook_coalesced_nb[hook_id]++;
+        saved_charge_nas += wake_up_micro_ampere_ms;
+    }
+    rp_stats->warm_total_us += ( uint64_t ) warm_time_ms * 1000;
+
+    // The saved charge can be negative, the remainder keeps the sign of the sum so no charge is lost either way
+    saved_charge_nas += rp_stats->warm_saved_charge_remainder_nas;
+    rp_stats->warm_saved_charge_uas += saved_charge_nas / 1000;
+    rp_stats->warm_saved_charge_remainder_nas = ( int16_t ) ( saved_charge_nas % 1000 );
+}
+
+/*!
+ * Total charge accounted to all hooks, in uAs
+ */
+static inline uint64_t rp_stats_get_total_charge_uas( const rp_stats_t* rp_stats )
+{
+    uint64_t total = 0;
+
+    for( int32_t i = 0; i < RP_NB_HOOKS; i++ )
+    {
+        total += rp_stats->hooks[i].tx_charge_uas + rp_stats->hooks[i].rx_charge_uas +
+                 rp_stats->hooks[i].none_charge_uas;
+    }
+    return total;
+}
+
 #if defined( RP_STAT_PRINT_ENBALE )
 /*!
  *
@@ -208,31 +276,34 @@ static inline void rp_stats_print( rp_stats_t* rp_stats )
     SMTC_MODEM_HAL_RP_TRACE_PRINTF( "###### ===================================== ######\n" );
     for( int32_t i = 0; i < RP_NB_HOOKS; i++ )
     {
-        SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Tx consumption hook #%ld = %lu ms\n", i, rp_stats->tx_consumption_ms[i] );
-        SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Tx consumption hook #%ld = %lu ua\n", i, rp_stats->tx_consumption_ma[i] );
-    }
-    for( int32_t i = 0; i < RP_NB_HOOKS; i++ )
-    {
-        SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Rx consumption hook #%ld = %lu ms\n", i, rp_stats->rx_consumption_ms[i] );
-        SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Rx consumption hook #%ld = %lu ua\n", i, rp_stats->rx_consumption_ma[i] );
-    }
-    for( int32_t i = 0; i < RP_NB_HOOKS; i++ )
-    {
-        SMTC_MODEM_HAL_RP_TRACE_PRINTF( "None consumption hook #%ld = %lu ms\n", i, rp_stats->none_consumption_ms[i] );
-        SMTC_MODEM_HAL_RP_TRACE_PRINTF( "None consumption hook #%ld = %lu ua\n", i, rp_stats->none_consumption_ma[i] );
+        SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Tx consumption hook #%ld = %lu ms, %lu mAs\n", i,
+                                        ( uint32_t ) ( rp_stats->hooks[i].tx_time_us / 1000 ),
+                                        ( uint32_t ) ( rp_stats->hooks[i].tx_charge_uas / 1000 ) );
+        SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Rx consumption hook #%ld = %lu ms, %lu mAs\n", i,
+                                        ( uint32_t ) ( rp_stats->hooks[i].rx_time_us / 1000 ),
+                                        ( uint32_t ) ( rp_stats->hooks[i].rx_charge_uas / 1000 ) );
+        SMTC_MODEM_HAL_RP_TRACE_PRINTF( "None consumption hook #%ld = %lu ms, %lu mAs\n", i,
+                                        ( uint32_t ) ( rp_stats->hooks[i].none_time_us / 1000 ),
+                                        ( uint32_t ) ( rp_stats->hooks[i].none_charge_uas / 1000 ) );
     }
-    SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Tx total consumption     = %lu ms\n ", rp_stats->tx_total_consumption_ms );
-    SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Tx total consumption     = %lu uA\n ", rp_stats->tx_total_consumption_ma );
-    SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Rx total consumption     = %lu ms\n ", rp_stats->rx_total_consumption_ms );
-    SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Rx total consumption     = %lu uA\n ", rp_stats->rx_total_consumption_ma );
-    SMTC_MODEM_HAL_RP_TRACE_PRINTF( "None total consumption   = %lu ms\n ", rp_stats->none_total_consumption_ms );
-    SMTC_MODEM_HAL_RP_TRACE_PRINTF( "None total consumption   = %lu uA\n ", rp_stats->none_total_consumption_ma );
+    SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Total consumption        = %lu mAs\n ",
+                                    ( uint32_t ) ( rp_stats_get_total_charge_uas( rp_stats ) / 1000 ) );
 
     for( int32_t i = 0; i < RP_NB_HOOKS; i++ )
     {
         SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Number of aborted tasks for hook #%ld = %lu \n", i,
                                         rp_stats->task_hook_aborted_nb[i] );
+        SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Number of suspended tasks for hook #%ld = %lu \n", i,
+                                        rp_stats->task_hook_suspended_nb[i] );
+        SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Number of coalesced tasks for hook #%ld = %lu \n", i,
+                                        rp_stats->task_hook_coalesced_nb[i] );
     }
+    SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Radio kept warm = %lu ms, saved charge = %ld uAs\n",
+                                    ( uint32_t ) ( rp_stats->warm_total_us / 1000 ),
+                                    ( int32_t ) rp_stats->warm_saved_charge_uas );
+    SMTC_MODEM_HAL_RP_TRACE_PRINTF( "Launch margin = %lu x 100us, longest latency = %lu x 100us, late = %lu\n",
+                                    rp_stats->margin_delay_100us, rp_stats->launch_latency_max_100us,
+                                    rp_stats->launch_late_nb );
     SMTC_MODEM_HAL_RP_TRACE_PRINTF( "RP: number of errors is %lu\n\n\n", rp_stats->rp_error );
 }
 #endif  // RP_STAT_PRINT_ENBALE
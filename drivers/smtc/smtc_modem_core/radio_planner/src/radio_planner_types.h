@@ -63,10 +63,23 @@ extern "C" {
 
 // clang-format off
 
+/*
+ * Number of hooks allocated at runtime with rp_hook_alloc(), after the RP_HOOK_ID_DEF ones. RP_NB_HOOKS must not exceed
+ * 128, task priorities ( state * RP_NB_HOOKS + rank ) are 8 bits
+ */
+#ifndef RP_NB_DYNAMIC_HOOKS
+#define RP_NB_DYNAMIC_HOOKS                         0
+#endif
+
 /*
  * Maximum number of objects that can be attached to the scheduler
  */
-#define RP_NB_HOOKS                                 RP_HOOK_ID_MAX
+#define RP_NB_HOOKS                                 ( RP_HOOK_ID_MAX + RP_NB_DYNAMIC_HOOKS )
+
+/*
+ * Number of 32-bit words of a hook mask, the bit ( hook_id % 32 ) of the word ( hook_id / 32 ) is set for each hook
+ */
+#define RP_HOOK_MASK_NB_WORDS                       ( ( RP_NB_HOOKS + 31 ) / 32 )
 
 #define RP_NB_USER_HOOK                             3
 
@@ -84,11 +97,68 @@ extern "C" {
 
 /*!
  * for 8 ms : 5MS FOR WAKE UP (2MS) + CONFIG TIMER (3MS FIX !) + 3 ms interrupt routine
+ * Initial launch margin, the margin is then learned from the measured launch latency
  */
 #ifndef RP_MARGIN_DELAY
 #define RP_MARGIN_DELAY                             8
 #endif
 
+/*!
+ * Bounds of the learned launch margin in 100us
+ */
+#ifndef RP_MARGIN_DELAY_MIN_100US
+#define RP_MARGIN_DELAY_MIN_100US                   10
+#endif
+#ifndef RP_MARGIN_DELAY_MAX_100US
+#define RP_MARGIN_DELAY_MAX_100US                   ( RP_MARGIN_DELAY * 10 * 2 )
+#endif
+
+/*!
+ * Guard added to the launch latency to compute the launch margin, in 100us
+ */
+#define RP_MARGIN_GUARD_100US                       5
+
+/*!
+ * Delay before the arbiter is called again when the next task is already inside the launch margin, in 100us
+ */
+#define RP_ALARM_RETRY_100US                        10
+
+/*!
+ * The radio and its TCXO are kept running for a suspended task if the preempting task is shorter than this, in ms
+ */
+#ifndef RP_TASK_SUSPEND_WARM_DURATION_MS
+#define RP_TASK_SUSPEND_WARM_DURATION_MS            50
+#endif
+
+/*!
+ * Number of records of the trace ring, must be a power of 2
+ */
+#ifndef RP_TRACE_NB_RECORDS
+#define RP_TRACE_NB_RECORDS                         64
+#endif
+
+#if ( RP_TRACE_NB_RECORDS < 2 ) || ( ( RP_TRACE_NB_RECORDS & ( RP_TRACE_NB_RECORDS - 1 ) ) != 0 )
+#error "RP_TRACE_NB_RECORDS must be a power of 2"
+#endif
+
+/*!
+ * The radio and its TCXO are kept running between two tasks if the next one starts within this delay, in ms
+ */
+#ifndef RP_TASK_COALESCE_THRESHOLD_MS
+#define RP_TASK_COALESCE_THRESHOLD_MS               8
+#endif
+
+/*!
+ * Radio consumption in standby with the TCXO running, in uA, and consumption of a wake up from sleep (TCXO startup
+ * and radio configuration), in uA x ms. Only used for the statistics
+ */
+#ifndef RP_RADIO_STANDBY_XOSC_CONSUMPTION_UA
+#define RP_RADIO_STANDBY_XOSC_CONSUMPTION_UA        1600
+#endif
+#ifndef RP_RADIO_WAKE_UP_CONSUMPTION_UAMS
+#define RP_RADIO_WAKE_UP_CONSUMPTION_UAMS           ( RP_RADIO_STANDBY_XOSC_CONSUMPTION_UA * RP_MARGIN_DELAY )
+#endif
+
 
 
 /*!
@@ -211,9 +281,13 @@ typedef struct rp_task_s
     void ( *launch_task_callbacks )( void* );
     uint8_t          priority;
     bool             schedule_task_low_priority;
+    // A suspendable task (continuous RX, scan) preempted by a higher priority task is resumed after it instead of
+    // being aborted, its launch callback is called again
+    bool             suspendable;
     rp_task_states_t state;
     // absolute Ms
     uint32_t start_time_ms;
+    // absolute 100us, optional (0 if the task is only timed in ms)
     uint32_t start_time_100us;
     // Have to keep the initial start time to be able to switch asap task to
     // schedule task after long period
@@ -221,6 +295,64 @@ typedef struct rp_task_s
     uint32_t duration_time_ms;
 } rp_task_t;
 
+/*!
+ * Result of an admission check, read the hook masks with rp_hook_mask_is_set()
+ */
+typedef struct rp_task_admission_s
+{
+    bool     admitted;                                // The task would be launched
+    uint32_t expected_start_ms;                       // Expected start time of the task if admitted
+    uint32_t preempted_hooks[RP_HOOK_MASK_NB_WORDS];  // Tasks which would be aborted or suspended by the task
+    uint32_t blocking_hooks[RP_HOOK_MASK_NB_WORDS];   // Tasks which would delay the task (asap) or abort it (schedule)
+} rp_task_admission_t;
+
+/*!
+ * Tell whether a hook is set in a hook mask
+ */
+static inline bool rp_hook_mask_is_set( const uint32_t mask[RP_HOOK_MASK_NB_WORDS], const uint8_t hook_id )
+{
+    return ( mask[hook_id / 32] & ( 1UL << ( hook_id % 32 ) ) ) != 0;
+}
+
+/*!
+ * Events recorded in the radio planner trace ring, decoded by scripts/rp_trace_decode.py
+ */
+typedef enum rp_trace_events_e
+{
+    RP_TRACE_EVENT_ENQUEUE,     // arg: state << 8 | type of the task
+    RP_TRACE_EVENT_LAUNCH,      // arg: type of the task
+    RP_TRACE_EVENT_READY,       // arg: launch latency in 100us
+    RP_TRACE_EVENT_SUSPEND,     // arg: remaining duration in ms
+    RP_TRACE_EVENT_ABORT,       // arg: 0
+    RP_TRACE_EVENT_RADIO_IRQ,   // arg: rp_status_t of the task, timestamp of the irq
+    RP_TRACE_EVENT_ALARM,       // arg: 0, hook of the next task
+    RP_TRACE_EVENT_TASK_TIMER,  // arg: 1 if the timer callback is called, 0 if the timer is dropped
+} rp_trace_events_t;
+
+/*!
+ * Radio planner trace record, 8 bytes
+ */
+typedef struct rp_trace_record_s
+{
+    uint32_t timestamp_100us;
+    uint8_t  event;  // rp_trace_events_t
+    uint8_t  hook_id;
+    uint16_t arg;
+} rp_trace_record_t;
+
+/*!
+ * Priority class of a hook, from the highest to the lowest. Inside a class, hooks are ordered on their id so a hook
+ * allocated at runtime comes after the RP_HOOK_ID_DEF hooks of its class
+ */
+typedef enum rp_hook_priority_class_e
+{
+    RP_HOOK_PRIORITY_CLASS_SUSPEND,     // Radio suspended for a direct access
+    RP_HOOK_PRIORITY_CLASS_MAC,         // LoRaWAN stack, LBT and RTC compensation
+    RP_HOOK_PRIORITY_CLASS_CLASS_B,     // Beacon, device to device and ping slots
+    RP_HOOK_PRIORITY_CLASS_USER,        // Application radio accesses
+    RP_HOOK_PRIORITY_CLASS_BACKGROUND,  // Class C continuous reception
+} rp_hook_priority_class_t;
+
 /*!
  *
  */
@@ -48,6 +48,21 @@ extern "C" {
 #include <stdbool.h>  // bool type
 
 #include "file_upload_defs.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+// Number of file upload sessions that can be in flight at the same time (session id is coded on 2 bits)
+#ifndef FILE_UPLOAD_NB_SESSIONS
+#define FILE_UPLOAD_NB_SESSIONS ( 1 )
+#endif
+
+#if( FILE_UPLOAD_NB_SESSIONS < 1 ) || ( FILE_UPLOAD_NB_SESSIONS > 4 )
+#error "FILE_UPLOAD_NB_SESSIONS must be in range [1:4]"
+#endif
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC TYPES ------------------------------------------------------------
@@ -78,6 +93,7 @@ typedef struct file_upload_s
 {
     uint8_t                    sid;              // Session Id (2bits)
     uint16_t                   average_delay;    // average frame transmission rate/delay
+    uint8_t                    weight;           // share of the uplinks given to this session when several are ready
     uint8_t                    port;             // applicative port on which the upload is done
     file_upload_encrypt_mode_t encrypt_mode;     // file upload encryptio mode
     uint8_t                    session_counter;  // session counter
@@ -105,11 +121,12 @@ typedef struct file_upload_s
  * @param [in] port            applicative where the data will be forwarded
  * @param [in] encryption      Encryption type
  * @param [in] session_counter Upload session counter
+ * @param [in] weight          Scheduling weight of the session (0 is handled as 1)
  * @return file_upload_return_code_t
  */
 file_upload_return_code_t file_upload_init( file_upload_t* file_upload, uint32_t session_id, uint32_t file_len,
                                             uint16_t average_delay, uint8_t port, uint8_t encryption,
-                                            uint8_t session_counter );
+                                            uint8_t session_counter, uint8_t weight );
 
 /**
  * @brief Process the downlink frame FILEDONE
@@ -138,6 +155,32 @@ file_upload_return_code_t file_upload_prepare_upload( file_upload_t* file_upload
  */
 uint32_t file_upload_get_average_delay_in_s( file_upload_t* file_upload );
 
+/**
+ * @brief get the upload progress, in chunks
+ *
+ * @param [in]  file_upload      Pointer to File Upload context
+ * @param [out] nb_chunks_sent   Number of chunks already sent
+ * @param [out] nb_chunks_target Number of chunks sent before the upload ends without server confirmation
+ */
+void file_upload_get_progress( file_upload_t* file_upload, uint16_t* nb_chunks_sent, uint16_t* nb_chunks_target );
+
+/**
+ * @brief get the number of fragments still to be sent when fragments are built in a buffer of size len
+ *
+ * @param [in] file_upload Pointer to File Upload context
+ * @param [in] len         fragment buffer size, as given to file_upload_get_fragment()
+ * @return uint32_t The number of remaining fragments, 0 if nothing is left to be sent
+ */
+uint32_t file_upload_get_nb_remaining_fragments( file_upload_t* file_upload, int32_t len );
+
+/**
+ * @brief get the scheduling weight of the session
+ *
+ * @param [in] file_upload Pointer to File Upload context
+ * @return uint8_t The weight used by the supervisor weighted round-robin
+ */
+uint8_t file_upload_get_weight( file_upload_t* file_upload );
+
 /**
  * @brief File upload fragment generation
  *
@@ -108,9 +108,8 @@
  */
 
 static uint32_t phash( uint32_t x );
-static uint32_t checkbits( uint32_t cid, uint32_t cct, uint32_t i );
-static void     function_xor( uint32_t* dst, uint32_t* src, int32_t nw );
-static void     gen_chunk( file_upload_t* file_upload, uint32_t* dst, uint32_t* src, uint32_t cct, uint32_t cid );
+static void     function_xor( uint32_t* dst, const uint32_t* src, int32_t nw );
+static void     gen_chunk( file_upload_t* file_upload, uint32_t* dst, const uint32_t* src, uint32_t cct, uint32_t cid );
 
 /**
  * @brief Compute SHA256
@@ -128,7 +127,7 @@ static void sha256( uint32_t* hash, const uint8_t* msg, uint32_t len );
 
 file_upload_return_code_t file_upload_init( file_upload_t* file_upload, uint32_t session_id, uint32_t file_len,
                                             uint16_t average_delay, uint8_t port, uint8_t encryption,
-                                            uint8_t session_counter )
+                                            uint8_t session_counter, uint8_t weight )
 {
     if( file_len > FILE_UPLOAD_MAX_SIZE )
     {
@@ -142,6 +141,7 @@ file_upload_return_code_t file_upload_init( file_upload_t* file_upload, uint32_t
     file_upload->session_counter = session_counter;
     file_upload->encrypt_mode    = encryption;
     file_upload->average_delay   = average_delay;
+    file_upload->weight          = ( weight > 0 ) ? weight : 1;
     file_upload->port            = port;
     file_upload->file_len        = file_len;
     file_upload->cct             = cct;
@@ -259,52 +259,82 @@ file_upload_return_code_t file_upload_process_file_done_frame( file_upload_t* fi
     }
 }
 
+void file_upload_get_progress( file_upload_t* file_upload, uint16_t* nb_chunks_sent, uint16_t* nb_chunks_target )
+{
+    *nb_chunks_sent   = file_upload->cntx;
+    *nb_chunks_target = 2 * file_upload->cct;
+}
+
+uint32_t file_upload_get_nb_remaining_fragments( file_upload_t* file_upload, int32_t len )
+{
+    if( file_upload_is_data_remaining( file_upload ) == false )
+    {
+        return 0;
+    }
+    if( ( len - 3 ) < ( CHUNK_NW * 4 ) )
+    {
+        // no fragment can be built with such a buffer, consider the smallest one
+        len = 3 + ( CHUNK_NW * 4 );
+    }
+    // same stop condition as file_upload_is_data_remaining(): twice the chunk count and minimum three frames
+    uint32_t nb_chunks_per_fragment = ( len - 3 ) / ( CHUNK_NW * 4 );
+    uint32_t nb_chunks_left =
+        ( file_upload->cntx < ( 2 * file_upload->cct ) ) ? ( ( 2 * file_upload->cct ) - file_upload->cntx ) : 0;
+    uint32_t nb_fragments  = ( nb_chunks_left + nb_chunks_per_fragment - 1 ) / nb_chunks_per_fragment;
+    uint32_t nb_frames_min = ( file_upload->fntx < 3 ) ? ( 3 - file_upload->fntx ) : 0;
+
+    return ( nb_fragments > nb_frames_min ) ? nb_fragments : nb_frames_min;
+}
+
 uint32_t file_upload_get_average_delay_in_s( file_upload_t* file_upload )
 {
     return file_upload->average_delay;
 }
 
+uint8_t file_upload_get_weight( file_upload_t* file_upload )
+{
+    return file_upload->weight;
+}
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
  */
 
-static void gen_chunk( file_upload_t* file_upload, uint32_t* dst, uint32_t* src, uint32_t cct, uint32_t cid )
+static void gen_chunk( file_upload_t* file_upload, uint32_t* dst, const uint32_t* src, uint32_t cct, uint32_t cid )
 {
+    const uint32_t ncw = ( cct + 31 ) >> 5;  // number of checkwords per chunk
+
     memset( dst, 0, CHUNK_NW * 4 );
-    uint32_t bits = 0;  // initialized to make compiler happy
-    for( uint32_t i = 0; i < cct; i++ )
+    for( uint32_t w = 0; w < ncw; w++ )
     {
-        if( ( i & 31 ) == 0 )
-        {
-            bits = checkbits( cid, cct, i >> 5 );
-        }
-        if( bits == 0 )
+        // each checkword selects up to 32 source chunks, bits above cct in the last checkword are ignored
+        uint32_t bits = phash( cid * ncw + w );
+        if( ( w == ( ncw - 1 ) ) && ( ( cct & 31 ) != 0 ) )
         {
-            continue;
+            bits &= ( 1UL << ( cct & 31 ) ) - 1;
         }
-        if( bits & 1 )
+
+        // only visit the selected chunks instead of testing every bit
+        while( bits != 0 )
         {
-            if( i == 0 )
+            uint32_t i = ( w << 5 ) + __builtin_ctz( bits );
+            bits &= bits - 1;
+
+            if( i >= 2 )
             {
-                uint32_t tmp[2];
-                tmp[0] = file_upload->header[0];
-                tmp[1] = file_upload->header[1];
-                function_xor( dst, tmp, CHUNK_NW );
+                function_xor( dst, src + ( CHUNK_NW * i ) - 3, CHUNK_NW );
             }
-            else if( i == 1 )
+            else if( i == 0 )
             {
-                uint32_t tmp[2];
-                tmp[0] = file_upload->header[2];
-                tmp[1] = *( src );
-                function_xor( dst, tmp, CHUNK_NW );
+                function_xor( dst, &file_upload->header[0], CHUNK_NW );
             }
             else
             {
-                function_xor( dst, src + ( CHUNK_NW * i ) - 3, CHUNK_NW );
+                const uint32_t tmp[CHUNK_NW] = { file_upload->header[2], *( src ) };
+                function_xor( dst, tmp, CHUNK_NW );
             }
         }
-        bits >>= 1;
     }
 }
 
@@ -317,13 +347,7 @@ static uint32_t phash( uint32_t x )
     return x;
 }
 
-static uint32_t checkbits( uint32_t cid, uint32_t cct, uint32_t i )
-{
-    uint32_t ncw = ( cct + 31 ) >> 5;  // number of checkwords per chunk
-    return phash( cid * ncw + i );
-}
-
-static void function_xor( uint32_t* dst, uint32_t* src, int32_t nw )
+static void function_xor( uint32_t* dst, const uint32_t* src, int32_t nw )
 {
     while( nw-- > 0 )
     {
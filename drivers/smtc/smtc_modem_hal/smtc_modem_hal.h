@@ -119,7 +119,10 @@ typedef enum
     CONTEXT_LR1MAC,
     CONTEXT_DEVNONCE,
     CONTEXT_SECURE_ELEMENT,
-    MODEM_CONTEXT_TYPE_SIZE
+    MODEM_CONTEXT_TYPE_SIZE,
+    // User storage implementations keep the crashlog in IDs MODEM_CONTEXT_TYPE_SIZE and MODEM_CONTEXT_TYPE_SIZE + 1,
+    // new contexts come after them so that the IDs already in use do not move
+    CONTEXT_DUTY_CYCLE = MODEM_CONTEXT_TYPE_SIZE + 2,
 } modem_context_type_t;
 
 /*
@@ -177,6 +180,16 @@ uint32_t smtc_modem_hal_get_compensated_time_in_s( void );
  */
 int32_t smtc_modem_hal_get_time_compensation_in_s( void );
 
+/**
+ * @brief Returns a time in seconds that keeps counting across MCU resets
+ *
+ * @remark Used to age the duty cycle context restored after a reset. Return 0 if no such clock is available, the
+ *         restored duty cycle context is then considered as stored right before the reset.
+ *
+ * @return uint32_t Persistent time in seconds, 0 if not available
+ */
+uint32_t smtc_modem_hal_get_persistent_time_in_s( void );
+
 /**
  * @brief Returns the current time in milliseconds
  *
@@ -216,6 +229,19 @@ uint32_t smtc_modem_hal_get_radio_irq_timestamp_in_100us( void );
  */
 void smtc_modem_hal_start_timer( const uint32_t milliseconds, void ( *callback )( void* context ), void* context );
 
+/**
+ * @brief Starts the provided timer objet for the given time in 0.1 milliseconds
+ *
+ * @remark Used by the radio planner to launch the radio tasks. Must be the same timer as the one started by
+ * \ref smtc_modem_hal_start_timer and stopped by \ref smtc_modem_hal_stop_timer.
+ *
+ * @param [in] time_in_100us Number of 0.1 milliseconds (timer value)
+ * @param [in] callback      Callback that will be called in case of timer irq
+ * @param [in] context       Context that will be passed on callback argument
+ */
+void smtc_modem_hal_start_timer_in_100us( const uint32_t time_in_100us, void ( *callback )( void* context ),
+                                          void* context );
+
 /**
  * @brief Stop the provided timer
  */
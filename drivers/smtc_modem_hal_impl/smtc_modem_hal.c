@@ -15,6 +15,7 @@
 #include <zephyr/kernel.h>
 #include <zephyr/settings/settings.h>
 #include <zephyr/sys/__assert.h>
+#include <zephyr/sys/atomic.h>
 #include <zephyr/sys/reboot.h>
 #include <version.h>
 
@@ -43,22 +44,63 @@ static struct smtc_modem_hal_cb *prv_hal_cb;
 static void *prv_smtc_modem_hal_timer_context;
 static void (*prv_smtc_modem_hal_timer_callback)(void *context);
 
-/* flag for enabling/disabling timer interrupt. This is set by the libraray during "critical"
- * sections */
-static bool prv_modem_irq_enabled;
+/* flag for masking the modem events. This is set by the libraray during "critical" sections.
+ * Events that arrive while it is cleared are kept in the event rings and dispatched once the
+ * section ends. It is read by the work that dispatches the events. */
+static atomic_t prv_modem_irq_enabled;
 
-/* The timer and work used for the modem_hal_timer */
+/* cycle count at the start of the current masked section and longest masked section seen */
+static uint32_t prv_modem_irq_masked_start_cyc;
+static uint32_t prv_modem_irq_masked_max_us;
+
+/* The timer used for the modem_hal_timer. Each start or stop bumps the generation so expiries
+ * of a previous timer that are still queued can be told apart and dropped. */
 static void prv_smtc_modem_hal_timer_handler(struct k_timer *timer);
 K_TIMER_DEFINE(prv_smtc_modem_hal_timer, prv_smtc_modem_hal_timer_handler, NULL);
-
-static void prv_smtc_modem_hal_timer_work_handler(struct k_work *work);
-K_WORK_DEFINE(prv_smtc_modem_hal_timer_work, prv_smtc_modem_hal_timer_work_handler);
+static atomic_t prv_smtc_modem_hal_timer_generation;
 
 /* context and callback for the event pin interrupt */
 static void *prv_smtc_modem_hal_radio_irq_context;
 static void (*prv_smtc_modem_hal_radio_irq_callback)(void *context);
 static bool prv_skip_next_radio_irq;
 
+/* timestamp of the radio event being dispatched, valid while prv_in_radio_irq_callback is set */
+static uint32_t prv_radio_irq_timestamp_100us;
+static bool prv_in_radio_irq_callback;
+
+/* Single producer, single consumer ring of modem events. The producer only writes head and the
+ * consumer only writes tail, so no lock is needed on either side. There is one ring per producer:
+ * the timer expiry runs in ISR context and the radio event in the lr11xx driver thread. */
+#define PRV_EVENT_RING_SIZE 8 /* must be a power of 2 */
+
+struct prv_event {
+	uint32_t timestamp_100us;
+	uint32_t data;
+};
+
+struct prv_event_ring {
+	struct prv_event events[PRV_EVENT_RING_SIZE];
+	atomic_t head;
+	atomic_t tail;
+};
+
+static struct prv_event_ring prv_timer_ring;
+static struct prv_event_ring prv_radio_ring;
+
+/* Timer expiries dropped because the timer ring was full */
+static atomic_t prv_timer_dropped;
+
+/* Radio events that did not fit in the radio ring are never dropped. The lr11xx keeps its irq
+ * flags latched until the radio irq callback reads them, so they are merged into one pending
+ * event, stamped with the first of them and dispatched once the ring is empty. While it is
+ * pending, new radio events are merged too so the capture order is kept. */
+static atomic_t prv_radio_overflow;
+static atomic_t prv_radio_overflow_timestamp_100us;
+
+/* The work that drains the event rings and calls the smtc modem stack callbacks */
+static void prv_event_work_handler(struct k_work *work);
+K_WORK_DEFINE(prv_event_work, prv_event_work_handler);
+
 /* ------------ Initialization ------------
  *
  * This function is defined in smtc_modem_hal_init.h
@@ -123,6 +165,18 @@ uint32_t smtc_modem_hal_get_compensated_time_in_s(void)
 	return smtc_modem_hal_get_time_in_s() + smtc_modem_hal_get_time_compensation_in_s();
 }
 
+uint32_t smtc_modem_hal_get_persistent_time_in_s(void)
+{
+	uint32_t time_s;
+
+	/* The callback is optional, uptime restarts from 0 on every reset so it can not be used */
+	if (!prv_hal_cb->get_persistent_time || prv_hal_cb->get_persistent_time(&time_s) != 0) {
+		return 0;
+	}
+
+	return time_s;
+}
+
 uint32_t smtc_modem_hal_get_time_in_ms(void)
 {
 	/* The wrapping every 49 days is expected by the modem lib */
@@ -156,74 +210,272 @@ uint32_t smtc_modem_hal_get_time_in_100us(void)
 /* Semtech's HAL for STM uses the same implementation for mtc_modem_hal_get_time_in_100us
  * and smtc_modem_hal_get_radio_irq_timestamp_in_100us.
  *
- * This does not make sense from just reading the doscstring in smtc_modem_hal.h or the porting
- * guide, where we would assume smtc_modem_hal_get_radio_irq_timestamp_in_100us should return a time
- * difference from some "event".
- *
- * This should be checked with Semtech
+ * Here the radio events are queued with the time they were captured, so while the radio irq
+ * callback runs that time is returned instead. It does not include the latency of the dispatch.
+ * Outside of the callback this falls back to the current time.
  */
 uint32_t smtc_modem_hal_get_radio_irq_timestamp_in_100us(void)
 {
-	return smtc_modem_hal_get_time_in_100us();
+	if (!prv_in_radio_irq_callback) {
+		return smtc_modem_hal_get_time_in_100us();
+	}
+
+	return prv_radio_irq_timestamp_100us;
 }
 
-/* ------------ Timer management ------------*/
+/* ------------ Event rings ------------*/
 
 /**
- * @brief Called when the prv_smtc_modem_hal_timer_work is submitted.
+ * @brief Queue an event, called by the only producer of the ring.
  *
- * Actually calls the callback that was requested by the smtc modem stack.
+ * @return true if the event was queued, false if the ring was full.
  */
-static void prv_smtc_modem_hal_timer_work_handler(struct k_work *work)
+static bool prv_event_ring_put(struct prv_event_ring *ring, uint32_t timestamp_100us,
+			       uint32_t data)
 {
-	ARG_UNUSED(work);
+	atomic_val_t head = atomic_get(&ring->head);
+
+	if ((head - atomic_get(&ring->tail)) >= PRV_EVENT_RING_SIZE) {
+		return false;
+	}
+
+	ring->events[head & (PRV_EVENT_RING_SIZE - 1)] = (struct prv_event){
+		.timestamp_100us = timestamp_100us,
+		.data = data,
+	};
+	/* atomic_set is a full barrier, the event is written before it is published */
+	atomic_set(&ring->head, head + 1);
+
+	return true;
+}
+
+/**
+ * @brief Get the oldest queued event without removing it, called by the consumer.
+ *
+ * @return NULL if the ring is empty.
+ */
+static struct prv_event *prv_event_ring_peek(struct prv_event_ring *ring)
+{
+	atomic_val_t tail = atomic_get(&ring->tail);
+
+	if (tail == atomic_get(&ring->head)) {
+		return NULL;
+	}
+
+	return &ring->events[tail & (PRV_EVENT_RING_SIZE - 1)];
+}
+
+/**
+ * @brief Remove the oldest queued event, called by the consumer after a peek.
+ */
+static void prv_event_ring_pop(struct prv_event_ring *ring)
+{
+	atomic_inc(&ring->tail);
+}
+
+/**
+ * @brief Get the oldest radio event, from the radio ring or else the merged overflow.
+ *
+ * @return false if no radio event is pending.
+ */
+static bool prv_radio_event_peek(struct prv_event *event, bool *is_overflow)
+{
+	struct prv_event *queued = prv_event_ring_peek(&prv_radio_ring);
+
+	*is_overflow = false;
+	if (queued) {
+		*event = *queued;
+		return true;
+	}
+
+	/* The ring is only filled again once the overflow is dispatched */
+	if (atomic_get(&prv_radio_overflow)) {
+		*event = (struct prv_event){
+			.timestamp_100us = (uint32_t)atomic_get(&prv_radio_overflow_timestamp_100us),
+		};
+		*is_overflow = true;
+		return true;
+	}
+
+	return false;
+}
+
+/**
+ * @brief Dispatch a queued radio event to the radio irq callback.
+ */
+static void prv_event_dispatch_radio(const struct prv_event *event)
+{
+	/* This logic is based on our understanding of section 5.24 of the porting guide.
+	 * NOTE:
+	 * In simple (init, join, uplink) tests smtc_modem_hal_radio_irq_clear_pending is
+	 * never called. This means that prv_skip_next_radio_irq is never true and no callbacks are
+	 * ever skipped.
+	 * This is why the LOG bellow is a warning. If it gets printed and you are encountering
+	 * issues, this might be the culprit. */
+	if (prv_skip_next_radio_irq) {
+		LOG_WRN("Skipping radio irq");
+		prv_skip_next_radio_irq = false;
+		return;
+	}
+
+	prv_radio_irq_timestamp_100us = event->timestamp_100us;
+	prv_in_radio_irq_callback = true;
+	prv_smtc_modem_hal_radio_irq_callback(prv_smtc_modem_hal_radio_irq_context);
+	prv_in_radio_irq_callback = false;
+}
+
+/**
+ * @brief Dispatch a queued timer expiry to the timer callback.
+ */
+static void prv_event_dispatch_timer(const struct prv_event *event)
+{
+	/* The timer was restarted or stopped after this expiry was queued */
+	if (event->data != (uint32_t)atomic_get(&prv_smtc_modem_hal_timer_generation)) {
+		return;
+	}
 
 	prv_smtc_modem_hal_timer_callback(prv_smtc_modem_hal_timer_context);
 }
 
+/**
+ * @brief Called when the prv_event_work is submitted.
+ *
+ * Dispatches the queued events in the order they were captured to the callbacks that were
+ * requested by the smtc modem stack. We have to execute these from a thread and not from irq since
+ * SPI transactions to lr11xx may be performed. Events are left queued while the modem irq is
+ * masked, enabling it submits the work again.
+ */
+static void prv_event_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	while (atomic_get(&prv_modem_irq_enabled)) {
+		struct prv_event *timer_event = prv_event_ring_peek(&prv_timer_ring);
+		struct prv_event radio_event;
+		bool is_overflow;
+		bool has_radio = prv_radio_event_peek(&radio_event, &is_overflow);
+		struct prv_event event;
+
+		if (has_radio &&
+		    (!timer_event ||
+		     (int32_t)(radio_event.timestamp_100us - timer_event->timestamp_100us) <= 0)) {
+			/* Popped before the dispatch, so a radio event merged in the overflow right
+			 * before it is cleared is still latched by the lr11xx and read by this dispatch */
+			if (is_overflow) {
+				atomic_clear(&prv_radio_overflow);
+			} else {
+				prv_event_ring_pop(&prv_radio_ring);
+			}
+			prv_event_dispatch_radio(&radio_event);
+		} else if (timer_event) {
+			/* Copy before popping, the producer may reuse the slot right after */
+			event = *timer_event;
+			prv_event_ring_pop(&prv_timer_ring);
+			prv_event_dispatch_timer(&event);
+		} else {
+			break;
+		}
+	}
+
+	if (atomic_get(&prv_timer_dropped)) {
+		LOG_ERR("Modem timer expiries dropped: %ld", (long)atomic_clear(&prv_timer_dropped));
+	}
+}
+
+/* ------------ Timer management ------------*/
+
 /**
  * @brief Called when the prv_smtc_modem_hal_timer expires.
  *
- * Submits the prv_smtc_modem_hal_timer_work to be handle the callback.
+ * Queues the expiry with its timestamp and submits the prv_event_work to handle the callback.
  */
 static void prv_smtc_modem_hal_timer_handler(struct k_timer *timer)
 {
 	ARG_UNUSED(timer);
 
-	if (prv_modem_irq_enabled) {
-		/* We have to execute this from a thread and not from irq since SPI transactions to
-		 * lr11xx may be performed. */
-		k_work_submit(&prv_smtc_modem_hal_timer_work);
+	if (prv_event_ring_put(&prv_timer_ring, smtc_modem_hal_get_time_in_100us(),
+			       (uint32_t)atomic_get(&prv_smtc_modem_hal_timer_generation))) {
+		k_work_submit(&prv_event_work);
+	} else {
+		atomic_inc(&prv_timer_dropped);
 	}
 };
 
-void smtc_modem_hal_start_timer(const uint32_t milliseconds, void (*callback)(void *context),
-				void *context)
+/**
+ * @brief Start the one-shot prv_smtc_modem_hal_timer.
+ *
+ * The previous timer is stopped before the generation is bumped: an expiry of the previous timer
+ * is then stamped with the old generation and dropped, it can never run the new callback early.
+ */
+static void prv_smtc_modem_hal_timer_start(k_timeout_t duration, void (*callback)(void *context),
+					   void *context)
 {
+	k_timer_stop(&prv_smtc_modem_hal_timer);
+	atomic_inc(&prv_smtc_modem_hal_timer_generation);
 	prv_smtc_modem_hal_timer_callback = callback;
 	prv_smtc_modem_hal_timer_context = context;
 
-	/* start one-shot timer */
-	k_timer_start(&prv_smtc_modem_hal_timer, K_MSEC(milliseconds), K_NO_WAIT);
+	k_timer_start(&prv_smtc_modem_hal_timer, duration, K_NO_WAIT);
+}
+
+void smtc_modem_hal_start_timer(const uint32_t milliseconds, void (*callback)(void *context),
+				void *context)
+{
+	prv_smtc_modem_hal_timer_start(K_MSEC(milliseconds), callback, context);
+}
+
+void smtc_modem_hal_start_timer_in_100us(const uint32_t time_in_100us,
+					 void (*callback)(void *context), void *context)
+{
+	/* the resolution is the system tick */
+	prv_smtc_modem_hal_timer_start(K_USEC((uint64_t)time_in_100us * 100), callback, context);
 }
 
 void smtc_modem_hal_stop_timer(void)
 {
 	k_timer_stop(&prv_smtc_modem_hal_timer);
+	atomic_inc(&prv_smtc_modem_hal_timer_generation);
 }
 
 /* ------------ IRQ management ------------*/
 
+/* No interrupt is disabled here. Timer and radio events keep being queued with their timestamp
+ * and only their dispatch is held back until the modem irq is enabled again. */
 void smtc_modem_hal_disable_modem_irq(void)
 {
-	prv_modem_irq_enabled = false;
-	lr11xx_board_disable_interrupt(prv_lr11xx_dev);
+	if (atomic_clear(&prv_modem_irq_enabled)) {
+		prv_modem_irq_masked_start_cyc = k_cycle_get_32();
+	}
 }
 
 void smtc_modem_hal_enable_modem_irq(void)
 {
-	prv_modem_irq_enabled = true;
-	lr11xx_board_enable_interrupt(prv_lr11xx_dev);
+	if (!atomic_get(&prv_modem_irq_enabled)) {
+		uint32_t masked_us =
+			k_cyc_to_us_ceil32(k_cycle_get_32() - prv_modem_irq_masked_start_cyc);
+
+		if (masked_us > prv_modem_irq_masked_max_us) {
+			prv_modem_irq_masked_max_us = masked_us;
+		}
+	}
+	atomic_set(&prv_modem_irq_enabled, true);
+
+	/* Dispatch the events that were queued while masked */
+	if (prv_event_ring_peek(&prv_timer_ring) || prv_event_ring_peek(&prv_radio_ring) ||
+	    atomic_get(&prv_radio_overflow)) {
+		k_work_submit(&prv_event_work);
+	}
+}
+
+uint32_t smtc_modem_hal_get_max_modem_irq_masked_time_us(bool reset)
+{
+	uint32_t max_us = prv_modem_irq_masked_max_us;
+
+	if (reset) {
+		prv_modem_irq_masked_max_us = 0;
+	}
+
+	return max_us;
 }
 
 /* ------------ Context saving management ------------*/
@@ -447,21 +699,18 @@ int32_t smtc_modem_hal_get_signed_random_nb_in_range(const int32_t val_1, const
  */
 void prv_lr11xx_event_cb(const struct device *dev)
 {
-	/* This logic is based on our understanding of section 5.24 of the porting guide.
-	 * NOTE:
-	 * In simple (init, join, uplink) tests smtc_modem_hal_radio_irq_clear_pending is
-	 * never called. This means that prv_skip_next_radio_irq is never true and no callbacks are
-	 * ever skipped.
-	 * This is why the LOG bellow is a warning. If it gets printed and you are encountering
-	 * issues, this might be the culprit. */
-	if (prv_skip_next_radio_irq) {
-		LOG_WRN("Skipping radio irq");
-		prv_skip_next_radio_irq = false;
-		return;
-	}
+	/* Due to the way the lr11xx driver is implemented, this is called from the system workq and
+	 * not from the event pin ISR. The event is only captured here and dispatched by
+	 * prv_event_work, so the skip logic and the modem irq masking are applied in one place. */
+	uint32_t timestamp_100us = smtc_modem_hal_get_time_in_100us();
 
-	/* Due to the way the lr11xx driver is implemented, this is called from the system workq. */
-	prv_smtc_modem_hal_radio_irq_callback(prv_smtc_modem_hal_radio_irq_context);
+	if (!atomic_get(&prv_radio_overflow) &&
+	    !prv_event_ring_put(&prv_radio_ring, timestamp_100us, 0)) {
+		/* The stamp is written before the overflow is published */
+		atomic_set(&prv_radio_overflow_timestamp_100us, timestamp_100us);
+		atomic_set(&prv_radio_overflow, true);
+	}
+	k_work_submit(&prv_event_work);
 }
 
 void smtc_modem_hal_irq_config_radio_irq(void (*callback)(void *context), void *context)
@@ -13,6 +13,7 @@
 extern "C" {
 #endif
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <zephyr/device.h>
 
@@ -50,6 +51,16 @@ struct smtc_modem_hal_cb {
 	 */
 	int (*get_voltage)(uint32_t *value);
 
+	/**
+	 * @brief Get persistent time callback, optional (can be NULL)
+	 *
+	 * @param [out] value A time in seconds that keeps counting across MCU resets (RTC, wall
+	 * clock). It is used to age the duty cycle context restored after a reset.
+	 *
+	 * @return int 0 if the time was set, or a negative error code if no valid time is available
+	 */
+	int (*get_persistent_time)(uint32_t *value);
+
 #ifdef CONFIG_LORA_BASICS_MODEM_USER_STORAGE_IMPL
 
 	/**
@@ -85,7 +96,7 @@ struct smtc_modem_hal_cb {
  *
  * @param[in] lr11xx The device pointer of the lr11xx instance that will be used.
  * @param[in] hal_cb The callbacks to use for the hal implementation. Mus not be NULL. All of the
- * callbacks must be set.
+ * callbacks must be set, except get_persistent_time.
  */
 void smtc_modem_hal_init(const struct device *lr11xx, struct smtc_modem_hal_cb *hal_cb);
 
@@ -101,6 +112,19 @@ void smtc_modem_hal_init(const struct device *lr11xx, struct smtc_modem_hal_cb *
  */
 void smtc_modem_hal_irq_reset_radio_irq(void);
 
+/**
+ * @brief Get the longest time the modem irq was masked by the lora basics modem.
+ *
+ * While masked, timer and radio events are queued and their callbacks are only run once the
+ * modem irq is enabled again, so this is the worst case dispatch delay added by the library
+ * "critical" sections. It includes the time the radio is suspended for user access.
+ *
+ * @param[in] reset If true, the maximum is cleared after being read.
+ *
+ * @return uint32_t The longest masked time, in microseconds.
+ */
+uint32_t smtc_modem_hal_get_max_modem_irq_masked_time_us(bool reset);
+
 #ifdef __cplusplus
 }
 #endif
@@ -35,6 +35,7 @@ static void send_frame(const uint8_t *buffer, const uint8_t length, const bool c
 /* CUSTOM STORAGE IMPLEMENTATION */
 static void context_store(const uint8_t ctx_id, const uint8_t *buffer, const uint32_t size);
 static void context_restore(const uint8_t ctx_id, uint8_t *buffer, const uint32_t size);
+static int get_persistent_time(uint32_t *time_s);
 
 /* ---------------- SAMPLE CONFIGURATION ---------------- */
 
@@ -83,6 +84,8 @@ struct smtc_app_env_callbacks env_callbacks = {
 
 	.context_store = context_store,
 	.context_restore = context_restore,
+	/* Optional, ages the duty cycle state restored after a reset */
+	.get_persistent_time = get_persistent_time,
 };
 
 /* lr11xx radio context and its use in the ralf layer */
@@ -260,11 +263,11 @@ static void send_frame(const uint8_t *buffer, const uint8_t length, bool tx_conf
 /* NOTE: This is the simplest storage implementation possible just to demonstrate the callbacks.
  * Using the .noinit RAM section is not recommended for such use-cases.
  *
- * In the current version of the modem library, the context ID is in the range [0, 5].
- * The largest ID is MODEM_CONTEXT_TYPE_SIZE+1. Do not rely on this value, as it may change in the
- * future.
+ * In the current version of the modem library, the context ID is in the range [0, 6].
+ * IDs MODEM_CONTEXT_TYPE_SIZE and MODEM_CONTEXT_TYPE_SIZE+1 hold the crashlog and the largest ID
+ * is CONTEXT_DUTY_CYCLE. Do not rely on these values, as they may change in the future.
  * */
-static uint8_t storage[6][256] __attribute__((section(".noinit")));
+static uint8_t storage[7][256] __attribute__((section(".noinit")));
 
 /**
  * @brief Store context. The application is responsible for storing the context persistently.
@@ -294,3 +297,43 @@ static void context_restore(const uint8_t ctx_id, uint8_t *buffer, const uint32_
 
 	memcpy(buffer, storage[ctx_id], size);
 }
+
+#define PERSISTENT_TIME_MAGIC 0x54494d45
+
+/* Time kept in the .noinit RAM section, like the contexts */
+static struct {
+	uint32_t magic;
+	uint32_t time_s;
+} persistent_time __attribute__((section(".noinit")));
+
+/**
+ * @brief Get a time that keeps counting across resets.
+ *
+ * The time only advances while the MCU runs and not while it is held in reset, so it is lower than
+ * the real time. The duty cycle state restored after a reset is then aged less than it should be,
+ * which keeps it on the safe side. A real application would read an RTC instead.
+ *
+ * @param[out] time_s The time in seconds.
+ *
+ * @return int 0 as the time is always available.
+ */
+static int get_persistent_time(uint32_t *time_s)
+{
+	static bool is_init;
+	static uint32_t base_s;
+
+	if (!is_init) {
+		is_init = true;
+		if (persistent_time.magic != PERSISTENT_TIME_MAGIC) {
+			persistent_time.magic = PERSISTENT_TIME_MAGIC;
+			/* 0 is reserved for "not available" */
+			persistent_time.time_s = 1;
+		}
+		base_s = persistent_time.time_s;
+	}
+
+	persistent_time.time_s = base_s + k_uptime_get() / MSEC_PER_SEC;
+	*time_s = persistent_time.time_s;
+
+	return 0;
+}
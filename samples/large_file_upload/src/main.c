@@ -28,6 +28,8 @@ LOG_MODULE_REGISTER(main);
 static void on_modem_reset(uint16_t reset_count);
 static void on_modem_network_joined(void);
 static void on_modem_upload_done(smtc_modem_event_uploaddone_status_t status);
+static void on_modem_upload_progress(uint8_t session_id, uint16_t nb_chunks_sent,
+				     uint16_t nb_chunks_target, uint32_t estimated_completion_s);
 
 /* ---------------- SAMPLE CONFIGURATION ---------------- */
 
@@ -45,7 +47,10 @@ static void on_modem_upload_done(smtc_modem_event_uploaddone_status_t status);
 #define APP_SMTC_MODEM_LFU_SIZE 256
 
 /**
- * @brief Average delay in second between two uplinks
+ * @brief Minimum delay in second between two uplinks
+ *
+ * The modem spaces fragments further when the regional duty cycle requires it, 0 sends them as fast
+ * as the regulation allows.
  */
 #define APP_SMTC_MODEM_LFU_AVERAGE_DELAY 10
 
@@ -68,6 +73,7 @@ static struct smtc_app_event_callbacks event_callbacks = {
 	.reset = on_modem_reset,
 	.joined = on_modem_network_joined,
 	.upload_done = on_modem_upload_done,
+	.upload_progress = on_modem_upload_progress,
 
 };
 
@@ -141,4 +147,11 @@ static void on_modem_network_joined(void)
 void on_modem_upload_done(smtc_modem_event_uploaddone_status_t status)
 {
 	LOG_INF("Upload done. Status: %s", smtc_modem_event_uploaddone_status_to_str(status));
-}
\ No newline at end of file
+}
+
+void on_modem_upload_progress(uint8_t session_id, uint16_t nb_chunks_sent,
+			      uint16_t nb_chunks_target, uint32_t estimated_completion_s)
+{
+	LOG_INF("Upload %d: %d/%d chunks sent, done in ~%u s", session_id, nb_chunks_sent,
+		nb_chunks_target, estimated_completion_s);
+}
@@ -0,0 +1,47 @@
+/** @file region_ram_report.c
+ *
+ * @brief Region context sizes, reported at build time
+ *
+ * Compiled in an object library that is never linked: each symbol is sized as the context of one enabled region, so
+ * scripts/region_ram_report.cmake reads the sizes from the object with nm.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2022 Irnas. All rights reserved.
+ */
+
+#include "smtc_real_defs.h"
+
+#if defined( REGION_WW2G4 )
+const uint8_t region_ram_report_ww_2g4[sizeof( region_ww2g4_context_t )] = { 0 };
+#endif
+#if defined( REGION_EU_868 )
+const uint8_t region_ram_report_eu_868[sizeof( region_eu868_context_t )] = { 0 };
+#endif
+#if defined( REGION_AS_923 )
+const uint8_t region_ram_report_as_923[sizeof( region_as923_context_t )] = { 0 };
+#endif
+#if defined( REGION_US_915 )
+const uint8_t region_ram_report_us_915[sizeof( region_us915_context_t )] = { 0 };
+#endif
+#if defined( REGION_AU_915 )
+const uint8_t region_ram_report_au_915[sizeof( region_au915_context_t )] = { 0 };
+#endif
+#if defined( REGION_CN_470 )
+const uint8_t region_ram_report_cn_470[sizeof( region_cn470_context_t )] = { 0 };
+#endif
+#if defined( REGION_CN_470_RP_1_0 )
+const uint8_t region_ram_report_cn_470_rp_1_0[sizeof( region_cn470_rp_1_0_context_t )] = { 0 };
+#endif
+#if defined( REGION_IN_865 )
+const uint8_t region_ram_report_in_865[sizeof( region_in865_context_t )] = { 0 };
+#endif
+#if defined( REGION_KR_920 )
+const uint8_t region_ram_report_kr_920[sizeof( region_kr920_context_t )] = { 0 };
+#endif
+#if defined( REGION_RU_864 )
+const uint8_t region_ram_report_ru_864[sizeof( region_ru864_context_t )] = { 0 };
+#endif
+
+// Union reserving the context of the largest enabled region, and the whole regional object holding it
+const uint8_t region_ram_report_smtc_real_t_region[sizeof( ( ( smtc_real_t* ) 0 )->region )] = { 0 };
+const uint8_t region_ram_report_smtc_real_t[sizeof( smtc_real_t )]                        = { 0 };
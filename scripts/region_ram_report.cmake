@@ -0,0 +1,24 @@
+# Print the RAM used by each region context, run at build time by drivers/CMakeLists.txt:
+#
+#   cmake -DNM=<nm> -DOBJECTS=<region_ram_report.c object> -P region_ram_report.cmake
+#
+# Each region_ram_report_<region> symbol of the object is sized as the context of that region.
+
+execute_process(
+    COMMAND ${NM} --print-size --radix=d ${OBJECTS}
+    OUTPUT_VARIABLE symbols
+    RESULT_VARIABLE result
+)
+if(NOT result EQUAL 0)
+    message(WARNING "Region RAM report: ${NM} failed on ${OBJECTS}")
+    return()
+endif()
+
+message("Region RAM report (bytes):")
+string(REPLACE "\n" ";" symbols "${symbols}")
+foreach(line IN LISTS symbols)
+    if(line MATCHES "^[0-9]+ +([0-9]+) +[A-Za-z] +region_ram_report_([A-Za-z0-9_]+)$")
+        math(EXPR size "${CMAKE_MATCH_1}")
+        message("  ${CMAKE_MATCH_2}: ${size}")
+    endif()
+endforeach()
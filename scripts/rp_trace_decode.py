@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+"""Render the radio planner trace ring as a timeline.
+
+The input is the content of the rp_trace_record_t array returned by rp_trace_read(), oldest record first, either as a
+raw binary file or as text made of hexadecimal bytes (for example a log of the records dumped with LOG_HEXDUMP_INF).
+Each record is 8 bytes, little endian: uint32 timestamp in 100us, uint8 event, uint8 hook id, uint16 argument.
+
+Example:
+    rp_trace_decode.py trace.bin
+    rp_trace_decode.py --hex --d2d trace.txt
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+RECORD = struct.Struct("<IBBH")
+
+# Must match rp_trace_events_t in radio_planner_types.h
+EVENTS = [
+    "ENQUEUE",
+    "LAUNCH",
+    "READY",
+    "SUSPEND",
+    "ABORT",
+    "RADIO_IRQ",
+    "ALARM",
+    "TASK_TIMER",
+]
+
+# Must match rp_task_types_t in radio_planner_types.h
+TASK_TYPES = [
+    "RX_LORA",
+    "RX_FSK",
+    "TX_LORA",
+    "TX_FSK",
+    "TX_LR_FHSS",
+    "CAD",
+    "CAD_TO_TX",
+    "CAD_TO_RX",
+    "GNSS_SNIFF",
+    "WIFI_SNIFF",
+    "GNSS_RSSI",
+    "WIFI_RSSI",
+    "LBT",
+    "USER",
+    "NONE",
+]
+
+# Must match rp_task_states_t in radio_planner_types.h
+TASK_STATES = ["SCHEDULE", "ASAP", "RUNNING", "ABORTED", "FINISHED"]
+
+# Must match rp_status_t in radio_planner_types.h
+STATUSES = [
+    "RX_CRC_ERROR",
+    "CAD_POSITIVE",
+    "CAD_NEGATIVE",
+    "TX_DONE",
+    "RX_PACKET",
+    "RX_TIMEOUT",
+    "LBT_FREE_CHANNEL",
+    "LBT_BUSY_CHANNEL",
+    "WIFI_SCAN_DONE",
+    "GNSS_SCAN_DONE",
+    "TASK_ABORTED",
+    "TASK_INIT",
+    "LR_FHSS_HOP",
+]
+
+
+def hook_names(d2d):
+    """Hook names in RP_HOOK_ID_DEF order for the Zephyr port, dynamic hooks come after them."""
+    names = [
+        "USER_SUSPEND",
+        "USER_SUSPEND_0",
+        "SUSPEND",
+        "LR1MAC_STACK",
+        "LBT",
+        "RTC_COMPENSATION",
+        "CLASS_B_BEACON",
+    ]
+    if d2d:
+        names.append("CLASS_B_D2D")
+    names += ["CLASS_B_PING_SLOT", "USER_SUSPEND_1", "USER_SUSPEND_2", "CLASS_C"]
+    return names
+
+
+def name(table, index):
+    return table[index] if index < len(table) else str(index)
+
+
+def describe(event, arg):
+    if event == 0:
+        return "{} {}".format(name(TASK_STATES, arg >> 8), name(TASK_TYPES, arg & 0xFF))
+    if event == 1:
+        return name(TASK_TYPES, arg)
+    if event == 2:
+        return "latency {:.1f} ms".format(arg / 10)
+    if event == 3:
+        return "{} ms left".format(arg)
+    if event == 5:
+        return name(STATUSES, arg)
+    if event == 7:
+        return "called" if arg else "dropped"
+    return ""
+
+
+def read_records(path, hex_input):
+    with open(path, "rb") as f:
+        data = f.read()
+    if hex_input:
+        data = bytes(int(byte, 16) for byte in re.findall(r"\b[0-9a-fA-F]{2}\b", data.decode(errors="ignore")))
+    if len(data) % RECORD.size:
+        print("warning: {} trailing bytes ignored".format(len(data) % RECORD.size), file=sys.stderr)
+    return [RECORD.unpack_from(data, offset) for offset in range(0, len(data) - RECORD.size + 1, RECORD.size)]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("file", help="dumped trace records")
+    parser.add_argument("--hex", action="store_true", help="the file is text made of hexadecimal bytes")
+    parser.add_argument("--d2d", action="store_true", help="built with CONFIG_LORA_BASICS_MODEM_D2D")
+    args = parser.parse_args()
+
+    hooks = hook_names(args.d2d)
+    records = read_records(args.file, args.hex)
+    if not records:
+        return
+
+    start = records[0][0]
+    previous = start
+    print("{:>10} {:>9}  {:<18} {:<10} {}".format("time ms", "delta ms", "hook", "event", "detail"))
+    for timestamp, event, hook_id, arg in records:
+        # Timestamps wrap on 32 bits, a radio irq is stamped when it was received so it can go back in time
+        elapsed = ((timestamp - start + 0x80000000) & 0xFFFFFFFF) - 0x80000000
+        delta = ((timestamp - previous + 0x80000000) & 0xFFFFFFFF) - 0x80000000
+        previous = timestamp
+        hook = hooks[hook_id] if hook_id < len(hooks) else "DYNAMIC_{}".format(hook_id - len(hooks))
+        print(
+            "{:>10.1f} {:>9.1f}  {:<18} {:<10} {}".format(
+                elapsed / 10, delta / 10, hook, name(EVENTS, event), describe(event, arg)
+            )
+        )
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,26 @@
+# Virtual time HAL and mock radio shared by the test suites, with the include directories of the
+# smtc modem core they are built against
+
+set(SMTC_DIR ${CMAKE_CURRENT_LIST_DIR}/../../drivers/smtc)
+
+# Suites built for unit_testing set TEST_TARGET to testbinary
+if(NOT DEFINED TEST_TARGET)
+    set(TEST_TARGET app)
+endif()
+
+target_sources(${TEST_TARGET} PRIVATE
+    ${CMAKE_CURRENT_LIST_DIR}/src/test_hal.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/test_radio.c
+)
+
+target_include_directories(${TEST_TARGET} PRIVATE
+    ${CMAKE_CURRENT_LIST_DIR}/include
+    ${SMTC_DIR}/smtc_modem_core
+    ${SMTC_DIR}/smtc_modem_core/modem_config
+    ${SMTC_DIR}/smtc_modem_core/smtc_ral/src
+    ${SMTC_DIR}/smtc_modem_core/smtc_ralf/src
+    ${SMTC_DIR}/smtc_modem_hal
+)
+
+# The modem traces go through the HAL, which the tests do not print
+target_compile_definitions(${TEST_TARGET} PRIVATE MODEM_HAL_DBG_TRACE=0)
@@ -0,0 +1,89 @@
+/** @file test_hal.h
+ *
+ * @brief Virtual time implementation of the smtc modem HAL for the host tests
+ *
+ * Time only moves when the test runs it with test_hal_run_until() or test_hal_advance_ms(). The
+ * modem timer and the radio irq are events of the virtual clock, they are dispatched in time
+ * order from these functions, never while the modem irq is disabled.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2022 Irnas. All rights reserved.
+ */
+
+#ifndef TEST_HAL_H
+#define TEST_HAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <smtc_modem_hal.h>
+
+/**
+ * @brief Reset the HAL: set the clock, drop the pending events and erase the stored contexts
+ *
+ * @param[in] start_100us Time of the virtual clock after the reset, in 100 us. Keep it above 0,
+ *			  the modem uses 0 as "no timestamp".
+ * @param[in] seed Seed of the random numbers, 0 is replaced by 1
+ */
+void test_hal_reset(uint64_t start_100us, uint32_t seed);
+
+/**
+ * @brief Get the time of the virtual clock, in 100 us
+ */
+uint64_t test_hal_now_100us(void);
+
+/**
+ * @brief Dispatch the next event if it is due at or before @p limit_100us
+ *
+ * The clock is moved to the time of the event. A radio irq is dispatched before a timer expiry
+ * due at the same time.
+ *
+ * @return true if an event has been dispatched
+ */
+bool test_hal_run_next(uint64_t limit_100us);
+
+/**
+ * @brief Dispatch the events due up to @p time_100us, then move the clock to it
+ */
+void test_hal_run_until(uint64_t time_100us);
+
+/**
+ * @brief Run the virtual clock for @p ms milliseconds
+ */
+void test_hal_advance_ms(uint32_t ms);
+
+/**
+ * @brief Schedule the radio irq
+ *
+ * @param[in] time_100us Time of the irq, in 100 us
+ * @param[in] latch Called at the irq time, before the radio irq callback, to latch the irq status
+ *		    of the radio. Can be NULL.
+ */
+void test_hal_radio_irq_set(uint64_t time_100us, void (*latch)(void));
+
+/**
+ * @brief Drop the scheduled radio irq
+ */
+void test_hal_radio_irq_clear(void);
+
+/**
+ * @brief Check if the modem timer is running
+ *
+ * @param[out] expiry_100us Expiry time of the timer, can be NULL
+ */
+bool test_hal_timer_is_armed(uint64_t *expiry_100us);
+
+/**
+ * @brief Get the number of context stores of @p ctx_type since the reset
+ */
+uint32_t test_hal_context_store_count(modem_context_type_t ctx_type);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TEST_HAL_H */
@@ -0,0 +1,90 @@
+/** @file test_radio.h
+ *
+ * @brief Mock radio for the host tests
+ *
+ * The mock implements every operation of the radio abstraction layer on the virtual clock of
+ * test_hal.h. It keeps the mode of the radio to account the time spent out of sleep and raises
+ * the irqs the test schedules with test_radio_irq_at().
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2022 Irnas. All rights reserved.
+ */
+
+#ifndef TEST_RADIO_H
+#define TEST_RADIO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <ralf.h>
+
+enum test_radio_mode {
+	TEST_RADIO_MODE_SLEEP,
+	TEST_RADIO_MODE_STANDBY,
+	TEST_RADIO_MODE_TX,
+	TEST_RADIO_MODE_RX,
+	TEST_RADIO_MODE_CAD,
+};
+
+struct test_radio_stats {
+	/* Time spent out of sleep, in 100 us */
+	uint64_t on_100us;
+	/* Time spent in tx, rx and standby, in 100 us */
+	uint64_t tx_100us;
+	uint64_t rx_100us;
+	uint64_t standby_100us;
+	/* Longest time spent in standby at once, in 100 us */
+	uint64_t standby_max_100us;
+	/* Number of wake ups from sleep */
+	uint32_t wake_up_nb;
+};
+
+/**
+ * @brief The mock radio, to give to the radio planner
+ */
+extern const ralf_t test_radio;
+
+/**
+ * @brief Put the radio to sleep and clear its statistics and irqs
+ */
+void test_radio_reset(void);
+
+/**
+ * @brief Get the mode of the radio
+ */
+enum test_radio_mode test_radio_get_mode(void);
+
+/**
+ * @brief Get the statistics of the radio, accounted up to now
+ */
+void test_radio_get_stats(struct test_radio_stats *stats);
+
+/**
+ * @brief Raise @p irq at @p time_100us
+ *
+ * The irq is dropped if the radio is put to standby or to sleep before, the radio goes to
+ * standby when it is raised.
+ */
+void test_radio_irq_at(ral_irq_t irq, uint64_t time_100us);
+
+/**
+ * @brief Set the packet read by the next payload and packet status reads
+ */
+void test_radio_set_rx_packet(const uint8_t *payload, uint16_t size, int16_t rssi_in_dbm,
+			      int16_t snr_in_db);
+
+/**
+ * @brief Get the last frequency, in Hz, and the last LoRa modulation the radio was set to
+ */
+uint32_t test_radio_get_rf_freq(void);
+const ral_lora_mod_params_t *test_radio_get_lora_mod_params(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TEST_RADIO_H */
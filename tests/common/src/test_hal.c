@@ -0,0 +1,365 @@
+/** @file test_hal.c
+ *
+ * @brief Virtual time implementation of the smtc modem HAL for the host tests
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2022 Irnas. All rights reserved.
+ */
+
+#include <test_hal.h>
+
+#include <string.h>
+
+#include <zephyr/ztest.h>
+
+/* Size of the storage of each context, above the largest context of the modem */
+#define PRV_CONTEXT_SIZE 1024
+
+/* Number of context ids, up to CONTEXT_DUTY_CYCLE */
+#define PRV_CONTEXT_NB (CONTEXT_DUTY_CYCLE + 1)
+
+static uint64_t prv_now_100us;
+static uint32_t prv_random_state;
+static bool prv_modem_irq_enabled;
+
+static bool prv_timer_armed;
+static uint64_t prv_timer_expiry_100us;
+static void (*prv_timer_callback)(void *context);
+static void *prv_timer_context;
+
+static bool prv_radio_irq_armed;
+static uint64_t prv_radio_irq_time_100us;
+static void (*prv_radio_irq_latch)(void);
+static void (*prv_radio_irq_callback)(void *context);
+static void *prv_radio_irq_context;
+static uint32_t prv_radio_irq_timestamp_100us;
+
+static uint8_t prv_contexts[PRV_CONTEXT_NB][PRV_CONTEXT_SIZE];
+static uint32_t prv_context_store_count[PRV_CONTEXT_NB];
+
+static uint8_t prv_crashlog[CRASH_LOG_SIZE];
+static bool prv_crashlog_available;
+
+void test_hal_reset(uint64_t start_100us, uint32_t seed)
+{
+	prv_now_100us = start_100us;
+	prv_random_state = (seed != 0) ? seed : 1;
+	prv_modem_irq_enabled = true;
+
+	prv_timer_armed = false;
+	prv_radio_irq_armed = false;
+	prv_radio_irq_callback = NULL;
+	prv_radio_irq_timestamp_100us = (uint32_t)start_100us;
+
+	/* Erased flash */
+	memset(prv_contexts, 0xFF, sizeof(prv_contexts));
+	memset(prv_context_store_count, 0, sizeof(prv_context_store_count));
+	memset(prv_crashlog, 0, sizeof(prv_crashlog));
+	prv_crashlog_available = false;
+}
+
+uint64_t test_hal_now_100us(void)
+{
+	return prv_now_100us;
+}
+
+bool test_hal_run_next(uint64_t limit_100us)
+{
+	bool radio = prv_radio_irq_armed && prv_radio_irq_time_100us <= limit_100us;
+	bool timer = prv_timer_armed && prv_timer_expiry_100us <= limit_100us;
+
+	zassert_true(prv_modem_irq_enabled, "Modem irq left disabled");
+
+	if (radio && timer && prv_timer_expiry_100us < prv_radio_irq_time_100us) {
+		radio = false;
+	}
+
+	if (radio) {
+		prv_radio_irq_armed = false;
+		if (prv_radio_irq_time_100us > prv_now_100us) {
+			prv_now_100us = prv_radio_irq_time_100us;
+		}
+		prv_radio_irq_timestamp_100us = (uint32_t)prv_now_100us;
+		if (prv_radio_irq_latch) {
+			prv_radio_irq_latch();
+		}
+		zassert_not_null(prv_radio_irq_callback, "Radio irq not configured");
+		prv_radio_irq_callback(prv_radio_irq_context);
+		return true;
+	}
+
+	if (timer) {
+		prv_timer_armed = false;
+		if (prv_timer_expiry_100us > prv_now_100us) {
+			prv_now_100us = prv_timer_expiry_100us;
+		}
+		prv_timer_callback(prv_timer_context);
+		return true;
+	}
+
+	return false;
+}
+
+void test_hal_run_until(uint64_t time_100us)
+{
+	while (test_hal_run_next(time_100us)) {
+	}
+
+	if (time_100us > prv_now_100us) {
+		prv_now_100us = time_100us;
+	}
+}
+
+void test_hal_advance_ms(uint32_t ms)
+{
+	test_hal_run_until(prv_now_100us + (uint64_t)ms * 10);
+}
+
+void test_hal_radio_irq_set(uint64_t time_100us, void (*latch)(void))
+{
+	prv_radio_irq_armed = true;
+	prv_radio_irq_time_100us = time_100us;
+	prv_radio_irq_latch = latch;
+}
+
+void test_hal_radio_irq_clear(void)
+{
+	prv_radio_irq_armed = false;
+}
+
+bool test_hal_timer_is_armed(uint64_t *expiry_100us)
+{
+	if (expiry_100us) {
+		*expiry_100us = prv_timer_expiry_100us;
+	}
+
+	return prv_timer_armed;
+}
+
+uint32_t test_hal_context_store_count(modem_context_type_t ctx_type)
+{
+	zassert_true(ctx_type < PRV_CONTEXT_NB, "Unknown context %d", ctx_type);
+
+	return prv_context_store_count[ctx_type];
+}
+
+/* ------------ Reset management ------------*/
+
+void smtc_modem_hal_reset_mcu(void)
+{
+	zassert_unreachable("MCU reset requested, crashlog: %s", prv_crashlog);
+}
+
+/* ------------ Watchdog management ------------*/
+
+void smtc_modem_hal_reload_wdog(void)
+{
+}
+
+/* ------------ Time management ------------*/
+
+uint32_t smtc_modem_hal_get_time_in_s(void)
+{
+	return (uint32_t)(prv_now_100us / 10000);
+}
+
+uint32_t smtc_modem_hal_get_compensated_time_in_s(void)
+{
+	return smtc_modem_hal_get_time_in_s();
+}
+
+int32_t smtc_modem_hal_get_time_compensation_in_s(void)
+{
+	return 0;
+}
+
+uint32_t smtc_modem_hal_get_persistent_time_in_s(void)
+{
+	return smtc_modem_hal_get_time_in_s();
+}
+
+uint32_t smtc_modem_hal_get_time_in_ms(void)
+{
+	return (uint32_t)(prv_now_100us / 10);
+}
+
+uint32_t smtc_modem_hal_get_time_in_100us(void)
+{
+	return (uint32_t)prv_now_100us;
+}
+
+uint32_t smtc_modem_hal_get_radio_irq_timestamp_in_100us(void)
+{
+	return prv_radio_irq_timestamp_100us;
+}
+
+/* ------------ Timer management ------------*/
+
+void smtc_modem_hal_start_timer(const uint32_t milliseconds, void (*callback)(void *context),
+				void *context)
+{
+	smtc_modem_hal_start_timer_in_100us(milliseconds * 10, callback, context);
+}
+
+void smtc_modem_hal_start_timer_in_100us(const uint32_t time_in_100us,
+					 void (*callback)(void *context), void *context)
+{
+	prv_timer_armed = true;
+	prv_timer_expiry_100us = prv_now_100us + time_in_100us;
+	prv_timer_callback = callback;
+	prv_timer_context = context;
+}
+
+void smtc_modem_hal_stop_timer(void)
+{
+	prv_timer_armed = false;
+}
+
+/* ------------ IRQ management ------------*/
+
+void smtc_modem_hal_disable_modem_irq(void)
+{
+	prv_modem_irq_enabled = false;
+}
+
+void smtc_modem_hal_enable_modem_irq(void)
+{
+	prv_modem_irq_enabled = true;
+}
+
+/* ------------ Context saving management ------------*/
+
+void smtc_modem_hal_context_restore(const modem_context_type_t ctx_type, uint8_t *buffer,
+				    const uint32_t size)
+{
+	zassert_true(ctx_type < PRV_CONTEXT_NB, "Unknown context %d", ctx_type);
+	zassert_true(size <= PRV_CONTEXT_SIZE, "Context %d too large: %u", ctx_type, size);
+
+	memcpy(buffer, prv_contexts[ctx_type], size);
+}
+
+void smtc_modem_hal_context_store(const modem_context_type_t ctx_type, const uint8_t *buffer,
+				  const uint32_t size)
+{
+	zassert_true(ctx_type < PRV_CONTEXT_NB, "Unknown context %d", ctx_type);
+	zassert_true(size <= PRV_CONTEXT_SIZE, "Context %d too large: %u", ctx_type, size);
+
+	memcpy(prv_contexts[ctx_type], buffer, size);
+	prv_context_store_count[ctx_type]++;
+}
+
+/* ------------ Crashlog management ------------*/
+
+void smtc_modem_hal_store_crashlog(uint8_t crashlog[CRASH_LOG_SIZE])
+{
+	strncpy((char *)prv_crashlog, (const char *)crashlog, CRASH_LOG_SIZE - 1);
+}
+
+void smtc_modem_hal_restore_crashlog(uint8_t crashlog[CRASH_LOG_SIZE])
+{
+	memcpy(crashlog, prv_crashlog, CRASH_LOG_SIZE);
+}
+
+void smtc_modem_hal_set_crashlog_status(bool available)
+{
+	prv_crashlog_available = available;
+}
+
+bool smtc_modem_hal_get_crashlog_status(void)
+{
+	return prv_crashlog_available;
+}
+
+/* ------------ assert management ------------*/
+
+void smtc_modem_hal_assert_fail(uint8_t *func, uint32_t line)
+{
+	zassert_unreachable("Assert failed in %s line %u", func, line);
+}
+
+/* ------------ Random management ------------*/
+
+/* xorshift32, the same seed gives the same sequence on every host */
+uint32_t smtc_modem_hal_get_random_nb(void)
+{
+	prv_random_state ^= prv_random_state << 13;
+	prv_random_state ^= prv_random_state >> 17;
+	prv_random_state ^= prv_random_state << 5;
+
+	return prv_random_state;
+}
+
+uint32_t smtc_modem_hal_get_random_nb_in_range(const uint32_t val_1, const uint32_t val_2)
+{
+	uint32_t low = (val_1 <= val_2) ? val_1 : val_2;
+	uint32_t range = ((val_1 <= val_2) ? (val_2 - val_1) : (val_1 - val_2)) + 1;
+
+	/* The full 32 bits range wraps to 0 */
+	return (range == 0) ? smtc_modem_hal_get_random_nb()
+			    : low + smtc_modem_hal_get_random_nb() % range;
+}
+
+int32_t smtc_modem_hal_get_signed_random_nb_in_range(const int32_t val_1, const int32_t val_2)
+{
+	int32_t low = (val_1 <= val_2) ? val_1 : val_2;
+	uint32_t range = (val_1 <= val_2) ? (uint32_t)(val_2 - val_1) : (uint32_t)(val_1 - val_2);
+
+	return (int32_t)(low + smtc_modem_hal_get_random_nb_in_range(0, range));
+}
+
+/* ------------ Radio env management ------------*/
+
+void smtc_modem_hal_irq_config_radio_irq(void (*callback)(void *context), void *context)
+{
+	prv_radio_irq_callback = callback;
+	prv_radio_irq_context = context;
+}
+
+/* The radio irq is dispatched as soon as it is latched, a pending irq is a scheduled one */
+void smtc_modem_hal_radio_irq_clear_pending(void)
+{
+	test_hal_radio_irq_clear();
+}
+
+void smtc_modem_hal_start_radio_tcxo(void)
+{
+}
+
+void smtc_modem_hal_stop_radio_tcxo(void)
+{
+}
+
+uint32_t smtc_modem_hal_get_radio_tcxo_startup_delay_ms(void)
+{
+	return 0;
+}
+
+/* ------------ Environment management ------------*/
+
+uint8_t smtc_modem_hal_get_battery_level(void)
+{
+	return 254;
+}
+
+int8_t smtc_modem_hal_get_temperature(void)
+{
+	return 25;
+}
+
+uint8_t smtc_modem_hal_get_voltage(void)
+{
+	/* 3.3 V in 1/50 V */
+	return 165;
+}
+
+int8_t smtc_modem_hal_get_board_delay_ms(void)
+{
+	return 1;
+}
+
+/* ------------ Trace management ------------*/
+
+void smtc_modem_hal_print_trace(const char *fmt, ...)
+{
+	ARG_UNUSED(fmt);
+}
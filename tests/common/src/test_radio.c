@@ -0,0 +1,659 @@
+/** @file test_radio.c
+ *
+ * @brief Mock radio for the host tests
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2022 Irnas. All rights reserved.
+ */
+
+#include <test_radio.h>
+#include <test_hal.h>
+
+#include <string.h>
+
+#include <zephyr/ztest.h>
+
+#define PRV_PAYLOAD_SIZE 255
+
+static enum test_radio_mode prv_mode;
+static uint64_t prv_mode_start_100us;
+static struct test_radio_stats prv_stats;
+
+static ral_irq_t prv_irq_pending;
+static ral_irq_t prv_irq_status;
+
+static uint32_t prv_rf_freq_in_hz;
+static ral_lora_mod_params_t prv_lora_mod_params;
+
+static uint8_t prv_rx_payload[PRV_PAYLOAD_SIZE];
+static uint16_t prv_rx_payload_size;
+static int16_t prv_rx_rssi_in_dbm;
+static int16_t prv_rx_snr_in_db;
+
+/**
+ * @brief Account the time spent in the current mode, then switch to @p mode.
+ */
+static void prv_mode_set(enum test_radio_mode mode)
+{
+	uint64_t now = test_hal_now_100us();
+	uint64_t elapsed = now - prv_mode_start_100us;
+
+	switch (prv_mode) {
+	case TEST_RADIO_MODE_SLEEP:
+		break;
+	case TEST_RADIO_MODE_STANDBY:
+		prv_stats.standby_100us += elapsed;
+		if (elapsed > prv_stats.standby_max_100us) {
+			prv_stats.standby_max_100us = elapsed;
+		}
+		break;
+	case TEST_RADIO_MODE_TX:
+		prv_stats.tx_100us += elapsed;
+		break;
+	case TEST_RADIO_MODE_RX:
+	case TEST_RADIO_MODE_CAD:
+		prv_stats.rx_100us += elapsed;
+		break;
+	}
+
+	if (prv_mode != TEST_RADIO_MODE_SLEEP) {
+		prv_stats.on_100us += elapsed;
+	} else if (mode != TEST_RADIO_MODE_SLEEP) {
+		prv_stats.wake_up_nb++;
+	}
+
+	prv_mode = mode;
+	prv_mode_start_100us = now;
+}
+
+/**
+ * @brief Stop the running operation, its irq is not raised anymore.
+ */
+static void prv_operation_stop(enum test_radio_mode mode)
+{
+	test_hal_radio_irq_clear();
+	prv_irq_pending = RAL_IRQ_NONE;
+	prv_mode_set(mode);
+}
+
+/**
+ * @brief Latch the scheduled irq, called by the HAL right before the radio irq callback.
+ */
+static void prv_irq_latch(void)
+{
+	prv_irq_status |= prv_irq_pending;
+	prv_irq_pending = RAL_IRQ_NONE;
+	prv_mode_set(TEST_RADIO_MODE_STANDBY);
+}
+
+void test_radio_reset(void)
+{
+	prv_mode = TEST_RADIO_MODE_SLEEP;
+	prv_mode_start_100us = test_hal_now_100us();
+	memset(&prv_stats, 0, sizeof(prv_stats));
+	prv_irq_pending = RAL_IRQ_NONE;
+	prv_irq_status = RAL_IRQ_NONE;
+	prv_rf_freq_in_hz = 0;
+	memset(&prv_lora_mod_params, 0, sizeof(prv_lora_mod_params));
+	prv_rx_payload_size = 0;
+	test_hal_radio_irq_clear();
+}
+
+enum test_radio_mode test_radio_get_mode(void)
+{
+	return prv_mode;
+}
+
+void test_radio_get_stats(struct test_radio_stats *stats)
+{
+	prv_mode_set(prv_mode);
+	*stats = prv_stats;
+}
+
+void test_radio_irq_at(ral_irq_t irq, uint64_t time_100us)
+{
+	zassert_not_equal(prv_mode, TEST_RADIO_MODE_SLEEP, "Irq scheduled on a sleeping radio");
+
+	prv_irq_pending = irq;
+	test_hal_radio_irq_set(time_100us, prv_irq_latch);
+}
+
+void test_radio_set_rx_packet(const uint8_t *payload, uint16_t size, int16_t rssi_in_dbm,
+			      int16_t snr_in_db)
+{
+	zassert_true(size <= PRV_PAYLOAD_SIZE, "Payload too large: %u", size);
+
+	memcpy(prv_rx_payload, payload, size);
+	prv_rx_payload_size = size;
+	prv_rx_rssi_in_dbm = rssi_in_dbm;
+	prv_rx_snr_in_db = snr_in_db;
+}
+
+uint32_t test_radio_get_rf_freq(void)
+{
+	return prv_rf_freq_in_hz;
+}
+
+const ral_lora_mod_params_t *test_radio_get_lora_mod_params(void)
+{
+	return &prv_lora_mod_params;
+}
+
+/* ------------ Radio abstraction layer ------------*/
+
+/**
+ * @brief A command wakes the radio up.
+ */
+static ral_status_t prv_wake_up(void)
+{
+	if (prv_mode == TEST_RADIO_MODE_SLEEP) {
+		prv_mode_set(TEST_RADIO_MODE_STANDBY);
+	}
+
+	return RAL_STATUS_OK;
+}
+
+static bool prv_handles_part(const char *part_number)
+{
+	return true;
+}
+
+static ral_status_t prv_reset(const void *context)
+{
+	prv_operation_stop(TEST_RADIO_MODE_STANDBY);
+	return RAL_STATUS_OK;
+}
+
+static ral_status_t prv_init(const void *context)
+{
+	return prv_wake_up();
+}
+
+static ral_status_t prv_wakeup(const void *context)
+{
+	return prv_wake_up();
+}
+
+static ral_status_t prv_set_sleep(const void *context, const bool retain_config)
+{
+	prv_operation_stop(TEST_RADIO_MODE_SLEEP);
+	return RAL_STATUS_OK;
+}
+
+static ral_status_t prv_set_standby(const void *context, ral_standby_cfg_t standby_cfg)
+{
+	prv_operation_stop(TEST_RADIO_MODE_STANDBY);
+	return RAL_STATUS_OK;
+}
+
+static ral_status_t prv_set_fs(const void *context)
+{
+	return prv_wake_up();
+}
+
+static ral_status_t prv_set_tx(const void *context)
+{
+	prv_mode_set(TEST_RADIO_MODE_TX);
+	return RAL_STATUS_OK;
+}
+
+static ral_status_t prv_set_rx(const void *context, const uint32_t timeout_in_ms)
+{
+	prv_mode_set(TEST_RADIO_MODE_RX);
+	return RAL_STATUS_OK;
+}
+
+static ral_status_t prv_cfg_rx_boosted(const void *context, const bool enable_boost_mode)
+{
+	return prv_wake_up();
+}
+
+static ral_status_t prv_set_rx_tx_fallback_mode(const void *context,
+						const ral_fallback_modes_t ral_fallback_mode)
+{
+	return prv_wake_up();
+}
+
+static ral_status_t prv_stop_timer_on_preamble(const void *context, const bool enable)
+{
+	return prv_wake_up();
+}
+
+static ral_status_t prv_set_rx_duty_cycle(const void *context, const uint32_t rx_time_in_ms,
+					  const uint32_t sleep_time_in_ms)
+{
+	prv_mode_set(TEST_RADIO_MODE_RX);
+	return RAL_STATUS_OK;
+}
+
+static ral_status_t prv_set_lora_cad(const void *context)
+{
+	prv_mode_set(TEST_RADIO_MODE_CAD);
+	return RAL_STATUS_OK;
+}
+
+static ral_status_t prv_set_tx_cw(const void *context)
+{
+	prv_mode_set(TEST_RADIO_MODE_TX);
+	return RAL_STATUS_OK;
+}
+
+static ral_status_t prv_set_tx_infinite_preamble(const void *context)
+{
+	prv_mode_set(TEST_RADIO_MODE_TX);
+	return RAL_STATUS_OK;
+}
+
+static ral_status_t prv_cal_img(const void *context, const uint16_t freq1_in_mhz,
+				const uint16_t freq2_in_mhz)
+{
+	return prv_wake_up();
+}
+
+static ral_status_t prv_set_tx_cfg(const void *context, const int8_t output_pwr_in_dbm,
+				   const uint32_t rf_freq_in_hz)
+{
+	return prv_wake_up();
+}
+
+static ral_status_t prv_set_pkt_payload(const void *context, const uint8_t *buffer,
+					const uint16_t size)
+{
+	return prv_wake_up();
+}
+
+static ral_status_t prv_get_pkt_payload(const void *context, uint16_t max_size_in_bytes,
+					uint8_t *buffer, uint16_t *size_in_bytes)
+{
+	uint16_t size = (prv_rx_payload_size < max_size_in_bytes) ? prv_rx_payload_size
+								  : max_size_in_bytes;
+
+	memcpy(buffer, prv_rx_payload, size);
+	if (size_in_bytes) {
+		*size_in_bytes = size;
+	}
+
+	return RAL_STATUS_OK;
+}
+
+static ral_status_t prv_get_irq_status(const void *context, ral_irq_t *irq)
+{
+	*irq = prv_irq_status;
+	return RAL_STATUS_OK;
+}
+
+static ral_status_t prv_clear_irq_status(const void *context, const ral_irq_t irq)
+{
+	prv_irq_status &= ~irq;
+	return RAL_STATUS_OK;
+}
+
+static ral_status_t prv_get_and_clear_irq_status(const void *context, ral_irq_t *irq)
+{
+	*irq = prv_irq_status;
+	prv_irq_status = RAL_IRQ_NONE;
+	return RAL_STATUS_OK;
+}
+
+static ral_status_t prv_set_dio_irq_params(const void *context, const ral_irq_t irq)
+{
+	return prv_wake_up();
+}
+
+static ral_status_t prv_set_rf_freq(const void *context, const uint32_t freq_in_hz)
+{
+	prv_rf_freq_in_hz = freq_in_hz;
+	return prv_wake_up();
+}
+
+static ral_status_t prv_set_pkt_type(const void *context, const ral_pkt_type_t pkt_type)
+{
+	return prv_wake_up();
+}
+
+static ral_status_t prv_get_pkt_type(const void *context, ral_pkt_type_t *pkt_type)
+{
+	*pkt_type = RAL_PKT_TYPE_LORA;
+	return RAL_STATUS_OK;
+}
+
+static ral_status_t prv_set_gfsk_mod_params(const void *context,
+					    const ral_gfsk_mod_params_t *params)
+{
+	return prv_wake_up();
+}
+
+static ral_status_t prv_set_gfsk_pkt_params(const void *context,
+					    const ral_gfsk_pkt_params_t *params)
+{
+	return prv_wake_up();
+}
+
+static ral_status_t prv_set_lora_mod_params(const void *context,
+					    const ral_lora_mod_params_t *params)
+{
+	prv_lora_mod_params = *params;
+	return prv_wake_up();
+}
+
+static ral_status_t prv_set_lora_pkt_params(const void *context,
+					    const ral_lora_pkt_params_t *params)
+{
+	return prv_wake_up();
+}
+
+static ral_status_t prv_set_lora_cad_params(const void *context,
+					    const ral_lora_cad_params_t *params)
+{
+	return prv_wake_up();
+}
+
+static ral_status_t prv_set_lora_symb_nb_timeout(const void *context, const uint8_t nb_of_symbs)
+{
+	return prv_wake_up();
+}
+
+static ral_status_t prv_set_flrc_mod_params(const void *context,
+					    const ral_flrc_mod_params_t *params)
+{
+	return prv_wake_up();
+}
+
+static ral_status_t prv_set_flrc_pkt_params(const void *context,
+					    const ral_flrc_pkt_params_t *params)
+{
+	return prv_wake_up();
+}
+
+static ral_status_t prv_get_gfsk_rx_pkt_status(const void *context,
+					       ral_gfsk_rx_pkt_status_t *rx_pkt_status)
+{
+	rx_pkt_status->rx_status = 0;
+	rx_pkt_status->rssi_sync_in_dbm = prv_rx_rssi_in_dbm;
+	rx_pkt_status->rssi_avg_in_dbm = prv_rx_rssi_in_dbm;
+	return RAL_STATUS_OK;
+}
+
+static ral_status_t prv_get_lora_rx_pkt_status(const void *context,
+					       ral_lora_rx_pkt_status_t *rx_pkt_status)
+{
+	rx_pkt_status->rssi_pkt_in_dbm = prv_rx_rssi_in_dbm;
+	rx_pkt_status->snr_pkt_in_db = prv_rx_snr_in_db;
+	rx_pkt_status->signal_rssi_pkt_in_dbm = prv_rx_rssi_in_dbm;
+	return RAL_STATUS_OK;
+}
+
+static ral_status_t prv_get_flrc_rx_pkt_status(const void *context,
+					       ral_flrc_rx_pkt_status_t *rx_pkt_status)
+{
+	rx_pkt_status->rssi_sync_in_dbm = prv_rx_rssi_in_dbm;
+	return RAL_STATUS_OK;
+}
+
+static ral_status_t prv_get_rssi_inst(const void *context, int16_t *rssi_in_dbm)
+{
+	/* Free channel */
+	*rssi_in_dbm = -127;
+	return RAL_STATUS_OK;
+}
+
+/**
+ * @brief LoRa time on air from the formula of the SX126x datasheet.
+ */
+static uint32_t prv_get_lora_time_on_air_in_ms(const ral_lora_pkt_params_t *pkt_p,
+					       const ral_lora_mod_params_t *mod_p)
+{
+	static const uint32_t bw_in_hz[] = {
+		[RAL_LORA_BW_007_KHZ] = 7810,	 [RAL_LORA_BW_010_KHZ] = 10420,
+		[RAL_LORA_BW_015_KHZ] = 15630,	 [RAL_LORA_BW_020_KHZ] = 20830,
+		[RAL_LORA_BW_031_KHZ] = 31250,	 [RAL_LORA_BW_041_KHZ] = 41670,
+		[RAL_LORA_BW_062_KHZ] = 62500,	 [RAL_LORA_BW_125_KHZ] = 125000,
+		[RAL_LORA_BW_200_KHZ] = 203125,	 [RAL_LORA_BW_250_KHZ] = 250000,
+		[RAL_LORA_BW_400_KHZ] = 406250,	 [RAL_LORA_BW_500_KHZ] = 500000,
+		[RAL_LORA_BW_800_KHZ] = 812500,	 [RAL_LORA_BW_1600_KHZ] = 1625000,
+	};
+	int32_t sf = mod_p->sf;
+	int32_t de = (mod_p->ldro != 0) ? 1 : 0;
+	int32_t ih = (pkt_p->header_type == RAL_LORA_PKT_IMPLICIT) ? 1 : 0;
+	int32_t cr = (mod_p->cr <= RAL_LORA_CR_4_8) ? mod_p->cr : mod_p->cr - RAL_LORA_CR_4_8;
+	int32_t num = 8 * pkt_p->pld_len_in_bytes - 4 * sf + 28 + (pkt_p->crc_is_on ? 16 : 0) -
+		      20 * ih;
+	int32_t den = 4 * (sf - 2 * de);
+	int32_t payload_symb = 8 + ((num > 0) ? ((num + den - 1) / den) * (cr + 4) : 0);
+	/* Symbols in quarters, for the 4.25 symbols of the sync word */
+	uint64_t quarter_symb = 4 * ((uint64_t)pkt_p->preamble_len_in_symb + payload_symb) + 17;
+
+	return (uint32_t)((quarter_symb * ((uint64_t)1000 << sf) + 4 * bw_in_hz[mod_p->bw] - 1) /
+			  (4 * bw_in_hz[mod_p->bw]));
+}
+
+static uint32_t prv_get_gfsk_time_on_air_in_ms(const ral_gfsk_pkt_params_t *pkt_p,
+					       const ral_gfsk_mod_params_t *mod_p)
+{
+	uint32_t bits = pkt_p->preamble_len_in_bits + pkt_p->sync_word_len_in_bits +
+			8 * (pkt_p->pld_len_in_bytes + 3);
+
+	return (uint32_t)(((uint64_t)bits * 1000 + mod_p->br_in_bps - 1) / mod_p->br_in_bps);
+}
+
+static uint32_t prv_get_flrc_time_on_air_in_ms(const ral_flrc_pkt_params_t *pkt_p,
+					       const ral_flrc_mod_params_t *mod_p)
+{
+	return 1;
+}
+
+static ral_status_t prv_set_gfsk_sync_word(const void *context, const uint8_t *sync_word,
+					   const uint8_t sync_word_len)
+{
+	return prv_wake_up();
+}
+
+static ral_status_t prv_set_lora_sync_word(const void *context, const uint8_t sync_word)
+{
+	return prv_wake_up();
+}
+
+static ral_status_t prv_set_flrc_sync_word(const void *context, const uint8_t *sync_word,
+					   const uint8_t sync_word_len)
+{
+	return prv_wake_up();
+}
+
+static ral_status_t prv_set_gfsk_crc_params(const void *context, const uint16_t seed,
+					    const uint16_t polynomial)
+{
+	return prv_wake_up();
+}
+
+static ral_status_t prv_set_flrc_crc_params(const void *context, const uint32_t seed)
+{
+	return prv_wake_up();
+}
+
+static ral_status_t prv_set_gfsk_whitening_seed(const void *context, const uint16_t seed)
+{
+	return prv_wake_up();
+}
+
+static ral_status_t prv_lr_fhss_init(const void *context,
+				     const ral_lr_fhss_params_t *lr_fhss_params)
+{
+	return prv_wake_up();
+}
+
+static ral_status_t prv_lr_fhss_build_frame(const void *context,
+					    const ral_lr_fhss_params_t *lr_fhss_params,
+					    ral_lr_fhss_memory_state_t memory_state_holder,
+					    uint16_t hop_sequence_id, const uint8_t *payload,
+					    uint16_t payload_length)
+{
+	return prv_wake_up();
+}
+
+static ral_status_t prv_lr_fhss_handle_hop(const void *context,
+					   const ral_lr_fhss_params_t *lr_fhss_params,
+					   ral_lr_fhss_memory_state_t state)
+{
+	return RAL_STATUS_OK;
+}
+
+static ral_status_t prv_lr_fhss_handle_tx_done(const void *context,
+					       const ral_lr_fhss_params_t *lr_fhss_params,
+					       ral_lr_fhss_memory_state_t state)
+{
+	return RAL_STATUS_OK;
+}
+
+static ral_status_t prv_lr_fhss_get_time_on_air_in_ms(const void *context,
+						      const ral_lr_fhss_params_t *lr_fhss_params,
+						      uint16_t payload_length,
+						      uint32_t *time_on_air)
+{
+	*time_on_air = 1000;
+	return RAL_STATUS_OK;
+}
+
+static ral_status_t prv_lr_fhss_get_hop_sequence_count(const void *context,
+						       const ral_lr_fhss_params_t *lr_fhss_params)
+{
+	return RAL_STATUS_OK;
+}
+
+static ral_status_t prv_get_lora_rx_pkt_cr_crc(const void *context, ral_lora_cr_t *cr,
+					       bool *is_crc_present)
+{
+	*cr = RAL_LORA_CR_4_5;
+	*is_crc_present = true;
+	return RAL_STATUS_OK;
+}
+
+/* Consumptions of an LR1110 in DC-DC mode */
+static ral_status_t prv_get_tx_consumption_in_ua(const void *context,
+						 const int8_t output_pwr_in_dbm,
+						 const uint32_t rf_freq_in_hz,
+						 uint32_t *pwr_consumption_in_ua)
+{
+	*pwr_consumption_in_ua = (output_pwr_in_dbm > 14) ? 90000 : 25000;
+	return RAL_STATUS_OK;
+}
+
+static ral_status_t prv_get_gfsk_rx_consumption_in_ua(const void *context,
+						      const uint32_t br_in_bps,
+						      const uint32_t bw_dsb_in_hz,
+						      const bool rx_boosted,
+						      uint32_t *pwr_consumption_in_ua)
+{
+	*pwr_consumption_in_ua = 5300;
+	return RAL_STATUS_OK;
+}
+
+static ral_status_t prv_get_lora_rx_consumption_in_ua(const void *context,
+						      const ral_lora_bw_t bw,
+						      const bool rx_boosted,
+						      uint32_t *pwr_consumption_in_ua)
+{
+	*pwr_consumption_in_ua = 5700;
+	return RAL_STATUS_OK;
+}
+
+static ral_status_t prv_get_random_numbers(const void *radio, uint32_t *numbers, unsigned int n)
+{
+	for (unsigned int i = 0; i < n; i++) {
+		numbers[i] = smtc_modem_hal_get_random_nb();
+	}
+
+	return RAL_STATUS_OK;
+}
+
+/* ------------ Radio abstraction layer front end ------------*/
+
+static ral_status_t prv_setup_gfsk(const ralf_t *radio, const ralf_params_gfsk_t *params)
+{
+	prv_rf_freq_in_hz = params->rf_freq_in_hz;
+	return prv_wake_up();
+}
+
+static ral_status_t prv_setup_lora(const ralf_t *radio, const ralf_params_lora_t *params)
+{
+	prv_rf_freq_in_hz = params->rf_freq_in_hz;
+	prv_lora_mod_params = params->mod_params;
+	return prv_wake_up();
+}
+
+static ral_status_t prv_setup_flrc(const ralf_t *radio, const ralf_params_flrc_t *params)
+{
+	prv_rf_freq_in_hz = params->rf_freq_in_hz;
+	return prv_wake_up();
+}
+
+const ralf_t test_radio = {
+	.ral = {
+		.context = NULL,
+		.driver = {
+			.handles_part = prv_handles_part,
+			.reset = prv_reset,
+			.init = prv_init,
+			.wakeup = prv_wakeup,
+			.set_sleep = prv_set_sleep,
+			.set_standby = prv_set_standby,
+			.set_fs = prv_set_fs,
+			.set_tx = prv_set_tx,
+			.set_rx = prv_set_rx,
+			.cfg_rx_boosted = prv_cfg_rx_boosted,
+			.set_rx_tx_fallback_mode = prv_set_rx_tx_fallback_mode,
+			.stop_timer_on_preamble = prv_stop_timer_on_preamble,
+			.set_rx_duty_cycle = prv_set_rx_duty_cycle,
+			.set_lora_cad = prv_set_lora_cad,
+			.set_tx_cw = prv_set_tx_cw,
+			.set_tx_infinite_preamble = prv_set_tx_infinite_preamble,
+			.cal_img = prv_cal_img,
+			.set_tx_cfg = prv_set_tx_cfg,
+			.set_pkt_payload = prv_set_pkt_payload,
+			.get_pkt_payload = prv_get_pkt_payload,
+			.get_irq_status = prv_get_irq_status,
+			.clear_irq_status = prv_clear_irq_status,
+			.get_and_clear_irq_status = prv_get_and_clear_irq_status,
+			.set_dio_irq_params = prv_set_dio_irq_params,
+			.set_rf_freq = prv_set_rf_freq,
+			.set_pkt_type = prv_set_pkt_type,
+			.get_pkt_type = prv_get_pkt_type,
+			.set_gfsk_mod_params = prv_set_gfsk_mod_params,
+			.set_gfsk_pkt_params = prv_set_gfsk_pkt_params,
+			.set_lora_mod_params = prv_set_lora_mod_params,
+			.set_lora_pkt_params = prv_set_lora_pkt_params,
+			.set_lora_cad_params = prv_set_lora_cad_params,
+			.set_lora_symb_nb_timeout = prv_set_lora_symb_nb_timeout,
+			.set_flrc_mod_params = prv_set_flrc_mod_params,
+			.set_flrc_pkt_params = prv_set_flrc_pkt_params,
+			.get_gfsk_rx_pkt_status = prv_get_gfsk_rx_pkt_status,
+			.get_lora_rx_pkt_status = prv_get_lora_rx_pkt_status,
+			.get_flrc_rx_pkt_status = prv_get_flrc_rx_pkt_status,
+			.get_rssi_inst = prv_get_rssi_inst,
+			.get_lora_time_on_air_in_ms = prv_get_lora_time_on_air_in_ms,
+			.get_gfsk_time_on_air_in_ms = prv_get_gfsk_time_on_air_in_ms,
+			.get_flrc_time_on_air_in_ms = prv_get_flrc_time_on_air_in_ms,
+			.set_gfsk_sync_word = prv_set_gfsk_sync_word,
+			.set_lora_sync_word = prv_set_lora_sync_word,
+			.set_flrc_sync_word = prv_set_flrc_sync_word,
+			.set_gfsk_crc_params = prv_set_gfsk_crc_params,
+			.set_flrc_crc_params = prv_set_flrc_crc_params,
+			.set_gfsk_whitening_seed = prv_set_gfsk_whitening_seed,
+			.lr_fhss_init = prv_lr_fhss_init,
+			.lr_fhss_build_frame = prv_lr_fhss_build_frame,
+			.lr_fhss_handle_hop = prv_lr_fhss_handle_hop,
+			.lr_fhss_handle_tx_done = prv_lr_fhss_handle_tx_done,
+			.lr_fhss_get_time_on_air_in_ms = prv_lr_fhss_get_time_on_air_in_ms,
+			.lr_fhss_get_hop_sequence_count = prv_lr_fhss_get_hop_sequence_count,
+			.get_lora_rx_pkt_cr_crc = prv_get_lora_rx_pkt_cr_crc,
+			.get_tx_consumption_in_ua = prv_get_tx_consumption_in_ua,
+			.get_gfsk_rx_consumption_in_ua = prv_get_gfsk_rx_consumption_in_ua,
+			.get_lora_rx_consumption_in_ua = prv_get_lora_rx_consumption_in_ua,
+			.get_random_numbers = prv_get_random_numbers,
+		},
+	},
+	.ralf_drv = {
+		.setup_gfsk = prv_setup_gfsk,
+		.setup_lora = prv_setup_lora,
+		.setup_flrc = prv_setup_flrc,
+	},
+};
@@ -0,0 +1,203 @@
+/** @file test_file_upload.c
+ *
+ * @brief File upload fragments against the encoder used before the checkword walk
+ *
+ * The chunks used to be encoded by testing every bit of a checkword drawn for each group of 32
+ * source chunks. The encoder of file_upload.c only visits the bits set, and masks the bits of the
+ * last checkword above the chunk count. The previous encoder is kept here as the reference: every
+ * fragment of whole upload sessions must be the same, for file sizes around the checkword
+ * boundaries and not multiple of 4, and for several frame counters.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2022 Irnas. All rights reserved.
+ */
+
+#include <string.h>
+
+#include <zephyr/ztest.h>
+
+#include <file_upload.h>
+#include <smtc_modem_hal.h>
+#include <smtc_modem_services_hal.h>
+#include <test_hal.h>
+
+/* As FILE_UPLOAD_HEADER_SIZE, FILE_UPLOAD_MAX_SIZE and CHUNK_NW of file_upload.c */
+#define PRV_HEADER_SIZE 12
+#define PRV_FILE_SIZE_MAX ((8 * 1024) - PRV_HEADER_SIZE)
+#define PRV_CHUNK_NW 2
+
+/* Discriminator of a fragment before its chunks */
+#define PRV_FRAGMENT_HEADER_SIZE 3
+
+/* Fragment sizes of the smallest and largest uplinks */
+static const int32_t prv_fragment_sizes[] = {11, 51, 115, 242};
+
+/* 1 to 3 checkwords per chunk, chunk counts on and around the multiples of 32 */
+static const uint32_t prv_file_sizes[] = {1,   3,   4,    5,    13,   239,  243,  244,
+					  245, 247, 500,  501,  755,  1021, 2037, 4093,
+					  6000, PRV_FILE_SIZE_MAX - 1, PRV_FILE_SIZE_MAX};
+
+static const uint32_t prv_fcnts[] = {0, 1, 0x1234, 0xFFFFFFF0};
+
+/* Word aligned, the encoders read the file by words past its last byte */
+static uint32_t prv_file[(PRV_FILE_SIZE_MAX + 3) / 4];
+
+/* Only plain uploads are encoded here */
+void smtc_modem_services_aes_encrypt(const uint8_t *raw_buffer, uint16_t size,
+				     uint8_t aes_ctr_nonce[14], uint8_t *enc_buffer)
+{
+	ARG_UNUSED(raw_buffer);
+	ARG_UNUSED(size);
+	ARG_UNUSED(aes_ctr_nonce);
+	ARG_UNUSED(enc_buffer);
+
+	zassert_unreachable("Upload encrypted");
+}
+
+static uint32_t prv_ref_phash(uint32_t x)
+{
+	x = ((x >> 16) ^ x) * 0x45d9f3b;
+	x = ((x >> 16) ^ x) * 0x45d9f3b;
+	x = ((x >> 16) ^ x);
+	return x;
+}
+
+static void prv_ref_function_xor(uint32_t *dst, const uint32_t *src, int32_t nw)
+{
+	while (nw-- > 0) {
+		*dst++ ^= *src++;
+	}
+}
+
+static uint32_t prv_ref_checkbits(uint32_t cid, uint32_t cct, uint32_t i)
+{
+	uint32_t ncw = (cct + 31) >> 5;
+
+	return prv_ref_phash(cid * ncw + i);
+}
+
+/* Previous gen_chunk, every bit of the checkwords tested in turn */
+static void prv_ref_gen_chunk(const file_upload_t *file_upload, uint32_t *dst, const uint32_t *src,
+			      uint32_t cct, uint32_t cid)
+{
+	uint32_t bits = 0;
+
+	memset(dst, 0, PRV_CHUNK_NW * 4);
+	for (uint32_t i = 0; i < cct; i++) {
+		if ((i & 31) == 0) {
+			bits = prv_ref_checkbits(cid, cct, i >> 5);
+		}
+		if (bits == 0) {
+			continue;
+		}
+		if (bits & 1) {
+			if (i == 0) {
+				uint32_t tmp[PRV_CHUNK_NW] = {file_upload->header[0],
+							      file_upload->header[1]};
+
+				prv_ref_function_xor(dst, tmp, PRV_CHUNK_NW);
+			} else if (i == 1) {
+				uint32_t tmp[PRV_CHUNK_NW] = {file_upload->header[2], *src};
+
+				prv_ref_function_xor(dst, tmp, PRV_CHUNK_NW);
+			} else {
+				prv_ref_function_xor(dst, src + PRV_CHUNK_NW * i - 3, PRV_CHUNK_NW);
+			}
+		}
+		bits >>= 1;
+	}
+}
+
+/* Fragment of file_upload_get_fragment() with the chunks of the reference encoder */
+static int32_t prv_ref_fragment(const file_upload_t *file_upload, uint8_t *buf, int32_t len,
+				uint32_t fcnt)
+{
+	uint32_t d = ((file_upload->sid & 0x03) << 14) |
+		     ((file_upload->session_counter & 0x0F) << 10) |
+		     ((file_upload->cct - 1) & 0x03FF);
+	uint32_t cid = prv_ref_phash(fcnt);
+	int32_t n = 0;
+
+	if ((len - PRV_FRAGMENT_HEADER_SIZE) < (PRV_CHUNK_NW * 4)) {
+		return 0;
+	}
+	len -= PRV_FRAGMENT_HEADER_SIZE;
+	buf[n++] = FILE_UPLOAD_TOKEN;
+	buf[n++] = d;
+	buf[n++] = d >> 8;
+
+	while (len >= (PRV_CHUNK_NW * 4)) {
+		uint32_t tmp[PRV_CHUNK_NW];
+
+		prv_ref_gen_chunk(file_upload, tmp, file_upload->file_buf, file_upload->cct, cid++);
+		memcpy(buf + n, tmp, PRV_CHUNK_NW * 4);
+		n += PRV_CHUNK_NW * 4;
+		len -= PRV_CHUNK_NW * 4;
+	}
+	return n;
+}
+
+static void prv_fill_file(uint32_t seed)
+{
+	test_hal_reset(0, seed);
+	for (size_t i = 0; i < ARRAY_SIZE(prv_file); i++) {
+		prv_file[i] = (smtc_modem_hal_get_random_nb_in_range(0, 0xFFFF) << 16) |
+			      smtc_modem_hal_get_random_nb_in_range(0, 0xFFFF);
+	}
+}
+
+/* Send a whole session, every fragment must match the reference */
+static void prv_check_session(uint32_t file_len, uint32_t fcnt, int32_t len)
+{
+	uint8_t expected[256];
+	uint8_t fragment[256];
+	file_upload_t file_upload;
+	uint32_t frames = 0;
+
+	zassert_equal(file_upload_init(&file_upload, 1, file_len, 0, 199, FILE_UPLOAD_NOT_ENCRYPTED,
+				       5, 1),
+		      FILE_UPLOAD_OK, "Size %u refused", file_len);
+	file_upload_attach_file_buffer(&file_upload, (const uint8_t *)prv_file);
+	zassert_equal(file_upload_prepare_upload(&file_upload), FILE_UPLOAD_OK,
+		      "Size %u not prepared", file_len);
+
+	while (file_upload_is_data_remaining(&file_upload)) {
+		int32_t n = prv_ref_fragment(&file_upload, expected, len, fcnt);
+
+		zassert_equal(file_upload_get_fragment(&file_upload, fragment, len, fcnt), n,
+			      "Size %u, fcnt %u: fragment length", file_len, fcnt);
+		zassert_mem_equal(fragment, expected, n, "Size %u, fcnt %u, %d bytes: differs",
+				  file_len, fcnt, len);
+		fcnt++;
+		frames++;
+		zassert_true(frames <= 2U * file_upload.cct + 3U,
+			     "Size %u: session does not end", file_len);
+	}
+}
+
+ZTEST(file_upload, test_gen_chunk_reference)
+{
+	for (uint32_t seed = 1; seed <= 3; seed++) {
+		prv_fill_file(seed);
+
+		for (size_t i = 0; i < ARRAY_SIZE(prv_file_sizes); i++) {
+			for (size_t j = 0; j < ARRAY_SIZE(prv_fcnts); j++) {
+				for (size_t k = 0; k < ARRAY_SIZE(prv_fragment_sizes); k++) {
+					prv_check_session(prv_file_sizes[i], prv_fcnts[j] + seed,
+							  prv_fragment_sizes[k]);
+				}
+			}
+		}
+	}
+}
+
+ZTEST(file_upload, test_too_large)
+{
+	file_upload_t file_upload;
+
+	zassert_equal(file_upload_init(&file_upload, 0, PRV_FILE_SIZE_MAX + 1, 0, 199,
+				       FILE_UPLOAD_NOT_ENCRYPTED, 0, 1),
+		      FILE_UPLOAD_ERROR, "File too large accepted");
+}
+
+ZTEST_SUITE(file_upload, NULL, NULL, NULL, NULL, NULL);
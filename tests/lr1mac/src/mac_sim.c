@@ -0,0 +1,94 @@
+/** @file mac_sim.c
+ *
+ * @brief LoRaWAN MAC layer on the virtual time HAL and the mock radio
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2022 Irnas. All rights reserved.
+ */
+
+#include "mac_sim.h"
+
+#include <string.h>
+
+#include <zephyr/ztest.h>
+
+#include <lr1mac_core.h>
+#include <smtc_secure_element.h>
+#include <test_hal.h>
+#include <test_radio.h>
+
+/* Draws of the channel selection for each enabled channel */
+#define PRV_DRAWS_PER_CHANNEL 64
+
+void mac_sim_init(struct mac_sim *sim, smtc_real_region_types_t region)
+{
+	memset(sim, 0, sizeof(*sim));
+
+	test_hal_reset(10000, 1);
+	test_radio_reset();
+	rp_init(&sim->rp, &test_radio);
+	zassert_equal(smtc_secure_element_init(), SMTC_SE_RC_SUCCESS, "Secure element init failed");
+
+	lr1mac_core_init(&sim->mac, &sim->real, &sim->lbt, &sim->dtc, &sim->rp,
+			 ACTIVATION_MODE_OTAA, region, NULL, NULL);
+	zassert_equal(lr1mac_core_set_region(&sim->mac, region), OKLORAWAN,
+		      "Region %u not supported", region);
+
+	/* Join request, its channel and data rate select the channels of the first uplinks */
+	zassert_equal(lr1mac_core_join(&sim->mac, 0), OKLORAWAN, "Join request failed");
+	sim->mac.lr1mac_state = LWPSTATE_IDLE;
+
+	/* Join accept without CFList, as done by the stack */
+	smtc_real_init_after_join_snapshot_channel_mask(&sim->mac);
+	sim->mac.join_status = JOINED;
+	lr1_stack_mac_session_init(&sim->mac);
+	smtc_real_init_session(&sim->mac);
+	sim->mac.adr_mode_select = sim->mac.adr_mode_select_tmp;
+	smtc_real_set_dr_distribution(&sim->mac, sim->mac.adr_mode_select);
+}
+
+uint8_t mac_sim_cmd(struct mac_sim *sim, const uint8_t *cmd, uint8_t size)
+{
+	zassert_true(size <= sizeof(sim->mac.nwk_payload), "MAC commands too long");
+
+	memcpy(sim->mac.nwk_payload, cmd, size);
+	sim->mac.nwk_payload_size = size;
+	zassert_equal(lr1_stack_mac_cmd_parse(&sim->mac), OKLORAWAN, "MAC commands rejected");
+
+	return sim->mac.tx_fopts_length;
+}
+
+void mac_sim_freq_encode(struct mac_sim *sim, uint8_t *buf, uint32_t freq_hz)
+{
+	uint32_t freq = freq_hz / smtc_real_get_frequency_factor(&sim->mac);
+
+	buf[0] = freq & 0xFF;
+	buf[1] = (freq >> 8) & 0xFF;
+	buf[2] = (freq >> 16) & 0xFF;
+}
+
+uint8_t mac_sim_uplink_freqs(struct mac_sim *sim, uint8_t dr, uint32_t *freq_hz)
+{
+	uint8_t nb = 0;
+
+	sim->mac.tx_data_rate = dr;
+	for (uint32_t draw = 0; draw < MAC_SIM_CHANNEL_NB_MAX * PRV_DRAWS_PER_CHANNEL; draw++) {
+		uint8_t i;
+
+		zassert_equal(smtc_real_get_next_channel(&sim->mac), OKLORAWAN,
+			      "No channel at DR%u", dr);
+
+		/* Insertion in increasing order */
+		for (i = 0; (i < nb) && (freq_hz[i] < sim->mac.tx_frequency); i++) {
+		}
+		if ((i < nb) && (freq_hz[i] == sim->mac.tx_frequency)) {
+			continue;
+		}
+		zassert_true(nb < MAC_SIM_CHANNEL_NB_MAX, "Too many channels");
+		memmove(&freq_hz[i + 1], &freq_hz[i], (nb - i) * sizeof(freq_hz[0]));
+		freq_hz[i] = sim->mac.tx_frequency;
+		nb++;
+	}
+
+	return nb;
+}
@@ -0,0 +1,68 @@
+/** @file mac_sim.h
+ *
+ * @brief LoRaWAN MAC layer on the virtual time HAL and the mock radio
+ *
+ * The MAC layer is initialized in a region and joined without CFList, as after a join accept.
+ * Downlink MAC commands are then replayed through the command parser of the stack.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2022 Irnas. All rights reserved.
+ */
+
+#ifndef MAC_SIM_H
+#define MAC_SIM_H
+
+#include <stdint.h>
+
+#include <lr1_stack_mac_layer.h>
+#include <radio_planner.h>
+#include <smtc_duty_cycle.h>
+#include <smtc_lbt.h>
+#include <smtc_real.h>
+
+/* Largest number of uplink channels of a region */
+#define MAC_SIM_CHANNEL_NB_MAX 96
+
+struct mac_sim {
+	lr1_stack_mac_t mac;
+	smtc_real_t real;
+	smtc_lbt_t lbt;
+	smtc_dtc_t dtc;
+	radio_planner_t rp;
+};
+
+/**
+ * @brief Reset the HAL and the mock radio, then initialize the MAC layer joined in @p region
+ */
+void mac_sim_init(struct mac_sim *sim, smtc_real_region_types_t region);
+
+/**
+ * @brief Replay the downlink MAC commands in @p cmd
+ *
+ * @return Number of bytes of the answers, in sim->mac.tx_fopts_data
+ */
+uint8_t mac_sim_cmd(struct mac_sim *sim, const uint8_t *cmd, uint8_t size);
+
+/**
+ * @brief Encode a frequency of a MAC command
+ *
+ * @param[in] sim Simulation, the frequency step depends on the region
+ * @param[out] buf The 3 bytes of the frequency
+ * @param[in] freq_hz Frequency, in Hz
+ */
+void mac_sim_freq_encode(struct mac_sim *sim, uint8_t *buf, uint32_t freq_hz);
+
+/**
+ * @brief Get the uplink frequencies picked by the channel selection at a data rate
+ *
+ * The channel selection is drawn until every enabled channel has had many chances to be picked.
+ *
+ * @param[in] sim Simulation
+ * @param[in] dr Data rate of the uplinks
+ * @param[out] freq_hz Picked frequencies in increasing order, MAC_SIM_CHANNEL_NB_MAX elements
+ *
+ * @return Number of frequencies
+ */
+uint8_t mac_sim_uplink_freqs(struct mac_sim *sim, uint8_t dr, uint32_t *freq_hz);
+
+#endif /* MAC_SIM_H */
@@ -0,0 +1,158 @@
+/** @file test_duty_cycle.c
+ *
+ * @brief Airtime of smtc_duty_cycle against an exact event log
+ *
+ * Random transmissions are summed in a duty cycle band while they are also logged with their
+ * time. The airtime counted by the band must stay between the exact sum of the logged airtime over
+ * the last period and over the last period plus one slot, and the next free time must be the
+ * exact time the budget comes back. The clock starts 10 minutes before the wrap of the 32-bit
+ * millisecond RTC.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2022 Irnas. All rights reserved.
+ */
+
+#include <zephyr/ztest.h>
+
+#include <smtc_duty_cycle.h>
+#include <smtc_modem_hal.h>
+#include <test_hal.h>
+
+/* Transmissions or waits simulated */
+#define PRV_STEP_NB 20000
+
+/* Band of the log, 1% duty cycle */
+#define PRV_FREQ_MIN_HZ 863000000
+#define PRV_FREQ_MAX_HZ 870000000
+#define PRV_FREQ_HZ 865000000
+#define PRV_DUTY_CYCLE 100
+#define PRV_BUDGET_MS (SMTC_DTC_PERIOD_MS / PRV_DUTY_CYCLE)
+
+/* 10 minutes before the wrap of smtc_modem_hal_get_time_in_ms() */
+#define PRV_START_100US ((0x100000000ULL - 600000ULL) * 10ULL)
+
+#define PRV_SLOT_MS (SMTC_DTC_SECONDS_BY_UNIT * 1000UL)
+
+static smtc_dtc_t prv_dtc;
+
+/* Event log of the transmissions */
+static uint32_t prv_log_ms[PRV_STEP_NB];
+static uint32_t prv_log_toa_ms[PRV_STEP_NB];
+static uint32_t prv_log_nb;
+
+static void prv_config(uint16_t duty_cycle)
+{
+	smtc_duty_cycle_init(&prv_dtc);
+	smtc_duty_cycle_config(&prv_dtc, 1, 0, duty_cycle, PRV_FREQ_MIN_HZ, PRV_FREQ_MAX_HZ);
+	smtc_duty_cycle_enable_set(&prv_dtc, SMTC_DTC_ENABLED);
+}
+
+/* Exact airtime of the transmissions logged in the last window_ms */
+static uint32_t prv_log_sum(uint32_t window_ms)
+{
+	uint32_t now_ms = smtc_modem_hal_get_time_in_ms();
+	uint32_t sum = 0;
+
+	for (uint32_t i = prv_log_nb; i > 0; i--) {
+		if (now_ms - prv_log_ms[i - 1] >= window_ms) {
+			break;
+		}
+		sum += prv_log_toa_ms[i - 1];
+	}
+	return sum;
+}
+
+static int32_t prv_available(void)
+{
+	smtc_duty_cycle_update(&prv_dtc);
+	return smtc_duty_cycle_band_get_available_toa_ms(&prv_dtc, 0);
+}
+
+static void prv_check_bounds(uint32_t step)
+{
+	uint32_t used = PRV_BUDGET_MS - prv_available();
+	uint32_t exact = prv_log_sum(SMTC_DTC_PERIOD_MS);
+	uint32_t exact_slot = prv_log_sum(SMTC_DTC_PERIOD_MS + PRV_SLOT_MS);
+
+	zassert_true(used >= exact, "Step %u: %u ms counted, %u ms sent in the last period", step,
+		     used, exact);
+	zassert_true(used <= exact_slot,
+		     "Step %u: %u ms counted, %u ms sent in the last period and slot", step, used,
+		     exact_slot);
+}
+
+/* The band is full, check that its budget comes back at the next free time and not before */
+static void prv_check_next_free_time(uint32_t step)
+{
+	uint32_t freq_hz = PRV_FREQ_HZ;
+	int32_t available = prv_available();
+	int32_t next_ms = smtc_duty_cycle_get_next_free_time_ms(&prv_dtc, 1, &freq_hz);
+
+	zassert_true(next_ms > 0, "Step %u: band full but free in %d ms", step, next_ms);
+
+	test_hal_advance_ms(next_ms - 1);
+	zassert_equal(prv_available(), available, "Step %u: budget back before %d ms", step,
+		      next_ms);
+	prv_check_bounds(step);
+
+	test_hal_advance_ms(1);
+	zassert_true(prv_available() > available, "Step %u: budget not back after %d ms", step,
+		     next_ms);
+	prv_check_bounds(step);
+}
+
+ZTEST(duty_cycle, test_event_log)
+{
+	uint32_t waits = 0;
+
+	test_hal_reset(PRV_START_100US, 1);
+	prv_config(PRV_DUTY_CYCLE);
+	prv_log_nb = 0;
+
+	for (uint32_t step = 0; step < PRV_STEP_NB; step++) {
+		/* Mostly short gaps, sometimes long enough to empty slots */
+		uint32_t gap_max =
+			(smtc_modem_hal_get_random_nb_in_range(0, 19) == 0) ? 600000 : 20000;
+
+		test_hal_advance_ms(smtc_modem_hal_get_random_nb_in_range(0, gap_max - 1));
+		prv_check_bounds(step);
+
+		if (prv_available() > 0) {
+			/* Mostly short frames, sometimes long SF12 bursts */
+			uint32_t toa_max =
+				(smtc_modem_hal_get_random_nb_in_range(0, 3) == 0) ? 40000 : 3000;
+			uint32_t toa_ms = smtc_modem_hal_get_random_nb_in_range(1, toa_max);
+
+			smtc_duty_cycle_sum(&prv_dtc, PRV_FREQ_HZ, toa_ms);
+			prv_log_ms[prv_log_nb] = smtc_modem_hal_get_time_in_ms();
+			prv_log_toa_ms[prv_log_nb] = toa_ms;
+			prv_log_nb++;
+		} else {
+			prv_check_next_free_time(step);
+			waits++;
+		}
+	}
+
+	zassert_true(smtc_modem_hal_get_time_in_ms() < PRV_START_100US / 10, "RTC did not wrap");
+	zassert_true(waits > 0, "Band never full");
+}
+
+ZTEST(duty_cycle, test_long_burst)
+{
+	uint32_t sent_ms = 0;
+
+	/* 10% band, 360 s of airtime per period */
+	test_hal_reset(PRV_START_100US, 1);
+	prv_config(10);
+
+	/* Several SF12 bursts in the same slot, more than 16-bit sums could hold */
+	while (sent_ms + 40000 <= SMTC_DTC_PERIOD_MS / 10) {
+		smtc_duty_cycle_sum(&prv_dtc, PRV_FREQ_HZ, 40000);
+		sent_ms += 40000;
+		test_hal_advance_ms(100);
+	}
+	zassert_true(sent_ms > UINT16_MAX, "Bursts fit in 16 bits");
+	zassert_equal(prv_available(), SMTC_DTC_PERIOD_MS / 10 - sent_ms, "Airtime lost");
+}
+
+ZTEST_SUITE(duty_cycle, NULL, NULL, NULL, NULL, NULL);
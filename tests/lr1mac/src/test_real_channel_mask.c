@@ -0,0 +1,210 @@
+/** @file test_real_channel_mask.c
+ *
+ * @brief Uplink channels of the fixed channel plans after random LinkADRReq blocks
+ *
+ * US915, AU915 and CN470 draw the uplink channel from per data rate channel bitmaps. Random
+ * LinkADRReq blocks are replayed and, at every data rate, the channels drawn are compared with a
+ * model of the channel mask following the ChMaskCntl rules of RP002-1.0.3: channels 0 to 63 by
+ * blocks of 16, 500 kHz channels 64 to 71 alone or with all 125 kHz channels on or off. The
+ * channel list of smtc_real_get_tx_channel_list(), used for the LBT fallback channels, must hold
+ * the same channels and leave the channel selection state untouched.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2022 Irnas. All rights reserved.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/ztest.h>
+
+#include <smtc_modem_hal.h>
+
+#include "mac_sim.h"
+
+/* LinkADRReq blocks replayed in each region */
+#define PRV_BLOCK_NB 100
+
+/* Highest data rate checked */
+#define PRV_DR_MAX 7
+
+struct prv_plan {
+	smtc_real_region_types_t region;
+	/* Number of 125 kHz channels, followed by 8 500 kHz channels if dr_500 is not 0 */
+	uint8_t nb_125;
+	/* Data rates of the 125 kHz and of the 500 kHz channels */
+	uint16_t dr_125;
+	uint16_t dr_500;
+};
+
+static const struct prv_plan prv_plans[] = {
+#if defined(REGION_US_915)
+	/* DR5 and DR6 are the LR-FHSS data rates, on the 500 kHz channels */
+	{SMTC_REAL_REGION_US_915, 64, 0x000F, 0x0070},
+#endif
+#if defined(REGION_AU_915)
+	/* DR7 is the LR-FHSS data rate, on the 500 kHz channels */
+	{SMTC_REAL_REGION_AU_915, 64, 0x003F, 0x00C0},
+#endif
+#if defined(REGION_CN_470)
+	/* 20 MHz channel plan, selected by the join request */
+	{SMTC_REAL_REGION_CN_470, 64, 0x003E, 0},
+#endif
+};
+
+static struct mac_sim prv_sim;
+static uint32_t prv_freq_hz[MAC_SIM_CHANNEL_NB_MAX];
+static uint32_t prv_rx1_hz[MAC_SIM_CHANNEL_NB_MAX];
+
+/* Model of the enabled channels, one bit per channel */
+static uint8_t prv_mask[MAC_SIM_CHANNEL_NB_MAX / 8];
+
+static void prv_model(const struct prv_plan *plan, uint8_t cntl, uint16_t ch_mask)
+{
+	switch (cntl) {
+	case 0:
+	case 1:
+	case 2:
+	case 3:
+		prv_mask[2 * cntl] = ch_mask & 0xFF;
+		prv_mask[2 * cntl + 1] = ch_mask >> 8;
+		break;
+	case 4:
+		prv_mask[8] = ch_mask & 0xFF;
+		break;
+	case 6:
+	case 7:
+		memset(prv_mask, (cntl == 6) ? 0xFF : 0x00, 8);
+		prv_mask[8] = ch_mask & 0xFF;
+		break;
+	default:
+		zassert_unreachable("ChMaskCntl %u not modelled", cntl);
+	}
+	if (plan->dr_500 == 0) {
+		prv_mask[8] = 0;
+	}
+}
+
+static bool prv_model_enabled(uint8_t channel)
+{
+	return (prv_mask[channel / 8] >> (channel % 8)) & 1;
+}
+
+static int prv_cmp(const void *a, const void *b)
+{
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+/* The channel list holds the expected channels and leaves the channel selection state untouched */
+static void prv_check_list(const struct prv_plan *plan, uint32_t block, uint8_t dr,
+			   const uint32_t *expected, uint8_t expected_nb)
+{
+	smtc_real_t real = prv_sim.real;
+	uint8_t nb = smtc_real_get_tx_channel_list(&prv_sim.mac, dr, prv_freq_hz, prv_rx1_hz,
+						   MAC_SIM_CHANNEL_NB_MAX);
+
+	zassert_mem_equal(&prv_sim.real, &real, sizeof(real),
+			  "Region %u block %u DR%u: channel selection state changed", plan->region,
+			  block, dr);
+	zassert_equal(nb, expected_nb, "Region %u block %u DR%u: %u channels listed instead of %u",
+		      plan->region, block, dr, nb, expected_nb);
+	qsort(prv_freq_hz, nb, sizeof(prv_freq_hz[0]), prv_cmp);
+	zassert_mem_equal(prv_freq_hz, expected, nb * sizeof(expected[0]),
+			  "Region %u block %u DR%u: wrong channels listed", plan->region, block, dr);
+}
+
+static void prv_check_channels(const struct prv_plan *plan, uint32_t block)
+{
+	for (uint8_t dr = 0; dr <= PRV_DR_MAX; dr++) {
+		uint32_t expected[MAC_SIM_CHANNEL_NB_MAX];
+		uint8_t expected_nb = 0;
+		uint8_t nb;
+
+		for (uint8_t ch = 0; ch < plan->nb_125 + 8; ch++) {
+			uint16_t drs = (ch < plan->nb_125) ? plan->dr_125 : plan->dr_500;
+
+			if (prv_model_enabled(ch) && ((drs >> dr) & 1)) {
+				expected[expected_nb++] =
+					smtc_real_get_tx_channel_frequency(&prv_sim.mac, ch);
+			}
+		}
+		/* The channel selection needs a channel */
+		if (expected_nb == 0) {
+			continue;
+		}
+
+		prv_check_list(plan, block, dr, expected, expected_nb);
+
+		nb = mac_sim_uplink_freqs(&prv_sim, dr, prv_freq_hz);
+		zassert_equal(nb, expected_nb, "Region %u block %u DR%u: %u channels instead of %u",
+			      plan->region, block, dr, nb, expected_nb);
+		/* Channel frequencies increase with the channel index */
+		zassert_mem_equal(prv_freq_hz, expected, nb * sizeof(expected[0]),
+				  "Region %u block %u DR%u: wrong channels", plan->region, block,
+				  dr);
+	}
+}
+
+static void prv_link_adr_req(const struct prv_plan *plan, uint32_t block)
+{
+	static const uint8_t partial_cntl[] = {0, 1, 2, 3, 4, 6, 7};
+	uint8_t cmd[7 * LINK_ADR_REQ_SIZE];
+	uint8_t cmd_nb = 0;
+	uint8_t extra_nb = smtc_modem_hal_get_random_nb_in_range(0, 2);
+
+	/* Every channel defined: 125 kHz channels off with the 500 kHz mask, then each block */
+	for (uint8_t i = 0; i < 5 + extra_nb; i++) {
+		uint8_t cntl = (i == 0) ? 7 : i - 1;
+		uint16_t ch_mask = smtc_modem_hal_get_random_nb_in_range(0, 0xFFFF);
+		uint8_t *req = &cmd[cmd_nb * LINK_ADR_REQ_SIZE];
+
+		if (plan->dr_500 == 0) {
+			/* CN470 20 MHz plans: ChMaskCntl 0 to 3 only */
+			if (i == 0) {
+				continue;
+			}
+			if (i >= 5) {
+				cntl = smtc_modem_hal_get_random_nb_in_range(0, 3);
+			}
+		} else if (i >= 5) {
+			cntl = partial_cntl[smtc_modem_hal_get_random_nb_in_range(
+				0, ARRAY_SIZE(partial_cntl) - 1)];
+		}
+
+		/* Current DR and TX power kept, NbTrans 1 */
+		req[0] = LINK_ADR_REQ;
+		req[1] = 0xFF;
+		req[2] = ch_mask & 0xFF;
+		req[3] = ch_mask >> 8;
+		req[4] = (cntl << 4) | 1;
+		prv_model(plan, cntl, ch_mask);
+		cmd_nb++;
+	}
+
+	zassert_equal(mac_sim_cmd(&prv_sim, cmd, cmd_nb * LINK_ADR_REQ_SIZE),
+		      cmd_nb * LINK_ADR_ANS_SIZE, "Region %u block %u: answers missing",
+		      plan->region, block);
+	for (uint8_t i = 0; i < cmd_nb; i++) {
+		zassert_equal(prv_sim.mac.tx_fopts_data[i * LINK_ADR_ANS_SIZE + 1], 0x07,
+			      "Region %u block %u: status 0x%02x", plan->region, block,
+			      prv_sim.mac.tx_fopts_data[i * LINK_ADR_ANS_SIZE + 1]);
+	}
+}
+
+ZTEST(real_channel_mask, test_random_link_adr_req)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(prv_plans); i++) {
+		const struct prv_plan *plan = &prv_plans[i];
+
+		mac_sim_init(&prv_sim, plan->region);
+		for (uint32_t block = 0; block < PRV_BLOCK_NB; block++) {
+			prv_link_adr_req(plan, block);
+			prv_check_channels(plan, block);
+		}
+	}
+}
+
+ZTEST_SUITE(real_channel_mask, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,342 @@
+/** @file test_real_conformance.c
+ *
+ * @brief Regional parameters conformance of smtc_real, region by region
+ *
+ * Every compiled region is joined without CFList, then downlink MAC commands (LinkADRReq,
+ * NewChannelReq, DlChannelReq, RxParamSetupReq) are replayed through the command parser. The
+ * answers, the applied parameters and the channels picked by the channel selection are checked
+ * against the LoRaWAN Regional Parameters RP002-1.0.3 and the LoRaWAN 1.0.4 MAC commands.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2022 Irnas. All rights reserved.
+ */
+
+#include <zephyr/ztest.h>
+
+#include "mac_sim.h"
+
+/* Frequency rejected in every region */
+#define PRV_INVALID_HZ 100000000
+
+struct prv_region {
+	smtc_real_region_types_t region;
+	/* Data rate of the default channels checked, also requested by LinkADRReq */
+	uint8_t dr;
+	/* Default channels, nb channels step_hz apart from hz[0] or the nb channels listed in hz */
+	uint8_t nb;
+	uint32_t step_hz;
+	uint32_t hz[3];
+	uint32_t rx2_hz;
+	uint8_t rx2_dr;
+	/* Number of RX1DROffset values, 8 when every value of the field is valid */
+	uint8_t rx1_dr_offset_nb;
+	/* Frequency of the channel added by NewChannelReq, 0 for a fixed channel plan */
+	uint32_t new_hz;
+};
+
+static const struct prv_region prv_regions[] = {
+#if defined(REGION_EU_868)
+	{SMTC_REAL_REGION_EU_868, 5, 3, 200000, {868100000}, 869525000, 0, 6, 867100000},
+#endif
+#if defined(REGION_AS_923)
+	{SMTC_REAL_REGION_AS_923, 5, 2, 200000, {923200000}, 923200000, 2, 8, 923600000},
+	{SMTC_REAL_REGION_AS_923_GRP2, 5, 2, 200000, {921400000}, 921400000, 2, 8, 921800000},
+	{SMTC_REAL_REGION_AS_923_GRP3, 5, 2, 200000, {916600000}, 916600000, 2, 8, 917000000},
+	{SMTC_REAL_REGION_AS_923_GRP4, 5, 2, 200000, {917300000}, 917300000, 2, 8, 917700000},
+#endif
+#if defined(REGION_US_915)
+	{SMTC_REAL_REGION_US_915, 0, 64, 200000, {902300000}, 923300000, 8, 4, 0},
+#endif
+#if defined(REGION_AU_915)
+	{SMTC_REAL_REGION_AU_915, 0, 64, 200000, {915200000}, 923300000, 8, 6, 0},
+#endif
+#if defined(REGION_CN_470_RP_1_0)
+	{SMTC_REAL_REGION_CN_470_RP_1_0, 0, 96, 200000, {470300000}, 505300000, 0, 6, 0},
+#endif
+#if defined(REGION_WW2G4)
+	{SMTC_REAL_REGION_WW2G4, 5, 3, 0, {2403000000, 2425000000, 2479000000}, 2423000000, 0, 6,
+	 2450000000},
+#endif
+#if defined(REGION_IN_865)
+	{SMTC_REAL_REGION_IN_865, 5, 3, 0, {865062500, 865402500, 865985000}, 866550000, 2, 8,
+	 866100000},
+#endif
+#if defined(REGION_KR_920)
+	{SMTC_REAL_REGION_KR_920, 5, 3, 200000, {922100000}, 921900000, 0, 6, 922700000},
+#endif
+#if defined(REGION_RU_864)
+	{SMTC_REAL_REGION_RU_864, 5, 2, 200000, {868900000}, 869100000, 0, 6, 864100000},
+#endif
+};
+
+static struct mac_sim prv_sim;
+static uint32_t prv_freq_hz[MAC_SIM_CHANNEL_NB_MAX];
+
+static uint32_t prv_default_hz(const struct prv_region *r, uint8_t i)
+{
+	return (r->step_hz != 0) ? r->hz[0] + i * r->step_hz : r->hz[i];
+}
+
+/* Check that the uplinks at DR r->dr use the first nb default channels and the extra ones */
+static void prv_check_uplinks(const struct prv_region *r, uint8_t nb, const uint32_t *extra_hz,
+			      uint8_t extra_nb)
+{
+	uint32_t expected[MAC_SIM_CHANNEL_NB_MAX];
+	uint8_t got_nb = mac_sim_uplink_freqs(&prv_sim, r->dr, prv_freq_hz);
+
+	for (uint8_t i = 0; i < nb; i++) {
+		expected[i] = prv_default_hz(r, i);
+	}
+	for (uint8_t i = 0; i < extra_nb; i++) {
+		uint8_t j;
+
+		/* Insertion in increasing order, as returned by mac_sim_uplink_freqs() */
+		for (j = nb + i; (j > 0) && (expected[j - 1] > extra_hz[i]); j--) {
+			expected[j] = expected[j - 1];
+		}
+		expected[j] = extra_hz[i];
+	}
+
+	zassert_equal(got_nb, nb + extra_nb, "Region %u: %u channels instead of %u", r->region,
+		      got_nb, nb + extra_nb);
+	for (uint8_t i = 0; i < got_nb; i++) {
+		zassert_equal(prv_freq_hz[i], expected[i], "Region %u: channel %u at %u Hz",
+			      r->region, i, prv_freq_hz[i]);
+	}
+}
+
+static void prv_check_ans(const struct prv_region *r, const uint8_t *cmd, uint8_t size,
+			  uint8_t cid, uint8_t status)
+{
+	zassert_equal(mac_sim_cmd(&prv_sim, cmd, size), 2, "Region %u: no answer to 0x%02x",
+		      r->region, cid);
+	zassert_equal(prv_sim.mac.tx_fopts_data[0], cid, "Region %u: wrong answer", r->region);
+	zassert_equal(prv_sim.mac.tx_fopts_data[1], status,
+		      "Region %u: status 0x%02x instead of 0x%02x to 0x%02x", r->region,
+		      prv_sim.mac.tx_fopts_data[1], status, cid);
+}
+
+ZTEST(real_conformance, test_default_channels)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(prv_regions); i++) {
+		const struct prv_region *r = &prv_regions[i];
+
+		mac_sim_init(&prv_sim, r->region);
+
+		prv_check_uplinks(r, r->nb, NULL, 0);
+		zassert_equal(prv_sim.mac.rx2_frequency, r->rx2_hz, "Region %u: RX2 at %u Hz",
+			      r->region, prv_sim.mac.rx2_frequency);
+		zassert_equal(prv_sim.mac.rx2_data_rate, r->rx2_dr, "Region %u: RX2 at DR%u",
+			      r->region, prv_sim.mac.rx2_data_rate);
+	}
+}
+
+#if defined(REGION_CN_470)
+ZTEST(real_conformance, test_default_channels_cn_470)
+{
+	uint8_t nb;
+
+	/* The 20 MHz or 26 MHz channel plan follows the channel of the join request */
+	mac_sim_init(&prv_sim, SMTC_REAL_REGION_CN_470);
+
+	nb = mac_sim_uplink_freqs(&prv_sim, 2, prv_freq_hz);
+	zassert_true(nb >= 48, "%u channels", nb);
+	for (uint8_t i = 0; i < nb; i++) {
+		zassert_between_inclusive(prv_freq_hz[i], 470000000, 510000000, "Channel at %u Hz",
+					  prv_freq_hz[i]);
+		zassert_equal(prv_freq_hz[i] % 100000, 0, "Channel at %u Hz", prv_freq_hz[i]);
+	}
+}
+#endif
+
+ZTEST(real_conformance, test_link_adr_req)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(prv_regions); i++) {
+		const struct prv_region *r = &prv_regions[i];
+
+		if (r->new_hz == 0) {
+			continue;
+		}
+		mac_sim_init(&prv_sim, r->region);
+
+		/* DR, TXPower 1, channels 0 and 1, NbTrans 2 */
+		uint8_t ok[] = {LINK_ADR_REQ, (r->dr << 4) | 1, 0x03, 0x00, 0x02};
+
+		prv_check_ans(r, ok, sizeof(ok), LINK_ADR_ANS, 0x07);
+		zassert_equal(prv_sim.mac.tx_data_rate_adr, r->dr, "Region %u: DR%u", r->region,
+			      prv_sim.mac.tx_data_rate_adr);
+		zassert_equal(prv_sim.mac.tx_power, prv_sim.mac.max_erp_dbm - 2,
+			      "Region %u: %d dBm", r->region, prv_sim.mac.tx_power);
+		zassert_equal(prv_sim.mac.nb_trans, 2, "Region %u: NbTrans %u", r->region,
+			      prv_sim.mac.nb_trans);
+		prv_check_uplinks(r, 2, NULL, 0);
+
+		/* Invalid DR, TXPower or ChMaskCntl: nothing applied, all channels requested */
+		uint8_t bad_dr[] = {LINK_ADR_REQ, 0xE0, 0x07, 0x00, 0x01};
+		uint8_t bad_power[] = {LINK_ADR_REQ, (r->dr << 4) | 0x0E, 0x07, 0x00, 0x01};
+		uint8_t bad_cntl[] = {LINK_ADR_REQ, (r->dr << 4) | 1, 0x07, 0x00, 0x51};
+
+		prv_check_ans(r, bad_dr, sizeof(bad_dr), LINK_ADR_ANS, 0x05);
+		prv_check_ans(r, bad_power, sizeof(bad_power), LINK_ADR_ANS, 0x03);
+		prv_check_ans(r, bad_cntl, sizeof(bad_cntl), LINK_ADR_ANS, 0x06);
+		zassert_equal(prv_sim.mac.tx_data_rate_adr, r->dr, "Region %u: DR%u", r->region,
+			      prv_sim.mac.tx_data_rate_adr);
+		zassert_equal(prv_sim.mac.nb_trans, 2, "Region %u: NbTrans %u", r->region,
+			      prv_sim.mac.nb_trans);
+		prv_check_uplinks(r, 2, NULL, 0);
+	}
+}
+
+#if defined(REGION_US_915) || defined(REGION_AU_915)
+static void prv_link_adr_req_64_8(const struct prv_region *r, uint8_t dr_500_khz,
+				  uint32_t ch_64_hz)
+{
+	/* ChMaskCntl 7: 125 kHz channels off, channel 64 on, then 125 kHz channels 0 to 7 on */
+	uint8_t block[] = {LINK_ADR_REQ, 0x20, 0x01, 0x00, 0x70,
+			   LINK_ADR_REQ, 0x22, 0xFF, 0x00, 0x01};
+
+	mac_sim_init(&prv_sim, r->region);
+
+	zassert_equal(mac_sim_cmd(&prv_sim, block, sizeof(block)), 4, "Region %u: no answer",
+		      r->region);
+	for (uint8_t i = 0; i < 2; i++) {
+		zassert_equal(prv_sim.mac.tx_fopts_data[2 * i], LINK_ADR_ANS, "Wrong answer");
+		zassert_equal(prv_sim.mac.tx_fopts_data[2 * i + 1], 0x07,
+			      "Region %u: status 0x%02x", r->region,
+			      prv_sim.mac.tx_fopts_data[2 * i + 1]);
+	}
+	zassert_equal(prv_sim.mac.tx_data_rate_adr, 2, "Region %u: DR%u", r->region,
+		      prv_sim.mac.tx_data_rate_adr);
+	prv_check_uplinks(r, 8, NULL, 0);
+
+	zassert_equal(mac_sim_uplink_freqs(&prv_sim, dr_500_khz, prv_freq_hz), 1,
+		      "Region %u: more than channel 64", r->region);
+	zassert_equal(prv_freq_hz[0], ch_64_hz, "Region %u: channel 64 at %u Hz", r->region,
+		      prv_freq_hz[0]);
+}
+#endif
+
+#if defined(REGION_US_915)
+ZTEST(real_conformance, test_link_adr_req_us_915)
+{
+	static const struct prv_region r = {SMTC_REAL_REGION_US_915, 0, 0, 200000, {902300000}};
+
+	prv_link_adr_req_64_8(&r, 4, 903000000);
+}
+#endif
+
+#if defined(REGION_AU_915)
+ZTEST(real_conformance, test_link_adr_req_au_915)
+{
+	static const struct prv_region r = {SMTC_REAL_REGION_AU_915, 0, 0, 200000, {915200000}};
+
+	prv_link_adr_req_64_8(&r, 6, 915900000);
+}
+#endif
+
+ZTEST(real_conformance, test_new_channel_req)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(prv_regions); i++) {
+		const struct prv_region *r = &prv_regions[i];
+		/* Channel 3, DR0 to DR5 */
+		uint8_t cmd[] = {NEW_CHANNEL_REQ, 3, 0, 0, 0, 0x50};
+
+		mac_sim_init(&prv_sim, r->region);
+		mac_sim_freq_encode(&prv_sim, &cmd[2], r->new_hz ? r->new_hz : r->rx2_hz);
+
+		if (r->new_hz == 0) {
+			zassert_equal(mac_sim_cmd(&prv_sim, cmd, sizeof(cmd)), 0,
+				      "Region %u: answer to NewChannelReq", r->region);
+			prv_check_uplinks(r, r->nb, NULL, 0);
+			continue;
+		}
+
+		prv_check_ans(r, cmd, sizeof(cmd), NEW_CHANNEL_ANS, 0x03);
+		prv_check_uplinks(r, r->nb, &r->new_hz, 1);
+
+		/* Default channel, invalid frequency and DR range: channels unchanged */
+		uint8_t bad_index[] = {NEW_CHANNEL_REQ, 0, cmd[2], cmd[3], cmd[4], 0x50};
+		uint8_t bad_freq[] = {NEW_CHANNEL_REQ, 4, 0, 0, 0, 0x50};
+		uint8_t bad_dr[] = {NEW_CHANNEL_REQ, 4, cmd[2], cmd[3], cmd[4], 0xF0};
+
+		mac_sim_freq_encode(&prv_sim, &bad_freq[2], PRV_INVALID_HZ);
+		prv_check_ans(r, bad_index, sizeof(bad_index), NEW_CHANNEL_ANS, 0x00);
+		prv_check_ans(r, bad_freq, sizeof(bad_freq), NEW_CHANNEL_ANS, 0x02);
+		prv_check_ans(r, bad_dr, sizeof(bad_dr), NEW_CHANNEL_ANS, 0x01);
+		prv_check_uplinks(r, r->nb, &r->new_hz, 1);
+	}
+}
+
+ZTEST(real_conformance, test_dl_channel_req)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(prv_regions); i++) {
+		const struct prv_region *r = &prv_regions[i];
+		uint8_t new_ch[] = {NEW_CHANNEL_REQ, 3, 0, 0, 0, 0x50};
+		/* RX1 of channel 3 on the RX2 frequency */
+		uint8_t cmd[] = {DL_CHANNEL_REQ, 3, 0, 0, 0};
+
+		if (r->new_hz == 0) {
+			continue;
+		}
+		mac_sim_init(&prv_sim, r->region);
+		mac_sim_freq_encode(&prv_sim, &new_ch[2], r->new_hz);
+		mac_sim_freq_encode(&prv_sim, &cmd[2], r->rx2_hz);
+		prv_check_ans(r, new_ch, sizeof(new_ch), NEW_CHANNEL_ANS, 0x03);
+		prv_check_ans(r, cmd, sizeof(cmd), DL_CHANNEL_ANS, 0x03);
+
+		/* Channel 3 keeps its uplink frequency, its RX1 moves */
+		prv_sim.mac.tx_data_rate = r->dr;
+		do {
+			zassert_equal(smtc_real_get_next_channel(&prv_sim.mac), OKLORAWAN,
+				      "Region %u: no channel", r->region);
+		} while (prv_sim.mac.tx_frequency != r->new_hz);
+		zassert_equal(prv_sim.mac.rx1_frequency, r->rx2_hz, "Region %u: RX1 at %u Hz",
+			      r->region, prv_sim.mac.rx1_frequency);
+
+		/* Undefined channel and invalid frequency */
+		uint8_t bad_index[] = {DL_CHANNEL_REQ, 5, cmd[2], cmd[3], cmd[4]};
+		uint8_t bad_freq[] = {DL_CHANNEL_REQ, 3, 0, 0, 0};
+
+		mac_sim_freq_encode(&prv_sim, &bad_freq[2], PRV_INVALID_HZ);
+		prv_check_ans(r, bad_index, sizeof(bad_index), DL_CHANNEL_ANS, 0x01);
+		prv_check_ans(r, bad_freq, sizeof(bad_freq), DL_CHANNEL_ANS, 0x02);
+	}
+}
+
+ZTEST(real_conformance, test_rx_param_setup_req)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(prv_regions); i++) {
+		const struct prv_region *r = &prv_regions[i];
+		/* RX1DROffset 1, RX2 one DR above the default */
+		uint8_t cmd[] = {RXPARRAM_SETUP_REQ, 0x10 | (r->rx2_dr + 1), 0, 0, 0};
+
+		mac_sim_init(&prv_sim, r->region);
+		mac_sim_freq_encode(&prv_sim, &cmd[2], r->rx2_hz);
+		prv_check_ans(r, cmd, sizeof(cmd), RXPARRAM_SETUP_ANS, 0x07);
+		zassert_equal(prv_sim.mac.rx1_dr_offset, 1, "Region %u: offset %u", r->region,
+			      prv_sim.mac.rx1_dr_offset);
+		zassert_equal(prv_sim.mac.rx2_data_rate, r->rx2_dr + 1, "Region %u: RX2 at DR%u",
+			      r->region, prv_sim.mac.rx2_data_rate);
+		zassert_equal(prv_sim.mac.rx2_frequency, r->rx2_hz, "Region %u: RX2 at %u Hz",
+			      r->region, prv_sim.mac.rx2_frequency);
+
+		/* Status bits: RX1DROffset ACK, RX2 data rate ACK, channel ACK */
+		uint8_t bad_offset[] = {RXPARRAM_SETUP_REQ, (r->rx1_dr_offset_nb << 4) | r->rx2_dr,
+					cmd[2], cmd[3], cmd[4]};
+		uint8_t bad_dr[] = {RXPARRAM_SETUP_REQ, 0x0F, cmd[2], cmd[3], cmd[4]};
+		uint8_t bad_freq[] = {RXPARRAM_SETUP_REQ, r->rx2_dr, 0, 0, 0};
+
+		mac_sim_freq_encode(&prv_sim, &bad_freq[2], PRV_INVALID_HZ);
+		if (r->rx1_dr_offset_nb < 8) {
+			prv_check_ans(r, bad_offset, sizeof(bad_offset), RXPARRAM_SETUP_ANS, 0x03);
+		}
+		prv_check_ans(r, bad_dr, sizeof(bad_dr), RXPARRAM_SETUP_ANS, 0x05);
+		prv_check_ans(r, bad_freq, sizeof(bad_freq), RXPARRAM_SETUP_ANS, 0x06);
+		zassert_equal(prv_sim.mac.rx1_dr_offset, 1, "Region %u: offset %u", r->region,
+			      prv_sim.mac.rx1_dr_offset);
+		zassert_equal(prv_sim.mac.rx2_data_rate, r->rx2_dr + 1, "Region %u: RX2 at DR%u",
+			      r->region, prv_sim.mac.rx2_data_rate);
+	}
+}
+
+ZTEST_SUITE(real_conformance, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,287 @@
+/** @file test_real_dispatch.c
+ *
+ * @brief Region dispatch of smtc_real against the switch statements it replaced
+ *
+ * The region dependent results of smtc_real (constants, data rate tables, RX1 data rates, channel
+ * plans, channel masks built by LinkADRReq and the answers to the MAC commands) are folded, region
+ * by region, into an FNV-1a digest. The expected digests were recorded with smtc_real.c dispatching
+ * on the region with switch statements, before the per-region ops table. Channels are folded as
+ * the set drawn by the channel selection, not in draw order, so the digest does not depend on the
+ * random draws.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2022 Irnas. All rights reserved.
+ */
+
+#include <zephyr/ztest.h>
+
+#include "mac_sim.h"
+
+#define PRV_FNV_OFFSET 2166136261u
+#define PRV_FNV_PRIME  16777619u
+
+/* Highest data rate checked */
+#define PRV_DR_MAX 15
+
+struct prv_digest {
+	smtc_real_region_types_t region;
+	uint32_t digest;
+};
+
+static const struct prv_digest prv_digests[] = {
+#if defined(REGION_EU_868)
+	{SMTC_REAL_REGION_EU_868, 0xcf95dfe4},
+#endif
+#if defined(REGION_AS_923)
+	{SMTC_REAL_REGION_AS_923, 0xf6c2d003},
+	{SMTC_REAL_REGION_AS_923_GRP2, 0xd8905792},
+	{SMTC_REAL_REGION_AS_923_GRP3, 0xf25eb55d},
+	{SMTC_REAL_REGION_AS_923_GRP4, 0x271016fe},
+#endif
+#if defined(REGION_US_915)
+	{SMTC_REAL_REGION_US_915, 0xfcf2c451},
+#endif
+#if defined(REGION_AU_915)
+	{SMTC_REAL_REGION_AU_915, 0x20019c2b},
+#endif
+#if defined(REGION_CN_470)
+	{SMTC_REAL_REGION_CN_470, 0x020a6006},
+#endif
+#if defined(REGION_CN_470_RP_1_0)
+	{SMTC_REAL_REGION_CN_470_RP_1_0, 0x5302e524},
+#endif
+#if defined(REGION_WW2G4)
+	{SMTC_REAL_REGION_WW2G4, 0x5e02ea7c},
+#endif
+#if defined(REGION_IN_865)
+	{SMTC_REAL_REGION_IN_865, 0x11239a2d},
+#endif
+#if defined(REGION_KR_920)
+	{SMTC_REAL_REGION_KR_920, 0x889fb733},
+#endif
+#if defined(REGION_RU_864)
+	{SMTC_REAL_REGION_RU_864, 0x9dbd018f},
+#endif
+};
+
+static struct mac_sim prv_sim;
+static uint32_t prv_freq_hz[MAC_SIM_CHANNEL_NB_MAX];
+static uint32_t prv_digest;
+
+static void prv_fold(uint32_t value)
+{
+	for (uint8_t i = 0; i < 4; i++) {
+		prv_digest = (prv_digest ^ ((value >> (8 * i)) & 0xFF)) * PRV_FNV_PRIME;
+	}
+}
+
+static void prv_fold_constants(void)
+{
+	lr1_stack_mac_t *mac = &prv_sim.mac;
+
+	prv_fold(mac->rx2_frequency);
+	prv_fold(mac->rx2_data_rate);
+	prv_fold(mac->rx1_dr_offset);
+	prv_fold(mac->tx_data_rate_adr);
+	prv_fold(mac->tx_power);
+	prv_fold(mac->max_erp_dbm);
+	prv_fold(smtc_real_get_frequency_factor(mac));
+	prv_fold(smtc_real_get_rx1_join_delay(mac));
+	prv_fold(smtc_real_get_rx2_join_dr(mac));
+	prv_fold(smtc_real_get_coding_rate(mac));
+	prv_fold(smtc_real_get_adr_ack_delay(mac));
+	prv_fold(smtc_real_get_adr_ack_limit(mac));
+	prv_fold(smtc_real_get_public_sync_word(mac));
+	prv_fold(smtc_real_get_private_sync_word(mac));
+	prv_fold(smtc_real_get_default_max_eirp(mac));
+	prv_fold(smtc_real_get_beacon_dr(mac));
+	prv_fold(smtc_real_get_beacon_frequency(mac, 128));
+	prv_fold(smtc_real_get_ping_slot_frequency(mac, 128, 0x12345678));
+	prv_fold(smtc_real_get_ping_slot_datarate(mac));
+	prv_fold(smtc_real_is_dtc_supported(mac));
+	prv_fold(smtc_real_is_lbt_supported(mac));
+	if (smtc_real_is_lbt_supported(mac)) {
+		prv_fold(smtc_real_get_lbt_duration_ms(mac));
+		prv_fold(smtc_real_get_lbt_threshold_dbm(mac));
+		prv_fold(smtc_real_get_lbt_bw_hz(mac));
+	}
+	prv_fold(smtc_real_is_new_channel_req_supported(mac));
+	prv_fold(smtc_real_is_tx_param_setup_req_supported(mac));
+	prv_fold(smtc_real_cf_list_type_supported(mac));
+	prv_fold(smtc_real_get_number_of_chmask_in_cflist(mac));
+	prv_fold(smtc_real_get_min_tx_channel_dr(mac));
+	prv_fold(smtc_real_get_max_tx_channel_dr(mac));
+	prv_fold(smtc_real_decrement_dr_simulation(mac));
+	for (uint8_t sf = 5; sf <= 12; sf++) {
+		prv_fold(smtc_real_get_preamble_len(mac, sf));
+	}
+}
+
+static void prv_fold_data_rates(smtc_real_region_types_t region)
+{
+	lr1_stack_mac_t *mac = &prv_sim.mac;
+
+	for (uint8_t dr = 0; dr <= PRV_DR_MAX; dr++) {
+		bool tx = smtc_real_is_tx_dr_valid(mac, dr) == OKLORAWAN;
+		bool rx = smtc_real_is_rx_dr_valid(mac, dr) == OKLORAWAN;
+		modulation_type_t modulation;
+
+		prv_fold(tx);
+		prv_fold(rx);
+		if (!tx && !rx) {
+			continue;
+		}
+
+		modulation = smtc_real_get_modulation_type_from_datarate(mac, dr);
+		prv_fold(modulation);
+		if (modulation == LORA) {
+			uint8_t sf;
+			lr1mac_bandwidth_t bw;
+
+			smtc_real_lora_dr_to_sf_bw(mac, dr, &sf, &bw);
+			prv_fold(sf);
+			prv_fold(bw);
+			prv_fold(smtc_real_get_symbol_duration_us(mac, dr));
+		} else if (modulation == FSK) {
+			uint8_t bitrate;
+
+			smtc_real_fsk_dr_to_bitrate(mac, dr, &bitrate);
+			prv_fold(bitrate);
+		} else if (modulation == LR_FHSS) {
+			lr_fhss_v1_cr_t cr;
+			lr_fhss_v1_bw_t bw;
+
+			smtc_real_lr_fhss_dr_to_cr_bw(mac, dr, &cr, &bw);
+			prv_fold(cr);
+			prv_fold(bw);
+		}
+
+		if (!tx) {
+			continue;
+		}
+		prv_fold(smtc_real_is_tx_dr_acceptable(mac, dr, false));
+		prv_fold(smtc_real_get_max_payload_size(mac, dr, 0));
+		/* WW2G4 accepts TxParamSetupReq but has no payload sizes with dwell time */
+		if (smtc_real_is_tx_param_setup_req_supported(mac) &&
+		    (region != SMTC_REAL_REGION_WW2G4)) {
+			prv_fold(smtc_real_get_max_payload_size(mac, dr, 1));
+		}
+
+		/* RX1 data rate of each valid RX1DROffset */
+		for (uint8_t offset = 0; offset < 8; offset++) {
+			if (smtc_real_is_rx1_dr_offset_valid(mac, offset) != OKLORAWAN) {
+				continue;
+			}
+			mac->tx_data_rate = dr;
+			mac->rx1_dr_offset = offset;
+			smtc_real_set_rx_config(mac, RX1);
+			prv_fold(offset);
+			prv_fold(mac->rx_data_rate);
+		}
+	}
+	mac->rx1_dr_offset = 0;
+}
+
+/* Uplink and RX1 frequencies of every channel picked at each valid data rate */
+static void prv_fold_channels(void)
+{
+	lr1_stack_mac_t *mac = &prv_sim.mac;
+
+	for (uint8_t dr = 0; dr <= PRV_DR_MAX; dr++) {
+		uint8_t nb;
+
+		if ((smtc_real_is_tx_dr_valid(mac, dr) != OKLORAWAN) ||
+		    (smtc_real_is_tx_dr_acceptable(mac, dr, false) != OKLORAWAN)) {
+			continue;
+		}
+		nb = mac_sim_uplink_freqs(&prv_sim, dr, prv_freq_hz);
+		prv_fold(dr);
+		prv_fold(nb);
+		for (uint8_t i = 0; i < nb; i++) {
+			prv_fold(prv_freq_hz[i]);
+		}
+		for (uint8_t i = 0; i < nb; i++) {
+			do {
+				smtc_real_get_next_channel(mac);
+			} while (mac->tx_frequency != prv_freq_hz[i]);
+			prv_fold(mac->rx1_frequency);
+		}
+	}
+}
+
+static void prv_fold_cmd(const uint8_t *cmd, uint8_t size)
+{
+	uint8_t len = mac_sim_cmd(&prv_sim, cmd, size);
+
+	prv_fold(len);
+	for (uint8_t i = 0; i < len; i++) {
+		prv_fold(prv_sim.mac.tx_fopts_data[i]);
+	}
+	prv_fold(prv_sim.mac.tx_data_rate_adr);
+	prv_fold(prv_sim.mac.tx_power);
+	prv_fold(prv_sim.mac.nb_trans);
+	prv_fold(prv_sim.mac.rx1_dr_offset);
+	prv_fold(prv_sim.mac.rx2_data_rate);
+	prv_fold(prv_sim.mac.rx2_frequency);
+}
+
+/* LinkADRReq with every ChMaskCntl, from the state after the join */
+static void prv_fold_link_adr_req(smtc_real_region_types_t region)
+{
+	for (uint8_t cntl = 0; cntl < 8; cntl++) {
+		/* Current DR and power, every other channel of the block, NbTrans 1 */
+		uint8_t cmd[] = {LINK_ADR_REQ, 0xFF, 0x55, 0x55, (cntl << 4) | 1};
+
+		mac_sim_init(&prv_sim, region);
+		prv_fold_cmd(cmd, sizeof(cmd));
+		prv_fold_channels();
+	}
+}
+
+static void prv_fold_channel_req(smtc_real_region_types_t region)
+{
+	uint8_t new_ch[] = {NEW_CHANNEL_REQ, 3, 0, 0, 0, 0x50};
+	uint8_t dl_ch[] = {DL_CHANNEL_REQ, 3, 0, 0, 0};
+	uint8_t rx_param[] = {RXPARRAM_SETUP_REQ, 0, 0, 0, 0};
+
+	mac_sim_init(&prv_sim, region);
+
+	/* New channel 2 MHz below RX2, with its RX1 on RX2 */
+	mac_sim_freq_encode(&prv_sim, &new_ch[2], prv_sim.mac.rx2_frequency - 2000000);
+	mac_sim_freq_encode(&prv_sim, &dl_ch[2], prv_sim.mac.rx2_frequency);
+	prv_fold_cmd(new_ch, sizeof(new_ch));
+	prv_fold_cmd(dl_ch, sizeof(dl_ch));
+	prv_fold_channels();
+
+	/* Valid RX2 data rates, RX2 on the first uplink channel */
+	mac_sim_freq_encode(&prv_sim, &rx_param[2],
+			    smtc_real_get_tx_channel_frequency(&prv_sim.mac, 0));
+	for (uint8_t dr = 0; dr <= PRV_DR_MAX; dr++) {
+		if (smtc_real_is_rx_dr_valid(&prv_sim.mac, dr) == OKLORAWAN) {
+			rx_param[1] = 0x10 | dr;
+			prv_fold_cmd(rx_param, sizeof(rx_param));
+		}
+	}
+}
+
+ZTEST(real_dispatch, test_digests)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(prv_digests); i++) {
+		smtc_real_region_types_t region = prv_digests[i].region;
+
+		prv_digest = PRV_FNV_OFFSET;
+		mac_sim_init(&prv_sim, region);
+		prv_fold_constants();
+		prv_fold_data_rates(region);
+		prv_fold_channels();
+		prv_fold_link_adr_req(region);
+		prv_fold_channel_req(region);
+
+		TC_PRINT("Region %2u: digest 0x%08x\n", region, prv_digest);
+		zassert_equal(prv_digest, prv_digests[i].digest,
+			      "Region %u: digest 0x%08x instead of 0x%08x", region, prv_digest,
+			      prv_digests[i].digest);
+	}
+}
+
+ZTEST_SUITE(real_dispatch, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,153 @@
+/** @file test_real_dtc_latency.c
+ *
+ * @brief Uplink latency of the EU868 channel selection over 24 hours of duty cycle limited traffic
+ *
+ * A device sends DR0 uplinks on the 3 default channels of the 868 MHz 1% sub-band, 3 channels of
+ * the 867 MHz 1% sub-band and the 869.525 MHz channel of the 10% sub-band. The uplinks are
+ * requested at random intervals, whatever the state of the device, and sent in order. The time
+ * from the request of each uplink to its transmission is recorded.
+ *
+ * The channel selection of smtc_real, weighted by the duty cycle budget left in each sub-band, is
+ * compared with a uniform draw over the enabled channels followed by a wait for the sub-band of the
+ * channel drawn to be free again.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2022 Irnas. All rights reserved.
+ */
+
+#include <stdlib.h>
+
+#include <zephyr/ztest.h>
+
+#include <smtc_modem_hal.h>
+#include <test_hal.h>
+
+#include "mac_sim.h"
+
+/* Simulated time */
+#define PRV_SIM_MS (24UL * 3600UL * 1000UL)
+
+/* Time between the requests of two uplinks */
+#define PRV_INTERVAL_MIN_MS 30000
+#define PRV_INTERVAL_MAX_MS 90000
+
+#define PRV_PAYLOAD_SIZE 20
+#define PRV_UPLINK_NB_MAX (PRV_SIM_MS / PRV_INTERVAL_MIN_MS)
+
+/* Channels added to the 3 default ones, DR0 to DR5 */
+static const uint32_t prv_new_hz[] = {867100000, 867300000, 867500000, 869525000};
+
+static struct mac_sim prv_sim;
+static uint32_t prv_freq_hz[3 + ARRAY_SIZE(prv_new_hz)];
+static uint32_t prv_latency_ms[PRV_UPLINK_NB_MAX];
+
+static void prv_init(void)
+{
+	mac_sim_init(&prv_sim, SMTC_REAL_REGION_EU_868);
+
+	for (uint8_t i = 0; i < 3; i++) {
+		prv_freq_hz[i] = smtc_real_get_tx_channel_frequency(&prv_sim.mac, i);
+	}
+	for (uint8_t i = 0; i < ARRAY_SIZE(prv_new_hz); i++) {
+		uint8_t cmd[] = {NEW_CHANNEL_REQ, 3 + i, 0, 0, 0, 0x50};
+
+		mac_sim_freq_encode(&prv_sim, &cmd[2], prv_new_hz[i]);
+		zassert_equal(mac_sim_cmd(&prv_sim, cmd, sizeof(cmd)), NEW_CHANNEL_ANS_SIZE,
+			      "NewChannelReq not answered");
+		zassert_equal(prv_sim.mac.tx_fopts_data[1], 0x03, "Channel %u rejected", 3 + i);
+		prv_freq_hz[3 + i] = prv_new_hz[i];
+	}
+	prv_sim.mac.tx_data_rate = 0;
+}
+
+/* Send one uplink, requested at request_100us, return the time from the request to the
+ * transmission
+ */
+static uint32_t prv_uplink(bool weighted, uint64_t request_100us, uint32_t toa_ms)
+{
+	uint32_t freq_hz = 0;
+
+	if (!weighted) {
+		freq_hz = prv_freq_hz[smtc_modem_hal_get_random_nb_in_range(
+			0, ARRAY_SIZE(prv_freq_hz) - 1)];
+	}
+
+	for (;;) {
+		int32_t wait_ms;
+
+		smtc_duty_cycle_update(&prv_sim.dtc);
+		if (weighted) {
+			if (smtc_real_get_next_channel(&prv_sim.mac) == OKLORAWAN) {
+				freq_hz = prv_sim.mac.tx_frequency;
+				break;
+			}
+			wait_ms = smtc_duty_cycle_get_next_free_time_ms(
+				&prv_sim.dtc, ARRAY_SIZE(prv_freq_hz), prv_freq_hz);
+		} else {
+			if (smtc_duty_cycle_is_channel_free(&prv_sim.dtc, freq_hz)) {
+				break;
+			}
+			wait_ms = smtc_duty_cycle_get_next_free_time_ms(&prv_sim.dtc, 1, &freq_hz);
+		}
+		test_hal_advance_ms(MAX(wait_ms, 1));
+	}
+
+	smtc_duty_cycle_sum(&prv_sim.dtc, freq_hz, toa_ms);
+	return (test_hal_now_100us() - request_100us) / 10;
+}
+
+static int prv_cmp(const void *a, const void *b)
+{
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+/* Run the 24 hours of traffic, return the median latency */
+static uint32_t prv_simulate(bool weighted)
+{
+	uint64_t request_100us;
+	uint64_t end_100us;
+	uint32_t toa_ms;
+	uint32_t nb = 0;
+
+	prv_init();
+	toa_ms = lr1_stack_toa_compute(&prv_sim.mac, 0, PRV_PAYLOAD_SIZE);
+	request_100us = test_hal_now_100us();
+	end_100us = request_100us + PRV_SIM_MS * 10ULL;
+
+	for (;;) {
+		request_100us += smtc_modem_hal_get_random_nb_in_range(PRV_INTERVAL_MIN_MS,
+								       PRV_INTERVAL_MAX_MS) * 10ULL;
+		if (request_100us >= end_100us) {
+			break;
+		}
+		/* Requested while the previous uplink was pending, it is sent after it */
+		if (request_100us > test_hal_now_100us()) {
+			test_hal_run_until(request_100us);
+		}
+		zassert_true(nb < PRV_UPLINK_NB_MAX, "Too many uplinks");
+		prv_latency_ms[nb++] = prv_uplink(weighted, request_100us, toa_ms);
+		test_hal_advance_ms(toa_ms);
+	}
+
+	qsort(prv_latency_ms, nb, sizeof(prv_latency_ms[0]), prv_cmp);
+	TC_PRINT("%s: %u uplinks of %u ms, latency median %u ms, 90th percentile %u ms, "
+		 "max %u ms\n",
+		 weighted ? "Weighted" : "Uniform", nb, toa_ms, prv_latency_ms[nb / 2],
+		 prv_latency_ms[(nb * 9) / 10], prv_latency_ms[nb - 1]);
+
+	return prv_latency_ms[nb / 2];
+}
+
+ZTEST(real_dtc_latency, test_median_latency)
+{
+	uint32_t uniform_ms = prv_simulate(false);
+	uint32_t weighted_ms = prv_simulate(true);
+
+	zassert_true(weighted_ms < uniform_ms, "Median latency %u ms, %u ms with a uniform draw",
+		     weighted_ms, uniform_ms);
+}
+
+ZTEST_SUITE(real_dtc_latency, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,196 @@
+/** @file test_real_perf.c
+ *
+ * @brief CPU time of the smtc_real hot paths, region by region
+ *
+ * The channel and data rate selection of every uplink and the parsing of the LinkADRReq and
+ * RxParamSetupReq downlinks are timed with the timing API and reported per call. The channel
+ * selection is also timed at each uplink data rate, and the region switch is checked against its
+ * bound. Built only with CONFIG_TIMING_FUNCTIONS, on a target: the CPU time of native_sim does not
+ * advance while the code runs.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2022 Irnas. All rights reserved.
+ */
+
+#include <string.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+
+#include <lr1mac_core.h>
+
+#include "mac_sim.h"
+
+/* Calls timed for each function */
+#define PRV_CALL_NB 1000
+
+/* Highest data rate timed */
+#define PRV_DR_MAX 15
+
+/* Bound of a region switch, the NVM write of the region in the RAM of the test HAL included */
+#define PRV_SWITCH_MAX_NS 1000000
+
+static const smtc_real_region_types_t prv_regions[] = {
+#if defined(REGION_EU_868)
+	SMTC_REAL_REGION_EU_868,
+#endif
+#if defined(REGION_AS_923)
+	SMTC_REAL_REGION_AS_923,
+#endif
+#if defined(REGION_US_915)
+	SMTC_REAL_REGION_US_915,
+#endif
+#if defined(REGION_AU_915)
+	SMTC_REAL_REGION_AU_915,
+#endif
+#if defined(REGION_CN_470)
+	SMTC_REAL_REGION_CN_470,
+#endif
+#if defined(REGION_CN_470_RP_1_0)
+	SMTC_REAL_REGION_CN_470_RP_1_0,
+#endif
+#if defined(REGION_WW2G4)
+	SMTC_REAL_REGION_WW2G4,
+#endif
+#if defined(REGION_IN_865)
+	SMTC_REAL_REGION_IN_865,
+#endif
+#if defined(REGION_KR_920)
+	SMTC_REAL_REGION_KR_920,
+#endif
+#if defined(REGION_RU_864)
+	SMTC_REAL_REGION_RU_864,
+#endif
+};
+
+static struct mac_sim prv_sim;
+
+static uint32_t prv_ns_per_call(timing_t *start, timing_t *end)
+{
+	return timing_cycles_to_ns(timing_cycles_get(start, end)) / PRV_CALL_NB;
+}
+
+static uint32_t prv_time_next_channel(void)
+{
+	timing_t start = timing_counter_get();
+	timing_t end;
+
+	for (uint32_t i = 0; i < PRV_CALL_NB; i++) {
+		smtc_real_get_next_channel(&prv_sim.mac);
+	}
+	end = timing_counter_get();
+
+	return prv_ns_per_call(&start, &end);
+}
+
+static uint32_t prv_time_next_dr(void)
+{
+	timing_t start = timing_counter_get();
+	timing_t end;
+
+	for (uint32_t i = 0; i < PRV_CALL_NB; i++) {
+		smtc_real_get_next_dr(&prv_sim.mac);
+	}
+	end = timing_counter_get();
+
+	return prv_ns_per_call(&start, &end);
+}
+
+static uint32_t prv_time_cmd(const uint8_t *cmd, uint8_t size)
+{
+	timing_t start;
+	timing_t end;
+
+	memcpy(prv_sim.mac.nwk_payload, cmd, size);
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < PRV_CALL_NB; i++) {
+		prv_sim.mac.nwk_payload_size = size;
+		lr1_stack_mac_cmd_parse(&prv_sim.mac);
+	}
+	end = timing_counter_get();
+
+	return prv_ns_per_call(&start, &end);
+}
+
+ZTEST(real_perf, test_hot_paths)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(prv_regions); i++) {
+		/* Current DR and power, all channels of the first ChMask block, NbTrans 1 */
+		uint8_t link_adr[] = {LINK_ADR_REQ, 0xFF, 0xFF, 0xFF, 0x01};
+		uint8_t rx_param[] = {RXPARRAM_SETUP_REQ, 0, 0, 0, 0};
+		uint32_t channel_ns;
+		uint32_t dr_ns;
+
+		mac_sim_init(&prv_sim, prv_regions[i]);
+		rx_param[1] = prv_sim.mac.rx2_data_rate;
+		mac_sim_freq_encode(&prv_sim, &rx_param[2], prv_sim.mac.rx2_frequency);
+
+		prv_sim.mac.tx_data_rate = prv_sim.mac.tx_data_rate_adr;
+		channel_ns = prv_time_next_channel();
+		dr_ns = prv_time_next_dr();
+
+		TC_PRINT("Region %2u: next channel %5u ns, next DR %5u ns, LinkADRReq %5u ns, "
+			 "RxParamSetupReq %5u ns\n",
+			 prv_regions[i], channel_ns, dr_ns,
+			 prv_time_cmd(link_adr, sizeof(link_adr)),
+			 prv_time_cmd(rx_param, sizeof(rx_param)));
+		zassert_equal(prv_sim.mac.tx_fopts_data[1], 0x07,
+			      "Region %u: RxParamSetupReq rejected", prv_regions[i]);
+	}
+}
+
+ZTEST(real_perf, test_next_channel)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(prv_regions); i++) {
+		mac_sim_init(&prv_sim, prv_regions[i]);
+
+		for (uint8_t dr = 0; dr <= PRV_DR_MAX; dr++) {
+			if ((smtc_real_is_tx_dr_valid(&prv_sim.mac, dr) != OKLORAWAN) ||
+			    (smtc_real_is_tx_dr_acceptable(&prv_sim.mac, dr, false) != OKLORAWAN)) {
+				continue;
+			}
+			prv_sim.mac.tx_data_rate = dr;
+			TC_PRINT("Region %2u DR%u: next channel %5u ns\n", prv_regions[i], dr,
+				 prv_time_next_channel());
+		}
+	}
+}
+
+ZTEST(real_perf, test_region_switch)
+{
+	for (size_t i = 1; i < ARRAY_SIZE(prv_regions); i++) {
+		timing_t start;
+		timing_t end;
+		uint32_t switch_ns;
+
+		mac_sim_init(&prv_sim, prv_regions[0]);
+		start = timing_counter_get();
+		for (uint32_t j = 0; j < PRV_CALL_NB; j++) {
+			lr1mac_core_switch_region(&prv_sim.mac, prv_regions[(j % 2 == 0) ? i : 0]);
+		}
+		end = timing_counter_get();
+		switch_ns = prv_ns_per_call(&start, &end);
+
+		TC_PRINT("Region %2u <-> %2u: switch %7u ns\n", prv_regions[0], prv_regions[i],
+			 switch_ns);
+		zassert_true(switch_ns <= PRV_SWITCH_MAX_NS, "Region %u: switch in %u ns",
+			     prv_regions[i], switch_ns);
+	}
+}
+
+static void *prv_setup(void)
+{
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+static void prv_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	timing_stop();
+}
+
+ZTEST_SUITE(real_perf, NULL, prv_setup, NULL, NULL, prv_teardown);
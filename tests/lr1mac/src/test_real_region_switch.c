@@ -0,0 +1,196 @@
+/** @file test_real_region_switch.c
+ *
+ * @brief Repeated EU868 / AS923 and EU868 / RU864 switches of a device crossing regulatory borders
+ *
+ * lr1mac_core_switch_region() must rebuild the channel plan of the new region, keep the keys, the
+ * DevNonce, the statistics and the duty cycle airtime of the EU868 bands, and write the NVM only
+ * once per region change. The RU864 bands take the place of EU868 bands without airtime.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2022 Irnas. All rights reserved.
+ */
+
+#include <string.h>
+
+#include <zephyr/ztest.h>
+
+#include <lr1mac_core.h>
+#include <smtc_secure_element.h>
+#include <test_hal.h>
+
+#include "mac_sim.h"
+
+/* Round trips between the two regions */
+#define PRV_SWITCH_NB 50
+
+/* Virtual time between two switches, the whole scenario stays within one duty cycle period */
+#define PRV_SWITCH_INTERVAL_MS 30000
+
+/* Airtime sent in the 868.0 - 868.6 MHz band before the first switch */
+#define PRV_EU_TOA_MS 10000
+
+/* Airtime sent in the 868.7 - 869.2 MHz band after the first switch to RU864 */
+#define PRV_RU_TOA_MS 1000
+
+/* Data rate of the default channels of both regions */
+#define PRV_DR 2
+
+static const uint32_t prv_eu_hz[] = {868100000, 868300000, 868500000};
+static const uint32_t prv_as_hz[] = {923200000, 923400000};
+static const uint32_t prv_ru_hz[] = {868900000, 869100000};
+
+static const uint8_t prv_key[SMTC_SE_KEY_SIZE] = {0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6,
+						   0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C};
+
+static struct mac_sim prv_sim;
+
+static void prv_encrypt(uint8_t out[SMTC_SE_KEY_SIZE])
+{
+	static const uint8_t block[SMTC_SE_KEY_SIZE] = {0};
+
+	zassert_equal(smtc_secure_element_aes_encrypt(block, sizeof(block), SMTC_SE_APP_KEY, out),
+		      SMTC_SE_RC_SUCCESS, "Encryption failed");
+}
+
+/* Duty cycle band of a frequency, in the current region */
+static uint8_t prv_band(uint32_t freq_hz)
+{
+	for (uint8_t band = 0; band < prv_sim.dtc.number_of_bands; band++) {
+		if ((freq_hz >= prv_sim.dtc.bands[band].freq_min) &&
+		    (freq_hz < prv_sim.dtc.bands[band].freq_max)) {
+			return band;
+		}
+	}
+	zassert_unreachable("No band for %u Hz", freq_hz);
+	return 0;
+}
+
+static int32_t prv_available(uint32_t freq_hz)
+{
+	smtc_duty_cycle_update(&prv_sim.dtc);
+	return smtc_duty_cycle_band_get_available_toa_ms(&prv_sim.dtc, prv_band(freq_hz));
+}
+
+/* Airtime counted in the band of a frequency, the bands of both regions differ in duty cycle */
+static int32_t prv_used(uint32_t freq_hz)
+{
+	uint8_t band = prv_band(freq_hz);
+
+	return SMTC_DTC_PERIOD_MS / prv_sim.dtc.bands[band].duty_cycle_regulation -
+	       prv_available(freq_hz);
+}
+
+static void prv_switch(smtc_real_region_types_t region, const uint32_t *freq_hz, uint8_t nb)
+{
+	uint32_t lr1mac_stores = test_hal_context_store_count(CONTEXT_LR1MAC);
+	uint32_t uplink_hz[MAC_SIM_CHANNEL_NB_MAX];
+	mac_context_t ctx;
+
+	zassert_equal(lr1mac_core_switch_region(&prv_sim.mac, region), OKLORAWAN,
+		      "Switch to region %u failed", region);
+	zassert_equal(prv_sim.real.region_type, region, "Region %u not set", region);
+
+	/* The region is stored, so a reset restarts in it */
+	zassert_equal(test_hal_context_store_count(CONTEXT_LR1MAC), lr1mac_stores + 1,
+		      "Region %u: %u LR1MAC context stores", region,
+		      test_hal_context_store_count(CONTEXT_LR1MAC) - lr1mac_stores);
+	smtc_modem_hal_context_restore(CONTEXT_LR1MAC, (uint8_t *)&ctx, sizeof(ctx));
+	zassert_equal(ctx.region_type, region, "Region %u not stored", region);
+
+	/* Switching to the current region does nothing */
+	zassert_equal(lr1mac_core_switch_region(&prv_sim.mac, region), OKLORAWAN,
+		      "Switch to the current region failed");
+	zassert_equal(test_hal_context_store_count(CONTEXT_LR1MAC), lr1mac_stores + 1,
+		      "Region %u: context stored by a switch to the current region", region);
+
+	zassert_equal(mac_sim_uplink_freqs(&prv_sim, PRV_DR, uplink_hz), nb,
+		      "Region %u: wrong number of channels", region);
+	zassert_mem_equal(uplink_hz, freq_hz, nb * sizeof(freq_hz[0]), "Region %u: wrong channels",
+			  region);
+}
+
+ZTEST(real_region_switch, test_eu_868_as_923)
+{
+	uint8_t encrypted[SMTC_SE_KEY_SIZE];
+	uint8_t encrypted_after[SMTC_SE_KEY_SIZE];
+	uint32_t devnonce_stores;
+	uint32_t se_stores;
+	uint16_t dev_nonce;
+	int32_t eu_toa_ms;
+
+	mac_sim_init(&prv_sim, SMTC_REAL_REGION_EU_868);
+	zassert_equal(smtc_secure_element_set_key(SMTC_SE_APP_KEY, prv_key), SMTC_SE_RC_SUCCESS,
+		      "AppKey not set");
+	prv_encrypt(encrypted);
+	prv_sim.mac.nb_of_reset = 7;
+	dev_nonce = prv_sim.mac.dev_nonce;
+
+	smtc_duty_cycle_sum(&prv_sim.dtc, prv_eu_hz[0], PRV_EU_TOA_MS);
+	eu_toa_ms = prv_available(prv_eu_hz[0]);
+
+	devnonce_stores = test_hal_context_store_count(CONTEXT_DEVNONCE);
+	se_stores = test_hal_context_store_count(CONTEXT_SECURE_ELEMENT);
+
+	for (uint32_t i = 0; i < PRV_SWITCH_NB; i++) {
+		test_hal_advance_ms(PRV_SWITCH_INTERVAL_MS);
+		prv_switch(SMTC_REAL_REGION_AS_923, prv_as_hz, ARRAY_SIZE(prv_as_hz));
+		zassert_false(smtc_real_is_dtc_supported(&prv_sim.mac),
+			      "AS923 duty cycle enforced");
+
+		test_hal_advance_ms(PRV_SWITCH_INTERVAL_MS);
+		prv_switch(SMTC_REAL_REGION_EU_868, prv_eu_hz, ARRAY_SIZE(prv_eu_hz));
+
+		/* The airtime sent in EU868 is still counted */
+		zassert_equal(prv_available(prv_eu_hz[0]), eu_toa_ms,
+			      "Switch %u: EU868 airtime lost", i);
+	}
+
+	prv_encrypt(encrypted_after);
+	zassert_mem_equal(encrypted_after, encrypted, sizeof(encrypted), "AppKey changed");
+	zassert_equal(prv_sim.mac.dev_nonce, dev_nonce, "DevNonce changed");
+	zassert_equal(prv_sim.mac.nb_of_reset, 7, "Reset count changed");
+	zassert_equal(test_hal_context_store_count(CONTEXT_DEVNONCE), devnonce_stores,
+		      "DevNonce context stored");
+	zassert_equal(test_hal_context_store_count(CONTEXT_SECURE_ELEMENT), se_stores,
+		      "Secure element context stored");
+}
+
+ZTEST(real_region_switch, test_eu_868_ru_864)
+{
+	int32_t eu_toa_ms;
+
+	mac_sim_init(&prv_sim, SMTC_REAL_REGION_EU_868);
+	smtc_duty_cycle_sum(&prv_sim.dtc, prv_eu_hz[0], PRV_EU_TOA_MS);
+	eu_toa_ms = prv_available(prv_eu_hz[0]);
+
+	for (uint32_t i = 0; i < PRV_SWITCH_NB; i++) {
+		test_hal_advance_ms(PRV_SWITCH_INTERVAL_MS);
+		prv_switch(SMTC_REAL_REGION_RU_864, prv_ru_hz, ARRAY_SIZE(prv_ru_hz));
+		zassert_true(smtc_real_is_dtc_supported(&prv_sim.mac), "RU864 duty cycle not enforced");
+
+		/* The 868.7 - 869.2 MHz band of RU864 is also an EU868 band */
+		if (i == 0) {
+			smtc_duty_cycle_sum(&prv_sim.dtc, prv_ru_hz[0], PRV_RU_TOA_MS);
+		}
+		zassert_equal(prv_used(prv_ru_hz[0]), PRV_RU_TOA_MS, "Switch %u: RU864 airtime lost",
+			      i);
+
+		test_hal_advance_ms(PRV_SWITCH_INTERVAL_MS);
+		prv_switch(SMTC_REAL_REGION_EU_868, prv_eu_hz, ARRAY_SIZE(prv_eu_hz));
+		zassert_equal(prv_available(prv_eu_hz[0]), eu_toa_ms,
+			      "Switch %u: EU868 airtime lost", i);
+		zassert_equal(prv_used(prv_ru_hz[0]), PRV_RU_TOA_MS,
+			      "Switch %u: 868.7 - 869.2 MHz airtime lost", i);
+	}
+}
+
+ZTEST(real_region_switch, test_unsupported_region)
+{
+	mac_sim_init(&prv_sim, SMTC_REAL_REGION_EU_868);
+
+	zassert_equal(lr1mac_core_switch_region(&prv_sim.mac, SMTC_REAL_REGION_UNKNOWN),
+		      ERRORLORAWAN, "Unknown region accepted");
+	zassert_equal(prv_sim.real.region_type, SMTC_REAL_REGION_EU_868, "Region changed");
+}
+
+ZTEST_SUITE(real_region_switch, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,489 @@
+/** @file rp_sim.c
+ *
+ * @brief Radio planner simulation on the virtual time HAL and the mock radio
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2022 Irnas. All rights reserved.
+ */
+
+#include "rp_sim.h"
+
+#include <string.h>
+
+#include <zephyr/ztest.h>
+
+#include <test_hal.h>
+#include <test_radio.h>
+
+/* Time of the virtual clock at init, in 100 us */
+#define PRV_START_100US 10000
+
+/* An asap task waiting longer than this is turned into a schedule task by the planner, in ms */
+#define PRV_ASAP_TO_SCHEDULE_MS RP_TASK_ASAP_TO_SCHEDULE_TRIG_TIME
+
+static struct rp_sim *prv_sim;
+
+static uint8_t prv_payload[RP_NB_HOOKS][255];
+
+/**
+ * @brief Get the margin of the planner, the time before its start a task can be launched, in 100 us
+ */
+static uint64_t prv_margin_100us(const struct rp_sim *sim)
+{
+	return sim->rp.margin_delay_100us;
+}
+
+static bool prv_is_rx(rp_task_types_t type)
+{
+	return (type == RP_TASK_TYPE_RX_LORA) || (type == RP_TASK_TYPE_RX_FSK);
+}
+
+/**
+ * @brief Check if the planner may have turned an asap task into a schedule one
+ */
+static bool prv_waited_too_long(const struct rp_sim_task *task)
+{
+	return (task->request.state == RP_TASK_STATE_ASAP) &&
+	       (test_hal_now_100us() - task->enqueue_100us >
+		(uint64_t)PRV_ASAP_TO_SCHEDULE_MS * 10);
+}
+
+/**
+ * @brief Get the time a task holds or claims the radio, in 100 us
+ *
+ * A launched task holds the radio from its first launch to its end, a queued schedule task claims
+ * it over its planned window and a queued asap task from its earliest start for its duration.
+ */
+static void prv_window(const struct rp_sim_task *task, uint64_t *lo, uint64_t *hi)
+{
+	uint64_t start_100us = (uint64_t)task->request.start_ms * 10;
+	uint64_t last_100us = task->ended ? task->end_100us : test_hal_now_100us();
+
+	if (task->launch_nb > 0) {
+		*lo = task->launch_100us;
+		*hi = MAX(last_100us,
+			  task->launch_100us + (uint64_t)task->request.duration_ms * 10);
+	} else if (task->request.state == RP_TASK_STATE_SCHEDULE) {
+		*lo = start_100us;
+		*hi = start_100us + (uint64_t)task->request.duration_ms * 10;
+	} else {
+		*lo = MAX(start_100us, task->enqueue_100us);
+		*hi = last_100us + (uint64_t)task->request.duration_ms * 10;
+	}
+}
+
+/**
+ * @brief Check that the abort of a task is caused by a higher priority task on the radio or
+ * claiming it over the window of the aborted task
+ */
+static void prv_check_abort(struct rp_sim *sim, const struct rp_sim_task *task)
+{
+	uint64_t slack = prv_margin_100us(sim) + 20;
+	uint64_t lo;
+	uint64_t hi;
+
+	prv_window(task, &lo, &hi);
+	lo = (lo > slack) ? lo - slack : 0;
+	hi += slack;
+
+	for (uint32_t i = 0; i < sim->task_nb; i++) {
+		const struct rp_sim_task *other = &sim->tasks[i];
+		uint64_t other_lo;
+		uint64_t other_hi;
+
+		if ((other == task) || (other->priority >= task->priority) ||
+		    (other->enqueue_100us > task->end_100us)) {
+			continue;
+		}
+		prv_window(other, &other_lo, &other_hi);
+		if ((other_lo <= hi) && (other_hi >= lo)) {
+			return;
+		}
+	}
+
+	zassert_unreachable("Task %u of hook %u aborted at %llu without a higher priority conflict",
+			    (uint32_t)(task - sim->tasks), task->request.hook_id,
+			    (unsigned long long)task->end_100us);
+}
+
+/**
+ * @brief Check if a queued task of the planner overlaps a higher priority queued or running task,
+ * tasks closer than the launch margin overlap
+ */
+static bool prv_rp_is_blocked(const radio_planner_t *rp, uint8_t id, uint32_t now)
+{
+	const rp_task_t *task = &rp->tasks[id];
+
+	for (uint8_t i = 0; i < RP_NB_HOOKS; i++) {
+		const rp_task_t *other = &rp->tasks[i];
+		uint32_t task_end_ms =
+			task->start_time_ms + task->duration_time_ms + rp->margin_delay;
+		uint32_t other_end_ms =
+			other->start_time_ms + other->duration_time_ms + rp->margin_delay;
+
+		if ((i == id) || (other->state > RP_TASK_STATE_RUNNING) ||
+		    (other->priority >= task->priority) ||
+		    ((other->state == RP_TASK_STATE_SCHEDULE) &&
+		     ((int32_t)(other->start_time_ms - now) < 0))) {
+			continue;
+		}
+		if (((int32_t)(other->start_time_ms - task_end_ms) <= 0) &&
+		    ((int32_t)(task->start_time_ms - other_end_ms) <= 0)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * @brief Check that the launched task does not delay a higher priority queued task
+ *
+ * A lower priority task goes first only if it ends a margin before the start of every higher
+ * priority task which is not itself blocked by a task of an even higher priority.
+ */
+static void prv_check_launch_order(const radio_planner_t *rp, uint8_t id, uint32_t now)
+{
+	const rp_task_t *task = &rp->tasks[id];
+	uint32_t end = task->start_time_ms + task->duration_time_ms;
+
+	for (uint8_t i = 0; i < RP_NB_HOOKS; i++) {
+		const rp_task_t *other = &rp->tasks[i];
+
+		if ((i == id) || (other->state > RP_TASK_STATE_ASAP) ||
+		    (other->priority >= task->priority) ||
+		    ((int32_t)(other->start_time_ms - now) < 0)) {
+			continue;
+		}
+		zassert_true(((int32_t)(end + rp->margin_delay - other->start_time_ms) < 0) ||
+				     prv_rp_is_blocked(rp, i, now),
+			     "Hook %u (priority %u) launched at %u ms until %u ms before hook %u "
+			     "(priority %u) at %u ms",
+			     id, task->priority, now, end, i, other->priority,
+			     other->start_time_ms);
+	}
+}
+
+/**
+ * @brief Launch callback of every task: check the launch, then start the radio operation
+ */
+static void prv_launch(void *context)
+{
+	struct rp_sim *sim = prv_sim;
+	radio_planner_t *rp = context;
+	uint8_t id = rp->radio_task_id;
+	const rp_task_t *rp_task = &rp->tasks[id];
+	int32_t index = sim->hook_task[id];
+	struct rp_sim_task *task;
+	uint64_t now = test_hal_now_100us();
+	uint32_t now_ms = smtc_modem_hal_get_time_in_ms();
+	ralf_params_lora_t *params;
+
+	zassert_true(&sim->rp == rp, "Launch from an unknown planner");
+	zassert_not_equal(index, RP_SIM_NONE, "Launch of idle hook %u", id);
+	task = &sim->tasks[index];
+
+	zassert_equal(rp_task->state, RP_TASK_STATE_RUNNING, "Hook %u launched in state %u", id,
+		      rp_task->state);
+	zassert_false(task->ended, "Hook %u launched after its end", id);
+	zassert_true((task->launch_nb == 0) || task->request.suspendable,
+		     "Hook %u launched again without being suspendable", id);
+	zassert_true(now + prv_margin_100us(sim) >= (uint64_t)rp_task->start_time_ms * 10,
+		     "Hook %u launched at %llu, earlier than the margin before %u ms", id,
+		     (unsigned long long)now, rp_task->start_time_ms);
+	if ((task->launch_nb == 0) && (task->request.state == RP_TASK_STATE_SCHEDULE)) {
+		zassert_true(now_ms <= task->request.start_ms,
+			     "Schedule hook %u launched at %u ms, after its start at %u ms", id,
+			     now_ms, task->request.start_ms);
+	}
+	prv_check_launch_order(rp, id, now_ms);
+
+	if (sim->running != RP_SIM_NONE) {
+		struct rp_sim_task *preempted = &sim->tasks[sim->running];
+		uint8_t preempted_id = preempted->request.hook_id;
+		rp_task_states_t expected = preempted->request.suspendable ? RP_TASK_STATE_ASAP
+									   : RP_TASK_STATE_ABORTED;
+
+		zassert_not_equal(preempted_id, id, "Hook %u launched while running", id);
+		zassert_equal(rp->tasks[preempted_id].state, expected,
+			      "Hook %u preempted by hook %u left in state %u", preempted_id, id,
+			      rp->tasks[preempted_id].state);
+		sim->busy_100us += now - sim->running_start_100us;
+		sim->preemption_nb++;
+	}
+
+	if (task->launch_nb == 0) {
+		task->launch_100us = now;
+	}
+	task->launch_nb++;
+	sim->launch_nb++;
+	sim->running = index;
+	sim->running_start_100us = now;
+
+	/* The operation starts at the start of the task, the planner waits for it with
+	 * rp_task_wait_start() on a real target
+	 */
+	task->op_end_100us = MAX(now, (uint64_t)rp_task->start_time_ms * 10) +
+			     (uint64_t)rp_task->duration_time_ms * 10;
+
+	if (prv_is_rx(task->request.type)) {
+		params = &rp->radio_params[id].rx.lora;
+		zassert_ok(ralf_setup_lora(rp->radio, params), "Rx setup failed");
+		zassert_ok(ral_set_rx(&rp->radio->ral, rp->radio_params[id].rx.timeout_in_ms),
+			   "Rx start failed");
+		rp_stats_set_rx_timestamp(&rp->stats, now_ms);
+		if (task->request.rx_packet) {
+			test_radio_set_rx_packet(prv_payload[id], 12, -60, 8);
+			test_radio_irq_at(RAL_IRQ_RX_DONE, task->op_end_100us);
+		} else {
+			test_radio_irq_at(RAL_IRQ_RX_TIMEOUT, task->op_end_100us);
+		}
+	} else {
+		params = &rp->radio_params[id].tx.lora;
+		zassert_ok(ralf_setup_lora(rp->radio, params), "Tx setup failed");
+		zassert_ok(ral_set_pkt_payload(&rp->radio->ral, rp->payload[id],
+					       rp->payload_size[id]),
+			   "Tx payload failed");
+		zassert_ok(ral_set_tx(&rp->radio->ral), "Tx start failed");
+		rp_stats_set_tx_timestamp(&rp->stats, now_ms);
+		test_radio_irq_at(RAL_IRQ_TX_DONE, task->op_end_100us);
+	}
+}
+
+/**
+ * @brief Hook callback of every hook: check the end of the task, then hand it to the test
+ */
+static void prv_hook_callback(void *context)
+{
+	struct rp_sim *sim = prv_sim;
+	uint8_t id = (uint8_t)((int32_t *)context - sim->hook_task);
+	int32_t index;
+	struct rp_sim_task *task;
+	uint32_t irq_timestamp_ms;
+	rp_status_t status;
+
+	zassert_true(id < RP_NB_HOOKS, "Callback of an unknown hook");
+	index = sim->hook_task[id];
+	zassert_not_equal(index, RP_SIM_NONE, "Callback of idle hook %u", id);
+	task = &sim->tasks[index];
+	zassert_false(task->ended, "Hook %u ended twice", id);
+
+	rp_get_status(&sim->rp, id, &irq_timestamp_ms, &status);
+	task->ended = true;
+	task->status = status;
+	task->end_100us = test_hal_now_100us();
+	sim->end_nb++;
+
+	if (sim->running == index) {
+		sim->busy_100us += task->end_100us - sim->running_start_100us;
+		sim->running = RP_SIM_NONE;
+	}
+
+	if (status == RP_STATUS_TASK_ABORTED) {
+		if (!task->abort_requested && !prv_waited_too_long(task)) {
+			prv_check_abort(sim, task);
+		}
+	} else {
+		zassert_equal(task->launch_nb > 0, true, "Hook %u ended without launch", id);
+		zassert_equal(task->end_100us, task->op_end_100us,
+			      "Hook %u ended at %llu instead of %llu", id,
+			      (unsigned long long)task->end_100us,
+			      (unsigned long long)task->op_end_100us);
+		if (prv_is_rx(task->request.type)) {
+			zassert_equal(status,
+				      task->request.rx_packet ? RP_STATUS_RX_PACKET
+							      : RP_STATUS_RX_TIMEOUT,
+				      "Hook %u rx ended with status %u", id, status);
+		} else {
+			zassert_equal(status, RP_STATUS_TX_DONE,
+				      "Hook %u tx ended with status %u", id, status);
+		}
+	}
+
+	sim->hook_task[id] = RP_SIM_NONE;
+	if (sim->on_end) {
+		sim->on_end(sim, task);
+	}
+}
+
+void rp_sim_init(struct rp_sim *sim, uint32_t seed)
+{
+	memset(sim, 0, sizeof(*sim));
+	prv_sim = sim;
+
+	test_hal_reset(PRV_START_100US, seed);
+	test_radio_reset();
+
+	rp_init(&sim->rp, &test_radio);
+	smtc_modem_hal_irq_config_radio_irq(rp_radio_irq_callback, &sim->rp);
+
+	for (uint8_t id = 0; id < RP_NB_HOOKS; id++) {
+		sim->hook_task[id] = RP_SIM_NONE;
+		if (id < RP_HOOK_ID_MAX) {
+			zassert_ok(rp_hook_init(&sim->rp, id, prv_hook_callback,
+						&sim->hook_task[id]),
+				   "Hook %u init failed", id);
+		}
+	}
+	sim->running = RP_SIM_NONE;
+}
+
+uint8_t rp_sim_alloc_hook(struct rp_sim *sim, rp_hook_priority_class_t priority_class)
+{
+	uint8_t next = RP_HOOK_ID_MAX;
+	uint8_t id;
+
+	/* The planner allocates the first free hook, the context of its callback gives its id */
+	while ((next < RP_NB_HOOKS) && (sim->rp.hook_callbacks[next] != NULL)) {
+		next++;
+	}
+	zassert_true(next < RP_NB_HOOKS, "No hook left");
+	zassert_ok(rp_hook_alloc(&sim->rp, priority_class, prv_hook_callback,
+				 &sim->hook_task[next], &id),
+		   "Hook allocation failed");
+	zassert_equal(id, next, "Hook %u allocated instead of %u", id, next);
+
+	return id;
+}
+
+uint32_t rp_sim_now_ms(void)
+{
+	return smtc_modem_hal_get_time_in_ms();
+}
+
+rp_hook_status_t rp_sim_enqueue(struct rp_sim *sim, const struct rp_sim_request *request,
+				struct rp_sim_task **task)
+{
+	uint8_t id = request->hook_id;
+	int32_t previous = sim->hook_task[id];
+	int32_t index = sim->task_nb;
+	struct rp_sim_task *sim_task = &sim->tasks[index];
+	rp_radio_params_t params = {0};
+	rp_task_t rp_task = {0};
+	rp_hook_status_t status;
+
+	zassert_true(sim->task_nb < RP_SIM_TASK_NB_MAX, "Too many tasks");
+	zassert_true((previous == RP_SIM_NONE) ||
+			     (sim->rp.tasks[id].state == RP_TASK_STATE_RUNNING),
+		     "Hook %u already has a queued task", id);
+
+	params.pkt_type = RAL_PKT_TYPE_LORA;
+	params.tx.lora = (ralf_params_lora_t){
+		.mod_params = {.sf = RAL_LORA_SF7,
+			       .bw = RAL_LORA_BW_125_KHZ,
+			       .cr = RAL_LORA_CR_4_5},
+		.pkt_params = {.preamble_len_in_symb = 8,
+			       .header_type = RAL_LORA_PKT_EXPLICIT,
+			       .pld_len_in_bytes = 12,
+			       .crc_is_on = true},
+		.rf_freq_in_hz = 868100000,
+		.output_pwr_in_dbm = 14,
+		.sync_word = 0x34,
+	};
+	params.rx.lora = params.tx.lora;
+	params.rx.lora.pkt_params.crc_is_on = false;
+	params.rx.lora.pkt_params.invert_iq_is_on = true;
+	params.rx.timeout_in_ms = request->duration_ms;
+
+	rp_task.hook_id = id;
+	rp_task.type = request->type;
+	rp_task.launch_task_callbacks = prv_launch;
+	rp_task.state = request->state;
+	rp_task.schedule_task_low_priority = request->low_priority;
+	rp_task.suspendable = request->suspendable;
+	rp_task.start_time_ms = request->start_ms;
+	rp_task.duration_time_ms = request->duration_ms;
+
+	memset(sim_task, 0, sizeof(*sim_task));
+	sim_task->request = *request;
+	sim_task->enqueue_100us = test_hal_now_100us();
+	sim_task->priority = UINT8_MAX;
+	if (previous == RP_SIM_NONE) {
+		/* Recorded before the enqueue, the planner may launch the task right away */
+		sim->hook_task[id] = index;
+		sim->task_nb++;
+	}
+
+	status = rp_task_enqueue(&sim->rp, &rp_task, prv_payload[id], sizeof(prv_payload[id]),
+				 &params);
+	if (status != RP_HOOK_STATUS_OK) {
+		if (previous == RP_SIM_NONE) {
+			sim->hook_task[id] = RP_SIM_NONE;
+			sim->task_nb--;
+		}
+		return status;
+	}
+	zassert_equal(previous, RP_SIM_NONE, "Hook %u enqueued while running", id);
+
+	/* The priority is kept by the planner while the task is queued or running */
+	if (!sim_task->ended) {
+		sim_task->priority = sim->rp.tasks[id].priority;
+	}
+	if (task) {
+		*task = sim_task;
+	}
+
+	return status;
+}
+
+void rp_sim_abort(struct rp_sim *sim, uint8_t hook_id)
+{
+	int32_t index = sim->hook_task[hook_id];
+
+	if (index != RP_SIM_NONE) {
+		sim->tasks[index].abort_requested = true;
+	}
+	zassert_ok(rp_task_abort(&sim->rp, hook_id), "Abort of hook %u failed", hook_id);
+}
+
+void rp_sim_run_ms(struct rp_sim *sim, uint32_t ms)
+{
+	ARG_UNUSED(sim);
+
+	test_hal_advance_ms(ms);
+}
+
+void rp_sim_run_until_idle(struct rp_sim *sim, uint32_t limit_ms)
+{
+	uint64_t limit_100us = test_hal_now_100us() + (uint64_t)limit_ms * 10;
+
+	while ((sim->end_nb < sim->task_nb) && test_hal_run_next(limit_100us)) {
+	}
+
+	zassert_equal(sim->end_nb, sim->task_nb, "%u tasks left after %u ms",
+		      sim->task_nb - sim->end_nb, limit_ms);
+}
+
+void rp_sim_check_idle(struct rp_sim *sim)
+{
+	struct test_radio_stats stats;
+	uint64_t standby_max_100us = (RP_TASK_COALESCE_THRESHOLD_MS + 1) * 10;
+
+	/* Let the planner put the radio to sleep */
+	test_hal_run_until(test_hal_now_100us() + standby_max_100us);
+	test_radio_get_stats(&stats);
+
+	for (uint32_t i = 0; i < sim->task_nb; i++) {
+		zassert_true(sim->tasks[i].ended, "Task %u of hook %u never ended", i,
+			     sim->tasks[i].request.hook_id);
+	}
+	for (uint8_t id = 0; id < RP_NB_HOOKS; id++) {
+		zassert_equal(sim->hook_task[id], RP_SIM_NONE, "Hook %u left busy", id);
+		zassert_true(sim->rp.tasks[id].state >= RP_TASK_STATE_ABORTED,
+			     "Hook %u left in state %u", id, sim->rp.tasks[id].state);
+	}
+	zassert_equal(sim->running, RP_SIM_NONE, "Task left on the radio");
+	zassert_equal(test_radio_get_mode(), TEST_RADIO_MODE_SLEEP, "Idle radio not asleep");
+	zassert_equal(sim->rp.stats.rp_error, 0, "%u planner errors", sim->rp.stats.rp_error);
+
+	/* The radio is on for the tasks and for the short stretches it is kept warm between them */
+	zassert_true(stats.standby_max_100us <= standby_max_100us,
+		     "Radio kept in standby for %llu x 100 us",
+		     (unsigned long long)stats.standby_max_100us);
+	zassert_true(stats.on_100us >= sim->busy_100us, "Radio on for %llu < busy %llu x 100 us",
+		     (unsigned long long)stats.on_100us, (unsigned long long)sim->busy_100us);
+	zassert_true(stats.on_100us <= sim->busy_100us + (sim->end_nb + sim->preemption_nb) *
+								 standby_max_100us,
+		     "Radio on for %llu x 100 us, busy for %llu",
+		     (unsigned long long)stats.on_100us, (unsigned long long)sim->busy_100us);
+}
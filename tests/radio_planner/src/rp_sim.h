@@ -0,0 +1,133 @@
+/** @file rp_sim.h
+ *
+ * @brief Radio planner simulation on the virtual time HAL and the mock radio
+ *
+ * The simulation plays the part of the modem services: it enqueues the tasks, radio operations
+ * are started by its launch callback and end with the irq of the mock radio. Every launch and end
+ * is checked against the radio planner rules as it happens.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2022 Irnas. All rights reserved.
+ */
+
+#ifndef RP_SIM_H
+#define RP_SIM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <radio_planner.h>
+
+/* Maximum number of tasks enqueued in a simulation */
+#define RP_SIM_TASK_NB_MAX 2048
+
+/* No task */
+#define RP_SIM_NONE -1
+
+struct rp_sim_request {
+	uint8_t hook_id;
+	rp_task_types_t type;
+	/* RP_TASK_STATE_SCHEDULE or RP_TASK_STATE_ASAP */
+	rp_task_states_t state;
+	bool suspendable;
+	bool low_priority;
+	/* An rx task receives a packet instead of timing out */
+	bool rx_packet;
+	/* Start time, the earliest one of an asap task, in ms */
+	uint32_t start_ms;
+	uint32_t duration_ms;
+};
+
+struct rp_sim_task {
+	struct rp_sim_request request;
+	/* Priority given by the planner */
+	uint8_t priority;
+	uint64_t enqueue_100us;
+	/* Number of launches, above 1 if the task has been suspended */
+	uint32_t launch_nb;
+	/* First launch */
+	uint64_t launch_100us;
+	/* End of the radio operation of the last launch */
+	uint64_t op_end_100us;
+	/* Time of the end callback */
+	uint64_t end_100us;
+	bool ended;
+	bool abort_requested;
+	rp_status_t status;
+};
+
+struct rp_sim {
+	radio_planner_t rp;
+	struct rp_sim_task tasks[RP_SIM_TASK_NB_MAX];
+	uint32_t task_nb;
+	/* Task of each hook, RP_SIM_NONE if the hook is idle */
+	int32_t hook_task[RP_NB_HOOKS];
+	/* Task on the radio */
+	int32_t running;
+	uint64_t running_start_100us;
+	/* Time spent by the tasks on the radio, in 100 us */
+	uint64_t busy_100us;
+	uint32_t launch_nb;
+	uint32_t end_nb;
+	uint32_t preemption_nb;
+	/* Called at the end of each task, can enqueue the next one */
+	void (*on_end)(struct rp_sim *sim, struct rp_sim_task *task);
+};
+
+/**
+ * @brief Reset the HAL, the mock radio and the radio planner, then initialize its hooks
+ *
+ * @param[in] sim Simulation, it is used by the callbacks until the next init
+ * @param[in] seed Seed of the HAL random numbers
+ */
+void rp_sim_init(struct rp_sim *sim, uint32_t seed);
+
+/**
+ * @brief Allocate a dynamic hook of the radio planner, its tasks are played like the other ones
+ *
+ * @param[in] sim Simulation
+ * @param[in] priority_class Priority class of the hook
+ *
+ * @return Id of the hook
+ */
+uint8_t rp_sim_alloc_hook(struct rp_sim *sim, rp_hook_priority_class_t priority_class);
+
+/**
+ * @brief Get the time of the radio planner, in ms
+ */
+uint32_t rp_sim_now_ms(void);
+
+/**
+ * @brief Enqueue a task
+ *
+ * @param[in] sim Simulation
+ * @param[in] request Task to enqueue
+ * @param[out] task Task in the simulation if it has been enqueued, can be NULL
+ *
+ * @return Status of rp_task_enqueue()
+ */
+rp_hook_status_t rp_sim_enqueue(struct rp_sim *sim, const struct rp_sim_request *request,
+				struct rp_sim_task **task);
+
+/**
+ * @brief Abort the task of a hook
+ */
+void rp_sim_abort(struct rp_sim *sim, uint8_t hook_id);
+
+/**
+ * @brief Run the simulation for @p ms milliseconds
+ */
+void rp_sim_run_ms(struct rp_sim *sim, uint32_t ms);
+
+/**
+ * @brief Run the simulation until every task has ended, at most @p limit_ms milliseconds
+ */
+void rp_sim_run_until_idle(struct rp_sim *sim, uint32_t limit_ms);
+
+/**
+ * @brief Check the state of an idle simulation: every task ended once, the radio sleeps and it
+ * has only been on for the tasks and the short standby stretches between them
+ */
+void rp_sim_check_idle(struct rp_sim *sim);
+
+#endif /* RP_SIM_H */
@@ -0,0 +1,159 @@
+/** @file test_random.c
+ *
+ * @brief Radio planner on randomized schedules
+ *
+ * Each seed plays a random mix of the tasks of the modem services: uplinks followed by their RX1
+ * window, listen before talk, class B beacons and ping slots, user tasks, the class C continuous
+ * reception and aborts. The simulation checks the launch order, the aborts and the radio on time
+ * of every task as it runs.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2022 Irnas. All rights reserved.
+ */
+
+#include <zephyr/ztest.h>
+
+#include <test_hal.h>
+#include <test_radio.h>
+
+#include "rp_sim.h"
+
+#define PRV_SEED_NB   200
+#define PRV_ACTION_NB 300
+
+/* Time left to the tasks still queued at the end of a seed, in ms */
+#define PRV_DRAIN_MS (RP_TASK_ASAP_TO_SCHEDULE_TRIG_TIME * 2)
+
+static struct rp_sim prv_sim;
+
+static const uint8_t prv_hooks[] = {
+	RP_HOOK_ID_SUSPEND,	      RP_HOOK_ID_LR1MAC_STACK,	     RP_HOOK_ID_LBT,
+	RP_HOOK_ID_RTC_COMPENSATION,  RP_HOOK_ID_CLASS_B_BEACON,     RP_HOOK_ID_CLASS_B_PING_SLOT,
+	RP_HOOK_ID_USER_SUSPEND_1,    RP_HOOK_ID_USER_SUSPEND_2,     RP_HOOK_ID_CLASS_C,
+};
+
+static uint32_t prv_random(uint32_t min, uint32_t max)
+{
+	return smtc_modem_hal_get_random_nb_in_range(min, max);
+}
+
+static bool prv_chance(uint32_t percent)
+{
+	return prv_random(0, 99) < percent;
+}
+
+/**
+ * @brief Open the RX1 window one second after each uplink of the stack
+ */
+static void prv_on_end(struct rp_sim *sim, struct rp_sim_task *task)
+{
+	struct rp_sim_request rx1 = {
+		.hook_id = RP_HOOK_ID_LR1MAC_STACK,
+		.type = RP_TASK_TYPE_RX_LORA,
+		.state = RP_TASK_STATE_SCHEDULE,
+		.rx_packet = prv_chance(20),
+		.start_ms = (uint32_t)(task->end_100us / 10) + 1000,
+		.duration_ms = prv_random(10, 60),
+	};
+
+	if ((task->request.hook_id == RP_HOOK_ID_LR1MAC_STACK) &&
+	    (task->status == RP_STATUS_TX_DONE)) {
+		zassert_equal(rp_sim_enqueue(sim, &rx1, NULL), RP_HOOK_STATUS_OK,
+			      "RX1 enqueue failed");
+	}
+}
+
+static struct rp_sim_request prv_request(uint8_t hook_id)
+{
+	uint32_t now = rp_sim_now_ms();
+	struct rp_sim_request request = {
+		.hook_id = hook_id,
+		.type = prv_chance(50) ? RP_TASK_TYPE_TX_LORA : RP_TASK_TYPE_RX_LORA,
+		.state = prv_chance(50) ? RP_TASK_STATE_SCHEDULE : RP_TASK_STATE_ASAP,
+		.duration_ms = prv_random(20, 400),
+	};
+
+	switch (hook_id) {
+	case RP_HOOK_ID_LR1MAC_STACK:
+		request.type = RP_TASK_TYPE_TX_LORA;
+		request.state = RP_TASK_STATE_ASAP;
+		break;
+	case RP_HOOK_ID_LBT:
+		request.type = RP_TASK_TYPE_RX_LORA;
+		request.duration_ms = prv_random(5, 20);
+		break;
+	case RP_HOOK_ID_CLASS_B_BEACON:
+	case RP_HOOK_ID_CLASS_B_PING_SLOT:
+		request.type = RP_TASK_TYPE_RX_LORA;
+		request.state = RP_TASK_STATE_SCHEDULE;
+		request.low_priority = (hook_id == RP_HOOK_ID_CLASS_B_PING_SLOT) && prv_chance(25);
+		break;
+	case RP_HOOK_ID_CLASS_C:
+		request.type = RP_TASK_TYPE_RX_LORA;
+		request.state = RP_TASK_STATE_ASAP;
+		request.suspendable = true;
+		request.duration_ms = prv_random(500, 5000);
+		break;
+	default:
+		request.suspendable = (request.state == RP_TASK_STATE_ASAP) && prv_chance(25);
+		break;
+	}
+
+	request.rx_packet = (request.type == RP_TASK_TYPE_RX_LORA) && prv_chance(20);
+	request.start_ms = (request.state == RP_TASK_STATE_SCHEDULE)
+				   ? now + prv_random(1, 2000)
+				   : now + (prv_chance(50) ? 0 : prv_random(0, 500));
+
+	return request;
+}
+
+static void prv_play(uint32_t seed)
+{
+	uint32_t aborted_nb = 0;
+	uint32_t suspended_nb = 0;
+
+	rp_sim_init(&prv_sim, seed);
+	prv_sim.on_end = prv_on_end;
+
+	for (uint32_t i = 0; i < PRV_ACTION_NB; i++) {
+		uint8_t hook_id = prv_hooks[prv_random(0, ARRAY_SIZE(prv_hooks) - 1)];
+		struct rp_sim_request request;
+
+		rp_sim_run_ms(&prv_sim, prv_random(0, 300));
+
+		if (prv_sim.hook_task[hook_id] != RP_SIM_NONE) {
+			if (prv_chance(10)) {
+				rp_sim_abort(&prv_sim, hook_id);
+			}
+			continue;
+		}
+		request = prv_request(hook_id);
+		zassert_equal(rp_sim_enqueue(&prv_sim, &request, NULL), RP_HOOK_STATUS_OK,
+			      "Seed %u: enqueue %u on hook %u failed", seed, i, hook_id);
+	}
+
+	rp_sim_run_until_idle(&prv_sim, PRV_DRAIN_MS);
+	rp_sim_check_idle(&prv_sim);
+
+	for (uint8_t id = 0; id < RP_NB_HOOKS; id++) {
+		aborted_nb += prv_sim.rp.stats.task_hook_aborted_nb[id];
+		suspended_nb += prv_sim.rp.stats.task_hook_suspended_nb[id];
+	}
+	zassert_true(prv_sim.launch_nb > 0, "Seed %u: nothing launched", seed);
+
+	if (seed == 1) {
+		TC_PRINT("Seed %u: %u tasks, %u launches, %u preemptions, %u suspended, "
+			 "%u aborted\n",
+			 seed, prv_sim.task_nb, prv_sim.launch_nb, prv_sim.preemption_nb,
+			 suspended_nb, aborted_nb);
+	}
+}
+
+ZTEST(rp_random, test_random_schedules)
+{
+	for (uint32_t seed = 1; seed <= PRV_SEED_NB; seed++) {
+		prv_play(seed);
+	}
+}
+
+ZTEST_SUITE(rp_random, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,395 @@
+/** @file test_scenario.c
+ *
+ * @brief Radio planner scenarios of the modem services
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2022 Irnas. All rights reserved.
+ */
+
+#include <zephyr/ztest.h>
+
+#include <test_hal.h>
+#include <test_radio.h>
+
+#include "rp_sim.h"
+
+/* Delay of the first task of a scenario, in ms */
+#define PRV_LEAD_MS 100
+
+static struct rp_sim prv_sim;
+
+/* Rx windows opened after an uplink by the scenario of the class A exchange */
+static uint32_t prv_rx_window_nb;
+static uint32_t prv_tx_end_ms;
+
+static uint64_t prv_margin_100us(void)
+{
+	return prv_sim.rp.margin_delay_100us;
+}
+
+/**
+ * @brief Check that a schedule task has been launched within the margin before its start and has
+ * ended after its duration
+ */
+static void prv_check_on_time(const struct rp_sim_task *task)
+{
+	uint64_t start_100us = (uint64_t)task->request.start_ms * 10;
+
+	zassert_equal(task->launch_nb, 1, "Hook %u launched %u times", task->request.hook_id,
+		      task->launch_nb);
+	zassert_between_inclusive(task->launch_100us, start_100us - prv_margin_100us(), start_100us,
+				  "Hook %u launched at %llu for %llu", task->request.hook_id,
+				  (unsigned long long)task->launch_100us,
+				  (unsigned long long)start_100us);
+	zassert_equal(task->end_100us, start_100us + (uint64_t)task->request.duration_ms * 10,
+		      "Hook %u ended at %llu", task->request.hook_id,
+		      (unsigned long long)task->end_100us);
+}
+
+static struct rp_sim_request prv_tx(uint8_t hook_id, uint32_t start_ms, uint32_t duration_ms)
+{
+	return (struct rp_sim_request){
+		.hook_id = hook_id,
+		.type = RP_TASK_TYPE_TX_LORA,
+		.state = RP_TASK_STATE_ASAP,
+		.start_ms = start_ms,
+		.duration_ms = duration_ms,
+	};
+}
+
+static struct rp_sim_request prv_rx(uint8_t hook_id, uint32_t start_ms, uint32_t duration_ms)
+{
+	return (struct rp_sim_request){
+		.hook_id = hook_id,
+		.type = RP_TASK_TYPE_RX_LORA,
+		.state = RP_TASK_STATE_SCHEDULE,
+		.start_ms = start_ms,
+		.duration_ms = duration_ms,
+	};
+}
+
+static void prv_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	rp_sim_init(&prv_sim, 1);
+	prv_rx_window_nb = 0;
+	prv_tx_end_ms = 0;
+}
+
+ZTEST(rp_scenario, test_tx_alone)
+{
+	struct rp_sim_request request = prv_tx(RP_HOOK_ID_LR1MAC_STACK, rp_sim_now_ms(), 50);
+	struct rp_sim_task *task;
+	struct test_radio_stats stats;
+
+	zassert_equal(rp_sim_enqueue(&prv_sim, &request, &task), RP_HOOK_STATUS_OK,
+		      "Enqueue failed");
+	zassert_equal(test_radio_get_mode(), TEST_RADIO_MODE_TX, "Asap task not launched at once");
+
+	rp_sim_run_until_idle(&prv_sim, 1000);
+
+	zassert_equal(task->status, RP_STATUS_TX_DONE, "Tx ended with status %u", task->status);
+	zassert_equal(task->end_100us, task->enqueue_100us + 500, "Tx ended at %llu",
+		      (unsigned long long)task->end_100us);
+	rp_sim_check_idle(&prv_sim);
+
+	test_radio_get_stats(&stats);
+	zassert_equal(stats.wake_up_nb, 1, "Radio woken up %u times", stats.wake_up_nb);
+	zassert_equal(stats.tx_100us, 500, "Radio in tx for %llu x 100 us",
+		      (unsigned long long)stats.tx_100us);
+}
+
+/**
+ * @brief Open RX1 one second after the end of the uplink, then RX2 one second later
+ */
+static void prv_class_a_on_end(struct rp_sim *sim, struct rp_sim_task *task)
+{
+	struct rp_sim_request request;
+
+	if (task->request.type == RP_TASK_TYPE_TX_LORA) {
+		zassert_equal(task->status, RP_STATUS_TX_DONE, "Uplink ended with status %u",
+			      task->status);
+		prv_tx_end_ms = (uint32_t)(task->end_100us / 10);
+	} else {
+		zassert_equal(task->status, RP_STATUS_RX_TIMEOUT, "RX%u ended with status %u",
+			      prv_rx_window_nb, task->status);
+	}
+
+	if (prv_rx_window_nb < 2) {
+		prv_rx_window_nb++;
+		request = prv_rx(RP_HOOK_ID_LR1MAC_STACK, prv_tx_end_ms + 1000 * prv_rx_window_nb,
+				 30);
+		zassert_equal(rp_sim_enqueue(sim, &request, NULL), RP_HOOK_STATUS_OK,
+			      "RX%u enqueue failed", prv_rx_window_nb);
+	}
+}
+
+ZTEST(rp_scenario, test_class_a_rx_windows)
+{
+	struct rp_sim_request request = prv_tx(RP_HOOK_ID_LR1MAC_STACK, rp_sim_now_ms(), 60);
+	struct test_radio_stats stats;
+
+	prv_sim.on_end = prv_class_a_on_end;
+	zassert_equal(rp_sim_enqueue(&prv_sim, &request, NULL), RP_HOOK_STATUS_OK,
+		      "Enqueue failed");
+
+	rp_sim_run_until_idle(&prv_sim, 5000);
+
+	zassert_equal(prv_sim.task_nb, 3, "%u tasks instead of the uplink and two windows",
+		      prv_sim.task_nb);
+	prv_check_on_time(&prv_sim.tasks[1]);
+	prv_check_on_time(&prv_sim.tasks[2]);
+	rp_sim_check_idle(&prv_sim);
+
+	/* The radio sleeps between the uplink and the windows */
+	test_radio_get_stats(&stats);
+	zassert_equal(stats.wake_up_nb, 3, "Radio woken up %u times", stats.wake_up_nb);
+}
+
+ZTEST(rp_scenario, test_beacon_suspends_class_c)
+{
+	uint32_t now = rp_sim_now_ms();
+	struct rp_sim_request class_c = prv_rx(RP_HOOK_ID_CLASS_C, now, 5000);
+	struct rp_sim_request beacon = prv_rx(RP_HOOK_ID_CLASS_B_BEACON, now + 1000, 200);
+	struct rp_sim_task *class_c_task;
+	struct rp_sim_task *beacon_task;
+
+	class_c.state = RP_TASK_STATE_ASAP;
+	class_c.suspendable = true;
+	zassert_equal(rp_sim_enqueue(&prv_sim, &class_c, &class_c_task), RP_HOOK_STATUS_OK,
+		      "Class C enqueue failed");
+	zassert_equal(rp_sim_enqueue(&prv_sim, &beacon, &beacon_task), RP_HOOK_STATUS_OK,
+		      "Beacon enqueue failed");
+
+	rp_sim_run_until_idle(&prv_sim, 10000);
+
+	prv_check_on_time(beacon_task);
+	zassert_equal(prv_sim.rp.stats.task_hook_suspended_nb[RP_HOOK_ID_CLASS_C], 1,
+		      "Class C suspended %u times",
+		      prv_sim.rp.stats.task_hook_suspended_nb[RP_HOOK_ID_CLASS_C]);
+	zassert_equal(class_c_task->launch_nb, 2, "Class C launched %u times",
+		      class_c_task->launch_nb);
+	zassert_equal(class_c_task->status, RP_STATUS_RX_TIMEOUT, "Class C ended with status %u",
+		      class_c_task->status);
+
+	/* The class C reception resumes after the beacon for the rest of its duration */
+	zassert_within(class_c_task->end_100us,
+		       class_c_task->launch_100us + 50000 + beacon.duration_ms * 10,
+		       prv_margin_100us(), "Class C ended at %llu, launched at %llu",
+		       (unsigned long long)class_c_task->end_100us,
+		       (unsigned long long)class_c_task->launch_100us);
+	rp_sim_check_idle(&prv_sim);
+}
+
+ZTEST(rp_scenario, test_beacon_aborts_uplink)
+{
+	uint32_t now = rp_sim_now_ms();
+	struct rp_sim_request uplink = prv_tx(RP_HOOK_ID_LR1MAC_STACK, now, 400);
+	struct rp_sim_request beacon = prv_rx(RP_HOOK_ID_CLASS_B_BEACON, now + 300, 200);
+	struct rp_sim_task *uplink_task;
+	struct rp_sim_task *beacon_task;
+
+	/* The running asap uplink is not suspendable, it is aborted for the beacon, a schedule task
+	 * of a lower class
+	 */
+	zassert_equal(rp_sim_enqueue(&prv_sim, &uplink, &uplink_task), RP_HOOK_STATUS_OK,
+		      "Uplink enqueue failed");
+	zassert_equal(rp_sim_enqueue(&prv_sim, &beacon, &beacon_task), RP_HOOK_STATUS_OK,
+		      "Beacon enqueue failed");
+
+	rp_sim_run_until_idle(&prv_sim, 5000);
+
+	prv_check_on_time(beacon_task);
+	zassert_equal(uplink_task->launch_nb, 1, "Uplink launched %u times",
+		      uplink_task->launch_nb);
+	zassert_equal(uplink_task->status, RP_STATUS_TASK_ABORTED, "Uplink ended with status %u",
+		      uplink_task->status);
+	rp_sim_check_idle(&prv_sim);
+}
+
+ZTEST(rp_scenario, test_rx1_beats_beacon)
+{
+	uint32_t now = rp_sim_now_ms();
+	struct rp_sim_request rx1 = prv_rx(RP_HOOK_ID_LR1MAC_STACK, now + 500, 100);
+	struct rp_sim_request beacon = prv_rx(RP_HOOK_ID_CLASS_B_BEACON, now + 550, 200);
+	struct rp_sim_task *rx1_task;
+	struct rp_sim_task *beacon_task;
+
+	zassert_equal(rp_sim_enqueue(&prv_sim, &beacon, &beacon_task), RP_HOOK_STATUS_OK,
+		      "Beacon enqueue failed");
+	zassert_equal(rp_sim_enqueue(&prv_sim, &rx1, &rx1_task), RP_HOOK_STATUS_OK,
+		      "RX1 enqueue failed");
+
+	rp_sim_run_until_idle(&prv_sim, 5000);
+
+	prv_check_on_time(rx1_task);
+	zassert_equal(beacon_task->launch_nb, 0, "Overlapping beacon launched");
+	zassert_equal(beacon_task->status, RP_STATUS_TASK_ABORTED, "Beacon ended with status %u",
+		      beacon_task->status);
+	rp_sim_check_idle(&prv_sim);
+}
+
+ZTEST(rp_scenario, test_low_priority_fits_before)
+{
+	uint32_t now = rp_sim_now_ms();
+	struct rp_sim_request ping_slot = prv_rx(RP_HOOK_ID_CLASS_B_PING_SLOT, now + 1000, 50);
+	struct rp_sim_request user = prv_tx(RP_HOOK_ID_USER_SUSPEND_1, now + PRV_LEAD_MS, 300);
+	struct rp_sim_request late_user = prv_tx(RP_HOOK_ID_USER_SUSPEND_2, now + 800, 300);
+	struct rp_sim_task *ping_slot_task;
+	struct rp_sim_task *user_task;
+	struct rp_sim_task *late_user_task;
+
+	zassert_equal(rp_sim_enqueue(&prv_sim, &ping_slot, &ping_slot_task), RP_HOOK_STATUS_OK,
+		      "Ping slot enqueue failed");
+	zassert_equal(rp_sim_enqueue(&prv_sim, &user, &user_task), RP_HOOK_STATUS_OK,
+		      "User enqueue failed");
+	zassert_equal(rp_sim_enqueue(&prv_sim, &late_user, &late_user_task), RP_HOOK_STATUS_OK,
+		      "Late user enqueue failed");
+
+	rp_sim_run_until_idle(&prv_sim, 5000);
+
+	/* The first user task ends before the ping slot, the second one waits for its end */
+	prv_check_on_time(ping_slot_task);
+	zassert_equal(user_task->status, RP_STATUS_TX_DONE, "User task ended with status %u",
+		      user_task->status);
+	zassert_true(user_task->end_100us <= ping_slot_task->launch_100us,
+		     "User task not run before the ping slot");
+	zassert_equal(late_user_task->status, RP_STATUS_TX_DONE,
+		      "Late user task ended with status %u", late_user_task->status);
+	zassert_true(late_user_task->launch_100us >= ping_slot_task->end_100us,
+		     "Late user task run before the ping slot");
+	rp_sim_check_idle(&prv_sim);
+}
+
+/**
+ * @brief Send the uplink right after a free channel
+ */
+static void prv_lbt_on_end(struct rp_sim *sim, struct rp_sim_task *task)
+{
+	struct rp_sim_request request = prv_tx(RP_HOOK_ID_LR1MAC_STACK, rp_sim_now_ms() + 2, 80);
+
+	if (task->request.hook_id == RP_HOOK_ID_LBT) {
+		zassert_equal(rp_sim_enqueue(sim, &request, NULL), RP_HOOK_STATUS_OK,
+			      "Uplink enqueue failed");
+	}
+}
+
+ZTEST(rp_scenario, test_lbt_keeps_radio_warm)
+{
+	struct rp_sim_request lbt = prv_rx(RP_HOOK_ID_LBT, rp_sim_now_ms() + PRV_LEAD_MS, 5);
+	struct test_radio_stats stats;
+
+	prv_sim.on_end = prv_lbt_on_end;
+	zassert_equal(rp_sim_enqueue(&prv_sim, &lbt, NULL), RP_HOOK_STATUS_OK,
+		      "Listen before talk enqueue failed");
+
+	rp_sim_run_until_idle(&prv_sim, 5000);
+
+	zassert_equal(prv_sim.task_nb, 2, "%u tasks", prv_sim.task_nb);
+	zassert_equal(prv_sim.tasks[1].status, RP_STATUS_TX_DONE, "Uplink ended with status %u",
+		      prv_sim.tasks[1].status);
+	rp_sim_check_idle(&prv_sim);
+
+	/* The uplink starts on the radio left in standby by the listen before talk */
+	test_radio_get_stats(&stats);
+	zassert_equal(stats.wake_up_nb, 1, "Radio woken up %u times", stats.wake_up_nb);
+	zassert_equal(prv_sim.rp.stats.task_hook_coalesced_nb[RP_HOOK_ID_LR1MAC_STACK], 1,
+		      "%u launches on the warm radio",
+		      prv_sim.rp.stats.task_hook_coalesced_nb[RP_HOOK_ID_LR1MAC_STACK]);
+}
+
+ZTEST(rp_scenario, test_abort)
+{
+	uint32_t now = rp_sim_now_ms();
+	struct rp_sim_request queued = prv_rx(RP_HOOK_ID_CLASS_B_PING_SLOT, now + 1000, 50);
+	struct rp_sim_request running = prv_tx(RP_HOOK_ID_LR1MAC_STACK, now, 400);
+	struct rp_sim_task *queued_task;
+	struct rp_sim_task *running_task;
+
+	zassert_equal(rp_sim_enqueue(&prv_sim, &queued, &queued_task), RP_HOOK_STATUS_OK,
+		      "Queued task enqueue failed");
+	zassert_equal(rp_sim_enqueue(&prv_sim, &running, &running_task), RP_HOOK_STATUS_OK,
+		      "Running task enqueue failed");
+	rp_sim_run_ms(&prv_sim, 100);
+	zassert_equal(test_radio_get_mode(), TEST_RADIO_MODE_TX, "Task not running");
+
+	rp_sim_abort(&prv_sim, RP_HOOK_ID_LR1MAC_STACK);
+	zassert_true(running_task->ended, "Running task not ended by its abort");
+	zassert_equal(running_task->status, RP_STATUS_TASK_ABORTED,
+		      "Running task ended with status %u", running_task->status);
+
+	rp_sim_abort(&prv_sim, RP_HOOK_ID_CLASS_B_PING_SLOT);
+	zassert_true(queued_task->ended, "Queued task not ended by its abort");
+	zassert_equal(queued_task->status, RP_STATUS_TASK_ABORTED,
+		      "Queued task ended with status %u", queued_task->status);
+	zassert_equal(queued_task->launch_nb, 0, "Aborted task launched");
+
+	rp_sim_check_idle(&prv_sim);
+}
+
+ZTEST(rp_scenario, test_enqueue_refused)
+{
+	struct rp_sim_request past = prv_rx(RP_HOOK_ID_CLASS_B_BEACON, rp_sim_now_ms(), 100);
+	struct rp_sim_request running = prv_tx(RP_HOOK_ID_LR1MAC_STACK, rp_sim_now_ms(), 100);
+
+	zassert_equal(rp_sim_enqueue(&prv_sim, &past, NULL), RP_TASK_STATUS_SCHEDULE_TASK_IN_PAST,
+		      "Schedule task in the past accepted");
+	zassert_equal(prv_sim.task_nb, 0, "Refused task recorded");
+
+	zassert_equal(rp_sim_enqueue(&prv_sim, &running, NULL), RP_HOOK_STATUS_OK,
+		      "Enqueue failed");
+	zassert_equal(rp_sim_enqueue(&prv_sim, &running, NULL), RP_TASK_STATUS_ALREADY_RUNNING,
+		      "Task of a running hook accepted");
+
+	rp_sim_run_until_idle(&prv_sim, 1000);
+	zassert_equal(prv_sim.task_nb, 1, "%u tasks", prv_sim.task_nb);
+	rp_sim_check_idle(&prv_sim);
+}
+
+ZTEST(rp_scenario, test_admission_check)
+{
+	uint32_t now = rp_sim_now_ms();
+	struct rp_sim_request queued = prv_rx(0, now + 1000, 100);
+	struct rp_sim_request request;
+	rp_task_t task = {0};
+	rp_task_admission_t result;
+	uint8_t id = 0;
+	uint8_t low_id;
+
+	/* Hooks past the first word of the hook masks */
+	while (id < 40) {
+		id = rp_sim_alloc_hook(&prv_sim, RP_HOOK_PRIORITY_CLASS_BACKGROUND);
+	}
+	low_id = rp_sim_alloc_hook(&prv_sim, RP_HOOK_PRIORITY_CLASS_BACKGROUND);
+	queued.hook_id = id;
+	zassert_equal(rp_sim_enqueue(&prv_sim, &queued, NULL), RP_HOOK_STATUS_OK,
+		      "Enqueue failed");
+
+	/* A stack task preempts the queued one */
+	request = prv_rx(RP_HOOK_ID_LR1MAC_STACK, now + 1050, 100);
+	task.hook_id = request.hook_id;
+	task.state = request.state;
+	task.start_time_ms = request.start_ms;
+	task.duration_time_ms = request.duration_ms;
+	zassert_ok(rp_task_admission_check(&prv_sim.rp, &task, &result), "Check failed");
+	zassert_true(result.admitted, "Stack task not admitted");
+	zassert_true(rp_hook_mask_is_set(result.preempted_hooks, id), "Hook %u not preempted", id);
+	zassert_false(rp_hook_mask_is_set(result.preempted_hooks, id % 32),
+		      "Hook %u preempted", id % 32);
+	zassert_false(rp_hook_mask_is_set(result.blocking_hooks, id), "Hook %u blocking", id);
+
+	/* A task of a lower priority hook of the same class is blocked by it */
+	task.hook_id = low_id;
+	zassert_ok(rp_task_admission_check(&prv_sim.rp, &task, &result), "Check failed");
+	zassert_false(result.admitted, "Overlapping task admitted");
+	zassert_true(rp_hook_mask_is_set(result.blocking_hooks, id), "Hook %u not blocking", id);
+	zassert_false(rp_hook_mask_is_set(result.preempted_hooks, id), "Hook %u preempted", id);
+
+	/* The check leaves the planner as it was */
+	rp_sim_run_until_idle(&prv_sim, 5000);
+	zassert_equal(prv_sim.task_nb, 1, "%u tasks", prv_sim.task_nb);
+	rp_sim_check_idle(&prv_sim);
+}
+
+ZTEST_SUITE(rp_scenario, NULL, NULL, prv_before, NULL, NULL);
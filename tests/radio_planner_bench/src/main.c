@@ -0,0 +1,232 @@
+/** @file main.c
+ *
+ * @brief Radio planner benchmark against the number of busy hooks
+ *
+ * Every busy hook gets a new rx task as soon as its last one has ended, so the planner always has
+ * as many queued tasks as busy hooks. The time spent in the planner (enqueues, radio irqs and
+ * timer expiries) is reported per task with 8, 32 and 64 busy hooks, the hooks past
+ * RP_HOOK_ID_MAX being allocated at runtime.
+ *
+ * On a target the time is measured with the timing API. On the host (unit_testing) it is the CPU
+ * time of the process, the CPU time of native_sim does not advance while the code runs.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2022 Irnas. All rights reserved.
+ */
+
+#include <zephyr/ztest.h>
+#if defined(CONFIG_TIMING_FUNCTIONS)
+#include <zephyr/timing/timing.h>
+#else
+#include <time.h>
+#endif
+
+#include <radio_planner.h>
+
+#include <test_hal.h>
+#include <test_radio.h>
+
+/* Tasks played for each number of busy hooks */
+#define PRV_TASK_NB 4000
+
+/* Time run between two rounds of enqueues, in ms */
+#define PRV_ROUND_MS 10
+
+static radio_planner_t prv_rp;
+static bool prv_busy[RP_NB_HOOKS];
+static uint8_t prv_payload[255];
+static uint32_t prv_end_nb;
+
+#if defined(CONFIG_TIMING_FUNCTIONS)
+typedef timing_t prv_clock_t;
+#else
+typedef struct timespec prv_clock_t;
+#endif
+
+/* Time spent in the planner, in timing cycles on a target and in ns on the host */
+static uint64_t prv_spent;
+
+static prv_clock_t prv_clock_get(void)
+{
+#if defined(CONFIG_TIMING_FUNCTIONS)
+	return timing_counter_get();
+#else
+	struct timespec now;
+
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+	return now;
+#endif
+}
+
+static void prv_clock_add(prv_clock_t *start)
+{
+	prv_clock_t end = prv_clock_get();
+
+#if defined(CONFIG_TIMING_FUNCTIONS)
+	prv_spent += timing_cycles_get(start, &end);
+#else
+	prv_spent += (uint64_t)(end.tv_sec - start->tv_sec) * 1000000000ULL + end.tv_nsec -
+		     start->tv_nsec;
+#endif
+}
+
+static uint64_t prv_spent_ns(void)
+{
+#if defined(CONFIG_TIMING_FUNCTIONS)
+	return timing_cycles_to_ns(prv_spent);
+#else
+	return prv_spent;
+#endif
+}
+
+static void prv_launch(void *context)
+{
+	radio_planner_t *rp = context;
+	uint8_t id = rp->radio_task_id;
+	const rp_task_t *task = &rp->tasks[id];
+	uint64_t start_100us = MAX(test_hal_now_100us(), (uint64_t)task->start_time_ms * 10);
+
+	ralf_setup_lora(rp->radio, &rp->radio_params[id].rx.lora);
+	ral_set_rx(&rp->radio->ral, rp->radio_params[id].rx.timeout_in_ms);
+	rp_stats_set_rx_timestamp(&rp->stats, smtc_modem_hal_get_time_in_ms());
+	test_radio_irq_at(RAL_IRQ_RX_TIMEOUT, start_100us + (uint64_t)task->duration_time_ms * 10);
+}
+
+static void prv_hook_callback(void *context)
+{
+	*(bool *)context = false;
+	prv_end_nb++;
+}
+
+static void prv_init(uint8_t hook_nb)
+{
+	uint8_t id;
+
+	test_hal_reset(10000, 1);
+	test_radio_reset();
+	rp_init(&prv_rp, &test_radio);
+	smtc_modem_hal_irq_config_radio_irq(rp_radio_irq_callback, &prv_rp);
+
+	for (id = 0; id < MIN(hook_nb, RP_HOOK_ID_MAX); id++) {
+		prv_busy[id] = false;
+		zassert_ok(rp_hook_init(&prv_rp, id, prv_hook_callback, &prv_busy[id]),
+			   "Hook %u init failed", id);
+	}
+	for (; id < hook_nb; id++) {
+		uint8_t alloc_id;
+
+		prv_busy[id] = false;
+		zassert_ok(rp_hook_alloc(&prv_rp, RP_HOOK_PRIORITY_CLASS_USER, prv_hook_callback,
+					 &prv_busy[id], &alloc_id),
+			   "Hook allocation failed");
+		zassert_equal(alloc_id, id, "Hook %u allocated instead of %u", alloc_id, id);
+	}
+}
+
+static void prv_enqueue(uint8_t id)
+{
+	uint32_t now = smtc_modem_hal_get_time_in_ms();
+	rp_radio_params_t params = {0};
+	rp_task_t task = {
+		.hook_id = id,
+		.type = RP_TASK_TYPE_RX_LORA,
+		.launch_task_callbacks = prv_launch,
+		.state = (id % 2) ? RP_TASK_STATE_ASAP : RP_TASK_STATE_SCHEDULE,
+		.start_time_ms = now + smtc_modem_hal_get_random_nb_in_range(20, 2000),
+		.duration_time_ms = smtc_modem_hal_get_random_nb_in_range(5, 20),
+	};
+	prv_clock_t start;
+
+	params.pkt_type = RAL_PKT_TYPE_LORA;
+	params.rx.lora.mod_params.sf = RAL_LORA_SF7;
+	params.rx.lora.mod_params.bw = RAL_LORA_BW_125_KHZ;
+	params.rx.lora.rf_freq_in_hz = 868100000;
+	params.rx.timeout_in_ms = task.duration_time_ms;
+
+	prv_busy[id] = true;
+	start = prv_clock_get();
+	zassert_ok(rp_task_enqueue(&prv_rp, &task, prv_payload, sizeof(prv_payload), &params),
+		   "Enqueue on hook %u failed", id);
+	prv_clock_add(&start);
+}
+
+static void prv_run_ms(uint32_t ms)
+{
+	uint64_t limit_100us = test_hal_now_100us() + (uint64_t)ms * 10;
+	prv_clock_t start = prv_clock_get();
+
+	while (test_hal_run_next(limit_100us)) {
+	}
+	prv_clock_add(&start);
+	test_hal_run_until(limit_100us);
+}
+
+static void prv_bench(uint8_t hook_nb)
+{
+	uint32_t task_nb = 0;
+	uint32_t aborted_nb = 0;
+	uint64_t ns;
+
+	zassert_true(hook_nb <= RP_NB_HOOKS, "%u hooks, the planner has %u", hook_nb, RP_NB_HOOKS);
+	prv_init(hook_nb);
+	prv_spent = 0;
+	prv_end_nb = 0;
+
+	while (task_nb < PRV_TASK_NB) {
+		for (uint8_t id = 0; (id < hook_nb) && (task_nb < PRV_TASK_NB); id++) {
+			if (!prv_busy[id]) {
+				prv_enqueue(id);
+				task_nb++;
+			}
+		}
+		prv_run_ms(PRV_ROUND_MS);
+	}
+	while (prv_end_nb < task_nb) {
+		prv_run_ms(PRV_ROUND_MS);
+	}
+
+	for (uint8_t id = 0; id < hook_nb; id++) {
+		aborted_nb += prv_rp.stats.task_hook_aborted_nb[id];
+	}
+	zassert_true(aborted_nb < task_nb, "Every task aborted");
+
+	ns = prv_spent_ns();
+	TC_PRINT("%2u hooks: %llu ns per task, %u tasks, %u aborted\n", hook_nb,
+		 (unsigned long long)(ns / task_nb), task_nb, aborted_nb);
+}
+
+static void *prv_setup(void)
+{
+#if defined(CONFIG_TIMING_FUNCTIONS)
+	timing_init();
+	timing_start();
+#endif
+
+	return NULL;
+}
+
+static void prv_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+#if defined(CONFIG_TIMING_FUNCTIONS)
+	timing_stop();
+#endif
+}
+
+ZTEST(rp_bench, test_8_hooks)
+{
+	prv_bench(8);
+}
+
+ZTEST(rp_bench, test_32_hooks)
+{
+	prv_bench(32);
+}
+
+ZTEST(rp_bench, test_64_hooks)
+{
+	prv_bench(64);
+}
+
+ZTEST_SUITE(rp_bench, NULL, prv_setup, NULL, NULL, prv_teardown);